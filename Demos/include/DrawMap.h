@@ -55,6 +55,7 @@ struct Arguments {
 
   std::string basemap;
   std::string srtmDirectory;
+  std::string styleCacheDirectory;
 
   osmscout::GeoCoord       center;
   osmscout::Magnification  zoom{osmscout::Magnification::magClose};
@@ -220,6 +221,12 @@ public:
               "srtmDirectory",
               "SRTM data lookup directory",
               false);
+    AddOption(osmscout::CmdLineStringOption([this](const std::string& value) {
+                args.styleCacheDirectory=value;
+              }),
+              "styleCache",
+              "Directory for caching the resolved stylesheet, speeds up the next start",
+              false);
     AddOption(osmscout::CmdLineStringOption([this](const std::string& value) {
                     args.maps.push_back(value);
                   }),
@@ -297,6 +304,29 @@ public:
 
   }
 
+  static osmscout::StyleConfigRef LoadStyle(const Arguments& args,
+                                            const osmscout::DatabaseRef& database,
+                                            const std::string& databaseDirectory)
+  {
+    auto styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+    bool loaded;
+
+    if (args.styleCacheDirectory.empty()) {
+      loaded=styleConfig->Load(args.style);
+    }
+    else {
+      std::error_code error;
+      std::filesystem::create_directories(args.styleCacheDirectory,error);
+
+      loaded=styleConfig->LoadCached(args.style,
+                                     osmscout::StyleConfig::GetCacheFileName(args.styleCacheDirectory,
+                                                                             databaseDirectory,
+                                                                             args.style));
+    }
+
+    return loaded ? styleConfig : nullptr;
+  }
+
   bool OpenDatabase()
   {
     osmscout::CmdLineParseResult argResult=argParser.Parse();
@@ -333,8 +363,8 @@ public:
 
       auto mapService=std::make_shared<osmscout::MapService>(database);
 
-      auto styleConfig = std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
-      if (!styleConfig->Load(args.style)) {
+      auto styleConfig=LoadStyle(args,database,map);
+      if (!styleConfig) {
         std::cerr << "Cannot open style" << std::endl;
         return false;
       }
@@ -389,8 +419,8 @@ public:
 
       auto mapService=std::make_shared<osmscout::MapService>(database);
 
-      auto styleConfig = std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
-      if (!styleConfig->Load(args.style)) {
+      auto styleConfig=LoadStyle(args,database,args.basemap);
+      if (!styleConfig) {
         std::cerr << "Cannot open style" << std::endl;
         return false;
       }
@@ -425,8 +455,13 @@ public:
         mapService->GetGroundTiles(projection,dbData.groundTiles);
       }
 
-      if (GetArguments().renderHillShading) {
-        dbData.srtmTile=mapService->GetSRTMData(projection);
+      if (GetArguments().renderHillShading || GetArguments().renderContourLines) {
+        mapService->GetTerrainTiles(projection,dbData.terrainTiles);
+
+        // Fall back to computing from the SRTM data while drawing
+        if (dbData.terrainTiles.empty()) {
+          dbData.srtmTile=mapService->GetSRTMData(projection);
+        }
       }
 
       data.emplace_back(std::move(dbData));
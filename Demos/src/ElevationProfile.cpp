@@ -21,12 +21,15 @@
 #include <osmscoutgpx/Import.h>
 
 #include <osmscout/elevation/ElevationService.h>
+#include <osmscout/elevation/SRTM.h>
 
 #include <osmscout/cli/CmdLineParsing.h>
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/Distance.h>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <osmscout/db/Database.h>
 
 #include <osmscoutgpx/Export.h>
@@ -37,6 +40,7 @@ struct Arguments
   std::string database;
   std::string gpxInput;
   std::string gpxOutput;
+  std::string srtmDirectory;
 };
 
 class DataLoader
@@ -92,6 +96,51 @@ public:
   }
 };
 
+/**
+ * Look up the SRTM heights of all track points, once point by point with a cache of a
+ * single file and once batched with the default cache, and compare the timings.
+ */
+static void EvaluateSRTM(const std::string &srtmDirectory,
+                         const std::vector<osmscout::GeoCoord> &way)
+{
+  osmscout::SRTM       singleFileSrtm(srtmDirectory, 1);
+  std::vector<int32_t> singleHeights;
+
+  osmscout::StopClock singleStopClock;
+  for (const auto &coord: way) {
+    singleHeights.push_back(singleFileSrtm.GetHeightAtLocation(coord));
+  }
+  singleStopClock.Stop();
+
+  osmscout::SRTM      batchSrtm(srtmDirectory);
+  osmscout::StopClock batchStopClock;
+  std::vector<int32_t> batchHeights=batchSrtm.GetHeights(way);
+  batchStopClock.Stop();
+
+  size_t  validCnt=0;
+  int32_t minHeight=std::numeric_limits<int32_t>::max();
+  int32_t maxHeight=std::numeric_limits<int32_t>::min();
+  for (int32_t height: batchHeights) {
+    if (height!=osmscout::SRTM::nodata) {
+      validCnt++;
+      minHeight=std::min(minHeight, height);
+      maxHeight=std::max(maxHeight, height);
+    }
+  }
+
+  std::cout << "SRTM heights for " << validCnt << " of " << way.size() << " points";
+  if (validCnt>0) {
+    std::cout << ", " << minHeight << " m - " << maxHeight << " m";
+  }
+  std::cout << std::endl;
+  std::cout << "SRTM per point lookup: " << singleStopClock.ResultString() << std::endl;
+  std::cout << "SRTM batched lookup:   " << batchStopClock.ResultString() << std::endl;
+
+  if (singleHeights!=batchHeights) {
+    std::cerr << "SRTM per point and batched lookup differ!" << std::endl;
+  }
+}
+
 int main(int argc, char* argv[])
 {
   osmscout::CmdLineParser   argParser("ElevationProfile",
@@ -112,6 +161,12 @@ int main(int argc, char* argv[])
                       "debugGpxOutput",
                       "file for debug gpx output");
 
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string &s) {
+                        args.srtmDirectory=s;
+                      }),
+                      "srtm",
+                      "SRTM data lookup directory, compare per point and batched height lookup");
+
   argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
                             args.database=value;
                           }),
@@ -208,6 +263,10 @@ int main(int argc, char* argv[])
   stopClock.Stop();
   osmscout::log.Debug() << "Evaluating elevation profile: " << stopClock.ResultString() << " (" << dataLoader.GetCount() << "x loading: " << dataLoader.GetMillis()/1000 << " s)";
 
+  if (!args.srtmDirectory.empty()) {
+    EvaluateSRTM(args.srtmDirectory, way);
+  }
+
   if (pointCnt==0){
     std::cout << "No intersection with contours found." << std::endl;
     return 0;
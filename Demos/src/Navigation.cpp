@@ -382,10 +382,10 @@ namespace osmscout {
         return desc;
     }
 
-    bool advanceToNextWaypoint(std::list<RouteDescription::Node>::const_iterator &waypoint,
-                               std::list<RouteDescription::Node>::const_iterator end) {
+    bool advanceToNextWaypoint(RouteDescription::NodeList::const_iterator &waypoint,
+                               RouteDescription::NodeList::const_iterator end) {
         if(waypoint == end) return false;
-        std::list<RouteDescription::Node>::const_iterator next = waypoint;
+        RouteDescription::NodeList::const_iterator next = waypoint;
         std::advance(next,1);
         if (next == end){
             return false;
@@ -650,7 +650,7 @@ int main(int argc, char *argv[]){
     osmscout::GeoCoord location(latitude, longitude);
     double minDistance = 0.0;
 
-    navigation.UpdateCurrentLocation(location, minDistance);
+    bool onRoute=navigation.UpdateCurrentLocation(location, minDistance);
 
     osmscout::ClosestRoutableObjectResult routableResult=router->GetClosestRoutableObject(location,
                                                                                           routingProfile->GetVehicle(),
@@ -658,6 +658,10 @@ int main(int argc, char *argv[]){
 
     std::cout << "Distance to route: " << minDistance << " °" << std::endl;
 
+    if (!onRoute) {
+      std::cout << "Location is not on route" << std::endl;
+    }
+
     std::cout << "Distance from start: " << navigation.GetDistanceFromStart().AsMeter() << std::endl;
     std::cout << "Time from start: " << TimeToString(navigation.GetDurationFromStart()) << std::endl;
 
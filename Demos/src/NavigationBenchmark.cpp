@@ -0,0 +1,673 @@
+/*
+ NavigationBenchmark - a demo program for libosmscout
+ Copyright (C) 2026  Tim Teulings
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+  Headless replay of recorded drives through the NavigationEngine.
+
+  For each given gpx file a route from the first to the last track point is calculated
+  upfront. Afterwards all tracks are replayed in parallel, each worker thread with its own
+  engine instance. Processing time of each agent is collected in histograms and
+  dumped at the end, together with overall throughput.
+
+  Example:
+    NavigationBenchmark --threads 8 nordrhein-westfalen drive1.gpx drive2.gpx ...
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscoutmap/MapService.h>
+
+#include <osmscout/routing/SimpleRoutingService.h>
+#include <osmscout/routing/RoutePostprocessor.h>
+
+#include <osmscout/navigation/Engine.h>
+#include <osmscout/navigation/Agents.h>
+#include <osmscout/navigation/DataAgent.h>
+#include <osmscout/navigation/PositionAgent.h>
+#include <osmscout/navigation/RouteStateAgent.h>
+#include <osmscout/navigation/BearingAgent.h>
+#include <osmscout/navigation/ArrivalEstimateAgent.h>
+#include <osmscout/navigation/SpeedAgent.h>
+#include <osmscout/navigation/VoiceInstructionAgent.h>
+#include <osmscout/navigation/LaneAgent.h>
+
+#include <osmscoutgpx/Import.h>
+
+#include <osmscout/cli/CmdLineParsing.h>
+#include <osmscout/util/StopClock.h>
+
+struct Arguments
+{
+  bool                     help=false;
+  bool                     debug=false;
+  std::string              router=osmscout::RoutingService::DEFAULT_FILENAME_BASE;
+  osmscout::Vehicle        vehicle=osmscout::Vehicle::vehicleCar;
+  size_t                   threads=std::max(1u,std::thread::hardware_concurrency());
+  size_t                   repeat=1;
+  std::string              databaseDirectory;
+  std::vector<std::string> gpxFiles;
+};
+
+static void GetCarSpeedTable(std::map<std::string,double>& map)
+{
+  map["highway_motorway"]=110.0;
+  map["highway_motorway_trunk"]=100.0;
+  map["highway_motorway_primary"]=70.0;
+  map["highway_motorway_link"]=60.0;
+  map["highway_motorway_junction"]=60.0;
+  map["highway_trunk"]=100.0;
+  map["highway_trunk_link"]=60.0;
+  map["highway_primary"]=70.0;
+  map["highway_primary_link"]=60.0;
+  map["highway_secondary"]=60.0;
+  map["highway_secondary_link"]=50.0;
+  map["highway_tertiary_link"]=55.0;
+  map["highway_tertiary"]=55.0;
+  map["highway_unclassified"]=50.0;
+  map["highway_road"]=50.0;
+  map["highway_residential"]=20.0;
+  map["highway_roundabout"]=40.0;
+  map["highway_living_street"]=10.0;
+  map["highway_service"]=30.0;
+}
+
+/**
+ * Latency histogram with power of two buckets (in nanoseconds). Cheap enough
+ * to be updated for each processed message.
+ */
+class LatencyHistogram
+{
+private:
+  static constexpr size_t BucketCount=65; // std::bit_width() of uint64_t is in [0,64]
+
+  std::array<uint64_t,BucketCount> buckets{};
+  uint64_t                         count=0;
+  uint64_t                         sum=0;
+  uint64_t                         max=0;
+
+public:
+  void Add(uint64_t nanoseconds)
+  {
+    buckets[std::bit_width(nanoseconds)]++;
+    count++;
+    sum+=nanoseconds;
+    max=std::max(max,nanoseconds);
+  }
+
+  void Merge(const LatencyHistogram& other)
+  {
+    for (size_t i=0; i<BucketCount; i++) {
+      buckets[i]+=other.buckets[i];
+    }
+    count+=other.count;
+    sum+=other.sum;
+    max=std::max(max,other.max);
+  }
+
+  uint64_t GetCount() const
+  {
+    return count;
+  }
+
+  uint64_t GetSum() const
+  {
+    return sum;
+  }
+
+  uint64_t GetMax() const
+  {
+    return max;
+  }
+
+  /**
+   * Upper bound of the bucket containing the given percentile
+   */
+  uint64_t GetPercentile(double percentile) const
+  {
+    auto threshold=static_cast<uint64_t>(std::ceil(double(count)*percentile/100.0));
+    uint64_t current=0;
+
+    for (size_t i=0; i<BucketCount; i++) {
+      current+=buckets[i];
+      if (current>=threshold && current>0) {
+        if (i==0) {
+          return 0;
+        }
+
+        // shifting by the bit width of uint64_t is undefined
+        return i<64 ? (uint64_t(1) << i)-1 : std::numeric_limits<uint64_t>::max();
+      }
+    }
+
+    return max;
+  }
+};
+
+/**
+ * Decorator measuring the processing time of the wrapped agent
+ */
+class TimedAgent : public osmscout::NavigationAgent
+{
+private:
+  osmscout::NavigationAgentRef agent;
+  LatencyHistogram&            histogram;
+
+public:
+  TimedAgent(const osmscout::NavigationAgentRef& agent,
+             LatencyHistogram& histogram)
+  : agent(agent),
+    histogram(histogram)
+  {
+    // no code
+  }
+
+  std::list<osmscout::NavigationMessageRef> Process(const osmscout::NavigationMessageRef& message) override
+  {
+    auto start=std::chrono::steady_clock::now();
+    auto result=agent->Process(message);
+    auto end=std::chrono::steady_clock::now();
+
+    histogram.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()));
+
+    return result;
+  }
+};
+
+class DataLoader
+{
+private:
+  osmscout::DatabaseRef   database;
+  osmscout::MapServiceRef mapService;
+
+public:
+  explicit DataLoader(const osmscout::DatabaseRef &database):
+    database(database),
+    mapService{std::make_shared<osmscout::MapService>(database)}
+  {}
+
+  bool loadRoutableObjects(const osmscout::GeoBox &box,
+                           const osmscout::Vehicle &vehicle,
+                           const std::map<std::string,osmscout::DatabaseId> &databaseMapping,
+                           osmscout::RoutableObjectsRef &data);
+};
+
+bool DataLoader::loadRoutableObjects(const osmscout::GeoBox &box,
+                                     const osmscout::Vehicle &vehicle,
+                                     const std::map<std::string,osmscout::DatabaseId> &databaseMapping,
+                                     osmscout::RoutableObjectsRef &data)
+{
+  assert(data);
+  data->bbox=box;
+
+  osmscout::Magnification magnification(osmscout::Magnification::magClose);
+
+  auto dbIdIt=databaseMapping.find(database->GetPath());
+  assert(dbIdIt!=databaseMapping.end());
+  osmscout::DatabaseId databaseId=dbIdIt->second;
+
+  osmscout::MapService::TypeDefinition routableTypes;
+  for (const auto& type:database->GetTypeConfig()->GetTypes()){
+    if (type->CanRoute(vehicle)){
+      if (type->CanBeArea()){
+        routableTypes.areaTypes.Set(type);
+      }
+      if (type->CanBeWay()){
+        routableTypes.wayTypes.Set(type);
+      }
+      if (type->CanBeNode()){
+        routableTypes.nodeTypes.Set(type);
+      }
+    }
+  }
+
+  std::list<osmscout::TileRef> tiles;
+  mapService->LookupTiles(magnification,box,tiles);
+  mapService->LoadMissingTileData(osmscout::AreaSearchParameter{},
+                                  magnification,
+                                  routableTypes,
+                                  tiles);
+
+  osmscout::RoutableDBObjects &objects=data->dbMap[databaseId];
+  objects.typeConfig=database->GetTypeConfig();
+  for (const auto &tile:tiles){
+    tile->GetWayData().CopyData([&](const osmscout::WayRef &way){objects.ways[way->GetFileOffset()]=way;});
+    tile->GetAreaData().CopyData([&](const osmscout::AreaRef &area){objects.areas[area->GetFileOffset()]=area;});
+  }
+
+  return true;
+}
+
+/**
+ * A recorded drive together with its precalculated route. All messages passed to the engine
+ * are allocated upfront, so the replay itself only measures the navigation stack.
+ */
+struct Drive
+{
+  std::string                                 name;
+  osmscout::RouteDescriptionRef               route;
+  std::vector<osmscout::NavigationMessageRef> messages;
+};
+
+static const std::vector<std::string> agentNames{
+  "DataAgent",
+  "PositionAgent",
+  "BearingAgent",
+  "VoiceInstructionAgent",
+  "RouteStateAgent",
+  "ArrivalEstimateAgent",
+  "SpeedAgent",
+  "LaneAgent"
+};
+
+struct WorkerStatistics
+{
+  std::vector<LatencyHistogram> agents{agentNames.size()};
+  LatencyHistogram              engine;
+  size_t                        resultMessages=0;
+};
+
+static bool PrepareDrive(const std::string& gpxFile,
+                         osmscout::SimpleRoutingService& router,
+                         const osmscout::RoutingProfileRef& routingProfile,
+                         const osmscout::DatabaseRef& database,
+                         Drive& drive)
+{
+  osmscout::gpx::GpxFile gpx;
+
+  if (!osmscout::gpx::ImportGpx(gpxFile,gpx)) {
+    std::cerr << "Cannot import gpx file '" << gpxFile << "'" << std::endl;
+    return false;
+  }
+
+  std::vector<osmscout::gpx::TrackPoint> points;
+
+  for (const auto& track : gpx.tracks) {
+    for (const auto& segment : track.segments) {
+      points.insert(points.end(),segment.points.begin(),segment.points.end());
+    }
+  }
+
+  if (points.size()<2) {
+    std::cerr << "Gpx file '" << gpxFile << "' contains no track" << std::endl;
+    return false;
+  }
+
+  auto startResult=router.GetClosestRoutableNode(points.front().coord,
+                                                 *routingProfile,
+                                                 osmscout::Kilometers(1));
+  auto targetResult=router.GetClosestRoutableNode(points.back().coord,
+                                                  *routingProfile,
+                                                  osmscout::Kilometers(1));
+
+  if (!startResult.IsValid() || !targetResult.IsValid()) {
+    std::cerr << "Cannot find routing nodes for '" << gpxFile << "'" << std::endl;
+    return false;
+  }
+
+  osmscout::RoutingParameter parameter;
+  auto routingResult=router.CalculateRoute(*routingProfile,
+                                           startResult.GetRoutePosition(),
+                                           targetResult.GetRoutePosition(),
+                                           std::nullopt,
+                                           parameter);
+
+  if (!routingResult.Success()) {
+    std::cerr << "Cannot calculate route for '" << gpxFile << "'" << std::endl;
+    return false;
+  }
+
+  auto routeDescriptionResult=router.TransformRouteDataToRouteDescription(routingResult.GetRoute());
+
+  if (!routeDescriptionResult.Success()) {
+    std::cerr << "Cannot generate route description for '" << gpxFile << "'" << std::endl;
+    return false;
+  }
+
+  std::list<osmscout::RoutePostprocessor::PostprocessorRef> postprocessors{
+    std::make_shared<osmscout::RoutePostprocessor::DistanceAndTimePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::StartPostprocessor>("Start"),
+    std::make_shared<osmscout::RoutePostprocessor::TargetPostprocessor>("Target"),
+    std::make_shared<osmscout::RoutePostprocessor::WayNamePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::WayTypePostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::CrossingWaysPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::DirectionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::MotorwayJunctionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::DestinationPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::MaxSpeedPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::InstructionPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::LanesPostprocessor>(),
+    std::make_shared<osmscout::RoutePostprocessor::SuggestedLanesPostprocessor>()
+  };
+
+  osmscout::RoutePostprocessor             postprocessor;
+  std::vector<osmscout::RoutingProfileRef> profiles{routingProfile};
+  std::vector<osmscout::DatabaseRef>       databases{database};
+
+  if (!postprocessor.PostprocessRouteDescription(*routeDescriptionResult.GetDescription(),
+                                                 profiles,
+                                                 databases,
+                                                 postprocessors,
+                                                 {"highway_motorway",
+                                                  "highway_motorway_trunk",
+                                                  "highway_trunk",
+                                                  "highway_motorway_primary"},
+                                                 {"highway_motorway_link",
+                                                  "highway_trunk_link"},
+                                                 {"highway_motorway_junction"})) {
+    std::cerr << "Cannot postprocess route for '" << gpxFile << "'" << std::endl;
+    return false;
+  }
+
+  drive.name=gpxFile;
+  drive.route=routeDescriptionResult.GetDescription();
+
+  // Tracks without timestamps are replayed in one second intervals
+  osmscout::Timestamp time=points.front().timestamp.value_or(std::chrono::system_clock::now());
+
+  drive.messages.reserve(2+2*points.size());
+  drive.messages.push_back(std::make_shared<osmscout::InitializeMessage>(time));
+  drive.messages.push_back(std::make_shared<osmscout::RouteUpdateMessage>(time,
+                                                                          drive.route,
+                                                                          routingProfile->GetVehicle()));
+
+  for (size_t i=0; i<points.size(); i++) {
+    const auto& point=points[i];
+    double      speed=-1.0;
+
+    if (i>0) {
+      osmscout::Timestamp previousTime=time;
+
+      time=point.timestamp.value_or(time+std::chrono::seconds(1));
+
+      double seconds=std::chrono::duration<double>(time-previousTime).count();
+
+      if (seconds>0.0) {
+        speed=osmscout::GetEllipsoidalDistance(points[i-1].coord,point.coord).As<osmscout::Kilometer>()/(seconds/3600.0);
+      }
+    }
+
+    drive.messages.push_back(std::make_shared<osmscout::GPSUpdateMessage>(time,
+                                                                          point.coord,
+                                                                          speed,
+                                                                          osmscout::Meters(point.hdop.value_or(10.0))));
+    drive.messages.push_back(std::make_shared<osmscout::TimeTickMessage>(time));
+  }
+
+  return true;
+}
+
+static void ReplayDrive(const osmscout::DatabaseRef& database,
+                        const Drive& drive,
+                        WorkerStatistics& statistics)
+{
+  DataLoader dataLoader(database);
+
+  auto timed=[&statistics](size_t index,const osmscout::NavigationAgentRef& agent) {
+    return std::make_shared<TimedAgent>(agent,statistics.agents[index]);
+  };
+
+  osmscout::NavigationEngine engine{
+    timed(0,std::make_shared<osmscout::DataAgent<DataLoader>>(dataLoader)),
+    timed(1,std::make_shared<osmscout::PositionAgent>()),
+    timed(2,std::make_shared<osmscout::BearingAgent>()),
+    timed(3,std::make_shared<osmscout::VoiceInstructionAgent>(osmscout::DistanceUnitSystem::Metrics,
+                                                               std::make_shared<osmscout::NoOpTTSMessageGenerator>())),
+    timed(4,std::make_shared<osmscout::RouteStateAgent>()),
+    timed(5,std::make_shared<osmscout::ArrivalEstimateAgent>()),
+    timed(6,std::make_shared<osmscout::SpeedAgent>()),
+    timed(7,std::make_shared<osmscout::LaneAgent>())
+  };
+
+  for (const auto& message : drive.messages) {
+    auto start=std::chrono::steady_clock::now();
+    auto result=engine.Process(message);
+    auto end=std::chrono::steady_clock::now();
+
+    statistics.engine.Add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end-start).count()));
+    statistics.resultMessages+=result.size();
+  }
+}
+
+static void DumpHistogram(const std::string& name,
+                          const LatencyHistogram& histogram)
+{
+  auto toMicro=[](uint64_t nanoseconds) {
+    return double(nanoseconds)/1000.0;
+  };
+
+  double mean=histogram.GetCount()>0 ? double(histogram.GetSum())/double(histogram.GetCount()) : 0.0;
+
+  std::cout << std::left << std::setw(22) << name << std::right
+            << std::setw(10) << histogram.GetCount()
+            << std::setw(12) << std::fixed << std::setprecision(1) << toMicro(uint64_t(mean))
+            << std::setw(12) << toMicro(histogram.GetPercentile(50))
+            << std::setw(12) << toMicro(histogram.GetPercentile(90))
+            << std::setw(12) << toMicro(histogram.GetPercentile(99))
+            << std::setw(12) << toMicro(histogram.GetMax())
+            << std::setw(12) << toMicro(histogram.GetSum())/1000.0
+            << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser  argParser("NavigationBenchmark",
+                                     argc,argv);
+  std::vector<std::string> helpArgs{"h","help"};
+  Arguments                args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      helpArgs,
+                      "Return argument help",
+                      true);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.debug=value;
+                      }),
+                      "debug",
+                      "Enable debug output",
+                      false);
+
+  argParser.AddOption(osmscout::CmdLineAlternativeFlag([&args](const std::string& value) {
+                        if (value=="foot") {
+                          args.vehicle=osmscout::Vehicle::vehicleFoot;
+                        }
+                        else if (value=="bicycle") {
+                          args.vehicle=osmscout::Vehicle::vehicleBicycle;
+                        }
+                        else if (value=="car") {
+                          args.vehicle=osmscout::Vehicle::vehicleCar;
+                        }
+                      }),
+                      {"foot","bicycle","car"},
+                      "Vehicle type to use for routing");
+
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.router=value;
+                      }),
+                      "router",
+                      "Router filename base");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.threads=std::max(size_t(1),value);
+                      }),
+                      "threads",
+                      "Number of worker threads replaying drives in parallel");
+
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.repeat=std::max(size_t(1),value);
+                      }),
+                      "repeat",
+                      "How many times each drive is replayed");
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.databaseDirectory=value;
+                          }),
+                          "DATABASE",
+                          "Directory of the db to use");
+
+  argParser.AddPositional(osmscout::CmdLineStringListOption([&args](const std::string& value) {
+                            args.gpxFiles.push_back(value);
+                          }),
+                          "GPX",
+                          "Gpx files with recorded drives");
+
+  osmscout::CmdLineParseResult cmdLineParseResult=argParser.Parse();
+
+  if (cmdLineParseResult.HasError()) {
+    std::cerr << "ERROR: " << cmdLineParseResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::log.Debug(args.debug);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open db" << std::endl;
+    return 1;
+  }
+
+  osmscout::FastestPathRoutingProfileRef routingProfile=std::make_shared<osmscout::FastestPathRoutingProfile>(database->GetTypeConfig());
+  osmscout::RouterParameter              routerParameter;
+  osmscout::SimpleRoutingService         router(database,
+                                                routerParameter,
+                                                args.router);
+
+  if (!router.Open()) {
+    std::cerr << "Cannot open routing db" << std::endl;
+    return 1;
+  }
+
+  std::map<std::string,double> carSpeedTable;
+
+  switch (args.vehicle) {
+  case osmscout::vehicleFoot:
+    routingProfile->ParametrizeForFoot(*database->GetTypeConfig(),
+                                       5.0);
+    break;
+  case osmscout::vehicleBicycle:
+    routingProfile->ParametrizeForBicycle(*database->GetTypeConfig(),
+                                          20.0);
+    break;
+  case osmscout::vehicleCar:
+    GetCarSpeedTable(carSpeedTable);
+    routingProfile->ParametrizeForCar(*database->GetTypeConfig(),
+                                      carSpeedTable,
+                                      160.0);
+    break;
+  }
+
+  // The routing service is not thread safe, so all routes are calculated upfront
+  osmscout::StopClock prepareTimer;
+  std::vector<Drive>  drives;
+
+  for (const auto& gpxFile : args.gpxFiles) {
+    Drive drive;
+
+    if (PrepareDrive(gpxFile,router,routingProfile,database,drive)) {
+      drives.push_back(std::move(drive));
+    }
+  }
+
+  router.Close();
+  prepareTimer.Stop();
+
+  std::cout << "Prepared " << drives.size() << " drives in " << prepareTimer.ResultString() << std::endl;
+
+  if (drives.empty()) {
+    return 1;
+  }
+
+  size_t                        jobCount=drives.size()*args.repeat;
+  std::atomic<size_t>           nextJob{0};
+  std::vector<WorkerStatistics> statistics(args.threads);
+  std::vector<std::thread>      workers;
+
+  osmscout::StopClock replayTimer;
+
+  for (size_t i=0; i<args.threads; i++) {
+    workers.emplace_back([&,i]() {
+      for (size_t job=nextJob++; job<jobCount; job=nextJob++) {
+        ReplayDrive(database,drives[job%drives.size()],statistics[i]);
+      }
+    });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  replayTimer.Stop();
+
+  WorkerStatistics total;
+
+  for (const auto& workerStatistics : statistics) {
+    for (size_t i=0; i<agentNames.size(); i++) {
+      total.agents[i].Merge(workerStatistics.agents[i]);
+    }
+    total.engine.Merge(workerStatistics.engine);
+    total.resultMessages+=workerStatistics.resultMessages;
+  }
+
+  double seconds=replayTimer.GetMilliseconds()/1000.0;
+
+  std::cout << "Replayed " << jobCount << " drives on " << args.threads << " threads in " << replayTimer.ResultString() << std::endl;
+  std::cout << "Input messages: " << total.engine.GetCount()
+            << " (" << std::fixed << std::setprecision(0) << double(total.engine.GetCount())/std::max(seconds,0.001) << "/s)"
+            << ", result messages: " << total.resultMessages << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::left << std::setw(22) << "Agent" << std::right
+            << std::setw(10) << "calls"
+            << std::setw(12) << "mean µs"
+            << std::setw(12) << "p50 µs"
+            << std::setw(12) << "p90 µs"
+            << std::setw(12) << "p99 µs"
+            << std::setw(12) << "max µs"
+            << std::setw(12) << "total ms"
+            << std::endl;
+
+  for (size_t i=0; i<agentNames.size(); i++) {
+    DumpHistogram(agentNames[i],total.agents[i]);
+  }
+
+  DumpHistogram("NavigationEngine",total.engine);
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+  SrtmTerrain - a demo program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+  Generates the terrain data file (precomputed contour lines and hill shading) of a
+  database from all hgt files in the given SRTM directory.
+
+  > SrtmTerrain ~/Documents/SRTM ~/maps/germany 25 300
+  N50E007.hgt: 3021 contour lines, 300x300 hill shading (1.200 s)
+  ...
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <osmscout/elevation/SRTM.h>
+#include <osmscout/elevation/TerrainDataFile.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/Exception.h>
+#include <osmscout/util/StopClock.h>
+
+struct Patch
+{
+  std::string filename;
+  int         lat;
+  int         lon;
+};
+
+static std::vector<Patch> GetPatches(const std::string& srtmDirectory)
+{
+  std::regex         pattern("([NS])(\\d{2})([EW])(\\d{3})\\.hgt",std::regex::icase);
+  std::vector<Patch> patches;
+
+  for (const auto& entry : std::filesystem::directory_iterator(srtmDirectory)) {
+    std::string filename=entry.path().filename().string();
+    std::smatch match;
+
+    if (!entry.is_regular_file() ||
+        !std::regex_match(filename,match,pattern)) {
+      continue;
+    }
+
+    int lat=std::stoi(match[2].str());
+    int lon=std::stoi(match[4].str());
+
+    if (match[1].str()=="S" || match[1].str()=="s") {
+      lat=-lat;
+    }
+
+    if (match[3].str()=="W" || match[3].str()=="w") {
+      lon=-lon;
+    }
+
+    patches.push_back({filename,lat,lon});
+  }
+
+  std::sort(patches.begin(),patches.end(),[](const Patch& a, const Patch& b) {
+    return a.filename<b.filename;
+  });
+
+  return patches;
+}
+
+int main(int argc,
+         char* argv[])
+{
+  if (argc<3 || argc>5) {
+    std::cout << "SrtmTerrain <SRTM directory> <database directory> [contour interval in m] [hill shading cells per degree]" << std::endl;
+    return 1;
+  }
+
+  std::string srtmDirectory=argv[1];
+  std::string databaseDirectory=argv[2];
+  int32_t     contourInterval=osmscout::TerrainTile::DefaultContourInterval;
+  size_t      hillShadeCells=osmscout::TerrainTile::DefaultHillShadeCells;
+
+  if (argc>3) {
+    contourInterval=std::stoi(argv[3]);
+  }
+
+  if (argc>4) {
+    hillShadeCells=std::stoul(argv[4]);
+  }
+
+  osmscout::log.Info(false);
+
+  std::vector<Patch> patches;
+
+  try {
+    patches=GetPatches(srtmDirectory);
+  }
+  catch (const std::filesystem::filesystem_error& e) {
+    std::cerr << "Cannot read SRTM directory: " << e.what() << std::endl;
+    return 1;
+  }
+
+  if (patches.empty()) {
+    std::cerr << "No hgt files in '" << srtmDirectory << "'" << std::endl;
+    return 1;
+  }
+
+  osmscout::SRTM                  srtm(srtmDirectory,1);
+  osmscout::TerrainDataFileWriter writer;
+
+  try {
+    writer.Open(databaseDirectory);
+
+    for (const auto& patch : patches) {
+      osmscout::StopClock   stopClock;
+      osmscout::GeoBox      patchBox(osmscout::GeoCoord(patch.lat+0.25,patch.lon+0.25),
+                                     osmscout::GeoCoord(patch.lat+0.75,patch.lon+0.75));
+      osmscout::SRTMDataRef data=srtm.GetHeightInBoundingBox(patchBox);
+
+      if (!data) {
+        std::cerr << patch.filename << ": cannot be read, skipped" << std::endl;
+        continue;
+      }
+
+      osmscout::TerrainTileRef tile=osmscout::TerrainTile::Generate(*data,
+                                                                    contourInterval,
+                                                                    hillShadeCells);
+
+      writer.Write(*tile);
+
+      stopClock.Stop();
+
+      std::cout << patch.filename << ": " << tile->contourLines.size() << " contour lines, "
+                << tile->hillShadeColumns << "x" << tile->hillShadeRows << " hill shading ("
+                << stopClock.ResultString() << " s)" << std::endl;
+    }
+
+    writer.Close();
+  }
+  catch (const osmscout::IOException& e) {
+    std::cerr << e.GetDescription() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
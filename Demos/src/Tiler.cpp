@@ -17,14 +17,32 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
-#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#if defined(HAVE_LIB_PNG)
+  #include <png.h>
+#endif
 
 #include <osmscout/db/Database.h>
 
+#include <osmscout/async/ProcessingQueue.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileWriter.h>
+
 #include <osmscout/projection/TileProjection.h>
 
 #include <osmscout/util/StopClock.h>
+#include <osmscout/util/String.h>
 #include <osmscout/util/Tiling.h>
 #include <osmscout/cli/CmdLineParsing.h>
 
@@ -37,34 +55,99 @@
   level directory), drawing the "Ruhrgebiet":
 
   src/Tiler ../maps/nordrhein-westfalen ../stylesheets/standard.oss 51.2 6.5 51.7 8 10 13
+
+  Tiles are rendered in metatiles of n x n tiles (see --metatile). Data is loaded and
+  labels are placed once per metatile, the result is then cut into the individual tiles.
+  Every render thread uses its own painter, all threads share the data tile cache of the
+  MapService. Image encoding and writing is done by a separate pool of encoder threads.
+
+  The tiles are written as "<output>/<level>/<x>/<y>.png" (or ".ppm", if libpng is not
+  available). Finished metatiles are recorded in "<output>/tiler.progress". Using
+  --resume, metatiles listed in this file are skipped. Since the metatiles are clipped
+  to the requested tile range, this only works for a run with the same bounding box,
+  levels and metatile size. Metatiles, for which data could not be loaded, are not
+  rendered and not recorded.
 */
 
 static const unsigned int tileWidth=256;
 static const unsigned int tileHeight=256;
 static const double       DPI=96.0;
-static const int          tileRingSize=1;
+static const uint32_t     tileRingSize=1;
+
+#if defined(HAVE_LIB_PNG)
+static const char* const  tileExtension=".png";
 
-bool write_ppm(const agg::rendering_buffer& buffer,
-               const char* file_name)
+static void WritePNGData(png_structp png,
+                         png_bytep data,
+                         png_size_t length)
 {
-  FILE* fd=fopen(file_name, "wb");
+  auto* buffer=static_cast<std::vector<char>*>(png_get_io_ptr(png));
 
-  if (fd) {
-    fprintf(fd,"P6 %d %d 255\n", buffer.width(),buffer.height());
+  buffer->insert(buffer->end(),
+                 reinterpret_cast<const char*>(data),
+                 reinterpret_cast<const char*>(data)+length);
+}
 
-    for (size_t y=0; y<buffer.height();y++)
-    {
-      const unsigned char* row=buffer.row_ptr(y);
+static bool EncodeTile(const std::vector<unsigned char>& rgb,
+                       std::vector<char>& buffer)
+{
+  png_structp png=png_create_write_struct(PNG_LIBPNG_VER_STRING,
+                                          nullptr,nullptr,nullptr);
 
-      fwrite(row,1,buffer.width()*3,fd);
-    }
+  if (png==nullptr) {
+    return false;
+  }
 
-    fclose(fd);
-    return true;
+  png_infop info=png_create_info_struct(png);
+
+  if (info==nullptr) {
+    png_destroy_write_struct(&png,nullptr);
+    return false;
+  }
+
+  std::vector<png_bytep> rowPointers(tileHeight);
+
+  for (size_t y=0; y<tileHeight; y++) {
+    rowPointers[y]=const_cast<png_bytep>(rgb.data()+y*tileWidth*3);
   }
 
-  return false;
+  if (setjmp(png_jmpbuf(png))) {
+    png_destroy_write_struct(&png,&info);
+    return false;
+  }
+
+  buffer.clear();
+
+  png_set_write_fn(png,&buffer,WritePNGData,nullptr);
+  png_set_IHDR(png,info,
+               tileWidth,tileHeight,
+               8,
+               PNG_COLOR_TYPE_RGB,
+               PNG_INTERLACE_NONE,
+               PNG_COMPRESSION_TYPE_DEFAULT,
+               PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png,info);
+  png_write_image(png,rowPointers.data());
+  png_write_end(png,info);
+
+  png_destroy_write_struct(&png,&info);
+
+  return true;
 }
+#else
+static const char* const  tileExtension=".ppm";
+
+static bool EncodeTile(const std::vector<unsigned char>& rgb,
+                       std::vector<char>& buffer)
+{
+  std::string header="P6 "+std::to_string(tileWidth)+" "+std::to_string(tileHeight)+" 255\n";
+
+  buffer.assign(header.begin(),header.end());
+  buffer.insert(buffer.end(),rgb.begin(),rgb.end());
+
+  return true;
+}
+#endif
 
 void MergeTilesToMapData(const std::list<osmscout::TileRef>& centerTiles,
                          const osmscout::MapService::TypeDefinition& ringTypeDefinition,
@@ -178,6 +261,169 @@ void MergeTilesToMapData(const std::list<osmscout::TileRef>& centerTiles,
   }
 }
 
+/**
+ * Return the types of the given magnification, that might have labels. Objects of these types
+ * are also loaded for the ring of tiles around the metatile, so that labels crossing the
+ * metatile border are drawn consistently.
+ */
+static osmscout::MapService::TypeDefinition GetLabelTypeDefinition(const osmscout::TypeConfig& typeConfig,
+                                                                   const osmscout::StyleConfig& styleConfig,
+                                                                   const osmscout::AreaSearchParameter& searchParameter,
+                                                                   const osmscout::Magnification& magnification)
+{
+  osmscout::MapService::TypeDefinition typeDefinition;
+
+  for (const auto& type : typeConfig.GetTypes()) {
+    bool hasLabel=false;
+
+    if (type->CanBeNode()) {
+      if (styleConfig.HasNodeTextStyles(type,
+                                        magnification)) {
+        typeDefinition.nodeTypes.Set(type);
+        hasLabel=true;
+      }
+    }
+
+    if (type->CanBeArea()) {
+      if (styleConfig.HasAreaTextStyles(type,
+                                        magnification)) {
+        if (type->GetOptimizeLowZoom() && searchParameter.GetUseLowZoomOptimization()) {
+          typeDefinition.optimizedAreaTypes.Set(type);
+        }
+        else {
+          typeDefinition.areaTypes.Set(type);
+        }
+
+        hasLabel=true;
+      }
+    }
+
+    if (hasLabel) {
+      osmscout::log.Debug() << "Type " << type->GetName() << " might have labels";
+    }
+  }
+
+  return typeDefinition;
+}
+
+/**
+ * A block of tiles rendered at once
+ */
+struct MetaTile
+{
+  osmscout::MagnificationLevel level;
+  osmscout::OSMTileIdBox       tiles;
+
+  /**
+   * Key of the metatile in the progress log. The tile box is clipped to the requested
+   * tile range, so keys only match between runs with the same bounding box and metatile size.
+   */
+  std::string GetKey() const
+  {
+    return std::to_string(level.Get())+" "+
+           std::to_string(tiles.GetMinX())+" "+std::to_string(tiles.GetMinY())+" "+
+           std::to_string(tiles.GetMaxX())+" "+std::to_string(tiles.GetMaxY());
+  }
+};
+
+/**
+ * List of finished metatiles, persisted in a file, to allow resuming an interrupted run
+ */
+class ProgressLog
+{
+private:
+  std::mutex            mutex;
+  std::set<std::string> finished;
+  std::ofstream         stream;
+
+public:
+  bool Open(const std::string& filename,
+            bool resume)
+  {
+    if (resume) {
+      std::ifstream input(filename);
+      std::string   line;
+
+      while (std::getline(input,line)) {
+        if (!line.empty()) {
+          finished.insert(line);
+        }
+      }
+    }
+
+    stream.open(filename,resume ? std::ios::app : std::ios::trunc);
+
+    return stream.is_open();
+  }
+
+  bool IsFinished(const MetaTile& metaTile) const
+  {
+    return finished.find(metaTile.GetKey())!=finished.end();
+  }
+
+  void MarkFinished(const MetaTile& metaTile)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    // Flush every entry, so that the log is complete if the process gets killed
+    stream << metaTile.GetKey() << std::endl;
+  }
+};
+
+/**
+ * Number of tiles of a metatile, that are not yet written
+ */
+struct MetaTileState
+{
+  MetaTile            metaTile;
+  std::atomic<size_t> remainingTiles;
+  std::atomic<bool>   success{true};
+
+  explicit MetaTileState(const MetaTile& metaTile)
+  : metaTile(metaTile),
+    remainingTiles(metaTile.tiles.GetCount())
+  {
+  }
+};
+
+using MetaTileStateRef = std::shared_ptr<MetaTileState>;
+
+/**
+ * A rendered tile, waiting for encoding and writing
+ */
+struct RenderedTile
+{
+  osmscout::OSMTileId        tile;
+  std::vector<unsigned char> rgb;
+  MetaTileStateRef           state;
+};
+
+struct Statistics
+{
+  size_t metaTileCount=0;
+  size_t skippedMetaTileCount=0;
+  size_t failedMetaTileCount=0;
+  size_t tileCount=0;
+  size_t byteCount=0;
+  double loadTime=0.0;
+  double renderTime=0.0;
+  double encodeTime=0.0;
+  double writeTime=0.0;
+
+  void Add(const Statistics& other)
+  {
+    metaTileCount+=other.metaTileCount;
+    skippedMetaTileCount+=other.skippedMetaTileCount;
+    failedMetaTileCount+=other.failedMetaTileCount;
+    tileCount+=other.tileCount;
+    byteCount+=other.byteCount;
+    loadTime+=other.loadTime;
+    renderTime+=other.renderTime;
+    encodeTime+=other.encodeTime;
+    writeTime+=other.writeTime;
+  }
+};
+
 struct Arguments {
   bool help{false};
   bool debug{false};
@@ -188,6 +434,12 @@ struct Arguments {
   osmscout::MagnificationLevel endZoom{20};
   osmscout::GeoCoord coordTopLeft;
   osmscout::GeoCoord coordBottomRight;
+  std::string output{"."};
+  size_t threads{std::max((unsigned int)1,std::thread::hardware_concurrency())};
+  size_t encoderThreads{std::max((unsigned int)1,std::thread::hardware_concurrency()/2)};
+  size_t metaTileSize{8};
+  size_t cacheSize{1000};
+  bool resume{false};
 };
 
 int main(int argc, char* argv[])
@@ -214,6 +466,42 @@ int main(int argc, char* argv[])
                       "font",
                       "Used font, default: " + args.font,
                       false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.output=value;
+                      }),
+                      "output",
+                      "Output directory, default: " + args.output,
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.threads=value;
+                      }),
+                      "threads",
+                      "Number of render threads, default: " + std::to_string(args.threads),
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.encoderThreads=value;
+                      }),
+                      "encoder-threads",
+                      "Number of image encoding threads, default: " + std::to_string(args.encoderThreads),
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.metaTileSize=value;
+                      }),
+                      "metatile",
+                      "Width and height of a metatile in tiles, default: " + std::to_string(args.metaTileSize),
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.cacheSize=value;
+                      }),
+                      "cache-size",
+                      "Number of cached data tiles, default: " + std::to_string(args.cacheSize),
+                      false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.resume=value;
+                      }),
+                      "resume",
+                      "Skip metatiles finished by a previous run",
+                      false);
 
   argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
                             args.databaseDirectory=value;
@@ -258,6 +546,10 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  args.threads=std::max(size_t(1),args.threads);
+  args.encoderThreads=std::max(size_t(1),args.encoderThreads);
+  args.metaTileSize=std::max(size_t(1),args.metaTileSize);
+
   osmscout::log.Debug(args.debug);
 
   osmscout::DatabaseParameter databaseParameter;
@@ -276,7 +568,23 @@ int main(int argc, char* argv[])
     std::cerr << "Cannot open style" << std::endl;
   }
 
-  osmscout::TileProjection      projection;
+  std::error_code error;
+
+  std::filesystem::create_directories(args.output,error);
+
+  if (error) {
+    std::cerr << "Cannot create output directory '" << args.output << "': " << error.message() << std::endl;
+    return 1;
+  }
+
+  ProgressLog progressLog;
+
+  if (!progressLog.Open(osmscout::AppendFileToDir(args.output,"tiler.progress"),
+                        args.resume)) {
+    std::cerr << "Cannot open progress file in '" << args.output << "'" << std::endl;
+    return 1;
+  }
+
   osmscout::MapParameter        drawParameter;
   osmscout::AreaSearchParameter searchParameter;
 
@@ -289,188 +597,312 @@ int main(int argc, char* argv[])
   searchParameter.SetUseLowZoomOptimization(true);
   searchParameter.SetMaximumAreaLevel(3);
 
-  osmscout::MapPainterAgg painter;
+  // Every render thread needs the data tiles of its metatile and the surrounding ring in the cache
+  uint32_t metaTileSize=uint32_t(args.metaTileSize);
 
-  for (osmscout::MagnificationLevel level=osmscout::MagnificationLevel(std::min(args.startZoom,args.endZoom));
-       level<=osmscout::MagnificationLevel(std::max(args.startZoom,args.endZoom));
-       level++) {
-    osmscout::Magnification magnification(level);
+  mapService->SetCacheSize(std::max(args.cacheSize,
+                                    args.threads*(args.metaTileSize+2*tileRingSize)*(args.metaTileSize+2*tileRingSize)));
 
-    osmscout::OSMTileId     tileA(osmscout::OSMTileId::GetOSMTile(magnification,
-                                                                  args.coordBottomRight));
-    osmscout::OSMTileId     tileB(osmscout::OSMTileId::GetOSMTile(magnification,
-                                                                  args.coordTopLeft));
-    uint32_t                xTileStart=std::min(tileA.GetX(),tileB.GetX());
-    uint32_t                xTileEnd=std::max(tileA.GetX(),tileB.GetX());
-    uint32_t                xTileCount=xTileEnd-xTileStart+1;
-    uint32_t                yTileStart=std::min(tileA.GetY(),tileB.GetY());
-    uint32_t                yTileEnd=std::max(tileA.GetY(),tileB.GetY());
-    uint32_t                yTileCount=yTileEnd-yTileStart+1;
+  osmscout::MagnificationLevel minLevel(std::min(args.startZoom,args.endZoom));
+  osmscout::MagnificationLevel maxLevel(std::max(args.startZoom,args.endZoom));
 
-    std::cout << "Drawing zoom " << level << ", " << (xTileCount)*(yTileCount) << " tiles [" << xTileStart << "," << yTileStart << " - " <<  xTileEnd << "," << yTileEnd << "]" << std::endl;
+  std::vector<osmscout::MapService::TypeDefinition> labelTypeDefinitions;
+  std::vector<MetaTile>                             metaTiles;
+  Statistics                                        statistics;
 
-    unsigned long bitmapSize=tileWidth*tileHeight*3*xTileCount*yTileCount;
-    unsigned char *buffer=new unsigned char[bitmapSize];
+  // Metatiles are aligned to multiples of the metatile size and clipped to the requested area,
+  // so that metatiles of different runs (and different bounding boxes) match
+  for (osmscout::MagnificationLevel level=minLevel; level<=maxLevel; level++) {
+    osmscout::Magnification magnification(level);
+    osmscout::OSMTileIdBox  tiles(osmscout::OSMTileId::GetOSMTile(magnification,
+                                                                  args.coordBottomRight),
+                                  osmscout::OSMTileId::GetOSMTile(magnification,
+                                                                  args.coordTopLeft));
 
+    std::cout << "Zoom " << level << ", " << tiles.GetCount() << " tiles " << tiles.GetDisplayText() << std::endl;
 
-    memset(buffer,0,bitmapSize);
+    labelTypeDefinitions.push_back(GetLabelTypeDefinition(*database->GetTypeConfig(),
+                                                          *styleConfig,
+                                                          searchParameter,
+                                                          magnification));
 
-    agg::rendering_buffer rbuf(buffer,
-                               tileWidth*xTileCount,
-                               tileHeight*yTileCount,
-                               tileWidth*xTileCount*3);
+    for (uint32_t y=tiles.GetMinY()/metaTileSize*metaTileSize; y<=tiles.GetMaxY(); y+=metaTileSize) {
+      for (uint32_t x=tiles.GetMinX()/metaTileSize*metaTileSize; x<=tiles.GetMaxX(); x+=metaTileSize) {
+        MetaTile metaTile{level,
+                          osmscout::OSMTileIdBox(osmscout::OSMTileId(std::max(x,tiles.GetMinX()),
+                                                                     std::max(y,tiles.GetMinY())),
+                                                 osmscout::OSMTileId(std::min(x+metaTileSize-1,tiles.GetMaxX()),
+                                                                     std::min(y+metaTileSize-1,tiles.GetMaxY())))};
 
-    double minTime=std::numeric_limits<double>::max();
-    double maxTime=0.0;
-    double totalTime=0.0;
+        if (progressLog.IsFinished(metaTile)) {
+          statistics.skippedMetaTileCount++;
+          continue;
+        }
 
-    osmscout::MapService::TypeDefinition typeDefinition;
+        metaTiles.push_back(metaTile);
+      }
+    }
+  }
 
-    for (const auto& type : database->GetTypeConfig()->GetTypes()) {
-      bool hasLabel=false;
+  std::cout << "Rendering " << metaTiles.size() << " metatile(s) using " << args.threads
+            << " render and " << args.encoderThreads << " encoder thread(s)";
 
-      if (type->CanBeNode()) {
-        if (styleConfig->HasNodeTextStyles(type,
-                                           magnification)) {
-          typeDefinition.nodeTypes.Set(type);
-          hasLabel=true;
-        }
-      }
+  if (statistics.skippedMetaTileCount>0) {
+    std::cout << ", skipping " << statistics.skippedMetaTileCount << " finished metatile(s)";
+  }
 
-      if (type->CanBeArea()) {
-        if (styleConfig->HasAreaTextStyles(type,
-                                           magnification)) {
-          if (type->GetOptimizeLowZoom() && searchParameter.GetUseLowZoomOptimization()) {
-            typeDefinition.optimizedAreaTypes.Set(type);
-          }
-          else {
-            typeDefinition.areaTypes.Set(type);
-          }
-
-          hasLabel=true;
-        }
+  std::cout << std::endl;
+
+  // Limit the number of tiles waiting for encoding, to bound memory usage
+  osmscout::ProcessingQueue<RenderedTile> encoderQueue(args.encoderThreads*args.metaTileSize*args.metaTileSize);
+  std::atomic<size_t>                     nextMetaTile{0};
+  std::atomic<bool>                       success{true};
+  std::mutex                              statisticsMutex;
+  osmscout::StopClock                     totalTimer;
+
+  auto renderer=[&]() {
+    osmscout::MapPainterAgg    painter;
+    osmscout::TileProjection   projection;
+    std::vector<unsigned char> buffer;
+    Statistics                 workerStatistics;
+
+    for (size_t index=nextMetaTile++; index<metaTiles.size() && success; index=nextMetaTile++) {
+      const MetaTile&         metaTile=metaTiles[index];
+      osmscout::Magnification magnification(metaTile.level);
+      size_t                  width=tileWidth*metaTile.tiles.GetWidth();
+      size_t                  height=tileHeight*metaTile.tiles.GetHeight();
+
+      osmscout::log.Debug() << "Drawing metatile " << metaTile.level.Get() << " " << metaTile.tiles.GetDisplayText();
+
+      osmscout::StopClock loadTimer;
+
+      projection.Set(metaTile.tiles,
+                     magnification,
+                     DPI,
+                     width,
+                     height);
+
+      std::list<osmscout::TileRef> centerTiles;
+
+      mapService->LookupTiles(magnification,
+                              projection.GetDimensions(),
+                              centerTiles);
+
+      if (!mapService->LoadMissingTileData(searchParameter,
+                                           *styleConfig,
+                                           centerTiles)) {
+        osmscout::log.Error() << "Cannot load data for metatile " << metaTile.level.Get() << " " << metaTile.tiles.GetDisplayText();
+        workerStatistics.failedMetaTileCount++;
+        continue;
       }
 
-      if (hasLabel) {
-        std::cout << "TYPE " << type->GetName() << " might have labels" << std::endl;
-      }
-    }
+      uint32_t               maxTile=(uint32_t(1) << metaTile.level.Get())-1;
+      osmscout::OSMTileIdBox ringBox(osmscout::OSMTileId(metaTile.tiles.GetMinX()-std::min(metaTile.tiles.GetMinX(),tileRingSize),
+                                                         metaTile.tiles.GetMinY()-std::min(metaTile.tiles.GetMinY(),tileRingSize)),
+                                     osmscout::OSMTileId(std::min(metaTile.tiles.GetMaxX()+tileRingSize,maxTile),
+                                                         std::min(metaTile.tiles.GetMaxY()+tileRingSize,maxTile)));
 
-    for (uint32_t y=yTileStart; y<=yTileEnd; y++) {
-      for (uint32_t x=xTileStart; x<=xTileEnd; x++) {
-        agg::pixfmt_rgb24   pf(rbuf);
-        osmscout::StopClock timer;
-        osmscout::MapData   data;
+      std::set<osmscout::TileKey>  centerTileKeys;
+      std::list<osmscout::TileRef> ringTiles;
 
-        data.styleConfig = styleConfig;
+      for (const auto& tile : centerTiles) {
+        centerTileKeys.insert(tile->GetKey());
+      }
 
-        projection.Set(osmscout::OSMTileId(x,y),
-                       magnification,
-                       DPI,
-                       tileWidth,
-                       tileHeight);
+      mapService->LookupTiles(magnification,
+                              ringBox.GetBoundingBox(magnification),
+                              ringTiles);
+
+      ringTiles.remove_if([&centerTileKeys](const osmscout::TileRef& tile) {
+        return centerTileKeys.find(tile->GetKey())!=centerTileKeys.end();
+      });
+
+      if (!mapService->LoadMissingTileData(searchParameter,
+                                           magnification,
+                                           labelTypeDefinitions[metaTile.level.Get()-minLevel.Get()],
+                                           ringTiles)) {
+        osmscout::log.Error() << "Cannot load label data for metatile " << metaTile.level.Get() << " " << metaTile.tiles.GetDisplayText();
+        workerStatistics.failedMetaTileCount++;
+        continue;
+      }
 
-        osmscout::GeoBox boundingBox(projection.GetDimensions());
+      std::vector<osmscout::MapData> dataList(1);
 
-        std::cout << "Drawing tile " << level << "." << y << "." << x << " " << boundingBox.GetDisplayText() << std::endl;
+      dataList.front().styleConfig=styleConfig;
 
+      MergeTilesToMapData(centerTiles,
+                          labelTypeDefinitions[metaTile.level.Get()-minLevel.Get()],
+                          ringTiles,
+                          dataList.front());
 
-        std::list<osmscout::TileRef> centerTiles;
+      loadTimer.Stop();
 
-        mapService->LookupTiles(magnification,
-                                boundingBox,
-                                centerTiles);
+      osmscout::StopClock renderTimer;
 
-        mapService->LoadMissingTileData(searchParameter,
-                                        *styleConfig,
-                                        centerTiles);
+      buffer.assign(width*height*3,0);
 
-        std::map<osmscout::TileKey,osmscout::TileRef> ringTileMap;
+      agg::rendering_buffer rbuf(buffer.data(),
+                                 unsigned(width),
+                                 unsigned(height),
+                                 int(width*3));
+      agg::pixfmt_rgb24     pf(rbuf);
 
-        for (uint32_t ringY=y-tileRingSize; ringY<=y+tileRingSize; ringY++) {
-          for (uint32_t ringX=x-tileRingSize; ringX<=x+tileRingSize; ringX++) {
-            if (ringX==x && ringY==y) {
-              continue;
-            }
+      if (!painter.DrawMap(projection,
+                           drawParameter,
+                           dataList,
+                           &pf)) {
+        osmscout::log.Error() << "Cannot draw metatile " << metaTile.level.Get() << " " << metaTile.tiles.GetDisplayText();
+        success=false;
+        break;
+      }
 
-            osmscout::GeoBox boundingBox(osmscout::OSMTileId(ringX,ringY).GetBoundingBox(magnification));
+      renderTimer.Stop();
 
+      workerStatistics.metaTileCount++;
+      workerStatistics.loadTime+=loadTimer.GetMilliseconds();
+      workerStatistics.renderTime+=renderTimer.GetMilliseconds();
 
-            std::list<osmscout::TileRef> tiles;
+      // Cut the metatile into tiles and pass them to the encoder threads
+      auto state=std::make_shared<MetaTileState>(metaTile);
 
-            mapService->LookupTiles(magnification,
-                                    boundingBox,
-                                    tiles);
+      for (const auto& tile : metaTile.tiles) {
+        RenderedTile renderedTile{tile,
+                                  std::vector<unsigned char>(tileWidth*tileHeight*3),
+                                  state};
+        size_t       xOffset=(tile.GetX()-metaTile.tiles.GetMinX())*tileWidth*3;
+        size_t       yOffset=(tile.GetY()-metaTile.tiles.GetMinY())*tileHeight;
 
-            for (const auto& tile : tiles) {
-              ringTileMap[tile->GetKey()]=tile;
-            }
-          }
+        for (size_t row=0; row<tileHeight; row++) {
+          std::memcpy(renderedTile.rgb.data()+row*tileWidth*3,
+                      buffer.data()+(yOffset+row)*width*3+xOffset,
+                      tileWidth*3);
         }
 
-        std::list<osmscout::TileRef> ringTiles;
+        encoderQueue.PushTask(std::move(renderedTile));
+      }
+    }
 
-        for (const auto& tileEntry : ringTileMap) {
-          ringTiles.push_back(tileEntry.second);
-        }
+    std::scoped_lock<std::mutex> lock(statisticsMutex);
 
-        mapService->LoadMissingTileData(searchParameter,
-                                        magnification,
-                                        typeDefinition,
-                                        ringTiles);
+    statistics.Add(workerStatistics);
+  };
 
-        MergeTilesToMapData(centerTiles,
-                            typeDefinition,
-                            ringTiles,
-                            data);
+  auto encoder=[&]() {
+    std::vector<char> data;
+    Statistics        workerStatistics;
 
-        size_t bufferOffset=xTileCount*tileWidth*3*(y-yTileStart)*tileHeight+
-                            (x-xTileStart)*tileWidth*3;
+    while (auto renderedTile=encoderQueue.PopTask()) {
+      const MetaTile& metaTile=renderedTile->state->metaTile;
 
-        rbuf.attach(buffer+bufferOffset,
-                    tileWidth,tileHeight,
-                    tileWidth*xTileCount*3);
+      osmscout::StopClock encodeTimer;
 
-        std::vector<osmscout::MapData> dataList;
-        dataList.emplace_back(std::move(data));
-        painter.DrawMap(projection,
-                        drawParameter,
-                        dataList,
-                        &pf);
+      if (!EncodeTile(renderedTile->rgb,data)) {
+        osmscout::log.Error() << "Cannot encode tile " << metaTile.level.Get() << " " << renderedTile->tile.GetDisplayText();
+        renderedTile->state->success=false;
+        success=false;
+      }
 
-        timer.Stop();
+      encodeTimer.Stop();
 
-        double time=timer.GetMilliseconds();
+      osmscout::StopClock writeTimer;
+      std::string         directory=osmscout::AppendFileToDir(osmscout::AppendFileToDir(args.output,
+                                                                                        std::to_string(metaTile.level.Get())),
+                                                              std::to_string(renderedTile->tile.GetX()));
+      osmscout::FileWriter writer;
 
-        minTime=std::min(minTime,time);
-        maxTime=std::max(maxTime,time);
-        totalTime+=time;
+      try {
+        std::filesystem::create_directories(directory);
 
-        std::string output=std::to_string(level.Get())+"_"+std::to_string(x)+"_"+std::to_string(y)+".ppm";
+        writer.Open(osmscout::AppendFileToDir(directory,
+                                              std::to_string(renderedTile->tile.GetY())+tileExtension));
+        writer.Write(data.data(),
+                     data.size());
+        writer.Close();
+      }
+      catch (osmscout::IOException& e) {
+        osmscout::log.Error() << e.GetDescription();
+        writer.CloseFailsafe();
+        renderedTile->state->success=false;
+        success=false;
+      }
+      catch (std::filesystem::filesystem_error& e) {
+        osmscout::log.Error() << "Cannot create directory '" << directory << "': " << e.what();
+        renderedTile->state->success=false;
+        success=false;
+      }
 
-        write_ppm(rbuf,output.c_str());
+      writeTimer.Stop();
+
+      workerStatistics.tileCount++;
+      workerStatistics.byteCount+=data.size();
+      workerStatistics.encodeTime+=encodeTimer.GetMilliseconds();
+      workerStatistics.writeTime+=writeTimer.GetMilliseconds();
+
+      if (--renderedTile->state->remainingTiles==0 &&
+          renderedTile->state->success) {
+        progressLog.MarkFinished(metaTile);
       }
     }
 
-    rbuf.attach(buffer,
-                tileWidth*xTileCount,
-                tileHeight*yTileCount,
-                tileWidth*xTileCount*3);
+    std::scoped_lock<std::mutex> lock(statisticsMutex);
+
+    statistics.Add(workerStatistics);
+  };
+
+  std::vector<std::thread> encoderThreads;
+  std::vector<std::thread> renderThreads;
+
+  encoderThreads.reserve(args.encoderThreads);
+  for (size_t i=0; i<args.encoderThreads; i++) {
+    encoderThreads.emplace_back(encoder);
+  }
+
+  renderThreads.reserve(args.threads-1);
+  for (size_t i=1; i<args.threads; i++) {
+    renderThreads.emplace_back(renderer);
+  }
 
-    std::string output=std::to_string(level.Get())+"_full_map.ppm";
+  renderer();
 
-    write_ppm(rbuf,output.c_str());
+  for (auto& thread : renderThreads) {
+    thread.join();
+  }
 
-    delete[] buffer;
+  encoderQueue.Stop();
 
-    std::cout << "=> Time: ";
-    std::cout << "total: " << totalTime << " msec ";
-    std::cout << "min: " << minTime << " msec ";
-    std::cout << "avg: " << totalTime/(xTileCount*yTileCount) << " msec ";
-    std::cout << "max: " << maxTime << " msec" << std::endl;
+  for (auto& thread : encoderThreads) {
+    thread.join();
   }
 
+  totalTimer.Stop();
+
   database->Close();
 
+  double totalTime=totalTimer.GetMilliseconds();
+
+  std::cout << "=> Metatiles: " << statistics.metaTileCount << " (" << statistics.skippedMetaTileCount << " skipped, "
+            << statistics.failedMetaTileCount << " failed)" << std::endl;
+  std::cout << "=> Tiles:     " << statistics.tileCount << ", " << osmscout::ByteSizeToString(double(statistics.byteCount)) << std::endl;
+  std::cout << "=> Time (summed over all threads): ";
+  std::cout << "load: " << statistics.loadTime << " msec ";
+  std::cout << "render: " << statistics.renderTime << " msec ";
+  std::cout << "encode: " << statistics.encodeTime << " msec ";
+  std::cout << "write: " << statistics.writeTime << " msec" << std::endl;
+
+  if (statistics.metaTileCount>0) {
+    std::cout << "=> Time per metatile: ";
+    std::cout << "load: " << statistics.loadTime/double(statistics.metaTileCount) << " msec ";
+    std::cout << "render: " << statistics.renderTime/double(statistics.metaTileCount) << " msec" << std::endl;
+  }
+
+  std::cout << "=> Total: " << totalTime << " msec, ";
+  std::cout << (totalTime>0.0 ? size_t(double(statistics.tileCount)*1000.0/totalTime) : 0) << " tiles/s" << std::endl;
+
+  if (!success ||
+      statistics.failedMetaTileCount>0) {
+    std::cerr << "Tile generation failed" << std::endl;
+    return 1;
+  }
+
   return 0;
 }
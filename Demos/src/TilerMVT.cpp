@@ -0,0 +1,229 @@
+/*
+  TilerMVT - a demo program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/util/String.h>
+
+#include <osmscoutmap/MapService.h>
+
+#include <osmscoutmapmvt/MVTTiler.h>
+
+/*
+  Example for the nordrhein-westfalen.osm (to be executed in the Demos top
+  level directory), generating vector tiles for the "Ruhrgebiet":
+
+  src/TilerMVT ../maps/nordrhein-westfalen ../stylesheets/standard.oss 51.2 6.5 51.7 8 10 14 ruhrgebiet.mbtiles
+
+  Output files ending with ".mbtiles" are written as MBTiles database, else a directory
+  pyramid "<level>/<x>/<y>.pbf" is created.
+*/
+
+struct Arguments {
+  bool help{false};
+  bool debug{false};
+  size_t threads{std::max((unsigned int)1,std::thread::hardware_concurrency())};
+  size_t cacheSize{1000};
+  bool writeEmptyTiles{false};
+  std::string databaseDirectory{"."};
+  std::string style{"stylesheets/standard.oss"};
+  std::string styleCacheDirectory;
+  osmscout::GeoCoord coordTopLeft;
+  osmscout::GeoCoord coordBottomRight;
+  osmscout::MagnificationLevel startZoom{0};
+  osmscout::MagnificationLevel endZoom{14};
+  std::string output;
+};
+
+int main(int argc, char* argv[])
+{
+  osmscout::CmdLineParser argParser("TilerMVT",
+                                    argc,argv);
+  Arguments               args;
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.help=value;
+                      }),
+                      std::vector<std::string>{"h","help"},
+                      "Display help",
+                      true);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.debug=value;
+                      }),
+                      "debug",
+                      "Enable debug output",
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.threads=value;
+                      }),
+                      "threads",
+                      "Number of worker threads, default: " + std::to_string(args.threads),
+                      false);
+  argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.cacheSize=value;
+                      }),
+                      "cache-size",
+                      "Number of cached data tiles, default: " + std::to_string(args.cacheSize),
+                      false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.writeEmptyTiles=value;
+                      }),
+                      "empty-tiles",
+                      "Write tiles without features",
+                      false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.styleCacheDirectory=value;
+                      }),
+                      "style-cache",
+                      "Directory for caching the resolved stylesheet, speeds up the next start",
+                      false);
+
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.databaseDirectory=value;
+                          }),
+                          "databaseDir",
+                          "Database directory");
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.style=value;
+                          }),
+                          "stylesheet",
+                          "Map stylesheet");
+  argParser.AddPositional(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& coord) {
+                            args.coordTopLeft = coord;
+                          }),
+                          "lat_top lon_left",
+                          "Bounding box top-left coordinate");
+  argParser.AddPositional(osmscout::CmdLineGeoCoordOption([&args](const osmscout::GeoCoord& coord) {
+                            args.coordBottomRight = coord;
+                          }),
+                          "lat_bottom lon_right",
+                          "Bounding box bottom-right coordinate");
+  argParser.AddPositional(osmscout::CmdLineUIntOption([&args](const unsigned int& value) {
+                            args.startZoom=osmscout::MagnificationLevel(value);
+                          }),
+                          "start-zoom",
+                          "Start zoom");
+  argParser.AddPositional(osmscout::CmdLineUIntOption([&args](const unsigned int& value) {
+                            args.endZoom=osmscout::MagnificationLevel(value);
+                          }),
+                          "end-zoom",
+                          "End zoom");
+  argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                            args.output=value;
+                          }),
+                          "output",
+                          "Output directory or MBTiles file (*.mbtiles)");
+
+  osmscout::CmdLineParseResult argResult=argParser.Parse();
+  if (argResult.HasError()) {
+    std::cerr << "ERROR: " << argResult.GetErrorDescription() << std::endl;
+    std::cout << argParser.GetHelp() << std::endl;
+    return 1;
+  }
+
+  if (args.help) {
+    std::cout << argParser.GetHelp() << std::endl;
+    return 0;
+  }
+
+  osmscout::log.Debug(args.debug);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+  osmscout::MapServiceRef     mapService=std::make_shared<osmscout::MapService>(database);
+
+  if (!database->Open(args.databaseDirectory)) {
+    std::cerr << "Cannot open db" << std::endl;
+
+    return 1;
+  }
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+  bool                     styleLoaded;
+
+  if (args.styleCacheDirectory.empty()) {
+    styleLoaded=styleConfig->Load(args.style);
+  }
+  else {
+    std::error_code styleCacheError;
+
+    std::filesystem::create_directories(args.styleCacheDirectory,styleCacheError);
+    styleLoaded=styleConfig->LoadCached(args.style,
+                                        osmscout::StyleConfig::GetCacheFileName(args.styleCacheDirectory,
+                                                                                args.databaseDirectory,
+                                                                                args.style));
+  }
+
+  if (!styleLoaded) {
+    std::cerr << "Cannot open style" << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<osmscout::MVTTileSink> sink;
+
+  if (args.output.ends_with(".mbtiles")) {
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+    sink=std::make_unique<osmscout::MVTMBTilesTileSink>(args.output);
+#else
+    std::cerr << "MBTiles output is not supported, sqlite3 is missing" << std::endl;
+    return 1;
+#endif
+  }
+  else {
+    sink=std::make_unique<osmscout::MVTDirectoryTileSink>(args.output);
+  }
+
+  // Every worker thread needs the data tiles of its tile in the cache
+  mapService->SetCacheSize(std::max(args.cacheSize,args.threads*4));
+
+  osmscout::MVTTiler            tiler(mapService,styleConfig);
+  osmscout::MVTTiler::Statistics statistics;
+
+  tiler.SetThreadCount(args.threads);
+  tiler.SetWriteEmptyTiles(args.writeEmptyTiles);
+  tiler.SetName(args.databaseDirectory);
+
+  bool success=tiler.Process(osmscout::GeoBox(args.coordTopLeft,args.coordBottomRight),
+                             args.startZoom,
+                             args.endZoom,
+                             *sink,
+                             statistics);
+
+  std::cout << "Tiles:    " << statistics.tileCount << " (" << statistics.emptyTileCount << " empty)" << std::endl;
+  std::cout << "Features: " << statistics.featureCount << std::endl;
+  std::cout << "Size:     " << osmscout::ByteSizeToString(double(statistics.byteCount)) << std::endl;
+  std::cout << "Load:     " << statistics.loadTime << " ms" << std::endl;
+  std::cout << "Encode:   " << statistics.encodeTime << " ms" << std::endl;
+  std::cout << "Write:    " << statistics.writeTime << " ms" << std::endl;
+  std::cout << "Total:    " << statistics.totalTime << " ms, " << size_t(statistics.GetTilesPerSecond()) << " tiles/s" << std::endl;
+
+  if (!success) {
+    std::cerr << "Tile generation failed" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+  MCPServer - a demo program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cassert>
+#include <cmath>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/log/Logger.h>
+
+#include "LocationDescriptionPool.h"
+#include "LocationDescriptionMapper.h"
+
+namespace osmscout::mcp {
+
+  LocationDescriptionPool::LocationDescriptionPool(const Parameter& parameter)
+  : parameter(parameter),
+    cache(parameter.cacheSize),
+    pool(std::max(parameter.workerCount,size_t(1)),"LocationDescription")
+  {
+    this->parameter.workerCount=pool.GetThreadCount();
+  }
+
+  /**
+   * Open one database instance for each worker
+   */
+  bool LocationDescriptionPool::Open(const std::string& databaseDirectory)
+  {
+    const DatabaseParameter databaseParameter;
+
+    for (size_t i=0; i<parameter.workerCount; i++) {
+      auto database=std::make_shared<Database>(databaseParameter);
+
+      if (!database->Open(databaseDirectory)) {
+        log.Error() << "Cannot open database '" << databaseDirectory << "'";
+        return false;
+      }
+
+      services.push_back(std::make_shared<LocationDescriptionService>(database));
+    }
+
+    log.Info() << "Opened " << services.size() << " database instance(s), description cache size "
+               << parameter.cacheSize;
+
+    return true;
+  }
+
+  LocationDescriptionServiceRef LocationDescriptionPool::GetThreadService()
+  {
+    std::scoped_lock lock(servicesMutex);
+
+    assert(!services.empty());
+
+    auto [entry,inserted]=threadServices.try_emplace(std::this_thread::get_id());
+
+    if (inserted) {
+      entry->second=services[(threadServices.size()-1)%services.size()];
+    }
+
+    return entry->second;
+  }
+
+  /**
+   * Snap the coordinate to the cache grid and return the cache key of the grid point
+   */
+  uint64_t LocationDescriptionPool::Quantize(const GeoCoord& coord) const
+  {
+    const double grid=parameter.cacheGrid;
+    const auto   latIndex=uint64_t(std::llround((coord.GetLat()+90.0)/grid));
+    const auto   lonIndex=uint64_t(std::llround((coord.GetLon()+180.0)/grid));
+    const auto   columns=uint64_t(std::llround(360.0/grid))+1;
+
+    return latIndex*columns+lonIndex;
+  }
+
+  LocationDescriptionPool::DescriptionRef LocationDescriptionPool::DescribeUncached(const GeoCoord& coord)
+  {
+    LocationDescription description;
+
+    if (!GetThreadService()->DescribeLocation(coord,description)) {
+      return nullptr;
+    }
+
+    nlohmann::json content=nlohmann::json::array();
+    nlohmann::json structured;
+
+    ToJson(description,content,structured);
+
+    auto payload=std::make_shared<nlohmann::json>();
+
+    (*payload)["content"]=std::move(content);
+    (*payload)["structuredContent"]=std::move(structured);
+
+    return payload;
+  }
+
+  /**
+   * Describe the given location. Cached descriptions are returned immediately,
+   * other locations are described by the next free worker.
+   */
+  std::future<LocationDescriptionPool::DescriptionRef> LocationDescriptionPool::Describe(const GeoCoord& coord)
+  {
+    if (!cache.IsActive()) {
+      return pool.Submit([this,coord]() {
+        return DescribeUncached(coord);
+      });
+    }
+
+    const uint64_t key=Quantize(coord);
+
+    {
+      std::scoped_lock           lock(cacheMutex);
+      DescriptionCache::CacheRef entry;
+
+      if (cache.GetEntry(key,entry)) {
+        std::promise<DescriptionRef> promise;
+
+        cacheHits++;
+        promise.set_value(entry->value);
+
+        return promise.get_future();
+      }
+    }
+
+    cacheMisses++;
+
+    // requested location is described, the description is returned
+    // for following requests within the same grid cell
+    return pool.Submit([this,key,coord]() {
+      DescriptionRef description=DescribeUncached(coord);
+
+      if (description) {
+        std::scoped_lock lock(cacheMutex);
+
+        cache.SetEntry(DescriptionCache::CacheEntry(key,description));
+      }
+
+      return description;
+    });
+  }
+
+} // namespace osmscout::mcp
@@ -0,0 +1,119 @@
+#ifndef OSMSCOUT_MCP_LOCATIONDESCRIPTIONPOOL_H
+#define OSMSCOUT_MCP_LOCATIONDESCRIPTIONPOOL_H
+
+/*
+  MCPServer - a demo program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/async/ThreadPool.h>
+
+#include <osmscout/location/LocationDescriptionService.h>
+
+#include <osmscout/util/Cache.h>
+
+#include <nlohmann/json.hpp>
+
+namespace osmscout::mcp {
+
+  /**
+   * Pool of worker threads describing locations.
+   *
+   * Each worker thread uses its own Database and LocationDescriptionService instance,
+   * so concurrent requests do not contend on the file scanners and data caches
+   * of a single database.
+   *
+   * Descriptions are cached in a LRU cache. If the cache is active, coordinates are
+   * snapped to a grid (cacheGrid, in degrees), so all requests within the same grid cell
+   * share one cache entry. On a cache miss the requested location is described,
+   * a cache hit returns the description of the location that was requested first
+   * within the grid cell.
+   */
+  class LocationDescriptionPool
+  {
+  public:
+    /**
+     * Description payload, an object with "content" and "structuredContent", or nullptr
+     * if the location could not be described
+     */
+    using DescriptionRef = std::shared_ptr<const nlohmann::json>;
+
+    struct Parameter
+    {
+      size_t workerCount=std::max(std::thread::hardware_concurrency(),1u);
+      size_t cacheSize=100000; //!< Number of cached descriptions, 0 disables the cache
+      double cacheGrid=0.0001; //!< Grid size in degrees (about 11m in latitude)
+    };
+
+    struct Statistics
+    {
+      size_t cacheHits;
+      size_t cacheMisses;
+    };
+
+  private:
+    using DescriptionCache = Cache<uint64_t,DescriptionRef>;
+
+  private:
+    Parameter                                  parameter;
+    std::vector<LocationDescriptionServiceRef> services;       //!< One service instance per worker
+    std::mutex                                 servicesMutex;
+    std::unordered_map<std::thread::id,
+                       LocationDescriptionServiceRef> threadServices; //!< Service instance assigned to the worker thread
+    std::mutex                                 cacheMutex;
+    DescriptionCache                           cache;
+    std::atomic<size_t>                        cacheHits{0};
+    std::atomic<size_t>                        cacheMisses{0};
+    ThreadPool                                 pool;           //!< Destroyed first, so that running jobs finish before the services are released
+
+  private:
+    LocationDescriptionServiceRef GetThreadService();
+    uint64_t Quantize(const GeoCoord& coord) const;
+    DescriptionRef DescribeUncached(const GeoCoord& coord);
+
+  public:
+    explicit LocationDescriptionPool(const Parameter& parameter);
+
+    bool Open(const std::string& databaseDirectory);
+
+    std::future<DescriptionRef> Describe(const GeoCoord& coord);
+
+    size_t GetWorkerCount() const
+    {
+      return parameter.workerCount;
+    }
+
+    Statistics GetStatistics() const
+    {
+      return {cacheHits,cacheMisses};
+    }
+  };
+
+} // namespace osmscout::mcp
+
+#endif // OSMSCOUT_MCP_LOCATIONDESCRIPTIONPOOL_H
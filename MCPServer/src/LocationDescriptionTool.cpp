@@ -17,34 +17,45 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <future>
+#include <string>
+#include <vector>
+
 #include <osmscout/log/Logger.h>
 
 #include "LocationDescriptionTool.h"
-#include "LocationDescriptionMapper.h"
 
 namespace osmscout::mcp {
 
-  ToolResult HandleLocationDescription(unsigned int id,
-                                       const nlohmann::json& arguments,
-                                       const LocationDescriptionServiceRef& locationDescriptionService)
+  static ToolResult ErrorResult(unsigned int id,
+                                int status,
+                                const std::string& message)
+  {
+    ToolResult result;
+    result.status = status;
+    result.body["jsonrpc"] = "2.0";
+    result.body["id"] = id;
+    result.body["error"]["message"] = message;
+    return result;
+  }
+
+  /**
+   * Parse and validate the "latitude" and "longitude" parameters of the given object.
+   * Returns an empty string on success, else the error message.
+   */
+  static std::string ParseCoordinate(const nlohmann::json& arguments,
+                                     GeoCoord& coord)
   {
-    // Validate required parameters
+    if (!arguments.is_object()) {
+      return "Invalid location, object with latitude and longitude expected";
+    }
+
     if (!arguments.contains("latitude") || !arguments["latitude"].is_number()) {
-      ToolResult result;
-      result.status = 400;
-      result.body["jsonrpc"] = "2.0";
-      result.body["id"] = id;
-      result.body["error"]["message"] = "Missing or invalid required parameter: latitude";
-      return result;
+      return "Missing or invalid required parameter: latitude";
     }
 
     if (!arguments.contains("longitude") || !arguments["longitude"].is_number()) {
-      ToolResult result;
-      result.status = 400;
-      result.body["jsonrpc"] = "2.0";
-      result.body["id"] = id;
-      result.body["error"]["message"] = "Missing or invalid required parameter: longitude";
-      return result;
+      return "Missing or invalid required parameter: longitude";
     }
 
     double latitude = arguments["latitude"];
@@ -52,49 +63,134 @@ namespace osmscout::mcp {
 
     // Validate coordinate range
     if (latitude < -90.0 || latitude > 90.0) {
-      ToolResult result;
-      result.status = 400;
-      result.body["jsonrpc"] = "2.0";
-      result.body["id"] = id;
-      result.body["error"]["message"] = "Latitude out of range (-90 to 90)";
-      return result;
+      return "Latitude out of range (-90 to 90)";
     }
 
     if (longitude < -180.0 || longitude > 180.0) {
-      ToolResult result;
-      result.status = 400;
-      result.body["jsonrpc"] = "2.0";
-      result.body["id"] = id;
-      result.body["error"]["message"] = "Longitude out of range (-180 to 180)";
-      return result;
+      return "Longitude out of range (-180 to 180)";
+    }
+
+    coord = GeoCoord(latitude, longitude);
+
+    return "";
+  }
+
+  ToolResult HandleLocationDescription(unsigned int id,
+                                       const nlohmann::json& arguments,
+                                       LocationDescriptionPool& descriptionPool)
+  {
+    osmscout::GeoCoord location;
+
+    if (std::string error = ParseCoordinate(arguments, location);
+        !error.empty()) {
+      return ErrorResult(id, 400, error);
+    }
+
+    LocationDescriptionPool::DescriptionRef description = descriptionPool.Describe(location).get();
+
+    if (!description) {
+      return ErrorResult(id, 500, "Failed to describe location");
+    }
+
+    ToolResult result;
+    result.status = 200;
+    result.body["jsonrpc"] = "2.0";
+    result.body["id"] = id;
+    result.body["result"] = *description;
+
+    return result;
+  }
+
+  /**
+   * Describe multiple locations with one call. All locations are submitted
+   * to the pool first, so they are described in parallel by the workers.
+   *
+   * Locations that cannot be described do not fail the whole call, their entry
+   * in the structured result contains an "error" instead of a "description".
+   */
+  ToolResult HandleLocationDescriptionBatch(unsigned int id,
+                                            const nlohmann::json& arguments,
+                                            LocationDescriptionPool& descriptionPool)
+  {
+    if (!arguments.contains("locations") || !arguments["locations"].is_array()) {
+      return ErrorResult(id, 400, "Missing or invalid required parameter: locations");
     }
 
-    osmscout::GeoCoord location(latitude, longitude);
-    osmscout::LocationDescription description;
+    const nlohmann::json& locations = arguments["locations"];
 
-    if (!locationDescriptionService->DescribeLocation(location, description)) {
-      ToolResult result;
-      result.status = 500;
-      result.body["jsonrpc"] = "2.0";
-      result.body["id"] = id;
-      result.body["error"]["message"] = "Failed to describe location";
-      return result;
+    if (locations.empty()) {
+      return ErrorResult(id, 400, "Parameter locations must not be empty");
+    }
+
+    if (locations.size() > MaxBatchSize) {
+      return ErrorResult(id, 400, "Too many locations, maximum is " + std::to_string(MaxBatchSize));
+    }
+
+    std::vector<GeoCoord> coords(locations.size());
+
+    for (size_t i = 0; i < locations.size(); i++) {
+      if (std::string error = ParseCoordinate(locations[i], coords[i]);
+          !error.empty()) {
+        return ErrorResult(id, 400, "locations[" + std::to_string(i) + "]: " + error);
+      }
+    }
+
+    std::vector<std::future<LocationDescriptionPool::DescriptionRef>> futures;
+
+    futures.reserve(coords.size());
+
+    for (const auto& coord : coords) {
+      futures.push_back(descriptionPool.Describe(coord));
     }
 
-    // Map description to JSON using the three-layer mapper
     nlohmann::json content = nlohmann::json::array();
-    nlohmann::json structured;
+    nlohmann::json structuredLocations = nlohmann::json::array();
+    size_t         failed = 0;
+
+    for (size_t i = 0; i < futures.size(); i++) {
+      LocationDescriptionPool::DescriptionRef description = futures[i].get();
+      const std::string                       prefix = "locations[" + std::to_string(i) + "]: ";
+      nlohmann::json                          entry;
+
+      entry["latitude"] = coords[i].GetLat();
+      entry["longitude"] = coords[i].GetLon();
+
+      // text content of all locations is flattened, so prefix it with the location index
+      if (description) {
+        entry["description"] = (*description)["structuredContent"];
+
+        for (nlohmann::json item : (*description)["content"]) {
+          if (item.contains("text") && item["text"].is_string()) {
+            item["text"] = prefix + item["text"].get<std::string>();
+          }
+          content.push_back(std::move(item));
+        }
+      }
+      else {
+        entry["error"] = "Failed to describe location";
+        failed++;
+
+        nlohmann::json item;
+        item["type"] = "text";
+        item["text"] = prefix + entry["error"].get<std::string>();
+        content.push_back(std::move(item));
+      }
+
+      structuredLocations.push_back(std::move(entry));
+    }
 
-    ToJson(description, content, structured);
+    if (failed > 0) {
+      log.Warn() << "Failed to describe " << failed << " of " << coords.size() << " location(s)";
+    }
 
     ToolResult result;
     result.status = 200;
     result.body["jsonrpc"] = "2.0";
     result.body["id"] = id;
     result.body["result"]["content"] = content;
-    result.body["result"]["structuredContent"] = structured;
+    result.body["result"]["structuredContent"]["locations"] = structuredLocations;
 
     return result;
   }
 
-} // namespace osmscout::mcp
\ No newline at end of file
+} // namespace osmscout::mcp
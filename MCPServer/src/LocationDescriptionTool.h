@@ -22,15 +22,21 @@
 
 #include <nlohmann/json.hpp>
 
-#include <osmscout/location/LocationDescriptionService.h>
-
 #include "VersionTool.h"
+#include "LocationDescriptionPool.h"
 
 namespace osmscout::mcp {
 
+  //! Maximum number of locations of one "locationDescriptionBatch" call
+  static constexpr size_t MaxBatchSize=1000;
+
   ToolResult HandleLocationDescription(unsigned int id,
                                        const nlohmann::json& arguments,
-                                       const LocationDescriptionServiceRef& locationDescriptionService);
+                                       LocationDescriptionPool& descriptionPool);
+
+  ToolResult HandleLocationDescriptionBatch(unsigned int id,
+                                            const nlohmann::json& arguments,
+                                            LocationDescriptionPool& descriptionPool);
 
 } // namespace osmscout::mcp
 
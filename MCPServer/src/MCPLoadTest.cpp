@@ -0,0 +1,355 @@
+/*
+  MCPLoadTest - a demo program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscout/cli/CmdLineParsing.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+/*
+ * Load test client for MCPServer. It calls the "locationDescription" tool
+ * (or "locationDescriptionBatch" if a batch size is given) for random
+ * locations within the given bounding box from multiple connections
+ * in parallel and reports throughput and latency percentiles.
+ *
+ * Example:
+ *   MCPLoadTest --connections 16 --requests 20000 \
+ *     --minLat 50.68 --minLon 7.05 --maxLat 50.76 --maxLon 7.18
+ */
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  struct Arguments
+  {
+    bool         help = false;
+    std::string  host="127.0.0.1";
+    unsigned int port=8000;
+    size_t       connections=8;
+    size_t       requests=10000;
+    size_t       duration=0;   //!< Test duration in seconds, 0 means that the request count is used
+    size_t       batchSize=0;  //!< 0 calls the single location tool
+    unsigned int seed=42;
+    double       minLat=50.68;
+    double       minLon=7.05;
+    double       maxLat=50.76;
+    double       maxLon=7.18;
+  };
+
+  struct ConnectionResult
+  {
+    std::vector<double> latencies; //!< Latency of successful requests in milliseconds
+    size_t              errors=0;
+  };
+
+  osmscout::CmdLineParseResult ParseArguments(const int argc, char** argv, Arguments& args)
+  {
+    osmscout::CmdLineParser argParser("MCPLoadTest",
+                                      argc, argv);
+    const std::vector<std::string> helpArgs{"h", "help"};
+
+    argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                          args.help=value;
+                        }),
+                        helpArgs,
+                        "Return argument help",
+                        true);
+
+    argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                          args.host=value;
+                        }),
+                        "host",
+                        "HTTP ip/hostname of server, default: "+args.host,
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineUIntOption([&args](const unsigned int& value) {
+                          args.port=value;
+                        }),
+                        "port",
+                        "HTTP port of server, default: "+std::to_string(args.port),
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                          args.connections=value;
+                        }),
+                        "connections",
+                        "Number of parallel connections, default: "+std::to_string(args.connections),
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                          args.requests=value;
+                        }),
+                        "requests",
+                        "Total number of requests, default: "+std::to_string(args.requests),
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                          args.duration=value;
+                        }),
+                        "duration",
+                        "Test duration in seconds, overrides the number of requests",
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                          args.batchSize=value;
+                        }),
+                        "batchSize",
+                        "Number of locations per request, uses the batch tool if set",
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineUIntOption([&args](const unsigned int& value) {
+                          args.seed=value;
+                        }),
+                        "seed",
+                        "Seed of the random location generator, default: "+std::to_string(args.seed),
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                          args.minLat=value;
+                        }),
+                        "minLat",
+                        "Minimum latitude of the bounding box of the generated locations",
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                          args.minLon=value;
+                        }),
+                        "minLon",
+                        "Minimum longitude of the bounding box of the generated locations",
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                          args.maxLat=value;
+                        }),
+                        "maxLat",
+                        "Maximum latitude of the bounding box of the generated locations",
+                        false);
+
+    argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                          args.maxLon=value;
+                        }),
+                        "maxLon",
+                        "Maximum longitude of the bounding box of the generated locations",
+                        false);
+
+    osmscout::CmdLineParseResult result=argParser.Parse();
+    if (result.HasError()) {
+      osmscout::log.Error() << "ERROR: " << result.GetErrorDescription();
+      osmscout::log.Info() << argParser.GetHelp();
+    }
+    else if (args.help) {
+      osmscout::log.Info() << argParser.GetHelp();
+    }
+
+    return result;
+  }
+
+  nlohmann::json RandomLocation(std::mt19937& generator,
+                                std::uniform_real_distribution<double>& latDistribution,
+                                std::uniform_real_distribution<double>& lonDistribution)
+  {
+    nlohmann::json location;
+
+    location["latitude"]=latDistribution(generator);
+    location["longitude"]=lonDistribution(generator);
+
+    return location;
+  }
+
+  void RunConnection(const Arguments& args,
+                     size_t connection,
+                     std::atomic<size_t>& nextRequest,
+                     const Clock::time_point& end,
+                     ConnectionResult& result)
+  {
+    httplib::Client client(args.host,int(args.port));
+
+    client.set_keep_alive(true);
+
+    std::mt19937                           generator(args.seed+unsigned(connection));
+    std::uniform_real_distribution<double> latDistribution(args.minLat,args.maxLat);
+    std::uniform_real_distribution<double> lonDistribution(args.minLon,args.maxLon);
+
+    while (true) {
+      size_t request=nextRequest++;
+
+      if (args.duration>0) {
+        if (Clock::now()>=end) {
+          break;
+        }
+      }
+      else if (request>=args.requests) {
+        break;
+      }
+
+      nlohmann::json reqObject;
+
+      reqObject["jsonrpc"]="2.0";
+      reqObject["id"]=request+1;
+      reqObject["method"]="tools/call";
+
+      if (args.batchSize>0) {
+        nlohmann::json locations=nlohmann::json::array();
+
+        for (size_t i=0; i<args.batchSize; i++) {
+          locations.push_back(RandomLocation(generator,latDistribution,lonDistribution));
+        }
+
+        reqObject["params"]["name"]="locationDescriptionBatch";
+        reqObject["params"]["arguments"]["locations"]=std::move(locations);
+      }
+      else {
+        reqObject["params"]["name"]="locationDescription";
+        reqObject["params"]["arguments"]=RandomLocation(generator,latDistribution,lonDistribution);
+      }
+
+      const std::string body=reqObject.dump();
+      const auto        start=Clock::now();
+      const auto        res=client.Post("/",body,"application/json");
+      const double      latency=std::chrono::duration<double,std::milli>(Clock::now()-start).count();
+
+      if (!res) {
+        osmscout::log.Debug() << "Request failed: " << httplib::to_string(res.error());
+        result.errors++;
+        continue;
+      }
+
+      if (res->status!=200) {
+        osmscout::log.Debug() << "HTTP status " << res->status << ": " << res->body;
+        result.errors++;
+        continue;
+      }
+
+      result.latencies.push_back(latency);
+    }
+  }
+
+  double Percentile(const std::vector<double>& sortedValues,
+                    double percentile)
+  {
+    if (sortedValues.empty()) {
+      return 0.0;
+    }
+
+    const auto index=size_t(std::ceil(percentile/100.0*double(sortedValues.size())));
+
+    return sortedValues[std::clamp(index,size_t(1),sortedValues.size())-1];
+  }
+}
+
+int main(const int argc, char* argv[])
+{
+  Arguments args;
+
+  if (const osmscout::CmdLineParseResult result=ParseArguments(argc, argv, args);
+    result.HasError()) {
+    osmscout::log.Error() << "Argument error";
+    return 1;
+  }
+
+  if (args.help) {
+    return 0;
+  }
+
+  if (args.connections==0) {
+    osmscout::log.Error() << "At least one connection is required";
+    return 1;
+  }
+
+  if (args.minLat>args.maxLat || args.minLon>args.maxLon) {
+    osmscout::log.Error() << "Invalid bounding box";
+    return 1;
+  }
+
+  std::cout << "Testing " << args.host << ":" << args.port
+            << " with " << args.connections << " connection(s), ";
+  if (args.duration>0) {
+    std::cout << args.duration << " s";
+  }
+  else {
+    std::cout << args.requests << " request(s)";
+  }
+  if (args.batchSize>0) {
+    std::cout << ", " << args.batchSize << " location(s) per request";
+  }
+  std::cout << "..." << std::endl;
+
+  std::atomic<size_t>           nextRequest{0};
+  std::vector<ConnectionResult> results(args.connections);
+  std::vector<std::thread>      threads;
+
+  const auto start=Clock::now();
+  const auto end=start+std::chrono::seconds(args.duration);
+
+  for (size_t connection=0; connection<args.connections; connection++) {
+    threads.emplace_back(RunConnection,
+                         std::cref(args),
+                         connection,
+                         std::ref(nextRequest),
+                         std::cref(end),
+                         std::ref(results[connection]));
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const double elapsed=std::chrono::duration<double>(Clock::now()-start).count();
+
+  std::vector<double> latencies;
+  size_t              errors=0;
+
+  for (const auto& result : results) {
+    latencies.insert(latencies.end(),result.latencies.begin(),result.latencies.end());
+    errors+=result.errors;
+  }
+
+  std::sort(latencies.begin(),latencies.end());
+
+  const size_t succeeded=latencies.size();
+  const size_t locationsPerRequest=std::max(args.batchSize,size_t(1));
+  const double mean=succeeded>0 ? std::accumulate(latencies.begin(),latencies.end(),0.0)/double(succeeded) : 0.0;
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Requests:    " << succeeded << " succeeded, " << errors << " failed in " << elapsed << " s" << std::endl;
+  std::cout << "Throughput:  " << double(succeeded)/elapsed << " req/s, "
+            << double(succeeded*locationsPerRequest)/elapsed << " locations/s" << std::endl;
+  std::cout << "Latency ms:  min " << (succeeded>0 ? latencies.front() : 0.0)
+            << " mean " << mean
+            << " p50 " << Percentile(latencies,50.0)
+            << " p95 " << Percentile(latencies,95.0)
+            << " p99 " << Percentile(latencies,99.0)
+            << " max " << (succeeded>0 ? latencies.back() : 0.0) << std::endl;
+
+  return errors>0 ? 1 : 0;
+}
@@ -17,32 +17,30 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <vector>
 
 #include <osmscout/cli/CmdLineParsing.h>
 
-#include <osmscout/db/Database.h>
-
-#include <osmscout/location/LocationService.h>
-#include <osmscout/location/LocationDescriptionService.h>
-
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
 #include "VersionTool.h"
+#include "LocationDescriptionPool.h"
 #include "LocationDescriptionTool.h"
 
 namespace {
   struct Arguments
   {
     bool                  help = false;
+    bool                  debug = false;
     std::string           databaseDirectory;
     std::filesystem::path dataPath;
     std::string           host="0.0.0.0";
     unsigned int          port=8000;
-
+    osmscout::mcp::LocationDescriptionPool::Parameter poolParameter;
   };
 
   osmscout::CmdLineParseResult ParseArguments(const int argc, char** argv, Arguments& args)
@@ -58,19 +56,50 @@ namespace {
                         "Return argument help",
                         true);
 
+    argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                          args.debug=value;
+                        }),
+                        "debug",
+                        "Enable debug output (including requests and responses)",
+                        false);
+
     argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
                       args.host=value;
                     }),
                     "host",
                     "HTTP ip/hostname of server",
-                    true);
+                    false);
 
     argParser.AddOption(osmscout::CmdLineUIntOption([&args](const unsigned int& value) {
                         args.port=value;
                       }),
                       "port",
                       "HTTP port of server",
-                      true);
+                      false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.poolParameter.workerCount=value;
+                      }),
+                      "workers",
+                      "Number of worker threads (each with its own database instance), default: "+
+                      std::to_string(args.poolParameter.workerCount),
+                      false);
+
+    argParser.AddOption(osmscout::CmdLineSizeTOption([&args](const size_t& value) {
+                        args.poolParameter.cacheSize=value;
+                      }),
+                      "cacheSize",
+                      "Number of cached location descriptions, 0 disables the cache, default: "+
+                      std::to_string(args.poolParameter.cacheSize),
+                      false);
+
+    argParser.AddOption(osmscout::CmdLineDoubleOption([&args](const double& value) {
+                        args.poolParameter.cacheGrid=value;
+                      }),
+                      "cacheGrid",
+                      "Grid size of the description cache in degrees, locations in the same grid cell share one description, default: "+
+                      std::to_string(args.poolParameter.cacheGrid),
+                      false);
 
     argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
                           args.dataPath=value;
@@ -160,12 +189,12 @@ namespace {
 
   void HandleMessageToolsCall(const nlohmann::json& reqObject,
                               httplib::Response& res,
-                              const osmscout::LocationDescriptionServiceRef& locationDescriptionService)
+                              osmscout::mcp::LocationDescriptionPool& descriptionPool)
   {
     unsigned int id=reqObject["id"];
     const std::string tool=reqObject["params"]["name"];
 
-    osmscout::log.Info() << "*** Calling tool '" << tool << "'...";
+    osmscout::log.Debug() << "*** Calling tool '" << tool << "'...";
 
     osmscout::mcp::ToolResult result;
 
@@ -174,7 +203,11 @@ namespace {
     }
     else if (tool=="locationDescription") {
       const nlohmann::json& arguments = reqObject["params"]["arguments"];
-      result = osmscout::mcp::HandleLocationDescription(id, arguments, locationDescriptionService);
+      result = osmscout::mcp::HandleLocationDescription(id, arguments, descriptionPool);
+    }
+    else if (tool=="locationDescriptionBatch") {
+      const nlohmann::json& arguments = reqObject["params"]["arguments"];
+      result = osmscout::mcp::HandleLocationDescriptionBatch(id, arguments, descriptionPool);
     }
     else {
       result.status = 400;
@@ -228,32 +261,49 @@ int main(const int argc, char* argv[])
     return 0;
   }
 
+  osmscout::log.Debug(args.debug);
+
+  if (args.poolParameter.cacheSize>0 &&
+      !(args.poolParameter.cacheGrid>=0.0000001 && args.poolParameter.cacheGrid<=1.0)) {
+    osmscout::log.Error() << "Cache grid must be in the range [0.0000001, 1.0]";
+    return 1;
+  }
+
   osmscout::log.Info() << "Opening database at '" << args.databaseDirectory << "'...";
 
-  const osmscout::DatabaseParameter databaseParameter;
-  osmscout::DatabaseRef             database(new osmscout::Database(databaseParameter));
+  osmscout::mcp::LocationDescriptionPool descriptionPool(args.poolParameter);
 
-  if (!database->Open(args.databaseDirectory)) {
+  if (!descriptionPool.Open(args.databaseDirectory)) {
     osmscout::log.Error() << "Cannot open db";
 
     return 1;
   }
 
-  auto locationService(std::make_shared<osmscout::LocationService>(database));
-  const auto locationDescriptionService(std::make_shared<osmscout::LocationDescriptionService>(database));
-
   osmscout::log.Info() << "Creating server...";
 
   httplib::Server server;
 
+  // Connections are handled by the HTTP threads, which wait for the description workers.
+  // Use more HTTP threads than workers, so that the workers are kept busy
+  // while responses are sent and requests are parsed.
+  const size_t httpThreadCount=std::max(size_t(8),2*descriptionPool.GetWorkerCount());
+
+  server.new_task_queue = [httpThreadCount] {
+    return new httplib::ThreadPool(httpThreadCount);
+  };
+
   server.set_pre_routing_handler([](const auto& req, auto& /*res*/) {
-    osmscout::log.Info() << "<<<| Server Request";
-    osmscout::log.Info() << req.method << " " << req.path << " " << req.get_header_value("Content-Type");
+    if (!osmscout::log.IsDebug()) {
+      return httplib::Server::HandlerResponse::Unhandled;
+    }
+
+    osmscout::log.Debug() << "<<<| Server Request";
+    osmscout::log.Debug() << req.method << " " << req.path << " " << req.get_header_value("Content-Type");
     for (const auto& param : req.params) {
-      osmscout::log.Info() << "Param: " << param.first << "=" << param.second;
+      osmscout::log.Debug() << "Param: " << param.first << "=" << param.second;
     }
     for (const auto& header : req.headers) {
-      osmscout::log.Info() << "Header " << header.first << ": " << header.second;
+      osmscout::log.Debug() << "Header " << header.first << ": " << header.second;
     }
 
     /*
@@ -263,25 +313,29 @@ int main(const int argc, char* argv[])
       osmscout::log.Info() << "---%<---";
     }*/
 
-    osmscout::log.Info() << "|<<<";
+    osmscout::log.Debug() << "|<<<";
 
     return httplib::Server::HandlerResponse::Unhandled;
   });
 
   server.set_post_routing_handler([](const auto& req, auto& res) {
-    osmscout::log.Info() << "<<<| Server Response";
-    osmscout::log.Info() << req.method << " " << req.path;
+    if (!osmscout::log.IsDebug()) {
+      return httplib::Server::HandlerResponse::Unhandled;
+    }
+
+    osmscout::log.Debug() << "<<<| Server Response";
+    osmscout::log.Debug() << req.method << " " << req.path;
     for (const auto& header : res.headers) {
-      osmscout::log.Info() << "Header " << header.first << ": " << header.second;
+      osmscout::log.Debug() << "Header " << header.first << ": " << header.second;
     }
 
-    osmscout::log.Info() << "HTTP Status: " << res.status;
+    osmscout::log.Debug() << "HTTP Status: " << res.status;
 
-    osmscout::log.Info() << "---%<---";
-    osmscout::log.Info() << res.body;
-    osmscout::log.Info() << "---%<---";
+    osmscout::log.Debug() << "---%<---";
+    osmscout::log.Debug() << res.body;
+    osmscout::log.Debug() << "---%<---";
 
-    osmscout::log.Info() << "|<<<";
+    osmscout::log.Debug() << "|<<<";
 
     return httplib::Server::HandlerResponse::Unhandled;
   });
@@ -289,13 +343,13 @@ int main(const int argc, char* argv[])
   // OpenAPI served via mcpo proxy, no direct endpoint needed
 
   server.Post("/", [&](const httplib::Request& req, httplib::Response& res) {
-    osmscout::log.Info() << "POST /";
+    osmscout::log.Debug() << "POST /";
 
     // TODO: Check content-type
 
-    osmscout::log.Info() << "---%<---";
-    osmscout::log.Info() << req.body;
-    osmscout::log.Info() << "---%<---";
+    osmscout::log.Debug() << "---%<---";
+    osmscout::log.Debug() << req.body;
+    osmscout::log.Debug() << "---%<---";
 
     const nlohmann::json reqObject = nlohmann::json::parse(req.body);
     const std::string method = reqObject["method"];
@@ -311,8 +365,8 @@ int main(const int argc, char* argv[])
     }
     else if (method=="tools/call") {
       HandleMessageToolsCall(reqObject,
-                          res,
-                             locationDescriptionService);
+                             res,
+                             descriptionPool);
     }
     else if (method=="ping") {
       HandleMessagePing(reqObject,res);
@@ -324,8 +378,15 @@ int main(const int argc, char* argv[])
     }
   });
 
-  osmscout::log.Info() << "Starting server on " << args.host << ":" << args.port << "...";
+  osmscout::log.Info() << "Starting server on " << args.host << ":" << args.port
+                       << " with " << descriptionPool.GetWorkerCount() << " worker(s) and "
+                       << httpThreadCount << " HTTP thread(s)...";
   server.listen(args.host, args.port);
+
+  const auto statistics=descriptionPool.GetStatistics();
+
+  osmscout::log.Info() << "Description cache hits: " << statistics.cacheHits
+                       << " misses: " << statistics.cacheMisses;
   osmscout::log.Info() << "Starting stopped.";
 
   return 0;
@@ -0,0 +1,414 @@
+/*
+  AdminRegionIndexPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <osmscoutimport/Import.h>
+#include <osmscoutimport/ImportProgress.h>
+
+#include <osmscout-test/PreprocessOLT.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/location/AdminRegionIndex.h>
+#include <osmscout/location/LocationDescriptionService.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Imports the location test data with its nested admin regions and reverse geocodes random
+  coordinates within the bounding box of the database. Checks, that the admin region index
+  returns the same regions as a traversal of the location index testing the region areas,
+  and reports the time per coordinate for both. Finally describes a batch of coordinates
+  one by one and in parallel and checks, that both return the same descriptions.
+
+  Arguments: [coordinate count] [batch count]
+*/
+
+class PreprocessorFactory : public osmscout::PreprocessorFactory
+{
+public:
+  std::unique_ptr<osmscout::Preprocessor> GetProcessor(const std::string& /*filename*/,
+                                                       osmscout::PreprocessorCallback& callback) const override
+  {
+    return std::unique_ptr<osmscout::Preprocessor>(new osmscout::test::PreprocessOLT(callback));
+  }
+};
+
+/**
+ * Reference implementation, testing the top outer rings of all regions visited
+ */
+class ReferenceVisitor : public osmscout::AdminRegionVisitor
+{
+private:
+  const osmscout::Database& database;
+  osmscout::GeoCoord        coord;
+
+public:
+  std::vector<osmscout::FileOffset> regions;
+  bool                              success=true;
+
+public:
+  ReferenceVisitor(const osmscout::Database& database,
+                   const osmscout::GeoCoord& coord)
+  : database(database),
+    coord(coord)
+  {
+    // no code
+  }
+
+  Action Visit(const osmscout::AdminRegion& region) override
+  {
+    osmscout::AreaRef area;
+
+    if (region.object.GetType()!=osmscout::refArea) {
+      return skipChildren;
+    }
+
+    if (!database.GetAreaByOffset(region.object.GetFileOffset(),
+                                  area)) {
+      success=false;
+      return error;
+    }
+
+    for (const auto& ring : area->rings) {
+      if (ring.IsTopOuter() &&
+          osmscout::IsCoordInArea(coord,ring.nodes)) {
+        regions.push_back(region.regionOffset);
+
+        return visitChildren;
+      }
+    }
+
+    return skipChildren;
+  }
+};
+
+static void DumpPlace(std::ostream& stream,
+                      const std::string& name,
+                      const osmscout::LocationAtPlaceDescriptionRef& description)
+{
+  if (!description) {
+    return;
+  }
+
+  stream << name << ": " << description->GetPlace().GetDisplayString()
+         << " " << description->GetPlace().GetObject().GetName()
+         << " " << description->IsAtPlace()
+         << " " << description->GetDistance().AsMeter()
+         << " " << description->GetBearing().DisplayString() << std::endl;
+}
+
+/**
+ * Return a textual dump of all parts of the description, to compare descriptions
+ */
+static std::string GetDescriptionDump(const osmscout::LocationDescription& description)
+{
+  std::ostringstream stream;
+
+  if (auto coordDescription=description.GetCoordDescription(); coordDescription) {
+    stream << "Coord: " << coordDescription->GetLocation().GetDisplayText() << std::endl;
+  }
+
+  DumpPlace(stream,"Name",description.GetAtNameDescription());
+  DumpPlace(stream,"Address",description.GetAtAddressDescription());
+  DumpPlace(stream,"POI",description.GetAtPOIDescription());
+
+  if (auto wayDescription=description.GetWayDescription(); wayDescription) {
+    stream << "Way: " << wayDescription->GetWay().GetDisplayString()
+           << " " << wayDescription->GetWay().GetObject().GetName()
+           << " " << wayDescription->GetDistance().AsMeter() << std::endl;
+  }
+
+  if (auto crossingDescription=description.GetCrossingDescription(); crossingDescription) {
+    stream << "Crossing: " << crossingDescription->GetCrossing().GetDisplayText();
+
+    for (const auto& way : crossingDescription->GetWays()) {
+      stream << " " << way.GetDisplayString();
+    }
+
+    stream << " " << crossingDescription->IsAtPlace()
+           << " " << crossingDescription->GetDistance().AsMeter()
+           << " " << crossingDescription->GetBearing().DisplayString() << std::endl;
+  }
+
+  if (auto milestoneDescription=description.GetHighwayMilestoneDescription(); milestoneDescription) {
+    stream << "Milestone: " << milestoneDescription->GetObject().GetName()
+           << " " << milestoneDescription->GetPreviousMilestoneRef()
+           << " " << milestoneDescription->GetNextMilestoneRef()
+           << " " << milestoneDescription->GetDistance().AsMeter() << std::endl;
+  }
+
+  return stream.str();
+}
+
+int main(int argc, char* argv[])
+{
+  size_t coordinateCount=2000;
+  size_t batchCount=200;
+
+  if (argc>1) {
+    coordinateCount=std::stoul(argv[1]);
+  }
+
+  if (argc>2) {
+    batchCount=std::stoul(argv[2]);
+  }
+
+  char* testsTopDirEnv=getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    std::cerr << "Expected environment variable 'TESTS_TOP_DIR' not set" << std::endl;
+    return 1;
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    std::cerr << "Environment variable 'TESTS_TOP_DIR' does not point to directory" << std::endl;
+    return 77;
+  }
+
+  char*       testsTmpDirEnv=getenv("TESTS_TMP_DIR");
+  std::string databaseDirectory=osmscout::AppendFileToDir(testsTmpDirEnv!=nullptr ? testsTmpDirEnv : ".",
+                                                          "AdminRegionIndexPerformance");
+
+  std::filesystem::create_directories(databaseDirectory);
+
+  osmscout::ImportParameter importParameter;
+  osmscout::ImportProgress  progress;
+  std::list<std::string>    mapfiles;
+
+  mapfiles.emplace_back(osmscout::AppendFileToDir(testsTopDir,"LocationTest.olt"));
+
+  importParameter.SetTypefile(osmscout::AppendFileToDir(testsTopDir,"../stylesheets/map.ost"));
+  importParameter.SetMapfiles(mapfiles);
+  importParameter.SetDestinationDirectory(databaseDirectory);
+  importParameter.SetPreprocessorFactory(std::make_shared<PreprocessorFactory>());
+
+  try {
+    osmscout::Importer importer(importParameter);
+
+    if (!importer.Import(progress)) {
+      std::cerr << "Import failed" << std::endl;
+      return 1;
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Import failed: " << e.GetDescription() << std::endl;
+    return 1;
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(databaseDirectory)) {
+    std::cerr << "Cannot open database '" << databaseDirectory << "'" << std::endl;
+    return 1;
+  }
+
+  osmscout::GeoBox boundingBox;
+
+  if (!database->GetBoundingBox(boundingBox)) {
+    std::cerr << "Cannot read bounding box" << std::endl;
+    return 1;
+  }
+
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> latDistribution(boundingBox.GetMinLat(),boundingBox.GetMaxLat());
+  std::uniform_real_distribution<double> lonDistribution(boundingBox.GetMinLon(),boundingBox.GetMaxLon());
+  std::vector<osmscout::GeoCoord>        coords;
+
+  coords.reserve(coordinateCount);
+
+  for (size_t i=0; i<coordinateCount; i++) {
+    coords.emplace_back(latDistribution(generator),
+                        lonDistribution(generator));
+  }
+
+  osmscout::StopClock        buildTimer;
+  osmscout::AdminRegionIndex index;
+
+  if (!index.Build(*database)) {
+    std::cerr << "Cannot build admin region index" << std::endl;
+    return 1;
+  }
+
+  buildTimer.Stop();
+
+  std::cout << "Index: " << index.GetRegionCount() << " regions, "
+            << index.GetCellEntryCount() << " cell entries, "
+            << index.GetEdgeCount() << " edges, built in " << buildTimer.ResultString() << std::endl;
+
+  if (index.GetRegionCount()==0) {
+    std::cerr << "No admin regions in index" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<osmscout::FileOffset>> indexResults(coords.size());
+  std::vector<osmscout::AdminRegionRef>          regions;
+  size_t                                         hits=0;
+  size_t                                         nestedHits=0;
+  osmscout::StopClock                            indexTimer;
+
+  for (size_t i=0; i<coords.size(); i++) {
+    index.GetRegions(coords[i],regions);
+
+    for (const auto& region : regions) {
+      indexResults[i].push_back(region->regionOffset);
+    }
+
+    hits+=regions.size();
+
+    if (regions.size()>1) {
+      nestedHits++;
+    }
+  }
+
+  indexTimer.Stop();
+
+  osmscout::LocationIndexRef locationIndex=database->GetLocationIndex();
+  size_t                     mismatches=0;
+  osmscout::StopClock        referenceTimer;
+
+  for (size_t i=0; i<coords.size(); i++) {
+    ReferenceVisitor visitor(*database,coords[i]);
+
+    if (!locationIndex->VisitAdminRegions(visitor) ||
+        !visitor.success) {
+      std::cerr << "Cannot traverse location index" << std::endl;
+      return 1;
+    }
+
+    if (visitor.regions!=indexResults[i]) {
+      std::cerr << "Mismatch at " << coords[i].GetDisplayText() << ": "
+                << indexResults[i].size() << " regions from index, "
+                << visitor.regions.size() << " regions from reference" << std::endl;
+      mismatches++;
+    }
+  }
+
+  referenceTimer.Stop();
+
+  std::cout << coords.size() << " coordinates, " << hits << " region hits, "
+            << nestedHits << " coordinates in nested regions" << std::endl;
+  std::cout << "Index:     " << indexTimer.GetMilliseconds()*1000.0/double(coords.size()) << " us/coordinate" << std::endl;
+  std::cout << "Reference: " << referenceTimer.GetMilliseconds()*1000.0/double(coords.size()) << " us/coordinate" << std::endl;
+
+  if (mismatches>0) {
+    std::cerr << mismatches << " mismatches" << std::endl;
+    return 1;
+  }
+
+  if (nestedHits==0) {
+    std::cerr << "No coordinate is within nested regions" << std::endl;
+    return 1;
+  }
+
+  osmscout::LocationDescriptionService       service(database);
+  std::vector<osmscout::GeoCoord>            batch(coords.begin(),
+                                                   coords.begin()+std::min(batchCount,coords.size()));
+  // The test data has only a few streets, so look further than by default to get
+  // descriptions with places, addresses and ways
+  osmscout::Distance                         lookupDistance=osmscout::Kilometers(10.0);
+  std::vector<osmscout::LocationDescription> sequentialDescriptions(batch.size());
+  std::vector<osmscout::LocationDescription> descriptions;
+  osmscout::StopClock                        sequentialTimer;
+
+  for (size_t i=0; i<batch.size(); i++) {
+    if (!service.DescribeLocation(batch[i],
+                                  sequentialDescriptions[i],
+                                  lookupDistance)) {
+      std::cerr << "Cannot describe location " << batch[i].GetDisplayText() << std::endl;
+      return 1;
+    }
+  }
+
+  sequentialTimer.Stop();
+
+  osmscout::StopClock batchTimer;
+
+  if (!service.DescribeLocations(batch,
+                                 descriptions,
+                                 lookupDistance)) {
+    std::cerr << "Cannot describe locations" << std::endl;
+    return 1;
+  }
+
+  batchTimer.Stop();
+
+  std::cout << "DescribeLocation:  " << batch.size() << " locations in " << sequentialTimer.ResultString() << std::endl;
+  std::cout << "DescribeLocations: " << descriptions.size() << " locations in " << batchTimer.ResultString() << std::endl;
+
+  if (descriptions.size()!=batch.size()) {
+    std::cerr << "Wrong number of descriptions" << std::endl;
+    return 1;
+  }
+
+  size_t describedCount=0;
+
+  for (size_t i=0; i<batch.size(); i++) {
+    std::string expected=GetDescriptionDump(sequentialDescriptions[i]);
+    std::string actual=GetDescriptionDump(descriptions[i]);
+
+    if (actual!=expected) {
+      std::cerr << "Description mismatch at " << batch[i].GetDisplayText() << ":" << std::endl
+                << "Sequential:" << std::endl << expected
+                << "Batch:" << std::endl << actual;
+      mismatches++;
+    }
+
+    if (sequentialDescriptions[i].GetAtNameDescription() ||
+        sequentialDescriptions[i].GetAtAddressDescription() ||
+        sequentialDescriptions[i].GetAtPOIDescription() ||
+        sequentialDescriptions[i].GetWayDescription()) {
+      describedCount++;
+    }
+  }
+
+  std::cout << describedCount << " locations with a place, address, POI or way description" << std::endl;
+
+  if (mismatches>0) {
+    std::cerr << mismatches << " description mismatches" << std::endl;
+    return 1;
+  }
+
+  if (describedCount==0) {
+    std::cerr << "No location was described by a place, address, POI or way" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,401 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscoutclient/AvailableMapEntry.h>
+#include <osmscoutclient/CurlHttpClient.h>
+#include <osmscoutclient/MapDirectory.h>
+#include <osmscoutclient/MapDownloadService.h>
+
+#include <osmscout/util/String.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * Minimal HTTP/1.1 server on the loopback interface, serving the given
+ * files for HEAD and GET requests. Single byte ranges are supported,
+ * if acceptRanges is set, else the Range header is ignored. The server
+ * drops connections after it has sent failAfterBytes body bytes in total.
+ */
+class LocalHttpServer
+{
+private:
+  int listenFd{-1};
+  uint16_t port{0};
+  std::atomic<bool> stop{false};
+  std::thread acceptThread;
+  std::mutex connectionMutex;
+  std::vector<std::thread> connections;
+
+public:
+  std::map<std::string, std::string> files;
+  std::atomic<bool> acceptRanges{true};
+  std::atomic<uint64_t> failAfterBytes{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> bytesServed{0};
+  std::atomic<size_t> rangeRequests{0};
+
+private:
+  static bool SendAll(int fd, const char *data, size_t size)
+  {
+    while (size > 0) {
+      ssize_t sent = send(fd, data, size, 0);
+      if (sent <= 0) {
+        return false;
+      }
+      data += sent;
+      size -= static_cast<size_t>(sent);
+    }
+    return true;
+  }
+
+  static bool SendResponse(int fd, const std::string &status, const std::string &headers)
+  {
+    std::string response = "HTTP/1.1 " + status + "\r\n" + headers + "Connection: close\r\n\r\n";
+    return SendAll(fd, response.data(), response.size());
+  }
+
+  void Serve(int fd)
+  {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+      ssize_t size = recv(fd, buffer, sizeof(buffer), 0);
+      if (size <= 0) {
+        close(fd);
+        return;
+      }
+      request.append(buffer, static_cast<size_t>(size));
+    }
+
+    std::istringstream requestLine(request.substr(0, request.find("\r\n")));
+    std::string method;
+    std::string path;
+    requestLine >> method >> path;
+
+    auto file = files.find(path);
+    if (file == files.end()) {
+      SendResponse(fd, "404 Not Found", "Content-Length: 0\r\n");
+      close(fd);
+      return;
+    }
+
+    const std::string &content = file->second;
+    uint64_t offset = 0;
+    uint64_t length = content.size();
+    std::string status = "200 OK";
+    std::string headers = acceptRanges ? "Accept-Ranges: bytes\r\n" : "";
+
+    std::string lowerRequest = osmscout::UTF8StringToLower(request);
+    size_t rangePos = lowerRequest.find("\r\nrange: bytes=");
+    if (acceptRanges && rangePos != std::string::npos) {
+      uint64_t first = 0;
+      uint64_t last = 0;
+      char dash = 0;
+      std::istringstream range(request.substr(rangePos + 15));
+      range >> first >> dash >> last;
+      if (!range || dash != '-' || first > last || last >= content.size()) {
+        SendResponse(fd, "416 Range Not Satisfiable", "Content-Length: 0\r\n");
+        close(fd);
+        return;
+      }
+      offset = first;
+      length = last - first + 1;
+      status = "206 Partial Content";
+      headers += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+                 std::to_string(content.size()) + "\r\n";
+      ++rangeRequests;
+    }
+
+    headers += "Content-Length: " + std::to_string(length) + "\r\n";
+    if (!SendResponse(fd, status, headers) || method == "HEAD") {
+      close(fd);
+      return;
+    }
+
+    for (uint64_t pos = offset; pos < offset + length; pos += 1024) {
+      size_t size = static_cast<size_t>(std::min<uint64_t>(1024, offset + length - pos));
+      if (bytesServed + size > failAfterBytes) {
+        break; // connection dropped
+      }
+      bytesServed += size;
+      if (!SendAll(fd, content.data() + pos, size)) {
+        break;
+      }
+    }
+
+    close(fd);
+  }
+
+  void Accept()
+  {
+    while (!stop) {
+      pollfd pfd{listenFd, POLLIN, 0};
+      if (poll(&pfd, 1, 50) <= 0) {
+        continue;
+      }
+
+      int fd = accept(listenFd, nullptr, nullptr);
+      if (fd < 0) {
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(connectionMutex);
+      connections.emplace_back(&LocalHttpServer::Serve, this, fd);
+    }
+  }
+
+public:
+  LocalHttpServer()
+  {
+    // Clients closing the connection early must not terminate the test
+    std::signal(SIGPIPE, SIG_IGN);
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listenFd >= 0);
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    REQUIRE(bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+    REQUIRE(listen(listenFd, 16) == 0);
+
+    socklen_t addressLength = sizeof(address);
+    REQUIRE(getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength) == 0);
+    port = ntohs(address.sin_port);
+
+    acceptThread = std::thread(&LocalHttpServer::Accept, this);
+  }
+
+  ~LocalHttpServer()
+  {
+    stop = true;
+    acceptThread.join();
+    for (auto &connection : connections) {
+      connection.join();
+    }
+    close(listenFd);
+  }
+
+  std::string GetUri() const
+  {
+    return "http://127.0.0.1:" + std::to_string(port);
+  }
+};
+
+std::string Content(const std::string &path)
+{
+  std::mt19937 generator(static_cast<uint32_t>(std::hash<std::string>()(path)));
+  std::string content(20000 + generator() % 3000, '\0');
+  for (auto &c : content) {
+    c = static_cast<char>(generator());
+  }
+  return content;
+}
+
+std::string ReadFile(const std::filesystem::path &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+}
+
+void AddMapFiles(LocalHttpServer &server)
+{
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    server.files["/test-dir/" + f] = Content(f);
+  }
+}
+
+uint64_t MapSize()
+{
+  uint64_t size = 0;
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    size += Content(f).size();
+  }
+  return size;
+}
+
+bool MapFilesMatch(const std::filesystem::path &dir)
+{
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    if (ReadFile(dir / f) != Content(f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("CurlHttpClient fetches and downloads files")
+{
+  LocalHttpServer server;
+  server.files["/list.json"] = "[]";
+  server.files["/file.bin"] = Content("file.bin");
+
+  osmscout::CurlHttpClient httpClient;
+
+  REQUIRE(httpClient.Fetch(server.GetUri() + "/list.json") == "[]");
+  REQUIRE(httpClient.Fetch(server.GetUri() + "/missing.json").empty());
+
+  std::error_code ec;
+  std::filesystem::path dest = std::filesystem::temp_directory_path(ec) / "osmscout-test-curl.bin";
+  uint64_t lastProgress = 0;
+  REQUIRE(httpClient.Download(server.GetUri() + "/file.bin", dest,
+                              [&lastProgress](uint64_t bytes, [[maybe_unused]] uint64_t total) {
+                                lastProgress = bytes;
+                                return true;
+                              }));
+  REQUIRE(ReadFile(dest) == Content("file.bin"));
+  REQUIRE(lastProgress == Content("file.bin").size());
+
+  // Cancelled by the progress callback
+  REQUIRE_FALSE(httpClient.Download(server.GetUri() + "/file.bin", dest,
+                                    []([[maybe_unused]] uint64_t bytes, [[maybe_unused]] uint64_t total) {
+                                      return false;
+                                    }));
+
+  std::filesystem::remove(dest, ec);
+}
+
+TEST_CASE("CurlHttpClient fetches byte ranges")
+{
+  LocalHttpServer server;
+  server.files["/file.bin"] = Content("file.bin");
+
+  osmscout::CurlHttpClient httpClient;
+  const std::string &content = server.files["/file.bin"];
+  std::string url = server.GetUri() + "/file.bin";
+
+  REQUIRE(httpClient.FetchContentLength(url) == content.size());
+  REQUIRE(httpClient.FetchContentLength(server.GetUri() + "/missing.bin") == 0);
+
+  std::string received;
+  auto Collect = [&received](const char *data, size_t size) {
+    received.append(data, size);
+    return true;
+  };
+
+  REQUIRE(httpClient.FetchRange(url, 1000, 5000, Collect));
+  REQUIRE(received == content.substr(1000, 5000));
+
+  received.clear();
+  REQUIRE(httpClient.FetchRange(url, content.size() - 10, 10, Collect));
+  REQUIRE(received == content.substr(content.size() - 10));
+
+  // Cancelled by the data callback
+  REQUIRE_FALSE(httpClient.FetchRange(url, 0, 5000, [](const char *, size_t) { return false; }));
+
+  // Range beyond the end of the file
+  REQUIRE_FALSE(httpClient.FetchRange(url, content.size(), 10, Collect));
+
+  // Without range support the whole file would be sent, it must not reach the callback
+  server.acceptRanges = false;
+  received.clear();
+  REQUIRE(httpClient.FetchContentLength(url) == 0);
+  REQUIRE_FALSE(httpClient.FetchRange(url, 1000, 5000, Collect));
+  REQUIRE(received.empty());
+}
+
+TEST_CASE("MapDownloadService downloads chunks from HTTP server using CurlHttpClient")
+{
+  LocalHttpServer server;
+  AddMapFiles(server);
+
+  osmscout::CurlHttpClient httpClient;
+
+  std::error_code ec;
+  std::filesystem::path tmpDir = std::filesystem::temp_directory_path(ec) / "osmscout-test-curl-chunked";
+  std::filesystem::remove_all(tmpDir, ec);
+
+  osmscout::MapProvider provider("test", server.GetUri(), "");
+  osmscout::AvailableMapEntry entry("CurlMap", {"europe"}, "", provider, MapSize(), "test-dir",
+                                    osmscout::Timestamp(std::chrono::seconds(1480801927)), 10);
+
+  uint64_t lastProgress = 0;
+  REQUIRE(osmscout::MapDownloadService::DownloadMapSync(entry, tmpDir, httpClient, nullptr,
+                                                        [&lastProgress](uint64_t bytes, [[maybe_unused]] uint64_t total) {
+                                                          lastProgress = std::max(lastProgress, bytes);
+                                                        },
+                                                        osmscout::MapDownloadParameter{4, 4096}));
+
+  REQUIRE(MapFilesMatch(tmpDir));
+  REQUIRE(server.bytesServed == MapSize());
+  REQUIRE(lastProgress == MapSize());
+  REQUIRE(server.rangeRequests >= osmscout::MapDownloadService::MapFiles().size() * 5);
+
+  std::filesystem::remove_all(tmpDir, ec);
+}
+
+TEST_CASE("MapDownloadService resumes download from HTTP server using CurlHttpClient")
+{
+  LocalHttpServer server;
+  AddMapFiles(server);
+
+  osmscout::CurlHttpClient httpClient;
+
+  std::error_code ec;
+  std::filesystem::path tmpDir = std::filesystem::temp_directory_path(ec) / "osmscout-test-curl-resume";
+  std::filesystem::remove_all(tmpDir, ec);
+
+  osmscout::MapProvider provider("test", server.GetUri(), "");
+  osmscout::AvailableMapEntry entry("CurlResumeMap", {"europe"}, "", provider, MapSize(), "test-dir",
+                                    osmscout::Timestamp(std::chrono::seconds(1480801927)), 10);
+
+  // Connection drops in the middle of the download
+  server.failAfterBytes = MapSize() / 2;
+  REQUIRE_FALSE(osmscout::MapDownloadService::DownloadMapSync(entry, tmpDir, httpClient, nullptr, {},
+                                                              osmscout::MapDownloadParameter{4, 4096}));
+
+  uint64_t firstAttempt = server.bytesServed;
+  server.bytesServed = 0;
+  server.failAfterBytes = std::numeric_limits<uint64_t>::max();
+
+  REQUIRE(osmscout::MapDownloadService::DownloadMapSync(entry, tmpDir, httpClient, nullptr, {},
+                                                        osmscout::MapDownloadParameter{4, 4096}));
+  REQUIRE(MapFilesMatch(tmpDir));
+
+  // Completed chunks were not downloaded again
+  REQUIRE(server.bytesServed < MapSize());
+  REQUIRE(server.bytesServed >= MapSize() - firstAttempt);
+
+  std::filesystem::remove_all(tmpDir, ec);
+}
@@ -0,0 +1,246 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutclient/DBThread.h>
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+  class MemorySettingsStorage: public osmscout::SettingsStorage
+  {
+  private:
+    std::map<std::string,std::string> values;
+
+  public:
+    void SetValue(const std::string &key, double d) override { values[key]=std::to_string(d); }
+    void SetValue(const std::string &key, uint32_t i) override { values[key]=std::to_string(i); }
+    void SetValue(const std::string &key, const std::string &str) override { values[key]=str; }
+    void SetValue(const std::string &key, bool b) override { values[key]=b ? "1" : "0"; }
+    void SetValue(const std::string &key, std::vector<char> bytes) override { values[key]=std::string(bytes.begin(), bytes.end()); }
+
+    double GetDouble(const std::string &key, double defaultValue) override
+    {
+      auto it=values.find(key);
+      return it==values.end() ? defaultValue : std::stod(it->second);
+    }
+
+    uint32_t GetUInt(const std::string &key, uint32_t defaultValue) override
+    {
+      auto it=values.find(key);
+      return it==values.end() ? defaultValue : uint32_t(std::stoul(it->second));
+    }
+
+    std::string GetString(const std::string &key, const std::string &defaultValue) override
+    {
+      auto it=values.find(key);
+      return it==values.end() ? defaultValue : it->second;
+    }
+
+    bool GetBool(const std::string &key, bool defaultValue) override
+    {
+      auto it=values.find(key);
+      return it==values.end() ? defaultValue : it->second=="1";
+    }
+
+    std::vector<char> GetBytes(const std::string &key) override
+    {
+      auto it=values.find(key);
+      return it==values.end() ? std::vector<char>() : std::vector<char>(it->second.begin(), it->second.end());
+    }
+
+    std::vector<std::string> Keys(const std::string &prefix) override
+    {
+      std::vector<std::string> keys;
+      for (const auto &[key, value]: values) {
+        if (key.starts_with(prefix)) {
+          keys.push_back(key);
+        }
+      }
+      return keys;
+    }
+  };
+
+  osmscout::DBThreadRef CreateDBThread(size_t jobThreadCount)
+  {
+    auto settings=std::make_shared<osmscout::Settings>(std::make_shared<MemorySettingsStorage>(), 96.0, "metrics");
+    auto mapManager=std::make_shared<osmscout::MapManager>(std::vector<std::filesystem::path>());
+
+    return std::make_shared<osmscout::DBThread>("", "", settings, mapManager, std::vector<std::string>(), jobThreadCount);
+  }
+}
+
+TEST_CASE("Jobs are started by priority")
+{
+  using Priority = osmscout::DBThread::JobPriority;
+
+  auto dbThread=CreateDBThread(1);
+
+  std::promise<void> blockerStarted;
+  std::promise<void> releaseBlocker;
+  std::shared_future<void> release=releaseBlocker.get_future().share();
+
+  std::mutex            mutex;
+  std::vector<Priority> order;
+
+  auto blocker=dbThread->SubmitJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+    blockerStarted.set_value();
+    release.wait();
+  });
+  blockerStarted.get_future().wait();
+
+  std::vector<osmscout::CancelableFuture<bool>> futures;
+  for (auto priority: {Priority::Low, Priority::Normal, Priority::Low}) {
+    futures.push_back(dbThread->SubmitJob([&mutex, &order, priority](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+      std::scoped_lock lock(mutex);
+      order.push_back(priority);
+    },
+    priority));
+  }
+
+  REQUIRE(dbThread->GetPendingJobCount(Priority::Normal)==1);
+  REQUIRE(dbThread->GetPendingJobCount(Priority::Low)==2);
+
+  // high priority jobs are executed by the reserved worker, while the job worker is blocked
+  for (size_t i=0; i<2; i++) {
+    REQUIRE(dbThread->SubmitJob([&mutex, &order](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+      std::scoped_lock lock(mutex);
+      order.push_back(Priority::High);
+    },
+    Priority::High).StdFuture().get());
+  }
+
+  REQUIRE(dbThread->GetPendingJobCount(Priority::High)==0);
+  REQUIRE(dbThread->GetPendingJobCount(Priority::Normal)==1);
+
+  releaseBlocker.set_value();
+
+  REQUIRE(blocker.StdFuture().get());
+  for (auto &future: futures) {
+    REQUIRE(future.StdFuture().get());
+  }
+
+  REQUIRE(order==std::vector<Priority>{Priority::High, Priority::High, Priority::Normal, Priority::Low, Priority::Low});
+  REQUIRE(dbThread->GetPendingJobCount(Priority::Low)==0);
+}
+
+TEST_CASE("Canceled jobs are skipped")
+{
+  auto dbThread=CreateDBThread(1);
+
+  std::promise<void> releaseBlocker;
+  std::shared_future<void> release=releaseBlocker.get_future().share();
+
+  std::mutex mutex;
+  std::vector<osmscout::DBThread::JobStatistics> statistics;
+
+  osmscout::Slot<osmscout::DBThread::JobStatistics> statisticsSlot(
+    [&](const osmscout::DBThread::JobStatistics &jobStatistics){
+      std::scoped_lock lock(mutex);
+      statistics.push_back(jobStatistics);
+    });
+  dbThread->jobFinished.Connect(statisticsSlot);
+
+  auto blocker=dbThread->SubmitJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+    release.wait();
+  });
+
+  bool executed=false;
+  auto canceled=dbThread->SubmitJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+    executed=true;
+  });
+  canceled.Cancel();
+
+  releaseBlocker.set_value();
+
+  REQUIRE(blocker.StdFuture().get());
+
+  // jobs of same priority are executed in order of submission
+  REQUIRE(dbThread->SubmitJob([](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){}).StdFuture().get());
+
+  REQUIRE_FALSE(executed);
+  REQUIRE(canceled.IsCanceled());
+
+  std::scoped_lock lock(mutex);
+  REQUIRE(statistics.size()==3);
+  REQUIRE_FALSE(statistics[0].canceled);
+  REQUIRE(statistics[1].canceled);
+  REQUIRE_FALSE(statistics[2].canceled);
+}
+
+TEST_CASE("Synchronous job is canceled by breaker of the caller")
+{
+  auto dbThread=CreateDBThread(1);
+
+  std::promise<void> releaseBlocker;
+  std::shared_future<void> release=releaseBlocker.get_future().share();
+
+  auto blocker=dbThread->SubmitJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+    release.wait();
+  });
+
+  osmscout::ThreadedBreaker breaker;
+  bool executed=false;
+
+  breaker.Break();
+
+  // job is queued behind the blocker, it is skipped
+  REQUIRE_FALSE(dbThread->RunSynchronousJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){
+    executed=true;
+  },
+  osmscout::DBThread::JobPriority::Normal,
+  &breaker));
+  REQUIRE_FALSE(executed);
+
+  releaseBlocker.set_value();
+  REQUIRE(blocker.StdFuture().get());
+}
+
+TEST_CASE("Synchronous job returns after running job is finished")
+{
+  auto dbThread=CreateDBThread(1);
+
+  osmscout::ThreadedBreaker breaker;
+  bool started=false;
+  bool finished=false;
+
+  REQUIRE_FALSE(dbThread->RunSynchronousJob([&](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker &jobBreaker){
+    started=true;
+    breaker.Break();
+    while (!jobBreaker.IsAborted()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    finished=true;
+  },
+  osmscout::DBThread::JobPriority::Normal,
+  &breaker));
+
+  REQUIRE(started);
+  REQUIRE(finished);
+
+  REQUIRE(dbThread->RunSynchronousJob([](const std::list<osmscout::DBInstanceRef>&, const osmscout::DBInstanceRef&, const osmscout::Breaker&){},
+                                      osmscout::DBThread::JobPriority::High));
+}
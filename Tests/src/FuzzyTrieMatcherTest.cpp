@@ -0,0 +1,293 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <osmscout/db/FuzzyTrieMatcher.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace osmscout;
+
+namespace {
+
+  /**
+   * Sorted set of keys, offering the trie interface required by FuzzyTrieMatcher
+   */
+  class SetTrie
+  {
+  private:
+    std::set<std::string> keys;
+    mutable size_t        lookups=0;
+
+  private:
+    static bool HasPrefix(const std::string& key,
+                          const std::string& prefix)
+    {
+      return key.compare(0,prefix.length(),prefix)==0;
+    }
+
+  public:
+    explicit SetTrie(const std::vector<std::string>& keys)
+    : keys(keys.begin(),keys.end())
+    {
+      // no code
+    }
+
+    bool HasPrefix(const std::string& prefix) const
+    {
+      lookups++;
+
+      auto key=keys.lower_bound(prefix);
+
+      return key!=keys.end() &&
+             HasPrefix(*key,prefix);
+    }
+
+    void VisitKeys(const std::string& prefix,
+                   const std::function<bool(const std::string& key)>& visitor) const
+    {
+      for (auto key=keys.lower_bound(prefix);
+           key!=keys.end() && HasPrefix(*key,prefix);
+           ++key) {
+        lookups++;
+
+        if (!visitor(*key)) {
+          return;
+        }
+      }
+    }
+
+    const std::set<std::string>& GetKeys() const
+    {
+      return keys;
+    }
+
+    size_t GetLookups() const
+    {
+      return lookups;
+    }
+  };
+
+  /**
+   * Optimal string alignment distance of the characters of a and b
+   */
+  size_t Distance(const std::vector<std::string>& a,
+                  const std::vector<std::string>& b)
+  {
+    std::vector<std::vector<size_t>> d(a.size()+1,std::vector<size_t>(b.size()+1));
+
+    for (size_t i=0; i<=a.size(); i++) {
+      d[i][0]=i;
+    }
+
+    for (size_t j=0; j<=b.size(); j++) {
+      d[0][j]=j;
+    }
+
+    for (size_t i=1; i<=a.size(); i++) {
+      for (size_t j=1; j<=b.size(); j++) {
+        d[i][j]=std::min({d[i-1][j]+1,
+                          d[i][j-1]+1,
+                          d[i-1][j-1]+(a[i-1]==b[j-1] ? 0 : 1)});
+
+        if (i>1 &&
+            j>1 &&
+            a[i-1]==b[j-2] &&
+            a[i-2]==b[j-1]) {
+          d[i][j]=std::min(d[i][j],d[i-2][j-2]+1);
+        }
+      }
+    }
+
+    return d[a.size()][b.size()];
+  }
+
+  /**
+   * Smallest distance of the query to a prefix of the key
+   */
+  size_t PrefixDistance(const std::string& query,
+                        const std::string& key)
+  {
+    std::vector<std::string> queryCharacters=SplitUTF8Characters(query);
+    std::vector<std::string> keyCharacters=SplitUTF8Characters(key);
+    size_t                   distance=std::numeric_limits<size_t>::max();
+
+    for (size_t length=0; length<=keyCharacters.size(); length++) {
+      std::vector<std::string> prefix(keyCharacters.begin(),keyCharacters.begin()+length);
+
+      distance=std::min(distance,Distance(queryCharacters,prefix));
+    }
+
+    return distance;
+  }
+
+  struct MatchResult
+  {
+    std::map<std::string,size_t> distances; //!< Best distance of each reported key
+    std::vector<size_t>          order;     //!< Distances in the order the keys were reported
+  };
+
+  MatchResult Match(const SetTrie& trie,
+                    const std::string& query,
+                    size_t maxDistance,
+                    size_t limit=1000,
+                    size_t maxLookups=std::numeric_limits<size_t>::max())
+  {
+    MatchResult                result;
+    FuzzyTrieMatcher<SetTrie> matcher(trie,
+                                      query,
+                                      maxDistance,
+                                      limit,
+                                      maxLookups);
+
+    matcher.Match([&result](const std::string& key,
+                            size_t distance) {
+      result.distances.emplace(key,distance);
+      result.order.push_back(distance);
+
+      return result.distances.size();
+    });
+
+    return result;
+  }
+
+  const std::vector<std::string> cities{
+    "Bahnhof",
+    "Bahnhofstraße",
+    "Berlin",
+    "Bern",
+    "Bremen",
+    "Dresden",
+    "Duisburg",
+    "Düsseldorf",
+    "Hauptbahnhof",
+    "Köln",
+    "Mainz",
+    "Mannheim",
+    "München",
+    "Münster",
+    "Ulm"
+  };
+}
+
+TEST_CASE("Fuzzy trie matcher reports texts with their prefix distance")
+{
+  SetTrie trie(cities);
+
+  for (const std::string query : {"Bern","Berlni","Munchen","Muenster","Düseldorf","Dresdn","Bahnhfo","Kln","Mannhiem"}) {
+    for (size_t maxDistance=0; maxDistance<=2; maxDistance++) {
+      INFO("Query '" << query << "', maximum distance " << maxDistance);
+
+      MatchResult result=Match(trie,query,maxDistance);
+
+      for (const auto& key : trie.GetKeys()) {
+        INFO("Key '" << key << "'");
+
+        size_t expected=PrefixDistance(query,key);
+        auto   match=result.distances.find(key);
+
+        if (expected<=maxDistance) {
+          REQUIRE(match!=result.distances.end());
+          REQUIRE(match->second==expected);
+        }
+        else {
+          REQUIRE(match==result.distances.end());
+        }
+      }
+
+      REQUIRE(std::is_sorted(result.order.begin(),result.order.end()));
+    }
+  }
+}
+
+TEST_CASE("Fuzzy trie matcher counts edit operations")
+{
+  SetTrie trie({"Berlin","Dresden","München"});
+
+  SECTION("Transposition")
+  {
+    MatchResult result=Match(trie,"Berlni",1);
+    REQUIRE(result.distances.size()==1);
+    REQUIRE(result.distances["Berlin"]==1);
+  }
+
+  SECTION("Deletion")
+  {
+    MatchResult result=Match(trie,"Dresdn",1);
+    REQUIRE(result.distances.size()==1);
+    REQUIRE(result.distances["Dresden"]==1);
+  }
+
+  SECTION("Insertion")
+  {
+    MatchResult result=Match(trie,"Dreseden",1);
+    REQUIRE(result.distances.size()==1);
+    REQUIRE(result.distances["Dresden"]==1);
+  }
+
+  SECTION("Substitution of a multi byte character")
+  {
+    MatchResult result=Match(trie,"Munchen",1);
+    REQUIRE(result.distances.size()==1);
+    REQUIRE(result.distances["München"]==1);
+  }
+
+  SECTION("Prefix")
+  {
+    MatchResult result=Match(trie,"Mün",0);
+    REQUIRE(result.distances.size()==1);
+    REQUIRE(result.distances["München"]==0);
+  }
+}
+
+TEST_CASE("Fuzzy trie matcher stops at the distance of the requested number of texts")
+{
+  SetTrie trie(cities);
+
+  // "Bern" is an exact match, "Berlin" has distance 1
+  MatchResult result=Match(trie,"Bern",1,1);
+  REQUIRE(result.distances.size()==1);
+  REQUIRE(result.distances["Bern"]==0);
+
+  result=Match(trie,"Bern",1,2);
+  REQUIRE(result.distances.size()==2);
+  REQUIRE(result.distances["Berlin"]==1);
+}
+
+TEST_CASE("Fuzzy trie matcher does not exceed the maximum number of lookups")
+{
+  SetTrie     trie(cities);
+  MatchResult unlimited=Match(trie,"Munchen",2);
+  size_t      unlimitedLookups=trie.GetLookups();
+
+  REQUIRE(unlimitedLookups>20);
+
+  SetTrie     limitedTrie(cities);
+  MatchResult limited=Match(limitedTrie,"Munchen",2,1000,20);
+
+  REQUIRE(limitedTrie.GetLookups()<=20);
+  REQUIRE(limited.distances.size()<=unlimited.distances.size());
+}
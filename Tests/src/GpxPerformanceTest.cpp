@@ -0,0 +1,200 @@
+/*
+  GpxPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscoutgpx/Import.h>
+#include <osmscoutgpx/Export.h>
+
+#include <osmscout/util/StopClock.h>
+
+/**
+  Write a gpx file with the given number of track points using the streaming writer,
+  read it back using the object tree import, the streaming import and the parallel
+  import of multiple files and report throughput in points per second.
+*/
+
+size_t POINT_COUNT=1000000; // Number of generated track points
+size_t FILE_COUNT=4;        // Number of files parsed in parallel
+
+class CountingHandler : public osmscout::gpx::GpxHandler
+{
+public:
+  size_t tracks=0;
+  size_t segments=0;
+  size_t points=0;
+
+  void OnTrackStart() override
+  {
+    tracks++;
+  }
+
+  void OnTrackSegmentStart(const osmscout::gpx::Track &) override
+  {
+    segments++;
+  }
+
+  void OnTrackPoint(osmscout::gpx::TrackPoint &&) override
+  {
+    points++;
+  }
+};
+
+static bool WriteTestFile(const std::string& fileName)
+{
+  osmscout::gpx::GpxStreamWriter writer(fileName);
+
+  if (!writer.IsOpen()) {
+    return false;
+  }
+
+  osmscout::gpx::Track track;
+  track.name="Performance test";
+
+  if (!writer.StartTrack(track) ||
+      !writer.StartTrackSegment()) {
+    return false;
+  }
+
+  auto time=std::chrono::system_clock::now();
+
+  for (size_t i=0; i<POINT_COUNT; i++) {
+    osmscout::gpx::TrackPoint point(osmscout::GeoCoord(50.0+double(i%10000)*0.0001,
+                                                       14.0+double(i/10000)*0.0001));
+
+    point.elevation=200.0+double(i%100);
+    point.timestamp=time+std::chrono::seconds(i);
+    point.hdop=5.0;
+
+    if (!writer.WriteTrackPoint(point)) {
+      return false;
+    }
+  }
+
+  return writer.Close();
+}
+
+static void DumpThroughput(const std::string& name,
+                           size_t points,
+                           const osmscout::StopClock& stopClock)
+{
+  double seconds=std::max(stopClock.GetMilliseconds()/1000.0,0.001);
+
+  std::cout << name << ": " << stopClock.ResultString() << " "
+            << size_t(double(points)/seconds) << " points/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc>1) {
+    POINT_COUNT=std::stoul(argv[1]);
+  }
+
+  std::string fileName=(std::filesystem::temp_directory_path() / "GpxPerformanceTest.gpx").string();
+
+  osmscout::StopClock writeTimer;
+
+  if (!WriteTestFile(fileName)) {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return 1;
+  }
+
+  writeTimer.Stop();
+  DumpThroughput("Streaming export",POINT_COUNT,writeTimer);
+
+  int result=0;
+
+  osmscout::StopClock treeTimer;
+  osmscout::gpx::GpxFile gpxFile;
+
+  if (!osmscout::gpx::ImportGpx(fileName,gpxFile) ||
+      gpxFile.tracks.size()!=1 ||
+      gpxFile.tracks.front().GetPointCount()!=POINT_COUNT) {
+    std::cerr << "Object tree import failed" << std::endl;
+    result=1;
+  }
+
+  treeTimer.Stop();
+  DumpThroughput("Object tree import",POINT_COUNT,treeTimer);
+
+  osmscout::StopClock exportTimer;
+
+  if (!osmscout::gpx::ExportGpx(gpxFile,fileName+".copy")) {
+    std::cerr << "Object tree export failed" << std::endl;
+    result=1;
+  }
+
+  exportTimer.Stop();
+  DumpThroughput("Object tree export",POINT_COUNT,exportTimer);
+
+  gpxFile=osmscout::gpx::GpxFile();
+
+  osmscout::StopClock streamTimer;
+  CountingHandler     handler;
+
+  if (!osmscout::gpx::ImportGpx(fileName,handler) ||
+      handler.tracks!=1 ||
+      handler.segments!=1 ||
+      handler.points!=POINT_COUNT) {
+    std::cerr << "Streaming import failed" << std::endl;
+    result=1;
+  }
+
+  streamTimer.Stop();
+  DumpThroughput("Streaming import",POINT_COUNT,streamTimer);
+
+  std::vector<std::string>                   files(FILE_COUNT,fileName);
+  std::vector<osmscout::gpx::GpxHandlerRef>  handlers;
+  std::vector<std::shared_ptr<CountingHandler>> counters;
+
+  for (size_t i=0; i<FILE_COUNT; i++) {
+    counters.push_back(std::make_shared<CountingHandler>());
+    handlers.push_back(counters.back());
+  }
+
+  osmscout::StopClock parallelTimer;
+
+  if (!osmscout::gpx::ImportGpx(files,handlers,FILE_COUNT)) {
+    std::cerr << "Parallel streaming import failed" << std::endl;
+    result=1;
+  }
+
+  parallelTimer.Stop();
+
+  for (const auto& counter : counters) {
+    if (counter->points!=POINT_COUNT) {
+      std::cerr << "Parallel streaming import returned " << counter->points << " points" << std::endl;
+      result=1;
+    }
+  }
+
+  DumpThroughput("Parallel streaming import ("+std::to_string(FILE_COUNT)+" files)",POINT_COUNT*FILE_COUNT,parallelTimer);
+
+  std::filesystem::remove(fileName);
+  std::filesystem::remove(fileName+".copy");
+
+  return result;
+}
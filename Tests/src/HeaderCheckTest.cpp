@@ -109,6 +109,7 @@ static const std::set<std::string> allowedDependencies{
     "osmscout.elevation => osmscout.system",
     "osmscout.elevation => osmscout.log",
     "osmscout.elevation => osmscout.util",
+    "osmscout.elevation => osmscout.io",
     "osmscout.elevation => osmscout.feature",
     "osmscout.elevation => osmscout", // Fix this
     "osmscout.location => osmscout.system",
@@ -231,7 +232,6 @@ static const std::set<std::string> allowedDependencies{
     "osmscoutmapgdi => osmscout.io",
     "osmscoutmapgdi => osmscoutmap",
 
-    "osmscoutmapopengl => osmscout.system",
     "osmscoutmapopengl => osmscout.log",
     "osmscoutmapopengl => osmscout.util",
     "osmscoutmapopengl => osmscout.projection",
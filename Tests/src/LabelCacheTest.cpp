@@ -0,0 +1,213 @@
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <osmscoutmap/LabelLayouter.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace osmscout;
+
+struct TestNativeGlyph
+{
+  char character;
+};
+
+struct TestNativeLabel
+{
+  size_t layoutId;
+};
+
+using TestLabel = Label<TestNativeGlyph,TestNativeLabel>;
+using TestLabelCache = LabelCache<TestNativeGlyph,TestNativeLabel>;
+
+template<>
+std::vector<Glyph<TestNativeGlyph>> TestLabel::ToGlyphs() const
+{
+  std::vector<Glyph<TestNativeGlyph>> result;
+
+  for (size_t i=0; i<text.size(); i++) {
+    result.emplace_back();
+    result.back().glyph.character=text[i];
+    result.back().position=Vertex2D(double(i)*10.0,0.0);
+  }
+
+  return result;
+}
+
+static LabelCacheKey GetKey(const std::string& text,
+                            double fontSize=12.0,
+                            const void* owner=nullptr)
+{
+  return LabelCacheKey{text,"DejaVu Sans",fontSize,0,false,false,owner};
+}
+
+static std::shared_ptr<TestLabel> CreateLabel(const std::string& text,
+                                              size_t layoutId)
+{
+  auto label=std::make_shared<TestLabel>(TestNativeLabel{layoutId});
+
+  label->text=text;
+  label->width=double(text.size())*10.0;
+  label->height=12.0;
+
+  return label;
+}
+
+TEST_CASE("Label is laid out once")
+{
+  TestLabelCache cache;
+  size_t         layoutCount=0;
+
+  auto layout=[&layoutCount]() {
+    layoutCount++;
+    return CreateLabel("Main Street",layoutCount);
+  };
+
+  auto label1=cache.GetLabel(GetKey("Main Street"),layout);
+  auto label2=cache.GetLabel(GetKey("Main Street"),layout);
+
+  REQUIRE(layoutCount==1);
+  REQUIRE(label1==label2);
+
+  TestLabelCache::Statistics statistics=cache.GetStatistics();
+
+  REQUIRE(statistics.hits==1);
+  REQUIRE(statistics.misses==1);
+  REQUIRE(statistics.entries==1);
+  REQUIRE(statistics.memory>0);
+}
+
+TEST_CASE("Different font sizes are different labels")
+{
+  TestLabelCache cache;
+  size_t         layoutCount=0;
+
+  auto layout=[&layoutCount]() {
+    layoutCount++;
+    return CreateLabel("Main Street",layoutCount);
+  };
+
+  auto label1=cache.GetLabel(GetKey("Main Street",12.0),layout);
+  auto label2=cache.GetLabel(GetKey("Main Street",14.0),layout);
+
+  REQUIRE(layoutCount==2);
+  REQUIRE(label1!=label2);
+  REQUIRE(cache.GetStatistics().entries==2);
+}
+
+TEST_CASE("Labels of different owners are not shared")
+{
+  TestLabelCache cache;
+  size_t         layoutCount=0;
+  int            owner1=0;
+  int            owner2=0;
+
+  auto layout=[&layoutCount]() {
+    layoutCount++;
+    return CreateLabel("Main Street",layoutCount);
+  };
+
+  auto label1=cache.GetLabel(GetKey("Main Street",12.0,&owner1),layout);
+  auto label2=cache.GetLabel(GetKey("Main Street",12.0,&owner2),layout);
+  auto label3=cache.GetLabel(GetKey("Main Street",12.0,&owner1),layout);
+
+  REQUIRE(layoutCount==2);
+  REQUIRE(label1!=label2);
+  REQUIRE(label1==label3);
+}
+
+TEST_CASE("Least recently used labels are evicted")
+{
+  TestLabelCache cache;
+
+  cache.GetLabel(GetKey("A"),[]() { return CreateLabel("A",1); });
+
+  size_t entryMemory=cache.GetStatistics().memory;
+
+  cache.SetMemoryBudget(entryMemory*2);
+
+  cache.GetLabel(GetKey("B"),[]() { return CreateLabel("B",2); });
+  // Touch A, so that B is the least recently used label
+  cache.GetLabel(GetKey("A"),[]() { return CreateLabel("A",3); });
+  cache.GetLabel(GetKey("C"),[]() { return CreateLabel("C",4); });
+
+  TestLabelCache::Statistics statistics=cache.GetStatistics();
+
+  REQUIRE(statistics.entries==2);
+  REQUIRE(statistics.evictions==1);
+  REQUIRE(statistics.memory<=statistics.memoryBudget);
+
+  REQUIRE(cache.GetLabel(GetKey("A"),[]() { return CreateLabel("A",5); })->label.layoutId==1);
+  REQUIRE(cache.GetLabel(GetKey("B"),[]() { return CreateLabel("B",6); })->label.layoutId==6);
+}
+
+TEST_CASE("Glyphs are cached with the label")
+{
+  TestLabelCache cache;
+  LabelCacheKey  key=GetKey("Main Street");
+
+  auto label=cache.GetLabel(key,[]() { return CreateLabel("Main Street",1); });
+
+  size_t memory=cache.GetStatistics().memory;
+
+  auto glyphs1=cache.GetGlyphs(key,label);
+  auto glyphs2=cache.GetGlyphs(key,label);
+
+  REQUIRE(glyphs1->size()==11);
+  REQUIRE(glyphs1==glyphs2);
+  REQUIRE(cache.GetStatistics().memory>memory);
+}
+
+TEST_CASE("Flush removes all labels")
+{
+  TestLabelCache cache;
+
+  cache.GetLabel(GetKey("A"),[]() { return CreateLabel("A",1); });
+  cache.GetLabel(GetKey("B"),[]() { return CreateLabel("B",2); });
+
+  cache.Flush();
+
+  TestLabelCache::Statistics statistics=cache.GetStatistics();
+
+  REQUIRE(statistics.entries==0);
+  REQUIRE(statistics.memory==0);
+  REQUIRE(cache.GetLabel(GetKey("A"),[]() { return CreateLabel("A",3); })->label.layoutId==3);
+}
+
+TEST_CASE("Cache is shared between threads")
+{
+  TestLabelCache           cache;
+  std::atomic<size_t>      layoutCount{0};
+  std::atomic<size_t>      wrongLabelCount{0};
+  std::vector<std::thread> threads;
+
+  for (size_t t=0; t<4; t++) {
+    threads.emplace_back([&cache,&layoutCount,&wrongLabelCount]() {
+      for (size_t i=0; i<1000; i++) {
+        std::string text="Label "+std::to_string(i%50);
+        auto        label=cache.GetLabel(GetKey(text),[&layoutCount,&text]() {
+          layoutCount++;
+          return CreateLabel(text,layoutCount);
+        });
+
+        if (label->text!=text) {
+          wrongLabelCount++;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  TestLabelCache::Statistics statistics=cache.GetStatistics();
+
+  REQUIRE(wrongLabelCount==0);
+  REQUIRE(statistics.entries==50);
+  REQUIRE(statistics.hits+statistics.misses==4000);
+  REQUIRE(layoutCount>=50);
+  REQUIRE(layoutCount==statistics.misses);
+}
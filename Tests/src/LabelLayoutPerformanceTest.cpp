@@ -0,0 +1,242 @@
+/*
+  LabelLayoutPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscoutmap/LabelLayouterHelper.h>
+
+/**
+  Simulate the collision detection of the label layouter for a label dense, high DPI
+  screen: a number of random label candidates (single labels, icon+label combinations and
+  contour labels made of glyphs) is placed on the screen in the order of generation, if it
+  does not collide with already placed labels.
+
+  Reports throughput in labels per millisecond and checks the result against a brute force
+  rectangle intersection test.
+
+  Arguments: [label count] [screen width] [screen height] [rounds]
+*/
+
+struct Candidate
+{
+  std::vector<osmscout::ScreenPixelRectangle> rectangles;
+};
+
+static std::vector<Candidate> GenerateCandidates(size_t count,
+                                                 int screenWidth,
+                                                 int screenHeight)
+{
+  std::mt19937                       gen(4711);
+  std::uniform_int_distribution<int> kindDis(0,9);
+  std::uniform_int_distribution<int> textWidthDis(40,400);
+  std::uniform_int_distribution<int> textHeightDis(16,48);
+  std::uniform_int_distribution<int> iconSizeDis(24,64);
+  std::uniform_int_distribution<int> glyphCountDis(4,24);
+  std::uniform_int_distribution<int> glyphSizeDis(12,32);
+  std::uniform_int_distribution<int> stepDis(-8,8);
+
+  std::vector<Candidate> candidates;
+
+  candidates.reserve(count);
+
+  // All rectangles are completely on the screen, so that the brute force check is exact
+  auto randomPosition=[&gen](int width, int height, int maxX, int maxY) {
+    std::uniform_int_distribution<int> xDis(0,maxX-width);
+    std::uniform_int_distribution<int> yDis(0,maxY-height);
+
+    return osmscout::ScreenPixelRectangle(xDis(gen),yDis(gen),width,height);
+  };
+
+  for (size_t i=0; i<count; i++) {
+    Candidate candidate;
+    int       kind=kindDis(gen);
+
+    if (kind<5) {
+      candidate.rectangles.push_back(randomPosition(textWidthDis(gen),textHeightDis(gen),screenWidth,screenHeight));
+    }
+    else if (kind<8) {
+      int                            iconSize=iconSizeDis(gen);
+      int                            textWidth=textWidthDis(gen);
+      int                            textHeight=textHeightDis(gen);
+      osmscout::ScreenPixelRectangle icon=randomPosition(std::max(iconSize,textWidth),
+                                                         iconSize+textHeight,
+                                                         screenWidth,
+                                                         screenHeight);
+
+      candidate.rectangles.emplace_back(icon.x,icon.y,iconSize,iconSize);
+      candidate.rectangles.emplace_back(icon.x,icon.y+iconSize,textWidth,textHeight);
+    }
+    else {
+      int                            glyphCount=glyphCountDis(gen);
+      int                            glyphSize=glyphSizeDis(gen);
+      osmscout::ScreenPixelRectangle start=randomPosition(glyphCount*glyphSize,
+                                                          glyphSize+glyphCount*8,
+                                                          screenWidth,
+                                                          screenHeight);
+      int                            y=start.y+glyphCount*4;
+
+      for (int g=0; g<glyphCount; g++) {
+        y=std::max(start.y,std::min(start.y+glyphCount*8,y+stepDis(gen)));
+        candidate.rectangles.emplace_back(start.x+g*glyphSize,y,glyphSize,glyphSize);
+      }
+    }
+
+    candidates.push_back(std::move(candidate));
+  }
+
+  return candidates;
+}
+
+static std::vector<bool> LayoutWithScreenMask(const std::vector<Candidate>& candidates,
+                                              size_t screenWidth,
+                                              size_t screenHeight)
+{
+  osmscout::ScreenMask                  canvas(screenWidth,screenHeight);
+  std::vector<osmscout::ScreenRectMask> masks;
+  std::vector<bool>                     placed;
+
+  placed.reserve(candidates.size());
+
+  for (const auto& candidate : candidates) {
+    bool collision=false;
+
+    if (masks.size()<candidate.rectangles.size()) {
+      masks.resize(candidate.rectangles.size());
+    }
+
+    for (size_t r=0; r<candidate.rectangles.size(); r++) {
+      masks[r].Set(screenWidth,candidate.rectangles[r]);
+
+      if (canvas.HasCollision(masks[r])) {
+        collision=true;
+        break;
+      }
+    }
+
+    if (!collision) {
+      for (size_t r=0; r<candidate.rectangles.size(); r++) {
+        canvas.AddMask(masks[r]);
+      }
+    }
+
+    placed.push_back(!collision);
+  }
+
+  return placed;
+}
+
+static std::vector<bool> LayoutBruteForce(const std::vector<Candidate>& candidates)
+{
+  std::vector<osmscout::ScreenPixelRectangle> placedRectangles;
+  std::vector<bool>                           placed;
+
+  placed.reserve(candidates.size());
+
+  for (const auto& candidate : candidates) {
+    bool collision=false;
+
+    for (const auto& rectangle : candidate.rectangles) {
+      for (const auto& placedRectangle : placedRectangles) {
+        if (rectangle.Intersects(placedRectangle)) {
+          collision=true;
+          break;
+        }
+      }
+
+      if (collision) {
+        break;
+      }
+    }
+
+    if (!collision) {
+      placedRectangles.insert(placedRectangles.end(),
+                              candidate.rectangles.begin(),
+                              candidate.rectangles.end());
+    }
+
+    placed.push_back(!collision);
+  }
+
+  return placed;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t labelCount=50000;
+  size_t screenWidth=3840;
+  size_t screenHeight=2160;
+  size_t rounds=10;
+
+  if (argc>1) {
+    labelCount=std::stoul(argv[1]);
+  }
+
+  if (argc>2) {
+    screenWidth=std::stoul(argv[2]);
+  }
+
+  if (argc>3) {
+    screenHeight=std::stoul(argv[3]);
+  }
+
+  if (argc>4) {
+    rounds=std::max(size_t(1),size_t(std::stoul(argv[4])));
+  }
+
+  std::cout << "Generating " << labelCount << " label candidates for a " << screenWidth << "x" << screenHeight << " screen..." << std::endl;
+
+  std::vector<Candidate> candidates=GenerateCandidates(labelCount,int(screenWidth),int(screenHeight));
+  std::vector<bool>      placed;
+  double                 totalTime=0.0;
+
+  for (size_t round=0; round<rounds; round++) {
+    osmscout::StopClock timer;
+
+    placed=LayoutWithScreenMask(candidates,screenWidth,screenHeight);
+
+    timer.Stop();
+    totalTime+=timer.GetMilliseconds();
+  }
+
+  size_t placedCount=std::count(placed.begin(),placed.end(),true);
+  double timePerRound=totalTime/double(rounds);
+
+  std::cout << "Placed " << placedCount << " of " << labelCount << " labels" << std::endl;
+  std::cout << "Layout: " << timePerRound << " ms per round, "
+            << (timePerRound>0.0 ? size_t(double(labelCount)/timePerRound) : 0) << " labels/ms" << std::endl;
+
+  std::cout << "Checking result against brute force rectangle intersection..." << std::endl;
+
+  std::vector<bool> expected=LayoutBruteForce(candidates);
+
+  if (placed!=expected) {
+    std::cerr << "Layout result differs from brute force result" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
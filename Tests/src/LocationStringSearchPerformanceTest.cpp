@@ -0,0 +1,255 @@
+/*
+  LocationStringSearchPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <osmscoutimport/Import.h>
+#include <osmscoutimport/ImportProgress.h>
+
+#include <osmscout-test/PreprocessOLT.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/location/LocationService.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/StopClock.h>
+
+/**
+  Imports the location test data and runs the queries of the string search test against
+  it, first using the location n-gram index, then after deleting the index using the
+  traversal of the location index only. Checks, that both return the same results and
+  reports the p50 and p99 latency of both.
+
+  Arguments: [iterations]
+*/
+
+static const std::vector<std::string> queries={
+  "Dortmund",
+  "Hamburg",
+  "Dortm",
+  "Brechten",
+  "Brecht",
+  "Am Birkenbaum Dortmund",
+  "Trallafittistraße Dortmund",
+  "Am Birken Dortmund",
+  "Dortmund Am Birken",
+  "Am Birkenbaum 1 Dortmund",
+  "Am Birkenbaum 10 Dortmund",
+  "Dortmund Am Birkenbaum 1"
+};
+
+class PreprocessorFactory : public osmscout::PreprocessorFactory
+{
+public:
+  std::unique_ptr<osmscout::Preprocessor> GetProcessor(const std::string& /*filename*/,
+                                                       osmscout::PreprocessorCallback& callback) const override
+  {
+    return std::unique_ptr<osmscout::Preprocessor>(new osmscout::test::PreprocessOLT(callback));
+  }
+};
+
+struct Run
+{
+  std::vector<std::string> results;   //!< Textual result per query
+  std::vector<double>      latencies; //!< Latencies of all queries in milliseconds
+};
+
+static std::string ResultToString(const osmscout::LocationSearchResult& result)
+{
+  std::ostringstream stream;
+
+  for (const auto& entry : result.results) {
+    stream << (entry.adminRegion ? entry.adminRegion->name : "") << "/" << entry.adminRegionMatchQuality << "|";
+    stream << (entry.location ? entry.location->name : "") << "/" << entry.locationMatchQuality << "|";
+    stream << (entry.address ? entry.address->name : "") << "/" << entry.addressMatchQuality << ";";
+  }
+
+  return stream.str();
+}
+
+static double GetPercentile(std::vector<double> values,
+                            double percentile)
+{
+  if (values.empty()) {
+    return 0.0;
+  }
+
+  size_t index=std::min(values.size()-1,
+                        size_t(percentile*double(values.size())));
+
+  std::nth_element(values.begin(),values.begin()+index,values.end());
+
+  return values[index];
+}
+
+static bool RunQueries(const std::string& databaseDirectory,
+                       size_t iterations,
+                       Run& run)
+{
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(databaseDirectory)) {
+    std::cerr << "Cannot open database '" << databaseDirectory << "'" << std::endl;
+    return false;
+  }
+
+  osmscout::LocationService locationService(database);
+
+  for (size_t iteration=0; iteration<iterations; iteration++) {
+    for (const auto& query : queries) {
+      osmscout::LocationStringSearchParameter parameter(query);
+      osmscout::LocationSearchResult          result;
+      osmscout::StopClock                     timer;
+
+      if (!locationService.SearchForLocationByString(parameter,
+                                                     result)) {
+        std::cerr << "Search for '" << query << "' failed" << std::endl;
+        return false;
+      }
+
+      timer.Stop();
+
+      run.latencies.push_back(timer.GetMilliseconds());
+
+      if (iteration==0) {
+        run.results.push_back(ResultToString(result));
+      }
+    }
+  }
+
+  database->Close();
+
+  return true;
+}
+
+static void DumpRun(const std::string& name,
+                    const Run& run)
+{
+  std::cout << std::setw(8) << std::left << name << std::right << std::fixed << std::setprecision(3)
+            << " p50: " << GetPercentile(run.latencies,0.5) << " ms"
+            << " p99: " << GetPercentile(run.latencies,0.99) << " ms"
+            << " (" << run.latencies.size() << " queries)" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  size_t iterations=50;
+
+  if (argc>1) {
+    iterations=std::stoul(argv[1]);
+  }
+
+  char* testsTopDirEnv=getenv("TESTS_TOP_DIR");
+
+  if (testsTopDirEnv==nullptr) {
+    std::cerr << "Expected environment variable 'TESTS_TOP_DIR' not set" << std::endl;
+    return 1;
+  }
+
+  std::string testsTopDir=testsTopDirEnv;
+
+  if (!osmscout::IsDirectory(testsTopDir)) {
+    std::cerr << "Environment variable 'TESTS_TOP_DIR' does not point to directory" << std::endl;
+    return 77;
+  }
+
+  char*       testsTmpDirEnv=getenv("TESTS_TMP_DIR");
+  std::string databaseDirectory=osmscout::AppendFileToDir(testsTmpDirEnv!=nullptr ? testsTmpDirEnv : ".",
+                                                          "LocationStringSearchPerformance");
+
+  std::filesystem::create_directories(databaseDirectory);
+
+  osmscout::ImportParameter importParameter;
+  osmscout::ImportProgress  progress;
+  std::list<std::string>    mapfiles;
+
+  mapfiles.emplace_back(osmscout::AppendFileToDir(testsTopDir,"LocationTest.olt"));
+
+  importParameter.SetTypefile(osmscout::AppendFileToDir(testsTopDir,"../stylesheets/map.ost"));
+  importParameter.SetMapfiles(mapfiles);
+  importParameter.SetDestinationDirectory(databaseDirectory);
+  importParameter.SetPreprocessorFactory(std::make_shared<PreprocessorFactory>());
+
+  try {
+    osmscout::Importer importer(importParameter);
+
+    if (!importer.Import(progress)) {
+      std::cerr << "Import failed" << std::endl;
+      return 1;
+    }
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Import failed: " << e.GetDescription() << std::endl;
+    return 1;
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+
+  Run nGramRun;
+
+  if (!RunQueries(databaseDirectory,iterations,nGramRun)) {
+    return 1;
+  }
+
+  if (!osmscout::RemoveFile(osmscout::AppendFileToDir(databaseDirectory,
+                                                      osmscout::LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX))) {
+    std::cerr << "Cannot remove location n-gram index" << std::endl;
+    return 1;
+  }
+
+  Run traversalRun;
+
+  if (!RunQueries(databaseDirectory,iterations,traversalRun)) {
+    return 1;
+  }
+
+  DumpRun("N-gram",nGramRun);
+  DumpRun("Traverse",traversalRun);
+
+  size_t mismatches=0;
+
+  for (size_t i=0; i<queries.size(); i++) {
+    if (nGramRun.results[i]!=traversalRun.results[i]) {
+      std::cerr << "Mismatch for '" << queries[i] << "': '"
+                << nGramRun.results[i] << "' vs. '" << traversalRun.results[i] << "'" << std::endl;
+      mismatches++;
+    }
+  }
+
+  if (mismatches>0) {
+    std::cerr << mismatches << " mismatches" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,435 @@
+/*
+  MVTPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscoutmap/MapService.h>
+
+#include <osmscoutmapmvt/MVTTiler.h>
+
+/**
+  Generate vector tiles for the whole database with one and with multiple worker threads,
+  report throughput in tiles per second and check, that the generated tiles are valid
+  protobuf encoded MVT tiles.
+
+  Arguments: <database directory> <oss file> [start zoom] [end zoom] [thread count]
+*/
+
+/**
+ * Minimal protobuf reader, sufficient to check the structure of a MVT tile
+ */
+class ProtobufReader
+{
+private:
+  const uint8_t* pos;
+  const uint8_t* end;
+
+public:
+  ProtobufReader(const char* data, size_t size)
+  : pos(reinterpret_cast<const uint8_t*>(data)),
+    end(reinterpret_cast<const uint8_t*>(data)+size)
+  {
+  }
+
+  bool AtEnd() const
+  {
+    return pos>=end;
+  }
+
+  bool ReadVarint(uint64_t& value)
+  {
+    value=0;
+
+    for (int shift=0; shift<64 && pos<end; shift+=7) {
+      uint8_t byte=*pos++;
+
+      value|=uint64_t(byte & 0x7f) << shift;
+
+      if ((byte & 0x80)==0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool ReadField(uint32_t& field,
+                 uint32_t& wireType,
+                 uint64_t& value,
+                 ProtobufReader& content)
+  {
+    uint64_t key;
+
+    if (!ReadVarint(key)) {
+      return false;
+    }
+
+    field=uint32_t(key >> 3);
+    wireType=uint32_t(key & 0x7);
+
+    if (wireType==0) {
+      return ReadVarint(value);
+    }
+
+    if (wireType==2) {
+      if (!ReadVarint(value) || value>uint64_t(end-pos)) {
+        return false;
+      }
+
+      content=ProtobufReader(reinterpret_cast<const char*>(pos),size_t(value));
+      pos+=value;
+
+      return true;
+    }
+
+    return false;
+  }
+};
+
+/**
+ * Check the geometry commands of a feature. All coordinates must be within the buffered tile.
+ */
+static bool CheckGeometry(ProtobufReader geometry,
+                          uint64_t type,
+                          int64_t min,
+                          int64_t max)
+{
+  int64_t x=0;
+  int64_t y=0;
+  size_t  commands=0;
+
+  while (!geometry.AtEnd()) {
+    uint64_t commandInteger;
+
+    if (!geometry.ReadVarint(commandInteger)) {
+      return false;
+    }
+
+    uint64_t command=commandInteger & 0x7;
+    uint64_t count=commandInteger >> 3;
+
+    if (command==7) {
+      if (type!=3 || count!=1) {
+        return false;
+      }
+      continue;
+    }
+
+    if ((command!=1 && command!=2) || count==0) {
+      return false;
+    }
+
+    for (uint64_t i=0; i<count; i++) {
+      uint64_t dx;
+      uint64_t dy;
+
+      if (!geometry.ReadVarint(dx) ||
+          !geometry.ReadVarint(dy)) {
+        return false;
+      }
+
+      x+=int64_t(dx >> 1) ^ -int64_t(dx & 1);
+      y+=int64_t(dy >> 1) ^ -int64_t(dy & 1);
+
+      if (x<min || x>max || y<min || y>max) {
+        return false;
+      }
+    }
+
+    commands++;
+  }
+
+  return commands>0;
+}
+
+/**
+ * Check the structure of a MVT tile and count its features
+ */
+static bool CheckTile(const std::vector<char>& data,
+                      size_t& featureCount)
+{
+  ProtobufReader tile(data.data(),data.size());
+
+  while (!tile.AtEnd()) {
+    uint32_t       field;
+    uint32_t       wireType;
+    uint64_t       value;
+    ProtobufReader layer(nullptr,0);
+
+    if (!tile.ReadField(field,wireType,value,layer) ||
+        field!=3 ||
+        wireType!=2) {
+      return false;
+    }
+
+    bool     hasName=false;
+    uint64_t version=0;
+    uint64_t extent=4096;
+    size_t   keyCount=0;
+    size_t   valueCount=0;
+    std::vector<ProtobufReader> features;
+
+    while (!layer.AtEnd()) {
+      ProtobufReader content(nullptr,0);
+
+      if (!layer.ReadField(field,wireType,value,content)) {
+        return false;
+      }
+
+      switch (field) {
+      case 1:
+        hasName=value>0;
+        break;
+      case 2:
+        features.push_back(content);
+        break;
+      case 3:
+        keyCount++;
+        break;
+      case 4:
+        valueCount++;
+        break;
+      case 5:
+        extent=value;
+        break;
+      case 15:
+        version=value;
+        break;
+      default:
+        return false;
+      }
+    }
+
+    if (!hasName || version!=2 || features.empty()) {
+      return false;
+    }
+
+    // Feature ids must be unique within a layer
+    std::unordered_set<uint64_t> ids;
+
+    for (auto& feature : features) {
+      uint64_t type=0;
+      bool     hasGeometry=false;
+
+      while (!feature.AtEnd()) {
+        ProtobufReader content(nullptr,0);
+
+        if (!feature.ReadField(field,wireType,value,content)) {
+          return false;
+        }
+
+        if (field==1) {
+          if (!ids.insert(value).second) {
+            return false;
+          }
+        }
+        else if (field==2) {
+          for (size_t i=0; !content.AtEnd(); i++) {
+            uint64_t index;
+
+            if (!content.ReadVarint(index) ||
+                index>=(i%2==0 ? keyCount : valueCount)) {
+              return false;
+            }
+          }
+        }
+        else if (field==3) {
+          type=value;
+        }
+        else if (field==4) {
+          if (type==0 ||
+              !CheckGeometry(content,type,-int64_t(extent),2*int64_t(extent))) {
+            return false;
+          }
+          hasGeometry=true;
+        }
+      }
+
+      if (!hasGeometry) {
+        return false;
+      }
+
+      featureCount++;
+    }
+  }
+
+  return true;
+}
+
+static bool CheckDirectory(const std::string& directory,
+                           size_t expectedTiles)
+{
+  size_t tileCount=0;
+  size_t featureCount=0;
+
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+    if (entry.path().extension()!=".pbf") {
+      continue;
+    }
+
+    std::vector<char> data;
+
+    if (!osmscout::ReadFile(entry.path().string(),data) ||
+        !CheckTile(data,featureCount)) {
+      std::cerr << "Invalid tile " << entry.path().string() << std::endl;
+      return false;
+    }
+
+    tileCount++;
+  }
+
+  std::cout << "Checked " << tileCount << " tile(s) with " << featureCount << " feature(s)" << std::endl;
+
+  if (tileCount!=expectedTiles) {
+    std::cerr << "Expected " << expectedTiles << " tile(s)" << std::endl;
+    return false;
+  }
+
+  return osmscout::ExistsInFilesystem(osmscout::AppendFileToDir(directory,"metadata.json"));
+}
+
+static void DumpStatistics(const std::string& name,
+                           const osmscout::MVTTiler::Statistics& statistics)
+{
+  std::cout << name << ": "
+            << statistics.tileCount << " tiles (" << statistics.emptyTileCount << " empty), "
+            << statistics.featureCount << " features, "
+            << statistics.byteCount << " bytes, "
+            << "load " << statistics.loadTime << " ms, "
+            << "encode " << statistics.encodeTime << " ms, "
+            << "write " << statistics.writeTime << " ms, "
+            << "total " << statistics.totalTime << " ms, "
+            << size_t(statistics.GetTilesPerSecond()) << " tiles/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc<3) {
+    std::cerr << "MVTPerformanceTest <database directory> <oss file> [start zoom] [end zoom] [thread count]" << std::endl;
+    return 1;
+  }
+
+  std::string                  databaseDirectory=argv[1];
+  std::string                  ossFile=argv[2];
+  osmscout::MagnificationLevel startLevel(10);
+  osmscout::MagnificationLevel endLevel(13);
+  size_t                       threadCount=std::max((unsigned int)2,std::thread::hardware_concurrency());
+
+  if (argc>3) {
+    startLevel=osmscout::MagnificationLevel(uint32_t(std::stoul(argv[3])));
+  }
+
+  if (argc>4) {
+    endLevel=osmscout::MagnificationLevel(uint32_t(std::stoul(argv[4])));
+  }
+
+  if (argc>5) {
+    threadCount=std::stoul(argv[5]);
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+  osmscout::log.Warn(false);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+  osmscout::MapServiceRef     mapService=std::make_shared<osmscout::MapService>(database);
+
+  if (!database->Open(databaseDirectory)) {
+    std::cerr << "Cannot open database '" << databaseDirectory << "'" << std::endl;
+    return 1;
+  }
+
+  osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  if (!styleConfig->Load(ossFile)) {
+    std::cerr << "Cannot load style sheet '" << ossFile << "'" << std::endl;
+    return 1;
+  }
+
+  osmscout::GeoBox boundingBox;
+
+  if (!database->GetBoundingBox(boundingBox)) {
+    std::cerr << "Cannot get bounding box of database" << std::endl;
+    return 1;
+  }
+
+  mapService->SetCacheSize(1000);
+
+  std::filesystem::path tmpDir=std::filesystem::temp_directory_path() / "MVTPerformanceTest";
+  int                   result=0;
+
+  std::filesystem::remove_all(tmpDir);
+
+  for (size_t threads : {size_t(1),threadCount}) {
+    std::string                    directory=(tmpDir / ("tiles-"+std::to_string(threads))).string();
+    osmscout::MVTDirectoryTileSink sink(directory);
+    osmscout::MVTTiler             tiler(mapService,styleConfig);
+    osmscout::MVTTiler::Statistics statistics;
+
+    tiler.SetThreadCount(threads);
+
+    if (!tiler.Process(boundingBox,startLevel,endLevel,sink,statistics)) {
+      std::cerr << "Tile generation with " << threads << " thread(s) failed" << std::endl;
+      result=1;
+      continue;
+    }
+
+    DumpStatistics(std::to_string(threads)+" thread(s)",statistics);
+
+    if (statistics.tileCount==statistics.emptyTileCount ||
+        !CheckDirectory(directory,statistics.tileCount-statistics.emptyTileCount)) {
+      result=1;
+    }
+  }
+
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+  std::string                    mbtilesFile=(tmpDir / "tiles.mbtiles").string();
+  osmscout::MVTMBTilesTileSink   mbtilesSink(mbtilesFile);
+  osmscout::MVTTiler             tiler(mapService,styleConfig);
+  osmscout::MVTTiler::Statistics statistics;
+
+  tiler.SetThreadCount(threadCount);
+
+  if (!tiler.Process(boundingBox,startLevel,endLevel,mbtilesSink,statistics) ||
+      !osmscout::ExistsInFilesystem(mbtilesFile)) {
+    std::cerr << "MBTiles generation failed" << std::endl;
+    result=1;
+  }
+  else {
+    DumpStatistics("MBTiles",statistics);
+  }
+#endif
+
+  std::filesystem::remove_all(tmpDir);
+
+  return result;
+}
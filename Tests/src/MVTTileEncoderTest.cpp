@@ -0,0 +1,472 @@
+/*
+  MVTTileEncoderTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/projection/TileProjection.h>
+
+#include <osmscoutmap/MapService.h>
+
+#include <osmscoutmapmvt/MVTTileEncoder.h>
+
+namespace {
+
+  std::string GetEnv(const char* name,
+                     const std::string& fallback)
+  {
+    const char * value=std::getenv(name);
+
+    return value!=nullptr ? std::string(value) : fallback;
+  }
+
+  struct Point
+  {
+    int64_t x;
+    int64_t y;
+  };
+
+  struct Feature
+  {
+    uint64_t                        id=0;
+    uint32_t                        type=0;
+    std::vector<std::vector<Point>> parts;      //!< Lines or rings of the geometry
+    size_t                          closedParts=0;
+  };
+
+  struct Layer
+  {
+    std::string          name;
+    uint64_t             version=0;
+    uint64_t             extent=0;
+    std::vector<Feature> features;
+  };
+
+  /**
+   * Minimal protobuf reader, just enough to decode the MVT messages
+   */
+  class Reader
+  {
+  private:
+    const char* pos;
+    const char* end;
+
+  public:
+    explicit Reader(const std::string& data)
+      : pos(data.data()),
+        end(data.data()+data.size())
+    {
+    }
+
+    bool AtEnd() const
+    {
+      return pos>=end;
+    }
+
+    uint64_t ReadVarint()
+    {
+      uint64_t value=0;
+
+      for (int shift=0; shift<64; shift+=7) {
+        REQUIRE(pos<end);
+
+        auto byte=uint8_t(*pos++);
+
+        value|=uint64_t(byte & 0x7f) << shift;
+
+        if ((byte & 0x80)==0) {
+          return value;
+        }
+      }
+
+      FAIL("Varint too long");
+      return 0;
+    }
+
+    std::string ReadBytes()
+    {
+      uint64_t length=ReadVarint();
+
+      REQUIRE(length<=uint64_t(end-pos));
+
+      std::string bytes(pos,size_t(length));
+
+      pos+=length;
+
+      return bytes;
+    }
+
+    /**
+     * Read the next field key, skip wire types other than varint (0) and length delimited (2)
+     */
+    bool ReadKey(uint32_t& field,
+                 uint32_t& wireType)
+    {
+      if (AtEnd()) {
+        return false;
+      }
+
+      uint64_t key=ReadVarint();
+
+      field=uint32_t(key >> 3);
+      wireType=uint32_t(key & 0x7);
+
+      REQUIRE((wireType==0 || wireType==2));
+
+      return true;
+    }
+  };
+
+  int64_t ZigZagDecode(uint64_t value)
+  {
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+  }
+
+  void DecodeGeometry(const std::string& data,
+                      Feature& feature)
+  {
+    Reader reader(data);
+    Point  cursor{0,0};
+
+    while (!reader.AtEnd()) {
+      uint64_t command=reader.ReadVarint();
+      uint64_t id=command & 0x7;
+      uint64_t count=command >> 3;
+
+      if (id==7) {
+        REQUIRE(count==1);
+        REQUIRE(!feature.parts.empty());
+        feature.closedParts++;
+        continue;
+      }
+
+      REQUIRE((id==1 || id==2));
+
+      for (uint64_t i=0; i<count; i++) {
+        cursor.x+=ZigZagDecode(reader.ReadVarint());
+        cursor.y+=ZigZagDecode(reader.ReadVarint());
+
+        if (id==1) {
+          feature.parts.emplace_back();
+        }
+        else {
+          REQUIRE(!feature.parts.empty());
+        }
+
+        feature.parts.back().push_back(cursor);
+      }
+    }
+  }
+
+  Feature DecodeFeature(const std::string& data)
+  {
+    Reader   reader(data);
+    Feature  feature;
+    uint32_t field;
+    uint32_t wireType;
+
+    while (reader.ReadKey(field,wireType)) {
+      if (wireType==0) {
+        uint64_t value=reader.ReadVarint();
+
+        if (field==1) {
+          feature.id=value;
+        }
+        else if (field==3) {
+          feature.type=uint32_t(value);
+        }
+      }
+      else {
+        std::string bytes=reader.ReadBytes();
+
+        if (field==4) {
+          DecodeGeometry(bytes,feature);
+        }
+      }
+    }
+
+    return feature;
+  }
+
+  std::vector<Layer> DecodeTile(const std::string& data)
+  {
+    Reader             tileReader(data);
+    std::vector<Layer> layers;
+    uint32_t           field;
+    uint32_t           wireType;
+
+    while (tileReader.ReadKey(field,wireType)) {
+      REQUIRE(field==3);
+      REQUIRE(wireType==2);
+
+      std::string layerData=tileReader.ReadBytes();
+      Reader      reader(layerData);
+      Layer       layer;
+
+      while (reader.ReadKey(field,wireType)) {
+        if (wireType==0) {
+          uint64_t value=reader.ReadVarint();
+
+          if (field==5) {
+            layer.extent=value;
+          }
+          else if (field==15) {
+            layer.version=value;
+          }
+        }
+        else {
+          std::string bytes=reader.ReadBytes();
+
+          if (field==1) {
+            layer.name=bytes;
+          }
+          else if (field==2) {
+            layer.features.push_back(DecodeFeature(bytes));
+          }
+        }
+      }
+
+      layers.push_back(layer);
+    }
+
+    return layers;
+  }
+
+  uint64_t FeatureId(osmscout::RefType type,
+                     osmscout::FileOffset offset,
+                     size_t ring=0)
+  {
+    return ((offset+ring) << 2) | uint64_t(type);
+  }
+
+  Point Project(const osmscout::TileProjection& projection,
+                const osmscout::GeoCoord& coord)
+  {
+    osmscout::Vertex2D pixel;
+
+    projection.GeoToPixel(coord,pixel);
+
+    return Point{std::lround(pixel.GetX()),
+                 std::lround(pixel.GetY())};
+  }
+
+  bool IsClose(const Point& a,
+               const Point& b)
+  {
+    return std::abs(a.x-b.x)<=1 && std::abs(a.y-b.y)<=1;
+  }
+}
+
+TEST_CASE("Encoded vector tile decodes to the objects of the tile")
+{
+  std::filesystem::path databaseDirectory=std::filesystem::path(GetEnv("TESTS_TOP_DIR",".")) / "data" / "testregion";
+  std::filesystem::path ossFile=std::filesystem::path(GetEnv("TESTS_TOP_DIR",".")) / ".." / "stylesheets" / "standard.oss";
+
+  osmscout::DatabaseParameter databaseParameter;
+  auto                        database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  REQUIRE(database->Open(databaseDirectory.string()));
+
+  auto mapService=std::make_shared<osmscout::MapService>(database);
+  auto styleConfig=std::make_shared<osmscout::StyleConfig>(database->GetTypeConfig());
+
+  REQUIRE(styleConfig->Load(ossFile.string()));
+
+  // Tile with roads and areas, used by the routing tests, too
+  osmscout::Magnification magnification{osmscout::MagnificationLevel(14)};
+  osmscout::OSMTileId     tile=osmscout::OSMTileId::GetOSMTile(magnification,
+                                                               osmscout::GeoCoord(50.42,14.56));
+
+  osmscout::MapData            data;
+  std::list<osmscout::TileRef> tiles;
+
+  mapService->LookupTiles(magnification,
+                          tile.GetBoundingBox(magnification),
+                          tiles);
+  REQUIRE(mapService->LoadMissingTileData(osmscout::AreaSearchParameter(),
+                                          *styleConfig,
+                                          tiles));
+  mapService->AddTileDataToMapData(tiles,
+                                   data);
+
+  osmscout::MVTTileEncoder encoder;
+  std::string              tileData;
+
+  REQUIRE(encoder.Encode(tile,
+                         magnification,
+                         data,
+                         tileData));
+  REQUIRE(!tileData.empty());
+
+  // Expected features by id: type name of the object (or ring) and geometry
+  std::map<uint64_t,std::string>                     expectedLayer;
+  std::map<uint64_t,osmscout::GeoCoord>              expectedPoint;
+  std::map<uint64_t,std::vector<osmscout::GeoCoord>> expectedLine;
+
+  // Only database objects, there are no manually added POI objects
+  for (const auto& node : data.nodes) {
+    uint64_t id=FeatureId(osmscout::refNode,node->GetFileOffset());
+
+    expectedLayer[id]=node->GetType()->GetName();
+    expectedPoint[id]=node->GetCoords();
+  }
+
+  for (const auto& way : data.ways) {
+    uint64_t id=FeatureId(osmscout::refWay,way->GetFileOffset());
+
+    expectedLayer[id]=way->GetType()->GetName();
+
+    for (const auto& point : way->nodes) {
+      expectedLine[id].push_back(point.GetCoord());
+    }
+  }
+
+  for (const auto& area : data.areas) {
+    area->VisitRings([&area,&expectedLayer](size_t i,
+                                            const osmscout::Area::Ring&,
+                                            const osmscout::TypeInfoRef& type)->bool {
+      expectedLayer[FeatureId(osmscout::refArea,area->GetFileOffset(),i)]=type->GetName();
+
+      return true;
+    });
+  }
+
+  osmscout::TileProjection projection;
+
+  REQUIRE(projection.Set(tile,
+                         magnification,
+                         encoder.GetExtent(),
+                         encoder.GetExtent()));
+
+  const auto extent=int64_t(encoder.GetExtent());
+  const auto buffer=int64_t(encoder.GetBuffer());
+
+  std::vector<Layer>    layers=DecodeTile(tileData);
+  std::set<std::string> layerNames;
+  size_t                featureCount=0;
+  size_t                pointCount=0;
+  size_t                lineCount=0;
+  size_t                polygonCount=0;
+  size_t                fullLineCount=0;
+
+  for (const auto& layer : layers) {
+    REQUIRE(layer.version==2);
+    REQUIRE(layer.extent==encoder.GetExtent());
+    REQUIRE(!layer.features.empty());
+    REQUIRE(layerNames.insert(layer.name).second);
+
+    std::set<uint64_t> ids;
+
+    for (const auto& feature : layer.features) {
+      INFO("Feature " << feature.id << " in layer " << layer.name);
+
+      REQUIRE(ids.insert(feature.id).second);
+      REQUIRE(expectedLayer.count(feature.id)==1);
+      REQUIRE(expectedLayer[feature.id]==layer.name);
+      REQUIRE(!feature.parts.empty());
+
+      for (const auto& part : feature.parts) {
+        for (const auto& point : part) {
+          REQUIRE(point.x>=-buffer);
+          REQUIRE(point.x<=extent+buffer);
+          REQUIRE(point.y>=-buffer);
+          REQUIRE(point.y<=extent+buffer);
+        }
+      }
+
+      auto refType=osmscout::RefType(feature.id & 0x3);
+
+      if (refType==osmscout::refNode) {
+        REQUIRE(feature.type==1);
+        REQUIRE(feature.parts.size()==1);
+        REQUIRE(feature.parts.front().size()==1);
+
+        Point expected=Project(projection,expectedPoint[feature.id]);
+
+        REQUIRE(feature.parts.front().front().x==expected.x);
+        REQUIRE(feature.parts.front().front().y==expected.y);
+        pointCount++;
+      }
+      else if (refType==osmscout::refWay) {
+        REQUIRE(feature.type==2);
+
+        for (const auto& part : feature.parts) {
+          REQUIRE(part.size()>=2);
+        }
+
+        // A way completely inside of the tile is not clipped, simplification keeps its end points
+        const auto& nodes=expectedLine[feature.id];
+        Point       first=Project(projection,nodes.front());
+        Point       last=Project(projection,nodes.back());
+        bool        inside=true;
+
+        for (const auto& node : nodes) {
+          Point point=Project(projection,node);
+
+          inside=inside &&
+                 point.x>=0 && point.x<=extent &&
+                 point.y>=0 && point.y<=extent;
+        }
+
+        if (inside) {
+          REQUIRE(feature.parts.size()==1);
+          REQUIRE(IsClose(feature.parts.front().front(),first));
+          REQUIRE(IsClose(feature.parts.front().back(),last));
+          fullLineCount++;
+        }
+
+        lineCount++;
+      }
+      else {
+        REQUIRE(refType==osmscout::refArea);
+        REQUIRE(feature.type==3);
+        REQUIRE(feature.closedParts==feature.parts.size());
+
+        for (const auto& part : feature.parts) {
+          REQUIRE(part.size()>=3);
+        }
+
+        polygonCount++;
+      }
+
+      featureCount++;
+    }
+  }
+
+  REQUIRE(featureCount==encoder.GetFeatureCount());
+
+  std::vector<std::string> encodedLayerNames=encoder.GetLayerNames();
+
+  REQUIRE(layerNames==std::set<std::string>(encodedLayerNames.begin(),
+                                            encodedLayerNames.end()));
+  REQUIRE(pointCount>0);
+  REQUIRE(lineCount>0);
+  REQUIRE(fullLineCount>0);
+  REQUIRE(polygonCount>0);
+}
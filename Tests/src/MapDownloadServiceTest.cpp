@@ -27,10 +27,15 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
 #include <mutex>
+#include <random>
 #include <set>
 #include <thread>
 
@@ -63,6 +68,103 @@ public:
   }
 };
 
+/**
+ * Stand-in for a map server supporting HTTP range requests. Every file
+ * has distinct pseudo-random content. Requests may be delayed and the
+ * connection may be dropped after given number of bytes.
+ */
+class RangeHttpClient : public osmscout::HttpClient
+{
+public:
+  std::chrono::milliseconds latency{0};
+  std::atomic<uint64_t> failAfterBytes{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> bytesServed{0};
+  std::atomic<int> activeRequests{0};
+  std::atomic<int> maxActiveRequests{0};
+
+  static std::string Content(const std::string &url)
+  {
+    std::mt19937 generator(static_cast<uint32_t>(std::hash<std::string>()(url)));
+    std::string content(20000 + generator() % 3000, '\0');
+    for (auto &c : content) {
+      c = static_cast<char>(generator());
+    }
+    return content;
+  }
+
+  std::string Fetch([[maybe_unused]] const std::string &url) override
+  {
+    return "";
+  }
+
+  bool Download(const std::string &url,
+                const std::filesystem::path &dest,
+                [[maybe_unused]] osmscout::ProgressCallback progress) override
+  {
+    std::string content = Content(url);
+    std::ofstream out(dest, std::ios::binary);
+    out << content;
+    bytesServed += content.size();
+    return true;
+  }
+
+  uint64_t FetchContentLength(const std::string &url) override
+  {
+    return Content(url).size();
+  }
+
+  bool FetchRange(const std::string &url,
+                  uint64_t offset,
+                  uint64_t length,
+                  const osmscout::DataCallback &data) override
+  {
+    int active = ++activeRequests;
+    int maxActive = maxActiveRequests;
+    while (active > maxActive && !maxActiveRequests.compare_exchange_weak(maxActive, active)) {
+      // retry
+    }
+
+    std::this_thread::sleep_for(latency);
+
+    std::string content = Content(url);
+    bool result = offset + length <= content.size();
+    for (uint64_t pos = offset; result && pos < offset + length; pos += 1024) {
+      size_t size = static_cast<size_t>(std::min<uint64_t>(1024, offset + length - pos));
+      if (bytesServed + size > failAfterBytes) {
+        result = false; // connection dropped
+        break;
+      }
+      bytesServed += size;
+      result = data(content.data() + pos, size);
+    }
+
+    --activeRequests;
+    return result;
+  }
+};
+
+uint64_t MapSize()
+{
+  uint64_t size = 0;
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    size += RangeHttpClient::Content("https://example.com/test-dir/" + f).size();
+  }
+  return size;
+}
+
+bool MapFilesMatch(const std::filesystem::path &dir)
+{
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    std::ifstream in(dir / f, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    if (content != RangeHttpClient::Content("https://example.com/test-dir/" + f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class TestSettingsStorage : public osmscout::SettingsStorage
 {
 private:
@@ -309,6 +411,121 @@ TEST_CASE("MapDownloadService::DownloadMap returns false on HTTP error")
   std::filesystem::remove_all(tmpDir, ec);
 }
 
+TEST_CASE("MapDownloadService::DownloadMap downloads chunks in parallel")
+{
+  TestFixture fx;
+  RangeHttpClient httpClient;
+  httpClient.latency = std::chrono::milliseconds(2);
+
+  fx.service->SetDownloadParameter(osmscout::MapDownloadParameter{4, 4096});
+
+  std::error_code ec;
+  std::filesystem::path tmpDir = std::filesystem::temp_directory_path(ec) / "osmscout-test-chunked";
+  std::filesystem::remove_all(tmpDir, ec);
+
+  osmscout::MapProvider provider("test", "https://example.com", "");
+  osmscout::AvailableMapEntry entry("ChunkedMap", {"europe"}, "", provider, MapSize(), "test-dir",
+                                      osmscout::Timestamp(std::chrono::seconds(1480801927)), 10);
+
+  REQUIRE(fx.service->DownloadMap(entry, tmpDir, httpClient).StdFuture().get());
+
+  REQUIRE(MapFilesMatch(tmpDir));
+  REQUIRE(httpClient.bytesServed == MapSize());
+  REQUIRE(httpClient.maxActiveRequests > 1);
+  REQUIRE(httpClient.maxActiveRequests <= 4);
+
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    REQUIRE_FALSE(std::filesystem::exists(tmpDir / (f + osmscout::MapDirectory::TemporaryFileSuffix)));
+    REQUIRE_FALSE(std::filesystem::exists(tmpDir / (f + osmscout::MapDirectory::TemporaryFileSuffix + osmscout::MapDirectory::ResumeStateSuffix)));
+  }
+
+  std::filesystem::remove_all(tmpDir, ec);
+}
+
+TEST_CASE("MapDownloadService::DownloadMap resumes interrupted download")
+{
+  TestFixture fx;
+  RangeHttpClient httpClient;
+
+  fx.service->SetDownloadParameter(osmscout::MapDownloadParameter{4, 4096});
+
+  std::error_code ec;
+  std::filesystem::path tmpDir = std::filesystem::temp_directory_path(ec) / "osmscout-test-resume";
+  std::filesystem::remove_all(tmpDir, ec);
+
+  osmscout::MapProvider provider("test", "https://example.com", "");
+  osmscout::AvailableMapEntry entry("ResumeMap", {"europe"}, "", provider, MapSize(), "test-dir",
+                                      osmscout::Timestamp(std::chrono::seconds(1480801927)), 10);
+
+  // Connection drops in the middle of the download
+  httpClient.failAfterBytes = MapSize() / 2;
+  REQUIRE_FALSE(fx.service->DownloadMap(entry, tmpDir, httpClient).StdFuture().get());
+  REQUIRE(std::filesystem::exists(tmpDir / osmscout::MapDirectory::FileMetadata));
+
+  // Damage the first byte of partial files, damaged chunks have to be downloaded again
+  size_t partialFiles = 0;
+  for (const auto &f : osmscout::MapDownloadService::MapFiles()) {
+    std::filesystem::path tempPath = tmpDir / (f + osmscout::MapDirectory::TemporaryFileSuffix);
+    if (std::filesystem::exists(tempPath)) {
+      std::fstream file(tempPath, std::ios::in | std::ios::out | std::ios::binary);
+      char c = 0;
+      file.read(&c, 1);
+      file.seekp(0);
+      c = static_cast<char>(c ^ 0xFF);
+      file.write(&c, 1);
+      partialFiles++;
+    }
+  }
+  REQUIRE(partialFiles > 0);
+
+  uint64_t firstAttempt = httpClient.bytesServed;
+  httpClient.bytesServed = 0;
+  httpClient.failAfterBytes = std::numeric_limits<uint64_t>::max();
+
+  REQUIRE(fx.service->DownloadMap(entry, tmpDir, httpClient).StdFuture().get());
+  REQUIRE(MapFilesMatch(tmpDir));
+
+  // Only missing and damaged chunks were downloaded
+  REQUIRE(httpClient.bytesServed < MapSize());
+  REQUIRE(httpClient.bytesServed >= MapSize() - firstAttempt);
+
+  std::filesystem::remove_all(tmpDir, ec);
+}
+
+TEST_CASE("MapDownloadService::DownloadMap parallel download throughput")
+{
+  std::error_code ec;
+  std::filesystem::path tmpDir = std::filesystem::temp_directory_path(ec) / "osmscout-test-throughput";
+
+  osmscout::MapProvider provider("test", "https://example.com", "");
+  osmscout::AvailableMapEntry entry("ThroughputMap", {"europe"}, "", provider, MapSize(), "test-dir",
+                                      osmscout::Timestamp(std::chrono::seconds(1480801927)), 10);
+
+  auto Measure = [&](size_t connections) {
+    RangeHttpClient httpClient;
+    httpClient.latency = std::chrono::milliseconds(5);
+
+    std::filesystem::remove_all(tmpDir, ec);
+    auto start = std::chrono::steady_clock::now();
+    bool result = osmscout::MapDownloadService::DownloadMapSync(entry, tmpDir, httpClient, nullptr, {},
+                                                                 osmscout::MapDownloadParameter{connections, 4096});
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    REQUIRE(result);
+    REQUIRE(MapFilesMatch(tmpDir));
+
+    std::cout << connections << " connection(s): " << duration.count() << " s, "
+              << (double(MapSize()) / 1024.0 / duration.count()) << " KiB/s" << std::endl;
+    return duration.count();
+  };
+
+  double sequential = Measure(1);
+  double parallel = Measure(4);
+
+  REQUIRE(parallel < sequential);
+
+  std::filesystem::remove_all(tmpDir, ec);
+}
+
 TEST_CASE("MapDownloadService::MapFiles returns mandatory and optional files")
 {
   auto files = osmscout::MapDownloadService::MapFiles();
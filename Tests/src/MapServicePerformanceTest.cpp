@@ -0,0 +1,236 @@
+/*
+  MapServicePerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <atomic>
+#include <iostream>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osmscout/async/ThreadPool.h>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscoutmap/MapService.h>
+
+/**
+  Load all tiles of a range of magnification levels from multiple databases in
+  parallel, the way a client with multiple map databases does. Every database has its own
+  MapService, all services share one thread pool. Reports throughput in tiles per
+  second for a pool with a single worker and for a pool with one worker per hardware
+  thread and checks, that both load the same data.
+
+  Arguments: <database directory> <oss file> [database count] [start zoom] [end zoom]
+*/
+
+struct Service
+{
+  osmscout::DatabaseRef    database;
+  osmscout::MapServiceRef  mapService;
+  osmscout::StyleConfigRef styleConfig;
+};
+
+struct Result
+{
+  size_t tileCount=0;
+  size_t objectCount=0;
+  double time=0.0;
+  bool   success=true;
+};
+
+static size_t GetObjectCount(const osmscout::TileRef& tile)
+{
+  return tile->GetNodeData().GetDataSize()+
+         tile->GetWayData().GetDataSize()+
+         tile->GetAreaData().GetDataSize()+
+         tile->GetOptimizedWayData().GetDataSize()+
+         tile->GetOptimizedAreaData().GetDataSize()+
+         tile->GetRouteData().GetDataSize();
+}
+
+static bool OpenServices(const std::string& databaseDirectory,
+                         const std::string& ossFile,
+                         size_t databaseCount,
+                         const osmscout::ThreadPoolRef& threadPool,
+                         std::vector<Service>& services)
+{
+  for (size_t i=0; i<databaseCount; i++) {
+    osmscout::DatabaseParameter databaseParameter;
+    Service                     service;
+
+    service.database=std::make_shared<osmscout::Database>(databaseParameter);
+
+    if (!service.database->Open(databaseDirectory)) {
+      std::cerr << "Cannot open database '" << databaseDirectory << "'" << std::endl;
+      return false;
+    }
+
+    service.mapService=std::make_shared<osmscout::MapService>(service.database,
+                                                             threadPool);
+    service.mapService->SetCacheSize(10000);
+    service.styleConfig=std::make_shared<osmscout::StyleConfig>(service.database->GetTypeConfig());
+
+    if (!service.styleConfig->Load(ossFile)) {
+      std::cerr << "Cannot load style sheet '" << ossFile << "'" << std::endl;
+      return false;
+    }
+
+    services.push_back(std::move(service));
+  }
+
+  return true;
+}
+
+static Result LoadTiles(const std::vector<Service>& services,
+                        osmscout::MagnificationLevel startLevel,
+                        osmscout::MagnificationLevel endLevel)
+{
+  Result              result;
+  std::atomic<size_t> tileCount{0};
+  std::atomic<size_t> objectCount{0};
+  std::atomic<bool>   success{true};
+
+  osmscout::StopClock      timer;
+  std::vector<std::thread> clients;
+
+  // One client thread for each database, requesting visible tiles level by level
+  for (const auto& service : services) {
+    clients.emplace_back([&service,startLevel,endLevel,&tileCount,&objectCount,&success]() {
+      osmscout::AreaSearchParameter parameter;
+      osmscout::GeoBox              boundingBox;
+
+      parameter.SetPriority(osmscout::ThreadPool::Priority::High);
+
+      if (!service.database->GetBoundingBox(boundingBox)) {
+        success=false;
+        return;
+      }
+
+      for (osmscout::MagnificationLevel level=startLevel; level<=endLevel; level++) {
+        std::list<osmscout::TileRef> tiles;
+
+        service.mapService->LookupTiles(osmscout::Magnification(level),
+                                        boundingBox,
+                                        tiles);
+
+        if (!service.mapService->LoadMissingTileData(parameter,
+                                                     *service.styleConfig,
+                                                     tiles)) {
+          success=false;
+        }
+
+        for (const auto& tile : tiles) {
+          if (!tile->IsComplete()) {
+            success=false;
+          }
+
+          objectCount+=GetObjectCount(tile);
+        }
+
+        tileCount+=tiles.size();
+      }
+    });
+  }
+
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  timer.Stop();
+
+  result.tileCount=tileCount;
+  result.objectCount=objectCount;
+  result.time=timer.GetMilliseconds();
+  result.success=success;
+
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc<3) {
+    std::cerr << "MapServicePerformanceTest <database directory> <oss file> [database count] [start zoom] [end zoom]" << std::endl;
+    return 1;
+  }
+
+  std::string                  databaseDirectory=argv[1];
+  std::string                  ossFile=argv[2];
+  size_t                       databaseCount=4;
+  osmscout::MagnificationLevel startLevel(10);
+  osmscout::MagnificationLevel endLevel(12);
+  size_t                       threadCount=std::max((unsigned int)2,std::thread::hardware_concurrency());
+
+  if (argc>3) {
+    databaseCount=std::max(size_t(1),size_t(std::stoul(argv[3])));
+  }
+
+  if (argc>4) {
+    startLevel=osmscout::MagnificationLevel(uint32_t(std::stoul(argv[4])));
+  }
+
+  if (argc>5) {
+    endLevel=osmscout::MagnificationLevel(uint32_t(std::stoul(argv[5])));
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+  osmscout::log.Warn(false);
+
+  std::vector<Result> results;
+
+  for (size_t threads : {size_t(1),threadCount}) {
+    osmscout::ThreadPoolRef threadPool=std::make_shared<osmscout::ThreadPool>(threads);
+    std::vector<Service>    services;
+
+    if (!OpenServices(databaseDirectory,ossFile,databaseCount,threadPool,services)) {
+      return 1;
+    }
+
+    Result result=LoadTiles(services,startLevel,endLevel);
+
+    std::cout << databaseCount << " database(s), " << threads << " worker(s): "
+              << result.tileCount << " tiles, "
+              << result.objectCount << " objects, "
+              << result.time << " ms, "
+              << (result.time>0.0 ? size_t(double(result.tileCount)*1000.0/result.time) : 0) << " tiles/s, "
+              << threadPool->GetStolenJobCount() << " of " << threadPool->GetExecutedJobCount() << " tasks stolen" << std::endl;
+
+    if (!result.success) {
+      std::cerr << "Loading tiles with " << threads << " worker(s) failed" << std::endl;
+      return 1;
+    }
+
+    results.push_back(result);
+  }
+
+  if (results.front().tileCount!=results.back().tileCount ||
+      results.front().objectCount!=results.back().objectCount) {
+    std::cerr << "Different data loaded depending on number of workers" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,232 @@
+/*
+  NearestPOIPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/poi/POIService.h>
+
+#include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
+
+/**
+  Search the nearest POIs of the given types for random locations around the nodes of these
+  types. Checks, that POIService::GetNearestPOIs() returns the same distances as
+  loading all objects of the database, dropping the ones farther away than the maximum
+  distance and sorting them, and compares its time to a radius query with the maximum distance.
+
+  Arguments: <database directory> [count] [max distance in km] [query count] [type...]
+*/
+
+/**
+ * Load everything in the database, filter by the maximum distance and take the closest ones
+ */
+static std::vector<double> GetReferenceDistances(const osmscout::Database& database,
+                                                 const osmscout::GeoBox& box,
+                                                 const osmscout::GeoCoord& location,
+                                                 const osmscout::TypeInfoSet& types,
+                                                 size_t count,
+                                                 const osmscout::Distance& maxDistance)
+{
+  std::vector<double> distances;
+
+  for (const auto& entry : database.LoadNodesInArea(types,box,location).GetNodeResults()) {
+    distances.push_back(entry.GetDistance().AsMeter());
+  }
+
+  for (const auto& entry : database.LoadWaysInArea(types,box,location).GetWayResults()) {
+    distances.push_back(entry.GetDistance().AsMeter());
+  }
+
+  for (const auto& entry : database.LoadAreasInArea(types,box,location).GetAreaResults()) {
+    distances.push_back(entry.GetDistance().AsMeter());
+  }
+
+  distances.erase(std::remove_if(distances.begin(),distances.end(),[&maxDistance](double distance) {
+    return distance>maxDistance.AsMeter();
+  }),distances.end());
+
+  std::sort(distances.begin(),distances.end());
+
+  if (distances.size()>count) {
+    distances.resize(count);
+  }
+
+  return distances;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc<2) {
+    std::cerr << "NearestPOIPerformanceTest <database directory> [count] [max distance in km] [query count] [type...]" << std::endl;
+    return 1;
+  }
+
+  std::string              databaseDirectory=argv[1];
+  size_t                   count=5;
+  osmscout::Distance       maxDistance=osmscout::Distance::Of<osmscout::Kilometer>(20.0);
+  size_t                   queryCount=100;
+  std::vector<std::string> typeNames={"amenity_restaurant","highway_bus_stop","building_garage","amenity_parking"};
+
+  if (argc>2) {
+    count=std::stoul(argv[2]);
+  }
+
+  if (argc>3) {
+    maxDistance=osmscout::Distance::Of<osmscout::Kilometer>(std::stod(argv[3]));
+  }
+
+  if (argc>4) {
+    queryCount=std::stoul(argv[4]);
+  }
+
+  if (argc>5) {
+    typeNames.assign(argv+5,argv+argc);
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+
+  osmscout::DatabaseParameter databaseParameter;
+  osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
+
+  if (!database->Open(databaseDirectory)) {
+    std::cerr << "Cannot open database '" << databaseDirectory << "'" << std::endl;
+    return 1;
+  }
+
+  osmscout::TypeInfoSet types(*database->GetTypeConfig());
+
+  for (const auto& typeName : typeNames) {
+    osmscout::TypeInfoRef type=database->GetTypeConfig()->GetTypeInfo(typeName);
+
+    if (!type) {
+      std::cerr << "Unknown type '" << typeName << "'" << std::endl;
+      return 1;
+    }
+
+    types.Set(type);
+  }
+
+  osmscout::GeoBox boundingBox;
+
+  if (!database->GetBoundingBox(boundingBox)) {
+    std::cerr << "Cannot read bounding box" << std::endl;
+    return 1;
+  }
+
+  std::vector<osmscout::GeoCoord> nodeCoords;
+
+  for (const auto& entry : database->LoadNodesInArea(types,boundingBox).GetNodeResults()) {
+    nodeCoords.push_back(entry.GetNode()->GetCoords());
+  }
+
+  if (nodeCoords.empty()) {
+    std::cerr << "No nodes of the given types" << std::endl;
+    return 1;
+  }
+
+  std::mt19937                           generator(42);
+  std::uniform_int_distribution<size_t>  nodeDistribution(0,nodeCoords.size()-1);
+  std::uniform_real_distribution<double> offsetDistribution(-0.1,0.1);
+  std::vector<osmscout::GeoCoord>        locations;
+
+  for (size_t i=0; i<queryCount; i++) {
+    const osmscout::GeoCoord& coord=nodeCoords[nodeDistribution(generator)];
+
+    locations.emplace_back(coord.GetLat()+offsetDistribution(generator),
+                           coord.GetLon()+offsetDistribution(generator));
+  }
+
+  osmscout::POIService service(database);
+  double               nearestTime=0.0;
+  double               radiusTime=0.0;
+  size_t               radiusResults=0;
+  size_t               nearestResults=0;
+  size_t               mismatches=0;
+
+  for (const auto& location : locations) {
+    osmscout::StopClock nearestTimer;
+    auto                nearest=service.GetNearestPOIs(location,
+                                                       types,
+                                                       count,
+                                                       maxDistance);
+
+    nearestTimer.Stop();
+    nearestTime+=nearestTimer.GetMilliseconds();
+    nearestResults+=nearest.size();
+
+    std::vector<osmscout::NodeRef> nodes;
+    std::vector<osmscout::WayRef>  ways;
+    std::vector<osmscout::AreaRef> areas;
+    osmscout::StopClock            radiusTimer;
+
+    service.GetPOIsInRadius(location,
+                            maxDistance,
+                            types,
+                            nodes,
+                            types,
+                            ways,
+                            types,
+                            areas);
+
+    radiusTimer.Stop();
+    radiusTime+=radiusTimer.GetMilliseconds();
+    radiusResults+=nodes.size()+ways.size()+areas.size();
+
+    std::vector<double> expected=GetReferenceDistances(*database,
+                                                       boundingBox,
+                                                       location,
+                                                       types,
+                                                       count,
+                                                       maxDistance);
+    std::vector<double> actual;
+
+    for (const auto& entry : nearest) {
+      actual.push_back(entry.distance.AsMeter());
+    }
+
+    if (actual!=expected) {
+      std::cerr << "Mismatch at " << location.GetDisplayText() << ": "
+                << actual.size() << " nearest POIs, "
+                << expected.size() << " expected" << std::endl;
+      mismatches++;
+    }
+  }
+
+  std::cout << locations.size() << " queries for " << count << " POIs within " << maxDistance.AsString() << std::endl;
+  std::cout << "Nearest: " << nearestTime/double(locations.size()) << " ms/query, " << nearestResults << " results" << std::endl;
+  std::cout << "Radius:  " << radiusTime/double(locations.size()) << " ms/query, " << radiusResults << " results" << std::endl;
+
+  if (mismatches>0) {
+    std::cerr << mismatches << " mismatches" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -99,6 +99,11 @@ struct Arguments {
   size_t loadRepeat{1};
   bool flushCache{false};
   bool flushDiskCache{false};
+  bool styleCache{true};
+  bool labelCache{true};
+  bool contourLines{false};
+  bool hillShading{false};
+  std::string srtmDirectory;
 
 #if defined(PERF_TEST_GPERFTOOLS_USAGE)
   bool heapProfile{false};
@@ -238,6 +243,11 @@ public:
                        const osmscout::MapParameter &drawParameter,
                        const osmscout::MapData &data,
                        osmscout::RenderSteps step) = 0;
+
+  virtual void DumpStatistics() const
+  {
+    // no code
+  }
 };
 
 #if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
@@ -248,7 +258,7 @@ private:
   std::shared_ptr<osmscout::MapPainterCairo> cairoMapPainter;
 
 public:
-  PerformanceTestBackendCairo(size_t tileWidth, size_t tileHeight)
+  PerformanceTestBackendCairo(size_t tileWidth, size_t tileHeight, bool labelCache)
   {
     cairoSurface=cairo_image_surface_create(CAIRO_FORMAT_RGB24,
                                             int(tileWidth),
@@ -263,6 +273,10 @@ public:
       throw std::runtime_error("Cannot create cairo_t for image cairoSurface");
     }
     cairoMapPainter = std::make_shared<osmscout::MapPainterCairo>();
+
+    if (!labelCache) {
+      cairoMapPainter->SetLabelCache(nullptr);
+    }
   }
 
   ~PerformanceTestBackendCairo() override
@@ -285,6 +299,25 @@ public:
                             step,
                             step);
   }
+
+  void DumpStatistics() const override
+  {
+    auto labelCache=cairoMapPainter->GetLabelCache();
+
+    if (!labelCache) {
+      return;
+    }
+
+    osmscout::MapPainterCairo::CairoLabelCache::Statistics cacheStatistics=labelCache->GetStatistics();
+
+    std::cout << "Label cache: ";
+    std::cout << "entries: " << cacheStatistics.entries << " ";
+    std::cout << "memory: " << formatAlloc(double(cacheStatistics.memory)) << " ";
+    std::cout << "hits: " << cacheStatistics.hits << " ";
+    std::cout << "misses: " << cacheStatistics.misses << " ";
+    std::cout << "evictions: " << cacheStatistics.evictions << " ";
+    std::cout << "hit rate: " << std::fixed << std::setprecision(1) << cacheStatistics.GetHitRate()*100.0 << "%" << std::endl;
+  }
 };
 #endif
 
@@ -544,7 +577,7 @@ PerformanceTestBackendRef PrepareBackend([[maybe_unused]] int argc,
     std::cout << "Using driver 'cairo'..." << std::endl;
 #if defined(HAVE_LIB_OSMSCOUTMAPCAIRO)
     try{
-      return std::make_shared<PerformanceTestBackendCairo>(args.TileWidth(),args.TileHeight());
+      return std::make_shared<PerformanceTestBackendCairo>(args.TileWidth(),args.TileHeight(),args.labelCache);
     } catch (const std::runtime_error &e){
       std::cerr << e.what() << std::endl;
       return nullptr;
@@ -697,6 +730,36 @@ int main(int argc, char* argv[])
                       "Flush system disk caches after each data load, default: " + std::to_string(args.flushDiskCache) +
                       " (It work just on Linux with admin rights.)",
                       false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.styleCache=!value;
+                      }),
+                      "no-style-cache",
+                      "Disable caching of composed styles, default: " + std::to_string(!args.styleCache),
+                      false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.labelCache=!value;
+                      }),
+                      "no-label-cache",
+                      "Disable caching of laid out labels between draw calls (cairo), default: " + std::to_string(!args.labelCache),
+                      false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.contourLines=value;
+                      }),
+                      "contour-lines",
+                      "Render contour lines, default: " + std::to_string(args.contourLines),
+                      false);
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.hillShading=value;
+                      }),
+                      "hill-shading",
+                      "Render hill shading, default: " + std::to_string(args.hillShading),
+                      false);
+  argParser.AddOption(osmscout::CmdLineStringOption([&args](const std::string& value) {
+                        args.srtmDirectory=value;
+                      }),
+                      "srtm",
+                      "SRTM data directory, used for contour lines and hill shading if the database has no terrain data",
+                      false);
 
   argParser.AddOption(osmscout::CmdLineUIntOption([&databaseParameter](const unsigned int& value) {
                         databaseParameter.SetNodeDataCacheSize(value);
@@ -775,6 +838,10 @@ int main(int argc, char* argv[])
   osmscout::log.Debug(args.debug);
   //databaseParameter.SetDebugPerformance(true);
 
+  if (!args.srtmDirectory.empty()) {
+    databaseParameter.SetSRTMDirectory(args.srtmDirectory);
+  }
+
   osmscout::DatabaseRef       database=std::make_shared<osmscout::Database>(databaseParameter);
   osmscout::MapServiceRef     mapService=std::make_shared<osmscout::MapService>(database);
 
@@ -790,6 +857,8 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  styleConfig->SetStyleCacheEnabled(args.styleCache);
+
   osmscout::TileProjection      projection;
   osmscout::MapParameter        drawParameter;
   osmscout::AreaSearchParameter searchParameter;
@@ -800,6 +869,9 @@ int main(int argc, char* argv[])
   drawParameter.SetPatternPaths(args.icons); // for simplicity use same directories for lookup
   drawParameter.SetIconMode(osmscout::MapParameter::IconMode::Scalable);
   drawParameter.SetPatternMode(osmscout::MapParameter::PatternMode::Scalable);
+  drawParameter.SetRenderContourLines(args.contourLines);
+  drawParameter.SetRenderHillShading(args.hillShading);
+  drawParameter.SetDebugPerformance(args.debug);
 
   PerformanceTestBackendRef backend = PrepareBackend(argc, argv, args, styleConfig, drawParameter);
   if (!backend) {
@@ -881,6 +953,14 @@ int main(int argc, char* argv[])
         mapService->LoadMissingTileData(searchParameter, *styleConfig, tiles);
         mapService->AddTileDataToMapData(tiles, data);
 
+        if (args.contourLines || args.hillShading) {
+          mapService->GetTerrainTiles(projection, data.terrainTiles);
+
+          if (data.terrainTiles.empty()) {
+            data.srtmTile=mapService->GetSRTMData(projection);
+          }
+        }
+
 #if defined(PERF_TEST_GPERFTOOLS_USAGE)
         if (args.heapProfile) {
           std::ostringstream buff;
@@ -1016,6 +1096,16 @@ int main(int argc, char* argv[])
     }
   }
 
+  osmscout::StyleCache::Statistics cacheStatistics=styleConfig->GetStyleCacheStatistics();
+
+  std::cout << "Style cache: ";
+  std::cout << "entries: " << cacheStatistics.entries << " ";
+  std::cout << "hits: " << cacheStatistics.hits << " ";
+  std::cout << "misses: " << cacheStatistics.misses << " ";
+  std::cout << "hit rate: " << std::fixed << std::setprecision(1) << cacheStatistics.GetHitRate()*100.0 << "%" << std::endl;
+
+  backend->DumpStatistics();
+
   database->Close();
 
   return 0;
@@ -23,6 +23,8 @@
  */
 #include <osmscout/util/PolygonCenter.h>
 #include <osmscout/log/Logger.h>
+#include <osmscout/feature/NameFeature.h>
+#include <osmscout/TypeConfig.h>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -1197,3 +1199,65 @@ TEST_CASE("compute polygon center of degenerated areas")
   REQUIRE(PolygonCenter(degenerated1) == osmscout::GeoCoord(0, 0));
   REQUIRE(PolygonCenter(degenerated2) == osmscout::GeoCoord(0, 0));
 }
+
+static osmscout::Area::Ring testRing(uint8_t ringId,
+                                     const osmscout::TypeInfoRef& type,
+                                     const std::vector<int>& data)
+{
+  osmscout::Area::Ring ring;
+  ring.SetRing(ringId);
+  ring.SetType(type);
+  for (size_t i=0; i<data.size(); i+=2){
+    ring.nodes.push_back(osmscout::Point(0, osmscout::GeoCoord(data[i], data[i+1])));
+  }
+
+  return ring;
+}
+
+TEST_CASE("label anchor of multipolygon outer ring with inner ring")
+{
+  osmscout::TypeConfig typeConfig;
+  osmscout::TypeInfoRef lakeType=std::make_shared<osmscout::TypeInfo>("lake");
+  osmscout::TypeInfoRef ignoreType=std::make_shared<osmscout::TypeInfo>("");
+  osmscout::FeatureRef nameFeature=typeConfig.GetFeature(osmscout::NameFeature::NAME);
+  size_t featureInstanceIndex;
+
+  ignoreType->SetIgnore(true);
+  lakeType->AddFeature(nameFeature);
+  typeConfig.RegisterType(lakeType);
+
+  REQUIRE(lakeType->GetFeature(osmscout::NameFeature::NAME,
+                               featureInstanceIndex));
+
+  // Master ring without nodes carries type and name, the outer and inner rings have no own type
+  osmscout::Area area;
+  osmscout::Area::Ring master;
+
+  master.SetRing(osmscout::Area::masterRingId);
+  master.SetType(lakeType);
+
+  osmscout::FeatureValueBuffer buffer;
+
+  buffer.SetType(lakeType);
+  static_cast<osmscout::NameFeatureValue*>(buffer.AllocateValue(featureInstanceIndex))->SetName("Lake");
+  master.SetFeatures(buffer);
+
+  REQUIRE(master.GetFeatureValueBuffer().HasFeature(featureInstanceIndex));
+
+  area.rings.push_back(master);
+  area.rings.push_back(testRing(osmscout::Area::outerRingId,ignoreType,{0,0,20,0,20,20,0,20}));
+  area.rings.push_back(testRing(osmscout::Area::outerRingId+1,ignoreType,{6,6,14,6,14,14,6,14}));
+
+  REQUIRE(area.GetRingType(area.rings[1])==lakeType);
+
+  // The bounding box center is inside the inner ring, so an anchor is required
+  std::optional<osmscout::GeoCoord> anchor=RingLabelAnchor(area, 1);
+
+  REQUIRE(anchor.has_value());
+  REQUIRE(osmscout::IsCoordInArea(anchor.value(), area.rings[1].nodes));
+  REQUIRE_FALSE(osmscout::IsCoordInArea(anchor.value(), area.rings[2].nodes));
+
+  // Master ring has no nodes and the inner ring is a clipping ring
+  REQUIRE_FALSE(RingLabelAnchor(area, 0).has_value());
+  REQUIRE_FALSE(RingLabelAnchor(area, 2).has_value());
+}
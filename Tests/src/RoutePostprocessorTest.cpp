@@ -18,6 +18,7 @@
 */
 
 #include <cstdio>
+#include <iostream>
 #include <string>
 #include <filesystem>
 
@@ -1346,3 +1347,162 @@ TEST_CASE("Describe A3/A4 highway near Zurich")
   }
 
 }
+
+constexpr size_t longRouteWayCount=5000;
+
+/**
+ * Long chain of straight, equally named street segments heading to the east
+ */
+MockDatabaseRef BuildLongRouteDatabase(std::vector<ObjectFileRef> &wayRefs)
+{
+  MockDatabaseBuilder databaseBuilder;
+  wayRefs.reserve(longRouteWayCount);
+  for (size_t i=0; i<longRouteWayCount; i++) {
+    wayRefs.push_back(databaseBuilder.AddHighway(
+      {GeoCoord(50.0, 14.0+double(i)*0.001), GeoCoord(50.0, 14.0+double(i+1)*0.001)},
+      [](AccessFeatureValue* access, LanesFeatureValue* lanes, NameFeatureValue* name){
+        lanes->SetLanes(1, 1);
+        access->SetAccess(AccessFeatureValue::carForward | AccessFeatureValue::carBackward);
+        name->SetName("Long street");
+      }));
+  }
+
+  return databaseBuilder.Build();
+}
+
+void AddLongRouteNodes(RouteDescription &description, const std::vector<ObjectFileRef> &wayRefs)
+{
+  description.Nodes().reserve(wayRefs.size()+1);
+  description.AddNode(0, 0, {wayRefs.front()}, wayRefs.front(), 1);
+  for (size_t i=1; i<wayRefs.size(); i++) {
+    description.AddNode(0, 0, {wayRefs[i-1], wayRefs[i]}, wayRefs[i], 1);
+  }
+  description.AddNode(0, 1, {wayRefs.back()}, ObjectFileRef(), 0);
+}
+
+TEST_CASE("Postprocess long route")
+{
+  using namespace osmscout;
+
+  std::vector<ObjectFileRef> wayRefs;
+  MockContext context(BuildLongRouteDatabase(wayRefs));
+
+  RouteDescription description;
+  AddLongRouteNodes(description, wayRefs);
+
+  Postprocess(description, context);
+
+  REQUIRE(description.Nodes().size()==longRouteWayCount+1);
+  for (const auto& node : description.Nodes()) {
+    REQUIRE_FALSE(node.HasDescription<RouteDescription::TurnDescription>());
+    REQUIRE_FALSE(node.HasDescription<RouteDescription::NameChangedDescription>());
+  }
+
+  auto nameDesc=description.Nodes().front().GetDescription<RouteDescription::NameDescription>();
+  REQUIRE(nameDesc);
+  REQUIRE(nameDesc->GetName()=="Long street");
+  REQUIRE(description.Nodes().back().GetDistance()>Kilometers(300));
+}
+
+TEST_CASE("Fused node postprocessors produce the same result")
+{
+  using namespace osmscout;
+
+  std::vector<ObjectFileRef> wayRefs;
+  MockContext context(BuildLongRouteDatabase(wayRefs));
+
+  RouteDescription sequential;
+  AddLongRouteNodes(sequential, wayRefs);
+
+  RoutePostprocessor::DistanceAndTimePostprocessor().Process(context, sequential);
+  RoutePostprocessor::WayNamePostprocessor().Process(context, sequential);
+  RoutePostprocessor::WayTypePostprocessor().Process(context, sequential);
+  RoutePostprocessor::LanesPostprocessor().Process(context, sequential);
+
+  RouteDescription fused;
+  AddLongRouteNodes(fused, wayRefs);
+
+  RoutePostprocessor::FusedPostprocessor fusedPostprocessor({std::make_shared<RoutePostprocessor::DistanceAndTimePostprocessor>(),
+                                                              std::make_shared<RoutePostprocessor::WayNamePostprocessor>(),
+                                                              std::make_shared<RoutePostprocessor::WayTypePostprocessor>(),
+                                                              std::make_shared<RoutePostprocessor::LanesPostprocessor>()});
+
+  SECTION("Untimed")
+  {
+    REQUIRE(fusedPostprocessor.Process(context, fused));
+  }
+
+  SECTION("Timed")
+  {
+    std::vector<std::chrono::steady_clock::duration> processorTimes;
+
+    REQUIRE(fusedPostprocessor.ProcessTimed(context, fused, processorTimes));
+    REQUIRE(processorTimes.size()==4);
+  }
+
+  REQUIRE(sequential.Nodes().size()==fused.Nodes().size());
+  for (size_t i=0; i<sequential.Nodes().size(); i++) {
+    const auto& expected=sequential.Nodes()[i];
+    const auto& actual=fused.Nodes()[i];
+
+    REQUIRE(expected.GetDistance()==actual.GetDistance());
+    REQUIRE(expected.GetLocation()==actual.GetLocation());
+    REQUIRE(expected.GetDescriptions().size()==actual.GetDescriptions().size());
+    for (size_t d=0; d<expected.GetDescriptions().size(); d++) {
+      REQUIRE(expected.GetDescriptions()[d]->GetDebugString()==actual.GetDescriptions()[d]->GetDebugString());
+    }
+  }
+}
+
+TEST_CASE("Latest node description of the same kind wins")
+{
+  using namespace osmscout;
+
+  RouteDescription description;
+  description.AddNode(0, 0, {}, ObjectFileRef(), 0);
+
+  auto& node=description.Nodes().front();
+  REQUIRE_FALSE(node.HasDescription<RouteDescription::NameDescription>());
+  REQUIRE_FALSE(node.GetDescription<RouteDescription::NameDescription>());
+
+  node.AddDescription(std::make_shared<RouteDescription::NameDescription>("first"));
+  node.AddDescription(std::make_shared<RouteDescription::TypeNameDescription>("highway"));
+  node.AddDescription(std::make_shared<RouteDescription::NameDescription>("second"));
+
+  REQUIRE(node.GetDescriptions().size()==3);
+  REQUIRE(node.HasDescription<RouteDescription::NameDescription>());
+  REQUIRE(node.GetDescription<RouteDescription::NameDescription>()->GetName()=="second");
+  REQUIRE(node.GetDescription<RouteDescription::TypeNameDescription>()->GetName()=="highway");
+  REQUIRE_FALSE(node.HasDescription<RouteDescription::TurnDescription>());
+
+  // null descriptions are stored, but not reported as present
+  node.AddDescription(RouteDescription::NameDescriptionRef());
+  REQUIRE_FALSE(node.HasDescription<RouteDescription::NameDescription>());
+}
+
+TEST_CASE("Nodes and descriptions are returned in order without copying")
+{
+  using namespace osmscout;
+
+  RouteDescription description;
+  description.AddNode(0, 0, {}, ObjectFileRef(), 1);
+  description.AddNode(0, 1, {}, ObjectFileRef(), 2);
+
+  auto firstName=std::make_shared<RouteDescription::NameDescription>("first");
+  auto typeName=std::make_shared<RouteDescription::TypeNameDescription>("highway");
+
+  description.Nodes().front().AddDescription(firstName);
+  description.Nodes().front().AddDescription(typeName);
+
+  const RouteDescription& constDescription=description;
+  const RouteDescription::NodeList& nodes=constDescription.Nodes();
+  REQUIRE(&nodes==&description.Nodes());
+  REQUIRE(nodes.size()==2);
+  REQUIRE(nodes.front().GetCurrentNodeIndex()==0);
+  REQUIRE(nodes.back().GetCurrentNodeIndex()==1);
+
+  const auto& descriptions=nodes.front().GetDescriptions();
+  REQUIRE(descriptions.size()==2);
+  REQUIRE(descriptions.front()==firstName);
+  REQUIRE(descriptions.back()==typeName);
+}
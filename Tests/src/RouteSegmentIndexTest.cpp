@@ -0,0 +1,114 @@
+/*
+  RouteSegmentIndexTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <osmscout/routing/RouteSegmentIndex.h>
+
+#include <osmscout/navigation/Navigation.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace osmscout;
+
+static void AddRouteNode(RouteDescription& description,
+                         const GeoCoord& coord)
+{
+  description.AddNode(0,
+                      description.Nodes().size(),
+                      {},
+                      ObjectFileRef(),
+                      description.Nodes().size()+1);
+  description.Nodes().back().SetLocation(coord);
+}
+
+TEST_CASE("Find closest segment of a straight route")
+{
+  RouteDescription description;
+
+  for (size_t i=0; i<1000; i++) {
+    AddRouteNode(description,GeoCoord(50.0,14.0+double(i)*0.001));
+  }
+
+  RouteSegmentIndex index(description);
+
+  REQUIRE(index.GetSegmentCount()==999);
+
+  RouteSegmentIndex::SegmentMatch match;
+
+  REQUIRE(index.SearchClosestSegment(GeoCoord(50.0001,14.5005),0,0.001,match));
+  REQUIRE(match.segment==500);
+  REQUIRE(match.abscissa>0.49);
+  REQUIRE(match.abscissa<0.51);
+
+  // location is behind the search start
+  REQUIRE_FALSE(index.SearchClosestSegment(GeoCoord(50.0001,14.5005),600,0.001,match));
+
+  // location is too far from the route
+  REQUIRE_FALSE(index.SearchClosestSegment(GeoCoord(50.1,14.5005),0,0.001,match));
+}
+
+TEST_CASE("Prefer the first pass of a route visiting the same place twice")
+{
+  RouteDescription description;
+
+  // there...
+  for (size_t i=0; i<100; i++) {
+    AddRouteNode(description,GeoCoord(50.0,14.0+double(i)*0.001));
+  }
+  // ...and back again, slightly shifted
+  for (size_t i=0; i<100; i++) {
+    AddRouteNode(description,GeoCoord(50.00005,14.099-double(i)*0.001));
+  }
+
+  RouteSegmentIndex index(description);
+
+  RouteSegmentIndex::SegmentMatch match;
+
+  REQUIRE(index.SearchClosestSegment(GeoCoord(50.00004,14.0505),0,0.001,match));
+  REQUIRE(match.segment==50);
+
+  REQUIRE(index.SearchClosestSegment(GeoCoord(50.00004,14.0505),100,0.001,match));
+  REQUIRE(match.segment>100);
+}
+
+TEST_CASE("Navigation snaps to the route using the segment index")
+{
+  RouteDescription description;
+
+  for (size_t i=0; i<1000; i++) {
+    AddRouteNode(description,GeoCoord(50.0,14.0+double(i)*0.001));
+  }
+
+  OutputDescription<int> output;
+  Navigation<int>        navigation(&output);
+
+  navigation.SetSnapDistance(Meters(25));
+  navigation.SetRoute(&description);
+
+  double minDistance=0.0;
+
+  REQUIRE(navigation.UpdateCurrentLocation(GeoCoord(50.0001,14.5005),minDistance));
+  REQUIRE(navigation.GetCurrentNode().GetCurrentNodeIndex()==500);
+  REQUIRE(minDistance<0.0002);
+
+  // minDistance is reported, even if the location is not on route
+  REQUIRE_FALSE(navigation.UpdateCurrentLocation(GeoCoord(50.1,14.5005),minDistance));
+  REQUIRE(minDistance>0.0999);
+  REQUIRE(minDistance<0.1001);
+  REQUIRE(navigation.GetCurrentNode().GetCurrentNodeIndex()==500);
+}
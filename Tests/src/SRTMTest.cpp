@@ -0,0 +1,143 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <vector>
+
+#include <osmscout/elevation/SRTM.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static const size_t grid=1201; // SRTM3
+
+static void WriteHGT(const std::filesystem::path& filename,
+                     const std::function<int16_t(size_t,size_t)>& height)
+{
+  std::ofstream file(filename,std::ios::binary);
+
+  for (size_t row=0; row<grid; row++) {
+    for (size_t column=0; column<grid; column++) {
+      auto value=uint16_t(height(column,row));
+
+      file.put(char(value >> 8));
+      file.put(char(value & 0xff));
+    }
+  }
+}
+
+static std::filesystem::path CreateTestData()
+{
+  std::filesystem::path directory=std::filesystem::temp_directory_path() / "srtm_test";
+
+  std::filesystem::create_directories(directory);
+
+  // Linear in row and column, so bilinear interpolation is exact
+  WriteHGT(directory / "N10E020.hgt",[](size_t column, size_t row) {
+    if (column==1 && row==1) {
+      return int16_t(osmscout::SRTM::nodata);
+    }
+
+    return int16_t(column+2*row);
+  });
+
+  WriteHGT(directory / "N10E021.hgt",[](size_t /*column*/, size_t /*row*/) {
+    return int16_t(100);
+  });
+
+  return directory;
+}
+
+static osmscout::GeoCoord Sample(double row, double column)
+{
+  return {11.0-row/double(grid-1),
+          20.0+column/double(grid-1)};
+}
+
+TEST_CASE("Heights at samples and between samples")
+{
+  osmscout::SRTM srtm(CreateTestData().string());
+
+  REQUIRE(srtm.GetHeightAtLocation(Sample(2,0))==4);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(1200,10))==2410);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(10,0))==20);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(1200,1199))==3599);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(100.4,200.4))==401); // 200.4+2*100.4=401.2
+  REQUIRE(srtm.GetHeightAtLocation(Sample(100.1,200.1))==400); // 200.1+2*100.1=400.3
+}
+
+TEST_CASE("Fallback to nearest sample next to missing data")
+{
+  osmscout::SRTM srtm(CreateTestData().string());
+
+  REQUIRE(srtm.GetHeightAtLocation(Sample(0.2,0.2))==0);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(1.0,1.0))==osmscout::SRTM::nodata);
+  REQUIRE(srtm.GetHeightAtLocation(Sample(1.8,1.8))==6); // sample (2,2)
+}
+
+TEST_CASE("Missing tiles")
+{
+  osmscout::SRTM srtm(CreateTestData().string());
+
+  REQUIRE(srtm.GetHeightAtLocation(osmscout::GeoCoord(-10.5,20.5))==osmscout::SRTM::nodata);
+  REQUIRE(srtm.GetHeightInBoundingBox(osmscout::GeoBox(osmscout::GeoCoord(-10.5,20.5),
+                                                       osmscout::GeoCoord(-10.4,20.6)))==nullptr);
+}
+
+TEST_CASE("Batched heights match single lookups")
+{
+  std::string                     directory=CreateTestData().string();
+  osmscout::SRTM                  srtm(directory,1);
+  std::vector<osmscout::GeoCoord> coords;
+
+  // Alternate between both tiles and a missing one, to force eviction from the cache
+  for (size_t i=0; i<100; i++) {
+    coords.emplace_back(10.0+double(i)/100.0,20.0+double(i)/50.0);
+    coords.emplace_back(10.5,21.5);
+    coords.emplace_back(9.5,21.5);
+  }
+
+  std::vector<int32_t> heights=srtm.GetHeights(coords);
+
+  REQUIRE(heights.size()==coords.size());
+
+  osmscout::SRTM reference(directory);
+
+  for (size_t i=0; i<coords.size(); i++) {
+    REQUIRE(heights[i]==reference.GetHeightAtLocation(coords[i]));
+  }
+
+  REQUIRE(heights[1]==100);
+  REQUIRE(heights[2]==osmscout::SRTM::nodata);
+}
+
+TEST_CASE("Height map of a tile")
+{
+  osmscout::SRTM srtm(CreateTestData().string());
+
+  osmscout::SRTMDataRef data=srtm.GetHeightInBoundingBox(osmscout::GeoBox(osmscout::GeoCoord(10.2,20.2),
+                                                                          osmscout::GeoCoord(10.3,20.3)));
+
+  REQUIRE(data);
+  REQUIRE(data->rows==grid);
+  REQUIRE(data->columns==grid);
+  REQUIRE(data->GetHeight(3,4)==11);
+  REQUIRE(data->GetHeight(1,1)==osmscout::SRTM::nodata);
+}
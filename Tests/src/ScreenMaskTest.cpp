@@ -302,3 +302,89 @@ TEST_CASE("Real world test 2")
 
   REQUIRE(screenMask.HasCollision(screenRectMask6)); // => mask1,mask2, mask4
 }
+
+TEST_CASE("ScreenRectMask ending on CellBorder")
+{
+  size_t screenWidth=200;
+
+  ScreenRectMask screenRectMask1(screenWidth,ScreenPixelRectangle(60,10,5,10));
+
+  REQUIRE(screenRectMask1.GetFirstCell()==0);
+  REQUIRE(screenRectMask1.GetLastCell()==1);
+
+  // 60x 0 bit + 4x 1 bit
+  REQUIRE(screenRectMask1.GetCell(0)==0xf000000000000000);
+  // 1x 1 bit
+  REQUIRE(screenRectMask1.GetCell(1)==0x1);
+}
+
+TEST_CASE("ScreenRectMask outside of screen")
+{
+  size_t screenWidth=200;
+
+  REQUIRE(ScreenRectMask(screenWidth,ScreenPixelRectangle(200,10,10,10)).IsEmpty());
+  REQUIRE(ScreenRectMask(screenWidth,ScreenPixelRectangle(-10,10,10,10)).IsEmpty());
+  REQUIRE(ScreenRectMask(screenWidth,ScreenPixelRectangle(10,10,0,0)).IsEmpty());
+
+  ScreenMask     screenMask(screenWidth,100);
+  ScreenRectMask screenRectMask1(screenWidth,ScreenPixelRectangle(-10,-10,220,120));
+  ScreenRectMask screenRectMask2(screenWidth,ScreenPixelRectangle(210,10,10,10));
+
+  screenMask.AddMask(screenRectMask1);
+
+  REQUIRE_FALSE(screenMask.HasCollision(screenRectMask2));
+}
+
+TEST_CASE("ScreenRectMask reuse")
+{
+  size_t screenWidth=1000;
+
+  ScreenRectMask screenRectMask1(screenWidth,ScreenPixelRectangle(10,10,800,10));
+
+  screenRectMask1.Set(screenWidth,ScreenPixelRectangle(130,20,10,5));
+
+  REQUIRE(screenRectMask1.GetFirstRow()==20);
+  REQUIRE(screenRectMask1.GetLastRow()==24);
+  REQUIRE(screenRectMask1.GetFirstCell()==2);
+  REQUIRE(screenRectMask1.GetLastCell()==2);
+  REQUIRE(screenRectMask1.GetCell(2)==0xffc);
+}
+
+TEST_CASE("ScreenRectMask intersection")
+{
+  size_t screenWidth=1000;
+
+  ScreenRectMask screenRectMask1(screenWidth,ScreenPixelRectangle(10,10,500,10));
+  ScreenRectMask screenRectMask2(screenWidth,ScreenPixelRectangle(509,19,100,10));
+  ScreenRectMask screenRectMask3(screenWidth,ScreenPixelRectangle(510,10,100,10));
+  ScreenRectMask screenRectMask4(screenWidth,ScreenPixelRectangle(10,20,500,10));
+
+  REQUIRE(screenRectMask1.Intersects(screenRectMask2));
+  REQUIRE(screenRectMask2.Intersects(screenRectMask1));
+  REQUIRE_FALSE(screenRectMask1.Intersects(screenRectMask3));
+  REQUIRE_FALSE(screenRectMask1.Intersects(screenRectMask4));
+}
+
+TEST_CASE("Wide masks")
+{
+  size_t screenWidth=3840;
+  size_t screenHeight=2160;
+
+  ScreenMask screenMask(screenWidth,screenHeight);
+
+  // spans 16 cells
+  ScreenRectMask screenRectMask1(screenWidth,ScreenPixelRectangle(100,100,1000,30));
+
+  screenMask.AddMask(screenRectMask1);
+
+  // Touching on the right side of the last cell
+  REQUIRE(screenMask.HasCollision(ScreenRectMask(screenWidth,ScreenPixelRectangle(1099,129,600,30))));
+  // Inside one of the middle cells
+  REQUIRE(screenMask.HasCollision(ScreenRectMask(screenWidth,ScreenPixelRectangle(500,110,1,1))));
+  // Directly right of the mask
+  REQUIRE_FALSE(screenMask.HasCollision(ScreenRectMask(screenWidth,ScreenPixelRectangle(1100,100,600,30))));
+  // Directly beneath the mask
+  REQUIRE_FALSE(screenMask.HasCollision(ScreenRectMask(screenWidth,ScreenPixelRectangle(0,130,3840,30))));
+  // Directly left of the mask
+  REQUIRE_FALSE(screenMask.HasCollision(ScreenRectMask(screenWidth,ScreenPixelRectangle(0,0,100,2160))));
+}
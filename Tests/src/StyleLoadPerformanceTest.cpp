@@ -0,0 +1,307 @@
+/*
+  StyleLoadPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/projection/MercatorProjection.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscoutmap/StyleConfig.h>
+
+/**
+  Compare the time to load a style sheet by parsing it with the time to load it
+  from the binary style sheet cache and check, that both result in the same
+  resolved style sheet.
+
+  Arguments: <ost file> <oss file> [repeat count]
+*/
+
+static void DumpTime(const std::string& name,
+                     double milliseconds,
+                     size_t repeat)
+{
+  std::cout << name << ": " << milliseconds/double(repeat) << " ms" << std::endl;
+}
+
+template<class S>
+static bool IsSameStyle(const std::shared_ptr<S>& a,
+                        const std::shared_ptr<S>& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  return *a==*b;
+}
+
+/**
+ * Label providers are created per style config, so compare them by name
+ */
+template<>
+bool IsSameStyle(const osmscout::TextStyleRef& a,
+                 const osmscout::TextStyleRef& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  if ((a->GetLabel() ? a->GetLabel()->GetName() : "")!=(b->GetLabel() ? b->GetLabel()->GetName() : "")) {
+    return false;
+  }
+
+  return a->GetSlot()==b->GetSlot() &&
+         a->GetPriority()==b->GetPriority() &&
+         a->GetSize()==b->GetSize() &&
+         a->GetPosition()==b->GetPosition() &&
+         a->GetTextColor()==b->GetTextColor() &&
+         a->GetStyle()==b->GetStyle() &&
+         a->GetScaleAndFadeMag()==b->GetScaleAndFadeMag() &&
+         a->GetAutoSize()==b->GetAutoSize();
+}
+
+template<class S>
+static bool IsSameStyles(const std::vector<std::shared_ptr<S>>& a,
+                         const std::vector<std::shared_ptr<S>>& b)
+{
+  return std::equal(a.begin(),a.end(),
+                    b.begin(),b.end(),
+                    IsSameStyle<S>);
+}
+
+static bool IsSameIconStyle(const osmscout::IconStyleRef& a,
+                            const osmscout::IconStyleRef& b)
+{
+  if (!a || !b) {
+    return !a && !b;
+  }
+
+  return a->GetIconName()==b->GetIconName() &&
+         a->GetPosition()==b->GetPosition() &&
+         a->GetPriority()==b->GetPriority() &&
+         (a->GetSymbol() ? a->GetSymbol()->GetName() : "")==(b->GetSymbol() ? b->GetSymbol()->GetName() : "");
+}
+
+/**
+ * Compare the resolved styles of both style configs for all types in all
+ * magnification levels via the public style lookup methods.
+ */
+static bool IsSameResolvedStyle(const osmscout::TypeConfig& typeConfig,
+                                const osmscout::StyleConfig& parsed,
+                                const osmscout::StyleConfig& cached)
+{
+  if (parsed.GetFlags()!=cached.GetFlags() ||
+      parsed.GetSymbolNames()!=cached.GetSymbolNames()) {
+    std::cerr << "Flags or symbols differ" << std::endl;
+    return false;
+  }
+
+  osmscout::MercatorProjection projection;
+
+  for (uint32_t level=0; level<=20; level++) {
+    osmscout::Magnification magnification{osmscout::MagnificationLevel(level)};
+
+    projection.Set(osmscout::GeoCoord(0.0,0.0),magnification,256,256);
+
+    if (!IsSameStyle(parsed.GetLandFillStyle(projection),cached.GetLandFillStyle(projection)) ||
+        !IsSameStyle(parsed.GetSeaFillStyle(projection),cached.GetSeaFillStyle(projection)) ||
+        !IsSameStyle(parsed.GetCoastFillStyle(projection),cached.GetCoastFillStyle(projection)) ||
+        !IsSameStyle(parsed.GetUnknownFillStyle(projection),cached.GetUnknownFillStyle(projection)) ||
+        !IsSameStyle(parsed.GetCoastlineLineStyle(projection),cached.GetCoastlineLineStyle(projection))) {
+      std::cerr << "Global styles differ in level " << level << std::endl;
+      return false;
+    }
+
+    for (const auto& type : typeConfig.GetTypes()) {
+      osmscout::FeatureValueBuffer buffer;
+
+      buffer.SetType(type);
+
+      std::vector<osmscout::TextStyleRef>   parsedTextStyles;
+      std::vector<osmscout::TextStyleRef>   cachedTextStyles;
+      std::vector<osmscout::LineStyleRef>   parsedLineStyles;
+      std::vector<osmscout::LineStyleRef>   cachedLineStyles;
+      std::vector<osmscout::BorderStyleRef> parsedBorderStyles;
+      std::vector<osmscout::BorderStyleRef> cachedBorderStyles;
+
+      if (type->CanBeNode()) {
+        parsed.GetNodeTextStyles(buffer,projection,parsedTextStyles);
+        cached.GetNodeTextStyles(buffer,projection,cachedTextStyles);
+
+        if (!IsSameStyles(parsedTextStyles,cachedTextStyles) ||
+            !IsSameIconStyle(parsed.GetNodeIconStyle(buffer,projection),
+                             cached.GetNodeIconStyle(buffer,projection))) {
+          std::cerr << "Node styles of type '" << type->GetName() << "' differ in level " << level << std::endl;
+          return false;
+        }
+      }
+
+      if (type->CanBeWay()) {
+        parsed.GetWayLineStyles(buffer,projection,parsedLineStyles);
+        cached.GetWayLineStyles(buffer,projection,cachedLineStyles);
+
+        if (parsed.GetWayPrio(type)!=cached.GetWayPrio(type) ||
+            !IsSameStyles(parsedLineStyles,cachedLineStyles)) {
+          std::cerr << "Way styles of type '" << type->GetName() << "' differ in level " << level << std::endl;
+          return false;
+        }
+      }
+
+      if (type->CanBeArea()) {
+        parsedTextStyles.clear();
+        cachedTextStyles.clear();
+
+        parsed.GetAreaTextStyles(type,buffer,projection,parsedTextStyles);
+        cached.GetAreaTextStyles(type,buffer,projection,cachedTextStyles);
+        parsed.GetAreaBorderStyles(type,buffer,projection,parsedBorderStyles);
+        cached.GetAreaBorderStyles(type,buffer,projection,cachedBorderStyles);
+
+        if (!IsSameStyle(parsed.GetAreaFillStyle(type,buffer,projection),
+                         cached.GetAreaFillStyle(type,buffer,projection)) ||
+            !IsSameStyles(parsedBorderStyles,cachedBorderStyles) ||
+            !IsSameStyles(parsedTextStyles,cachedTextStyles) ||
+            !IsSameIconStyle(parsed.GetAreaIconStyle(type,buffer,projection),
+                             cached.GetAreaIconStyle(type,buffer,projection))) {
+          std::cerr << "Area styles of type '" << type->GetName() << "' differ in level " << level << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc<3) {
+    std::cerr << "StyleLoadPerformanceTest <ost file> <oss file> [repeat count]" << std::endl;
+    return 1;
+  }
+
+  std::string ostFile=argv[1];
+  std::string ossFile=argv[2];
+  size_t      repeat=10;
+
+  if (argc>3) {
+    repeat=std::stoul(argv[3]);
+  }
+
+  osmscout::log.Debug(false);
+  osmscout::log.Info(false);
+  osmscout::log.Warn(false);
+
+  osmscout::TypeConfigRef typeConfig=std::make_shared<osmscout::TypeConfig>();
+
+  if (!typeConfig->LoadFromOSTFile(ostFile)) {
+    std::cerr << "Cannot load type configuration '" << ostFile << "'" << std::endl;
+    return 1;
+  }
+
+  std::filesystem::path tmpDir=std::filesystem::temp_directory_path();
+  std::string           cacheFile=(tmpDir / "StyleLoadPerformanceTest.ossb").string();
+
+  osmscout::RemoveFile(cacheFile);
+
+  double parseTime=0.0;
+
+  for (size_t i=0; i<repeat; i++) {
+    osmscout::StyleConfig styleConfig(typeConfig);
+    osmscout::StopClock   timer;
+
+    if (!styleConfig.Load(ossFile)) {
+      std::cerr << "Cannot parse style sheet '" << ossFile << "'" << std::endl;
+      return 1;
+    }
+
+    timer.Stop();
+    parseTime+=timer.GetMilliseconds();
+  }
+
+  DumpTime("Parse",parseTime,repeat);
+
+  osmscout::StopClock storeTimer;
+
+  if (!osmscout::StyleConfig(typeConfig).LoadCached(ossFile,cacheFile) ||
+      !osmscout::ExistsInFilesystem(cacheFile)) {
+    std::cerr << "Cannot create style sheet cache" << std::endl;
+    return 1;
+  }
+
+  storeTimer.Stop();
+  DumpTime("Parse and store cache",storeTimer.GetMilliseconds(),1);
+
+  double cachedTime=0.0;
+
+  for (size_t i=0; i<repeat; i++) {
+    osmscout::StyleConfig styleConfig(typeConfig);
+    osmscout::StopClock   timer;
+
+    if (!styleConfig.LoadBinary(cacheFile)) {
+      std::cerr << "Cannot load style sheet cache" << std::endl;
+      return 1;
+    }
+
+    timer.Stop();
+    cachedTime+=timer.GetMilliseconds();
+  }
+
+  DumpTime("Load cache",cachedTime,repeat);
+
+  if (cachedTime>0.0) {
+    std::cout << "Speedup: " << parseTime/cachedTime << "x" << std::endl;
+  }
+
+  int result=0;
+
+  osmscout::StyleConfig parsedConfig(typeConfig);
+  osmscout::StyleConfig cachedConfig(typeConfig);
+
+  if (!parsedConfig.Load(ossFile) ||
+      !cachedConfig.LoadBinary(cacheFile) ||
+      !IsSameResolvedStyle(*typeConfig,parsedConfig,cachedConfig)) {
+    std::cerr << "Style sheet loaded from cache differs from parsed style sheet" << std::endl;
+    result=1;
+  }
+
+  osmscout::StyleConfig flagConfig(typeConfig);
+
+  // A different set of flags must invalidate the cache, but the style sheet must still load
+  flagConfig.AddFlag("StyleLoadPerformanceTest",true);
+
+  if (!flagConfig.LoadCached(ossFile,cacheFile) ||
+      !flagConfig.HasFlag("StyleLoadPerformanceTest")) {
+    std::cerr << "Fallback to parsing failed" << std::endl;
+    result=1;
+  }
+
+  osmscout::RemoveFile(cacheFile);
+
+  return result;
+}
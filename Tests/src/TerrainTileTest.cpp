@@ -0,0 +1,178 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include <osmscout/elevation/TerrainDataFile.h>
+#include <osmscout/elevation/TerrainTile.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+static const size_t grid=101;
+
+static osmscout::SRTMData CreateData(const std::function<int32_t(size_t,size_t)>& height)
+{
+  osmscout::SRTMData data;
+
+  data.boundingBox=osmscout::GeoBox(osmscout::GeoCoord(10.0,20.0),
+                                    osmscout::GeoCoord(11.0,21.0));
+  data.rows=grid;
+  data.columns=grid;
+  data.heights.reserve(grid*grid);
+
+  for (size_t row=0; row<grid; row++) {
+    for (size_t column=0; column<grid; column++) {
+      data.heights.push_back(height(column,row));
+    }
+  }
+
+  return data;
+}
+
+TEST_CASE("Contour lines of a plane rising to the east")
+{
+  auto data=CreateData([](size_t column, size_t /*row*/) {
+    return int32_t(column*10+5);
+  });
+  auto tile=osmscout::TerrainTile::Generate(data,250,10);
+
+  REQUIRE(tile->patchLat==10);
+  REQUIRE(tile->patchLon==20);
+  REQUIRE(tile->contourLines.size()==4);
+
+  for (const auto& line : tile->contourLines) {
+    REQUIRE(line.elevation%250==0);
+    REQUIRE(line.nodes.size()==grid);
+
+    // Crossing exactly between two samples
+    double lon=20.0+(double(line.elevation-5)/10.0)/double(grid-1);
+
+    for (const auto& node : line.nodes) {
+      REQUIRE(std::abs(node.GetLon()-lon)<1e-9);
+    }
+
+    REQUIRE(std::abs(line.boundingBox.GetMinLat()-10.0)<1e-9);
+    REQUIRE(std::abs(line.boundingBox.GetMaxLat()-11.0)<1e-9);
+  }
+}
+
+TEST_CASE("Contour lines are skipped for missing data")
+{
+  auto data=CreateData([](size_t column, size_t row) {
+    if (row==50) {
+      return int32_t(osmscout::SRTM::nodata);
+    }
+
+    return int32_t(column*10+5);
+  });
+  auto tile=osmscout::TerrainTile::Generate(data,250,10);
+
+  // Each contour line is split into a northern and a southern part
+  REQUIRE(tile->contourLines.size()==8);
+
+  for (const auto& line : tile->contourLines) {
+    REQUIRE(line.nodes.size()==50);
+  }
+}
+
+TEST_CASE("Hill shading depends on the orientation of the slope")
+{
+  auto flat=osmscout::TerrainTile::Generate(CreateData([](size_t /*column*/, size_t /*row*/) {
+    return int32_t(500);
+  }),25,10);
+  auto facingWest=osmscout::TerrainTile::Generate(CreateData([](size_t column, size_t /*row*/) {
+    return int32_t(column*100);
+  }),25,10);
+  auto facingEast=osmscout::TerrainTile::Generate(CreateData([](size_t column, size_t /*row*/) {
+    return int32_t((grid-1-column)*100);
+  }),25,10);
+
+  REQUIRE(flat->contourLines.empty());
+  REQUIRE(flat->hillShadeRows==10);
+  REQUIRE(flat->hillShadeColumns==10);
+
+  for (size_t row=0; row<10; row++) {
+    for (size_t column=0; column<10; column++) {
+      REQUIRE(flat->GetHillShade(column,row)==osmscout::TerrainTile::FlatHillShade);
+      // The sun is in the north west
+      REQUIRE(facingWest->GetHillShade(column,row)>osmscout::TerrainTile::FlatHillShade);
+      REQUIRE(facingEast->GetHillShade(column,row)<osmscout::TerrainTile::FlatHillShade);
+    }
+  }
+
+  osmscout::GeoBox cell=flat->GetHillShadeCell(0,0);
+
+  REQUIRE(std::abs(cell.GetMinLat()-10.9)<1e-9);
+  REQUIRE(std::abs(cell.GetMaxLat()-11.0)<1e-9);
+  REQUIRE(std::abs(cell.GetMinLon()-20.0)<1e-9);
+  REQUIRE(std::abs(cell.GetMaxLon()-20.1)<1e-9);
+}
+
+TEST_CASE("Write and read terrain data file")
+{
+  std::filesystem::path directory=std::filesystem::temp_directory_path() / "terrain_test";
+
+  std::filesystem::create_directories(directory);
+
+  auto tile=osmscout::TerrainTile::Generate(CreateData([](size_t column, size_t row) {
+    return int32_t(column*10+row*3);
+  }),100,20);
+
+  osmscout::TerrainDataFileWriter writer;
+
+  writer.Open(directory.string());
+  writer.Write(*tile);
+  writer.Close();
+
+  osmscout::TerrainDataFile file;
+
+  REQUIRE(file.Open(directory.string(),true));
+
+  std::vector<osmscout::TerrainTileRef> tiles;
+
+  REQUIRE(file.GetTiles(osmscout::GeoBox(osmscout::GeoCoord(9.5,19.5),
+                                         osmscout::GeoCoord(10.5,20.5)),
+                        tiles));
+  REQUIRE(tiles.size()==1);
+
+  const auto& loaded=*tiles.front();
+
+  REQUIRE(loaded.patchLat==tile->patchLat);
+  REQUIRE(loaded.patchLon==tile->patchLon);
+  REQUIRE(loaded.hillShade==tile->hillShade);
+  REQUIRE(loaded.contourLines.size()==tile->contourLines.size());
+
+  for (size_t i=0; i<tile->contourLines.size(); i++) {
+    REQUIRE(loaded.contourLines[i].elevation==tile->contourLines[i].elevation);
+    REQUIRE(loaded.contourLines[i].nodes.size()==tile->contourLines[i].nodes.size());
+    // Coordinates are stored with reduced precision
+    REQUIRE(std::abs(loaded.contourLines[i].boundingBox.GetMinLat()-tile->contourLines[i].boundingBox.GetMinLat())<1e-6);
+  }
+
+  REQUIRE(file.GetTiles(osmscout::GeoBox(osmscout::GeoCoord(40.0,40.0),
+                                         osmscout::GeoCoord(41.0,41.0)),
+                        tiles));
+  REQUIRE(tiles.empty());
+
+  file.Close();
+  std::filesystem::remove_all(directory);
+}
@@ -19,20 +19,97 @@
 
 #include <algorithm>
 #include <iostream>
+#include <set>
 
 #include <osmscout/db/TextSearchIndex.h>
 #include <osmscout/db/Database.h>
 
 #include <osmscout/cli/CmdLineParsing.h>
 
+#include <osmscout/util/StopClock.h>
+
 struct Arguments
 {
   bool        help=false;
   std::string databaseDirectory;
   std::string lookupPhrase;
   int         expectedResults=-1;
+  int         minResults=-1;
+  bool        fuzzy=false;
+  size_t      benchmarkRounds=0;
 };
 
+/**
+ * Return misspelled variants of the phrase (deleted, transposed and replaced characters)
+ */
+std::vector<std::string> getMisspellings(const std::string& phrase)
+{
+  std::set<std::string> misspellings;
+
+  for (size_t i=0; i<phrase.length(); i++) {
+    // Only ASCII characters, to keep the variants valid UTF-8
+    if ((unsigned char)phrase[i]>=0x80) {
+      continue;
+    }
+
+    std::string deleted=phrase;
+    deleted.erase(i,1);
+    misspellings.insert(deleted);
+
+    std::string replaced=phrase;
+    replaced[i]=replaced[i]=='x' ? 'y' : 'x';
+    misspellings.insert(replaced);
+
+    if (i+1<phrase.length() && (unsigned char)phrase[i+1]<0x80) {
+      std::string transposed=phrase;
+      std::swap(transposed[i],transposed[i+1]);
+      misspellings.insert(transposed);
+    }
+  }
+
+  return std::vector<std::string>(misspellings.begin(),misspellings.end());
+}
+
+/**
+ * Measure the throughput of the fuzzy search for misspelled variants of the phrase
+ */
+void benchmarkFuzzySearch(const osmscout::TextSearchIndex& textSearch,
+                          const std::string& phrase,
+                          size_t rounds)
+{
+  std::vector<std::string>                          queries=getMisspellings(phrase);
+  osmscout::TextSearchIndex::FuzzySearchParameter parameter;
+  osmscout::TextSearchIndex::FuzzyResults         results;
+  size_t                                            queryCount=0;
+  size_t                                            resultCount=0;
+  double                                            maxTime=0.0;
+  osmscout::StopClock                               overallTime;
+
+  for (size_t round=0; round<rounds; round++) {
+    for (const auto& query : queries) {
+      osmscout::StopClock queryTime;
+
+      textSearch.SearchFuzzy(query,true,true,true,true,true,parameter,results);
+
+      queryTime.Stop();
+
+      maxTime=std::max(maxTime,queryTime.GetMilliseconds());
+      resultCount+=results.size();
+      queryCount++;
+    }
+  }
+
+  overallTime.Stop();
+
+  double time=overallTime.GetMilliseconds();
+
+  std::cout << "Fuzzy search: " << queryCount << " queries (" << queries.size() << " misspellings), "
+            << resultCount << " results, "
+            << time << " ms, "
+            << (time>0.0 ? size_t(double(queryCount)*1000.0/time) : 0) << " queries/s, "
+            << "max. " << maxTime << " ms per query" << std::endl;
+}
+
 void printDetails(const osmscout::FeatureValueBuffer& features)
 {
   std::cout << "   - type:     " << features.GetType()->GetName() << std::endl;
@@ -82,6 +159,27 @@ int main (int argc, char *argv[])
                       "Count of expected results. Test is terminated with 1 when result count differs.",
                       false);
 
+  argParser.AddOption(osmscout::CmdLineUIntOption([&args](unsigned int value) {
+                        args.minResults=value;
+                      }),
+                      "min-results",
+                      "Minimum count of expected results. Test is terminated with 1 when there are less results.",
+                      false);
+
+  argParser.AddOption(osmscout::CmdLineFlag([&args](const bool& value) {
+                        args.fuzzy=value;
+                      }),
+                      "fuzzy",
+                      "Use typo tolerant search",
+                      false);
+
+  argParser.AddOption(osmscout::CmdLineUIntOption([&args](unsigned int value) {
+                        args.benchmarkRounds=value;
+                      }),
+                      "benchmark",
+                      "Number of rounds of fuzzy searching for misspellings of the phrase",
+                      false);
+
   argParser.AddPositional(osmscout::CmdLineStringOption([&args](const std::string& value) {
                             args.databaseDirectory=value;
                           }),
@@ -126,7 +224,26 @@ int main (int argc, char *argv[])
   // search using the text input as the query
   osmscout::TextSearchIndex::ResultsMap results;
 
-  textSearch.Search(osmscout::LocaleStringToUTF8String(args.lookupPhrase),true,true,true,true,true,results);
+  if (args.fuzzy) {
+    osmscout::TextSearchIndex::FuzzySearchParameter parameter;
+    osmscout::TextSearchIndex::FuzzyResults         fuzzyResults;
+
+    textSearch.SearchFuzzy(osmscout::LocaleStringToUTF8String(args.lookupPhrase),true,true,true,true,true,parameter,fuzzyResults);
+
+    for (const auto& fuzzyResult : fuzzyResults) {
+      std::cout << "\"" << fuzzyResult.text << "\": distance " << fuzzyResult.distance << ", score " << fuzzyResult.score << std::endl;
+      results[fuzzyResult.text]=fuzzyResult.refs;
+    }
+  }
+  else {
+    textSearch.Search(osmscout::LocaleStringToUTF8String(args.lookupPhrase),true,true,true,true,true,results);
+  }
+
+  if (args.benchmarkRounds>0) {
+    benchmarkFuzzySearch(textSearch,
+                         osmscout::LocaleStringToUTF8String(args.lookupPhrase),
+                         args.benchmarkRounds);
+  }
 
   if(results.empty()) {
     std::cout << "No results found." << std::endl;
@@ -176,5 +293,10 @@ int main (int argc, char *argv[])
     std::cerr << "Number of results (" << results.size() << ") differs from expected (" << args.expectedResults << ")" << std::endl;
     return 1;
   }
+
+  if (args.minResults >= 0 && results.size() < size_t(args.minResults)) {
+    std::cerr << "Number of results (" << results.size() << ") is less than expected (" << args.minResults << ")" << std::endl;
+    return 1;
+  }
   return 0;
 }
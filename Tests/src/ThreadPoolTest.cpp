@@ -0,0 +1,146 @@
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <osmscout/async/ThreadPool.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace osmscout;
+
+TEST_CASE("Jobs are executed and return their result")
+{
+  ThreadPool                    pool(4);
+  std::vector<std::future<int>> results;
+
+  for (int i=0; i<100; i++) {
+    results.push_back(pool.Submit([i]() {
+      return i*i;
+    }));
+  }
+
+  for (int i=0; i<100; i++) {
+    REQUIRE(results[i].get()==i*i);
+  }
+
+  REQUIRE(pool.GetThreadCount()==4);
+  REQUIRE(pool.GetPendingJobCount()==0);
+}
+
+TEST_CASE("Jobs with higher priority are executed first")
+{
+  ThreadPool         pool(1);
+  std::promise<void> blocker;
+  std::shared_future<void> blocked=blocker.get_future().share();
+  std::mutex         orderMutex;
+  std::vector<int>   order;
+
+  // Blocks the only worker, until all other jobs are queued
+  auto first=pool.Submit([blocked]() {
+    blocked.wait();
+  });
+
+  std::vector<std::future<void>> results;
+
+  for (int i=0; i<3; i++) {
+    results.push_back(pool.Submit([&orderMutex,&order]() {
+      std::scoped_lock<std::mutex> lock(orderMutex);
+      order.push_back(2);
+    },ThreadPool::Priority::Low));
+    results.push_back(pool.Submit([&orderMutex,&order]() {
+      std::scoped_lock<std::mutex> lock(orderMutex);
+      order.push_back(1);
+    },ThreadPool::Priority::Normal));
+    results.push_back(pool.Submit([&orderMutex,&order]() {
+      std::scoped_lock<std::mutex> lock(orderMutex);
+      order.push_back(0);
+    },ThreadPool::Priority::High));
+  }
+
+  blocker.set_value();
+  first.get();
+
+  for (auto& result : results) {
+    result.get();
+  }
+
+  REQUIRE(order==std::vector<int>{0,0,0,1,1,1,2,2,2});
+}
+
+TEST_CASE("Jobs of a busy worker are stolen")
+{
+  ThreadPool pool(2);
+
+  // Submits all jobs from within the pool to the queue of the worker itself and waits for
+  // them, so they can only be executed by the other worker
+  auto first=pool.Submit([&pool]() {
+    std::vector<std::future<bool>> results;
+
+    for (size_t i=0; i<10; i++) {
+      results.push_back(pool.Submit([]() {
+        return true;
+      }));
+    }
+
+    for (auto& result : results) {
+      result.wait();
+    }
+
+    return results.size();
+  });
+
+  REQUIRE(first.get()==10);
+  // The first job itself may have been stolen, too
+  REQUIRE(pool.GetStolenJobCount()>=10);
+}
+
+TEST_CASE("Jobs of an aborted breaker are skipped")
+{
+  ThreadPool          pool(1);
+  std::promise<void>  blocker;
+  std::shared_future<void> blocked=blocker.get_future().share();
+  BreakerRef          breaker=std::make_shared<ThreadedBreaker>();
+  std::atomic<size_t> executed{0};
+
+  auto first=pool.Submit([blocked]() {
+    blocked.wait();
+  });
+
+  std::vector<std::future<bool>> results;
+
+  for (size_t i=0; i<10; i++) {
+    results.push_back(pool.Submit([&executed]() {
+      executed++;
+      return true;
+    },ThreadPool::Priority::Normal,breaker));
+  }
+
+  breaker->Break();
+  blocker.set_value();
+  first.get();
+
+  for (auto& result : results) {
+    REQUIRE_FALSE(result.get());
+  }
+
+  REQUIRE(executed==0);
+}
+
+TEST_CASE("Pending jobs are executed on destruction")
+{
+  std::atomic<size_t> executed{0};
+
+  {
+    ThreadPool pool(2);
+
+    for (size_t i=0; i<100; i++) {
+      pool.Submit([&executed]() {
+        executed++;
+      });
+    }
+  }
+
+  REQUIRE(executed==100);
+}
@@ -0,0 +1,288 @@
+/*
+  This source is part of the libosmscout-client-qt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <osmscoutclientqt/OSMTile.h>
+#include <osmscoutclientqt/TileCache.h>
+#include <osmscoutclientqt/TileDiskCache.h>
+
+#include <chrono>
+#include <limits>
+
+using namespace osmscout;
+
+namespace {
+
+  // entry overhead is private, compute memory of image tiles from the null tile
+  size_t NullTileMemory()
+  {
+    TileCache cache(std::numeric_limits<size_t>::max());
+    cache.put(0, 0, 0, QImage());
+    return cache.getMemoryUsage();
+  }
+
+  QImage CreateTile(int dimension=256)
+  {
+    QImage image(dimension, dimension, QImage::Format_ARGB32);
+    image.fill(Qt::red);
+    return image;
+  }
+
+  size_t ImageMemory(const QImage &image)
+  {
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0) /* For compatibility with QT 5.6 */
+    return size_t(image.byteCount());
+#else
+    return size_t(image.sizeInBytes());
+#endif
+  }
+
+  struct DiskCacheResult
+  {
+    bool   loaded=false;
+    bool   missed=false;
+    QImage image;
+    size_t epoch=0;
+  };
+
+  /**
+   * Disk cache without its own thread, queued requests are processed
+   * by sending posted events to it.
+   */
+  DiskCacheResult Load(TileDiskCache &cache, const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch)
+  {
+    DiskCacheResult result;
+
+    auto loadedConnection=QObject::connect(&cache, &TileDiskCache::loaded,
+                                           [&result](QString, uint32_t, uint32_t, uint32_t, QImage image, size_t epoch) {
+                                             result.loaded=true;
+                                             result.image=image;
+                                             result.epoch=epoch;
+                                           });
+    auto missedConnection=QObject::connect(&cache, &TileDiskCache::missed,
+                                           [&result](QString, uint32_t, uint32_t, uint32_t, size_t epoch) {
+                                             result.missed=true;
+                                             result.epoch=epoch;
+                                           });
+
+    cache.requestLoad(key, zoomLevel, x, y, epoch);
+    QCoreApplication::sendPostedEvents(&cache);
+
+    QObject::disconnect(loadedConnection);
+    QObject::disconnect(missedConnection);
+
+    return result;
+  }
+
+  QString TilePath(const QTemporaryDir &dir, const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y)
+  {
+    return QString("%1/%2/%3/%4/%5.tile").arg(dir.path()).arg(key).arg(zoomLevel).arg(x).arg(y);
+  }
+
+  void SetModificationTime(const QString &path, const QDateTime &time)
+  {
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadWrite));
+    REQUIRE(file.setFileTime(time, QFileDevice::FileModificationTime));
+  }
+
+} // namespace
+
+TEST_CASE("Tile cache accounts memory of inserted tiles")
+{
+  const size_t entryMemory=NullTileMemory();
+  const QImage tile=CreateTile();
+
+  TileCache cache(std::numeric_limits<size_t>::max());
+  REQUIRE(cache.getMemoryUsage() == 0);
+
+  cache.put(10, 1, 1, tile);
+  REQUIRE(cache.getMemoryUsage() == entryMemory + ImageMemory(tile));
+
+  cache.put(10, 1, 2, QImage());
+  REQUIRE(cache.getMemoryUsage() == 2 * entryMemory + ImageMemory(tile));
+
+  SECTION("Replaced tile is not counted twice")
+  {
+    cache.put(10, 1, 1, CreateTile(512));
+    REQUIRE(cache.getMemoryUsage() == 2 * entryMemory + ImageMemory(CreateTile(512)));
+  }
+
+  SECTION("Invalidated tiles are subtracted")
+  {
+    // box inside of tile 10/1/1, it doesn't intersect tile 10/1/2
+    GeoBox tileBox=OSMTile::tileBoundingBox(10, 1, 1);
+    GeoBox box(tileBox.GetCenter(), tileBox.GetCenter());
+    box.Include(GeoCoord(tileBox.GetCenter().GetLat(), tileBox.GetMinLon() + tileBox.GetWidth() / 4));
+
+    REQUIRE(cache.invalidate(box));
+    REQUIRE(!cache.contains(10, 1, 1));
+    REQUIRE(cache.contains(10, 1, 2));
+    REQUIRE(cache.getMemoryUsage() == entryMemory);
+
+    REQUIRE(cache.invalidate());
+    REQUIRE(cache.getMemoryUsage() == 0);
+  }
+
+  SECTION("Flushed cache is empty")
+  {
+    cache.cleanupCache(std::numeric_limits<uint32_t>::max(), std::chrono::milliseconds::zero());
+    REQUIRE(!cache.contains(10, 1, 1));
+    REQUIRE(cache.getMemoryUsage() == 0);
+  }
+
+  SECTION("Recently used tiles are not cleaned up")
+  {
+    cache.cleanupCache(std::numeric_limits<uint32_t>::max(), std::chrono::hours(1));
+    REQUIRE(cache.contains(10, 1, 1));
+    REQUIRE(cache.getMemoryUsage() == 2 * entryMemory + ImageMemory(tile));
+  }
+}
+
+TEST_CASE("Tile cache removes least recently used tiles when it exceeds its limit")
+{
+  const QImage tile=CreateTile();
+  const size_t tileMemory=NullTileMemory() + ImageMemory(tile);
+
+  // it fits three tiles, the fourth one triggers cleanup to 90% of the limit
+  TileCache cache(3 * tileMemory + tileMemory / 2);
+
+  cache.put(10, 1, 1, tile);
+  cache.put(10, 1, 2, tile);
+  cache.put(10, 1, 3, tile);
+  REQUIRE(cache.getMemoryUsage() == 3 * tileMemory);
+
+  // mark the first tile as used recently
+  cache.get(10, 1, 1);
+
+  cache.put(10, 1, 4, tile);
+  REQUIRE(cache.getMemoryUsage() <= 3 * tileMemory);
+  REQUIRE(cache.contains(10, 1, 1));
+  REQUIRE(!cache.contains(10, 1, 2));
+  REQUIRE(cache.contains(10, 1, 4));
+}
+
+TEST_CASE("Tile disk cache loads stored tiles")
+{
+  int argc=1;
+  char arg0[]="TileCacheTest";
+  char* argv[1]={arg0};
+  QCoreApplication app(argc, argv);
+
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+
+  TileDiskCache cache(nullptr, dir.path(), std::numeric_limits<qint64>::max());
+  const QImage tile=CreateTile();
+
+  auto result=Load(cache, "key", 10, 1, 1, 7);
+  REQUIRE(result.missed);
+  REQUIRE(!result.loaded);
+  REQUIRE(result.epoch == 7);
+
+  cache.requestStore("key", 10, 1, 1, tile);
+  QCoreApplication::sendPostedEvents(&cache);
+  REQUIRE(QFileInfo::exists(TilePath(dir, "key", 10, 1, 1)));
+
+  result=Load(cache, "key", 10, 1, 1, 8);
+  REQUIRE(result.loaded);
+  REQUIRE(result.epoch == 8);
+  REQUIRE(result.image.size() == tile.size());
+  REQUIRE(result.image.pixelColor(0, 0) == tile.pixelColor(0, 0));
+
+  // tiles stored with different key are not used
+  result=Load(cache, "otherKey", 10, 1, 1, 8);
+  REQUIRE(result.missed);
+
+  SECTION("Broken tile is removed")
+  {
+    cache.requestStore("key", 10, 1, 2, QByteArray("not an image"));
+    QCoreApplication::sendPostedEvents(&cache);
+    REQUIRE(QFileInfo::exists(TilePath(dir, "key", 10, 1, 2)));
+
+    result=Load(cache, "key", 10, 1, 2, 8);
+    REQUIRE(result.missed);
+    REQUIRE(!QFileInfo::exists(TilePath(dir, "key", 10, 1, 2)));
+  }
+}
+
+TEST_CASE("Tile disk cache expires old tiles")
+{
+  int argc=1;
+  char arg0[]="TileCacheTest";
+  char* argv[1]={arg0};
+  QCoreApplication app(argc, argv);
+
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+
+  TileDiskCache cache(nullptr, dir.path(), std::numeric_limits<qint64>::max(), std::chrono::hours(1));
+
+  cache.requestStore("key", 10, 1, 1, CreateTile());
+  cache.requestStore("key", 10, 1, 2, CreateTile());
+  QCoreApplication::sendPostedEvents(&cache);
+
+  SetModificationTime(TilePath(dir, "key", 10, 1, 1), QDateTime::currentDateTime().addSecs(-2 * 3600));
+
+  auto result=Load(cache, "key", 10, 1, 1, 0);
+  REQUIRE(result.missed);
+  REQUIRE(!QFileInfo::exists(TilePath(dir, "key", 10, 1, 1)));
+
+  result=Load(cache, "key", 10, 1, 2, 0);
+  REQUIRE(result.loaded);
+}
+
+TEST_CASE("Tile disk cache removes oldest tiles when it exceeds its size")
+{
+  int argc=1;
+  char arg0[]="TileCacheTest";
+  char* argv[1]={arg0};
+  QCoreApplication app(argc, argv);
+
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+
+  const QByteArray data(1000, 'x');
+
+  // it fits two tiles, the third one triggers cleanup to 90% of the size
+  TileDiskCache cache(nullptr, dir.path(), 2500);
+
+  cache.requestStore("oldKey", 10, 1, 1, data);
+  cache.requestStore("key", 10, 1, 2, data);
+  QCoreApplication::sendPostedEvents(&cache);
+
+  QDateTime now=QDateTime::currentDateTime();
+  SetModificationTime(TilePath(dir, "oldKey", 10, 1, 1), now.addSecs(-120));
+  SetModificationTime(TilePath(dir, "key", 10, 1, 2), now.addSecs(-60));
+
+  cache.requestStore("key", 10, 1, 3, data);
+  QCoreApplication::sendPostedEvents(&cache);
+
+  REQUIRE(!QFileInfo::exists(TilePath(dir, "oldKey", 10, 1, 1)));
+  REQUIRE(QFileInfo::exists(TilePath(dir, "key", 10, 1, 2)));
+  REQUIRE(QFileInfo::exists(TilePath(dir, "key", 10, 1, 3)));
+}
@@ -17,3 +17,13 @@ TEST_CASE("Parse ISO8601 time string with millisecond precision") {
   REQUIRE(std::chrono::duration_cast<std::chrono::milliseconds>(ts.time_since_epoch()).count()==1489329116012);
   REQUIRE(osmscout::TimestampToISO8601TimeString(ts)==testString);
 }
+
+TEST_CASE("Reject invalid ISO8601 dates and times") {
+  osmscout::Timestamp ts;
+  REQUIRE_FALSE(osmscout::ParseISO8601TimeString("2017-13-12T14:31:56Z", ts));
+  REQUIRE_FALSE(osmscout::ParseISO8601TimeString("2017-03-32T14:31:56Z", ts));
+  REQUIRE_FALSE(osmscout::ParseISO8601TimeString("2017-02-29T14:31:56Z", ts));
+  REQUIRE_FALSE(osmscout::ParseISO8601TimeString("2017-03-12T24:31:56Z", ts));
+  REQUIRE_FALSE(osmscout::ParseISO8601TimeString("2017-03-12T14:60:56Z", ts));
+  REQUIRE(osmscout::ParseISO8601TimeString("2016-02-29T14:31:56Z", ts));
+}
@@ -0,0 +1,206 @@
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <osmscoutmapopengl/Triangulate.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace osmscout;
+
+static double GetTrianglesArea(const std::vector<GLfloat>& triangles)
+{
+  double area=0.0;
+
+  for (size_t i=0; i+5<triangles.size(); i+=6) {
+    double ax=triangles[i];
+    double ay=triangles[i+1];
+    double bx=triangles[i+2];
+    double by=triangles[i+3];
+    double cx=triangles[i+4];
+    double cy=triangles[i+5];
+
+    area+=std::fabs((bx-ax)*(cy-ay)-(cx-ax)*(by-ay))/2.0;
+  }
+
+  return area;
+}
+
+static std::vector<Vertex2D> GetCircle(double centerX,
+                                       double centerY,
+                                       double radius,
+                                       size_t count)
+{
+  std::vector<Vertex2D> vertices;
+
+  for (size_t i=0; i<count; i++) {
+    double angle=2*M_PI*double(i)/double(count);
+
+    vertices.emplace_back(centerX+radius*std::cos(angle),
+                          centerY+radius*std::sin(angle));
+  }
+
+  return vertices;
+}
+
+static std::vector<Point> ToPoints(const std::vector<Vertex2D>& vertices)
+{
+  std::vector<Point> points;
+
+  for (const auto& vertex : vertices) {
+    points.emplace_back(0,GeoCoord(vertex.GetY(),vertex.GetX()));
+  }
+
+  return points;
+}
+
+TEST_CASE("Triangulate square")
+{
+  std::vector<Vertex2D> square{{0,0},{10,0},{10,10},{0,10}};
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulatePolygon(square);
+
+  REQUIRE(triangles.size()==2*6);
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-100.0)<0.0001);
+}
+
+TEST_CASE("Triangulate concave polygon in both orientations")
+{
+  std::vector<Vertex2D> polygon{{0,0},{10,0},{10,10},{5,2},{0,10}};
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(triangles.size()==3*6);
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-60.0)<0.0001);
+
+  std::reverse(polygon.begin(),polygon.end());
+
+  triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(triangles.size()==3*6);
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-60.0)<0.0001);
+}
+
+TEST_CASE("Triangulate polygon with duplicated and collinear points")
+{
+  std::vector<Vertex2D> polygon{{0,0},{5,0},{5,0},{10,0},{10,10},{0,10},{0,0}};
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-100.0)<0.0001);
+}
+
+TEST_CASE("Triangulate degenerated polygon")
+{
+  std::vector<Vertex2D> empty;
+  std::vector<Vertex2D> line{{0,0},{10,0}};
+  std::vector<Vertex2D> collinear{{0,0},{5,0},{10,0}};
+
+  REQUIRE(Triangulate::TriangulatePolygon(empty).empty());
+  REQUIRE(Triangulate::TriangulatePolygon(line).empty());
+  REQUIRE(GetTrianglesArea(Triangulate::TriangulatePolygon(collinear))==0.0);
+}
+
+TEST_CASE("Triangulate polygon with holes")
+{
+  std::vector<std::vector<Point>> polygon;
+
+  polygon.push_back(ToPoints({{0,0},{10,0},{10,10},{0,10}}));
+  polygon.push_back(ToPoints({{2,2},{4,2},{4,4},{2,4}}));
+  polygon.push_back(ToPoints({{6,6},{6,8},{8,8},{8,6}}));
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulateWithHoles(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-92.0)<0.0001);
+}
+
+TEST_CASE("Triangulate large polygon with hole using z-order hashing")
+{
+  std::vector<std::vector<Point>> polygon;
+
+  polygon.push_back(ToPoints(GetCircle(14.5,50.4,0.01,1000)));
+  polygon.push_back(ToPoints(GetCircle(14.5,50.4,0.005,500)));
+
+  double expectedArea=0.5*1000*0.01*0.01*std::sin(2*M_PI/1000)-
+                      0.5*500*0.005*0.005*std::sin(2*M_PI/500);
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulateWithHoles(polygon);
+
+  REQUIRE(triangles.size()==1500*6);
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-expectedArea)<expectedArea*0.001);
+}
+
+TEST_CASE("Triangulate polygon with non consecutive duplicated points")
+{
+  // Two squares touching in one vertex, which is part of the ring twice
+  std::vector<Vertex2D> polygon{{0,0},{10,0},{10,10},{20,10},{20,20},{10,20},{10,10},{0,10}};
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-200.0)<0.0001);
+
+  std::reverse(polygon.begin(),polygon.end());
+
+  triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-200.0)<0.0001);
+}
+
+TEST_CASE("Triangulate polygon with hole touching the outer ring")
+{
+  std::vector<std::vector<Point>> polygon;
+
+  polygon.push_back(ToPoints({{0,0},{10,0},{10,10},{0,10}}));
+  polygon.push_back(ToPoints({{0,0},{4,2},{4,4},{2,4}}));
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulateWithHoles(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-92.0)<0.0001);
+}
+
+TEST_CASE("Triangulate large polygon with non consecutive duplicated points using z-order hashing")
+{
+  // A circle with a spike from the center and back, the center vertex is part of the ring
+  // twice. The ring passes the center between two circle vertices, so one sector is missing
+  std::vector<Vertex2D> circle=GetCircle(0.0,0.0,100.0,200);
+  std::vector<Vertex2D> polygon;
+
+  polygon.insert(polygon.end(),circle.begin(),circle.begin()+100);
+  polygon.emplace_back(0.0,0.0);
+  polygon.emplace_back(50.0,-10.0);
+  polygon.emplace_back(0.0,0.0);
+  polygon.insert(polygon.end(),circle.begin()+100,circle.end());
+
+  double expectedArea=0.5*199*100.0*100.0*std::sin(2*M_PI/200);
+
+  std::vector<GLfloat> triangles=Triangulate::TriangulatePolygon(polygon);
+
+  REQUIRE(std::fabs(GetTrianglesArea(triangles)-expectedArea)<expectedArea*0.001);
+}
+
+TEST_CASE("Triangulation cache")
+{
+  TriangulationCache      cache(100);
+  std::vector<Point>      square=ToPoints({{0,0},{10,0},{10,10},{0,10}});
+  std::vector<Point>      otherSquare=ToPoints({{1,1},{10,0},{10,10},{0,10}});
+  TriangulationCache::Key key{4711,1,14};
+  TriangulationCache::Key otherLevelKey{4711,1,15};
+
+  REQUIRE(cache.Get(key,square)==nullptr);
+
+  auto triangles=cache.Set(key,square,Triangulate::TriangulatePolygon(square));
+
+  REQUIRE(cache.Get(key,square)==triangles);
+  REQUIRE(cache.Get(otherLevelKey,square)==nullptr);
+  // Same key, but different data (for example from another data file)
+  REQUIRE(cache.Get(key,otherSquare)==nullptr);
+  REQUIRE(cache.GetSize()==12);
+  REQUIRE(cache.GetHits()==1);
+  REQUIRE(cache.GetMisses()==3);
+
+  cache.SetMaxSize(10);
+
+  REQUIRE(cache.GetSize()==0);
+  REQUIRE(cache.Get(key,square)==nullptr);
+}
@@ -0,0 +1,257 @@
+/*
+  TriangulationPerformanceTest - a test program for libosmscout
+  Copyright (C) 2026  Tim Teulings
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/db/AreaDataFile.h>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscoutmapopengl/Triangulate.h>
+
+/**
+  Triangulate all areas of a database the way the OpenGL backend does (CPU only, no
+  OpenGL context required), report throughput and check that the area of the triangles
+  matches the area of the polygons. Afterwards the areas are triangulated again
+  using the triangulation cache to measure a reload of already visible data.
+
+  Arguments: <database directory> [rounds]
+*/
+
+struct Polygon
+{
+  osmscout::FileOffset                      offset;
+  uint32_t                                  ring;
+  std::vector<std::vector<osmscout::Point>> rings; //!< Outer ring followed by holes
+};
+
+static double GetRingArea(const std::vector<osmscout::Point>& nodes)
+{
+  double area=0.0;
+
+  for (size_t i=0; i<nodes.size(); i++) {
+    const osmscout::Point& a=nodes[i];
+    const osmscout::Point& b=nodes[(i+1)%nodes.size()];
+
+    area+=a.GetLon()*b.GetLat()-b.GetLon()*a.GetLat();
+  }
+
+  return std::fabs(area)/2.0;
+}
+
+static double GetTrianglesArea(const std::vector<GLfloat>& triangles)
+{
+  double area=0.0;
+
+  for (size_t i=0; i+5<triangles.size(); i+=6) {
+    double ax=triangles[i];
+    double ay=triangles[i+1];
+    double bx=triangles[i+2];
+    double by=triangles[i+3];
+    double cx=triangles[i+4];
+    double cy=triangles[i+5];
+
+    area+=std::fabs((bx-ax)*(cy-ay)-(cx-ax)*(by-ay))/2.0;
+  }
+
+  return area;
+}
+
+static bool LoadPolygons(const std::string& directory,
+                         std::vector<Polygon>& polygons,
+                         size_t& vertexCount)
+{
+  osmscout::TypeConfig typeConfig;
+
+  if (!typeConfig.LoadFromDataFile(directory)) {
+    std::cerr << "Cannot load type configuration from '" << directory << "'" << std::endl;
+    return false;
+  }
+
+  osmscout::FileScanner scanner;
+
+  try {
+    scanner.Open(osmscout::AppendFileToDir(directory,
+                                           osmscout::AreaDataFile::AREAS_DAT),
+                 osmscout::FileScanner::Sequential,
+                 true);
+
+    uint32_t areaCount=scanner.ReadUInt32();
+
+    for (uint32_t a=1; a<=areaCount; a++) {
+      osmscout::Area area;
+
+      area.Read(typeConfig,
+                scanner);
+
+      for (size_t r=0; r<area.rings.size(); r++) {
+        const osmscout::Area::Ring& ring=area.rings[r];
+
+        if (ring.IsMaster() ||
+            ring.nodes.size()<3 ||
+            (!ring.IsTopOuter() && ring.GetType()->GetIgnore())) {
+          continue;
+        }
+
+        Polygon polygon;
+
+        polygon.offset=area.GetFileOffset();
+        polygon.ring=uint32_t(r);
+        polygon.rings.push_back(ring.nodes);
+
+        for (size_t h=r+1;
+             h<area.rings.size() &&
+             area.rings[h].GetRing()==ring.GetRing()+1 &&
+             area.rings[h].GetType()->GetIgnore();
+             h++) {
+          if (area.rings[h].nodes.size()>=3) {
+            polygon.rings.push_back(area.rings[h].nodes);
+          }
+        }
+
+        for (const auto& nodes : polygon.rings) {
+          vertexCount+=nodes.size();
+        }
+
+        polygons.push_back(std::move(polygon));
+      }
+    }
+
+    scanner.Close();
+  }
+  catch (osmscout::IOException& e) {
+    std::cerr << "Cannot read areas: " << e.GetDescription() << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc<2) {
+    std::cerr << "TriangulationPerformanceTest <database directory> [rounds]" << std::endl;
+    return 1;
+  }
+
+  std::string directory=argv[1];
+  size_t      rounds=5;
+
+  if (argc>2) {
+    rounds=std::max(size_t(1),size_t(std::stoul(argv[2])));
+  }
+
+  std::vector<Polygon> polygons;
+  size_t               vertexCount=0;
+
+  if (!LoadPolygons(directory,polygons,vertexCount)) {
+    return 1;
+  }
+
+  std::cout << "Triangulating " << polygons.size() << " polygons with " << vertexCount << " vertices..." << std::endl;
+
+  double polygonArea=0.0;
+  double trianglesArea=0.0;
+  size_t triangleCount=0;
+  double totalTime=0.0;
+
+  for (size_t round=0; round<rounds; round++) {
+    osmscout::StopClock timer;
+
+    triangleCount=0;
+
+    for (const auto& polygon : polygons) {
+      std::vector<GLfloat> triangles=osmscout::Triangulate::TriangulateWithHoles(polygon.rings);
+
+      triangleCount+=triangles.size()/6;
+
+      if (round==0) {
+        trianglesArea+=GetTrianglesArea(triangles);
+      }
+    }
+
+    timer.Stop();
+    totalTime+=timer.GetMilliseconds();
+
+    if (round==0) {
+      for (const auto& polygon : polygons) {
+        polygonArea+=GetRingArea(polygon.rings.front());
+
+        for (size_t h=1; h<polygon.rings.size(); h++) {
+          polygonArea-=GetRingArea(polygon.rings[h]);
+        }
+      }
+    }
+  }
+
+  double timePerRound=totalTime/double(rounds);
+
+  std::cout << "Triangulation: " << triangleCount << " triangles, " << timePerRound << " ms per round, "
+            << (timePerRound>0.0 ? size_t(double(vertexCount)/timePerRound) : 0) << " vertices/ms" << std::endl;
+
+  osmscout::TriangulationCache cache;
+  osmscout::StopClock          fillTimer;
+
+  for (const auto& polygon : polygons) {
+    osmscout::TriangulationCache::Key key{polygon.offset,polygon.ring,0};
+
+    if (!cache.Get(key,polygon.rings.front())) {
+      cache.Set(key,polygon.rings.front(),osmscout::Triangulate::TriangulateWithHoles(polygon.rings));
+    }
+  }
+
+  fillTimer.Stop();
+
+  osmscout::StopClock reloadTimer;
+
+  for (const auto& polygon : polygons) {
+    osmscout::TriangulationCache::Key key{polygon.offset,polygon.ring,0};
+
+    if (!cache.Get(key,polygon.rings.front())) {
+      cache.Set(key,polygon.rings.front(),osmscout::Triangulate::TriangulateWithHoles(polygon.rings));
+    }
+  }
+
+  reloadTimer.Stop();
+
+  std::cout << "Cache: first load " << fillTimer.GetMilliseconds() << " ms, reload " << reloadTimer.GetMilliseconds() << " ms, "
+            << cache.GetHits() << " hits, " << cache.GetMisses() << " misses" << std::endl;
+
+  double deviation=polygonArea>0.0 ? std::fabs(trianglesArea-polygonArea)/polygonArea : 0.0;
+
+  std::cout << "Polygon area " << polygonArea << ", triangle area " << trianglesArea << ", deviation " << deviation*100.0 << "%" << std::endl;
+
+  // Self-intersecting data may not be triangulated completely, but in sum the areas must match
+  if (deviation>0.01) {
+    std::cerr << "Triangle area does not match polygon area" << std::endl;
+    return 1;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -341,6 +341,11 @@
 #cmakedefine HAVE_LIB_ZLIB 1
 #endif
 
+/* sqlite3 detected */
+#ifndef HAVE_LIB_SQLITE3
+#cmakedefine HAVE_LIB_SQLITE3 1
+#endif
+
 /* libagg detected */
 #ifndef HAVE_LIB_AGG
 #cmakedefine HAVE_LIB_AGG 1
@@ -371,6 +376,10 @@
 #cmakedefine OSMSCOUT_MAP_SVG_HAVE_LIB_PANGO 1
 #endif
 
+/* sqlite3 detected */
+#ifndef OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3
+#cmakedefine OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3 1
+#endif
 
 #ifndef OSMSCOUT_PTHREAD_NAME
 /* Threads are pthreads and non-posix setname is available */
@@ -162,6 +162,9 @@ set(HAVE_LIB_MARISA ${MARISA_FOUND})
 set(OSMSCOUT_HAVE_LIB_MARISA ${HAVE_LIB_MARISA})
 set(OSMSCOUT_IMPORT_HAVE_LIB_MARISA ${MARISA_FOUND})
 
+find_package(CURL QUIET)
+set(OSMSCOUT_CLIENT_HAVE_LIB_CURL ${CURL_FOUND})
+
 find_package(LibXml2)
 if (TARGET LibXml2::LibXml2 AND NOT BUILD_SHARED_LIBS)
   # seems that FindLibXml2.cmake don't handle static libraries properly
@@ -189,6 +192,10 @@ endif()
 find_package(ZLIB)
 target_exists(ZLIB::ZLIB HAVE_LIB_ZLIB)
 
+find_package(SQLite3)
+target_exists(SQLite::SQLite3 HAVE_LIB_SQLITE3)
+set(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3 ${HAVE_LIB_SQLITE3})
+
 find_package(LibLZMA)
 
 find_package(PNG)
@@ -34,9 +34,13 @@
 
 #include <osmscoutclient/DBInstance.h>
 #include <osmscoutclient/DBJob.h>
+#include <osmscoutclient/DBThread.h>
 
 #include <osmscoutclientqt/ClientQtImportExport.h>
 
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 
 namespace osmscout {
@@ -47,6 +51,16 @@ namespace osmscout {
 class OSMSCOUT_CLIENT_QT_API DBLoadJob : public QObject, public DBJob {
   Q_OBJECT
 
+private:
+  /**
+   * Shared with the admission job submitted to DBThread, job is reset when the load job is closed
+   */
+  struct SubmitGuard
+  {
+    std::mutex mutex;
+    DBLoadJob  *job;
+  };
+
 private:
   bool                                            closeOnFinish;
   bool                                            loadBasemap;
@@ -54,6 +68,9 @@ private:
   osmscout::MercatorProjection                    lookupProjection;
   osmscout::AreaSearchParameter                   searchParameter;
   QMap<QString,osmscout::MapService::CallbackId>  callbacks;
+  std::shared_ptr<SubmitGuard>                    submitGuard;
+  DBThreadRef                                     submitThread;
+  std::optional<CancelableFuture<bool>>           submitFuture;
 
   QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> allTiles;
   QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> loadingTiles;
@@ -61,8 +78,14 @@ private:
 
 protected slots:
   void onTileStateChanged(QString dbPath,const osmscout::TileRef tile);
+  void onAdmitted();
 
 signals:
+  /**
+   * Emitted from the DBThread job worker when the submitted job was admitted
+   */
+  void admitted();
+
   /**
    * This signal is not called in Job thread context!
    */
@@ -87,6 +110,21 @@ public:
 
   void Close() override;
 
+  /**
+   * Submit the job to the prioritized job queue of the DBThread. When the job is admitted
+   * by the job worker, it is run in the thread of this object, database read lock
+   * is owned by this thread. So tiles requested with higher priority are loaded first.
+   *
+   * Canceling the returned future skips the job, if it was not admitted yet.
+   * Close cancels the future as well.
+   *
+   * @param dbThread
+   * @param priority
+   * @return future with true, if the job was admitted
+   */
+  CancelableFuture<bool> Submit(const DBThreadRef &dbThread,
+                                DBThread::JobPriority priority=DBThread::JobPriority::High);
+
   bool IsFinished() const;
   QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>> GetAllTiles() const;
 
@@ -68,8 +68,9 @@ private:
   QString iconDirectory;
   QStringList customPoiTypes;
 
-  size_t onlineTileCacheSize{100};
-  size_t offlineTileCacheSize{200};
+  size_t onlineTileCacheSize{32*1024*1024}; // bytes
+  size_t offlineTileCacheSize{64*1024*1024}; // bytes
+  qint64 tileDiskCacheSize{256*1024*1024}; // bytes
   GLPowerOfTwoTexture glPowerOfTwoTexture{GLPowerOfTwoTexture::Upscaling};
   PixelRatioSetup pixelRatio;
 
@@ -183,13 +184,37 @@ public:
     return *this;
   }
 
+  /**
+   * Setup in-memory tile cache sizes by tile count. Tile caches are limited by memory,
+   * count is converted using size of 256x256 ARGB tile (\see TileCache::EstimatedTileMemory).
+   * Prefer WithTileCacheMemory.
+   */
   inline OSMScoutQtBuilder& WithTileCacheSizes(size_t onlineTileCacheSize,
                                                size_t offlineTileCacheSize){
+    this->onlineTileCacheSize=onlineTileCacheSize*TileCache::EstimatedTileMemory;
+    this->offlineTileCacheSize=offlineTileCacheSize*TileCache::EstimatedTileMemory;
+    return *this;
+  }
+
+  /**
+   * Setup memory limit (in bytes) of in-memory tile caches
+   */
+  inline OSMScoutQtBuilder& WithTileCacheMemory(size_t onlineTileCacheSize,
+                                                size_t offlineTileCacheSize){
     this->onlineTileCacheSize=onlineTileCacheSize;
     this->offlineTileCacheSize=offlineTileCacheSize;
     return *this;
   }
 
+  /**
+   * Setup size limit (in bytes) of on-disk tile caches (for rendered offline tiles
+   * and downloaded online tiles, each). Zero disables disk caches.
+   */
+  inline OSMScoutQtBuilder& WithTileDiskCacheSize(qint64 tileDiskCacheSize){
+    this->tileDiskCacheSize=tileDiskCacheSize;
+    return *this;
+  }
+
   inline OSMScoutQtBuilder& WithTilePowerOfTwoScaling(GLPowerOfTwoTexture glPowerOfTwoTexture){
     this->glPowerOfTwoTexture=glPowerOfTwoTexture;
     return *this;
@@ -281,6 +306,7 @@ private:
   QString             cacheLocation;
   size_t              onlineTileCacheSize;
   size_t              offlineTileCacheSize;
+  qint64              tileDiskCacheSize;
   GLPowerOfTwoTexture glPowerOfTwoTexture;
   PixelRatioSetup     pixelRatio;
   QString             userAgent;
@@ -300,6 +326,7 @@ private:
              QString cacheLocation,
              size_t onlineTileCacheSize,
              size_t offlineTileCacheSize,
+             qint64 tileDiskCacheSize,
              GLPowerOfTwoTexture glPowerOfTwoTexture,
              const PixelRatioSetup &pixelRatio,
              QString userAgent,
@@ -89,7 +89,13 @@ struct RequestState
  * \ingroup QtAPI
  *
  * Cache have to be locked by its mutex() while access.
- * It owns all inserted tiles and it is responsible for its release
+ * It owns all inserted tiles and it is responsible for its release.
+ *
+ * Size of the cache is limited by memory used by tile images (in bytes),
+ * not by count of tiles. Tile size depends on screen DPI and pixel ratio,
+ * so count-based limit is hard to configure reasonably.
+ * When the limit is exceeded, tiles not used for some time are removed first,
+ * then least recently used tiles until the cache uses less than 90% of its limit.
  */
 class OSMSCOUT_CLIENT_QT_API TileCache : public QObject
 {
@@ -99,6 +105,16 @@ signals:
   void tileRequested(uint32_t zoomLevel, uint32_t x, uint32_t y);
 
 public:
+  /**
+   * Rough memory usage of one 256x256 ARGB tile, it may be used for conversion
+   * of tile count to memory limit
+   */
+  static constexpr size_t EstimatedTileMemory=256*256*4;
+
+public:
+  /**
+   * @param cacheSize maximum memory used by cached tiles (in bytes)
+   */
   explicit TileCache(size_t cacheSize);
   ~TileCache() override = default;
 
@@ -148,6 +164,14 @@ public:
 
   void cleanupCache(uint32_t maxRemove, const std::chrono::milliseconds &maximumLifetime);
 
+  /**
+   * @return memory used by cached tiles (in bytes)
+   */
+  inline size_t getMemoryUsage() const
+  {
+    return memoryUsage;
+  }
+
   inline size_t getEpoch() const
   {
     return epoch;
@@ -158,10 +182,17 @@ public:
     epoch ++;
   }
 
+private:
+  static size_t tileMemory(const TileCacheVal &val);
+
+  void removeTile(const TileCacheKey &key);
+  void removeLeastRecentlyUsed(size_t targetMemoryUsage);
+
 private:
   QHash<TileCacheKey, TileCacheVal> tiles;
   QHash<TileCacheKey, RequestState> requests;
-  size_t                            cacheSize; // maximum count of elements in cache
+  size_t                            cacheSize; // maximum memory used by cached tiles (in bytes)
+  size_t                            memoryUsage{0}; // memory used by cached tiles (in bytes)
   size_t                            epoch{0};
 };
 
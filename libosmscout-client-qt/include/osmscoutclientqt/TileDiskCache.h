@@ -0,0 +1,110 @@
+#ifndef OSMSCOUT_CLIENT_QT_TILEDISKCACHE_H
+#define OSMSCOUT_CLIENT_QT_TILEDISKCACHE_H
+
+/*
+ OSMScout - a Qt backend for libosmscout and libosmscout-map
+ Copyright (C) 2026  Tim Teulings
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 2.1 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <QObject>
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QThread>
+
+#include <osmscoutclientqt/ClientQtImportExport.h>
+
+#include <chrono>
+
+namespace osmscout {
+
+/**
+ * \ingroup QtAPI
+ *
+ * Second level of the tile cache, it stores compressed tiles on disk,
+ * so they survive application restart.
+ *
+ * Tiles are stored in the directory structure `<directory>/<key>/<zoom>/<x>/<y>.tile`.
+ * Key should identify everything that affects tile content (database versions,
+ * stylesheet and its flags, rendering parameters or online tile provider).
+ * When the key changes, tiles stored with old key are not used anymore
+ * and they are removed eventually when the cache exceeds its size.
+ *
+ * All disk operations are executed in the thread of this object. Methods
+ * requestLoad and requestStore are thread-safe, result of load request
+ * is reported by loaded or missed signal.
+ */
+class OSMSCOUT_CLIENT_QT_API TileDiskCache : public QObject
+{
+  Q_OBJECT
+
+private:
+  QThread                   *thread;
+  QString                   directory;
+  qint64                    maximumSize;   //!< maximum size of stored tiles (in bytes)
+  std::chrono::seconds      maximumAge;    //!< zero when tiles don't expire
+  qint64                    currentSize{-1}; //!< -1 when it was not computed yet
+
+signals:
+  void loaded(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, size_t epoch);
+  void missed(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+
+  void loadRequested(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+  void storeRequested(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray data);
+
+private slots:
+  void load(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+  void store(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray data);
+
+private:
+  QString tilePath(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y) const;
+  void computeSize();
+  void expire();
+
+public:
+  /**
+   * @param thread thread for disk operations, cache stops the thread in its destructor
+   * @param directory cache directory
+   * @param maximumSize maximum size of stored tiles (in bytes)
+   * @param maximumAge maximum age of stored tile, zero when tiles don't expire
+   */
+  TileDiskCache(QThread *thread,
+                const QString &directory,
+                qint64 maximumSize,
+                const std::chrono::seconds &maximumAge = std::chrono::seconds::zero());
+
+  ~TileDiskCache() override;
+
+  /**
+   * Request loading of the tile, result is reported by loaded or missed signal
+   */
+  void requestLoad(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+
+  /**
+   * Request storing of the tile image, it is stored as PNG
+   */
+  void requestStore(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, const QImage &image);
+
+  /**
+   * Request storing of the tile already encoded in some image format (downloaded tile for example)
+   */
+  void requestStore(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, const QByteArray &data);
+};
+
+}
+
+#endif /* OSMSCOUT_CLIENT_QT_TILEDISKCACHE_H */
@@ -23,6 +23,8 @@
 
 #include <QObject>
 #include <QSettings>
+#include <QSet>
+#include <QElapsedTimer>
 
 #include <osmscoutmap/DataTileCache.h>
 
@@ -30,11 +32,13 @@
 
 #include <osmscoutclientqt/MapRenderer.h>
 #include <osmscoutclientqt/TileCache.h>
+#include <osmscoutclientqt/TileDiskCache.h>
 #include <osmscoutclientqt/OsmTileDownloader.h>
 
 #include <osmscoutclientqt/ClientQtImportExport.h>
 
 #include <atomic>
+#include <limits>
 
 namespace osmscout {
 
@@ -76,6 +80,24 @@ private:
   TileCache                     onlineTileCache;
   TileCache                     offlineTileCache;
 
+  // Second level of tile caches, compressed tiles stored on disk (nullptr when disabled).
+  // Disk is checked before the tile is downloaded or rendered, I/O is done in separate thread.
+  //
+  // Offline tiles are stored with key computed from databases, stylesheet
+  // and rendering parameters. The key is recomputed when offlineTileCache epoch changes.
+  // Tiles intersecting overlay objects are not stored nor loaded.
+  TileDiskCache                 *offlineDiskCache=nullptr;
+  TileDiskCache                 *onlineDiskCache=nullptr;
+  QString                       offlineDiskCacheKey; // guarded by tileCacheMutex, empty when disk cache should not be used
+  size_t                        offlineDiskCacheKeyEpoch{std::numeric_limits<size_t>::max()}; // guarded by tileCacheMutex
+  QSet<TileCacheKey>            offlineDiskCacheMisses; // guarded by tileCacheMutex
+  QString                       onlineDiskCacheKey; // guarded by tileCacheMutex
+
+  // cold start statistics, guarded by tileCacheMutex
+  QElapsedTimer                 coldStartTimer;
+  bool                          firstCompleteMap{false};
+  size_t                        diskCacheHits{0};
+
   std::atomic<GLPowerOfTwoTexture> glPowerOfTwoTexture{GLPowerOfTwoTexture::Upscaling};
 
   OsmTileDownloader             *tileDownloader=nullptr;
@@ -94,6 +116,12 @@ private:
   uint32_t                      loadYTo;
   MagnificationLevel            loadZ;
   size_t                        loadEpoch; // guarded by lock
+  QString                       loadDiskCacheKey; // guarded by lock
+
+  // area of the running data loading request, job is canceled when it is not visible anymore
+  osmscout::GeoBox              loadBox; // guarded by tileCacheMutex, invalid when there is no load job
+  uint32_t                      loadBoxZ{0}; // guarded by tileCacheMutex
+  bool                          loadCancelRequested{false}; // guarded by tileCacheMutex
 
   QColor                        unknownColor;
   QColor                        tileGridColor;
@@ -106,6 +134,7 @@ signals:
   void onlineTileProviderSignal(OnlineTileProvider provider);
   void onlineTilesEnabledSignal(bool);
   void offlineMapChangedSignal(bool);
+  void offlineLoadOffScreen();
 
 public slots:
   virtual void Initialize();
@@ -119,16 +148,27 @@ public slots:
   void tileDownloaded(uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray downloadedData);
   void tileDownloadFailed(uint32_t zoomLevel, uint32_t x, uint32_t y, bool zoomLevelOutOfRange);
   void onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>>);
+  void onOfflineLoadOffScreen();
 
   void onlineTileProviderChanged(const OnlineTileProvider &);
   void onlineTilesEnabledChanged(bool);
 
   void onOfflineMapChanged(bool);
 
+  void offlineDiskCacheLoaded(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, size_t epoch);
+  void offlineDiskCacheMissed(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+  void onlineDiskCacheLoaded(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, size_t epoch);
+  void onlineDiskCacheMissed(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch);
+
 private:
 
   DatabaseCoverage databaseCoverageOfTile(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile);
 
+  void downloadOnlineTile(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile);
+  bool intersectsOverlayObjects(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile) const;
+  QString computeOfflineDiskCacheKey();
+  static QString diskCacheKey(const QStringList &parameters);
+
 public:
   TiledMapRenderer(QThread *thread,
                    SettingsRef settings,
@@ -137,6 +177,7 @@ public:
                    const QString &tileCacheDirectory,
                    size_t onlineTileCacheSize,
                    size_t offlineTileCacheSize,
+                   qint64 tileDiskCacheSize,
                    GLPowerOfTwoTexture glPowerOfTwoTexture,
                    const PixelRatioSetup &pixelRatio);
 
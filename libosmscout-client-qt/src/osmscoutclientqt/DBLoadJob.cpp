@@ -31,18 +31,25 @@ DBLoadJob::DBLoadJob(osmscout::MercatorProjection lookupProjection,
   closeOnFinish(closeOnFinish),
   loadBasemap(loadBasemap),
   breaker(std::make_shared<ThreadedBreaker>()),
-  lookupProjection(lookupProjection)
+  lookupProjection(lookupProjection),
+  submitGuard(std::make_shared<SubmitGuard>())
 {
+  submitGuard->job=this;
+
   //qDebug() << "create: " << this << " in " << QThread::currentThread();
 
   searchParameter.SetMaximumAreaLevel(maximumAreaLevel);
   searchParameter.SetUseMultithreading(true);
   searchParameter.SetUseLowZoomOptimization(lowZoomOptimization);
   searchParameter.SetBreaker(breaker);
+  searchParameter.SetPriority(ThreadPool::Priority::High);
 
   connect(this, &DBLoadJob::tileStateChanged,
           this, &DBLoadJob::onTileStateChanged,
           Qt::QueuedConnection);
+  connect(this, &DBLoadJob::admitted,
+          this, &DBLoadJob::onAdmitted,
+          Qt::QueuedConnection);
 }
 
 DBLoadJob::~DBLoadJob()
@@ -125,6 +132,43 @@ void DBLoadJob::Run(const DBInstanceRef& basemapDatabase,
   }
 }
 
+CancelableFuture<bool> DBLoadJob::Submit(const DBThreadRef &dbThread,
+                                         DBThread::JobPriority priority)
+{
+  assert(threadId==std::this_thread::get_id());
+  submitThread=dbThread;
+
+  // Database read lock is owned by the thread that acquired it and DBJob holds it
+  // until it is closed. So the admission job doesn't run the load job itself,
+  // it just passes it back to the thread of this object.
+  auto guard=submitGuard;
+  auto future=dbThread->SubmitJob([guard](const std::list<DBInstanceRef>&,
+                                          const DBInstanceRef&,
+                                          const Breaker&) {
+    std::scoped_lock lock(guard->mutex);
+    if (guard->job!=nullptr) {
+      emit guard->job->admitted();
+    }
+  },
+  priority);
+
+  submitFuture=future;
+  return future;
+}
+
+void DBLoadJob::onAdmitted()
+{
+  {
+    std::scoped_lock lock(submitGuard->mutex);
+    if (submitGuard->job==nullptr) {
+      return; // closed meanwhile
+    }
+  }
+  if (submitThread) {
+    submitThread->RunJob(std::bind(&DBLoadJob::Run, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  }
+}
+
 void DBLoadJob::onTileStateChanged(QString dbPath,const osmscout::TileRef tile)
 {
   if (!tile->IsComplete()){
@@ -164,6 +208,15 @@ void DBLoadJob::Close()
   // stop asynchronous loading if it is still running
   breaker->Break();
 
+  // skip the job if it was not admitted yet
+  {
+    std::scoped_lock lock(submitGuard->mutex);
+    submitGuard->job=nullptr;
+  }
+  if (submitFuture) {
+    submitFuture->Cancel();
+  }
+
   // deregister callbacks
   for (auto &db:databases){
     QString path=QString::fromStdString(db->path);
@@ -73,7 +73,7 @@ void LookupModule::requestObjectsOnView(const MapViewStruct &view,
   connect(loadJob, &DBLoadJob::finished,
           this, &LookupModule::onLoadJobFinished);
 
-  dbThread->RunJob(std::bind(&DBLoadJob::Run, loadJob, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  loadJob->Submit(dbThread, DBThread::JobPriority::Normal);
 }
 
 void LookupModule::addObjectInfo(QList<ObjectInfo> &objectList, // output
@@ -145,7 +145,7 @@ void LookupModule::requestObjects(const LocationEntry &entry, bool reverseLookup
   QList<ObjectInfo> objectList;
 
   dbThread->RunSynchronousJob(
-    [&](const std::list<DBInstanceRef> &databases){
+    [&](const std::list<DBInstanceRef> &databases, const DBInstanceRef &, const Breaker &){
       for (const auto &db:databases) {
         if (QString::fromStdString(db->path)==entry.getDatabase()){
 
@@ -207,7 +207,8 @@ void LookupModule::requestObjects(const LocationEntry &entry, bool reverseLookup
           }
         }
       }
-    }
+    },
+    DBThread::JobPriority::Normal
   );
   objectList.size();
   emit objectsLoaded(entry, objectList);
@@ -288,7 +289,7 @@ void LookupModule::requestLocationDescription(const osmscout::GeoCoord location)
 {
   QMutexLocker locker(&mutex);
   OSMScoutQt::GetInstance().GetDBThread()->RunSynchronousJob(
-    [this,location](const std::list<DBInstanceRef> &databases){
+    [this,location](const std::list<DBInstanceRef> &databases, const DBInstanceRef &, const Breaker &){
       for (auto db:databases){
         osmscout::LocationDescription description;
         osmscout::GeoBox dbBox=db->GetDBGeoBox();
@@ -321,7 +322,8 @@ void LookupModule::requestLocationDescription(const osmscout::GeoCoord location)
       }
 
       emit locationDescriptionFinished(location);
-    }
+    },
+    DBThread::JobPriority::Normal
   );
 }
 
@@ -386,7 +388,7 @@ void LookupModule::requestRegionLookup(const osmscout::GeoCoord location) {
   QMutexLocker locker(&mutex);
 
   OSMScoutQt::GetInstance().GetDBThread()->RunSynchronousJob(
-    [this,location](const std::list<DBInstanceRef> &databases) {
+    [this,location](const std::list<DBInstanceRef> &databases, const DBInstanceRef &, const Breaker &) {
       for (auto db:databases) {
         osmscout::GeoBox dbBox=db->GetDBGeoBox();
         if (!dbBox.Includes(location)){
@@ -433,7 +435,8 @@ void LookupModule::requestRegionLookup(const osmscout::GeoCoord location) {
           adminRegionCache[QString::fromStdString(db->path)]=adminRegionMap;
         }
       }
-    }
+    },
+    DBThread::JobPriority::Normal
   );
 
   emit locationAdminRegionFinished(location);
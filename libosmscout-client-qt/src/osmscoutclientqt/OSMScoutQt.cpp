@@ -184,6 +184,7 @@ OSMScoutQtBuilder::~OSMScoutQtBuilder()
                                   cacheLocation,
                                   onlineTileCacheSize,
                                   offlineTileCacheSize,
+                                  tileDiskCacheSize,
                                   glPowerOfTwoTexture,
                                   pixelRatio,
                                   userAgent,
@@ -304,6 +305,7 @@ OSMScoutQt::OSMScoutQt(SettingsRef settings,
                        QString cacheLocation,
                        size_t onlineTileCacheSize,
                        size_t offlineTileCacheSize,
+                       qint64 tileDiskCacheSize,
                        GLPowerOfTwoTexture glPowerOfTwoTexture,
                        const PixelRatioSetup &pixelRatio,
                        QString userAgent,
@@ -316,6 +318,7 @@ OSMScoutQt::OSMScoutQt(SettingsRef settings,
         cacheLocation(cacheLocation),
         onlineTileCacheSize(onlineTileCacheSize),
         offlineTileCacheSize(offlineTileCacheSize),
+        tileDiskCacheSize(tileDiskCacheSize),
         glPowerOfTwoTexture(glPowerOfTwoTexture),
         pixelRatio(pixelRatio),
         userAgent(userAgent),
@@ -471,6 +474,7 @@ MapRenderer* OSMScoutQt::MakeMapRenderer(RenderingType type)
                                      cacheLocation,
                                      onlineTileCacheSize,
                                      offlineTileCacheSize,
+                                     tileDiskCacheSize,
                                      glPowerOfTwoTexture,
                                      pixelRatio);
   }else{
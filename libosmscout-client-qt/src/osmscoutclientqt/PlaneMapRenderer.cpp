@@ -529,7 +529,7 @@ void PlaneMapRenderer::TriggerMapRendering(const MapViewStruct& request, size_t
     connect(loadJob, &DBLoadJob::finished,
             this, &PlaneMapRenderer::onLoadJobFinished);
 
-    dbThread->RunJob(std::bind(&DBLoadJob::Run, loadJob, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    loadJob->Submit(dbThread, DBThread::JobPriority::High);
   }
   emit TriggerInitialRendering();
 }
@@ -231,7 +231,9 @@ void SearchModule::SearchForLocations(const QString searchPattern,
   timer.start();
 
   OSMScoutQt::GetInstance().GetDBThread()->RunSynchronousJob(
-    [this,&searchPattern,&limit,&searchCenter,&breaker,&defaultRegionInfo](const std::list<DBInstanceRef>& databases, const DBInstanceRef baseMap) {
+    [this,&searchPattern,&limit,&searchCenter,&breaker,&defaultRegionInfo](const std::list<DBInstanceRef>& databases,
+                                                                            const DBInstanceRef &baseMap,
+                                                                            const Breaker &) {
 
       // sort databases by distance from search center
       // to provide nearest results first
@@ -283,7 +285,9 @@ void SearchModule::SearchForLocations(const QString searchPattern,
         success = success && resultFuture.get();
       }
       emit searchFinished(searchPattern, /*error*/ !success);
-    }
+    },
+    DBThread::JobPriority::Normal,
+    breaker.get()
   );
 
   osmscout::log.Debug() << "Retrieve result tooks " << timer.elapsed() << " ms";
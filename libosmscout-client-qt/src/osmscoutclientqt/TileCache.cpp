@@ -23,7 +23,9 @@
 
 #include <iostream>
 #include <algorithm>
+#include <limits>
 #include <tuple>
+#include <vector>
 
 #include <osmscoutclientqt/TileCache.h>
 #include <osmscoutclientqt/OSMTile.h>
@@ -57,6 +59,32 @@ TileCache::TileCache(size_t cacheSize):
 {
 }
 
+size_t TileCache::tileMemory(const TileCacheVal &val)
+{
+  // null images are cached as well, count just the entry for them
+  size_t entrySize = sizeof(TileCacheKey) + sizeof(TileCacheVal);
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0) /* For compatibility with QT 5.6 */
+  return entrySize + size_t(val.image.byteCount());
+#else
+  return entrySize + size_t(val.image.sizeInBytes());
+#endif
+}
+
+void TileCache::removeTile(const TileCacheKey &key)
+{
+  auto it = tiles.find(key);
+  if (it == tiles.end()) {
+    return;
+  }
+
+#ifdef DEBUG_TILE_CACHE
+  qDebug() << this << "removing" << key;
+#endif
+
+  memoryUsage -= tileMemory(it.value());
+  tiles.erase(it);
+}
+
 void TileCache::clearPendingRequests()
 {        
     QMutableHashIterator<TileCacheKey, RequestState> it(requests);
@@ -196,10 +224,12 @@ void TileCache::put(uint32_t zoomLevel, uint32_t x, uint32_t y, const QImage &im
     qDebug() << this << "inserting tile" << key;
 #endif
 
+    removeTile(key);
     tiles.insert(key, val);
+    memoryUsage += tileMemory(val);
 
-    if (tiles.size() > (int)cacheSize) {
-      cleanupCache(cacheSize / 10, std::chrono::minutes{5});
+    if (memoryUsage > cacheSize) {
+      cleanupCache(std::numeric_limits<uint32_t>::max(), std::chrono::minutes{5});
     }
 }
 
@@ -208,58 +238,66 @@ void TileCache::cleanupCache(uint32_t maxRemove, const std::chrono::milliseconds
     if (maxRemove==std::numeric_limits<uint32_t>::max() && maximumLifetime.count() == 0) {
       // flush cache completely
       tiles.clear();
+      memoryUsage = 0;
       return;
     }
 
     /**
      * first, we will iterate over all entries and remove up to maxRemove tiles
-     * older than `maximumLifetime`, if no such entry found and size is bigger than cacheSize,
-     * remove oldest tile
+     * older than `maximumLifetime`, if cache is still bigger than cacheSize,
+     * remove least recently used tiles until it is under 90% of its size
      *
      * Goal is to remove more items at once and minimise frequency of this expensive cleaning
      */
 
 #ifdef DEBUG_TILE_CACHE
-    qDebug() << this << "Cleaning tile cache (" << cacheSize << ")";
+    qDebug() << this << "Cleaning tile cache (" << memoryUsage << "/" << cacheSize << "bytes)";
 #endif
 
     uint32_t removed = 0;
-    auto oldest=TileCacheVal::clock::duration::zero();
-    TileCacheKey key;
-    TileCacheKey oldestKey;
     auto now = TileCacheVal::clock::now();
 
     QMutableHashIterator<TileCacheKey, TileCacheVal> it(tiles);
     while (it.hasNext() && removed < maxRemove){
         it.next();
 
-        key = it.key();
-        TileCacheVal val = it.value();
-
-        auto elapsed = now - val.lastAccess;
-        if (elapsed > oldest){
-          oldest = elapsed;
-          oldestKey = key;
-        }
-
+        auto elapsed = now - it.value().lastAccess;
         if (elapsed > duration_cast<TileCacheVal::clock::duration>(maximumLifetime)){
 #ifdef DEBUG_TILE_CACHE
-          qDebug() << this << "removing" << key;
+          qDebug() << this << "removing" << it.key();
 #endif
 
+          memoryUsage -= tileMemory(it.value());
           it.remove();
 
           removed ++;
         }
     }
-    if (tiles.size() > (int)cacheSize){
-        if (removed == 0 && oldest.count() > 0){
-          key = oldestKey;
-#ifdef DEBUG_TILE_CACHE
-          qDebug() << this << "removing" << key;
-#endif
-          tiles.remove(key);
+
+    if (memoryUsage > cacheSize){
+        removeLeastRecentlyUsed(cacheSize - cacheSize / 10);
+    }
+}
+
+void TileCache::removeLeastRecentlyUsed(size_t targetMemoryUsage)
+{
+    std::vector<std::pair<TileCacheVal::clock::time_point, TileCacheKey>> candidates;
+    candidates.reserve(tiles.size());
+
+    for (auto it = tiles.cbegin(); it != tiles.cend(); ++it){
+        candidates.emplace_back(it.value().lastAccess, it.key());
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b){
+                return a.first < b.first;
+              });
+
+    for (const auto &[lastAccess, key]: candidates){
+        if (memoryUsage <= targetMemoryUsage){
+            break;
         }
+        removeTile(key);
     }
 }
 
@@ -276,10 +314,12 @@ bool TileCache::invalidate(osmscout::GeoBox box){
         if (box.IsValid()){
             bbox = OSMTile::tileBoundingBox(key.zoomLevel, key.xtile, key.ytile);
             if (box.Intersects(bbox)){
+                memoryUsage -= tileMemory(it.value());
                 it.remove();
                 removed = true;
             }
         }else{
+            memoryUsage -= tileMemory(it.value());
             it.remove();
             removed = true;
         }
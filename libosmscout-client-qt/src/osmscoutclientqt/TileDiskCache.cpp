@@ -0,0 +1,212 @@
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscoutclientqt/TileDiskCache.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace osmscout {
+
+TileDiskCache::TileDiskCache(QThread *thread,
+                             const QString &directory,
+                             qint64 maximumSize,
+                             const std::chrono::seconds &maximumAge):
+  thread(thread),
+  directory(directory),
+  maximumSize(maximumSize),
+  maximumAge(maximumAge)
+{
+  connect(this, &TileDiskCache::loadRequested,
+          this, &TileDiskCache::load,
+          Qt::QueuedConnection);
+  connect(this, &TileDiskCache::storeRequested,
+          this, &TileDiskCache::store,
+          Qt::QueuedConnection);
+}
+
+TileDiskCache::~TileDiskCache()
+{
+  if (thread!=nullptr){
+    thread->quit();
+  }
+}
+
+void TileDiskCache::requestLoad(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch)
+{
+  emit loadRequested(key, zoomLevel, x, y, epoch);
+}
+
+void TileDiskCache::requestStore(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, const QImage &image)
+{
+  emit storeRequested(key, zoomLevel, x, y, image, QByteArray());
+}
+
+void TileDiskCache::requestStore(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y, const QByteArray &data)
+{
+  emit storeRequested(key, zoomLevel, x, y, QImage(), data);
+}
+
+QString TileDiskCache::tilePath(const QString &key, uint32_t zoomLevel, uint32_t x, uint32_t y) const
+{
+  return QString("%1/%2/%3/%4/%5.tile").arg(directory).arg(key).arg(zoomLevel).arg(x).arg(y);
+}
+
+void TileDiskCache::load(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t epoch)
+{
+  QString path=tilePath(key, zoomLevel, x, y);
+  QFileInfo info(path);
+  if (!info.exists()){
+    emit missed(key, zoomLevel, x, y, epoch);
+    return;
+  }
+
+  if (maximumAge.count() > 0 &&
+      info.lastModified().secsTo(QDateTime::currentDateTime()) > maximumAge.count()){
+    if (currentSize >= 0){
+      currentSize -= info.size();
+    }
+    QFile::remove(path);
+    emit missed(key, zoomLevel, x, y, epoch);
+    return;
+  }
+
+  QImage image;
+  if (!image.load(path)){
+    osmscout::log.Warn() << "Removing broken tile " << path.toStdString();
+    if (currentSize >= 0){
+      currentSize -= info.size();
+    }
+    QFile::remove(path);
+    emit missed(key, zoomLevel, x, y, epoch);
+    return;
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0) /* For compatibility with QT 5.6 */
+  if (maximumAge.count() == 0){
+    // modification time is used for removing least recently used tiles
+    QFile file(path);
+    if (file.open(QIODevice::ReadWrite)){
+      file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+  }
+#endif
+
+  emit loaded(key, zoomLevel, x, y, image, epoch);
+}
+
+void TileDiskCache::store(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray data)
+{
+  if (data.isEmpty()){
+    if (image.isNull()){
+      return;
+    }
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "PNG")){
+      osmscout::log.Warn() << "Failed to encode tile " << zoomLevel << " " << x << " " << y;
+      return;
+    }
+  }
+
+  QString path=tilePath(key, zoomLevel, x, y);
+  QFileInfo info(path);
+  qint64 previousSize=info.exists() ? info.size() : 0;
+
+  if (!QDir().mkpath(info.absolutePath())){
+    osmscout::log.Warn() << "Failed to create directory " << info.absolutePath().toStdString();
+    return;
+  }
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(data) != data.size() ||
+      !file.commit()){
+    osmscout::log.Warn() << "Failed to write tile " << path.toStdString() << ": " << file.errorString().toStdString();
+    return;
+  }
+
+  if (currentSize < 0){
+    computeSize();
+  } else {
+    currentSize += data.size() - previousSize;
+  }
+
+  if (currentSize > maximumSize){
+    expire();
+  }
+}
+
+void TileDiskCache::computeSize()
+{
+  currentSize=0;
+  QDirIterator it(directory, QStringList() << "*.tile", QDir::Files, QDirIterator::Subdirectories);
+  while (it.hasNext()){
+    it.next();
+    currentSize+=it.fileInfo().size();
+  }
+}
+
+void TileDiskCache::expire()
+{
+  // oldest tiles (including tiles stored with outdated key) are removed first
+  std::vector<std::tuple<QDateTime, QString, qint64>> files;
+  currentSize=0;
+
+  QDirIterator it(directory, QStringList() << "*.tile", QDir::Files, QDirIterator::Subdirectories);
+  while (it.hasNext()){
+    it.next();
+    QFileInfo info=it.fileInfo();
+    files.emplace_back(info.lastModified(), info.filePath(), info.size());
+    currentSize+=info.size();
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const auto &a, const auto &b){
+              return std::get<0>(a) < std::get<0>(b);
+            });
+
+  qint64 targetSize=maximumSize - maximumSize / 10;
+  size_t removed=0;
+  for (const auto &[lastModified, path, size]: files){
+    if (currentSize <= targetSize){
+      break;
+    }
+    if (QFile::remove(path)){
+      currentSize-=size;
+      removed++;
+    }
+  }
+
+  osmscout::log.Debug() << "Removed " << removed << " tiles from disk cache " << directory.toStdString()
+                        << ", " << currentSize << " bytes used";
+}
+
+}
@@ -21,11 +21,16 @@
 #include <osmscoutclientqt/TiledMapRenderer.h>
 
 #include <osmscoutclientqt/OSMTile.h>
+#include <osmscoutclientqt/OSMScoutQt.h>
 #include <osmscoutclientqt/TiledRenderingHelper.h>
 
+#include <osmscout/TypeConfig.h>
 #include <osmscout/system/Math.h>
 #include <osmscout/log/Logger.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
 #include <QGuiApplication>
 #include <QScreen>
 #include <QtCore>
@@ -40,6 +45,7 @@ TiledMapRenderer::TiledMapRenderer(QThread *thread,
                                    const QString &tileCacheDirectory,
                                    size_t onlineTileCacheSize,
                                    size_t offlineTileCacheSize,
+                                   qint64 tileDiskCacheSize,
                                    GLPowerOfTwoTexture glPowerOfTwoTexture,
                                    const PixelRatioSetup &pixelRatio):
   MapRenderer(thread,settings,dbThread,iconDirectory,pixelRatio),
@@ -51,6 +57,8 @@ TiledMapRenderer::TiledMapRenderer(QThread *thread,
   loadJob(nullptr),
   unknownColor(QColor::fromRgbF(1.0,1.0,1.0)) // white
 {
+  coldStartTimer.start();
+
   QScreen *srn=QGuiApplication::primaryScreen();
   screenWidth=srn->availableSize().width();
   screenHeight=srn->availableSize().height();
@@ -71,6 +79,9 @@ TiledMapRenderer::TiledMapRenderer(QThread *thread,
   connect(this, &TiledMapRenderer::offlineMapChangedSignal,
           this, &TiledMapRenderer::onOfflineMapChanged,
           Qt::QueuedConnection);
+  connect(this, &TiledMapRenderer::offlineLoadOffScreen,
+          this, &TiledMapRenderer::onOfflineLoadOffScreen,
+          Qt::QueuedConnection);
 
   //
   // Make sure that we always decouple caller and receiver even if they are running in the same thread
@@ -84,6 +95,40 @@ TiledMapRenderer::TiledMapRenderer(QThread *thread,
   connect(&offlineTileCache, &TileCache::tileRequested,
           this, &TiledMapRenderer::offlineTileRequest,
           Qt::QueuedConnection);
+
+  if (tileDiskCacheSize > 0 && !tileCacheDirectory.isEmpty()) {
+    QThread *offlineDiskCacheThread=OSMScoutQt::GetInstance().makeThread("OfflineTileDiskCache");
+    offlineDiskCache=new TileDiskCache(offlineDiskCacheThread,
+                                       QDir(tileCacheDirectory).filePath("OfflineTiles"),
+                                       tileDiskCacheSize);
+    offlineDiskCache->moveToThread(offlineDiskCacheThread);
+    offlineDiskCacheThread->start();
+
+    // http://wiki.openstreetmap.org/wiki/Tile_usage_policy
+    // downloaded tiles are cached for 7 days
+    QThread *onlineDiskCacheThread=OSMScoutQt::GetInstance().makeThread("OnlineTileDiskCache");
+    onlineDiskCache=new TileDiskCache(onlineDiskCacheThread,
+                                      QDir(tileCacheDirectory).filePath("OnlineTiles"),
+                                      tileDiskCacheSize,
+                                      std::chrono::hours(7*24));
+    onlineDiskCache->moveToThread(onlineDiskCacheThread);
+    onlineDiskCacheThread->start();
+
+    onlineDiskCacheKey=diskCacheKey(QStringList() << QString::fromStdString(settings->GetOnlineTileProvider().getId()));
+
+    connect(offlineDiskCache, &TileDiskCache::loaded,
+            this, &TiledMapRenderer::offlineDiskCacheLoaded,
+            Qt::QueuedConnection);
+    connect(offlineDiskCache, &TileDiskCache::missed,
+            this, &TiledMapRenderer::offlineDiskCacheMissed,
+            Qt::QueuedConnection);
+    connect(onlineDiskCache, &TileDiskCache::loaded,
+            this, &TiledMapRenderer::onlineDiskCacheLoaded,
+            Qt::QueuedConnection);
+    connect(onlineDiskCache, &TileDiskCache::missed,
+            this, &TiledMapRenderer::onlineDiskCacheMissed,
+            Qt::QueuedConnection);
+  }
 }
 
 TiledMapRenderer::~TiledMapRenderer()
@@ -91,6 +136,13 @@ TiledMapRenderer::~TiledMapRenderer()
   qDebug() << "~TiledMapRenderer";
   delete tileDownloader;
   delete loadJob;
+  // disk caches are living in its own threads
+  if (offlineDiskCache!=nullptr) {
+    offlineDiskCache->deleteLater();
+  }
+  if (onlineDiskCache!=nullptr) {
+    onlineDiskCache->deleteLater();
+  }
 }
 
 void TiledMapRenderer::Initialize()
@@ -205,6 +257,23 @@ bool TiledMapRenderer::RenderMap(QPainter& painter,
   onlineTileCache.clearPendingRequests();
   offlineTileCache.clearPendingRequests();
 
+  // cancel data loading for tiles that are not visible anymore,
+  // MapRenderer::lock can't be acquired here, job is closed in the renderer thread
+  if (loadBox.IsValid() && !loadCancelRequested) {
+    osmscout::MercatorProjection projection;
+    projection.Set(request.coord,
+                   request.angle.AsRadians(),
+                   request.magnification,
+                   request.dpi,
+                   request.width,
+                   request.height);
+    osmscout::GeoBox visibleBox(projection.GetDimensions());
+    if (loadBoxZ != request.magnification.GetLevel() || !loadBox.Intersects(visibleBox)) {
+      loadCancelRequested = true;
+      emit offlineLoadOffScreen();
+    }
+  }
+
   if (QOpenGLContext *glContext = QOpenGLContext::currentContext();
       glContext
       && this->glPowerOfTwoTexture != GLPowerOfTwoTexture::NoScaling
@@ -220,7 +289,15 @@ bool TiledMapRenderer::RenderMap(QPainter& painter,
     return false;
   }
 
-  return onlineTileCache.isRequestQueueEmpty() && offlineTileCache.isRequestQueueEmpty();
+  bool complete = onlineTileCache.isRequestQueueEmpty() && offlineTileCache.isRequestQueueEmpty();
+  if (complete && !firstCompleteMap &&
+      (!offlineTilesEnabled || dbThread->databaseBoundingBox().IsValid())) {
+    firstCompleteMap = true;
+    osmscout::log.Info() << "First complete map rendered " << coldStartTimer.elapsed() << " ms after start, "
+                         << diskCacheHits << " tiles loaded from disk cache";
+  }
+
+  return complete;
 }
 
 DatabaseCoverage TiledMapRenderer::databaseCoverageOfTile(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile)
@@ -264,12 +341,12 @@ void TiledMapRenderer::onlineTileRequest(uint32_t zoomLevel, uint32_t xtile, uin
                                                   DatabaseCoverage::Covered));
 
     if (requestedFromWeb){
-        QMutexLocker locker(&lock);
-        if (tileDownloader == nullptr){
-            qWarning() << "tile requested but downloader is not initialized yet";
-            emit tileDownloadFailed(zoomLevel, xtile, ytile, false);
+        if (onlineDiskCache != nullptr){
+            // try disk cache first, download the tile when it is missing
+            QMutexLocker locker(&tileCacheMutex);
+            onlineDiskCache->requestLoad(onlineDiskCacheKey, zoomLevel, xtile, ytile, onlineTileCache.getEpoch());
         }else{
-            emit tileDownloader->download(zoomLevel, xtile, ytile);
+            downloadOnlineTile(zoomLevel, xtile, ytile);
         }
     } else{
         // put Null image
@@ -280,8 +357,47 @@ void TiledMapRenderer::onlineTileRequest(uint32_t zoomLevel, uint32_t xtile, uin
     }
 }
 
+void TiledMapRenderer::downloadOnlineTile(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile)
+{
+    QMutexLocker locker(&lock);
+    if (tileDownloader == nullptr){
+        qWarning() << "tile requested but downloader is not initialized yet";
+        emit tileDownloadFailed(zoomLevel, xtile, ytile, false);
+    }else{
+        emit tileDownloader->download(zoomLevel, xtile, ytile);
+    }
+}
+
 void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile)
 {
+    if (offlineDiskCache != nullptr && !intersectsOverlayObjects(zoomLevel, xtile, ytile)){
+        size_t epoch;
+        bool keyOutdated;
+        {
+            QMutexLocker tileCacheLocker(&tileCacheMutex);
+            epoch = offlineTileCache.getEpoch();
+            keyOutdated = offlineDiskCacheKeyEpoch != epoch;
+        }
+        if (keyOutdated){
+            QString key = computeOfflineDiskCacheKey();
+
+            QMutexLocker tileCacheLocker(&tileCacheMutex);
+            offlineDiskCacheKey = key;
+            offlineDiskCacheKeyEpoch = epoch;
+            offlineDiskCacheMisses.clear();
+        }
+
+        // try disk cache first, tile will be rendered when it is missing
+        QMutexLocker tileCacheLocker(&tileCacheMutex);
+        if (!offlineDiskCacheKey.isEmpty() &&
+            !offlineDiskCacheMisses.contains(TileCacheKey{zoomLevel, xtile, ytile})){
+            if (offlineTileCache.startRequestProcess(zoomLevel, xtile, ytile)){
+                offlineDiskCache->requestLoad(offlineDiskCacheKey, zoomLevel, xtile, ytile, offlineDiskCacheKeyEpoch);
+            }
+            return;
+        }
+    }
+
     // just start loading
     QMutexLocker locker(&lock);
     if (loadJob!=nullptr){
@@ -294,6 +410,7 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
             return;
 
         loadEpoch = offlineTileCache.getEpoch();
+        loadDiskCacheKey = offlineDiskCacheKeyEpoch == loadEpoch ? offlineDiskCacheKey : QString();
     }
 
     DatabaseCoverage state = databaseCoverageOfTile(zoomLevel, xtile, ytile);
@@ -308,6 +425,10 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
             offlineTileCache.mergeAndStartRequests(zoomLevel, xtile, ytile,
                                                    loadXFrom, loadXTo, loadYFrom, loadYTo,
                                                    /*maxWidth*/ 5, /*maxHeight*/ 5);
+            loadBox = OSMTile::tileBoundingBox(zoomLevel, loadXFrom, loadYFrom);
+            loadBox.Include(OSMTile::tileBoundingBox(zoomLevel, loadXTo, loadYTo));
+            loadBoxZ = zoomLevel;
+            loadCancelRequested = false;
         }
         uint32_t width = (loadXTo - loadXFrom + 1);
         uint32_t height = (loadYTo - loadYFrom + 1);
@@ -347,7 +468,7 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
                 this, &TiledMapRenderer::onLoadJobFinished);
 
         if (offlineTilesEnabled) {
-          dbThread->RunJob(std::bind(&DBLoadJob::Run, loadJob, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+          loadJob->Submit(dbThread, DBThread::JobPriority::High);
         } else {
           // offline map rendering is disabled but there are some overlay objects intersecting with the tile...
           onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osmscout::TileRef>>());
@@ -360,11 +481,14 @@ void TiledMapRenderer::offlineTileRequest(uint32_t zoomLevel, uint32_t xtile, ui
     }
 }
 
-void TiledMapRenderer::tileDownloaded(uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray /*downloadedData*/)
+void TiledMapRenderer::tileDownloaded(uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, QByteArray downloadedData)
 {
     {
         QMutexLocker locker(&tileCacheMutex);
         onlineTileCache.put(zoomLevel, x, y, image);
+        if (onlineDiskCache != nullptr && !downloadedData.isEmpty()){
+            onlineDiskCache->requestStore(onlineDiskCacheKey, zoomLevel, x, y, downloadedData);
+        }
     }
     //std::cout << "  put: " << zoomLevel << " xtile: " << x << " ytile: " << y << std::endl;
     emit Redraw();
@@ -390,11 +514,12 @@ void TiledMapRenderer::tileDownloadFailed(uint32_t zoomLevel, uint32_t x, uint32
     }
 }
 
-void TiledMapRenderer::onlineTileProviderChanged(const OnlineTileProvider&)
+void TiledMapRenderer::onlineTileProviderChanged(const OnlineTileProvider &provider)
 {
     {
         QMutexLocker locker(&tileCacheMutex);
         onlineTileCache.invalidate();
+        onlineDiskCacheKey = diskCacheKey(QStringList() << QString::fromStdString(provider.getId()));
     }
     emit Redraw();
 }
@@ -548,6 +673,10 @@ void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osm
     loadJob->Close();
     loadJob->deleteLater();
     loadJob=nullptr;
+    {
+        QMutexLocker tileCacheLocker(&tileCacheMutex);
+        loadBox = osmscout::GeoBox();
+    }
 
     if (!success)  {
       osmscout::log.Error() << "*** Rendering of data has error or was interrupted";
@@ -563,8 +692,22 @@ void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osm
           osmscout::log.Warn() << "Rendered from outdated data" << loadEpoch << "!=" << offlineTileCache.getEpoch();
         }
 
+        // rendered tiles are stored to disk cache when they are still valid
+        // and don't contain overlay objects
+        bool storeToDisk = offlineDiskCache != nullptr &&
+                           !loadDiskCacheKey.isEmpty() &&
+                           loadEpoch == offlineTileCache.getEpoch();
+
+        auto putTile = [&](uint32_t x, uint32_t y, const QImage &tile){
+            offlineTileCache.put(loadZ.Get(), x, y, tile, loadEpoch);
+            offlineDiskCacheMisses.remove(TileCacheKey{loadZ.Get(), x, y});
+            if (storeToDisk && !intersectsOverlayObjects(loadZ.Get(), x, y)){
+                offlineDiskCache->requestStore(loadDiskCacheKey, loadZ.Get(), x, y, tile);
+            }
+        };
+
         if (width == 1 && height == 1){
-            offlineTileCache.put(loadZ.Get(), loadXFrom, loadYFrom, canvas, loadEpoch);
+            putTile(loadXFrom, loadYFrom, canvas);
         }else{
             for (uint32_t y = loadYFrom; y <= loadYTo; ++y){
                 for (uint32_t x = loadXFrom; x <= loadXTo; ++x){
@@ -575,7 +718,7 @@ void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osm
                             tileDimension, tileDimension
                             );
 
-                    offlineTileCache.put(loadZ.Get(), x, y, tile, loadEpoch);
+                    putTile(x, y, tile);
                 }
             }
         }
@@ -588,4 +731,171 @@ void TiledMapRenderer::onLoadJobFinished(QMap<QString,QMap<osmscout::TileKey,osm
     emit Redraw();
     //std::cout << "  put offline: " << loadZ << " xtile: " << xtile << " ytile: " << ytile << std::endl;
 }
+
+void TiledMapRenderer::onOfflineLoadOffScreen()
+{
+    QMutexLocker locker(&lock);
+    if (loadJob==nullptr){
+        // finished meanwhile
+        return;
+    }
+
+    {
+        QMutexLocker tileCacheLocker(&tileCacheMutex);
+        if (!loadCancelRequested){
+            return;
+        }
+        loadBox = osmscout::GeoBox();
+        loadCancelRequested = false;
+
+        // loading tiles may be requested again, when they become visible
+        for (uint32_t y = loadYFrom; y <= loadYTo; ++y){
+            for (uint32_t x = loadXFrom; x <= loadXTo; ++x){
+                offlineTileCache.removeRequest(loadZ.Get(), x, y);
+            }
+        }
+    }
+
+    // Close cancels the job future, job is skipped when it was not admitted
+    // by the DBThread yet, running data loading is interrupted by its breaker
+    disconnect(loadJob, nullptr, this, nullptr);
+    loadJob->Close();
+    loadJob->deleteLater();
+    loadJob=nullptr;
+
+    {
+        QMutexLocker tileCacheLocker(&tileCacheMutex);
+        offlineTileCache.reemitRequests();
+    }
+}
+
+void TiledMapRenderer::offlineDiskCacheLoaded(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, size_t epoch)
+{
+    {
+        QMutexLocker locker(&tileCacheMutex);
+        if (key != offlineDiskCacheKey){
+            // rendering parameters were changed meanwhile, tile will be requested again
+            offlineTileCache.removeRequest(zoomLevel, x, y);
+        }else{
+            // epoch was increased, but rendering parameters are the same
+            if (epoch != offlineTileCache.getEpoch() &&
+                offlineDiskCacheKeyEpoch == offlineTileCache.getEpoch() &&
+                !intersectsOverlayObjects(zoomLevel, x, y)){
+                epoch = offlineTileCache.getEpoch();
+            }
+            offlineTileCache.put(zoomLevel, x, y, image, epoch);
+            diskCacheHits++;
+        }
+    }
+    emit Redraw();
+}
+
+void TiledMapRenderer::offlineDiskCacheMissed(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t /*epoch*/)
+{
+    QMutexLocker locker(&tileCacheMutex);
+    offlineTileCache.removeRequest(zoomLevel, x, y);
+    if (key == offlineDiskCacheKey){
+        offlineDiskCacheMisses.insert(TileCacheKey{zoomLevel, x, y});
+    }
+    // request the tile again, it will be rendered
+    offlineTileCache.request(zoomLevel, x, y);
+}
+
+void TiledMapRenderer::onlineDiskCacheLoaded(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, QImage image, size_t epoch)
+{
+    {
+        QMutexLocker locker(&tileCacheMutex);
+        if (key != onlineDiskCacheKey){
+            // tile provider was changed meanwhile
+            onlineTileCache.removeRequest(zoomLevel, x, y);
+        }else{
+            onlineTileCache.put(zoomLevel, x, y, image, epoch);
+            diskCacheHits++;
+        }
+    }
+    emit Redraw();
+}
+
+void TiledMapRenderer::onlineDiskCacheMissed(QString key, uint32_t zoomLevel, uint32_t x, uint32_t y, size_t /*epoch*/)
+{
+    {
+        QMutexLocker locker(&tileCacheMutex);
+        if (key != onlineDiskCacheKey){
+            // tile provider was changed meanwhile
+            onlineTileCache.removeRequest(zoomLevel, x, y);
+            return;
+        }
+    }
+    downloadOnlineTile(zoomLevel, x, y);
+}
+
+/**
+ * Test if the tile or its neighbours intersects some overlay object.
+ * Overlay objects are rendered to offline tiles, such tiles can't be stored to disk cache.
+ * Neighbours are tested as well, because rendered object may overlap the tile boundary.
+ */
+bool TiledMapRenderer::intersectsOverlayObjects(uint32_t zoomLevel, uint32_t xtile, uint32_t ytile) const
+{
+    osmscout::GeoBox overlayBox = overlayObjectsBox();
+    if (!overlayBox.IsValid()){
+        return false;
+    }
+
+    uint32_t maxTile = (uint32_t(1) << zoomLevel) - 1;
+    osmscout::GeoBox box = OSMTile::tileBoundingBox(zoomLevel, xtile > 0 ? xtile - 1 : xtile, ytile > 0 ? ytile - 1 : ytile);
+    box.Include(OSMTile::tileBoundingBox(zoomLevel, std::min(xtile + 1, maxTile), std::min(ytile + 1, maxTile)));
+
+    return overlayBox.Intersects(box);
+}
+
+/**
+ * Compute key of offline disk cache from everything that affects rendered tiles.
+ * Empty string is returned when there is no database.
+ */
+QString TiledMapRenderer::computeOfflineDiskCacheKey()
+{
+    QStringList parameters;
+
+    dbThread->RunSynchronousJob(
+      [&parameters](const std::list<DBInstanceRef>& databases) {
+        for (const auto &db:databases){
+          QFileInfo typesFile(QDir(QString::fromStdString(db->path)).filePath(TypeConfig::FILE_TYPES_DAT));
+          parameters << typesFile.absoluteFilePath()
+                     << QString::number(typesFile.lastModified().toMSecsSinceEpoch());
+        }
+      }
+    );
+
+    if (parameters.isEmpty()){
+      return QString();
+    }
+
+    QFileInfo stylesheetFile(QString::fromStdString(dbThread->GetStylesheetFilename()));
+    parameters << stylesheetFile.absoluteFilePath()
+               << QString::number(stylesheetFile.lastModified().toMSecsSinceEpoch());
+    for (const auto &[flag, value]: dbThread->GetStyleFlags()){
+      parameters << QString("%1=%2").arg(QString::fromStdString(flag)).arg(value);
+    }
+
+    QMutexLocker locker(&lock);
+    double ratio = std::holds_alternative<ScreenPixelRatio>(this->pixelRatio) ?
+                   std::get<ScreenPixelRatio>(this->pixelRatio).ratio : std::get<FixedPixelRatio>(this->pixelRatio).ratio;
+    parameters << QString::number(mapDpi)
+               << QString::number(ratio)
+               << QString::number(renderSea)
+               << fontName
+               << QString::number(fontSize)
+               << QString::number(showAltLanguage)
+               << units
+               << QString::number(onlineTilesEnabled.load())
+               << QString::number(offlineTilesEnabled.load());
+
+    return diskCacheKey(parameters);
+}
+
+QString TiledMapRenderer::diskCacheKey(const QStringList &parameters)
+{
+    QByteArray hash = QCryptographicHash::hash(parameters.join('\n').toUtf8(), QCryptographicHash::Sha1);
+    return QString::fromLatin1(hash.toHex().left(16));
+}
 }
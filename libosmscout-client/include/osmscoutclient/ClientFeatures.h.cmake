@@ -1,4 +1,9 @@
 #ifndef LIBOSMSCOUT_CLIENTFEATURES_H
 #define LIBOSMSCOUT_CLIENTFEATURES_H
 
+#ifndef OSMSCOUT_CLIENT_HAVE_LIB_CURL
+/* libcurl is available, CurlHttpClient is part of the library */
+#cmakedefine OSMSCOUT_CLIENT_HAVE_LIB_CURL
+#endif
+
 #endif
@@ -0,0 +1,71 @@
+#ifndef OSMSCOUT_CLIENT_CURLHTTPCLIENT_H
+#define OSMSCOUT_CLIENT_CURLHTTPCLIENT_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscoutclient/ClientImportExport.h>
+
+#include <osmscoutclient/HttpClient.h>
+
+#include <string>
+
+namespace osmscout {
+
+/**
+ * \ingroup ClientAPI
+ *
+ * HttpClient implementation using libcurl. It is available only if
+ * libosmscout-client was built with libcurl (OSMSCOUT_CLIENT_HAVE_LIB_CURL).
+ *
+ * Every request uses its own curl handle, so all methods may be called
+ * from multiple threads in parallel. Range requests are supported, if
+ * the server announces them by "Accept-Ranges: bytes".
+ */
+class OSMSCOUT_CLIENT_API CurlHttpClient : public HttpClient
+{
+private:
+  std::string userAgent;
+  long connectTimeout; ///< connect timeout in seconds
+  long stallTimeout;   ///< request is aborted, if no data is received for this number of seconds
+
+public:
+  explicit CurlHttpClient(const std::string &userAgent = "libosmscout",
+                          long connectTimeout = 30,
+                          long stallTimeout = 60);
+
+  ~CurlHttpClient() override = default;
+
+  std::string Fetch(const std::string &url) override;
+
+  bool Download(const std::string &url,
+                const std::filesystem::path &dest,
+                ProgressCallback progress = nullptr) override;
+
+  uint64_t FetchContentLength(const std::string &url) override;
+
+  bool FetchRange(const std::string &url,
+                  uint64_t offset,
+                  uint64_t length,
+                  const DataCallback &data) override;
+};
+
+}
+
+#endif /* OSMSCOUT_CLIENT_CURLHTTPCLIENT_H */
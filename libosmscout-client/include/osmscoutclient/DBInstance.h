@@ -150,9 +150,14 @@ public:
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-lastUsage);
   }
 
+  /**
+   * Load the style sheet for this database. If styleCacheDirectory is not empty,
+   * the resolved style sheet is cached there (see StyleConfig::LoadCached).
+   */
   bool LoadStyle(const std::string &stylesheetFilename,
                  std::unordered_map<std::string,bool> stylesheetFlags,
-                 std::list<StyleError> &errors);
+                 std::list<StyleError> &errors,
+                 const std::string &styleCacheDirectory="");
 
   void Close();
 };
@@ -30,6 +30,7 @@
 #include <osmscout/async/Signal.h>
 #include <osmscout/async/AsyncWorker.h>
 #include <osmscout/async/ReadWriteLock.h>
+#include <osmscout/async/ThreadPool.h>
 
 #include <osmscoutmap/MapService.h>
 
@@ -37,10 +38,15 @@
 #include <osmscoutclient/Settings.h>
 #include <osmscoutclient/MapManager.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <shared_mutex>
 #include <filesystem>
 #include <map>
 #include <string>
+#include <thread>
 
 namespace osmscout {
 
@@ -88,6 +94,11 @@ enum class DatabaseCoverage{
  * readers at one time. DBThread warrants that none db will be closed
  * or modified (except thread-safe caches) when read lock is hold.
  * Databases may be accessed via \see AsynchronousDBJob or \see RunSynchronousJob methods.
+ *
+ * Read-only jobs may be submitted with a priority via \see SubmitJob. These are executed
+ * by a pool of worker threads, so a slow job (a search for example) doesn't delay
+ * more important ones (loading of visible tiles). Changes of the database list and
+ * of the style are still executed by the single DBThread worker.
  */
 class OSMSCOUT_CLIENT_API DBThread: public AsyncWorker
 {
@@ -99,11 +110,42 @@ public:
                                                 const std::list<DBInstanceRef> &databases,
                                                 ReadLock &&locker)>;
 
+  /**
+   * Job for SubmitJob. Long running jobs should poll the breaker and return early,
+   * when the job was canceled.
+   */
+  using PrioritizedDBJob = std::function<void (const std::list<DBInstanceRef> &databases,
+                                               const DBInstanceRef &basemapDatabase,
+                                               const Breaker &breaker)>;
+
+  /**
+   * Priority of jobs submitted via SubmitJob:
+   * High for visible map tiles, Normal for lookups, Low for prefetching and housekeeping
+   */
+  using JobPriority = ThreadPool::Priority;
+
+  /**
+   * Statistics of one finished (or canceled) job, see jobFinished
+   */
+  struct JobStatistics
+  {
+    JobPriority               priority=JobPriority::Normal;
+    size_t                    pendingJobs=0; //!< Number of jobs of the same priority still waiting
+    std::chrono::microseconds queueTime{0};  //!< Time between submission and start of the job
+    std::chrono::microseconds runTime{0};    //!< Execution time of the job
+    bool                      canceled=false;
+  };
+
   // signals
   Signal<> stylesheetFilenameChanged;
   Signal<osmscout::GeoBox> databaseLoadFinished;
   Signal<> styleErrorsChanged;
 
+  /**
+   * Emitted from the job worker thread for every job submitted via SubmitJob
+   */
+  Signal<JobStatistics> jobFinished;
+
   // slots
   Slot<> toggleDaylight{
     std::bind(&DBThread::ToggleDaylight, this)
@@ -155,6 +197,7 @@ private:
   StyleConfigRef                     emptyStyleConfig;
 
   std::string                        stylesheetFilename;
+  std::string                        styleCacheDirectory; //!< empty, if the resolved style sheet is not cached
   std::string                        iconDirectory;
   std::unordered_map<std::string,bool>
                                      stylesheetFlags;
@@ -170,6 +213,12 @@ private:
     }
   };
 
+  std::array<std::atomic<size_t>,3> pendingJobs{};
+
+  // pools have to be destroyed first, queued jobs are executed before
+  ThreadPool                         jobPool;
+  ThreadPool                         highPriorityJobPool; //!< reserved worker for high priority jobs
+
 protected:
 
   /**
@@ -192,7 +241,13 @@ protected:
 
   void registerCustomPoiTypes(TypeConfigRef typeConfig) const;
 
-  StyleConfigRef makeStyleConfig(TypeConfigRef typeConfig, bool suppressWarnings=false) const;
+  /**
+   * Create style config for the given type config. If databaseDirectory is given and the style
+   * cache directory is set, the resolved style sheet is cached.
+   */
+  StyleConfigRef makeStyleConfig(TypeConfigRef typeConfig,
+                                 bool suppressWarnings=false,
+                                 const std::string &databaseDirectory="") const;
 
   /**
    * Load basemap database, write lock needs to be hold
@@ -204,7 +259,8 @@ public:
            const std::string &iconDirectory,
            SettingsRef settings,
            MapManagerRef mapManager,
-           const std::vector<std::string> &customPoiTypes);
+           const std::vector<std::string> &customPoiTypes,
+           size_t jobThreadCount=std::max(std::thread::hardware_concurrency(),1u));
 
   ~DBThread() override;
 
@@ -250,6 +306,13 @@ public:
     return styleErrors;
   }
 
+  /**
+   * Cache the resolved style sheet of each database in the given directory,
+   * so that it does not have to be parsed on next start (see StyleConfig::LoadCached).
+   * Should be set before Initialize(). Empty directory disables the cache.
+   */
+  void SetStyleCacheDirectory(const std::string &directory);
+
   StyleConfigRef GetEmptyStyleConfig() const
   {
     ReadLock locker(latch);
@@ -289,6 +352,67 @@ public:
   void RunSynchronousJob(SynchronousDBJob job);
   void RunSynchronousJob(SynchronousDBJob2 job);
 
+  /**
+   * Submit read-only job with given priority. The job is executed by one of the job
+   * worker threads, database read lock is hold while it is running. Jobs with higher
+   * priority are started first. One worker is reserved for jobs with high priority,
+   * so they are started immediately, even when all other workers are busy with
+   * long running jobs.
+   *
+   * Canceling the returned future skips the job, if it was not started yet.
+   * A running job is signaled by its breaker.
+   *
+   * Example:
+   * ```
+   * auto future=dbThread->SubmitJob(
+   *   [&](const std::list<DBInstanceRef> &databases, const DBInstanceRef &basemap, const Breaker &breaker){
+   *     // read data from databases, until breaker is aborted...
+   *   },
+   *   DBThread::JobPriority::High
+   * );
+   * ...
+   * future.Cancel(); // result is not required anymore
+   * ```
+   *
+   * @param job
+   * @param priority
+   * @return future with true, if the job was executed completely,
+   *   false if databases are not initialized or job was aborted
+   */
+  CancelableFuture<bool> SubmitJob(PrioritizedDBJob job,
+                                   JobPriority priority=JobPriority::Normal);
+
+  /**
+   * Submit read-only job with given priority (see \see SubmitJob) and block until
+   * it is finished. When the given breaker is aborted, the job is skipped if it was not
+   * started yet, a running job is signaled by its breaker. The method returns after
+   * the job is finished or skipped in any case, so the job may access variables
+   * of the caller safely.
+   *
+   * It must not be called from a job, it would block the job worker.
+   *
+   * @param job
+   * @param priority
+   * @param breaker optional breaker of the caller, may be nullptr
+   * @return true, if the job was executed completely
+   */
+  bool RunSynchronousJob(PrioritizedDBJob job,
+                         JobPriority priority,
+                         const Breaker *breaker=nullptr);
+
+  /**
+   * Return the number of submitted jobs with given priority, that were not started yet
+   */
+  size_t GetPendingJobCount(JobPriority priority) const
+  {
+    return pendingJobs[size_t(priority)];
+  }
+
+  size_t GetJobThreadCount() const
+  {
+    return jobPool.GetThreadCount();
+  }
+
   /**
    * Reload the basemap database from the configured lookup directory.
    *
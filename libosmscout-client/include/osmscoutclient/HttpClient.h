@@ -22,6 +22,7 @@
 
 #include <osmscoutclient/ClientImportExport.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <string>
@@ -39,6 +40,17 @@ namespace osmscout {
  */
 using ProgressCallback = std::function<bool(uint64_t bytesDownloaded, uint64_t totalBytes)>;
 
+/**
+ * \ingroup ClientAPI
+ *
+ * Callback receiving the response body piece by piece.
+ *
+ * @param data pointer to the received bytes
+ * @param size number of received bytes
+ * @return true to continue, false to cancel
+ */
+using DataCallback = std::function<bool(const char *data, size_t size)>;
+
 /**
  * \ingroup ClientAPI
  *
@@ -76,6 +88,43 @@ public:
   virtual bool Download(const std::string &url,
                         const std::filesystem::path &dest,
                         ProgressCallback progress = nullptr) = 0;
+
+  /**
+   * Return the size of the resource in bytes (HTTP HEAD request),
+   * if the server supports range requests for it.
+   *
+   * The default implementation returns 0, so that callers fall back
+   * to Download.
+   *
+   * @param url the URL to query
+   * @return size in bytes, 0 if unknown or range requests are not supported
+   */
+  virtual uint64_t FetchContentLength([[maybe_unused]] const std::string &url)
+  {
+    return 0;
+  }
+
+  /**
+   * Fetch the given byte range of the resource (HTTP range request).
+   * Received data is passed to the callback as it arrives.
+   * If the callback returns false, the request SHOULD be cancelled.
+   *
+   * Implementations MUST be thread-safe, multiple ranges of the same
+   * resource may be requested in parallel.
+   *
+   * @param url    the URL to fetch
+   * @param offset first byte of the range
+   * @param length number of bytes in the range
+   * @param data   callback receiving the data
+   * @return true, if the complete range was received
+   */
+  virtual bool FetchRange([[maybe_unused]] const std::string &url,
+                          [[maybe_unused]] uint64_t offset,
+                          [[maybe_unused]] uint64_t length,
+                          [[maybe_unused]] const DataCallback &data)
+  {
+    return false;
+  }
 };
 
 }
@@ -40,6 +40,7 @@ class OSMSCOUT_CLIENT_API MapDirectory
 public:
   static constexpr char const *FileMetadata = "metadata.json";
   static constexpr char const *TemporaryFileSuffix = ".download"; ///< suffix of file being downloaded
+  static constexpr char const *ResumeStateSuffix = ".state"; ///< suffix of resume state of file being downloaded, appended to TemporaryFileSuffix
 
 public:
   MapDirectory() = default;
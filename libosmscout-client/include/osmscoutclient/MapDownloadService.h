@@ -57,6 +57,17 @@ struct OSMSCOUT_CLIENT_API DownloadJobState
   bool successful{false};
 };
 
+/**
+ * \ingroup ClientAPI
+ *
+ * Parameters of chunked map downloads.
+ */
+struct OSMSCOUT_CLIENT_API MapDownloadParameter
+{
+  size_t maxConnections{4};        ///< maximum number of parallel requests to the map server
+  uint64_t chunkSize{4*1024*1024}; ///< size of one range request, 0 disables chunked downloads
+};
+
 /**
  * \ingroup ClientAPI
  *
@@ -64,6 +75,13 @@ struct OSMSCOUT_CLIENT_API DownloadJobState
  * Runs on its own worker thread via AsyncWorker.
  * Uses the abstract HttpClient interface so no HTTP library dependency
  * is added to the core library.
+ *
+ * When the HttpClient supports range requests, database files are downloaded
+ * in chunks over multiple parallel connections. Completed chunks and their CRC-32
+ * checksums are recorded in a resume state file next to the partial file,
+ * so an interrupted download continues where it stopped. Chunks of a partial file
+ * are verified against the recorded checksums before resuming.
+ * A download cancelled by the user is removed completely.
  */
 class OSMSCOUT_CLIENT_API MapDownloadService : public AsyncWorker
 {
@@ -110,7 +128,8 @@ public:
       const std::filesystem::path &targetDir,
       HttpClient &httpClient,
       MapManagerRef mapManager,
-      const std::function<void(uint64_t, uint64_t)> &progress = {});
+      const std::function<void(uint64_t, uint64_t)> &progress = {},
+      const MapDownloadParameter &parameter = MapDownloadParameter());
 
   /**
    * Download a map to the specified directory.
@@ -127,6 +146,12 @@ public:
       HttpClient &httpClient,
       const std::function<void(uint64_t, uint64_t)> &progress = {});
 
+  /**
+   * Set parameters of chunked downloads for following calls of DownloadMap.
+   * Thread-safe.
+   */
+  void SetDownloadParameter(const MapDownloadParameter &parameter);
+
   /**
    * Cancel a running download by target directory.
    *
@@ -177,6 +202,7 @@ private:
 
   mutable std::mutex jobsMutex;
   std::vector<DownloadJobState> jobs;
+  MapDownloadParameter parameter;
 
   /**
    * Internal download implementation.
@@ -188,7 +214,20 @@ private:
                                   const std::filesystem::path &targetDir,
                                   HttpClient &httpClient,
                                   Breaker &breaker,
+                                  const MapDownloadParameter &parameter,
                                   const std::function<void(uint64_t, uint64_t)> &progress = {});
+
+  /**
+   * Download one file to tempPath. Uses parallel range requests, if supported
+   * by the HttpClient, and resumes a previous partial download.
+   * Progress callback is called with bytes of this file, calls are serialized.
+   */
+  static bool DownloadFile(HttpClient &httpClient,
+                           const std::string &url,
+                           const std::filesystem::path &tempPath,
+                           const MapDownloadParameter &parameter,
+                           Breaker &breaker,
+                           const ProgressCallback &progress);
 };
 
 /**
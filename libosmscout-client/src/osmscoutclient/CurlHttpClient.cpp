@@ -0,0 +1,259 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+ */
+
+#include <osmscoutclient/CurlHttpClient.h>
+
+#include <osmscout/log/Logger.h>
+#include <osmscout/util/String.h>
+
+#include <curl/curl.h>
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace osmscout {
+
+namespace {
+
+struct CurlDeleter
+{
+  void operator()(CURL *curl) const
+  {
+    curl_easy_cleanup(curl);
+  }
+};
+
+using CurlHandle = std::unique_ptr<CURL, CurlDeleter>;
+
+size_t WriteString(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+  static_cast<std::string*>(userdata)->append(ptr, size * nmemb);
+  return size * nmemb;
+}
+
+size_t WriteFile(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+  auto *ofs = static_cast<std::ofstream*>(userdata);
+  ofs->write(ptr, static_cast<std::streamsize>(size * nmemb));
+  return ofs->good() ? size * nmemb : 0;
+}
+
+int DownloadProgress(void *clientp,
+                     curl_off_t dltotal,
+                     curl_off_t dlnow,
+                     [[maybe_unused]] curl_off_t ultotal,
+                     [[maybe_unused]] curl_off_t ulnow)
+{
+  const auto *progress = static_cast<const ProgressCallback*>(clientp);
+  return (*progress)(static_cast<uint64_t>(dlnow), static_cast<uint64_t>(dltotal)) ? 0 : 1;
+}
+
+/**
+ * Checks the headers of the final response (after redirects) for range support
+ */
+size_t AcceptRangesHeader(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+  auto *acceptRanges = static_cast<bool*>(userdata);
+  std::string header = UTF8StringToLower(std::string(buffer, size * nitems));
+
+  if (header.rfind("http/", 0) == 0) {
+    *acceptRanges = false;
+  } else if (header.rfind("accept-ranges:", 0) == 0) {
+    *acceptRanges = header.find("bytes") != std::string::npos;
+  }
+
+  return size * nitems;
+}
+
+struct RangeRequest
+{
+  CURL *curl;
+  const DataCallback &data;
+  uint64_t received{0};
+};
+
+size_t WriteRange(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+  auto *request = static_cast<RangeRequest*>(userdata);
+
+  // A server ignoring the range would send the whole resource
+  long responseCode = 0;
+  curl_easy_getinfo(request->curl, CURLINFO_RESPONSE_CODE, &responseCode);
+  if (responseCode != 206) {
+    return 0;
+  }
+
+  if (!request->data(ptr, size * nmemb)) {
+    return 0;
+  }
+
+  request->received += size * nmemb;
+  return size * nmemb;
+}
+
+CurlHandle CreateHandle(const std::string &url,
+                        const std::string &userAgent,
+                        long connectTimeout,
+                        long stallTimeout)
+{
+  CurlHandle curl(curl_easy_init());
+  if (!curl) {
+    osmscout::log.Error() << "Cannot create curl handle";
+    return curl;
+  }
+
+  curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl.get(), CURLOPT_USERAGENT, userAgent.c_str());
+  curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
+  curl_easy_setopt(curl.get(), CURLOPT_FAILONERROR, 1L);
+  curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1L); // handles are used by multiple threads
+  curl_easy_setopt(curl.get(), CURLOPT_CONNECTTIMEOUT, connectTimeout);
+  curl_easy_setopt(curl.get(), CURLOPT_LOW_SPEED_LIMIT, 1L);
+  curl_easy_setopt(curl.get(), CURLOPT_LOW_SPEED_TIME, stallTimeout);
+
+  return curl;
+}
+
+bool Perform(const CurlHandle &curl, const std::string &url)
+{
+  CURLcode result = curl_easy_perform(curl.get());
+  if (result != CURLE_OK) {
+    osmscout::log.Warn() << "Request " << url << " failed: " << curl_easy_strerror(result);
+    return false;
+  }
+
+  return true;
+}
+
+}
+
+CurlHttpClient::CurlHttpClient(const std::string &userAgent,
+                               long connectTimeout,
+                               long stallTimeout)
+  : userAgent(userAgent)
+  , connectTimeout(connectTimeout)
+  , stallTimeout(stallTimeout)
+{
+  static std::once_flag globalInit;
+  std::call_once(globalInit, []() {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+  });
+}
+
+std::string CurlHttpClient::Fetch(const std::string &url)
+{
+  CurlHandle curl = CreateHandle(url, userAgent, connectTimeout, stallTimeout);
+  if (!curl) {
+    return "";
+  }
+
+  std::string body;
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, WriteString);
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &body);
+
+  if (!Perform(curl, url)) {
+    return "";
+  }
+
+  return body;
+}
+
+bool CurlHttpClient::Download(const std::string &url,
+                              const std::filesystem::path &dest,
+                              ProgressCallback progress)
+{
+  CurlHandle curl = CreateHandle(url, userAgent, connectTimeout, stallTimeout);
+  if (!curl) {
+    return false;
+  }
+
+  std::ofstream ofs(dest, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    osmscout::log.Error() << "Cannot create " << dest.string();
+    return false;
+  }
+
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, WriteFile);
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &ofs);
+  if (progress) {
+    curl_easy_setopt(curl.get(), CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl.get(), CURLOPT_XFERINFOFUNCTION, DownloadProgress);
+    curl_easy_setopt(curl.get(), CURLOPT_XFERINFODATA, &progress);
+  }
+
+  if (!Perform(curl, url)) {
+    return false;
+  }
+
+  ofs.close();
+  return ofs.good();
+}
+
+uint64_t CurlHttpClient::FetchContentLength(const std::string &url)
+{
+  CurlHandle curl = CreateHandle(url, userAgent, connectTimeout, stallTimeout);
+  if (!curl) {
+    return 0;
+  }
+
+  bool acceptRanges = false;
+  curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+  curl_easy_setopt(curl.get(), CURLOPT_HEADERFUNCTION, AcceptRangesHeader);
+  curl_easy_setopt(curl.get(), CURLOPT_HEADERDATA, &acceptRanges);
+
+  if (!Perform(curl, url) || !acceptRanges) {
+    return 0;
+  }
+
+  curl_off_t length = -1;
+  if (curl_easy_getinfo(curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) != CURLE_OK ||
+      length <= 0) {
+    return 0;
+  }
+
+  return static_cast<uint64_t>(length);
+}
+
+bool CurlHttpClient::FetchRange(const std::string &url,
+                                uint64_t offset,
+                                uint64_t length,
+                                const DataCallback &data)
+{
+  if (length == 0) {
+    return true;
+  }
+
+  CurlHandle curl = CreateHandle(url, userAgent, connectTimeout, stallTimeout);
+  if (!curl) {
+    return false;
+  }
+
+  std::string range = std::to_string(offset) + "-" + std::to_string(offset + length - 1);
+  RangeRequest request{curl.get(), data};
+
+  curl_easy_setopt(curl.get(), CURLOPT_RANGE, range.c_str());
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, WriteRange);
+  curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &request);
+
+  return Perform(curl, url) &&
+         request.received == length;
+}
+
+}
@@ -27,7 +27,8 @@ namespace osmscout {
 
 bool DBInstance::LoadStyle(const std::string &stylesheetFilename,
                            std::unordered_map<std::string,bool> stylesheetFlags,
-                           std::list<StyleError> &errors)
+                           std::list<StyleError> &errors,
+                           const std::string &styleCacheDirectory)
 {
   std::scoped_lock lock(mutex);
 
@@ -51,7 +52,20 @@ bool DBInstance::LoadStyle(const std::string &stylesheetFilename,
     newStyleConfig->AddFlag(flag.first,flag.second);
   }
 
-  if (newStyleConfig->Load(stylesheetFilename, nullptr, false)) {
+  bool loaded;
+
+  if (styleCacheDirectory.empty()) {
+    loaded=newStyleConfig->Load(stylesheetFilename, nullptr, false);
+  }
+  else {
+    loaded=newStyleConfig->LoadCached(stylesheetFilename,
+                                      StyleConfig::GetCacheFileName(styleCacheDirectory,
+                                                                    path,
+                                                                    stylesheetFilename,
+                                                                    stylesheetFlags));
+  }
+
+  if (loaded) {
     // Recreate
     styleConfig=newStyleConfig;
 
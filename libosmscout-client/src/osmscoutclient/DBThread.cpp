@@ -18,6 +18,12 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
  */
 
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+
 #include <osmscoutmap/MapService.h>
 
 #include <osmscoutclient/DBThread.h>
@@ -31,11 +37,48 @@
 
 namespace osmscout {
 
+namespace {
+/**
+ * Breaker of a synchronous job, aborted when the job is canceled or the caller is aborted
+ */
+class CombinedBreaker: public Breaker
+{
+private:
+  const Breaker &jobBreaker;
+  const Breaker &callerBreaker;
+
+public:
+  CombinedBreaker(const Breaker &jobBreaker,
+                  const Breaker &callerBreaker):
+    jobBreaker(jobBreaker),
+    callerBreaker(callerBreaker)
+  {
+    // no code
+  }
+
+  void Break() override
+  {
+    log.Warn() << "Combined breaker doesn't support break.";
+  }
+
+  bool IsAborted() const override
+  {
+    return jobBreaker.IsAborted() || callerBreaker.IsAborted();
+  }
+
+  void Reset() override
+  {
+    log.Warn() << "Combined breaker doesn't support reset.";
+  }
+};
+}
+
 DBThread::DBThread(const std::string &basemapLookupDirectory,
                    const std::string &iconDirectory,
                    SettingsRef settings,
                    MapManagerRef mapManager,
-                   const std::vector<std::string> &customPoiTypes)
+                   const std::vector<std::string> &customPoiTypes,
+                   size_t jobThreadCount)
   : AsyncWorker("DBThread"),
     mapManager(mapManager),
     basemapLookupDirectory(basemapLookupDirectory),
@@ -43,7 +86,9 @@ DBThread::DBThread(const std::string &basemapLookupDirectory,
     mapDpi(-1),
     iconDirectory(iconDirectory),
     daylight(true),
-    customPoiTypes(customPoiTypes)
+    customPoiTypes(customPoiTypes),
+    jobPool(jobThreadCount,"DBJob"),
+    highPriorityJobPool(1,"DBJobHigh")
 {
   double physicalDpi = settings->GetPhysicalDPI();
   osmscout::log.Debug() << "Reported screen DPI: " << physicalDpi;
@@ -285,7 +330,7 @@ CancelableFuture<bool> DBThread::OnDatabaseListChanged(const std::vector<std::fi
 
         if (typeConfig) {
           registerCustomPoiTypes(typeConfig);
-          styleConfig=makeStyleConfig(typeConfig);
+          styleConfig=makeStyleConfig(typeConfig, false, databaseDirectory.string());
         }
         else {
           log.Warn() << "TypeConfig invalid!";
@@ -340,7 +385,9 @@ void DBThread::registerCustomPoiTypes(osmscout::TypeConfigRef typeConfig) const
   }
 }
 
-StyleConfigRef DBThread::makeStyleConfig(TypeConfigRef typeConfig, bool suppressWarnings) const
+StyleConfigRef DBThread::makeStyleConfig(TypeConfigRef typeConfig,
+                                         bool suppressWarnings,
+                                         const std::string &databaseDirectory) const
 {
   osmscout::StyleConfigRef styleConfig=std::make_shared<osmscout::StyleConfig>(typeConfig);
 
@@ -354,7 +401,22 @@ StyleConfigRef DBThread::makeStyleConfig(TypeConfigRef typeConfig, bool suppress
     log.Warn(false);
   }
 
-  if (!styleConfig->Load(stylesheetFilename, nullptr, false, log)) {
+  bool loaded;
+
+  if (styleCacheDirectory.empty() || databaseDirectory.empty()) {
+    loaded=styleConfig->Load(stylesheetFilename, nullptr, false, log);
+  }
+  else {
+    loaded=styleConfig->LoadCached(stylesheetFilename,
+                                   StyleConfig::GetCacheFileName(styleCacheDirectory,
+                                                                 databaseDirectory,
+                                                                 stylesheetFilename,
+                                                                 stylesheetFlags),
+                                   nullptr,
+                                   log);
+  }
+
+  if (!loaded) {
     log.Warn() << "Cannot load style sheet '" << stylesheetFilename << "'!";
     styleConfig=nullptr;
   }
@@ -429,6 +491,24 @@ CancelableFuture<bool> DBThread::LoadStyle(const std::string &stylesheetFilename
   });
 }
 
+void DBThread::SetStyleCacheDirectory(const std::string &directory)
+{
+  WriteLock locker(latch);
+
+  if (!directory.empty()) {
+    std::error_code error;
+
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+      log.Warn() << "Cannot create style cache directory '" << directory << "': " << error.message();
+      styleCacheDirectory.clear();
+      return;
+    }
+  }
+
+  styleCacheDirectory=directory;
+}
+
 void DBThread::LoadStyleInternal(const std::string &stylesheetFilename,
                                  const std::unordered_map<std::string,bool> &stylesheetFlags,
                                  const std::string &suffix)
@@ -443,12 +523,12 @@ void DBThread::LoadStyleInternal(const std::string &stylesheetFilename,
   std::string file = stylesheetFilename+suffix;
   for (const auto& db: databases){
     log.Debug() << "Loading style " << file << " for database " << db->path << "...";
-    db->LoadStyle(file, stylesheetFlags, styleErrors);
+    db->LoadStyle(file, stylesheetFlags, styleErrors, styleCacheDirectory);
     log.Debug() << "Loading style done";
   }
   if (basemapDatabase) {
     log.Debug() << "Loading style " << file << " for database " << basemapDatabase->path << "...";
-    basemapDatabase->LoadStyle(file, stylesheetFlags, styleErrors);
+    basemapDatabase->LoadStyle(file, stylesheetFlags, styleErrors, styleCacheDirectory);
     log.Debug() << "Loading style done";
   }
   if (prevErrs || (!styleErrors.empty())){
@@ -488,34 +568,23 @@ CancelableFuture<bool> DBThread::FlushCaches(const std::chrono::milliseconds &id
 {
   flushCachesSignal.Emit(idleMs);
 
-  return Async<bool>([this, idleMs](const Breaker& breaker) {
-    if (breaker.IsAborted()) {
-      return false;
-    }
-    bool result=true;
-    RunSynchronousJob([&](const std::list<DBInstanceRef> &dbs, const DBInstanceRef baseMap){
-      if (breaker.IsAborted()) {
-        result = false;
-        return;
+  return SubmitJob([idleMs](const std::list<DBInstanceRef> &dbs, const DBInstanceRef &baseMap, const Breaker &breaker){
+    auto Flush=[&](const auto &db){
+      if (db && !breaker.IsAborted() && db->LastUsageMs() > idleMs){
+        auto database=db->GetDatabase();
+        log.Debug() << "Flushing caches for " << database->GetPath();
+        database->DumpStatistics();
+        database->FlushCache();
+        db->GetMapService()->FlushTileCache();
       }
+    };
 
-      auto Flush=[&](const auto &db){
-        if (db && db->LastUsageMs() > idleMs){
-          auto database=db->GetDatabase();
-          log.Debug() << "Flushing caches for " << database->GetPath();
-          database->DumpStatistics();
-          database->FlushCache();
-          db->GetMapService()->FlushTileCache();
-        }
-      };
-
-      for (const auto &db:dbs){
-        Flush(db);
-      }
-      Flush(baseMap);
-    });
-    return result;
-  });
+    for (const auto &db:dbs){
+      Flush(db);
+    }
+    Flush(baseMap);
+  },
+  JobPriority::Low);
 }
 
 void DBThread::RunJob(AsynchronousDBJob job)
@@ -549,6 +618,97 @@ void DBThread::RunSynchronousJob(SynchronousDBJob2 job)
   job(databases, basemapDatabase);
 }
 
+CancelableFuture<bool> DBThread::SubmitJob(PrioritizedDBJob job,
+                                          JobPriority priority)
+{
+  using Clock = std::chrono::steady_clock;
+
+  CancelableFuture<bool>::Promise promise;
+  auto breaker=std::make_shared<CancelableFuture<bool>::FutureBreaker>(promise.Breaker());
+  auto submitted=Clock::now();
+  auto &pending=pendingJobs[size_t(priority)];
+
+  pending++;
+
+  // breaker is not passed to the pool, canceled jobs are accounted in statistics as well
+  auto task=std::make_shared<std::function<void()>>([this, job=std::move(job), priority, promise, breaker, submitted, &pending]() mutable {
+    JobStatistics statistics;
+    auto started=Clock::now();
+
+    pending--;
+    statistics.priority=priority;
+    statistics.pendingJobs=pending;
+    statistics.queueTime=std::chrono::duration_cast<std::chrono::microseconds>(started-submitted);
+
+    bool executed=false;
+    if (!breaker->IsAborted()) {
+      ReadLock locker(latch);
+      if (isInitializedInternal()) {
+        job(databases, basemapDatabase, *breaker);
+        executed=!breaker->IsAborted();
+      }
+      else {
+        osmscout::log.Warn() << "ignore request, dbs is not initialized";
+      }
+    }
+
+    statistics.runTime=std::chrono::duration_cast<std::chrono::microseconds>(Clock::now()-started);
+    statistics.canceled=breaker->IsAborted();
+
+    jobFinished.Emit(statistics);
+    promise.SetValue(executed);
+  });
+
+  // High priority jobs are queued for the reserved worker as well,
+  // the worker that takes the job first executes it
+  auto claimed=std::make_shared<std::atomic<bool>>(false);
+  auto claim=[task, claimed]() {
+    if (!claimed->exchange(true)) {
+      (*task)();
+    }
+  };
+
+  jobPool.Submit(claim, priority);
+
+  if (priority==JobPriority::High) {
+    highPriorityJobPool.Submit(claim, priority);
+  }
+
+  return promise.Future();
+}
+
+bool DBThread::RunSynchronousJob(PrioritizedDBJob job,
+                                 JobPriority priority,
+                                 const Breaker *breaker)
+{
+  if (breaker!=nullptr && breaker->IsAborted()) {
+    return false;
+  }
+
+  // The future is not passed to anybody else, so it is never canceled and its value
+  // is set, when the job is finished or skipped
+  auto future=SubmitJob([&job, breaker](const std::list<DBInstanceRef> &databases,
+                                        const DBInstanceRef &basemapDatabase,
+                                        const Breaker &jobBreaker) {
+    if (breaker==nullptr) {
+      job(databases, basemapDatabase, jobBreaker);
+      return;
+    }
+
+    if (breaker->IsAborted()) {
+      return;
+    }
+
+    CombinedBreaker combinedBreaker(jobBreaker, *breaker);
+    job(databases, basemapDatabase, combinedBreaker);
+  },
+  priority);
+
+  bool executed=future.StdFuture().get();
+
+  return executed && (breaker==nullptr || !breaker->IsAborted());
+}
+
 void DBThread::LoadBasemap()
 {
   if (basemapDatabase) {
@@ -565,7 +725,7 @@ void DBThread::LoadBasemap()
       osmscout::StyleConfigRef styleConfig;
       if (typeConfig) {
         registerCustomPoiTypes(typeConfig);
-        styleConfig=makeStyleConfig(typeConfig);
+        styleConfig=makeStyleConfig(typeConfig, false, basemapLookupDirectory);
       }
       else {
         log.Warn() << "TypeConfig invalid!";
@@ -112,7 +112,9 @@ std::vector<std::string> MapDirectory::OptionalFiles(){
     "textother.dat",
     "textpoi.dat",
     "textregion.dat",
-    "coverage.idx"
+    "coverage.idx",
+    "locationngram.idx",
+    "terrain.dat"
   }};
 }
 
@@ -156,6 +158,10 @@ bool MapDirectory::DeleteDatabase()
         if (std::filesystem::exists(tempFileName)) {
           result &= RemoveFile(tempFileName);
         }
+        if (std::string stateFileName = tempFileName + MapDirectory::ResumeStateSuffix;
+            std::filesystem::exists(stateFileName)) {
+          result &= RemoveFile(stateFileName);
+        }
       }
     }
   };
@@ -24,12 +24,145 @@
 #include <osmscout/TypeConfig.h>
 #include <osmscout/log/Logger.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <fstream>
+#include <optional>
 #include <set>
+#include <thread>
 
 namespace osmscout {
 
+namespace {
+
+/**
+ * CRC-32 (IEEE 802.3) of the data, continuing the given crc
+ */
+uint32_t UpdateCRC32(uint32_t crc, const char *data, size_t size)
+{
+  static const std::array<uint32_t, 256> table = [](){
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t value = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+      }
+      t[i] = value;
+    }
+    return t;
+  }();
+
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+/**
+ * Resume state of a chunked file download, stored as json next to the partial file.
+ */
+struct ResumeState
+{
+  std::string url;
+  uint64_t size{0};
+  uint64_t chunkSize{0};
+  std::vector<std::optional<uint32_t>> checksums; ///< CRC-32 of completed chunks
+
+  bool Load(const std::filesystem::path &path)
+  {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+      return false;
+    }
+
+    try {
+      auto json = nlohmann::json::parse(ifs);
+      url = json.at("url").get<std::string>();
+      size = json.at("size").get<uint64_t>();
+      chunkSize = json.at("chunkSize").get<uint64_t>();
+      checksums.clear();
+      for (const auto &checksum : json.at("checksums")) {
+        if (checksum.is_null()) {
+          checksums.emplace_back();
+        } else {
+          checksums.emplace_back(checksum.get<uint32_t>());
+        }
+      }
+    } catch (const nlohmann::json::exception &e) {
+      osmscout::log.Warn() << "Cannot parse download state " << path.string() << ": " << e.what();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool Save(const std::filesystem::path &path) const
+  {
+    nlohmann::json json;
+    json["url"] = url;
+    json["size"] = size;
+    json["chunkSize"] = chunkSize;
+    json["checksums"] = nlohmann::json::array();
+    for (const auto &checksum : checksums) {
+      if (checksum) {
+        json["checksums"].push_back(checksum.value());
+      } else {
+        json["checksums"].push_back(nullptr);
+      }
+    }
+
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs.is_open()) {
+      return false;
+    }
+    ofs << json.dump();
+    return ofs.good();
+  }
+};
+
+nlohmann::json MetadataJson(const AvailableMapEntry &entry)
+{
+  nlohmann::json metadata;
+  metadata["name"] = entry.GetName();
+  {
+    std::string pathStr;
+    for (size_t i = 0; i < entry.GetPath().size(); ++i) {
+      if (i > 0) pathStr += "/";
+      pathStr += entry.GetPath()[i];
+    }
+    metadata["map"] = pathStr;
+  }
+  metadata["version"] = entry.GetVersion();
+  metadata["creation"] = std::chrono::duration_cast<std::chrono::seconds>(
+      entry.GetCreation().time_since_epoch()).count();
+
+  return metadata;
+}
+
+nlohmann::json ReadMetadataJson(const std::filesystem::path &path)
+{
+  std::ifstream ifs(path);
+  if (!ifs.is_open()) {
+    return {};
+  }
+
+  try {
+    return nlohmann::json::parse(ifs);
+  } catch (const nlohmann::json::exception &) {
+    return {};
+  }
+}
+
+std::filesystem::path ResumeStatePath(const std::filesystem::path &tempPath)
+{
+  return tempPath.string() + MapDirectory::ResumeStateSuffix;
+}
+
+}
+
 MapDownloadService::MapDownloadService(MapManagerRef mapManager,
                                          SettingsRef settings)
   : AsyncWorker("MapDownloadService")
@@ -86,13 +219,14 @@ bool MapDownloadService::DownloadMapSync(
     const std::filesystem::path &targetDir,
     HttpClient &httpClient,
     MapManagerRef mapManager,
-    const std::function<void(uint64_t, uint64_t)> &progress)
+    const std::function<void(uint64_t, uint64_t)> &progress,
+    const MapDownloadParameter &parameter)
 {
   std::vector<DownloadJobState> jobs;
   std::mutex jobsMutex;
   osmscout::ThreadedBreaker breaker;
   return DownloadMapInternal(jobs, jobsMutex, mapManager,
-                             entry, targetDir, httpClient, breaker, progress);
+                             entry, targetDir, httpClient, breaker, parameter, progress);
 }
 
 CancelableFuture<bool> MapDownloadService::DownloadMap(
@@ -101,13 +235,25 @@ CancelableFuture<bool> MapDownloadService::DownloadMap(
     HttpClient &httpClient,
     const std::function<void(uint64_t, uint64_t)> &progress)
 {
+  MapDownloadParameter downloadParameter;
+  {
+    std::unique_lock<std::mutex> lock(jobsMutex);
+    downloadParameter = parameter;
+  }
+
   return Async<bool>(
-      [this, entry, targetDir, &httpClient, &progress](Breaker &breaker) -> bool {
+      [this, entry, targetDir, &httpClient, &progress, downloadParameter](Breaker &breaker) -> bool {
         return DownloadMapInternal(jobs, jobsMutex, mapManager,
-                                   entry, targetDir, httpClient, breaker, progress);
+                                   entry, targetDir, httpClient, breaker, downloadParameter, progress);
       });
 }
 
+void MapDownloadService::SetDownloadParameter(const MapDownloadParameter &parameter)
+{
+  std::unique_lock<std::mutex> lock(jobsMutex);
+  this->parameter = parameter;
+}
+
 void MapDownloadService::CancelDownload(const std::filesystem::path &targetDir)
 {
   std::unique_lock<std::mutex> lock(jobsMutex);
@@ -134,6 +280,7 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
                                              const std::filesystem::path &targetDir,
                                              HttpClient &httpClient,
                                              Breaker &breaker,
+                                             const MapDownloadParameter &parameter,
                                              const std::function<void(uint64_t, uint64_t)> &progress)
 {
   if (entry.IsDirectory()) {
@@ -170,42 +317,32 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
     return false;
   }
 
-  // Check for existing partial download — clean up if needed
+  // Check for existing partial download
   // Only check if directory has metadata file (indicates previous download attempt)
   std::string dirStr = targetDir.string();
   std::string metaPathStr = dirStr + "/" + MapDirectory::FileMetadata;
   bool hasMetaFile = std::filesystem::exists(metaPathStr);
+  nlohmann::json metadata = MetadataJson(entry);
+  bool resume = false;
   if (hasMetaFile) {
-    // Partial download exists — clean it up by removing all files
-    for (const auto &f : MapDirectory::MandatoryFiles()) {
-      std::string fp = dirStr + "/" + f;
-      std::string tp = dirStr + "/" + f + MapDirectory::TemporaryFileSuffix;
-      remove(fp.c_str());
-      remove(tp.c_str());
-    }
-    for (const auto &f : MapDirectory::OptionalFiles()) {
-      std::string fp = dirStr + "/" + f;
-      std::string tp = dirStr + "/" + f + MapDirectory::TemporaryFileSuffix;
-      remove(fp.c_str());
-      remove(tp.c_str());
+    // Partial download of the same map version is resumed, otherwise clean it up
+    resume = ReadMetadataJson(metaPathStr) == metadata;
+    if (resume) {
+      osmscout::log.Info() << "Resuming download of map " << entry.GetName() << " to " << dirStr;
+    } else {
+      for (const auto &f : MapDownloadService::MapFiles()) {
+        std::string fp = dirStr + "/" + f;
+        std::string tp = dirStr + "/" + f + MapDirectory::TemporaryFileSuffix;
+        std::string sp = tp + MapDirectory::ResumeStateSuffix;
+        remove(fp.c_str());
+        remove(tp.c_str());
+        remove(sp.c_str());
+      }
+      remove(metaPathStr.c_str());
     }
-    remove(metaPathStr.c_str());
   }
 
   // Write metadata.json first (marks this as a download in progress)
-  nlohmann::json metadata;
-  metadata["name"] = entry.GetName();
-  {
-    std::string pathStr;
-    for (size_t i = 0; i < entry.GetPath().size(); ++i) {
-      if (i > 0) pathStr += "/";
-      pathStr += entry.GetPath()[i];
-    }
-    metadata["map"] = pathStr;
-  }
-  metadata["version"] = entry.GetVersion();
-  metadata["creation"] = std::chrono::duration_cast<std::chrono::seconds>(
-      entry.GetCreation().time_since_epoch()).count();
 
   std::string metadataPathStr = dirStr + "/" + MapDirectory::FileMetadata;
   std::string metaJson = metadata.dump(2);
@@ -247,6 +384,16 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
     std::filesystem::path tempPath = targetDir / (fileName + MapDirectory::TemporaryFileSuffix);
     std::filesystem::path finalPath = targetDir / fileName;
 
+    if (resume && std::filesystem::exists(finalPath)) {
+      // Completed by previous attempt
+      std::error_code sizeEc;
+      auto fileSize = std::filesystem::file_size(finalPath, sizeEc);
+      if (!sizeEc) {
+        totalDownloaded += fileSize;
+      }
+      continue;
+    }
+
     // Update job state
     {
       std::unique_lock<std::mutex> lock(jobsMutex);
@@ -260,8 +407,8 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
     osmscout::log.Debug() << "Downloading " << fileUrl << " to " << tempPath.string();
 
     // Download with progress callback
-    bool fileOk = httpClient.Download(
-        fileUrl, tempPath,
+    bool fileOk = DownloadFile(
+        httpClient, fileUrl, tempPath, parameter, breaker,
         [&jobs, &jobsMutex, &targetDir, &totalDownloaded, &breaker, &progress](uint64_t bytes, uint64_t total) -> bool {
           if (breaker.IsAborted()) {
             return false;
@@ -323,12 +470,21 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
   }
 
   if (!allSucceeded) {
-    // Clean up partial download - remove files individually
+    if (!breaker.IsAborted()) {
+      // Keep partial download, it is resumed by the next attempt
+      osmscout::log.Warn() << "Download of map " << entry.GetName() << " failed, partial download is kept in "
+                           << dirStr;
+      return false;
+    }
+
+    // Clean up cancelled download - remove files individually
     std::error_code ec;
     for (const auto &fileName : allFiles) {
       std::filesystem::path filePath = targetDir / fileName;
+      std::filesystem::path tempPath = targetDir / (fileName + MapDirectory::TemporaryFileSuffix);
       std::filesystem::remove(filePath, ec);
-      std::filesystem::remove(targetDir / (fileName + MapDirectory::TemporaryFileSuffix), ec);
+      std::filesystem::remove(tempPath, ec);
+      std::filesystem::remove(ResumeStatePath(tempPath), ec);
     }
     std::filesystem::remove(metadataPathStr, ec);
     std::filesystem::remove(targetDir, ec);
@@ -347,6 +503,170 @@ bool MapDownloadService::DownloadMapInternal(std::vector<DownloadJobState> &jobs
   return true;
 }
 
+bool MapDownloadService::DownloadFile(HttpClient &httpClient,
+                                      const std::string &url,
+                                      const std::filesystem::path &tempPath,
+                                      const MapDownloadParameter &parameter,
+                                      Breaker &breaker,
+                                      const ProgressCallback &progress)
+{
+  uint64_t fileSize = parameter.chunkSize > 0 ? httpClient.FetchContentLength(url) : 0;
+  if (fileSize == 0) {
+    // Range requests are not supported, download the whole file
+    return httpClient.Download(url, tempPath, progress);
+  }
+
+  std::filesystem::path statePath = ResumeStatePath(tempPath);
+  size_t chunkCount = static_cast<size_t>((fileSize + parameter.chunkSize - 1) / parameter.chunkSize);
+  auto ChunkLength = [&](size_t chunk) -> uint64_t {
+    return std::min(parameter.chunkSize, fileSize - chunk * parameter.chunkSize);
+  };
+
+  std::error_code ec;
+  ResumeState state;
+  bool resume = state.Load(statePath) &&
+                state.url == url &&
+                state.size == fileSize &&
+                state.chunkSize == parameter.chunkSize &&
+                state.checksums.size() == chunkCount &&
+                std::filesystem::file_size(tempPath, ec) == fileSize && !ec;
+
+  if (resume) {
+    // Verify chunks of the partial file, damaged ones are downloaded again
+    std::ifstream ifs(tempPath, std::ios::binary);
+    std::vector<char> buffer(64 * 1024);
+    for (size_t chunk = 0; chunk < chunkCount && !breaker.IsAborted(); ++chunk) {
+      if (!state.checksums[chunk]) {
+        continue;
+      }
+      ifs.seekg(static_cast<std::streamoff>(chunk * parameter.chunkSize));
+      uint32_t crc = 0;
+      for (uint64_t remaining = ChunkLength(chunk); remaining > 0 && ifs;) {
+        auto size = static_cast<size_t>(std::min<uint64_t>(remaining, buffer.size()));
+        ifs.read(buffer.data(), static_cast<std::streamsize>(size));
+        crc = UpdateCRC32(crc, buffer.data(), static_cast<size_t>(ifs.gcount()));
+        remaining -= static_cast<uint64_t>(ifs.gcount());
+      }
+      if (!ifs || crc != state.checksums[chunk].value()) {
+        osmscout::log.Warn() << "Chunk " << chunk << " of " << tempPath.string() << " is damaged, downloading it again";
+        state.checksums[chunk].reset();
+        ifs.clear();
+      }
+    }
+  } else {
+    state.url = url;
+    state.size = fileSize;
+    state.chunkSize = parameter.chunkSize;
+    state.checksums.assign(chunkCount, std::nullopt);
+
+    std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      osmscout::log.Error() << "Cannot create " << tempPath.string();
+      return false;
+    }
+    ofs.close();
+    std::filesystem::resize_file(tempPath, fileSize, ec);
+    if (ec) {
+      osmscout::log.Error() << "Cannot resize " << tempPath.string() << ": " << ec.message();
+      return false;
+    }
+  }
+
+  std::vector<size_t> pendingChunks;
+  uint64_t transferred = 0;
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+    if (state.checksums[chunk]) {
+      transferred += ChunkLength(chunk);
+    } else {
+      pendingChunks.push_back(chunk);
+    }
+  }
+
+  std::mutex mutex; // protects state, transferred and progress calls
+  std::atomic<size_t> nextChunk{0};
+  std::atomic<bool> failed{false};
+
+  if (progress && !progress(transferred, fileSize)) {
+    return false;
+  }
+
+  auto Worker = [&]() {
+    std::fstream file(tempPath, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+      osmscout::log.Error() << "Cannot open " << tempPath.string();
+      failed = true;
+      return;
+    }
+
+    while (!failed && !breaker.IsAborted()) {
+      size_t index = nextChunk++;
+      if (index >= pendingChunks.size()) {
+        return;
+      }
+
+      size_t chunk = pendingChunks[index];
+      uint64_t offset = chunk * parameter.chunkSize;
+      uint64_t length = ChunkLength(chunk);
+      uint64_t received = 0;
+      uint32_t crc = 0;
+
+      file.seekp(static_cast<std::streamoff>(offset));
+      bool chunkOk = httpClient.FetchRange(url, offset, length,
+        [&](const char *data, size_t size) -> bool {
+          if (failed || breaker.IsAborted() || received + size > length) {
+            return false;
+          }
+          file.write(data, static_cast<std::streamsize>(size));
+          if (!file) {
+            return false;
+          }
+          crc = UpdateCRC32(crc, data, size);
+          received += size;
+
+          std::unique_lock<std::mutex> lock(mutex);
+          transferred += size;
+          return !progress || progress(transferred, fileSize);
+        });
+
+      file.flush();
+      if (!chunkOk || received != length || !file) {
+        osmscout::log.Error() << "Failed to download bytes " << offset << "-" << (offset + length - 1)
+                              << " of " << url;
+        // The chunk is downloaded again by the next attempt
+        std::unique_lock<std::mutex> lock(mutex);
+        transferred -= received;
+        failed = true;
+        return;
+      }
+
+      std::unique_lock<std::mutex> lock(mutex);
+      state.checksums[chunk] = crc;
+      if (!state.Save(statePath)) {
+        osmscout::log.Warn() << "Cannot write download state " << statePath.string();
+      }
+    }
+  };
+
+  size_t threadCount = std::min(std::max(parameter.maxConnections, size_t(1)), pendingChunks.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < threadCount; ++i) {
+    threads.emplace_back(Worker);
+  }
+  if (threadCount > 0) {
+    Worker();
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (failed || breaker.IsAborted()) {
+    return false;
+  }
+
+  std::filesystem::remove(statePath, ec);
+  return true;
+}
+
 std::vector<std::string> MapDownloadService::MapFiles()
 {
   std::vector<std::string> files = MapDirectory::MandatoryFiles();
@@ -381,6 +701,7 @@ bool MapDownloadService::PrepareMapDirectory(const AvailableMapEntry &entry,
     std::error_code err;
     std::filesystem::remove(fp, err);
     std::filesystem::remove(tp, err);
+    std::filesystem::remove(ResumeStatePath(tp), err);
   };
 
   for (const auto &f : MapDirectory::MandatoryFiles()) {
@@ -395,19 +716,7 @@ bool MapDownloadService::PrepareMapDirectory(const AvailableMapEntry &entry,
   }
 
   // Write metadata.json
-  nlohmann::json metadata;
-  metadata["name"] = entry.GetName();
-  {
-    std::string pathStr;
-    for (size_t i = 0; i < entry.GetPath().size(); ++i) {
-      if (i > 0) pathStr += "/";
-      pathStr += entry.GetPath()[i];
-    }
-    metadata["map"] = pathStr;
-  }
-  metadata["version"] = entry.GetVersion();
-  metadata["creation"] = std::chrono::duration_cast<std::chrono::seconds>(
-      entry.GetCreation().time_since_epoch()).count();
+  nlohmann::json metadata = MetadataJson(entry);
 
   std::string metadataPathStr = dirStr + "/" + MapDirectory::FileMetadata;
   std::string metaJson = metadata.dump(2);
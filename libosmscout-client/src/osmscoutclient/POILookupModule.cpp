@@ -168,17 +168,24 @@ POILookupModule::LookupFuture POILookupModule::lookupPOIRequest(int requestId,
     LookupResult result;
     GeoBox searchBoundingBox=GeoBox::BoxByCenterAndRadius(searchCenter, maxDistance);
 
-    dbThread->RunSynchronousJob([&](const std::list<DBInstanceRef>& databases){
+    // lookup is executed by db job worker, with lower priority than map rendering,
+    // the job is canceled when the lookup is aborted
+    bool executed=dbThread->RunSynchronousJob([&](const std::list<DBInstanceRef>& databases, const DBInstanceRef&, const Breaker& jobBreaker){
       for (auto &db : databases) {
-        if (breaker.IsAborted()){
-          lookupAborted.Emit(requestId);
-          break;
+        if (breaker.IsAborted() || jobBreaker.IsAborted()){
+          return;
         }
         auto partialResult=this->doPOIlookup(db, searchBoundingBox, types);
         lookupResult.Emit(requestId,partialResult);
         std::copy(partialResult.begin(), partialResult.end(), std::back_inserter(result));
       }
-    });
+    },
+    DBThread::JobPriority::Normal,
+    &breaker);
+
+    if (!executed && breaker.IsAborted()){
+      lookupAborted.Emit(requestId);
+    }
 
     lookupFinished.Emit(requestId);
     return result;
@@ -30,14 +30,84 @@
 #include <osmscout/async/Breaker.h>
 
 #include <cstdio>
+#include <memory>
 #include <string>
 
 namespace osmscout::gpx {
 
+class GpxWritter;
+
 extern OSMSCOUT_GPX_API bool ExportGpx(const GpxFile &gpxFile,
                                        const std::string &filePath,
                                        BreakerRef breaker = nullptr,
                                        ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+/**
+ * Incremental gpx writer. Content is written to the file as it is passed,
+ * so tracks of any size may be exported with bounded memory.
+ *
+ * Gpx schema requires this order of elements: metadata, waypoints, routes, tracks.
+ * The writer does not reorder elements, caller has to pass them in this order.
+ * ExportGpx writes them in the same order.
+ * Metadata are optional, but when used, WriteMetadata have to be called first.
+ * Each track is written as StartTrack, (StartTrackSegment, WriteTrackPoint*, EndTrackSegment)*, EndTrack.
+ * Close finishes the document, it is called by destructor when omitted.
+ *
+ * All methods return false on error or when called in unexpected state.
+ */
+class OSMSCOUT_GPX_API GpxStreamWriter {
+private:
+  enum class State {
+    Initial,
+    Document,
+    Track,
+    Segment,
+    Closed
+  };
+
+  std::unique_ptr<GpxWritter> writer;
+  State state=State::Initial;
+
+private:
+  bool EnsureDocument();
+
+public:
+  explicit GpxStreamWriter(const std::string &filePath,
+                           BreakerRef breaker = nullptr,
+                           ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+  GpxStreamWriter(const GpxStreamWriter&) = delete;
+  GpxStreamWriter& operator=(const GpxStreamWriter&) = delete;
+
+  ~GpxStreamWriter();
+
+  bool IsOpen() const;
+
+  /**
+   * Write document metadata (name, desc and timestamp of the given file),
+   * other content of the file is ignored.
+   */
+  bool WriteMetadata(const GpxFile &metadata);
+
+  bool WriteWaypoint(const Waypoint &waypoint);
+
+  bool WriteRoute(const Route &route);
+
+  /**
+   * Start new track with attributes of the given track, its segments are ignored.
+   */
+  bool StartTrack(const Track &track);
+
+  bool StartTrackSegment();
+
+  bool WriteTrackPoint(const TrackPoint &point);
+
+  bool EndTrackSegment();
+
+  bool EndTrack();
+
+  bool Close();
+};
 }
 
 #endif //LIBOSMSCOUT_GPX_EXPORT_H
@@ -30,16 +30,87 @@
 #include <osmscout/async/Breaker.h>
 
 #include <cstdio>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace osmscout::gpx {
 
+/**
+ * SAX like receiver of gpx content. It allows to process gpx files of any size
+ * without building the complete GpxFile object tree in memory.
+ *
+ * Track points are reported one by one, between OnTrackSegmentStart and OnTrackSegmentEnd.
+ * Waypoints and routes are small and reported as whole objects.
+ */
+class OSMSCOUT_GPX_API GpxHandler {
+public:
+  virtual ~GpxHandler() = default;
+
+  virtual void OnMetadata(const std::optional<std::string> &name,
+                          const std::optional<std::string> &desc,
+                          const std::optional<Timestamp> &timestamp);
+
+  virtual void OnWaypoint(Waypoint &&waypoint);
+
+  virtual void OnRoute(Route &&route);
+
+  virtual void OnTrackStart();
+
+  /**
+   * Start of new track segment.
+   * @param track - track attributes known so far (gpx schema defines them before segments),
+   *                segments of the given track are always empty
+   */
+  virtual void OnTrackSegmentStart(const Track &track);
+
+  virtual void OnTrackPoint(TrackPoint &&point) = 0;
+
+  virtual void OnTrackSegmentEnd();
+
+  /**
+   * End of the track.
+   * @param track - track attributes, segments of the given track are always empty
+   */
+  virtual void OnTrackEnd(const Track &track);
+};
+
+using GpxHandlerRef = std::shared_ptr<GpxHandler>;
 
 extern OSMSCOUT_GPX_API bool ImportGpx(const std::string &filePath,
                                        GpxFile &output,
                                        BreakerRef breaker =nullptr,
                                        ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
 
+/**
+ * Streaming import, content of the file is passed to the handler while parsing.
+ * Memory usage don't depend on the file size.
+ */
+extern OSMSCOUT_GPX_API bool ImportGpx(const std::string &filePath,
+                                       GpxHandler &handler,
+                                       BreakerRef breaker =nullptr,
+                                       ProcessCallbackRef callback = std::make_shared<ProcessCallback>());
+
+/**
+ * Parse multiple files in parallel, using up to threadCount threads.
+ * Each file is passed to its own handler (handlers[i] for filePaths[i]).
+ * Handler is called from the parsing thread, handlers of different files may
+ * be called concurrently.
+ *
+ * @return true if all files were imported successfully
+ */
+extern OSMSCOUT_GPX_API bool ImportGpx(const std::vector<std::string> &filePaths,
+                                       const std::vector<GpxHandlerRef> &handlers,
+                                       size_t threadCount,
+                                       BreakerRef breaker =nullptr);
+
+/**
+ * Import multiple files into GpxFile object trees in parallel
+ */
+extern OSMSCOUT_GPX_API bool ImportGpx(const std::vector<std::string> &filePaths,
+                                       std::vector<GpxFile> &output,
+                                       size_t threadCount,
+                                       BreakerRef breaker =nullptr);
 }
 
 #endif //LIBOSMSCOUT_GPX_IMPORT_H
@@ -31,6 +31,8 @@
 using namespace osmscout;
 using namespace osmscout::gpx;
 
+namespace osmscout::gpx {
+
 /**
  * Inspired by http://www.xmlsoft.org/examples/testWriter.c
  */
@@ -43,13 +45,10 @@ private:
 
   xmlTextWriterPtr    writer;
   ProcessCallbackRef  callback;
-  const GpxFile       &gpxFile;
   BreakerRef          breaker;
 
 private:
   bool WriteGpxHeader();
-  bool StartElement(const char *name);
-  bool EndElement();
 
   bool WriteAttribute(const char *name, const char *content);
   bool WriteAttribute(const char *name, double value, std::streamsize precision=6);
@@ -67,10 +66,8 @@ private:
 
   bool WriteMetadata(const GpxFile file);
 
-  bool WriteWaypoint(const Waypoint &waypoint);
   bool WriteWaypoints(const std::vector<Waypoint> &waypoints);
 
-  bool WriteTrackPoint(const char *elemName, const TrackPoint &point);
   bool WriteTrackPoints(const char *elemName, const std::vector<TrackPoint> &points);
 
   bool WriteTrackSegment(const TrackSegment &segment);
@@ -79,19 +76,16 @@ private:
   bool WriteTrack(const Track &track);
   bool WriteTracks(const std::vector<Track> &tracks);
 
-  bool WriteRoute(const Route &route);
   bool WriteRoutes(const std::vector<Route> &routes);
 
   bool WriteExtensions(const Extensions &ext);
 
 public:
-  GpxWritter(const GpxFile &gpxFile,
-             const std::string &filePath,
+  GpxWritter(const std::string &filePath,
              BreakerRef breaker,
              ProcessCallbackRef callback):
       writer(nullptr),
       callback(callback),
-      gpxFile(gpxFile),
       breaker(breaker)
   {
     /* Create a new XmlWriter for uri, with no compression. */
@@ -100,7 +94,7 @@ public:
       callback->Error("Error creating the xml writer");
     }
     if (writer != nullptr) {
-      if (xmlTextWriterSetIndent(writer, 1) < 0){
+      if (xmlTextWriterSetIndent(writer, 1) < 0 && callback){
         callback->Error("Error at xmlTextWriterSetIndent");
       }
     }
@@ -114,7 +108,20 @@ public:
     }
   }
 
-  bool Process()
+  bool IsOpen() const
+  {
+    return writer!=nullptr;
+  }
+
+  bool StartElement(const char *name);
+  bool EndElement();
+
+  bool WriteWaypoint(const Waypoint &waypoint);
+  bool WriteTrackPoint(const char *elemName, const TrackPoint &point);
+  bool WriteTrackHeader(const Track &track);
+  bool WriteRoute(const Route &route);
+
+  bool StartDocument(const GpxFile &gpxFile)
   {
     if (writer==nullptr) {
       return false;
@@ -127,37 +134,62 @@ public:
       return false;
     }
 
-    if (!WriteGpxHeader()){
+    return WriteGpxHeader() &&
+           WriteMetadata(gpxFile);
+  }
+
+  bool EndDocument()
+  {
+    if (writer==nullptr) {
       return false;
     }
 
-    if (!WriteMetadata(gpxFile)){
+    if (xmlTextWriterEndDocument(writer) < 0) {
+      if (callback) {
+        callback->Error("Error at xmlTextWriterEndDocument");
+      }
       return false;
     }
 
-    if (!WriteWaypoints(gpxFile.waypoints)){
+    return true;
+  }
+
+  bool IsAborted() const
+  {
+    if (breaker && breaker->IsAborted()){
+      if (callback) {
+        callback->Error("aborted");
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool Process(const GpxFile &gpxFile)
+  {
+    if (!StartDocument(gpxFile)){
       return false;
     }
 
-    if (!WriteTracks(gpxFile.tracks)){
+    if (!WriteWaypoints(gpxFile.waypoints)){
       return false;
     }
 
+    // gpx schema requires routes before tracks
     if (!WriteRoutes(gpxFile.routes)){
       return false;
     }
 
-    if (xmlTextWriterEndDocument(writer) < 0) {
-      if (callback) {
-        callback->Error("Error at xmlTextWriterEndDocument");
-      }
+    if (!WriteTracks(gpxFile.tracks)){
       return false;
     }
 
-    return true;
+    return EndDocument();
   }
 };
 
+}
+
 bool GpxWritter::StartElement(const char *name)
 {
   if (writer==nullptr){
@@ -204,7 +236,7 @@ bool GpxWritter::WriteTextElement(const char *elementName, double value, std::st
 {
   std::ostringstream stream;
   stream.setf(std::ios::fixed,std::ios::floatfield);
-  stream.imbue(std::locale("C"));
+  stream.imbue(std::locale::classic());
   stream.precision(precision);
   stream << value;
 
@@ -234,7 +266,7 @@ bool GpxWritter::WriteAttribute(const char *name, double value, std::streamsize
 {
   std::ostringstream stream;
   stream.setf(std::ios::fixed,std::ios::floatfield);
-  stream.imbue(std::locale("C"));
+  stream.imbue(std::locale::classic());
   stream.precision(precision);
   stream << value;
 
@@ -388,7 +420,7 @@ bool GpxWritter::WriteTrackSegments(const std::vector<TrackSegment> &segments)
   return true;
 }
 
-bool GpxWritter::WriteTrack(const Track &track)
+bool GpxWritter::WriteTrackHeader(const Track &track)
 {
   if (!StartElement("trk")){
     return false;
@@ -434,7 +466,13 @@ bool GpxWritter::WriteTrack(const Track &track)
     }
   }
 
-  return WriteTrackSegments(track.segments) &&
+  return true;
+}
+
+bool GpxWritter::WriteTrack(const Track &track)
+{
+  return WriteTrackHeader(track) &&
+      WriteTrackSegments(track.segments) &&
       EndElement();
 }
 
@@ -538,6 +576,122 @@ bool gpx::ExportGpx(const GpxFile &gpxFile,
                     BreakerRef breaker,
                     ProcessCallbackRef callback)
 {
-  GpxWritter writter(gpxFile, filePath, breaker, callback);
-  return writter.Process();
+  GpxWritter writter(filePath, breaker, callback);
+  return writter.Process(gpxFile);
+}
+
+GpxStreamWriter::GpxStreamWriter(const std::string &filePath,
+                                 BreakerRef breaker,
+                                 ProcessCallbackRef callback):
+  writer(std::make_unique<GpxWritter>(filePath, breaker, callback))
+{
+  // no code
+}
+
+GpxStreamWriter::~GpxStreamWriter()
+{
+  if (state!=State::Closed) {
+    Close();
+  }
+}
+
+bool GpxStreamWriter::IsOpen() const
+{
+  return writer->IsOpen();
+}
+
+bool GpxStreamWriter::WriteMetadata(const GpxFile &metadata)
+{
+  if (state!=State::Initial) {
+    return false;
+  }
+  state=State::Document;
+  return writer->StartDocument(metadata);
+}
+
+bool GpxStreamWriter::EnsureDocument()
+{
+  if (state==State::Initial) {
+    return WriteMetadata(GpxFile());
+  }
+  return state!=State::Closed;
+}
+
+bool GpxStreamWriter::WriteWaypoint(const Waypoint &waypoint)
+{
+  if (!EnsureDocument() || state!=State::Document) {
+    return false;
+  }
+  return writer->WriteWaypoint(waypoint);
+}
+
+bool GpxStreamWriter::WriteRoute(const Route &route)
+{
+  if (!EnsureDocument() || state!=State::Document) {
+    return false;
+  }
+  return writer->WriteRoute(route);
+}
+
+bool GpxStreamWriter::StartTrack(const Track &track)
+{
+  if (!EnsureDocument() || state!=State::Document) {
+    return false;
+  }
+  state=State::Track;
+  return writer->WriteTrackHeader(track);
+}
+
+bool GpxStreamWriter::StartTrackSegment()
+{
+  if (state!=State::Track) {
+    return false;
+  }
+  state=State::Segment;
+  return writer->StartElement("trkseg");
+}
+
+bool GpxStreamWriter::WriteTrackPoint(const TrackPoint &point)
+{
+  if (state!=State::Segment || writer->IsAborted()) {
+    return false;
+  }
+  return writer->WriteTrackPoint("trkpt", point);
+}
+
+bool GpxStreamWriter::EndTrackSegment()
+{
+  if (state!=State::Segment) {
+    return false;
+  }
+  state=State::Track;
+  return writer->EndElement();
+}
+
+bool GpxStreamWriter::EndTrack()
+{
+  if (state==State::Segment && !EndTrackSegment()) {
+    return false;
+  }
+  if (state!=State::Track) {
+    return false;
+  }
+  state=State::Document;
+  return writer->EndElement();
+}
+
+bool GpxStreamWriter::Close()
+{
+  if (state==State::Closed) {
+    return false;
+  }
+  if ((state==State::Segment || state==State::Track) && !EndTrack()) {
+    state=State::Closed;
+    return false;
+  }
+  if (!EnsureDocument()) {
+    return false;
+  }
+  state=State::Closed;
+  return writer->EndDocument();
 }
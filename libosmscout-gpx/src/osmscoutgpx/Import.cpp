@@ -17,11 +17,15 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <libxml/parser.h>
 
@@ -66,10 +70,10 @@ public:
 
 class DocumentContext : public GpxParserContext {
 private:
-  GpxFile &output;
+  GpxHandler &handler;
 public:
-  DocumentContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser) :
-      GpxParserContext(ctxt, parser), output(output) {}
+  DocumentContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser) :
+      GpxParserContext(ctxt, parser), handler(handler) {}
 
   ~DocumentContext() override = default;
 
@@ -94,7 +98,7 @@ private:
   xmlParserCtxtPtr  ctxt;
   FileOffset        fileSize;
 
-  GpxFile           &output;
+  GpxHandler        &handler;
   BreakerRef        breaker;
   ProcessCallbackRef callback;
 
@@ -102,13 +106,13 @@ private:
 
 public:
   GpxParser(const std::string &filePath,
-         GpxFile &output,
+         GpxHandler &handler,
          const BreakerRef& breaker,
          const ProcessCallbackRef& callback):
   file(nullptr),
   ctxt(nullptr),
   fileSize(0),
-  output(output),
+  handler(handler),
   breaker(breaker),
   callback(callback),
   errorCnt(0)
@@ -130,7 +134,9 @@ public:
     try{
       fileSize=GetFileSize(filePath);
     }catch(const IOException &e){
-      callback->Error("Can't get file size: " + e.GetErrorMsg());
+      if (callback) {
+        callback->Error("Can't get file size: " + e.GetErrorMsg());
+      }
     }
 
     file=std::fopen(filePath.c_str(),"rb");
@@ -159,14 +165,15 @@ public:
       return false;
     }
 
-    char chars[1024];
+    // bigger chunks reduce parser overhead, memory usage is still bounded
+    std::vector<char> chars(64*1024);
 
-    size_t res=std::fread(chars,1,4,file);
+    size_t res=std::fread(chars.data(),1,4,file);
     if (res!=4) {
       return false;
     }
 
-    ctxt=xmlCreatePushParserCtxt(&saxParser,this,chars,
+    ctxt=xmlCreatePushParserCtxt(&saxParser,this,chars.data(),
                                  static_cast<int>(res),
                                  nullptr);
 
@@ -174,8 +181,8 @@ public:
     xmlCtxtUseOptions(ctxt,XML_PARSE_NOENT|XML_PARSE_NONET);
 
     FileOffset position=0;
-    while ((res=std::fread(chars,1,sizeof(chars),file))>0) {
-      if (::xmlParseChunk(ctxt,chars,
+    while ((res=std::fread(chars.data(),1,chars.size(),file))>0) {
+      if (::xmlParseChunk(ctxt,chars.data(),
                         static_cast<int>(res),0)!=0) {
         ::xmlParserError(ctxt,"xmlParseChunk");
         return false;
@@ -195,7 +202,7 @@ public:
       }
     }
 
-    if (::xmlParseChunk(ctxt,chars,0,1)!=0) {
+    if (::xmlParseChunk(ctxt,chars.data(),0,1)!=0) {
       ::xmlParserError(ctxt,"xmlParseChunk");
       return false;
     }
@@ -206,7 +213,7 @@ public:
   void StartDocument()
   {
     assert(contextStack.empty());
-    contextStack.push_back(new DocumentContext(ctxt, output, *this));
+    contextStack.push_back(new DocumentContext(ctxt, handler, *this));
   }
 
   void StartElement(NameSpace ns,
@@ -507,14 +514,14 @@ public:
 
 class TrkptContext : public PointLikeContext {
 private:
-  TrackSegment &segment;
+  GpxHandler &handler;
 public:
-  TrkptContext(xmlParserCtxtPtr ctxt, TrackSegment &segment, GpxParser &parser, double lat, double lon) :
-      PointLikeContext(ctxt, parser, lat, lon), segment(segment) {}
+  TrkptContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser, double lat, double lon) :
+      PointLikeContext(ctxt, parser, lat, lon), handler(handler) {}
 
   ~TrkptContext() override
   {
-    segment.points.push_back(std::move(point));
+    handler.OnTrackPoint(std::move(point));
   }
 
   const char *ContextName() const override
@@ -543,15 +550,15 @@ public:
 
 class WaypointContext : public GpxParserContext {
 private:
-  GpxFile &output;
+  GpxHandler &handler;
   Waypoint waypoint;
 public:
-  WaypointContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser, double lat, double lon) :
-      GpxParserContext(ctxt, parser), output(output), waypoint(GeoCoord(lat,lon)) { }
+  WaypointContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser, double lat, double lon) :
+      GpxParserContext(ctxt, parser), handler(handler), waypoint(GeoCoord(lat,lon)) { }
 
   ~WaypointContext() override
   {
-    output.waypoints.push_back(std::move(waypoint));
+    handler.OnWaypoint(std::move(waypoint));
   }
 
   const char *ContextName() const override
@@ -647,13 +654,17 @@ public:
 
 class MetadataContext : public GpxParserContext {
 private:
-  GpxFile &output;
+  GpxHandler &handler;
+  std::optional<std::string> name;
+  std::optional<std::string> desc;
+  std::optional<Timestamp> timestamp;
 public:
-  MetadataContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser) :
-  GpxParserContext(ctxt, parser), output(output) { }
+  MetadataContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser) :
+  GpxParserContext(ctxt, parser), handler(handler) { }
 
   ~MetadataContext() override
   {
+    handler.OnMetadata(name, desc, timestamp);
   }
 
   const char *ContextName() const override
@@ -667,13 +678,13 @@ public:
   {
     if (ns == NameSpace::Gpx && name=="name") {
       return new SimpleValueContext("NameContext", ctxt, parser, [&](const std::string &name) {
-        output.name = std::make_optional<std::string>(name);
+        this->name = std::make_optional<std::string>(name);
       });
     }
 
     if (ns == NameSpace::Gpx && name == "desc") {
       return new SimpleValueContext("DescContext", ctxt, parser, [&](const std::string &description) {
-        output.desc = std::make_optional<std::string>(description);
+        desc = std::make_optional<std::string>(description);
       });
     }
 
@@ -681,7 +692,7 @@ public:
       return new SimpleValueContext("TimeContext", ctxt, parser, [&](const std::string &value){
         Timestamp time;
         if (ParseISO8601TimeString(value, time)){
-          output.timestamp=std::make_optional<Timestamp>(time);
+          timestamp=std::make_optional<Timestamp>(time);
         }else{
           ::xmlParserWarning(ctxt,"Can't parse Time value\n");
           parser.Warning("Can't parse Time value");
@@ -695,15 +706,17 @@ public:
 
 class TrkSegContext : public GpxParserContext {
 private:
-  Track &track;
-  TrackSegment segment;
+  GpxHandler &handler;
 public:
-  TrkSegContext(xmlParserCtxtPtr ctxt, Track &track, GpxParser &parser) :
-      GpxParserContext(ctxt, parser), track(track) {}
+  TrkSegContext(xmlParserCtxtPtr ctxt, const Track &track, GpxHandler &handler, GpxParser &parser) :
+      GpxParserContext(ctxt, parser), handler(handler)
+  {
+    handler.OnTrackSegmentStart(track);
+  }
 
   ~TrkSegContext() override
   {
-    track.segments.push_back(std::move(segment));
+    handler.OnTrackSegmentEnd();
   }
 
   const char *ContextName() const override
@@ -721,7 +734,7 @@ public:
       if (GpxParser::ParseDoubleAttr(atts, {NameSpace::Gpx, "lat"}, lat) &&
           GpxParser::ParseDoubleAttr(atts, {NameSpace::Gpx, "lon"}, lon)
           ) {
-        return new TrkptContext(ctxt, segment, parser, lat, lon);
+        return new TrkptContext(ctxt, handler, parser, lat, lon);
       }
 
       ::xmlParserError(ctxt,"Can't parse trkpt lan/lon\n");
@@ -735,15 +748,15 @@ public:
 
 class RouteContext : public GpxParserContext {
 private:
-  GpxFile &output;
+  GpxHandler &handler;
   Route route;
 public:
-  RouteContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser) :
-  GpxParserContext(ctxt, parser), output(output) {}
+  RouteContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser) :
+  GpxParserContext(ctxt, parser), handler(handler) {}
 
   ~RouteContext() override
   {
-    output.routes.push_back(std::move(route));
+    handler.OnRoute(std::move(route));
   }
 
   const char *ContextName() const override
@@ -818,15 +831,18 @@ public:
 
 class TrkContext : public GpxParserContext {
 private:
-  Track track;
-  GpxFile &output;
+  Track track; // track attributes, segments are passed to the handler directly
+  GpxHandler &handler;
 public:
-  TrkContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser):
-      GpxParserContext(ctxt, parser), output(output) { }
+  TrkContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser):
+      GpxParserContext(ctxt, parser), handler(handler)
+  {
+    handler.OnTrackStart();
+  }
 
   ~TrkContext() override
   {
-    output.tracks.push_back(std::move(track));
+    handler.OnTrackEnd(track);
   }
 
   const char *ContextName() const override
@@ -857,7 +873,7 @@ public:
     }
 
     if (ns == NameSpace::Gpx && name=="trkseg"){
-      return new TrkSegContext(ctxt, track, parser);
+      return new TrkSegContext(ctxt, track, handler, parser);
     } else if (ns == NameSpace::Gpx && name=="extensions"){
       return new TrkExtensionContext(ctxt, track, parser);
     }
@@ -867,10 +883,10 @@ public:
 };
 
 class GpxDocumentContext : public GpxParserContext {
-  GpxFile &output;
+  GpxHandler &handler;
 public:
-  GpxDocumentContext(xmlParserCtxtPtr ctxt, GpxFile &output, GpxParser &parser):
-      GpxParserContext(ctxt, parser), output(output) {}
+  GpxDocumentContext(xmlParserCtxtPtr ctxt, GpxHandler &handler, GpxParser &parser):
+      GpxParserContext(ctxt, parser), handler(handler) {}
 
   ~GpxDocumentContext() override = default;
 
@@ -884,7 +900,7 @@ public:
                                  const std::map<AttrKey, std::string> &atts) override
   {
     if (ns == NameSpace::Gpx && name=="trk"){
-      return new TrkContext(ctxt,output,parser);
+      return new TrkContext(ctxt,handler,parser);
     }
 
     if (ns == NameSpace::Gpx && name=="wpt"){
@@ -893,7 +909,7 @@ public:
       if (GpxParser::ParseDoubleAttr(atts, {NameSpace::Gpx, "lat"}, lat) &&
           GpxParser::ParseDoubleAttr(atts, {NameSpace::Gpx, "lon"}, lon)
           ) {
-        return new WaypointContext(ctxt, output, parser, lat, lon);
+        return new WaypointContext(ctxt, handler, parser, lat, lon);
       }
 
       ::xmlParserError(ctxt,"Can't parse wpt lan/lon\n");
@@ -902,11 +918,11 @@ public:
     }
 
     if (ns == NameSpace::Gpx && name=="rte"){
-      return new RouteContext(ctxt,output,parser);
+      return new RouteContext(ctxt,handler,parser);
     }
 
     if (ns == NameSpace::Gpx && name=="metadata"){
-      return new MetadataContext(ctxt,output,parser);
+      return new MetadataContext(ctxt,handler,parser);
     }
     return nullptr; // silently ignore unknown elements
   }
@@ -917,17 +933,183 @@ GpxParserContext* DocumentContext::StartElement(NameSpace ns,
                                                 const std::map<AttrKey, std::string> &atts)
 {
   if (ns == NameSpace::Gpx && name=="gpx"){
-    return new GpxDocumentContext(ctxt,output,parser);
+    return new GpxDocumentContext(ctxt,handler,parser);
   }
   return GpxParserContext::StartElement(ns, name, atts);
 }
 
+/**
+ * Handler building complete GpxFile object tree
+ */
+class GpxFileBuilder : public GpxHandler {
+private:
+  GpxFile &output;
+public:
+  explicit GpxFileBuilder(GpxFile &output):
+      output(output) {}
+
+  ~GpxFileBuilder() override = default;
+
+  void OnMetadata(const std::optional<std::string> &name,
+                  const std::optional<std::string> &desc,
+                  const std::optional<Timestamp> &timestamp) override
+  {
+    output.name=name;
+    output.desc=desc;
+    output.timestamp=timestamp;
+  }
+
+  void OnWaypoint(Waypoint &&waypoint) override
+  {
+    output.waypoints.push_back(std::move(waypoint));
+  }
+
+  void OnRoute(Route &&route) override
+  {
+    output.routes.push_back(std::move(route));
+  }
+
+  void OnTrackStart() override
+  {
+    output.tracks.emplace_back();
+  }
+
+  void OnTrackSegmentStart(const Track &) override
+  {
+    assert(!output.tracks.empty());
+    output.tracks.back().segments.emplace_back();
+  }
+
+  void OnTrackPoint(TrackPoint &&point) override
+  {
+    assert(!output.tracks.empty() && !output.tracks.back().segments.empty());
+    output.tracks.back().segments.back().points.push_back(std::move(point));
+  }
+
+  void OnTrackEnd(const Track &track) override
+  {
+    assert(!output.tracks.empty());
+    Track &current=output.tracks.back();
+    current.name=track.name;
+    current.desc=track.desc;
+    current.type=track.type;
+    current.displayColor=track.displayColor;
+  }
+};
+
+void GpxHandler::OnMetadata(const std::optional<std::string> &,
+                            const std::optional<std::string> &,
+                            const std::optional<Timestamp> &)
+{
+  // no code
+}
+
+void GpxHandler::OnWaypoint(Waypoint &&)
+{
+  // no code
+}
+
+void GpxHandler::OnRoute(Route &&)
+{
+  // no code
+}
+
+void GpxHandler::OnTrackStart()
+{
+  // no code
+}
+
+void GpxHandler::OnTrackSegmentStart(const Track &)
+{
+  // no code
+}
+
+void GpxHandler::OnTrackSegmentEnd()
+{
+  // no code
+}
+
+void GpxHandler::OnTrackEnd(const Track &)
+{
+  // no code
+}
+
 bool gpx::ImportGpx(const std::string &filePath,
                     GpxFile &output,
                     BreakerRef breaker,
                     ProcessCallbackRef callback)
 {
+  GpxFileBuilder builder(output);
+  return ImportGpx(filePath, builder, breaker, callback);
+}
 
-  GpxParser parser(filePath, output, breaker, callback);
+bool gpx::ImportGpx(const std::string &filePath,
+                    GpxHandler &handler,
+                    BreakerRef breaker,
+                    ProcessCallbackRef callback)
+{
+  GpxParser parser(filePath, handler, breaker, callback);
   return parser.Process();
 }
+
+bool gpx::ImportGpx(const std::vector<std::string> &filePaths,
+                    const std::vector<GpxHandlerRef> &handlers,
+                    size_t threadCount,
+                    BreakerRef breaker)
+{
+  assert(filePaths.size()==handlers.size());
+
+  // libxml2 global state have to be initialized before parsing in multiple threads
+  xmlInitParser();
+
+  std::atomic<size_t> nextFile{0};
+  std::atomic<bool>   success{true};
+
+  auto worker=[&]() {
+    for (size_t i=nextFile++; i<filePaths.size(); i=nextFile++) {
+      if (breaker && breaker->IsAborted()) {
+        success=false;
+        return;
+      }
+
+      // ProcessCallback is not thread safe, errors are logged instead
+      if (!ImportGpx(filePaths[i], *handlers[i], breaker, nullptr)) {
+        osmscout::log.Error() << "Failed to import gpx file " << filePaths[i];
+        success=false;
+      }
+    }
+  };
+
+  threadCount=std::max(size_t(1), std::min(threadCount, filePaths.size()));
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount-1);
+  for (size_t i=1; i<threadCount; i++) {
+    threads.emplace_back(worker);
+  }
+
+  worker();
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return success;
+}
+
+bool gpx::ImportGpx(const std::vector<std::string> &filePaths,
+                    std::vector<GpxFile> &output,
+                    size_t threadCount,
+                    BreakerRef breaker)
+{
+  output.clear();
+  output.resize(filePaths.size());
+
+  std::vector<GpxHandlerRef> builders;
+  builders.reserve(filePaths.size());
+  for (auto &file : output) {
+    builders.push_back(std::make_shared<GpxFileBuilder>(file));
+  }
+
+  return ImportGpx(filePaths, builders, threadCount, breaker);
+}
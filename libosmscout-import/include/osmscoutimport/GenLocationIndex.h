@@ -509,6 +509,9 @@ namespace osmscout {
     void WriteAddressData(FileWriter& writer,
                           const locidx::Region& region);
 
+    bool WriteLocationNGramIndex(const ImportParameter& parameter,
+                                 Progress& progress) const;
+
   public:
     void GetDescription(const ImportParameter& parameter,
                         ImportModuleDescription& description) const override;
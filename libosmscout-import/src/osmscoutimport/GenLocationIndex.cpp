@@ -20,17 +20,20 @@
 #include <osmscoutimport/GenLocationIndex.h>
 
 #include <algorithm>
+#include <array>
 #include <sstream>
 #include <limits>
 #include <list>
 #include <map>
 #include <set>
+#include <tuple>
 
 #include <osmscout/Pixel.h>
 
 #include <osmscout/FeatureReader.h>
 
 #include <osmscout/db/LocationIndex.h>
+#include <osmscout/db/LocationNGramIndex.h>
 
 #include <osmscout/db/AreaDataFile.h>
 #include <osmscout/db/NodeDataFile.h>
@@ -2704,6 +2707,260 @@ namespace osmscout {
     }
   }
 
+  namespace {
+    using NGramPostings = std::unordered_map<uint32_t,std::vector<FileOffset>>;
+
+    void AddNGrams(const std::string& name,
+                   FileOffset offset,
+                   NGramPostings& postings)
+    {
+      std::string           normalizedName=LocationNGramIndex::NormalizeName(name);
+      std::vector<uint32_t> nGrams;
+
+      for (size_t length=1; length<=LocationNGramIndex::MaxNGramLength; length++) {
+        LocationNGramIndex::GetNGrams(normalizedName,
+                                      length,
+                                      nGrams);
+      }
+
+      for (uint32_t nGram : nGrams) {
+        std::vector<FileOffset>& posting=postings[nGram];
+
+        if (posting.empty() ||
+            posting.back()!=offset) {
+          posting.push_back(offset);
+        }
+      }
+    }
+
+    class NGramRegionVisitor : public AdminRegionVisitor
+    {
+    public:
+      std::vector<AdminRegion> regions;
+      NGramPostings&           postings;
+
+    public:
+      explicit NGramRegionVisitor(NGramPostings& postings)
+      : postings(postings)
+      {
+        // no code
+      }
+
+      Action Visit(const AdminRegion& region) override
+      {
+        regions.push_back(region);
+
+        AddNGrams(region.name,region.regionOffset,postings);
+        AddNGrams(region.altName,region.regionOffset,postings);
+
+        for (const auto& alias : region.aliases) {
+          AddNGrams(alias.name,region.regionOffset,postings);
+          AddNGrams(alias.altName,region.regionOffset,postings);
+        }
+
+        return visitChildren;
+      }
+    };
+
+    class NGramAddressVisitor : public AddressVisitor
+    {
+    public:
+      NGramPostings& postings;
+
+    public:
+      explicit NGramAddressVisitor(NGramPostings& postings)
+      : postings(postings)
+      {
+        // no code
+      }
+
+      bool Visit(const AdminRegion& /*adminRegion*/,
+                 const PostalArea& /*postalArea*/,
+                 const Location& /*location*/,
+                 const Address& address) override
+      {
+        AddNGrams(address.name,address.locationOffset,postings);
+
+        return true;
+      }
+    };
+
+    class NGramLocationVisitor : public LocationVisitor
+    {
+    public:
+      const LocationIndex& locationIndex;
+      NGramPostings&       locationPostings;
+      NGramAddressVisitor  addressVisitor;
+      bool                 success=true;
+
+    public:
+      NGramLocationVisitor(const LocationIndex& locationIndex,
+                           NGramPostings& locationPostings,
+                           NGramPostings& addressPostings)
+      : locationIndex(locationIndex),
+        locationPostings(locationPostings),
+        addressVisitor(addressPostings)
+      {
+        // no code
+      }
+
+      bool Visit(const AdminRegion& adminRegion,
+                 const PostalArea& postalArea,
+                 const Location& location) override
+      {
+        AddNGrams(location.name,adminRegion.regionOffset,locationPostings);
+
+        if (location.addressesOffset!=0 &&
+            !locationIndex.VisitAddresses(adminRegion,
+                                          postalArea,
+                                          location,
+                                          addressVisitor)) {
+          success=false;
+          return false;
+        }
+
+        return true;
+      }
+    };
+
+    void WriteNGramPostings(FileWriter& writer,
+                            NGramPostings& postings,
+                            std::vector<std::tuple<uint32_t,uint32_t,FileOffset>>& directory)
+    {
+      std::vector<uint32_t> nGrams;
+
+      nGrams.reserve(postings.size());
+
+      for (const auto& [nGram,posting] : postings) {
+        nGrams.push_back(nGram);
+      }
+
+      std::sort(nGrams.begin(),nGrams.end());
+
+      for (uint32_t nGram : nGrams) {
+        std::vector<FileOffset>& posting=postings[nGram];
+        FileOffset               lastOffset=0;
+
+        std::sort(posting.begin(),posting.end());
+        posting.erase(std::unique(posting.begin(),posting.end()),posting.end());
+
+        directory.emplace_back(nGram,(uint32_t)posting.size(),writer.GetPos());
+
+        for (FileOffset offset : posting) {
+          writer.WriteNumber((uint64_t)(offset-lastOffset));
+          lastOffset=offset;
+        }
+
+        posting.clear();
+        posting.shrink_to_fit();
+      }
+    }
+  }
+
+  /**
+   * Read the just written location index and write an inverted index from the n-grams of
+   * all region, location and address names to their entries (see LocationNGramIndex)
+   */
+  bool LocationIndexGenerator::WriteLocationNGramIndex(const ImportParameter& parameter,
+                                                       Progress& progress) const
+  {
+    progress.SetAction("Write '{}'",LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX);
+
+    LocationIndex locationIndex;
+
+    if (!locationIndex.Load(parameter.GetDestinationDirectory(),
+                            false)) {
+      progress.Error("Cannot read location index");
+      return false;
+    }
+
+    std::array<NGramPostings,LocationNGramIndex::SectionCount> postings;
+    NGramRegionVisitor                                         regionVisitor(postings[size_t(LocationNGramIndex::Section::regions)]);
+
+    if (!locationIndex.VisitAdminRegions(regionVisitor)) {
+      progress.Error("Cannot visit regions of location index");
+      return false;
+    }
+
+    NGramLocationVisitor locationVisitor(locationIndex,
+                                         postings[size_t(LocationNGramIndex::Section::locations)],
+                                         postings[size_t(LocationNGramIndex::Section::addresses)]);
+
+    for (const auto& region : regionVisitor.regions) {
+      if (!locationIndex.VisitLocations(region,
+                                        locationVisitor,
+                                        false) ||
+          !locationVisitor.success) {
+        progress.Error("Cannot visit locations of location index");
+        return false;
+      }
+    }
+
+    locationIndex.FlushCache();
+
+    FileWriter writer;
+
+    try {
+      std::array<std::vector<std::tuple<uint32_t,uint32_t,FileOffset>>,LocationNGramIndex::SectionCount> directories;
+
+      writer.Open(AppendFileToDir(parameter.GetDestinationDirectory(),
+                                  LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX));
+
+      writer.WriteFileOffset(0); // Offset of the directory
+
+      for (size_t section=0; section<LocationNGramIndex::SectionCount; section++) {
+        WriteNGramPostings(writer,
+                           postings[section],
+                           directories[section]);
+      }
+
+      FileOffset directoryOffset=writer.GetPos();
+
+      std::sort(regionVisitor.regions.begin(),
+                regionVisitor.regions.end(),
+                [](const AdminRegion& a, const AdminRegion& b) {
+                  return a.regionOffset<b.regionOffset;
+                });
+
+      writer.WriteNumber((uint32_t)regionVisitor.regions.size());
+
+      for (const auto& region : regionVisitor.regions) {
+        writer.WriteFileOffset(region.regionOffset);
+        writer.WriteFileOffset(region.parentRegionOffset);
+      }
+
+      for (const auto& directory : directories) {
+        writer.WriteNumber((uint32_t)directory.size());
+
+        for (const auto& [nGram,count,offset] : directory) {
+          writer.WriteNumber(nGram);
+          writer.WriteNumber(count);
+          writer.WriteFileOffset(offset);
+        }
+      }
+
+      writer.SetPos(0);
+      writer.WriteFileOffset(directoryOffset);
+
+      progress.Info("{} regions, {} region n-grams, {} location n-grams, {} address n-grams",
+                    regionVisitor.regions.size(),
+                    directories[size_t(LocationNGramIndex::Section::regions)].size(),
+                    directories[size_t(LocationNGramIndex::Section::locations)].size(),
+                    directories[size_t(LocationNGramIndex::Section::addresses)].size());
+
+      writer.Close();
+    }
+    catch (const IOException& e) {
+      progress.Error(e.GetDescription());
+
+      writer.CloseFailsafe();
+
+      return false;
+    }
+
+    return true;
+  }
+
   void LocationIndexGenerator::GetDescription(const ImportParameter& /*parameter*/,
                                               ImportModuleDescription& description) const
   {
@@ -2719,6 +2976,7 @@ namespace osmscout {
     description.AddRequiredFile(AreaAreaIndexGenerator::AREAADDRESS_DAT);
 
     description.AddProvidedFile(LocationIndex::FILENAME_LOCATION_IDX);
+    description.AddProvidedFile(LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX);
 
     description.AddProvidedAnalysisFile(FILENAME_LOCATION_REGION_TXT);
     description.AddProvidedAnalysisFile(FILENAME_LOCATION_FULL_TXT);
@@ -3012,6 +3270,11 @@ namespace osmscout {
                        *rootRegion);
 
       writer.Close();
+
+      if (!WriteLocationNGramIndex(parameter,
+                                   progress)) {
+        return false;
+      }
     }
     catch (const IOException& e) {
       progress.Error(e.GetDescription());
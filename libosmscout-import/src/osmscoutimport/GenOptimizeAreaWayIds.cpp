@@ -73,28 +73,6 @@ namespace osmscout {
     {
     }
 
-    std::optional<GeoCoord> OptionalRingCenter(const Area::Ring &ring)
-    {
-      // TODO: compute center just for types where we need
-      // (types with Name feature, where it is expected that will be used for label)
-      if (ring.nodes.empty()) {
-        return std::nullopt;
-      }
-      auto bbox=ring.GetBoundingBox();
-      double dimension=std::max(bbox.GetWidth(), bbox.GetHeight());
-      auto center=PolygonCenter(ring.nodes,
-                                dimension * 0.01);
-      // when computed center is close to bbox center (20% of longest bbox side),
-      // it is not necessary to store center coordinates to Ring
-      auto bboxCenter=bbox.GetCenter();
-      auto a=bboxCenter.GetLat()-center.GetLat();
-      auto b=bboxCenter.GetLon()-center.GetLon();
-      if (sqrt(a*a + b*b) < dimension * 0.2) {
-        return std::nullopt;
-      }
-      return center;
-    }
-
     bool operator()() override
     {
       FileScanner scanner;
@@ -102,6 +80,7 @@ namespace osmscout {
 
       try {
         uint32_t idClearedCount=0;
+        uint32_t anchorCount=0;
 
         progress.SetAction("Copy data from 'areas2.tmp' to 'areas3.tmp'");
 
@@ -135,7 +114,15 @@ namespace osmscout {
                 idClearedCount++;
               }
             }
-            ring.center=OptionalRingCenter(ring);
+          }
+
+          // Store label anchors for rings, where the bounding box center is not a good label position
+          for (size_t r=0; r<data.rings.size(); r++) {
+            data.rings[r].center=RingLabelAnchor(data,r);
+
+            if (data.rings[r].center) {
+              anchorCount++;
+            }
           }
 
           writer.Write(type);
@@ -149,6 +136,7 @@ namespace osmscout {
         writer.Close();
 
         progress.Info(std::to_string(idClearedCount)+" node serials cleared");
+        progress.Info(std::to_string(anchorCount)+" label anchors stored");
       }
       catch (IOException& e) {
         progress.Error(e.GetDescription());
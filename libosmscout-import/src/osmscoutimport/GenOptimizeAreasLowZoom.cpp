@@ -34,6 +34,7 @@
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Number.h>
+#include <osmscout/util/PolygonCenter.h>
 #include <osmscout/util/TileId.h>
 #include <osmscout/util/Transformation.h>
 
@@ -285,6 +286,22 @@ namespace osmscout
         continue;
       }
 
+      // The label anchor of the original ring might not be a good anchor for the
+      // simplified ring anymore
+      for (size_t r=0; r<copiedArea->rings.size(); r++) {
+        Area::Ring& ring=copiedArea->rings[r];
+
+        if (ring.nodes.size()<3) {
+          continue;
+        }
+
+        GeoCoord anchor=ring.center ? ring.center.value() : ring.GetBoundingBox().GetCenter();
+
+        if (!IsCoordInArea(anchor,ring.nodes)) {
+          ring.center=RingLabelAnchor(*copiedArea,r);
+        }
+      }
+
       optimizedAreas.push_back(copiedArea);
     }
   }
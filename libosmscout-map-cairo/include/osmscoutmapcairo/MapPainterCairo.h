@@ -79,6 +79,7 @@ namespace osmscout {
     using CairoGlyph = Glyph<CairoNativeGlyph>;
     using CairoLabelInstance = LabelInstance<CairoNativeGlyph, CairoNativeLabel>;
     using CairoLabelLayouter = LabelLayouter<CairoNativeGlyph, CairoNativeLabel, MapPainterCairo>;
+    using CairoLabelCache = LabelCache<CairoNativeGlyph, CairoNativeLabel>;
     friend CairoLabelLayouter;
 
   private:
@@ -218,6 +219,15 @@ namespace osmscout {
                             const std::string& text,
                             double fontSize) override;
 
+    /**
+     * Set the cache for laid out labels. By default every painter has its own cache,
+     * a cache may be shared by multiple painters (for example in a pool of render threads).
+     * Passing nullptr disables caching.
+     */
+    void SetLabelCache(const std::shared_ptr<CairoLabelCache>& cache);
+
+    std::shared_ptr<CairoLabelCache> GetLabelCache() const;
+
     bool DrawMap(const Projection& projection,
                  const MapParameter& parameter,
                  const std::vector<MapData>& data,
@@ -261,7 +261,7 @@ namespace osmscout {
   MapPainterCairo::MapPainterCairo()
       : labelLayouter(this)
   {
-    // no code
+    labelLayouter.SetLabelCache(std::make_shared<CairoLabelCache>(),this);
   }
 
   MapPainterCairo::~MapPainterCairo()
@@ -958,11 +958,18 @@ namespace osmscout {
                                                                        bool /*enableWrapping*/,
                                                                        bool /*contourLabel*/)
   {
-    auto label = std::make_shared<MapPainterCairo::CairoLabel>();
+    // The label holds a reference to the font, it may be cached and outlive
+    // the font cache of this painter
+    CairoFont font = cairo_scaled_font_reference(GetFont(projection, parameter, fontSize));
+    auto label = std::shared_ptr<MapPainterCairo::CairoLabel>(new MapPainterCairo::CairoLabel(),
+                                                              [](MapPainterCairo::CairoLabel* label) {
+                                                                cairo_scaled_font_destroy(label->label.font);
+                                                                delete label;
+                                                              });
 
     label->label.wstr = UTF8StringToWString(text);
 
-    label->label.font = GetFont(projection, parameter, fontSize);
+    label->label.font = font;
 
     cairo_scaled_font_extents(label->label.font,
                               &(label->label.fontExtents));
@@ -985,12 +992,24 @@ namespace osmscout {
                                            const std::string& text,
                                            double fontSize)
   {
-    return MeasureLabel(Layout(projection, parameter, text, fontSize, 0, false, false),
+    return MeasureLabel(labelLayouter.LayoutLabel(projection, parameter, text, fontSize, 0, false, false),
                         [this](const CairoNativeGlyph& glyph) {
                           return GlyphBoundingBox(glyph);
                         });
   }
 
+  void MapPainterCairo::SetLabelCache(const std::shared_ptr<CairoLabelCache>& cache)
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    labelLayouter.SetLabelCache(cache,this);
+  }
+
+  std::shared_ptr<MapPainterCairo::CairoLabelCache> MapPainterCairo::GetLabelCache() const
+  {
+    return labelLayouter.GetLabelCache();
+  }
+
   void MapPainterCairo::DrawLabel(const Projection &/*projection*/,
                                   const MapParameter &/*parameter*/,
                                   const ScreenVectorRectangle &labelRectangle,
@@ -1009,6 +1028,9 @@ namespace osmscout {
 #if defined(OSMSCOUT_MAP_CAIRO_HAVE_LIB_PANGO)
       PangoRectangle extends;
 
+      // The layout may have been created (and cached) for another cairo context
+      pango_cairo_update_layout(draw,
+                                layout.get());
       pango_layout_get_pixel_extents(layout.get(),
                                      nullptr,
                                      &extends);
@@ -1103,6 +1125,9 @@ namespace osmscout {
 #if defined(OSMSCOUT_MAP_CAIRO_HAVE_LIB_PANGO)
       PangoRectangle extends;
 
+      // The layout may have been created (and cached) for another cairo context
+      pango_cairo_update_layout(draw,
+                                layout.get());
       pango_layout_get_pixel_extents(layout.get(),
                                      nullptr,
                                      &extends);
@@ -0,0 +1,199 @@
+#ifndef OSMSCOUT_MAP_MVT_MVTTILEENCODER_H
+#define OSMSCOUT_MAP_MVT_MVTTILEENCODER_H
+
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscoutmapmvt/MapMVTImportExport.h>
+
+#include <osmscout/TypeConfig.h>
+
+#include <osmscout/projection/TileProjection.h>
+
+#include <osmscout/util/Locale.h>
+#include <osmscout/util/Tiling.h>
+#include <osmscout/util/Transformation.h>
+
+#include <osmscoutmap/MapData.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Encodes the objects of a MapData instance as Mapbox Vector Tile (MVT, version 2).
+   *
+   * Every type results in a layer with the name of the type. Every feature of an object
+   * results in an attribute with the name of the feature: features with a label are stored
+   * with their (first) label as string value, features without value are stored as boolean
+   * flag. Other features are skipped. The feature id is derived from the object type,
+   * the file offset of the object and - for areas - the index of the ring.
+   *
+   * Geometries are transformed using a TileProjection with the size of the tile extent,
+   * simplified like for drawing using TransPolygon optimization and then clipped against
+   * the tile extended by the given buffer.
+   *
+   * An instance is not thread safe, but it can (and should) be reused for multiple tiles,
+   * to avoid reallocation of internal buffers. Use one instance per thread.
+   */
+  class OSMSCOUT_MAP_MVT_API MVTTileEncoder CLASS_FINAL
+  {
+  public:
+    static constexpr uint32_t defaultExtent=4096;
+    static constexpr uint32_t defaultBuffer=64;
+
+  private:
+    struct TilePoint
+    {
+      int32_t x;
+      int32_t y;
+
+      bool operator==(const TilePoint& other) const
+      {
+        return x==other.x && y==other.y;
+      }
+    };
+
+    struct ClipPoint
+    {
+      double x;
+      double y;
+    };
+
+    /**
+     * A layer of the tile under construction, keys, values and features are already
+     * protobuf encoded
+     */
+    struct Layer
+    {
+      std::string                               name;
+      std::vector<std::string>                  keys;
+      std::unordered_map<std::string,uint32_t>  keyIndex;
+      std::vector<std::string>                  values;
+      std::unordered_map<std::string,uint32_t>  valueIndex;
+      std::string                               features;
+      size_t                                    featureCount=0;
+    };
+
+  private:
+    uint32_t                     extent=defaultExtent;  //!< Size of the tile in tile coordinates
+    uint32_t                     buffer=defaultBuffer;  //!< Clipping buffer around the tile in tile coordinates
+    TransPolygon::OptimizeMethod optimize=TransPolygon::quality;
+    double                       errorTolerance=1.0;    //!< Error tolerance for simplification in tile coordinates
+    Locale                       locale;
+
+    TileProjection               projection;
+    TransBuffer                  transBuffer;
+
+    std::vector<Layer>           layers;                //!< Layers of the current tile
+    std::vector<size_t>          layerIndex;            //!< Index of the layer in layers by type index
+    size_t                       featureCount=0;
+
+    // Reused working buffers
+    std::vector<ClipPoint>       clipInput;
+    std::vector<ClipPoint>       clipOutput;
+    std::vector<TilePoint>       points;
+    std::vector<uint32_t>        tags;
+    std::vector<uint32_t>        geometry;
+    TilePoint                    cursor{0,0};           //!< Current position of the geometry encoding
+    std::string                  value;
+    std::string                  message;
+
+  private:
+    void Reset();
+
+    Layer& GetLayer(const TypeInfo& type);
+
+    uint32_t GetKeyIndex(Layer& layer,
+                         const std::string& key);
+    uint32_t GetValueIndex(Layer& layer);
+
+    void CollectTags(Layer& layer,
+                     const FeatureValueBuffer& buffer);
+
+    void CollectTransformedPoints();
+    void RoundPoints(const std::vector<ClipPoint>& clipped);
+    void ClipLine();
+    void ClipPolygon();
+
+    void ClearGeometry();
+    void AddPointsGeometry();
+    void AddLineGeometry();
+    bool AddRingGeometry(bool exterior);
+
+    void AddFeature(Layer& layer,
+                    uint64_t id,
+                    uint32_t geometryType);
+
+    void EncodeNode(const Node& node);
+    void EncodeWay(const Way& way);
+    void EncodeArea(const Area& area);
+
+  public:
+    MVTTileEncoder() = default;
+
+    void SetExtent(uint32_t extent);
+    void SetBuffer(uint32_t buffer);
+    void SetOptimize(TransPolygon::OptimizeMethod optimize);
+    void SetErrorTolerance(double errorTolerance);
+    void SetLocale(const Locale& locale);
+
+    uint32_t GetExtent() const
+    {
+      return extent;
+    }
+
+    uint32_t GetBuffer() const
+    {
+      return buffer;
+    }
+
+    /**
+     * Encode the objects in data as MVT tile for the given tile.
+     *
+     * The resulting tile is empty, if no object has geometry in the buffered tile.
+     *
+     * @return false, if the tile projection could not be set up
+     */
+    bool Encode(const OSMTileId& tile,
+                const Magnification& magnification,
+                const MapData& data,
+                std::string& tileData);
+
+    /**
+     * Names of the layers of the last encoded tile
+     */
+    std::vector<std::string> GetLayerNames() const;
+
+    /**
+     * Number of features of the last encoded tile
+     */
+    size_t GetFeatureCount() const
+    {
+      return featureCount;
+    }
+  };
+}
+
+#endif
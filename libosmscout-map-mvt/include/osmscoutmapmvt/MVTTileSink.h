@@ -0,0 +1,140 @@
+#ifndef OSMSCOUT_MAP_MVT_MVTTILESINK_H
+#define OSMSCOUT_MAP_MVT_MVTTILESINK_H
+
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_set>
+
+#include <osmscoutmapmvt/MapMVTImportExport.h>
+
+#include <osmscout/util/GeoBox.h>
+#include <osmscout/util/Magnification.h>
+#include <osmscout/util/Tiling.h>
+
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+struct sqlite3;
+struct sqlite3_stmt;
+#endif
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Description of a generated tile set, written as metadata by the tile sinks
+   */
+  struct OSMSCOUT_MAP_MVT_API MVTTileSetInfo
+  {
+    std::string           name;
+    std::string           description;
+    GeoBox                boundingBox;
+    MagnificationLevel    minLevel;
+    MagnificationLevel    maxLevel;
+    std::set<std::string> layers;    //!< Names of all layers in the tile set
+  };
+
+  /**
+   * \ingroup Renderer
+   *
+   * Destination for generated vector tiles.
+   *
+   * WriteTile() is called concurrently by multiple worker threads and must be thread safe.
+   */
+  class OSMSCOUT_MAP_MVT_API MVTTileSink
+  {
+  public:
+    virtual ~MVTTileSink() = default;
+
+    virtual bool Open() = 0;
+
+    virtual bool WriteTile(const MagnificationLevel& level,
+                           const OSMTileId& tile,
+                           const std::string& tileData) = 0;
+
+    virtual bool Close(const MVTTileSetInfo& info) = 0;
+  };
+
+  using MVTTileSinkRef = std::shared_ptr<MVTTileSink>;
+
+  /**
+   * \ingroup Renderer
+   *
+   * Writes the tiles as "<directory>/<level>/<x>/<y>.pbf" (uncompressed) and the
+   * tile set description as "<directory>/metadata.json".
+   */
+  class OSMSCOUT_MAP_MVT_API MVTDirectoryTileSink CLASS_FINAL : public MVTTileSink
+  {
+  private:
+    std::string                     directory;
+    std::mutex                      mutex;              //!< Protects createdDirectories
+    std::unordered_set<std::string> createdDirectories;
+
+  public:
+    explicit MVTDirectoryTileSink(const std::string& directory);
+
+    bool Open() override;
+
+    bool WriteTile(const MagnificationLevel& level,
+                   const OSMTileId& tile,
+                   const std::string& tileData) override;
+
+    bool Close(const MVTTileSetInfo& info) override;
+  };
+
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+  /**
+   * \ingroup Renderer
+   *
+   * Writes the tiles into a MBTiles (1.3) sqlite database. Tiles are gzip compressed,
+   * if zlib is available. All tiles are written in one transaction, which is committed
+   * by Close().
+   */
+  class OSMSCOUT_MAP_MVT_API MVTMBTilesTileSink CLASS_FINAL : public MVTTileSink
+  {
+  private:
+    std::string  filename;
+    std::mutex   mutex;          //!< Protects the database connection
+    sqlite3*     db=nullptr;
+    sqlite3_stmt *insertStatement=nullptr;
+
+  private:
+    bool Execute(const std::string& sql);
+    void Cleanup();
+
+  public:
+    explicit MVTMBTilesTileSink(const std::string& filename);
+    ~MVTMBTilesTileSink() override;
+
+    bool Open() override;
+
+    bool WriteTile(const MagnificationLevel& level,
+                   const OSMTileId& tile,
+                   const std::string& tileData) override;
+
+    bool Close(const MVTTileSetInfo& info) override;
+  };
+#endif
+}
+
+#endif
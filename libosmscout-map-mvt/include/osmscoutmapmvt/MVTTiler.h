@@ -0,0 +1,111 @@
+#ifndef OSMSCOUT_MAP_MVT_MVTTILER_H
+#define OSMSCOUT_MAP_MVT_MVTTILER_H
+
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <string>
+
+#include <osmscoutmapmvt/MapMVTImportExport.h>
+
+#include <osmscoutmapmvt/MVTTileSink.h>
+
+#include <osmscout/async/Breaker.h>
+
+#include <osmscout/util/GeoBox.h>
+#include <osmscout/util/Magnification.h>
+
+#include <osmscoutmap/MapService.h>
+#include <osmscoutmap/StyleConfig.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Renderer
+   *
+   * Generates a pyramid of vector tiles for a bounding box and a range of magnification levels.
+   *
+   * The tiles are distributed over a number of worker threads. Every worker loads the data
+   * for its tile via the shared MapService (objects are selected by the style sheet as for
+   * drawing), encodes it with its own MVTTileEncoder and passes the result to the sink.
+   *
+   * The MapService data cache should be large enough to hold the data tiles of all workers,
+   * see MapService::SetCacheSize().
+   */
+  class OSMSCOUT_MAP_MVT_API MVTTiler CLASS_FINAL
+  {
+  public:
+    struct OSMSCOUT_MAP_MVT_API Statistics
+    {
+      size_t tileCount=0;      //!< Number of processed tiles
+      size_t emptyTileCount=0; //!< Number of tiles without any feature
+      size_t featureCount=0;   //!< Number of encoded features
+      size_t byteCount=0;      //!< Size of all encoded tiles
+      double loadTime=0.0;     //!< Time spent loading data, summed over all workers (milliseconds)
+      double encodeTime=0.0;   //!< Time spent encoding, summed over all workers (milliseconds)
+      double writeTime=0.0;    //!< Time spent writing to the sink, summed over all workers (milliseconds)
+      double totalTime=0.0;    //!< Wall clock time (milliseconds)
+
+      double GetTilesPerSecond() const
+      {
+        return totalTime>0.0 ? double(tileCount)*1000.0/totalTime : 0.0;
+      }
+    };
+
+  private:
+    MapServiceRef       mapService;
+    StyleConfigRef      styleConfig;
+    AreaSearchParameter searchParameter;
+    size_t              threadCount;
+    uint32_t            extent;
+    uint32_t            buffer;
+    bool                writeEmptyTiles=false;
+    std::string         name;
+    BreakerRef          breaker;
+
+  public:
+    MVTTiler(const MapServiceRef& mapService,
+             const StyleConfigRef& styleConfig);
+
+    void SetSearchParameter(const AreaSearchParameter& parameter);
+    void SetThreadCount(size_t threadCount);
+    void SetExtent(uint32_t extent);
+    void SetBuffer(uint32_t buffer);
+    void SetWriteEmptyTiles(bool writeEmptyTiles);
+    void SetName(const std::string& name);
+    void SetBreaker(const BreakerRef& breaker);
+
+    /**
+     * Generate all tiles covering the given bounding box for the given range of magnification
+     * levels and write them to the sink. The sink is opened before and closed after
+     * processing.
+     *
+     * @return false, if the sink could not be opened or closed, writing of a tile failed or
+     *    the process was aborted by the breaker
+     */
+    bool Process(const GeoBox& boundingBox,
+                 const MagnificationLevel& startLevel,
+                 const MagnificationLevel& endLevel,
+                 MVTTileSink& sink,
+                 Statistics& statistics);
+  };
+}
+
+#endif
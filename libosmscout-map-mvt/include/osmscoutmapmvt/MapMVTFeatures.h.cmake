@@ -0,0 +1,9 @@
+#ifndef LIBOSMSCOUT_MAP_MVT_FEATURES
+#define LIBOSMSCOUT_MAP_MVT_FEATURES
+
+#ifndef OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3
+/* sqlite3 found, MBTiles output available */
+#cmakedefine OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3
+#endif
+
+#endif
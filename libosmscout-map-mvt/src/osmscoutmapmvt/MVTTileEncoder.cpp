@@ -0,0 +1,738 @@
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmapmvt/MVTTileEncoder.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <osmscout/ObjectRef.h>
+
+namespace osmscout {
+
+  // Protobuf wire types and MVT message field numbers, see vector_tile.proto of the
+  // Mapbox Vector Tile specification (version 2.1)
+  static const uint32_t wireTypeVarint = 0;
+  static const uint32_t wireTypeLength = 2;
+
+  static const uint32_t tileLayers     = 3;
+
+  static const uint32_t layerName      = 1;
+  static const uint32_t layerFeatures  = 2;
+  static const uint32_t layerKeys      = 3;
+  static const uint32_t layerValues    = 4;
+  static const uint32_t layerExtent    = 5;
+  static const uint32_t layerVersion   = 15;
+
+  static const uint32_t featureId       = 1;
+  static const uint32_t featureTags     = 2;
+  static const uint32_t featureType     = 3;
+  static const uint32_t featureGeometry = 4;
+
+  static const uint32_t valueString    = 1;
+  static const uint32_t valueBool      = 7;
+
+  static const uint32_t geomTypePoint      = 1;
+  static const uint32_t geomTypeLineString = 2;
+  static const uint32_t geomTypePolygon    = 3;
+
+  static const uint32_t commandMoveTo    = 1;
+  static const uint32_t commandLineTo    = 2;
+  static const uint32_t commandClosePath = 7;
+
+  /**
+   * Feature ids must be unique within a layer, but file offsets of nodes, ways and areas
+   * overlap and an area results in one feature per ring. The object type is stored in
+   * the lowest bits, the ring index is added to the file offset of the area. This is
+   * unique, since every ring takes at least one byte in the area data file.
+   */
+  static uint64_t FeatureId(RefType type,
+                            FileOffset offset,
+                            size_t ring=0)
+  {
+    return ((offset+ring) << 2) | uint64_t(type);
+  }
+
+  static void WriteVarint(std::string& out,
+                          uint64_t value)
+  {
+    while (value>=0x80) {
+      out.push_back(char((value & 0x7f) | 0x80));
+      value>>=7;
+    }
+
+    out.push_back(char(value));
+  }
+
+  static void WriteKey(std::string& out,
+                       uint32_t field,
+                       uint32_t wireType)
+  {
+    WriteVarint(out,(field << 3) | wireType);
+  }
+
+  static void WriteVarintField(std::string& out,
+                               uint32_t field,
+                               uint64_t value)
+  {
+    WriteKey(out,field,wireTypeVarint);
+    WriteVarint(out,value);
+  }
+
+  static void WriteBytesField(std::string& out,
+                              uint32_t field,
+                              const std::string& bytes)
+  {
+    WriteKey(out,field,wireTypeLength);
+    WriteVarint(out,bytes.size());
+    out.append(bytes);
+  }
+
+  static void WritePackedField(std::string& out,
+                               uint32_t field,
+                               const std::vector<uint32_t>& values)
+  {
+    size_t size=0;
+
+    for (uint32_t value : values) {
+      size++;
+      while (value>=0x80) {
+        size++;
+        value>>=7;
+      }
+    }
+
+    WriteKey(out,field,wireTypeLength);
+    WriteVarint(out,size);
+
+    for (uint32_t value : values) {
+      WriteVarint(out,value);
+    }
+  }
+
+  static uint32_t CommandInteger(uint32_t command,
+                                 size_t count)
+  {
+    return (command & 0x7) | (uint32_t(count) << 3);
+  }
+
+  static uint32_t ZigZag(int32_t value)
+  {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+  }
+
+  /**
+   * Clip the line from a to b against the given box (Liang-Barsky).
+   *
+   * @return false, if the line is completely outside, else a and b are moved to the
+   * visible part of the line
+   */
+  static bool ClipSegment(double min,
+                          double max,
+                          double& ax, double& ay,
+                          double& bx, double& by)
+  {
+    double t0=0.0;
+    double t1=1.0;
+    double dx=bx-ax;
+    double dy=by-ay;
+
+    const double p[4]={-dx,dx,-dy,dy};
+    const double q[4]={ax-min,max-ax,ay-min,max-ay};
+
+    for (size_t i=0; i<4; i++) {
+      if (p[i]==0.0) {
+        if (q[i]<0.0) {
+          return false;
+        }
+
+        continue;
+      }
+
+      double t=q[i]/p[i];
+
+      if (p[i]<0.0) {
+        if (t>t1) {
+          return false;
+        }
+        t0=std::max(t0,t);
+      }
+      else {
+        if (t<t0) {
+          return false;
+        }
+        t1=std::min(t1,t);
+      }
+    }
+
+    // Keep unclipped end points exact, so that consecutive segments stay connected
+    if (t1<1.0) {
+      bx=ax+t1*dx;
+      by=ay+t1*dy;
+    }
+
+    if (t0>0.0) {
+      ax+=t0*dx;
+      ay+=t0*dy;
+    }
+
+    return true;
+  }
+
+  void MVTTileEncoder::SetExtent(uint32_t extent)
+  {
+    this->extent=extent;
+  }
+
+  void MVTTileEncoder::SetBuffer(uint32_t buffer)
+  {
+    this->buffer=buffer;
+  }
+
+  void MVTTileEncoder::SetOptimize(TransPolygon::OptimizeMethod optimize)
+  {
+    this->optimize=optimize;
+  }
+
+  void MVTTileEncoder::SetErrorTolerance(double errorTolerance)
+  {
+    this->errorTolerance=errorTolerance;
+  }
+
+  void MVTTileEncoder::SetLocale(const Locale& locale)
+  {
+    this->locale=locale;
+  }
+
+  void MVTTileEncoder::Reset()
+  {
+    layers.clear();
+    std::fill(layerIndex.begin(),layerIndex.end(),std::numeric_limits<size_t>::max());
+    featureCount=0;
+  }
+
+  MVTTileEncoder::Layer& MVTTileEncoder::GetLayer(const TypeInfo& type)
+  {
+    if (type.GetIndex()>=layerIndex.size()) {
+      layerIndex.resize(type.GetIndex()+1,std::numeric_limits<size_t>::max());
+    }
+
+    size_t& index=layerIndex[type.GetIndex()];
+
+    if (index==std::numeric_limits<size_t>::max()) {
+      index=layers.size();
+      layers.emplace_back();
+      layers.back().name=type.GetName();
+    }
+
+    return layers[index];
+  }
+
+  uint32_t MVTTileEncoder::GetKeyIndex(Layer& layer,
+                                       const std::string& key)
+  {
+    auto entry=layer.keyIndex.find(key);
+
+    if (entry!=layer.keyIndex.end()) {
+      return entry->second;
+    }
+
+    auto index=uint32_t(layer.keys.size());
+
+    layer.keys.push_back(key);
+    layer.keyIndex.emplace(key,index);
+
+    return index;
+  }
+
+  /**
+   * Return the index of the value currently encoded in 'value'
+   */
+  uint32_t MVTTileEncoder::GetValueIndex(Layer& layer)
+  {
+    auto entry=layer.valueIndex.find(value);
+
+    if (entry!=layer.valueIndex.end()) {
+      return entry->second;
+    }
+
+    auto index=uint32_t(layer.values.size());
+
+    layer.values.push_back(value);
+    layer.valueIndex.emplace(value,index);
+
+    return index;
+  }
+
+  void MVTTileEncoder::CollectTags(Layer& layer,
+                                   const FeatureValueBuffer& buffer)
+  {
+    tags.clear();
+
+    for (size_t idx=0; idx<buffer.GetFeatureCount(); idx++) {
+      if (!buffer.HasFeature(idx)) {
+        continue;
+      }
+
+      const FeatureRef& feature=buffer.GetFeature(idx).GetFeature();
+
+      value.clear();
+
+      if (!feature->HasValue()) {
+        WriteVarintField(value,valueBool,1);
+      }
+      else if (feature->HasLabel()) {
+        const FeatureValue* featureValue=buffer.GetValue(idx);
+        std::string         label=featureValue!=nullptr ? featureValue->GetLabel(locale,0) : "";
+
+        if (label.empty()) {
+          continue;
+        }
+
+        WriteBytesField(value,valueString,label);
+      }
+      else {
+        continue;
+      }
+
+      tags.push_back(GetKeyIndex(layer,feature->GetName()));
+      tags.push_back(GetValueIndex(layer));
+    }
+  }
+
+  /**
+   * Copy the to be drawn points of the TransBuffer to clipInput
+   */
+  void MVTTileEncoder::CollectTransformedPoints()
+  {
+    clipInput.clear();
+
+    if (transBuffer.IsEmpty()) {
+      return;
+    }
+
+    for (size_t i=transBuffer.GetStart(); i<=transBuffer.GetEnd(); i++) {
+      if (transBuffer.points[i].draw) {
+        clipInput.push_back(ClipPoint{transBuffer.points[i].x,
+                                      transBuffer.points[i].y});
+      }
+    }
+  }
+
+  /**
+   * Round the clipped points to tile coordinates, dropping duplicates
+   */
+  void MVTTileEncoder::RoundPoints(const std::vector<ClipPoint>& clipped)
+  {
+    points.clear();
+
+    for (const auto& point : clipped) {
+      TilePoint tilePoint{int32_t(std::lround(point.x)),
+                          int32_t(std::lround(point.y))};
+
+      if (points.empty() || !(points.back()==tilePoint)) {
+        points.push_back(tilePoint);
+      }
+    }
+  }
+
+  /**
+   * Clip the line in clipInput against the buffered tile and add all visible
+   * parts to the feature geometry
+   */
+  void MVTTileEncoder::ClipLine()
+  {
+    double min=-double(buffer);
+    double max=double(extent+buffer);
+
+    ClearGeometry();
+    clipOutput.clear();
+
+    for (size_t i=1; i<clipInput.size(); i++) {
+      double ax=clipInput[i-1].x;
+      double ay=clipInput[i-1].y;
+      double bx=clipInput[i].x;
+      double by=clipInput[i].y;
+
+      if (!ClipSegment(min,max,ax,ay,bx,by)) {
+        continue;
+      }
+
+      if (clipOutput.empty() ||
+          clipOutput.back().x!=ax ||
+          clipOutput.back().y!=ay) {
+        RoundPoints(clipOutput);
+        AddLineGeometry();
+        clipOutput.clear();
+        clipOutput.push_back(ClipPoint{ax,ay});
+      }
+
+      clipOutput.push_back(ClipPoint{bx,by});
+    }
+
+    RoundPoints(clipOutput);
+    AddLineGeometry();
+  }
+
+  /**
+   * Clip the polygon in clipInput against the buffered tile (Sutherland-Hodgman).
+   * The result is in clipInput.
+   */
+  void MVTTileEncoder::ClipPolygon()
+  {
+    double min=-double(buffer);
+    double max=double(extent+buffer);
+
+    for (size_t edge=0; edge<4 && !clipInput.empty(); edge++) {
+      auto inside=[edge,min,max](const ClipPoint& point) {
+        switch (edge) {
+        case 0:
+          return point.x>=min;
+        case 1:
+          return point.x<=max;
+        case 2:
+          return point.y>=min;
+        default:
+          return point.y<=max;
+        }
+      };
+
+      auto intersect=[edge,min,max](const ClipPoint& a,
+                                    const ClipPoint& b) {
+        double border=(edge%2==0) ? min : max;
+
+        if (edge<2) {
+          return ClipPoint{border,a.y+(b.y-a.y)*(border-a.x)/(b.x-a.x)};
+        }
+
+        return ClipPoint{a.x+(b.x-a.x)*(border-a.y)/(b.y-a.y),border};
+      };
+
+      clipOutput.clear();
+
+      const ClipPoint* previous=&clipInput.back();
+
+      for (const auto& current : clipInput) {
+        bool currentInside=inside(current);
+
+        if (currentInside) {
+          if (!inside(*previous)) {
+            clipOutput.push_back(intersect(*previous,current));
+          }
+          clipOutput.push_back(current);
+        }
+        else if (inside(*previous)) {
+          clipOutput.push_back(intersect(*previous,current));
+        }
+
+        previous=&current;
+      }
+
+      std::swap(clipInput,clipOutput);
+    }
+  }
+
+  void MVTTileEncoder::ClearGeometry()
+  {
+    geometry.clear();
+    cursor=TilePoint{0,0};
+  }
+
+  /**
+   * Add a MoveTo for the first and a LineTo for all following points. Coordinates
+   * are relative to the cursor, which is the last point of the previous part.
+   */
+  void MVTTileEncoder::AddPointsGeometry()
+  {
+    for (size_t i=0; i<points.size(); i++) {
+      if (i==0) {
+        geometry.push_back(CommandInteger(commandMoveTo,1));
+      }
+      else if (i==1) {
+        geometry.push_back(CommandInteger(commandLineTo,points.size()-1));
+      }
+
+      geometry.push_back(ZigZag(points[i].x-cursor.x));
+      geometry.push_back(ZigZag(points[i].y-cursor.y));
+      cursor=points[i];
+    }
+  }
+
+  void MVTTileEncoder::AddLineGeometry()
+  {
+    if (points.size()<2) {
+      return;
+    }
+
+    AddPointsGeometry();
+  }
+
+  /**
+   * Add the ring in points to the feature geometry.
+   *
+   * @return false, if the ring is degenerated and was not added
+   */
+  bool MVTTileEncoder::AddRingGeometry(bool exterior)
+  {
+    while (points.size()>1 && points.front()==points.back()) {
+      points.pop_back();
+    }
+
+    if (points.size()<3) {
+      return false;
+    }
+
+    int64_t area=0;
+
+    for (size_t i=0; i<points.size(); i++) {
+      const TilePoint& a=points[i];
+      const TilePoint& b=points[(i+1)%points.size()];
+
+      area+=int64_t(a.x)*int64_t(b.y)-int64_t(b.x)*int64_t(a.y);
+    }
+
+    if (area==0) {
+      return false;
+    }
+
+    // In tile coordinates (y pointing down) exterior rings must have a positive area
+    // (clockwise), interior rings a negative area
+    if ((area>0)!=exterior) {
+      std::reverse(points.begin(),points.end());
+    }
+
+    AddPointsGeometry();
+    geometry.push_back(CommandInteger(commandClosePath,1));
+
+    return true;
+  }
+
+  void MVTTileEncoder::AddFeature(Layer& layer,
+                                  uint64_t id,
+                                  uint32_t geometryType)
+  {
+    message.clear();
+
+    WriteVarintField(message,featureId,id);
+
+    if (!tags.empty()) {
+      WritePackedField(message,featureTags,tags);
+    }
+
+    WriteVarintField(message,featureType,geometryType);
+    WritePackedField(message,featureGeometry,geometry);
+
+    WriteBytesField(layer.features,layerFeatures,message);
+    layer.featureCount++;
+    featureCount++;
+  }
+
+  void MVTTileEncoder::EncodeNode(const Node& node)
+  {
+    Vertex2D pixel;
+
+    projection.GeoToPixel(node.GetCoords(),pixel);
+
+    TilePoint point{int32_t(std::lround(pixel.GetX())),
+                    int32_t(std::lround(pixel.GetY()))};
+
+    if (point.x<-int32_t(buffer) || point.x>int32_t(extent+buffer) ||
+        point.y<-int32_t(buffer) || point.y>int32_t(extent+buffer)) {
+      return;
+    }
+
+    ClearGeometry();
+    points.assign(1,point);
+    AddPointsGeometry();
+
+    Layer& layer=GetLayer(*node.GetType());
+
+    CollectTags(layer,
+                node.GetFeatureValueBuffer());
+    AddFeature(layer,
+               FeatureId(refNode,node.GetFileOffset()),
+               geomTypePoint);
+  }
+
+  void MVTTileEncoder::EncodeWay(const Way& way)
+  {
+    TransformWay(way.nodes,
+                 transBuffer,
+                 projection,
+                 optimize,
+                 errorTolerance);
+
+    CollectTransformedPoints();
+    ClipLine();
+
+    if (geometry.empty()) {
+      return;
+    }
+
+    Layer& layer=GetLayer(*way.GetType());
+
+    CollectTags(layer,
+                way.GetFeatureValueBuffer());
+    AddFeature(layer,
+               FeatureId(refWay,way.GetFileOffset()),
+               geomTypeLineString);
+  }
+
+  /**
+   * Every ring with a (not ignored) type results in a polygon feature, with the
+   * directly nested rings as holes - like the map painter handles clipping rings.
+   */
+  void MVTTileEncoder::EncodeArea(const Area& area)
+  {
+    area.VisitRings([this,&area](size_t i,
+                                 const Area::Ring& ring,
+                                 const TypeInfoRef& type)->bool {
+      if (ring.nodes.size()<3 ||
+          type->GetIgnore()) {
+        return true;
+      }
+
+      ClearGeometry();
+
+      TransformArea(ring.nodes,
+                    transBuffer,
+                    projection,
+                    optimize,
+                    errorTolerance);
+
+      CollectTransformedPoints();
+      ClipPolygon();
+      RoundPoints(clipInput);
+
+      if (!AddRingGeometry(true)) {
+        return true;
+      }
+
+      area.VisitClippingRings(i,[this](size_t,
+                                       const Area::Ring& hole,
+                                       const TypeInfoRef&)->bool {
+        if (hole.nodes.size()<3) {
+          return true;
+        }
+
+        TransformArea(hole.nodes,
+                      transBuffer,
+                      projection,
+                      optimize,
+                      errorTolerance);
+
+        CollectTransformedPoints();
+        ClipPolygon();
+        RoundPoints(clipInput);
+        AddRingGeometry(false);
+
+        return true;
+      });
+
+      Layer& layer=GetLayer(*type);
+
+      // Outer rings without own type inherit type and features from the area
+      const FeatureValueBuffer& features=ring.GetType()==type ? ring.GetFeatureValueBuffer() : area.GetFeatureValueBuffer();
+
+      CollectTags(layer,
+                  features);
+      AddFeature(layer,
+                 FeatureId(refArea,area.GetFileOffset(),i),
+                 geomTypePolygon);
+
+      return true;
+    });
+  }
+
+  bool MVTTileEncoder::Encode(const OSMTileId& tile,
+                              const Magnification& magnification,
+                              const MapData& data,
+                              std::string& tileData)
+  {
+    tileData.clear();
+    Reset();
+
+    if (!projection.Set(tile,
+                        magnification,
+                        extent,
+                        extent)) {
+      return false;
+    }
+
+    for (const auto& area : data.areas) {
+      EncodeArea(*area);
+    }
+
+    for (const auto& area : data.poiAreas) {
+      EncodeArea(*area);
+    }
+
+    for (const auto& way : data.ways) {
+      EncodeWay(*way);
+    }
+
+    for (const auto& way : data.poiWays) {
+      EncodeWay(*way);
+    }
+
+    for (const auto& node : data.nodes) {
+      EncodeNode(*node);
+    }
+
+    for (const auto& node : data.poiNodes) {
+      EncodeNode(*node);
+    }
+
+    for (const auto& layer : layers) {
+      message.clear();
+
+      WriteVarintField(message,layerVersion,2);
+      WriteBytesField(message,layerName,layer.name);
+      message.append(layer.features);
+
+      for (const auto& key : layer.keys) {
+        WriteBytesField(message,layerKeys,key);
+      }
+
+      for (const auto& layerValue : layer.values) {
+        WriteBytesField(message,layerValues,layerValue);
+      }
+
+      WriteVarintField(message,layerExtent,extent);
+
+      WriteBytesField(tileData,tileLayers,message);
+    }
+
+    return true;
+  }
+
+  std::vector<std::string> MVTTileEncoder::GetLayerNames() const
+  {
+    std::vector<std::string> names;
+
+    names.reserve(layers.size());
+
+    for (const auto& layer : layers) {
+      names.push_back(layer.name);
+    }
+
+    return names;
+  }
+}
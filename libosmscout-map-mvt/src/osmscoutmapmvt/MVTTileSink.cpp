@@ -0,0 +1,402 @@
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmapmvt/MVTTileSink.h>
+
+#include <osmscoutmapmvt/private/Config.h>
+
+#include <filesystem>
+#include <sstream>
+
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+  #include <sqlite3.h>
+#endif
+
+#if defined(HAVE_LIB_ZLIB)
+  #include <zlib.h>
+#endif
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/String.h>
+
+namespace osmscout {
+
+  static std::string EscapeJSON(const std::string& value)
+  {
+    std::string result;
+
+    result.reserve(value.size());
+
+    for (char c : value) {
+      if (c=='"' || c=='\\') {
+        result.push_back('\\');
+        result.push_back(c);
+      }
+      else if (static_cast<unsigned char>(c)<0x20) {
+        result.push_back(' ');
+      }
+      else {
+        result.push_back(c);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Return the bounds in MBTiles notation "left,bottom,right,top"
+   */
+  static std::string GetBounds(const GeoBox& boundingBox)
+  {
+    std::ostringstream stream;
+
+    stream.imbue(std::locale::classic());
+    stream << boundingBox.GetMinLon() << "," << boundingBox.GetMinLat() << ","
+           << boundingBox.GetMaxLon() << "," << boundingBox.GetMaxLat();
+
+    return stream.str();
+  }
+
+  /**
+   * Return the "vector_layers" description as required by the MBTiles specification
+   */
+  static std::string GetVectorLayersJSON(const MVTTileSetInfo& info)
+  {
+    std::string json="{\"vector_layers\":[";
+    bool        first=true;
+
+    for (const auto& layer : info.layers) {
+      if (!first) {
+        json+=",";
+      }
+
+      json+="{\"id\":\""+EscapeJSON(layer)+"\",\"fields\":{},"+
+            "\"minzoom\":"+std::to_string(info.minLevel.Get())+","+
+            "\"maxzoom\":"+std::to_string(info.maxLevel.Get())+"}";
+      first=false;
+    }
+
+    json+="]}";
+
+    return json;
+  }
+
+  MVTDirectoryTileSink::MVTDirectoryTileSink(const std::string& directory)
+  : directory(directory)
+  {
+    // no code
+  }
+
+  bool MVTDirectoryTileSink::Open()
+  {
+    std::error_code error;
+
+    std::filesystem::create_directories(directory,error);
+
+    if (error) {
+      log.Error() << "Cannot create directory '" << directory << "': " << error.message();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool MVTDirectoryTileSink::WriteTile(const MagnificationLevel& level,
+                                       const OSMTileId& tile,
+                                       const std::string& tileData)
+  {
+    std::string tileDirectory=AppendFileToDir(AppendFileToDir(directory,
+                                                              std::to_string(level.Get())),
+                                              std::to_string(tile.GetX()));
+
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      if (createdDirectories.find(tileDirectory)==createdDirectories.end()) {
+        std::error_code error;
+
+        std::filesystem::create_directories(tileDirectory,error);
+
+        if (error) {
+          log.Error() << "Cannot create directory '" << tileDirectory << "': " << error.message();
+          return false;
+        }
+
+        createdDirectories.insert(tileDirectory);
+      }
+    }
+
+    FileWriter writer;
+
+    try {
+      writer.Open(AppendFileToDir(tileDirectory,
+                                  std::to_string(tile.GetY())+".pbf"));
+      writer.Write(tileData.data(),
+                   tileData.size());
+      writer.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool MVTDirectoryTileSink::Close(const MVTTileSetInfo& info)
+  {
+    std::string json="{\"name\":\""+EscapeJSON(info.name)+"\","+
+                     "\"description\":\""+EscapeJSON(info.description)+"\","+
+                     "\"format\":\"pbf\","+
+                     "\"bounds\":\""+GetBounds(info.boundingBox)+"\","+
+                     "\"minzoom\":"+std::to_string(info.minLevel.Get())+","+
+                     "\"maxzoom\":"+std::to_string(info.maxLevel.Get())+","+
+                     "\"json\":\""+EscapeJSON(GetVectorLayersJSON(info))+"\"}\n";
+
+    FileWriter writer;
+
+    try {
+      writer.Open(AppendFileToDir(directory,"metadata.json"));
+      writer.Write(json.data(),
+                   json.size());
+      writer.Close();
+    }
+    catch (IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      return false;
+    }
+
+    return true;
+  }
+
+#if defined(OSMSCOUT_MAP_MVT_HAVE_LIB_SQLITE3)
+
+#if defined(HAVE_LIB_ZLIB)
+  static bool Compress(const std::string& data,
+                       std::string& compressed)
+  {
+    z_stream stream{};
+
+    // windowBits 15+16 results in gzip instead of zlib format
+    if (deflateInit2(&stream,
+                     Z_DEFAULT_COMPRESSION,
+                     Z_DEFLATED,
+                     15+16,
+                     8,
+                     Z_DEFAULT_STRATEGY)!=Z_OK) {
+      return false;
+    }
+
+    compressed.resize(deflateBound(&stream,uLong(data.size())));
+
+    stream.next_in=reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in=uInt(data.size());
+    stream.next_out=reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out=uInt(compressed.size());
+
+    int result=deflate(&stream,Z_FINISH);
+
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return result==Z_STREAM_END;
+  }
+#endif
+
+  MVTMBTilesTileSink::MVTMBTilesTileSink(const std::string& filename)
+  : filename(filename)
+  {
+    // no code
+  }
+
+  MVTMBTilesTileSink::~MVTMBTilesTileSink()
+  {
+    Cleanup();
+  }
+
+  bool MVTMBTilesTileSink::Execute(const std::string& sql)
+  {
+    char* errorMessage=nullptr;
+
+    if (sqlite3_exec(db,sql.c_str(),nullptr,nullptr,&errorMessage)!=SQLITE_OK) {
+      log.Error() << "Cannot execute '" << sql << "' on '" << filename << "': "
+                  << (errorMessage!=nullptr ? errorMessage : "");
+      sqlite3_free(errorMessage);
+      return false;
+    }
+
+    return true;
+  }
+
+  void MVTMBTilesTileSink::Cleanup()
+  {
+    if (insertStatement!=nullptr) {
+      sqlite3_finalize(insertStatement);
+      insertStatement=nullptr;
+    }
+
+    if (db!=nullptr) {
+      sqlite3_close(db);
+      db=nullptr;
+    }
+  }
+
+  bool MVTMBTilesTileSink::Open()
+  {
+    if (ExistsInFilesystem(filename) &&
+        !RemoveFile(filename)) {
+      log.Error() << "Cannot remove existing file '" << filename << "'";
+      return false;
+    }
+
+    if (sqlite3_open(filename.c_str(),&db)!=SQLITE_OK) {
+      log.Error() << "Cannot open '" << filename << "': " << sqlite3_errmsg(db);
+      Cleanup();
+      return false;
+    }
+
+    if (!Execute("PRAGMA synchronous=OFF") ||
+        !Execute("PRAGMA journal_mode=MEMORY") ||
+        !Execute("CREATE TABLE metadata (name TEXT, value TEXT)") ||
+        !Execute("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB)") ||
+        !Execute("CREATE UNIQUE INDEX tile_index ON tiles (zoom_level, tile_column, tile_row)") ||
+        !Execute("BEGIN TRANSACTION")) {
+      Cleanup();
+      return false;
+    }
+
+    if (sqlite3_prepare_v2(db,
+                           "INSERT OR REPLACE INTO tiles (zoom_level, tile_column, tile_row, tile_data) VALUES (?, ?, ?, ?)",
+                           -1,
+                           &insertStatement,
+                           nullptr)!=SQLITE_OK) {
+      log.Error() << "Cannot prepare statement for '" << filename << "': " << sqlite3_errmsg(db);
+      Cleanup();
+      return false;
+    }
+
+    return true;
+  }
+
+  bool MVTMBTilesTileSink::WriteTile(const MagnificationLevel& level,
+                                     const OSMTileId& tile,
+                                     const std::string& tileData)
+  {
+#if defined(HAVE_LIB_ZLIB)
+    std::string compressed;
+
+    if (!Compress(tileData,compressed)) {
+      log.Error() << "Cannot compress tile " << level.Get() << "/" << tile.GetDisplayText();
+      return false;
+    }
+
+    const std::string& data=compressed;
+#else
+    const std::string& data=tileData;
+#endif
+
+    // MBTiles uses the TMS tile scheme, with y pointing north
+    uint32_t row=(uint32_t(1) << level.Get())-1-tile.GetY();
+
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    if (insertStatement==nullptr) {
+      return false;
+    }
+
+    sqlite3_bind_int(insertStatement,1,int(level.Get()));
+    sqlite3_bind_int64(insertStatement,2,tile.GetX());
+    sqlite3_bind_int64(insertStatement,3,row);
+    sqlite3_bind_blob(insertStatement,4,data.data(),int(data.size()),SQLITE_STATIC);
+
+    int result=sqlite3_step(insertStatement);
+
+    sqlite3_reset(insertStatement);
+    sqlite3_clear_bindings(insertStatement);
+
+    if (result!=SQLITE_DONE) {
+      log.Error() << "Cannot write tile to '" << filename << "': " << sqlite3_errmsg(db);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool MVTMBTilesTileSink::Close(const MVTTileSetInfo& info)
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    if (db==nullptr) {
+      return false;
+    }
+
+    sqlite3_stmt* statement=nullptr;
+
+    if (sqlite3_prepare_v2(db,
+                           "INSERT INTO metadata (name, value) VALUES (?, ?)",
+                           -1,
+                           &statement,
+                           nullptr)!=SQLITE_OK) {
+      log.Error() << "Cannot prepare statement for '" << filename << "': " << sqlite3_errmsg(db);
+      Cleanup();
+      return false;
+    }
+
+    const std::pair<std::string,std::string> metadata[]={
+      {"name",info.name},
+      {"description",info.description},
+      {"format","pbf"},
+      {"type","baselayer"},
+      {"version","1"},
+      {"bounds",GetBounds(info.boundingBox)},
+      {"minzoom",std::to_string(info.minLevel.Get())},
+      {"maxzoom",std::to_string(info.maxLevel.Get())},
+      {"json",GetVectorLayersJSON(info)}
+    };
+
+    bool success=true;
+
+    for (const auto& [name,value] : metadata) {
+      sqlite3_bind_text(statement,1,name.c_str(),-1,SQLITE_STATIC);
+      sqlite3_bind_text(statement,2,value.c_str(),-1,SQLITE_STATIC);
+
+      if (sqlite3_step(statement)!=SQLITE_DONE) {
+        log.Error() << "Cannot write metadata to '" << filename << "': " << sqlite3_errmsg(db);
+        success=false;
+      }
+
+      sqlite3_reset(statement);
+    }
+
+    sqlite3_finalize(statement);
+
+    success=Execute("COMMIT") && success;
+
+    Cleanup();
+
+    return success;
+  }
+#endif
+}
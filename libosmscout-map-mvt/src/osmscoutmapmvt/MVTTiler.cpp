@@ -0,0 +1,263 @@
+/*
+  This source is part of the libosmscout-map-mvt library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmapmvt/MVTTiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/StopClock.h>
+#include <osmscout/util/Tiling.h>
+
+#include <osmscoutmapmvt/MVTTileEncoder.h>
+
+namespace osmscout {
+
+  MVTTiler::MVTTiler(const MapServiceRef& mapService,
+                     const StyleConfigRef& styleConfig)
+  : mapService(mapService),
+    styleConfig(styleConfig),
+    threadCount(std::max((unsigned int)1,std::thread::hardware_concurrency())),
+    extent(MVTTileEncoder::defaultExtent),
+    buffer(MVTTileEncoder::defaultBuffer)
+  {
+    searchParameter.SetUseLowZoomOptimization(true);
+  }
+
+  void MVTTiler::SetSearchParameter(const AreaSearchParameter& parameter)
+  {
+    this->searchParameter=parameter;
+  }
+
+  void MVTTiler::SetThreadCount(size_t threadCount)
+  {
+    this->threadCount=std::max(size_t(1),threadCount);
+  }
+
+  void MVTTiler::SetExtent(uint32_t extent)
+  {
+    this->extent=extent;
+  }
+
+  void MVTTiler::SetBuffer(uint32_t buffer)
+  {
+    this->buffer=buffer;
+  }
+
+  void MVTTiler::SetWriteEmptyTiles(bool writeEmptyTiles)
+  {
+    this->writeEmptyTiles=writeEmptyTiles;
+  }
+
+  void MVTTiler::SetName(const std::string& name)
+  {
+    this->name=name;
+  }
+
+  void MVTTiler::SetBreaker(const BreakerRef& breaker)
+  {
+    this->breaker=breaker;
+  }
+
+  bool MVTTiler::Process(const GeoBox& boundingBox,
+                         const MagnificationLevel& startLevel,
+                         const MagnificationLevel& endLevel,
+                         MVTTileSink& sink,
+                         Statistics& statistics)
+  {
+    struct LevelTiles
+    {
+      MagnificationLevel level;
+      OSMTileIdBox       tiles;
+      size_t             firstJob;
+    };
+
+    StopClock totalTimer;
+
+    statistics=Statistics();
+
+    MagnificationLevel    minLevel(std::min(startLevel.Get(),endLevel.Get()));
+    MagnificationLevel    maxLevel(std::max(startLevel.Get(),endLevel.Get()));
+    std::vector<LevelTiles> levels;
+    size_t                jobCount=0;
+
+    for (MagnificationLevel level=minLevel; level<=maxLevel; ++level) {
+      Magnification magnification(level);
+      OSMTileIdBox  tiles(OSMTileId::GetOSMTile(magnification,boundingBox.GetMinCoord()),
+                          OSMTileId::GetOSMTile(magnification,boundingBox.GetMaxCoord()));
+
+      levels.push_back(LevelTiles{level,tiles,jobCount});
+      jobCount+=tiles.GetCount();
+    }
+
+    if (!sink.Open()) {
+      return false;
+    }
+
+    log.Info() << "Generating " << jobCount << " tile(s) using " << threadCount << " thread(s)";
+
+    std::atomic<size_t> nextJob{0};
+    std::atomic<bool>   success{true};
+    std::mutex          statisticsMutex;
+    std::set<std::string> layers;
+
+    AreaSearchParameter parameter(searchParameter);
+
+    if (breaker) {
+      parameter.SetBreaker(breaker);
+    }
+
+    auto worker=[&]() {
+      MVTTileEncoder encoder;
+      Statistics     workerStatistics;
+      std::set<std::string> workerLayers;
+      std::string    tileData;
+
+      encoder.SetExtent(extent);
+      encoder.SetBuffer(buffer);
+
+      for (size_t job=nextJob++; job<jobCount && success; job=nextJob++) {
+        if (breaker && breaker->IsAborted()) {
+          success=false;
+          break;
+        }
+
+        auto levelTiles=std::prev(std::upper_bound(levels.begin(),
+                                                   levels.end(),
+                                                   job,
+                                                   [](size_t value, const LevelTiles& entry) {
+                                                     return value<entry.firstJob;
+                                                   }));
+
+        size_t        index=job-levelTiles->firstJob;
+        OSMTileId     tile(levelTiles->tiles.GetMinX()+uint32_t(index%levelTiles->tiles.GetWidth()),
+                           levelTiles->tiles.GetMinY()+uint32_t(index/levelTiles->tiles.GetWidth()));
+        Magnification magnification(levelTiles->level);
+
+        StopClock     loadTimer;
+        MapData       data;
+        std::list<TileRef> tiles;
+
+        mapService->LookupTiles(magnification,
+                                tile.GetBoundingBox(magnification),
+                                tiles);
+
+        if (!mapService->LoadMissingTileData(parameter,
+                                             *styleConfig,
+                                             tiles)) {
+          log.Error() << "Cannot load data for tile " << levelTiles->level.Get() << "/" << tile.GetDisplayText();
+          success=false;
+          break;
+        }
+
+        mapService->AddTileDataToMapData(tiles,
+                                         data);
+
+        loadTimer.Stop();
+
+        StopClock encodeTimer;
+
+        encoder.Encode(tile,
+                       magnification,
+                       data,
+                       tileData);
+
+        encodeTimer.Stop();
+
+        workerStatistics.tileCount++;
+        workerStatistics.featureCount+=encoder.GetFeatureCount();
+        workerStatistics.byteCount+=tileData.size();
+        workerStatistics.loadTime+=loadTimer.GetMilliseconds();
+        workerStatistics.encodeTime+=encodeTimer.GetMilliseconds();
+
+        for (const auto& layer : encoder.GetLayerNames()) {
+          workerLayers.insert(layer);
+        }
+
+        if (encoder.GetFeatureCount()==0) {
+          workerStatistics.emptyTileCount++;
+
+          if (!writeEmptyTiles) {
+            continue;
+          }
+        }
+
+        StopClock writeTimer;
+
+        if (!sink.WriteTile(levelTiles->level,
+                            tile,
+                            tileData)) {
+          success=false;
+          break;
+        }
+
+        writeTimer.Stop();
+        workerStatistics.writeTime+=writeTimer.GetMilliseconds();
+      }
+
+      std::scoped_lock<std::mutex> lock(statisticsMutex);
+
+      statistics.tileCount+=workerStatistics.tileCount;
+      statistics.emptyTileCount+=workerStatistics.emptyTileCount;
+      statistics.featureCount+=workerStatistics.featureCount;
+      statistics.byteCount+=workerStatistics.byteCount;
+      statistics.loadTime+=workerStatistics.loadTime;
+      statistics.encodeTime+=workerStatistics.encodeTime;
+      statistics.writeTime+=workerStatistics.writeTime;
+      layers.insert(workerLayers.begin(),workerLayers.end());
+    };
+
+    size_t workerCount=std::max(size_t(1),std::min(threadCount,jobCount));
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount-1);
+    for (size_t i=1; i<workerCount; i++) {
+      threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    MVTTileSetInfo info;
+
+    info.name=name;
+    info.boundingBox=boundingBox;
+    info.minLevel=minLevel;
+    info.maxLevel=maxLevel;
+    info.layers=layers;
+
+    if (!sink.Close(info)) {
+      success=false;
+    }
+
+    totalTimer.Stop();
+    statistics.totalTime=totalTimer.GetMilliseconds();
+
+    return success;
+  }
+}
@@ -28,6 +28,7 @@
 #include <osmscoutmapopengl/MapOpenGLImportExport.h>
 #include <osmscoutmapopengl/TextLoader.h>
 #include <osmscoutmapopengl/OpenGLProjection.h>
+#include <osmscoutmapopengl/Triangulate.h>
 
 namespace osmscout {
   class OSMSCOUT_MAP_OPENGL_API MapPainterOpenGL
@@ -71,6 +72,8 @@ namespace osmscout {
 
     TextLoader textLoader;
 
+    TriangulationCache triangulationCache;
+
     osmscout::MapData mapData;
     osmscout::StyleConfigRef styleConfig;
     osmscout::StyleConfigRef dataStyleConfig;
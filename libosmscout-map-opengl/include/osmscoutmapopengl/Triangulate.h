@@ -22,38 +22,161 @@
 
 #include <GL/glew.h>
 
-#include <iostream>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 #include <osmscoutmap/MapPainter.h>
 
-#include <glm/vec3.hpp>
+#include <osmscoutmapopengl/MapOpenGLImportExport.h>
 
 namespace osmscout{
 
-  class Triangulate {
+  /**
+   * Triangulation of polygons by ear clipping. Ear candidates are looked up using a
+   * z-order curve hash of the vertices for larger polygons, holes are joined with the
+   * outer ring by bridges. Self-intersecting and degenerated polygons do not fail, but may
+   * result in a partial triangulation.
+   *
+   * All methods return the triangles as a flat list of x,y coordinates, three coordinate
+   * pairs for each triangle. For geographic coordinates x is the longitude and y the latitude.
+   */
+  class OSMSCOUT_MAP_OPENGL_API Triangulate {
   public:
 
     /**
      * Triangulate a polygon without hole.
      */
-    static std::vector<GLfloat> TriangulatePolygon(std::vector<osmscout::Point> points);
+    static std::vector<GLfloat> TriangulatePolygon(std::span<const osmscout::Point> points);
 
     /**
      * Triangulate a polygon without hole.
      */
-    static std::vector<GLfloat> TriangulatePolygon(std::vector<osmscout::Vertex2D> points);
+    static std::vector<GLfloat> TriangulatePolygon(std::span<const osmscout::Vertex2D> points);
 
     /**
      * Triangulate a polygon without hole.
      */
-    static std::vector<GLfloat> TriangulatePolygon(std::vector<osmscout::GeoCoord> points);
+    static std::vector<GLfloat> TriangulatePolygon(std::span<const osmscout::GeoCoord> points);
 
     /**
-     * Triangulate a polygon with hole.
+     * Triangulate a polygon with hole. The first polygon is the outer ring, all other
+     * polygons are holes.
      */
-    static std::vector<GLfloat> TriangulateWithHoles(std::vector<std::vector<osmscout::Point>> points);
+    static std::vector<GLfloat> TriangulateWithHoles(std::span<const std::vector<osmscout::Point>> points);
 
   };
+
+  /**
+   * Cache of area triangulations, so that areas visible before and after reloading of the
+   * map data (for example while panning) must not be triangulated again.
+   *
+   * Triangulations are identified by the file offset of the area, the index of the ring
+   * and the magnification level the data was loaded for (areas may be simplified for lower
+   * magnifications). As a guard against equal file offsets of different data files the number
+   * of nodes and the first node of the ring are checked, too.
+   *
+   * The least recently used triangulations are evicted, if the number of cached coordinates
+   * exceeds the maximum size. The cache is not thread safe.
+   */
+  class OSMSCOUT_MAP_OPENGL_API TriangulationCache {
+  public:
+    using TrianglesRef = std::shared_ptr<const std::vector<GLfloat>>;
+
+    struct Key
+    {
+      FileOffset offset;
+      uint32_t   ring;
+      uint32_t   level;
+
+      bool operator==(const Key& other) const
+      {
+        return offset==other.offset &&
+               ring==other.ring &&
+               level==other.level;
+      }
+    };
+
+    static constexpr size_t DefaultMaxSize=4*1024*1024; //!< Default number of cached coordinates
+
+  private:
+    struct KeyHasher
+    {
+      size_t operator()(const Key& key) const
+      {
+        return std::hash<FileOffset>()(key.offset) ^
+               (size_t(key.ring) << 48) ^
+               (size_t(key.level) << 56);
+      }
+    };
+
+    struct Entry
+    {
+      Key          key;
+      size_t       nodeCount;
+      GeoCoord     firstNode;
+      TrianglesRef triangles;
+    };
+
+    using OrderList = std::list<Entry>;
+    using Map = std::unordered_map<Key,OrderList::iterator,KeyHasher>;
+
+    OrderList order;  //!< Entries, most recently used first
+    Map       map;
+    size_t    size=0; //!< Number of cached coordinates
+    size_t    maxSize;
+    size_t    hits=0;
+    size_t    misses=0;
+
+  private:
+    void StripCache();
+
+  public:
+    explicit TriangulationCache(size_t maxSize=DefaultMaxSize);
+
+    /**
+     * Return the cached triangulation of the given ring or nullptr, if it is not cached
+     */
+    TrianglesRef Get(const Key& key,
+                     std::span<const Point> nodes);
+
+    /**
+     * Store the triangulation of the given ring and return it
+     */
+    TrianglesRef Set(const Key& key,
+                     std::span<const Point> nodes,
+                     std::vector<GLfloat>&& triangles);
+
+    void SetMaxSize(size_t maxSize);
+
+    size_t GetMaxSize() const
+    {
+      return maxSize;
+    }
+
+    /**
+     * Return the number of cached coordinates
+     */
+    size_t GetSize() const
+    {
+      return size;
+    }
+
+    size_t GetHits() const
+    {
+      return hits;
+    }
+
+    size_t GetMisses() const
+    {
+      return misses;
+    }
+
+    void Flush();
+  };
 }
 
 #endif //LIBOSMSCOUT_TRIANGULATE_H
@@ -181,6 +181,32 @@ namespace osmscout {
     wayRenderer.SwapData();
   }
 
+  /**
+   * Return the nodes without consecutive duplicates. Rings are implicitly closed,
+   * so a last node equal to the first node is removed, too.
+   *
+   * Non consecutive duplicates (rings touching themselves or a hole touching the outer
+   * ring) are kept, removing them would change the shape of the ring. The ear clipping
+   * triangulation handles them (see TriangulateTest).
+   */
+  static std::vector<Point> RemoveDuplicateNodes(const std::vector<Point> &nodes) {
+    std::vector<Point> result;
+
+    result.reserve(nodes.size());
+
+    for (const auto &node: nodes) {
+      if (result.empty() || !result.back().IsSame(node)) {
+        result.push_back(node);
+      }
+    }
+
+    while (result.size() > 1 && result.back().IsSame(result.front())) {
+      result.pop_back();
+    }
+
+    return result;
+  }
+
   void MapPainterOpenGL::ProcessAreas(const osmscout::MapData &data,
                                       const osmscout::Projection &loadProjection,
                                       const osmscout::StyleConfigRef &styleConfig) {
@@ -247,20 +273,7 @@ namespace osmscout {
 
           foundRing = true;
 
-          std::vector<Point> p = area->rings[i].nodes;
-          std::vector<osmscout::Area::Ring> r;
-
-          for (int i = p.size() - 1; i >= 0; i--) {
-            for (int j = 0; j < i; j++) {
-              if (fabs(p[i].GetLat() - p[j].GetLat()) < 0.000000001 &&
-                  fabs(p[i].GetLon() - p[j].GetLon()) < 0.0000000001) {
-                p.erase(p.begin() + i);
-                if (size_t(i) == p.size()) { // i was the last element
-                  break;
-                }
-              }
-            }
-          }
+          std::vector<Point> p = RemoveDuplicateNodes(area->rings[i].nodes);
 
           if (p.size() < 3) {
             continue;
@@ -268,18 +281,6 @@ namespace osmscout {
 
           osmscout::GeoBox ringBoundingBox=ring.GetBoundingBox();
 
-          size_t j = i + 1;
-          int hasClippings = 0;
-          while (j < area->rings.size() &&
-                 area->rings[j].GetRing() == ringId + 1 &&
-                 area->rings[j].GetType()->GetIgnore()) {
-            r.push_back(area->rings[j]);
-            j++;
-            hasClippings = 1;
-          }
-
-          std::vector<GLfloat> points;
-
           if (!fillStyle) {
             continue;
           }
@@ -304,35 +305,33 @@ namespace osmscout {
             continue;
           }
 
-          try {
-            if (hasClippings == 1) {
-              for (auto &ring: r) {
-                for (int i = ring.nodes.size() - 1; i >= 0; i--) {
-                  for (int j = 0; j < i; j++) {
-                    if (fabs(ring.nodes[i].GetLat() - ring.nodes[j].GetLat()) < 0.000000001 &&
-                        fabs(ring.nodes[i].GetLon() - ring.nodes[j].GetLon()) < 0.0000000001) {
-                      ring.nodes.erase(ring.nodes.begin() + i);
-                    }
-                  }
-                }
-              }
+          TriangulationCache::Key key{area->GetFileOffset(),
+                                      uint32_t(i),
+                                      loadProjection.GetMagnification().GetLevel()};
+          TriangulationCache::TrianglesRef triangles = triangulationCache.Get(key, p);
 
-              std::vector<std::vector<osmscout::Point>> polygons;
-              polygons.push_back(p);
-              for (const auto &ring: r) {
-                if (ring.nodes.size() >= 3) {
-                  polygons.push_back(ring.nodes);
-                }
+          if (!triangles) {
+            std::vector<std::vector<osmscout::Point>> polygons;
+
+            polygons.push_back(p);
+
+            for (size_t j = i + 1;
+                 j < area->rings.size() &&
+                 area->rings[j].GetRing() == ringId + 1 &&
+                 area->rings[j].GetType()->GetIgnore();
+                 j++) {
+              std::vector<Point> hole = RemoveDuplicateNodes(area->rings[j].nodes);
+
+              if (hole.size() >= 3) {
+                polygons.push_back(std::move(hole));
               }
-              points = osmscout::Triangulate::TriangulateWithHoles(polygons);
-            } else {
-              points = osmscout::Triangulate::TriangulatePolygon(p);
             }
-          } catch (const std::runtime_error &e) {
-            log.Warn() << "Skip area " << area->GetFileOffset() << ", triangulation failed: " << e.what();
-            continue;
+
+            triangles = triangulationCache.Set(key, p, Triangulate::TriangulateWithHoles(polygons));
           }
 
+          const std::vector<GLfloat> &points = *triangles;
+
           for (size_t t = 0; t < points.size(); t++) {
             if (t % 2 == 0) {
               areaRenderer.AddNewVertex(points[t]);
@@ -762,18 +761,9 @@ namespace osmscout {
 
         }
 
-        for (int i = p.size() - 1; i >= 0; i--) {
-          for (int j = 0; j < i; j++) {
-            if (fabs(p[i].GetLat() - p[j].GetLat()) < 0.000000001 &&
-                fabs(p[i].GetLon() - p[j].GetLon()) < 0.0000000001) {
-              p.erase(p.begin() + i);
-            }
-          }
-        }
-
-        std::vector<GLfloat> points;
+        p = RemoveDuplicateNodes(p);
 
-        points = osmscout::Triangulate::TriangulatePolygon(p);
+        std::vector<GLfloat> points = osmscout::Triangulate::TriangulatePolygon(p);
 
         for (size_t t = 0; t < points.size(); t++) {
           if (t % 2 == 0) {
@@ -15,151 +15,1004 @@
   You should have received a copy of the GNU Lesser General Public
   License along with this library; if not, write to the Free Software
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+
+  The ear clipping triangulation (class Earcut) is a port of mapbox/earcut
+  (https://github.com/mapbox/earcut):
+
+  Copyright (c) 2016, Mapbox
+
+  ISC License (compatible with GNU LGPL)
+
+  Permission to use, copy, modify, and/or distribute this software for any purpose
+  with or without fee is hereby granted, provided that the above copyright notice
+  and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH
+  REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND
+  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT,
+  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS
+  OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+  TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF
+  THIS SOFTWARE.
 */
 
 #include <osmscoutmapopengl/Triangulate.h>
 
-#include <osmscout/util/ScopeGuard.h>
-#include <osmscout/system/Math.h>
-
-#include <poly2tri/poly2tri.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <utility>
 
 namespace osmscout {
-  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::vector<osmscout::Point> points) {
-    std::vector<GLfloat> result;
-
-    std::vector<p2t::Point *> polyline;
-    std::for_each(points.begin(), points.end(),
-                  [&polyline](osmscout::Point p) { polyline.push_back(new p2t::Point(p.GetLon(), p.GetLat())); });
-    p2t::CDT *cdt = new p2t::CDT(polyline);
-    cdt->Triangulate();
-    std::vector<p2t::Triangle *> triangles;
-    triangles = cdt->GetTriangles();
-    for (size_t i = 0; i < triangles.size(); i++) {
-      p2t::Point a = *triangles[i]->GetPoint(0);
-      p2t::Point b = *triangles[i]->GetPoint(1);
-      p2t::Point c = *triangles[i]->GetPoint(2);
-      result.emplace_back(a.x);
-      result.emplace_back(a.y);
-      result.emplace_back(b.x);
-      result.emplace_back(b.y);
-      result.emplace_back(c.x);
-      result.emplace_back(c.y);
-    }
 
-    std::for_each(polyline.begin(), polyline.end(), [](p2t::Point *p){delete p;});
-    delete cdt;
-    cdt = nullptr;
+  namespace {
 
-    return result;
+    /**
+     * Ear clipping triangulation of a polygon with holes.
+     *
+     * The rings are converted into circular doubly linked lists of vertices. Holes are
+     * connected to the outer ring by bridges, resulting in one (weakly simple) ring, which
+     * is then triangulated by cutting off ears. For larger polygons the vertices are
+     * additionally linked in z-order, so that checking an ear candidate only needs to
+     * check the vertices in the z-order range of the bounding box of the candidate.
+     *
+     * If no ear can be found (self-intersections, degenerated geometry) the ring is cleaned
+     * up, local self-intersections are cured and at last the ring is split into two
+     * rings, which are triangulated separately.
+     */
+    class Earcut
+    {
+    private:
+      struct Node
+      {
+        double  x;
+        double  y;
+        size_t  i;                //!< Index of the vertex in the source polygon
+        Node*   prev=nullptr;     //!< Previous vertex in the ring
+        Node*   next=nullptr;     //!< Next vertex in the ring
+        int32_t z=0;              //!< Z-order curve value
+        Node*   prevZ=nullptr;    //!< Previous vertex in z-order
+        Node*   nextZ=nullptr;    //!< Next vertex in z-order
+        bool    steiner=false;    //!< Vertex is a hole consisting of a single point
 
-  }
+        Node(size_t i, double x, double y)
+        : x(x),
+          y(y),
+          i(i)
+        {
+          // no code
+        }
+      };
 
-  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::vector<osmscout::Vertex2D> points) {
-    std::vector<GLfloat> result;
-
-    std::vector<p2t::Point *> polyline;
-    std::for_each(points.begin(), points.end(),
-                  [&polyline](osmscout::Vertex2D p) { polyline.push_back(new p2t::Point(p.GetX(), p.GetY())); });
-    p2t::CDT *cdt = new p2t::CDT(polyline);
-    cdt->Triangulate();
-    std::vector<p2t::Triangle *> triangles;
-    triangles = cdt->GetTriangles();
-    for (size_t i = 0; i < triangles.size(); i++) {
-      p2t::Point a = *triangles[i]->GetPoint(0);
-      p2t::Point b = *triangles[i]->GetPoint(1);
-      p2t::Point c = *triangles[i]->GetPoint(2);
-      result.emplace_back(a.x);
-      result.emplace_back(a.y);
-      result.emplace_back(b.x);
-      result.emplace_back(b.y);
-      result.emplace_back(c.x);
-      result.emplace_back(c.y);
-    }
+      static constexpr size_t HashingThreshold=80; //!< Use z-order hashing above this number of vertices
 
-    std::for_each(polyline.begin(), polyline.end(), [](p2t::Point *p){delete p;});
-    delete cdt;
-    cdt = nullptr;
+      std::deque<Node>     nodes;
+      std::vector<GLfloat> triangles;
+      bool                 hashing=false;
+      double               minX=0.0;
+      double               minY=0.0;
+      double               invSize=0.0;
 
-    return result;
+    private:
+      Node* CreateNode(size_t i, double x, double y)
+      {
+        nodes.emplace_back(i,x,y);
 
-  }
+        return &nodes.back();
+      }
 
-  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::vector<osmscout::GeoCoord> points) {
-    std::vector<GLfloat> result;
+      Node* InsertNode(size_t i, double x, double y, Node* last)
+      {
+        Node* p=CreateNode(i,x,y);
 
-    std::vector<p2t::Point *> polyline;
-    std::for_each(points.begin(), points.end(),
-                  [&polyline](osmscout::GeoCoord g) { polyline.push_back(new p2t::Point(g.GetLon(), g.GetLat())); });
-    ScopeGuard polylineDeleter([&polyline]() noexcept {
-      std::for_each(polyline.begin(), polyline.end(), [](p2t::Point *p){delete p;});
-    });
+        if (last==nullptr) {
+          p->prev=p;
+          p->next=p;
+        }
+        else {
+          p->next=last->next;
+          p->prev=last;
+          last->next->prev=p;
+          last->next=p;
+        }
+
+        return p;
+      }
+
+      static void RemoveNode(Node* p)
+      {
+        p->next->prev=p->prev;
+        p->prev->next=p->next;
+
+        if (p->prevZ!=nullptr) {
+          p->prevZ->nextZ=p->nextZ;
+        }
+
+        if (p->nextZ!=nullptr) {
+          p->nextZ->prevZ=p->prevZ;
+        }
+      }
+
+      static double Area(const Node* p, const Node* q, const Node* r)
+      {
+        return (q->y-p->y)*(r->x-q->x)-(q->x-p->x)*(r->y-q->y);
+      }
+
+      static bool Equals(const Node* p1, const Node* p2)
+      {
+        return p1->x==p2->x && p1->y==p2->y;
+      }
+
+      static bool PointInTriangle(double ax, double ay,
+                                  double bx, double by,
+                                  double cx, double cy,
+                                  double px, double py)
+      {
+        return (cx-px)*(ay-py)>=(ax-px)*(cy-py) &&
+               (ax-px)*(by-py)>=(bx-px)*(ay-py) &&
+               (bx-px)*(cy-py)>=(cx-px)*(by-py);
+      }
+
+      static int Sign(double value)
+      {
+        return (value>0.0)-(value<0.0);
+      }
+
+      static bool OnSegment(const Node* p, const Node* q, const Node* r)
+      {
+        return q->x<=std::max(p->x,r->x) &&
+               q->x>=std::min(p->x,r->x) &&
+               q->y<=std::max(p->y,r->y) &&
+               q->y>=std::min(p->y,r->y);
+      }
+
+      static bool Intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2)
+      {
+        int o1=Sign(Area(p1,q1,p2));
+        int o2=Sign(Area(p1,q1,q2));
+        int o3=Sign(Area(p2,q2,p1));
+        int o4=Sign(Area(p2,q2,q1));
+
+        if (o1!=o2 && o3!=o4) {
+          return true;
+        }
+
+        return (o1==0 && OnSegment(p1,p2,q1)) ||
+               (o2==0 && OnSegment(p1,q2,q1)) ||
+               (o3==0 && OnSegment(p2,p1,q2)) ||
+               (o4==0 && OnSegment(p2,q1,q2));
+      }
+
+      /**
+       * Check if a polygon diagonal intersects any polygon segment
+       */
+      static bool IntersectsPolygon(const Node* a, const Node* b)
+      {
+        const Node* p=a;
+
+        do {
+          if (p->i!=a->i &&
+              p->next->i!=a->i &&
+              p->i!=b->i &&
+              p->next->i!=b->i &&
+              Intersects(p,p->next,a,b)) {
+            return true;
+          }
+
+          p=p->next;
+        } while (p!=a);
+
+        return false;
+      }
+
+      /**
+       * Check if a polygon diagonal is locally inside the polygon
+       */
+      static bool LocallyInside(const Node* a, const Node* b)
+      {
+        if (Area(a->prev,a,a->next)<0.0) {
+          return Area(a,b,a->next)>=0.0 && Area(a,a->prev,b)>=0.0;
+        }
+
+        return Area(a,b,a->prev)<0.0 || Area(a,a->next,b)<0.0;
+      }
+
+      /**
+       * Check if the middle point of a polygon diagonal is inside the polygon
+       */
+      static bool MiddleInside(const Node* a, const Node* b)
+      {
+        const Node* p=a;
+        bool        inside=false;
+        double      px=(a->x+b->x)/2.0;
+        double      py=(a->y+b->y)/2.0;
+
+        do {
+          if (((p->y>py)!=(p->next->y>py)) &&
+              p->next->y!=p->y &&
+              (px<(p->next->x-p->x)*(py-p->y)/(p->next->y-p->y)+p->x)) {
+            inside=!inside;
+          }
+
+          p=p->next;
+        } while (p!=a);
+
+        return inside;
+      }
+
+      /**
+       * Check if a diagonal between two polygon nodes is valid (lies in polygon interior)
+       */
+      static bool IsValidDiagonal(const Node* a, const Node* b)
+      {
+        if (a->next->i==b->i ||
+            a->prev->i==b->i ||
+            IntersectsPolygon(a,b)) {
+          return false;
+        }
+
+        if (LocallyInside(a,b) &&
+            LocallyInside(b,a) &&
+            MiddleInside(a,b) &&
+            (Area(a->prev,a,b->prev)!=0.0 || Area(a,b->prev,b)!=0.0)) {
+          return true;
+        }
+
+        // Special zero length case
+        return Equals(a,b) &&
+               Area(a->prev,a,a->next)>0.0 &&
+               Area(b->prev,b,b->next)>0.0;
+      }
+
+      static bool SectorContainsSector(const Node* m, const Node* p)
+      {
+        return Area(m->prev,m,p->prev)<0.0 && Area(p->next,m,m->next)<0.0;
+      }
+
+      /**
+       * Z-order of a point given coords and inverse of the longer side of the bounding box
+       */
+      int32_t ZOrder(double x, double y) const
+      {
+        auto ix=uint32_t((x-minX)*invSize);
+        auto iy=uint32_t((y-minY)*invSize);
+
+        ix=(ix | (ix << 8)) & 0x00FF00FF;
+        ix=(ix | (ix << 4)) & 0x0F0F0F0F;
+        ix=(ix | (ix << 2)) & 0x33333333;
+        ix=(ix | (ix << 1)) & 0x55555555;
+
+        iy=(iy | (iy << 8)) & 0x00FF00FF;
+        iy=(iy | (iy << 4)) & 0x0F0F0F0F;
+        iy=(iy | (iy << 2)) & 0x33333333;
+        iy=(iy | (iy << 1)) & 0x55555555;
+
+        return int32_t(ix | (iy << 1));
+      }
+
+      /**
+       * Sort the z-order linked list using merge sort
+       */
+      static Node* SortLinked(Node* list)
+      {
+        size_t inSize=1;
+        size_t numMerges;
+
+        do {
+          Node* p=list;
+          Node* tail=nullptr;
+
+          list=nullptr;
+          numMerges=0;
+
+          while (p!=nullptr) {
+            numMerges++;
+
+            Node*  q=p;
+            size_t pSize=0;
+
+            for (size_t i=0; i<inSize; i++) {
+              pSize++;
+              q=q->nextZ;
+
+              if (q==nullptr) {
+                break;
+              }
+            }
+
+            size_t qSize=inSize;
+
+            while (pSize>0 || (qSize>0 && q!=nullptr)) {
+              Node* e;
+
+              if (pSize!=0 && (qSize==0 || q==nullptr || p->z<=q->z)) {
+                e=p;
+                p=p->nextZ;
+                pSize--;
+              }
+              else {
+                e=q;
+                q=q->nextZ;
+                qSize--;
+              }
+
+              if (tail!=nullptr) {
+                tail->nextZ=e;
+              }
+              else {
+                list=e;
+              }
+
+              e->prevZ=tail;
+              tail=e;
+            }
+
+            p=q;
+          }
+
+          tail->nextZ=nullptr;
+          inSize*=2;
+        } while (numMerges>1);
+
+        return list;
+      }
+
+      /**
+       * Interlink polygon nodes in z-order
+       */
+      void IndexCurve(Node* start)
+      {
+        Node* p=start;
+
+        do {
+          p->z=ZOrder(p->x,p->y);
+          p->prevZ=p->prev;
+          p->nextZ=p->next;
+          p=p->next;
+        } while (p!=start);
+
+        p->prevZ->nextZ=nullptr;
+        p->prevZ=nullptr;
+
+        SortLinked(p);
+      }
+
+      /**
+       * Create a circular doubly linked list from the ring in the given winding order
+       */
+      template<class Iterator, class CoordGetter>
+      Node* LinkedList(Iterator begin,
+                       Iterator end,
+                       size_t startIndex,
+                       bool clockwise,
+                       CoordGetter getCoord)
+      {
+        size_t count=size_t(std::distance(begin,end));
+        double sum=0.0;
+
+        if (count==0) {
+          return nullptr;
+        }
+
+        auto last=begin+(count-1);
+
+        for (auto p=begin; p!=end; ++p) {
+          auto [px,py]=getCoord(*p);
+          auto [lx,ly]=getCoord(*last);
+
+          sum+=(lx-px)*(py+ly);
+          last=p;
+        }
+
+        Node* lastNode=nullptr;
+
+        if (clockwise==(sum>0.0)) {
+          size_t index=startIndex;
+
+          for (auto p=begin; p!=end; ++p) {
+            auto [x,y]=getCoord(*p);
+
+            lastNode=InsertNode(index++,x,y,lastNode);
+          }
+        }
+        else {
+          size_t index=startIndex+count;
+
+          for (auto p=end; p!=begin;) {
+            --p;
+            auto [x,y]=getCoord(*p);
+
+            lastNode=InsertNode(--index,x,y,lastNode);
+          }
+        }
+
+        if (lastNode!=nullptr && Equals(lastNode,lastNode->next)) {
+          Node* next=lastNode->next;
+
+          RemoveNode(lastNode);
+          lastNode=next;
+        }
+
+        return lastNode;
+      }
+
+      /**
+       * Eliminate colinear or duplicate points
+       */
+      static Node* FilterPoints(Node* start, Node* end=nullptr)
+      {
+        if (start==nullptr) {
+          return start;
+        }
+
+        if (end==nullptr) {
+          end=start;
+        }
+
+        Node* p=start;
+        bool  again;
+
+        do {
+          again=false;
+
+          if (!p->steiner &&
+              (Equals(p,p->next) || Area(p->prev,p,p->next)==0.0)) {
+            RemoveNode(p);
+            p=end=p->prev;
+
+            if (p==p->next) {
+              break;
+            }
+
+            again=true;
+          }
+          else {
+            p=p->next;
+          }
+        } while (again || p!=end);
+
+        return end;
+      }
+
+      bool IsEar(const Node* ear) const
+      {
+        const Node* a=ear->prev;
+        const Node* b=ear;
+        const Node* c=ear->next;
+
+        if (Area(a,b,c)>=0.0) {
+          return false; // Reflex, cannot be an ear
+        }
+
+        // Now make sure we don't have other points inside the potential ear
+        const Node* p=ear->next->next;
+
+        while (p!=ear->prev) {
+          if (PointInTriangle(a->x,a->y,b->x,b->y,c->x,c->y,p->x,p->y) &&
+              Area(p->prev,p,p->next)>=0.0) {
+            return false;
+          }
+
+          p=p->next;
+        }
+
+        return true;
+      }
+
+      bool IsEarHashed(const Node* ear) const
+      {
+        const Node* a=ear->prev;
+        const Node* b=ear;
+        const Node* c=ear->next;
+
+        if (Area(a,b,c)>=0.0) {
+          return false; // Reflex, cannot be an ear
+        }
+
+        // Z-order range for the current triangle bounding box
+        int32_t minZ=ZOrder(std::min({a->x,b->x,c->x}),std::min({a->y,b->y,c->y}));
+        int32_t maxZ=ZOrder(std::max({a->x,b->x,c->x}),std::max({a->y,b->y,c->y}));
+
+        auto IsInside=[a,b,c,ear](const Node* p) {
+          return p!=ear->prev &&
+                 p!=ear->next &&
+                 PointInTriangle(a->x,a->y,b->x,b->y,c->x,c->y,p->x,p->y) &&
+                 Area(p->prev,p,p->next)>=0.0;
+        };
+
+        const Node* p=ear->prevZ;
+        const Node* n=ear->nextZ;
+
+        // Look for points inside the triangle in both directions
+        while (p!=nullptr && p->z>=minZ &&
+               n!=nullptr && n->z<=maxZ) {
+          if (IsInside(p) || IsInside(n)) {
+            return false;
+          }
 
-    p2t::CDT cdt(polyline);
-    cdt.Triangulate();
-    std::vector<p2t::Triangle *> triangles;
-    triangles = cdt.GetTriangles();
-    for (size_t i = 0; i < triangles.size(); i++) {
-      p2t::Point a = *triangles[i]->GetPoint(0);
-      p2t::Point b = *triangles[i]->GetPoint(1);
-      p2t::Point c = *triangles[i]->GetPoint(2);
-      result.emplace_back(a.x);
-      result.emplace_back(a.y);
-      result.emplace_back(b.x);
-      result.emplace_back(b.y);
-      result.emplace_back(c.x);
-      result.emplace_back(c.y);
+          p=p->prevZ;
+          n=n->nextZ;
+        }
+
+        while (p!=nullptr && p->z>=minZ) {
+          if (IsInside(p)) {
+            return false;
+          }
+
+          p=p->prevZ;
+        }
+
+        while (n!=nullptr && n->z<=maxZ) {
+          if (IsInside(n)) {
+            return false;
+          }
+
+          n=n->nextZ;
+        }
+
+        return true;
+      }
+
+      void AddTriangle(const Node* a, const Node* b, const Node* c)
+      {
+        triangles.push_back(GLfloat(a->x));
+        triangles.push_back(GLfloat(a->y));
+        triangles.push_back(GLfloat(b->x));
+        triangles.push_back(GLfloat(b->y));
+        triangles.push_back(GLfloat(c->x));
+        triangles.push_back(GLfloat(c->y));
+      }
+
+      /**
+       * Go through all polygon nodes and cure small local self-intersections
+       */
+      Node* CureLocalIntersections(Node* start)
+      {
+        Node* p=start;
+
+        do {
+          Node* a=p->prev;
+          Node* b=p->next->next;
+
+          if (!Equals(a,b) &&
+              Intersects(a,p,p->next,b) &&
+              LocallyInside(a,b) &&
+              LocallyInside(b,a)) {
+            AddTriangle(a,p,b);
+
+            // Remove two nodes involved
+            RemoveNode(p);
+            RemoveNode(p->next);
+
+            p=start=b;
+          }
+
+          p=p->next;
+        } while (p!=start);
+
+        return FilterPoints(p);
+      }
+
+      /**
+       * Link two polygon vertices with a bridge. If the vertices belong to the same ring,
+       * it splits the polygon into two, if one belongs to the outer ring and another to a hole,
+       * it merges it into a single ring.
+       */
+      Node* SplitPolygon(Node* a, Node* b)
+      {
+        Node* a2=CreateNode(a->i,a->x,a->y);
+        Node* b2=CreateNode(b->i,b->x,b->y);
+        Node* an=a->next;
+        Node* bp=b->prev;
+
+        a->next=b;
+        b->prev=a;
+
+        a2->next=an;
+        an->prev=a2;
+
+        b2->next=a2;
+        a2->prev=b2;
+
+        bp->next=b2;
+        b2->prev=bp;
+
+        return b2;
+      }
+
+      /**
+       * Try splitting the polygon into two and triangulate them independently
+       */
+      void SplitEarcut(Node* start)
+      {
+        // Look for a valid diagonal that divides the polygon into two
+        Node* a=start;
+
+        do {
+          Node* b=a->next->next;
+
+          while (b!=a->prev) {
+            if (a->i!=b->i && IsValidDiagonal(a,b)) {
+              Node* c=SplitPolygon(a,b);
+
+              a=FilterPoints(a,a->next);
+              c=FilterPoints(c,c->next);
+
+              EarcutLinked(a,0);
+              EarcutLinked(c,0);
+              return;
+            }
+
+            b=b->next;
+          }
+
+          a=a->next;
+        } while (a!=start);
+      }
+
+      /**
+       * Main ear slicing loop which triangulates a polygon (given as a linked list)
+       */
+      void EarcutLinked(Node* ear, int pass)
+      {
+        if (ear==nullptr) {
+          return;
+        }
+
+        // Interlink polygon nodes in z-order
+        if (pass==0 && hashing) {
+          IndexCurve(ear);
+        }
+
+        Node* stop=ear;
+
+        // Iterate through ears, slicing them one by one
+        while (ear->prev!=ear->next) {
+          Node* prev=ear->prev;
+          Node* next=ear->next;
+
+          if (hashing ? IsEarHashed(ear) : IsEar(ear)) {
+            AddTriangle(prev,ear,next);
+
+            RemoveNode(ear);
+
+            // Skipping the next vertex leads to less sliver triangles
+            ear=next->next;
+            stop=next->next;
+
+            continue;
+          }
+
+          ear=next;
+
+          // If we looped through the whole remaining polygon and can't find any more ears
+          if (ear==stop) {
+            if (pass==0) {
+              // Try filtering points and slicing again
+              EarcutLinked(FilterPoints(ear),1);
+            }
+            else if (pass==1) {
+              // If this didn't work, try curing all small self-intersections locally
+              EarcutLinked(CureLocalIntersections(FilterPoints(ear)),2);
+            }
+            else {
+              // As a last resort, try splitting the remaining polygon into two
+              SplitEarcut(ear);
+            }
+
+            break;
+          }
+        }
+      }
+
+      static Node* GetLeftmost(Node* start)
+      {
+        Node* p=start;
+        Node* leftmost=start;
+
+        do {
+          if (p->x<leftmost->x || (p->x==leftmost->x && p->y<leftmost->y)) {
+            leftmost=p;
+          }
+
+          p=p->next;
+        } while (p!=start);
+
+        return leftmost;
+      }
+
+      /**
+       * David Eberly's algorithm for finding a bridge between hole and outer polygon
+       */
+      static Node* FindHoleBridge(const Node* hole, Node* outerNode)
+      {
+        Node*  p=outerNode;
+        double hx=hole->x;
+        double hy=hole->y;
+        double qx=-std::numeric_limits<double>::infinity();
+        Node*  m=nullptr;
+
+        // Find a segment intersected by a ray from the hole's leftmost point to the left;
+        // segment's endpoint with lesser x will be potential connection point
+        do {
+          if (hy<=p->y && hy>=p->next->y && p->next->y!=p->y) {
+            double x=p->x+(hy-p->y)*(p->next->x-p->x)/(p->next->y-p->y);
+
+            if (x<=hx && x>qx) {
+              qx=x;
+              m=p->x<p->next->x ? p : p->next;
+
+              if (x==hx) {
+                return m; // Hole touches outer segment; pick leftmost endpoint
+              }
+            }
+          }
+
+          p=p->next;
+        } while (p!=outerNode);
+
+        if (m==nullptr) {
+          return nullptr;
+        }
+
+        // Look for points inside the triangle of hole point, segment intersection and endpoint;
+        // if there are no points found, we have a valid connection;
+        // otherwise choose the point of the minimum angle with the ray as connection point
+        const Node* stop=m;
+        double      mx=m->x;
+        double      my=m->y;
+        double      tanMin=std::numeric_limits<double>::infinity();
+
+        p=m;
+
+        do {
+          if (hx>=p->x &&
+              p->x>=mx &&
+              hx!=p->x &&
+              PointInTriangle(hy<my ? hx : qx,hy,mx,my,hy<my ? qx : hx,hy,p->x,p->y)) {
+            double tan=std::fabs(hy-p->y)/(hx-p->x); // tangential
+
+            if (LocallyInside(p,hole) &&
+                (tan<tanMin ||
+                 (tan==tanMin && (p->x>m->x || (p->x==m->x && SectorContainsSector(m,p)))))) {
+              m=p;
+              tanMin=tan;
+            }
+          }
+
+          p=p->next;
+        } while (p!=stop);
+
+        return m;
+      }
+
+      /**
+       * Find a bridge between vertices that connects hole with an outer ring and link it
+       */
+      Node* EliminateHole(Node* hole, Node* outerNode)
+      {
+        Node* bridge=FindHoleBridge(hole,outerNode);
+
+        if (bridge==nullptr) {
+          return outerNode;
+        }
+
+        Node* bridgeReverse=SplitPolygon(bridge,hole);
+
+        // Filter collinear points around the cuts
+        FilterPoints(bridgeReverse,bridgeReverse->next);
+
+        return FilterPoints(bridge,bridge->next);
+      }
+
+      void ComputeBoundingBox(Node* start)
+      {
+        double maxX=start->x;
+        double maxY=start->y;
+        Node*  p=start;
+
+        minX=start->x;
+        minY=start->y;
+
+        do {
+          minX=std::min(minX,p->x);
+          minY=std::min(minY,p->y);
+          maxX=std::max(maxX,p->x);
+          maxY=std::max(maxY,p->y);
+          p=p->next;
+        } while (p!=start);
+
+        // minX, minY and invSize are later used to transform coords into integers for z-order calculation
+        invSize=std::max(maxX-minX,maxY-minY);
+        invSize=invSize!=0.0 ? 32767.0/invSize : 0.0;
+      }
+
+    public:
+      /**
+       * Triangulate the given rings, the first ring is the outer ring, all other
+       * rings are holes. getCoord must return the x and y coordinate of a ring element.
+       */
+      template<class Ring, class CoordGetter>
+      std::vector<GLfloat> TriangulateRings(std::span<const Ring> rings,
+                                            CoordGetter getCoord)
+      {
+        size_t vertexCount=0;
+
+        for (const auto& ring : rings) {
+          vertexCount+=ring.size();
+        }
+
+        if (rings.empty() || vertexCount<3) {
+          return {};
+        }
+
+        triangles.reserve((vertexCount+2*(rings.size()-1))*6);
+
+        Node* outerNode=LinkedList(rings[0].begin(),
+                                   rings[0].end(),
+                                   0,
+                                   true,
+                                   getCoord);
+
+        if (outerNode==nullptr || outerNode->prev==outerNode->next) {
+          return {};
+        }
+
+        if (rings.size()>1) {
+          std::vector<Node*> queue;
+          size_t             startIndex=rings[0].size();
+
+          queue.reserve(rings.size()-1);
+
+          for (size_t r=1; r<rings.size(); r++) {
+            Node* list=LinkedList(rings[r].begin(),
+                                  rings[r].end(),
+                                  startIndex,
+                                  false,
+                                  getCoord);
+
+            startIndex+=rings[r].size();
+
+            if (list!=nullptr) {
+              if (list==list->next) {
+                list->steiner=true;
+              }
+
+              queue.push_back(GetLeftmost(list));
+            }
+          }
+
+          std::sort(queue.begin(),queue.end(),[](const Node* a, const Node* b) {
+            return a->x<b->x || (a->x==b->x && a->y<b->y);
+          });
+
+          // Process holes from left to right
+          for (Node* hole : queue) {
+            outerNode=EliminateHole(hole,outerNode);
+          }
+        }
+
+        // If the shape is not too simple, we'll use z-order curve hash later
+        if (vertexCount>HashingThreshold) {
+          hashing=true;
+          ComputeBoundingBox(outerNode);
+        }
+
+        EarcutLinked(outerNode,0);
+
+        return std::move(triangles);
+      }
+
+      /**
+       * Triangulate the given ring
+       */
+      template<class Vertex, class CoordGetter>
+      std::vector<GLfloat> TriangulateRing(std::span<const Vertex> ring,
+                                           CoordGetter getCoord)
+      {
+        return TriangulateRings(std::span<const std::span<const Vertex>>(&ring,1),
+                                getCoord);
+      }
+    };
+
+    std::pair<double,double> GetPointCoord(const Point& point)
+    {
+      return {point.GetLon(), point.GetLat()};
     }
+  }
 
-    return result;
+  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::span<const osmscout::Point> points) {
+    return Earcut().TriangulateRing(points,GetPointCoord);
   }
 
-  std::vector<GLfloat> osmscout::Triangulate::TriangulateWithHoles(std::vector<std::vector<osmscout::Point>> points) {
-    std::vector<GLfloat> result;
-    std::vector<p2t::Point *> polyline;
-    std::for_each(points[0].begin(), points[0].end(),
-                  [&polyline](osmscout::Point p) { polyline.push_back(new p2t::Point(p.GetLon(), p.GetLat())); });
-    p2t::CDT cdt(polyline);
+  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::span<const osmscout::Vertex2D> points) {
+    return Earcut().TriangulateRing(points,[](const Vertex2D& vertex) {
+      return std::pair<double,double>(vertex.GetX(),vertex.GetY());
+    });
+  }
 
-    ScopeGuard polylineDeleter([&polyline]() noexcept {
-      std::for_each(polyline.begin(), polyline.end(), [](p2t::Point *p){delete p;});
+  std::vector<GLfloat> osmscout::Triangulate::TriangulatePolygon(std::span<const osmscout::GeoCoord> points) {
+    return Earcut().TriangulateRing(points,[](const GeoCoord& coord) {
+      return std::pair<double,double>(coord.GetLon(),coord.GetLat());
     });
+  }
 
-    std::vector<std::vector<p2t::Point *>> holes;
+  std::vector<GLfloat> osmscout::Triangulate::TriangulateWithHoles(std::span<const std::vector<osmscout::Point>> points) {
+    return Earcut().TriangulateRings(points,GetPointCoord);
+  }
 
-    for (size_t i = 1; i < points.size(); i++) {
-      std::vector<p2t::Point *> hole;
-      std::for_each(points[i].begin(), points[i].end(),
-                    [&hole](osmscout::Point p) { hole.push_back(new p2t::Point(p.GetLon(), p.GetLat())); });
-      holes.push_back(hole);
+  TriangulationCache::TriangulationCache(size_t maxSize)
+  : maxSize(maxSize)
+  {
+    // no code
+  }
+
+  void TriangulationCache::StripCache()
+  {
+    while (size>maxSize && !order.empty()) {
+      size-=order.back().triangles->size();
+      map.erase(order.back().key);
+      order.pop_back();
     }
+  }
 
-    ScopeGuard holesDeleter([&holes]() noexcept {
-      for (const auto &hole: holes) {
-        std::for_each(hole.begin(), hole.end(), [](p2t::Point *p){delete p;});
-      }
-    });
+  TriangulationCache::TrianglesRef TriangulationCache::Get(const Key& key,
+                                                           std::span<const Point> nodes)
+  {
+    auto entry=map.find(key);
+
+    if (entry==map.end() ||
+        nodes.empty() ||
+        entry->second->nodeCount!=nodes.size() ||
+        entry->second->firstNode!=nodes.front().GetCoord()) {
+      misses++;
+      return nullptr;
+    }
+
+    order.splice(order.begin(),order,entry->second);
+    hits++;
+
+    return entry->second->triangles;
+  }
 
-    for (const auto& hole: holes) {
-      cdt.AddHole(hole);
+  TriangulationCache::TrianglesRef TriangulationCache::Set(const Key& key,
+                                                           std::span<const Point> nodes,
+                                                           std::vector<GLfloat>&& triangles)
+  {
+    auto result=std::make_shared<const std::vector<GLfloat>>(std::move(triangles));
+
+    if (nodes.empty() || result->size()>maxSize) {
+      return result;
     }
 
-    cdt.Triangulate();
-    std::vector<p2t::Triangle *> triangles;
-    triangles = cdt.GetTriangles();
-    for (size_t i = 0; i < triangles.size(); i++) {
-      p2t::Point a = *triangles[i]->GetPoint(0);
-      p2t::Point b = *triangles[i]->GetPoint(1);
-      p2t::Point c = *triangles[i]->GetPoint(2);
-      result.emplace_back(a.x);
-      result.emplace_back(a.y);
-      result.emplace_back(b.x);
-      result.emplace_back(b.y);
-      result.emplace_back(c.x);
-      result.emplace_back(c.y);
+    if (auto entry=map.find(key);
+        entry!=map.end()) {
+      size-=entry->second->triangles->size();
+      order.erase(entry->second);
+      map.erase(entry);
     }
 
+    order.push_front(Entry{key,nodes.size(),nodes.front().GetCoord(),result});
+    map.emplace(key,order.begin());
+    size+=result->size();
+
+    StripCache();
+
     return result;
   }
 
+  void TriangulationCache::SetMaxSize(size_t maxSize)
+  {
+    this->maxSize=maxSize;
+
+    StripCache();
+  }
+
+  void TriangulationCache::Flush()
+  {
+    order.clear();
+    map.clear();
+    size=0;
+  }
 }
@@ -61,6 +61,7 @@ namespace osmscout {
     using SkiaLabel = Label<SkiaNativeGlyph, SkiaNativeLabel>;
     using SkiaGlyph = Glyph<SkiaNativeGlyph>;
     using SkiaLabelLayouter = LabelLayouter<SkiaNativeGlyph, SkiaNativeLabel, MapPainterSkia>;
+    using SkiaLabelCache = LabelCache<SkiaNativeGlyph, SkiaNativeLabel>;
     friend SkiaLabelLayouter;
 
   private:
@@ -226,6 +227,15 @@ namespace osmscout {
                             const std::string& text,
                             double fontSize) override;
 
+    /**
+     * Set the cache for laid out labels. By default every painter has its own cache,
+     * a cache may be shared by multiple painters (for example in a pool of render threads).
+     * Passing nullptr disables caching.
+     */
+    void SetLabelCache(const std::shared_ptr<SkiaLabelCache>& cache);
+
+    std::shared_ptr<SkiaLabelCache> GetLabelCache() const;
+
     bool DrawMap(const Projection& projection,
                  const MapParameter& parameter,
                  const std::vector<MapData>& data,
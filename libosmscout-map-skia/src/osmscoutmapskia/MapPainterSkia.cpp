@@ -94,6 +94,8 @@ namespace osmscout {
 #endif
   {
     log.Debug() << "MapPainterSkia::MapPainterSkia() fontMgr=" << (fontMgr ? "valid" : "null");
+
+    labelLayouter.SetLabelCache(std::make_shared<SkiaLabelCache>());
   }
 
   MapPainterSkia::~MapPainterSkia()
@@ -1253,9 +1255,21 @@ namespace osmscout {
                                           const std::string& text,
                                           double fontSize)
   {
-    return MeasureLabel(Layout(projection, parameter, text, fontSize, 0, false, false),
+    return MeasureLabel(labelLayouter.LayoutLabel(projection, parameter, text, fontSize, 0, false, false),
                         [this](const SkiaNativeGlyph& glyph) {
                           return GlyphBoundingBox(glyph);
                         });
   }
+
+  void MapPainterSkia::SetLabelCache(const std::shared_ptr<SkiaLabelCache>& cache)
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+
+    labelLayouter.SetLabelCache(cache);
+  }
+
+  std::shared_ptr<MapPainterSkia::SkiaLabelCache> MapPainterSkia::GetLabelCache() const
+  {
+    return labelLayouter.GetLabelCache();
+  }
 }
@@ -53,6 +53,7 @@ namespace osmscout {
   {
   private:
     mutable std::mutex mutex;
+    mutable std::mutex loadMutex;
 
     TypeInfoSet        types;
 
@@ -191,6 +192,16 @@ namespace osmscout {
       complete=true;
     }
 
+    /**
+     * Serialize loading of data for the tile. Load tasks for the same tile data may run
+     * in parallel and must hold the lock while checking for completeness and loading
+     * missing data.
+     */
+    [[nodiscard]] std::unique_lock<std::mutex> LockLoading() const
+    {
+      return std::unique_lock<std::mutex>(loadMutex);
+    }
+
     /**
      * Return 'true' if there was data already assigned to the tile
      */
@@ -0,0 +1,319 @@
+#ifndef OSMSCOUT_MAP_LABELCACHE_H
+#define OSMSCOUT_MAP_LABELCACHE_H
+
+/*
+  This source is part of the libosmscout-map library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscoutmap/MapImportExport.h>
+
+namespace osmscout {
+
+  template<class NativeGlyph>
+  class Glyph;
+
+  template<class NativeGlyph, class NativeLabel>
+  class Label;
+
+  /**
+   * \ingroup Renderer
+   *
+   * Everything the layout of a label depends on
+   */
+  struct LabelCacheKey
+  {
+    std::string text;           //!< The label text
+    std::string fontName;       //!< Name of the font
+    double      fontSize;       //!< Font size in pixels
+    int         objectWidth;    //!< Width of the labeled object in pixels (rounded up)
+    bool        enableWrapping; //!< Label may be wrapped into multiple lines
+    bool        contourLabel;   //!< Label is drawn along a path
+    const void* owner;          //!< Painter owning the label, if labels must not be shared between painters
+
+    bool operator==(const LabelCacheKey& other) const
+    {
+      return owner==other.owner &&
+             fontSize==other.fontSize &&
+             objectWidth==other.objectWidth &&
+             enableWrapping==other.enableWrapping &&
+             contourLabel==other.contourLabel &&
+             text==other.text &&
+             fontName==other.fontName;
+    }
+  };
+
+  struct LabelCacheKeyHasher
+  {
+    size_t operator()(const LabelCacheKey& key) const
+    {
+      size_t hash=std::hash<std::string>()(key.text);
+
+      hash=hash*31+std::hash<std::string>()(key.fontName);
+      hash=hash*31+std::hash<double>()(key.fontSize);
+      hash=hash*31+std::hash<int>()(key.objectWidth);
+      hash=hash*31+(key.enableWrapping ? 1 : 0)+(key.contourLabel ? 2 : 0);
+      hash=hash*31+std::hash<const void*>()(key.owner);
+
+      return hash;
+    }
+  };
+
+  /**
+   * \ingroup Renderer
+   *
+   * Least recently used cache of laid out labels, so that text of labels visible in
+   * consecutive frames (for example while panning) must not be shaped and measured again.
+   * For contour labels the glyphs of the label are cached, too.
+   *
+   * The cache is bounded by a memory budget. The memory of the native label layout is not
+   * known to the cache, so it is estimated based on the length of the text.
+   *
+   * The cache is thread safe and can be shared by multiple painters of the same backend.
+   * Cached labels are never modified after they were inserted. Backends with native labels
+   * that are bound to the painter (like Cairo with Pango) store an owner in the key, so
+   * such painters share the memory budget, but not the labels.
+   *
+   * The label line settings of the MapParameter (used for wrapping) are not part of
+   * the key. The cache must be flushed, if they are changed.
+   */
+  template<class NativeGlyph, class NativeLabel>
+  class LabelCache CLASS_FINAL
+  {
+  public:
+    using LabelType = Label<NativeGlyph, NativeLabel>;
+    using LabelPtr = std::shared_ptr<LabelType>;
+    using GlyphVector = std::vector<Glyph<NativeGlyph>>;
+    using GlyphVectorPtr = std::shared_ptr<const GlyphVector>;
+
+    static constexpr size_t DefaultMemoryBudget=8*1024*1024; //!< Default memory budget in bytes
+    static constexpr size_t NativeBytesPerCharacter=64;      //!< Estimated memory of the native layout per character
+
+    struct Statistics
+    {
+      size_t hits=0;
+      size_t misses=0;
+      size_t evictions=0;
+      size_t entries=0;
+      size_t memory=0;       //!< Estimated memory of all entries in bytes
+      size_t memoryBudget=0; //!< Memory budget in bytes
+
+      double GetHitRate() const
+      {
+        return hits+misses>0 ? double(hits)/double(hits+misses) : 0.0;
+      }
+    };
+
+  private:
+    struct Entry
+    {
+      LabelCacheKey  key;
+      LabelPtr       label;
+      GlyphVectorPtr glyphs;
+      size_t         memory;
+    };
+
+    using OrderList = std::list<Entry>;
+    using Map = std::unordered_map<LabelCacheKey,typename OrderList::iterator,LabelCacheKeyHasher>;
+
+    mutable std::mutex mutex;
+    OrderList          order;        //!< Entries, most recently used first
+    Map                map;
+    size_t             memory=0;
+    size_t             memoryBudget;
+    size_t             hits=0;
+    size_t             misses=0;
+    size_t             evictions=0;
+
+  private:
+    static size_t EstimateMemory(const LabelCacheKey& key,
+                                 const LabelPtr& label)
+    {
+      return sizeof(Entry)+
+             sizeof(typename Map::value_type)+
+             sizeof(LabelType)+
+             key.text.size()+
+             key.fontName.size()+
+             label->text.size()*(NativeBytesPerCharacter+1);
+    }
+
+    void StripCache()
+    {
+      while (memory>memoryBudget && !order.empty()) {
+        memory-=order.back().memory;
+        map.erase(order.back().key);
+        order.pop_back();
+        evictions++;
+      }
+    }
+
+  public:
+    explicit LabelCache(size_t memoryBudget=DefaultMemoryBudget)
+    : memoryBudget(memoryBudget)
+    {
+      // no code
+    }
+
+    /**
+     * Return the cached label for the given key. If there is no cached label, the label
+     * is laid out by calling the given function and added to the cache.
+     *
+     * The layout function is called without holding the cache lock, so in case of concurrent
+     * misses for the same key a label may be laid out more than once.
+     */
+    template<class LayoutFunction>
+    LabelPtr GetLabel(const LabelCacheKey& key,
+                      LayoutFunction&& layout)
+    {
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        if (auto entry=map.find(key);
+            entry!=map.end()) {
+          order.splice(order.begin(),order,entry->second);
+          hits++;
+
+          return entry->second->label;
+        }
+
+        misses++;
+      }
+
+      LabelPtr label=layout();
+
+      if (!label) {
+        return label;
+      }
+
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      if (auto entry=map.find(key);
+          entry!=map.end()) {
+        return entry->second->label;
+      }
+
+      size_t entryMemory=EstimateMemory(key,label);
+
+      if (entryMemory>memoryBudget) {
+        return label;
+      }
+
+      order.push_front(Entry{key,label,nullptr,entryMemory});
+      map.emplace(key,order.begin());
+      memory+=entryMemory;
+
+      StripCache();
+
+      return label;
+    }
+
+    /**
+     * Return the glyphs of the given label, which must have been returned by GetLabel()
+     * for the given key. The glyphs are computed on first request and then stored together
+     * with the label.
+     */
+    GlyphVectorPtr GetGlyphs(const LabelCacheKey& key,
+                             const LabelPtr& label)
+    {
+      {
+        std::scoped_lock<std::mutex> lock(mutex);
+
+        if (auto entry=map.find(key);
+            entry!=map.end() &&
+            entry->second->label==label &&
+            entry->second->glyphs) {
+          return entry->second->glyphs;
+        }
+      }
+
+      GlyphVectorPtr glyphs=std::make_shared<const GlyphVector>(label->ToGlyphs());
+
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      if (auto entry=map.find(key);
+          entry!=map.end() &&
+          entry->second->label==label &&
+          !entry->second->glyphs) {
+        size_t glyphMemory=glyphs->size()*sizeof(Glyph<NativeGlyph>);
+
+        entry->second->glyphs=glyphs;
+        entry->second->memory+=glyphMemory;
+        memory+=glyphMemory;
+
+        StripCache();
+      }
+
+      return glyphs;
+    }
+
+    void SetMemoryBudget(size_t memoryBudget)
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      this->memoryBudget=memoryBudget;
+
+      StripCache();
+    }
+
+    size_t GetMemoryBudget() const
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      return memoryBudget;
+    }
+
+    /**
+     * Remove all entries from the cache
+     */
+    void Flush()
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      map.clear();
+      order.clear();
+      memory=0;
+    }
+
+    Statistics GetStatistics() const
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      Statistics                   statistics;
+
+      statistics.hits=hits;
+      statistics.misses=misses;
+      statistics.evictions=evictions;
+      statistics.entries=map.size();
+      statistics.memory=memory;
+      statistics.memoryBudget=memoryBudget;
+
+      return statistics;
+    }
+  };
+}
+
+#endif
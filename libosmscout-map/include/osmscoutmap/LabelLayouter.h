@@ -29,6 +29,7 @@
 #include <osmscoutmap/StyleConfig.h>
 #include <osmscoutmap/LabelPath.h>
 #include <osmscoutmap/LabelLayouterHelper.h>
+#include <osmscoutmap/LabelCache.h>
 
 #include <osmscout/system/Math.h>
 
@@ -266,6 +267,8 @@ constexpr bool debugLabelLayouter = false;
     using LabelType = Label<NativeGlyph, NativeLabel>;
     using LabelPtr = std::shared_ptr<LabelType>;
     using LabelInstanceType = LabelInstance<NativeGlyph, NativeLabel>;
+    using LabelCacheType = LabelCache<NativeGlyph, NativeLabel>;
+    using LabelCacheRef = std::shared_ptr<LabelCacheType>;
 
   public:
     explicit LabelLayouter(TextLayouter *textLayouter):
@@ -293,6 +296,66 @@ constexpr bool debugLabelLayouter = false;
       labelInstances.clear();
     }
 
+    /**
+     * Set the cache for laid out labels. The cache may be shared with other layouters
+     * of the same backend. If no cache is set (the default), labels are laid out
+     * every time.
+     *
+     * If an owner is given, cached labels are only returned to layouters with the same
+     * owner. This is required, if the native label must not be used by other painters.
+     */
+    void SetLabelCache(const LabelCacheRef& cache,
+                       const void* owner=nullptr)
+    {
+      labelCache=cache;
+      labelCacheOwner=owner;
+    }
+
+    const LabelCacheRef& GetLabelCache() const
+    {
+      return labelCache;
+    }
+
+    /**
+     * Layout the given text using the text layouter. The label is taken from
+     * the label cache, if there is one.
+     */
+    LabelPtr LayoutLabel(const Projection& projection,
+                         const MapParameter& parameter,
+                         const std::string& text,
+                         double fontSize,
+                         double objectWidth,
+                         bool enableWrapping,
+                         bool contourLabel)
+    {
+      if (!labelCache) {
+        return textLayouter->Layout(projection,
+                                    parameter,
+                                    text,
+                                    fontSize,
+                                    objectWidth,
+                                    enableWrapping,
+                                    contourLabel);
+      }
+
+      return labelCache->GetLabel(GetLabelCacheKey(projection,
+                                                   parameter,
+                                                   text,
+                                                   fontSize,
+                                                   objectWidth,
+                                                   enableWrapping,
+                                                   contourLabel),
+                                  [&]() {
+                                    return textLayouter->Layout(projection,
+                                                                parameter,
+                                                                text,
+                                                                fontSize,
+                                                                objectWidth,
+                                                                enableWrapping,
+                                                                contourLabel);
+                                  });
+    }
+
     // Something is an overlay, if its alpha is <0.8
     static bool IsOverlay(const LabelData &labelData)
     {
@@ -323,6 +386,11 @@ constexpr bool debugLabelLayouter = false;
       ScreenMask labelCanvas;
       ScreenMask overlayCanvas;
 
+      // Scratch buffers, reused for all labels of the job to avoid allocations per label
+      std::vector<ScreenRectMask> masks;     //!< Masks of the individual elements or glyphs of the current label
+      std::vector<ScreenMask*>    canvases;  //!< Corresponding canvas for each element or null (if collision)
+      std::vector<typename LabelInstanceType::Element> visibleElements; //!< Elements to be rendered (no collision)
+
       LayoutJob(const ScreenVectorRectangle &layoutViewport,
                 const Projection& projection,
                 const MapParameter& parameter):
@@ -396,11 +464,13 @@ constexpr bool debugLabelLayouter = false;
 
       {
         size_t elementCount = currentLabel.elements.size();       // Number of elements in label
-        std::vector<ScreenRectMask> masks(elementCount);          // Vector of masks of each individual object
-        std::vector<ScreenMask*> canvases(elementCount, nullptr); // Corresponding canvas for each label or null (if collision)
 
-        // List of elements to be rendered (no collision)
-        std::vector<typename LabelInstance<NativeGlyph, NativeLabel>::Element> visibleElements;
+        if (masks.size()<elementCount) {
+          masks.resize(elementCount);
+        }
+
+        canvases.assign(elementCount, nullptr);
+        visibleElements.clear();
 
         for (size_t eli=0; eli < elementCount; eli++) {
           const typename LabelInstance<NativeGlyph, NativeLabel>::Element& element = currentLabel.elements[eli];
@@ -443,8 +513,8 @@ constexpr bool debugLabelLayouter = false;
             rectangle.height = element.label->height + 2*padding;
           }
 
-          mask=ScreenRectMask(layoutViewport.width,
-                              rectangle);
+          mask.Set(layoutViewport.width,
+                   rectangle);
 
           bool collision = canvas->HasCollision(mask);
 
@@ -484,7 +554,9 @@ constexpr bool debugLabelLayouter = false;
           std::cout << "Test contour label prio " << currentContourLabel.priority << ": " << currentContourLabel.text;
         }
 
-        std::vector<ScreenRectMask> masks(glyphCnt);
+        if ((int)masks.size()<glyphCnt) {
+          masks.resize(glyphCnt);
+        }
 
         bool collision=false;
         for (int gi=0; gi<glyphCnt; gi++) {
@@ -496,8 +568,8 @@ constexpr bool debugLabelLayouter = false;
             (int)(glyph.trHeight + 2*contourLabelPadding)
           };
 
-          masks[gi]=ScreenRectMask(layoutViewport.width,
-                                   rect);
+          masks[gi].Set(layoutViewport.width,
+                        rect);
 
           if (labelCanvas.HasCollision(masks[gi])) {
             collision=true;
@@ -709,11 +781,11 @@ constexpr bool debugLabelLayouter = false;
           instance.priority);
         // TODO: should we take style into account?
         // Qt allows to split text layout and style setup
-        element.label = textLayouter->Layout(projection, parameter,
-                                             data.text, data.fontSize,
-                                             objectWidth,
-                                             /*enable wrapping*/ true,
-                                             /*contour label*/ false);
+        element.label = LayoutLabel(projection, parameter,
+                                    data.text, data.fontSize,
+                                    objectWidth,
+                                    /*enable wrapping*/ true,
+                                    /*contour label*/ false);
         element.x = point.GetX() - element.label->width / 2;
         if (offset<0){
           element.y = point.GetY() - element.label->height / 2;
@@ -786,20 +858,34 @@ constexpr bool debugLabelLayouter = false;
                               const PathLabelData &labelData,
                               const LabelPath &labelPath)
     {
-      // TODO: cache label for string and font parameters
-      LabelPtr label=textLayouter->Layout(projection,
-                                          parameter,
-                                          labelData.text,
-                                          labelData.height,
-                                          /* object width */ 0.0,
-                                          /*enable wrapping*/ false,
-                                          /*contour label*/ true);
+      LabelPtr label=LayoutLabel(projection,
+                                 parameter,
+                                 labelData.text,
+                                 labelData.height,
+                                 /* object width */ 0.0,
+                                 /*enable wrapping*/ false,
+                                 /*contour label*/ true);
 
       // text should be rendered with 0x0 coordinate as left baseline
       // we want to move label a bit to the bottom, near to line center
       double                           textBaselineOffset = label->height * 0.25;
 
-      std::vector<Glyph<NativeGlyph>>  glyphs = label->ToGlyphs();
+      typename LabelCacheType::GlyphVectorPtr glyphs;
+
+      if (labelCache) {
+        glyphs=labelCache->GetGlyphs(GetLabelCacheKey(projection,
+                                                      parameter,
+                                                      labelData.text,
+                                                      labelData.height,
+                                                      0.0,
+                                                      false,
+                                                      true),
+                                     label);
+      }
+      else {
+        glyphs=std::make_shared<const typename LabelCacheType::GlyphVector>(label->ToGlyphs());
+      }
+
       double                           pathLength=labelPath.GetLength();
       ContourLabelPositioner           positioner;
       ContourLabelPositioner::Position position=positioner.calculatePositions(projection,
@@ -840,7 +926,7 @@ constexpr bool debugLabelLayouter = false;
         bool upwards=initialAngle>90 && initialAngle<270;
 
 
-        for (const Glyph<NativeGlyph> &glyph:glyphs){
+        for (const Glyph<NativeGlyph> &glyph:*glyphs){
           double glyphOffset = upwards ?
                                offset - glyph.position.GetX() + label->width:
                                offset + glyph.position.GetX();
@@ -928,8 +1014,28 @@ constexpr bool debugLabelLayouter = false;
       return contourLabelInstances;
     }
 
+  private:
+    LabelCacheKey GetLabelCacheKey(const Projection& projection,
+                                   const MapParameter& parameter,
+                                   const std::string& text,
+                                   double fontSize,
+                                   double objectWidth,
+                                   bool enableWrapping,
+                                   bool contourLabel) const
+    {
+      return LabelCacheKey{text,
+                           parameter.GetFontName(),
+                           fontSize*projection.ConvertWidthToPixel(parameter.GetFontSize()),
+                           int(std::ceil(objectWidth)),
+                           enableWrapping,
+                           contourLabel,
+                           labelCacheOwner};
+    }
+
   private:
     TextLayouter *textLayouter;
+    LabelCacheRef labelCache;
+    const void *labelCacheOwner=nullptr;
     std::vector<ContourLabelType> contourLabelInstances;
     std::vector<LabelInstanceType> labelInstances;
     ScreenVectorRectangle visibleViewport{0,0,0,0};
@@ -24,6 +24,7 @@
 #include <memory>
 #include <set>
 #include <array>
+#include <vector>
 
 #include <osmscoutmap/MapImportExport.h>
 
@@ -112,24 +113,39 @@ namespace osmscout {
    * Holds a rectangular bit mask
    *
    * Implementation:
-   * Only one row of the mask is stored together with the indexes of the starting and final row
+   * Only one row of the mask is stored together with the indexes of the starting and final row.
+   * The row only holds the cells in the interval [GetFirstCell(),GetLastCell()].
    */
   class OSMSCOUT_MAP_API ScreenRectMask CLASS_FINAL
   {
   private:
-    int                   cellFrom{0}; // First used byte of mask
-    int                   cellTo{0};   // Last used byte of mask
+    int                   cellFrom{0}; // First used cell of mask
+    int                   cellTo{-1};  // Last used cell of mask
     int                   rowFrom{0};  // First row of mask
-    int                   rowTo{0};    // Last row of mask
-    std::vector<uint64_t> bitmask;     // bitmask for one row
+    int                   rowTo{-1};   // Last row of mask
+    std::vector<uint64_t> bitmask;     // bitmask for the used cells of one row
 
   public:
     ScreenRectMask() = default;
     ScreenRectMask(size_t screenWidth,
                    const ScreenPixelRectangle &rect);
 
+    /**
+     * (Re)initialize the mask for the given rectangle. Already allocated memory
+     * is reused, so a mask instance can be used as scratch buffer for multiple rectangles.
+     */
+    void Set(size_t screenWidth,
+             const ScreenPixelRectangle &rect);
+
     bool Intersects(const ScreenRectMask& other) const;
 
+    /**
+     * Return true, if the mask does not contain any pixel on the screen
+     */
+    bool IsEmpty() const {
+      return bitmask.empty();
+    }
+
     /**
      * Return starting index of row (y-coordinate of rectangle)
      * @return index
@@ -172,8 +188,23 @@ namespace osmscout {
      * @return te bit mask
      */
     uint64_t GetCell(size_t idx) const;
+
+    /**
+     * Return the cells in the interval [GetFirstCell(),GetLastCell()] as continuous array,
+     * the first entry is the cell with index GetFirstCell()
+     */
+    const uint64_t* GetCells() const {
+      return bitmask.data();
+    }
   };
 
+  /**
+   * Bit mask of the whole screen, one bit per pixel.
+   *
+   * Rows of a ScreenRectMask are checked and marked as a whole. The cells of a row are
+   * processed using SIMD instructions (AVX2 or SSE2, depending on the compiler flags)
+   * with a scalar fallback.
+   */
   class OSMSCOUT_MAP_API ScreenMask CLASS_FINAL
   {
   private:
@@ -32,6 +32,7 @@
 
 #include <osmscout/GroundTile.h>
 #include <osmscout/elevation/SRTM.h>
+#include <osmscout/elevation/TerrainTile.h>
 
 #include <osmscout/system/Compiler.h>
 
@@ -60,6 +61,7 @@ namespace osmscout {
     std::list<GroundTile> groundTiles;  //!< List of ground tiles (optional)
     std::list<GroundTile> baseMapTiles; //!< List of ground tiles of base map (optional)
     SRTMDataRef           srtmTile;     //!< Optional data with height information
+    std::vector<TerrainTileRef> terrainTiles; //!< Optional precomputed contour lines and hill shading
 
   public:
     void ClearDBData();
@@ -297,6 +297,10 @@ namespace osmscout {
     std::vector<TextStyleRef>    textStyles;         //!< Temporary storage for StyleConfig return value
     std::vector<LineStyleRef>    lineStyles;         //!< Temporary storage for StyleConfig return value
     std::vector<PathSymbolStyleRef> symbolStyles;    //!< Temporary storage for StyleConfig return value
+    std::vector<Point>           clippedNodes;       //!< Temporary storage for clipped area rings
+
+    size_t                       areaCoordCount=0;        //!< Number of area coordinates of the current render run
+    size_t                       clippedAreaCoordCount=0; //!< Number of area coordinates left after clipping
 
     /**                           L
      Precalculations
@@ -383,6 +387,7 @@ namespace osmscout {
                      const StyleConfig& styleConfig,
                      const Projection& projection,
                      const MapParameter& parameter,
+                     const GeoBox& clipBox,
                      const AreaRef &area);
 
     void PrepareAreaLabel(const Projection& projection,
@@ -443,6 +448,18 @@ namespace osmscout {
                          const MapParameter& parameter,
                          const std::list<GroundTile> &groundTiles);
 
+    void DrawTerrainContourLines(size_t dbIndex,
+                                 const Projection& projection,
+                                 const MapParameter& parameter,
+                                 const std::vector<TerrainTileRef>& terrainTiles,
+                                 const FeatureValueBuffer& buffer,
+                                 const LineStyleRef& lineStyle);
+
+    void DrawTerrainHillShading(const Projection& projection,
+                                const MapParameter& parameter,
+                                const std::vector<TerrainTileRef>& terrainTiles,
+                                const FillStyle& hillShadingFill);
+
     //@}
 
     /**
@@ -89,6 +89,23 @@ namespace osmscout {
     void DumpMapPainterStatistics(const Projection& projection,
                                   const MapParameter& parameter,
                                   const std::vector<MapData>& data);
+
+    /**
+     * Dump the number of area coordinates before and after clipping against the visible
+     * region, in total and per (256x256 pixel) tile
+     */
+    void DumpAreaClippingStatistics(const Projection& projection,
+                                    size_t coordCount,
+                                    size_t clippedCoordCount);
+
+    /**
+     * Dump the number of areas with prepared labels, how many of them use an anchor
+     * precomputed at import and the preparation time, in total and per (256x256 pixel) tile
+     */
+    void DumpAreaLabelStatistics(const Projection& projection,
+                                 size_t areaCount,
+                                 size_t anchorCount,
+                                 double milliseconds);
   };
 }
 #endif
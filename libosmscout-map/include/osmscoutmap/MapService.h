@@ -22,7 +22,6 @@
 
 #include <list>
 #include <memory>
-#include <thread>
 #include <vector>
 
 #include <osmscoutmap/MapImportExport.h>
@@ -37,7 +36,7 @@
 #include <osmscout/async/Breaker.h>
 #include <osmscout/util/GeoBox.h>
 #include <osmscout/util/StopClock.h>
-#include <osmscout/async/WorkQueue.h>
+#include <osmscout/async/ThreadPool.h>
 
 #include <osmscoutmap/DataTileCache.h>
 
@@ -58,6 +57,7 @@ namespace osmscout {
     BreakerRef    breaker;
     bool          useMultithreading=false;
     bool          resolveRouteMembers=true;
+    ThreadPool::Priority priority=ThreadPool::Priority::Normal;
 
   public:
     AreaSearchParameter() = default;
@@ -72,6 +72,8 @@ namespace osmscout {
 
     void SetBreaker(const BreakerRef& breaker);
 
+    void SetPriority(ThreadPool::Priority priority);
+
     unsigned long GetMaximumAreaLevel() const;
 
     bool GetUseLowZoomOptimization() const;
@@ -80,6 +82,10 @@ namespace osmscout {
 
     bool GetResolveRouteMembers() const;
 
+    ThreadPool::Priority GetPriority() const;
+
+    BreakerRef GetBreaker() const;
+
     bool IsAborted() const;
   };
 
@@ -94,8 +100,11 @@ namespace osmscout {
    * - Get objects of a certain type in a given area and impose certain
    * limits on the resulting data (size of area, number of objects,
    * low zoom optimizations,...).
+   *
+   * A MapService must be owned by a std::shared_ptr (see MapServiceRef), since
+   * the load tasks in the thread pool keep a reference to the service.
    */
-  class OSMSCOUT_MAP_API MapService
+  class OSMSCOUT_MAP_API MapService : public std::enable_shared_from_this<MapService>
   {
   public:
     class OSMSCOUT_MAP_API TypeDefinition CLASS_FINAL
@@ -121,23 +130,7 @@ namespace osmscout {
     DatabaseRef                  database;             //!< The reference to the db
     mutable DataTileCache        cache;                //!< Data cache
 
-    mutable WorkQueue<bool>      nodeWorkerQueue;
-    std::thread                  nodeWorkerThread;
-
-    mutable WorkQueue<bool>      wayWorkerQueue;
-    std::thread                  wayWorkerThread;
-
-    mutable WorkQueue<bool>      wayLowZoomWorkerQueue;
-    std::thread                  wayLowZoomWorkerThread;
-
-    mutable WorkQueue<bool>      areaWorkerQueue;
-    std::thread                  areaWorkerThread;
-
-    mutable WorkQueue<bool>      areaLowZoomWorkerQueue;
-    std::thread                  areaLowZoomWorkerThread;
-
-    mutable WorkQueue<bool>      routeWorkerQueue;
-    std::thread                  routeWorkerThread;
+    ThreadPoolRef                threadPool;           //!< Pool executing the load tasks
 
     CallbackId                   nextCallbackId;
     std::map<CallbackId,TileStateCallback> tileStateCallbacks;
@@ -208,6 +201,8 @@ namespace osmscout {
         return false;
       }
 
+      std::unique_lock<std::mutex> loadLock=tileData.LockLoading();
+
       if (tileData.IsComplete()) {
         return true;
       }
@@ -279,12 +274,8 @@ namespace osmscout {
       return !parameter.IsAborted();
     }
 
-    void NodeWorkerLoop();
-    void WayWorkerLoop();
-    void WayLowZoomWorkerLoop();
-    void AreaWorkerLoop();
-    void AreaLowZoomWorkerLoop();
-    void RouteWorkerLoop();
+    std::future<bool> PushTask(const AreaSearchParameter& parameter,
+                               std::function<bool()>&& task) const;
 
     std::future<bool> PushNodeTask(const AreaSearchParameter& parameter,
                                    const TypeInfoSet& nodeTypes,
@@ -339,7 +330,8 @@ namespace osmscout {
                                            bool async) const;
 
   public:
-    explicit MapService(const DatabaseRef& database);
+    explicit MapService(const DatabaseRef& database,
+                        const ThreadPoolRef& threadPool=ThreadPool::GetShared());
     virtual ~MapService();
 
     void SetCacheSize(size_t cacheSize);
@@ -395,6 +387,12 @@ namespace osmscout {
 
     SRTMDataRef GetSRTMData(const GeoBox& boundingBox) const;
 
+    bool GetTerrainTiles(const Projection& projection,
+                         std::vector<TerrainTileRef>& tiles) const;
+
+    bool GetTerrainTiles(const GeoBox& boundingBox,
+                         std::vector<TerrainTileRef>& tiles) const;
+
     CallbackId RegisterTileStateCallback(TileStateCallback callback);
     void DeregisterTileStateCallback(CallbackId callbackId);
   };
@@ -20,9 +20,13 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -70,6 +74,11 @@ namespace osmscout {
 
     size_t GetFeatureReaderIndex(const Feature& feature);
 
+    size_t GetFeatureReaderCount() const
+    {
+      return featureReaders.size();
+    }
+
     bool HasFeature(size_t featureIndex,
                     const FeatureValueBuffer& buffer) const
     {
@@ -90,6 +99,117 @@ namespace osmscout {
     bool IsOneway(const FeatureValueBuffer& buffer) const;
   };
 
+  /**
+   * \ingroup Stylesheet
+   *
+   * Cache of styles composed from multiple matching style selectors.
+   *
+   * The resolved style only depends on the set of matching selectors of the given
+   * selector list (type and magnification level). The cache key is the address of the
+   * selector list and a bitmask of matching selectors, so all objects sharing
+   * the same type, feature values and size class share the same (immutable)
+   * style instance and the style is composed just once.
+   *
+   * The cache is thread safe.
+   */
+  class OSMSCOUT_MAP_API StyleCache CLASS_FINAL
+  {
+  public:
+    static constexpr size_t MaxSelectorCount=64;   //!< Selector lists longer than this are not cached
+    static constexpr size_t MaxEntryCount=100'000; //!< Upper limit of the cache size
+
+    struct Statistics
+    {
+      size_t hits=0;
+      size_t misses=0;
+      size_t entries=0;
+
+      double GetHitRate() const
+      {
+        return hits+misses>0 ? double(hits)/double(hits+misses) : 0.0;
+      }
+    };
+
+  private:
+    struct Key
+    {
+      const void* selectors;
+      uint64_t    matches;
+
+      bool operator==(const Key& other) const
+      {
+        return selectors==other.selectors &&
+               matches==other.matches;
+      }
+    };
+
+    struct KeyHasher
+    {
+      size_t operator()(const Key& key) const
+      {
+        return std::hash<const void*>()(key.selectors) ^
+               (std::hash<uint64_t>()(key.matches) << 1);
+      }
+    };
+
+    mutable std::shared_mutex                              mutex;
+    std::unordered_map<Key,std::shared_ptr<void>,KeyHasher> cache;
+    std::atomic<bool>                                      enabled{true};
+    mutable std::atomic<size_t>                            hits{0};
+    mutable std::atomic<size_t>                            misses{0};
+
+  public:
+    bool IsEnabled() const
+    {
+      return enabled;
+    }
+
+    void SetEnabled(bool enabled);
+
+    /**
+     * Return true and set the style, if there is a cached style for the given
+     * selector list and selector match mask. The cached style may be nullptr
+     * (composed style is not visible).
+     */
+    template<class S>
+    bool Get(const void* selectors,
+             uint64_t matches,
+             std::shared_ptr<S>& style) const
+    {
+      {
+        std::shared_lock lock(mutex);
+
+        if (auto entry=cache.find(Key{selectors,matches});
+            entry!=cache.end()) {
+          style=std::static_pointer_cast<S>(entry->second);
+          hits.fetch_add(1,std::memory_order_relaxed);
+
+          return true;
+        }
+      }
+
+      misses.fetch_add(1,std::memory_order_relaxed);
+
+      return false;
+    }
+
+    template<class S>
+    void Put(const void* selectors,
+             uint64_t matches,
+             const std::shared_ptr<S>& style)
+    {
+      std::unique_lock lock(mutex);
+
+      if (cache.size()<MaxEntryCount) {
+        cache.emplace(Key{selectors,matches},style);
+      }
+    }
+
+    void Clear();
+
+    Statistics GetStatistics() const;
+  };
+
   /**
    * \ingroup Stylesheet
    *
@@ -215,6 +335,46 @@ namespace osmscout {
     void SetMaxPx(double maxPx);
 
     bool Evaluate(double meterInPixel, double meterInMM) const;
+
+    bool HasMinMM() const
+    {
+      return minMMSet;
+    }
+
+    double GetMinMM() const
+    {
+      return minMM;
+    }
+
+    bool HasMinPx() const
+    {
+      return minPxSet;
+    }
+
+    double GetMinPx() const
+    {
+      return minPx;
+    }
+
+    bool HasMaxMM() const
+    {
+      return maxMMSet;
+    }
+
+    double GetMaxMM() const
+    {
+      return maxMM;
+    }
+
+    bool HasMaxPx() const
+    {
+      return maxPxSet;
+    }
+
+    double GetMaxPx() const
+    {
+      return maxPx;
+    }
   };
 
   using SizeConditionRef = std::shared_ptr<SizeCondition>;
@@ -343,6 +503,16 @@ namespace osmscout {
       return oneway;
     }
 
+    const std::list<FeatureFilterData>& GetFeatures() const
+    {
+      return features;
+    }
+
+    const SizeConditionRef& GetSizeCondition() const
+    {
+      return sizeCondition;
+    }
+
     bool Matches(const StyleResolveContext& context,
                  const FeatureValueBuffer& buffer,
                  double meterInPixel,
@@ -482,6 +652,16 @@ namespace osmscout {
     {
       // no code
     }
+
+    StyleSelector(const StyleCriteria& criteria,
+                  const std::set<A>& attributes,
+                  const std::shared_ptr<S>& style)
+    : criteria(criteria),
+      attributes(attributes),
+      style(style)
+    {
+      // no code
+    }
   };
 
   using LinePartialStyle = PartialStyle<LineStyle,LineStyle::Attribute>;
@@ -555,6 +735,7 @@ namespace osmscout {
 
   private:
     mutable StyleResolveContext                styleResolveContext;    //!< Instance of helper class that can get passed around to templated helper methods
+    mutable StyleCache                         styleCache;             //!< Cache of composed styles
 
     FeatureValueBuffer                         tileLandBuffer;         //!< Fake FeatureValueBuffer for land tiles
     FeatureValueBuffer                         tileSeaBuffer;          //!< Fake FeatureValueBuffer for sea tiles
@@ -638,9 +819,20 @@ namespace osmscout {
     std::list<StyleError>                      errors;
     std::list<StyleError>                      warnings;
 
+    std::unordered_map<std::string,bool>       initialFlags;           //!< Flags as set before loading the style sheet
+    std::list<std::pair<std::string,uint64_t>> sourceFiles;            //!< Loaded style sheet files and hash of their content
+
   private:
     void Reset();
 
+    static uint64_t CalculateContentHash(const char* content,
+                                         size_t size);
+    uint64_t CalculateTypeConfigHash() const;
+
+    bool ReadBinary(const std::string& filename,
+                    const std::string& styleFile,
+                    Log& log);
+
     void PostprocessNodes();
     void PostprocessWays();
     void PostprocessAreas();
@@ -690,6 +882,13 @@ namespace osmscout {
 
     size_t GetFeatureFilterIndex(const Feature& feature) const;
 
+    /**
+     * Enable or disable caching of composed styles (enabled by default)
+     */
+    void SetStyleCacheEnabled(bool enabled);
+
+    StyleCache::Statistics GetStyleCacheStatistics() const;
+
     StyleConfig& SetWayPrio(const TypeInfoRef& type,
                             size_t prio);
 
@@ -859,6 +1058,27 @@ namespace osmscout {
     const std::list<StyleError>&  GetErrors() const;
     const std::list<StyleError>&  GetWarnings() const;
     //@}
+
+    /**
+     * Methods for storing and loading the resolved state of a style sheet
+     * as binary file, to avoid parsing and postprocessing of the style sheet
+     * on each start
+     */
+    //@{
+    bool StoreBinary(const std::string& filename,
+                     Log& log=osmscout::log) const;
+    bool LoadBinary(const std::string& filename,
+                    Log& log=osmscout::log);
+    bool LoadCached(const std::string& styleFile,
+                    const std::string& cacheFile,
+                    ColorPostprocessor colorPostprocessor=nullptr,
+                    Log& log=osmscout::log);
+
+    static std::string GetCacheFileName(const std::string& cacheDirectory,
+                                        const std::string& databaseDirectory,
+                                        const std::string& styleFile,
+                                        const std::unordered_map<std::string,bool>& flags={});
+    //@}
   };
 
   using StyleConfigRef = std::shared_ptr<StyleConfig>;
@@ -19,102 +19,176 @@
 
 #include <osmscoutmap/LabelLayouterHelper.h>
 
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(OSMSCOUT_HAVE_SSE2)
+#include <emmintrin.h>
+#define OSMSCOUT_SCREEN_MASK_SSE2
+#endif
+
 namespace osmscout {
-  ScreenRectMask::ScreenRectMask(size_t screenWidth,
-                                 const ScreenPixelRectangle &rect)
+
+  static constexpr size_t   bitsPerCell=64u;
+  static constexpr uint64_t allBitsSet=~uint64_t(0);
+
+  /**
+   * Return true, if at least one bit is set in both arrays
+   */
+  static inline bool HasCommonBits(const uint64_t* a,
+                                   const uint64_t* b,
+                                   size_t count)
   {
-    constexpr size_t   bitsPerCell=64u;
-    constexpr uint64_t allBitsSet=~0;
+    size_t i=0;
 
-    size_t rowLength=screenWidth / bitsPerCell +1;
+#if defined(__AVX2__)
+    for (; i+4<=count; i+=4) {
+      __m256i x=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i));
+      __m256i y=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i));
 
-    if (screenWidth % bitsPerCell!=0u) {
-      rowLength++;
+      if (!_mm256_testz_si256(x,y)) {
+        return true;
+      }
     }
+#endif
 
-    rowFrom=rect.y;
-    rowTo=rect.y+rect.height-1;
+#if defined(OSMSCOUT_SCREEN_MASK_SSE2)
+    for (; i+2<=count; i+=2) {
+      __m128i x=_mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+      __m128i y=_mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+      __m128i common=_mm_and_si128(x,y);
 
-    bitmask.resize(rowLength);
-
-    // Rectangle is to the right of the screen
-    if (rect.x>(int)screenWidth) {
-      return;
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(common,_mm_setzero_si128()))!=0xffff) {
+        return true;
+      }
     }
+#endif
 
-    // Rectangle is to the left of the screen
-    if (rect.x+rect.width-1<0) {
-      return;
+    for (; i<count; i++) {
+      if ((a[i] & b[i])!=0u) {
+        return true;
+      }
     }
 
-    size_t startX=std::max(0,rect.x);
-    size_t endX=std::min(size_t(std::max(rect.x+rect.width-1,0)),screenWidth-1);
+    return false;
+  }
 
-    cellFrom=startX / bitsPerCell;
+  /**
+   * Set all bits of b in a
+   */
+  static inline void AddBits(uint64_t* a,
+                             const uint64_t* b,
+                             size_t count)
+  {
+    size_t i=0;
 
-    cellTo=endX / bitsPerCell;
+#if defined(__AVX2__)
+    for (; i+4<=count; i+=4) {
+      __m256i x=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i));
+      __m256i y=_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i));
 
-    if (endX % bitsPerCell==0u) {
-      cellTo++;
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(a+i),_mm256_or_si256(x,y));
     }
+#endif
 
-    if (cellFrom>=int(rowLength)) {
-      return;
+#if defined(OSMSCOUT_SCREEN_MASK_SSE2)
+    for (; i+2<=count; i+=2) {
+      __m128i x=_mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+      __m128i y=_mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(a+i),_mm_or_si128(x,y));
     }
+#endif
 
-    // Fill everything between and including start and end with a "full" msk
-    // start and end will be corrected later
-    for (int x=cellFrom; x<=cellTo; x++) {
-      bitmask[x]=allBitsSet;
+    for (; i<count; i++) {
+      a[i]|=b[i];
     }
+  }
+
+  ScreenRectMask::ScreenRectMask(size_t screenWidth,
+                                 const ScreenPixelRectangle &rect)
+  {
+    Set(screenWidth,rect);
+  }
 
-    // Starting mask cell
-    size_t bitOffsetStart=startX % bitsPerCell;
-    if (bitOffsetStart!=0u) {
-      bitmask[cellFrom] =  bitmask[cellFrom] & (allBitsSet << bitOffsetStart);
+  void ScreenRectMask::Set(size_t screenWidth,
+                           const ScreenPixelRectangle &rect)
+  {
+    rowFrom=rect.y;
+    rowTo=rect.y+rect.height-1;
+    cellFrom=0;
+    cellTo=-1;
+
+    bitmask.clear();
+
+    // Rectangle without any pixel
+    if (rect.width<=0 ||
+        rect.height<=0 ||
+        screenWidth==0) {
+      return;
     }
 
-    // Final mask cell (may also be the starting cell!)
-    size_t bitOffsetEnd=endX % bitsPerCell;
-    if (bitOffsetEnd!=0u) {
-      bitmask[cellTo] = bitmask[cellTo] & (allBitsSet >> (bitsPerCell-bitOffsetEnd-1));
+    // Rectangle is to the right of the screen
+    if (rect.x>=(int)screenWidth) {
+      return;
     }
+
+    // Rectangle is to the left of the screen
+    if (rect.x+rect.width-1<0) {
+      return;
+    }
+
+    size_t startX=std::max(0,rect.x);
+    size_t endX=std::min(size_t(rect.x+rect.width-1),screenWidth-1);
+
+    cellFrom=int(startX / bitsPerCell);
+    cellTo=int(endX / bitsPerCell);
+
+    // Fill everything between and including start and end with a "full" mask,
+    // then correct start and end cell (the final cell may also be the starting cell!)
+    bitmask.assign(cellTo-cellFrom+1,allBitsSet);
+
+    bitmask.front()&=allBitsSet << (startX % bitsPerCell);
+    bitmask.back()&=allBitsSet >> (bitsPerCell-1-endX % bitsPerCell);
   }
 
   uint64_t ScreenRectMask::GetCell(size_t idx) const
   {
-    assert(idx<bitmask.size());
+    assert(int(idx)>=cellFrom && int(idx)<=cellTo);
 
-    return bitmask[idx];
+    return bitmask[idx-cellFrom];
   }
 
-
   bool ScreenRectMask::Intersects(const ScreenRectMask& other) const
   {
-    // Other is to the right of us
+    // Other is below of us
     if (other.rowFrom>rowTo) {
       return false;
     }
 
-    // Other is to the left of us
+    // Other is above of us
     if (other.rowTo<rowFrom) {
       return false;
     }
 
-    for (size_t idx=0; idx<std::min(bitmask.size(),other.bitmask.size()); idx++) {
-      if ((bitmask[idx] & other.bitmask[idx]) != 0u) {
-        return true;
-      }
+    int from=std::max(cellFrom,other.cellFrom);
+    int to=std::min(cellTo,other.cellTo);
+
+    if (from>to) {
+      return false;
     }
 
-    return false;
+    return HasCommonBits(bitmask.data()+(from-cellFrom),
+                         other.bitmask.data()+(from-other.cellFrom),
+                         size_t(to-from+1));
   }
 
   ScreenMask::ScreenMask(size_t width, size_t height)
   : height(height)
   {
-    size_t bitsPerCell=64u;
-
     rowLength=width / bitsPerCell;
 
     if (width % bitsPerCell!=0) {
@@ -126,31 +200,49 @@ namespace osmscout {
 
   void ScreenMask::AddMask(const ScreenRectMask& mask)
   {
-    for (int r=std::max(0,mask.GetFirstRow()); r<=std::min((int)height-1, mask.GetLastRow()); r++) {
-      for (int c=std::max(0,mask.GetFirstCell()); c<=std::min((int)rowLength-1, mask.GetLastCell()); c++) {
-        int idx= r * rowLength + c;
+    int rowFrom=std::max(0,mask.GetFirstRow());
+    int rowTo=std::min((int)height-1,mask.GetLastRow());
+    int cellFrom=std::max(0,mask.GetFirstCell());
+    int cellTo=std::min((int)rowLength-1,mask.GetLastCell());
 
-        assert(idx>=0);
-        assert(idx<(int)bitmask.size());
+    if (rowFrom>rowTo || cellFrom>cellTo) {
+      return;
+    }
 
-        bitmask[idx] = (bitmask[idx] | mask.GetCell(c));
-      }
+    size_t          cellCount=cellTo-cellFrom+1;
+    const uint64_t* cells=mask.GetCells()+(cellFrom-mask.GetFirstCell());
+    uint64_t*       row=bitmask.data()+rowFrom*rowLength+cellFrom;
+
+    assert(size_t(rowTo)*rowLength+cellTo<bitmask.size());
+
+    for (int r=rowFrom; r<=rowTo; r++) {
+      AddBits(row,cells,cellCount);
+      row+=rowLength;
     }
   }
 
   bool ScreenMask::HasCollision(const ScreenRectMask& mask) const
   {
-    for (int r=std::max(0,mask.GetFirstRow()); r<=std::min((int)height-1, mask.GetLastRow()); r++) {
-      for (int c=std::max(0,mask.GetFirstCell()); c<=std::min((int)rowLength-1,mask.GetLastCell()); c++) {
-        int idx= r * rowLength + c;
+    int rowFrom=std::max(0,mask.GetFirstRow());
+    int rowTo=std::min((int)height-1,mask.GetLastRow());
+    int cellFrom=std::max(0,mask.GetFirstCell());
+    int cellTo=std::min((int)rowLength-1,mask.GetLastCell());
+
+    if (rowFrom>rowTo || cellFrom>cellTo) {
+      return false;
+    }
 
-        assert(idx>=0);
-        assert(idx<(int)bitmask.size());
+    size_t          cellCount=cellTo-cellFrom+1;
+    const uint64_t* cells=mask.GetCells()+(cellFrom-mask.GetFirstCell());
+    const uint64_t* row=bitmask.data()+rowFrom*rowLength+cellFrom;
 
-        if ((bitmask[idx] & mask.GetCell(c))) {
-          return true;
-        }
+    assert(size_t(rowTo)*rowLength+cellTo<bitmask.size());
+
+    for (int r=rowFrom; r<=rowTo; r++) {
+      if (HasCommonBits(row,cells,cellCount)) {
+        return true;
       }
+      row+=rowLength;
     }
 
     return false;
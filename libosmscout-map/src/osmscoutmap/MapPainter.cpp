@@ -1215,10 +1215,167 @@ constexpr bool debugGroundTiles = false;
     return true;
   }
 
+  static constexpr uint8_t outsideSouth=1;
+  static constexpr uint8_t outsideNorth=2;
+  static constexpr uint8_t outsideWest=4;
+  static constexpr uint8_t outsideEast=8;
+
+  /**
+   * Return the sides of the clip box the coordinate is outside of (0, if it is inside)
+   */
+  static uint8_t GetOutsideCode(const GeoBox& clipBox,
+                                const GeoCoord& coord)
+  {
+    uint8_t code=0;
+
+    if (coord.GetLat()<clipBox.GetMinLat()) {
+      code|=outsideSouth;
+    }
+    else if (coord.GetLat()>clipBox.GetMaxLat()) {
+      code|=outsideNorth;
+    }
+
+    if (coord.GetLon()<clipBox.GetMinLon()) {
+      code|=outsideWest;
+    }
+    else if (coord.GetLon()>clipBox.GetMaxLon()) {
+      code|=outsideEast;
+    }
+
+    return code;
+  }
+
+  /**
+   * Return the sides of the clip box the given bounding box is completely outside of
+   */
+  static uint8_t GetOutsideCode(const GeoBox& clipBox,
+                                const GeoBox& boundingBox)
+  {
+    uint8_t code=0;
+
+    if (boundingBox.GetMaxLat()<clipBox.GetMinLat()) {
+      code|=outsideSouth;
+    }
+    else if (boundingBox.GetMinLat()>clipBox.GetMaxLat()) {
+      code|=outsideNorth;
+    }
+
+    if (boundingBox.GetMaxLon()<clipBox.GetMinLon()) {
+      code|=outsideWest;
+    }
+    else if (boundingBox.GetMinLon()>clipBox.GetMaxLon()) {
+      code|=outsideEast;
+    }
+
+    return code;
+  }
+
+  /**
+   * Copy the nodes of the area ring to result, dropping nodes that do not influence the part of the
+   * ring within the clip box.
+   *
+   * A run of consecutive nodes that are all outside of the same side of the clip box is replaced
+   * by the first and the last node of the run. The dropped part of the ring and its replacing
+   * edge are both within the half plane outside that side, so the shape of the ring within the
+   * clip box does not change. Segments, whose bounding box is completely outside of one side,
+   * are handled as a whole without looking at the individual nodes.
+   */
+  static void ClipRingNodes(const std::vector<Point>& nodes,
+                            const std::vector<SegmentGeoBox>& segments,
+                            const GeoBox& clipBox,
+                            std::vector<Point>& result)
+  {
+    uint8_t runCode=0;      // Common outside sides of the current run, 0 if there is no run
+    size_t  runLast=0;      // Index of the last node of the current run
+    bool    runOpen=false;  // The last node of the current run is not yet in result
+
+    result.clear();
+
+    auto closeRun=[&]() {
+      if (runOpen) {
+        result.push_back(nodes[runLast]);
+      }
+
+      runCode=0;
+      runOpen=false;
+    };
+
+    auto addNode=[&](size_t index,
+                     uint8_t code) {
+      if (runCode!=0 && (runCode & code)!=0) {
+        runCode&=code;
+        runLast=index;
+        runOpen=true;
+        return;
+      }
+
+      closeRun();
+      result.push_back(nodes[index]);
+
+      runCode=code;
+      runLast=index;
+    };
+
+    auto addNodes=[&](size_t from,
+                      size_t to) {
+      for (size_t i=from; i<to; i++) {
+        addNode(i,GetOutsideCode(clipBox,nodes[i].GetCoord()));
+      }
+    };
+
+    if (segments.empty() ||
+        segments.front().from!=0 ||
+        segments.back().to!=nodes.size()) {
+      addNodes(0,nodes.size());
+    }
+    else {
+      for (const auto& segment : segments) {
+        uint8_t segmentCode=GetOutsideCode(clipBox,segment.bbox);
+
+        if (segmentCode==0) {
+          addNodes(segment.from,segment.to);
+        }
+        else if (runCode!=0 && (runCode & segmentCode)!=0) {
+          runCode&=segmentCode;
+          runLast=segment.to-1;
+          runOpen=true;
+        }
+        else {
+          closeRun();
+          result.push_back(nodes[segment.from]);
+
+          runCode=segmentCode;
+          runLast=segment.to-1;
+          runOpen=segment.to-segment.from>1;
+        }
+      }
+    }
+
+    closeRun();
+  }
+
+  /**
+   * Return the geographic region outside of which area rings get clipped. The visible
+   * region is enlarged, so that area borders, border offsets and border labels of
+   * rings just outside of the visible region are still complete.
+   */
+  static GeoBox GetAreaClipBox(const Projection& projection)
+  {
+    GeoBox dimensions=projection.GetDimensions();
+    double latMargin=dimensions.GetHeight()/2.0;
+    double lonMargin=dimensions.GetWidth()/2.0;
+
+    return GeoBox(GeoCoord(dimensions.GetMinLat()-latMargin,
+                           dimensions.GetMinLon()-lonMargin),
+                  GeoCoord(dimensions.GetMaxLat()+latMargin,
+                           dimensions.GetMaxLon()+lonMargin));
+  }
+
   void MapPainter::PrepareArea(size_t dbIndex,
                                const StyleConfig& styleConfig,
                                const Projection& projection,
                                const MapParameter& parameter,
+                               const GeoBox& clipBox,
                                const AreaRef &area)
   {
     std::vector<CoordBufferRange> td(area->rings.size()); // Polygon information for each ring
@@ -1232,35 +1389,41 @@ constexpr bool debugGroundTiles = false;
         continue;
       }
 
-      if (ring.segments.size() <= 1){
+      areaCoordCount+=ring.nodes.size();
+
+      GeoBox ringBoundingBox=ring.GetBoundingBox();
+
+      if (clipBox.Includes(ringBoundingBox.GetMinCoord(),false) &&
+          clipBox.Includes(ringBoundingBox.GetMaxCoord(),false)) {
+        clippedAreaCoordCount+=ring.nodes.size();
+
         td[i]=TransformArea(ring.nodes,
                             transBuffer,
                             coordBuffer,
                             projection,
                             parameter.GetOptimizeAreaNodes(),
                             errorTolerancePixel);
+        continue;
       }
-      else {
-        std::vector<Point> nodes;
 
-        for (const auto &segment:ring.segments){
-          if (projection.GetDimensions().Intersects(segment.bbox, false)){
-            // TODO: add TransBuffer::Transform* methods with vector subrange (begin/end)
-            nodes.insert(nodes.end(), ring.nodes.data() + segment.from, ring.nodes.data() + segment.to);
-          }
-          else {
-            nodes.push_back(ring.nodes[segment.from]);
-            nodes.push_back(ring.nodes[segment.to-1]);
-          }
-        }
+      ClipRingNodes(ring.nodes,
+                    ring.segments,
+                    clipBox,
+                    clippedNodes);
 
-        td[i]=TransformArea(nodes,
-                            transBuffer,
-                            coordBuffer,
-                            projection,
-                            parameter.GetOptimizeAreaNodes(),
-                            errorTolerancePixel);
+      // A ring reduced to less than 3 nodes does not intersect the clip box
+      if (clippedNodes.size()<3) {
+        continue;
       }
+
+      clippedAreaCoordCount+=clippedNodes.size();
+
+      td[i]=TransformArea(clippedNodes,
+                          transBuffer,
+                          coordBuffer,
+                          projection,
+                          parameter.GetOptimizeAreaNodes(),
+                          errorTolerancePixel);
     }
 
     area->VisitRings([this,&styleConfig,&projection,&parameter,&td,&area, &dbIndex](size_t i,
@@ -1282,7 +1445,11 @@ constexpr bool debugGroundTiles = false;
                                 const MapParameter& parameter,
                                 const std::vector<MapData>& data)
   {
+    GeoBox clipBox=GetAreaClipBox(projection);
+
     areaData.clear();
+    areaCoordCount=0;
+    clippedAreaCoordCount=0;
 
     for (size_t dbIndex=0; dbIndex<data.size(); ++dbIndex) {
       const auto& mapData = data[dbIndex];
@@ -1292,6 +1459,7 @@ constexpr bool debugGroundTiles = false;
                     *mapData.styleConfig,
                     projection,
                     parameter,
+                    clipBox,
                     area);
       }
 
@@ -1301,9 +1469,18 @@ constexpr bool debugGroundTiles = false;
                     *mapData.styleConfig,
                     projection,
                     parameter,
+                    clipBox,
                     area);
       }
     }
+
+    if (parameter.IsDebugPerformance()) {
+      MapPainterStatistics statistics;
+
+      statistics.DumpAreaClippingStatistics(projection,
+                                            areaCoordCount,
+                                            clippedAreaCoordCount);
+    }
   }
 
   std::vector<OffsetRel> MapPainter::ParseLaneTurns(const LanesFeatureValue &feature) const
@@ -2559,6 +2736,7 @@ constexpr bool debugGroundTiles = false;
   {
     StopClock timer;
     size_t    drawnCount=0;
+    size_t    anchorCount=0;
 
     for (const auto& area : areaData)
     {
@@ -2571,13 +2749,21 @@ constexpr bool debugGroundTiles = false;
                        area);
 
       ++drawnCount;
+
+      if (area.center.has_value()) {
+        ++anchorCount;
+      }
     }
 
     timer.Stop();
 
-    if (parameter.IsDebugPerformance() && timer.IsSignificant()) {
-      log.Info()
-        << "Draw area labels: " << drawnCount << " (pcs) " << timer.ResultString() << "(s)";
+    if (parameter.IsDebugPerformance()) {
+      MapPainterStatistics statistics;
+
+      statistics.DumpAreaLabelStatistics(projection,
+                                         drawnCount,
+                                         anchorCount,
+                                         timer.GetMilliseconds());
     }
   }
 
@@ -2737,7 +2923,7 @@ constexpr bool debugGroundTiles = false;
       return;
     }
 
-    if (!data.srtmTile) {
+    if (!data.srtmTile && data.terrainTiles.empty()) {
       log.Warn() << "Contour lines activated but data available";
       return;
     }
@@ -2751,6 +2937,30 @@ constexpr bool debugGroundTiles = false;
       return;
     }
 
+    if (!data.terrainTiles.empty()) {
+      FeatureValueBuffer contourLinesBuffer;
+
+      contourLinesBuffer.SetType(srtmType);
+
+      std::vector<LineStyleRef> contourLineStyles;
+
+      styleConfig->GetWayLineStyles(contourLinesBuffer,projection,contourLineStyles);
+
+      if (contourLineStyles.empty()) {
+        log.Warn() << "Contour lines activated but no line style for type 'srtm_tile' found";
+        return;
+      }
+
+      DrawTerrainContourLines(dbIndex,
+                              projection,
+                              parameter,
+                              data.terrainTiles,
+                              contourLinesBuffer,
+                              contourLineStyles[0]);
+
+      return;
+    }
+
     if (true) {
       FeatureValueBuffer contourLinesBuffer;
 
@@ -3047,6 +3257,139 @@ constexpr bool debugGroundTiles = false;
     }
   }
 
+  /**
+   * Draw the precomputed contour lines of the given terrain tiles
+   */
+  void MapPainter::DrawTerrainContourLines(size_t dbIndex,
+                                           const Projection& projection,
+                                           const MapParameter& parameter,
+                                           const std::vector<TerrainTileRef>& terrainTiles,
+                                           const FeatureValueBuffer& buffer,
+                                           const LineStyleRef& lineStyle)
+  {
+    GeoBox boundingBox=projection.GetDimensions();
+    double lineWidth=GetProjectedWidth(projection,
+                                       projection.ConvertWidthToPixel(lineStyle->GetDisplayWidth()),
+                                       lineStyle->GetWidth());
+
+    for (const auto& tile : terrainTiles) {
+      if (!boundingBox.Intersects(tile->GetBoundingBox())) {
+        continue;
+      }
+
+      for (const auto& contourLine : tile->contourLines) {
+        if (contourLine.nodes.size()<2 ||
+            !boundingBox.Intersects(contourLine.boundingBox)) {
+          continue;
+        }
+
+        WayData wd;
+
+        wd.dbIndex=dbIndex;
+        wd.buffer=&buffer;
+        wd.layer=0;
+        wd.lineStyle=lineStyle;
+        wd.color=lineStyle->GetLineColor();
+        wd.wayPriority=std::numeric_limits<size_t>::max();
+        wd.coordRange=TransformWay(contourLine.nodes,
+                                   transBuffer,
+                                   coordBuffer,
+                                   projection,
+                                   TransPolygon::fast,
+                                   errorTolerancePixel);
+        wd.lineWidth=lineWidth;
+        wd.startIsClosed=false;
+        wd.endIsClosed=false;
+
+        DrawWay(projection,parameter,wd);
+      }
+    }
+  }
+
+  /**
+   * Draw the precomputed hill shading of the given terrain tiles. Only shadows are drawn,
+   * using the color of the given fill style with an alpha value depending on the darkness.
+   * Neighbouring cells with the same (quantized) darkness are drawn as one rectangle.
+   */
+  void MapPainter::DrawTerrainHillShading(const Projection& projection,
+                                          const MapParameter& parameter,
+                                          const std::vector<TerrainTileRef>& terrainTiles,
+                                          const FillStyle& hillShadingFill)
+  {
+    constexpr size_t ShadeLevels=16;
+    constexpr double MaxShadowAlpha=0.5;
+
+    std::array<FillStyleRef,ShadeLevels> shadeFills;
+
+    for (size_t level=1; level<ShadeLevels; level++) {
+      auto fill=std::make_shared<FillStyle>(hillShadingFill);
+
+      fill->SetFillColor(hillShadingFill.GetFillColor().Alpha(MaxShadowAlpha*double(level)/double(ShadeLevels-1)));
+      shadeFills[level]=fill;
+    }
+
+    auto getLevel=[](uint8_t shade) {
+      if (shade>=TerrainTile::FlatHillShade) {
+        return size_t(0);
+      }
+
+      double shadow=double(TerrainTile::FlatHillShade-shade)/double(TerrainTile::FlatHillShade);
+
+      return size_t(std::lround(shadow*double(ShadeLevels-1)));
+    };
+
+    GeoBox mapBoundingBox=projection.GetDimensions();
+
+    for (const auto& tile : terrainTiles) {
+      if (tile->hillShade.empty() ||
+          !mapBoundingBox.Intersects(tile->GetBoundingBox())) {
+        continue;
+      }
+
+      double rows=double(tile->hillShadeRows);
+      double columns=double(tile->hillShadeColumns);
+      size_t firstRow=size_t(std::clamp((double(tile->patchLat+1)-mapBoundingBox.GetMaxLat())*rows,0.0,rows-1));
+      size_t lastRow=size_t(std::clamp((double(tile->patchLat+1)-mapBoundingBox.GetMinLat())*rows,0.0,rows-1));
+      size_t firstColumn=size_t(std::clamp((mapBoundingBox.GetMinLon()-double(tile->patchLon))*columns,0.0,columns-1));
+      size_t lastColumn=size_t(std::clamp((mapBoundingBox.GetMaxLon()-double(tile->patchLon))*columns,0.0,columns-1));
+
+      for (size_t row=firstRow; row<=lastRow; row++) {
+        size_t column=firstColumn;
+
+        while (column<=lastColumn) {
+          size_t level=getLevel(tile->GetHillShade(column,row));
+          size_t runEnd=column+1;
+
+          while (runEnd<=lastColumn &&
+                 getLevel(tile->GetHillShade(runEnd,row))==level) {
+            runEnd++;
+          }
+
+          if (level>0) {
+            AreaData areaData;
+
+            areaData.buffer=nullptr;
+            areaData.fillStyle=shadeFills[level];
+            areaData.boundingBox=GeoBox(tile->GetHillShadeCell(column,row).GetMinCoord(),
+                                        tile->GetHillShadeCell(runEnd-1,row).GetMaxCoord());
+            areaData.isOuter=false;
+            areaData.ref=ObjectFileRef();
+            areaData.coordRange=TransformBoundingBox(areaData.boundingBox,
+                                                     transBuffer,
+                                                     coordBuffer,
+                                                     projection,
+                                                     TransPolygon::none,
+                                                     errorTolerancePixel);
+
+            DrawArea(projection,parameter,areaData);
+          }
+
+          column=runEnd;
+        }
+      }
+    }
+  }
+
   void MapPainter::DrawHillShading(const Projection& projection,
                                    const MapParameter& parameter,
                                    const std::vector<MapData>& data)
@@ -3096,6 +3439,17 @@ constexpr bool debugGroundTiles = false;
       log.Warn() << "HillShading activated but no fill style for type 'srtm_tile' found";
     }
 
+    if (!data.terrainTiles.empty()) {
+      if (hillShadingFill) {
+        DrawTerrainHillShading(projection,
+                               parameter,
+                               data.terrainTiles,
+                               *hillShadingFill);
+      }
+
+      return;
+    }
+
     if (textStyles.empty()) {
       log.Warn() << "HillShading activated but no text style for type 'srtm_tile' found";
     }
@@ -17,6 +17,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <algorithm>
 #include <numeric>
 #include <osmscoutmap/MapPainterStatistics.h>
 
@@ -63,6 +64,21 @@ namespace osmscout {
         << "+" << poiNodeCount
         << " " << wayCount
         << " " << areaCount;
+
+      for (const auto& mapData : data) {
+        if (!mapData.styleConfig) {
+          continue;
+        }
+
+        StyleCache::Statistics cacheStatistics=mapData.styleConfig->GetStyleCacheStatistics();
+
+        log.Info()
+          << "Style cache: "
+          << cacheStatistics.entries << " entries, "
+          << cacheStatistics.hits << " hits, "
+          << cacheStatistics.misses << " misses, "
+          << size_t(cacheStatistics.GetHitRate()*100.0) << "% hit rate";
+      }
     }
 
     if (parameter.GetWarningCoordCountLimit()==0 &&
@@ -81,6 +97,38 @@ namespace osmscout {
     }
   }
 
+  void MapPainterStatistics::DumpAreaClippingStatistics(const Projection& projection,
+                                                        size_t coordCount,
+                                                        size_t clippedCoordCount)
+  {
+    double tileCount=std::max(1.0,
+                              double(projection.GetWidth())*double(projection.GetHeight())/(256.0*256.0));
+    double reduction=coordCount>0 ? 100.0-double(clippedCoordCount)*100.0/double(coordCount) : 0.0;
+
+    log.Info()
+      << "Area clipping: "
+      << coordCount << " -> " << clippedCoordCount << " coords, "
+      << size_t(double(coordCount)/tileCount) << " -> " << size_t(double(clippedCoordCount)/tileCount) << " coords per tile, "
+      << size_t(reduction) << "% reduction";
+  }
+
+  void MapPainterStatistics::DumpAreaLabelStatistics(const Projection& projection,
+                                                     size_t areaCount,
+                                                     size_t anchorCount,
+                                                     double milliseconds)
+  {
+    double tileCount=std::max(1.0,
+                              double(projection.GetWidth())*double(projection.GetHeight())/(256.0*256.0));
+
+    log.Info()
+      << "Area labels: "
+      << areaCount << " areas, "
+      << anchorCount << " with precomputed anchor, "
+      << areaCount-anchorCount << " with bounding box center, "
+      << milliseconds << " ms, "
+      << milliseconds/tileCount << " ms per tile";
+  }
+
   void MapPainterStatistics::DumpDataStatistics(const std::list<DataStatistic>& statistics)
   {
     log.Info() << "Type|ObjectCount|NodeCount|WayCount|AreaCount|Nodes|Labels|Icons";
@@ -24,7 +24,6 @@
 
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
-#include <osmscout/async/Thread.h>
 
 #include <osmscout/util/Geometry.h>
 #include <osmscout/log/Logger.h>
@@ -61,6 +60,25 @@ namespace osmscout {
     this->breaker=breaker;
   }
 
+  /**
+   * Set the priority of the load tasks in the thread pool. Use ThreadPool::Priority::High
+   * for data that is visible right now and ThreadPool::Priority::Low for prefetching.
+   */
+  void AreaSearchParameter::SetPriority(ThreadPool::Priority priority)
+  {
+    this->priority=priority;
+  }
+
+  ThreadPool::Priority AreaSearchParameter::GetPriority() const
+  {
+    return priority;
+  }
+
+  BreakerRef AreaSearchParameter::GetBreaker() const
+  {
+    return breaker;
+  }
+
   unsigned long AreaSearchParameter::GetMaximumAreaLevel() const
   {
     return maxAreaLevel;
@@ -86,35 +104,26 @@ namespace osmscout {
     }
   }
 
-  MapService::MapService(const DatabaseRef& database)
+  /**
+   * Create a new MapService for the given database. Tile data is loaded in tasks
+   * executed by the given thread pool. By default the pool is shared by all services of
+   * the process. Load tasks hold a reference to the service, so the service may be
+   * destroyed by a worker of the pool. A custom pool must therefore be held by the caller
+   * as long as the service is in use.
+   */
+  MapService::MapService(const DatabaseRef& database,
+                         const ThreadPoolRef& threadPool)
    : database(database),
      cache(25),
-     nodeWorkerThread(&MapService::NodeWorkerLoop,this),
-     wayWorkerThread(&MapService::WayWorkerLoop,this),
-     wayLowZoomWorkerThread(&MapService::WayLowZoomWorkerLoop,this),
-     areaWorkerThread(&MapService::AreaWorkerLoop,this),
-     areaLowZoomWorkerThread(&MapService::AreaLowZoomWorkerLoop,this),
-     routeWorkerThread(&MapService::RouteWorkerLoop,this),
+     threadPool(threadPool),
      nextCallbackId(0)
   {
-    // no code
+    assert(threadPool);
   }
 
   MapService::~MapService()
   {
-    nodeWorkerQueue.Stop();
-    wayWorkerQueue.Stop();
-    wayLowZoomWorkerQueue.Stop();
-    areaWorkerQueue.Stop();
-    routeWorkerQueue.Stop();
-    areaLowZoomWorkerQueue.Stop();
-
-    nodeWorkerThread.join();
-    wayWorkerThread.join();
-    wayLowZoomWorkerThread.join();
-    areaWorkerThread.join();
-    routeWorkerThread.join();
-    areaLowZoomWorkerThread.join();
+    // no code
   }
 
   /**
@@ -253,6 +262,8 @@ namespace osmscout {
       return false;
     }
 
+    std::unique_lock<std::mutex> loadLock=tile->GetNodeData().LockLoading();
+
     if (tile->GetNodeData().IsComplete()) {
       return true;
     }
@@ -350,6 +361,8 @@ namespace osmscout {
       return true;
     }
 
+    std::unique_lock<std::mutex> loadLock=tile->GetOptimizedAreaData().LockLoading();
+
     if (tile->GetOptimizedAreaData().IsComplete()) {
       return true;
     }
@@ -422,6 +435,8 @@ namespace osmscout {
       return false;
     }
 
+    std::unique_lock<std::mutex> loadLock=tile->GetAreaData().LockLoading();
+
     if (tile->GetAreaData().IsComplete()) {
       return true;
     }
@@ -520,6 +535,8 @@ namespace osmscout {
       return true;
     }
 
+    std::unique_lock<std::mutex> loadLock=tile->GetOptimizedWayData().LockLoading();
+
     if (tile->GetOptimizedWayData().IsComplete()) {
       return true;
     }
@@ -628,58 +645,25 @@ namespace osmscout {
                       "route"sv, "routes"sv);
   }
 
-  void MapService::NodeWorkerLoop()
-  {
-    SetThreadName("NodeLoader");
-
-    while (auto task=nodeWorkerQueue.PopTask()) {
-      task.value()();
-    }
-  }
-
-  void MapService::WayWorkerLoop()
-  {
-    SetThreadName("WayLoader");
-
-    while (auto task=wayWorkerQueue.PopTask()) {
-      task.value()();
-    }
-  }
-
-  void MapService::WayLowZoomWorkerLoop()
-  {
-    SetThreadName("WayLowZoomLoader");
-
-    while (auto task=wayLowZoomWorkerQueue.PopTask()) {
-      task.value()();
-    }
-  }
-
-  void MapService::AreaWorkerLoop()
-  {
-    SetThreadName("AreaLoader");
-
-    while (auto task=areaWorkerQueue.PopTask()) {
-      task.value()();
-    }
-  }
-
-  void MapService::AreaLowZoomWorkerLoop()
-  {
-    SetThreadName("AreaLowZoomLoader");
-
-    while (auto task=areaLowZoomWorkerQueue.PopTask()) {
-      task.value()();
-    }
-  }
-
-  void MapService::RouteWorkerLoop()
+  /**
+   * Submit the given load task to the thread pool. The task is skipped, if the
+   * operation was aborted before the task was started.
+   *
+   * The task keeps a reference to the service, so the service is not destroyed
+   * before all its tasks are finished, without blocking in the destructor (which
+   * may run in a worker of the pool itself).
+   */
+  std::future<bool> MapService::PushTask(const AreaSearchParameter& parameter,
+                                         std::function<bool()>&& task) const
   {
-    SetThreadName("RouteLoader");
-
-    while (auto task=routeWorkerQueue.PopTask()) {
-      task.value()();
-    }
+    return threadPool->Submit([self=shared_from_this(),parameter,task=std::move(task)]() {
+                                if (parameter.IsAborted()) {
+                                  return false;
+                                }
+
+                                return task();
+                              },
+                              parameter.GetPriority());
   }
 
   std::future<bool> MapService::PushNodeTask(const AreaSearchParameter& parameter,
@@ -688,18 +672,13 @@ namespace osmscout {
                                              bool prefill,
                                              const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetNodes,this,
-                                              parameter,
-                                              nodeTypes,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    nodeWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetNodes,this,
+                              parameter,
+                              nodeTypes,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   std::future<bool> MapService::PushAreaLowZoomTask(const AreaSearchParameter& parameter,
@@ -709,19 +688,14 @@ namespace osmscout {
                                                     bool prefill,
                                                     const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetAreasLowZoom,this,
-                                              parameter,
-                                              areaTypes,
-                                              magnification,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    areaLowZoomWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetAreasLowZoom,this,
+                              parameter,
+                              areaTypes,
+                              magnification,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   std::future<bool> MapService::PushAreaTask(const AreaSearchParameter& parameter,
@@ -731,19 +705,14 @@ namespace osmscout {
                                              bool prefill,
                                              const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetAreas,this,
-                                              parameter,
-                                              areaTypes,
-                                              magnification,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    areaWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetAreas,this,
+                              parameter,
+                              areaTypes,
+                              magnification,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   std::future<bool> MapService::PushWayLowZoomTask(const AreaSearchParameter& parameter,
@@ -753,19 +722,14 @@ namespace osmscout {
                                                    bool prefill,
                                                    const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetWaysLowZoom,this,
-                                              parameter,
-                                              wayTypes,
-                                              magnification,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    wayLowZoomWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetWaysLowZoom,this,
+                              parameter,
+                              wayTypes,
+                              magnification,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   std::future<bool> MapService::PushWayTask(const AreaSearchParameter& parameter,
@@ -774,18 +738,13 @@ namespace osmscout {
                                             bool prefill,
                                             const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetWays,this,
-                                              parameter,
-                                              wayTypes,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    wayWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetWays,this,
+                              parameter,
+                              wayTypes,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   std::future<bool> MapService::PushRouteTask(const AreaSearchParameter& parameter,
@@ -794,18 +753,13 @@ namespace osmscout {
                                               bool prefill,
                                               const TileRef& tile) const
   {
-    std::packaged_task<bool()> task(std::bind(&MapService::GetRoutes,this,
-                                              parameter,
-                                              routeTypes,
-                                              boundingBox,
-                                              prefill,
-                                              tile));
-
-    std::future<bool> future=task.get_future();
-
-    routeWorkerQueue.PushTask(std::move(task));
-
-    return future;
+    return PushTask(parameter,
+                    std::bind(&MapService::GetRoutes,this,
+                              parameter,
+                              routeTypes,
+                              boundingBox,
+                              prefill,
+                              tile));
   }
 
   void MapService::NotifyTileStateCallbacks(const TileRef& tile) const
@@ -1458,6 +1412,37 @@ namespace osmscout {
     return tile;
   }
 
+  bool MapService::GetTerrainTiles(const Projection& projection,
+                                   std::vector<TerrainTileRef>& tiles) const
+  {
+    return GetTerrainTiles(projection.GetDimensions(),
+                           tiles);
+  }
+
+  /**
+   * Return the precomputed contour lines and hill shading for the given area. Returns
+   * an empty list, if the database has no terrain data.
+   */
+  bool MapService::GetTerrainTiles(const GeoBox& boundingBox,
+                                   std::vector<TerrainTileRef>& tiles) const
+  {
+    tiles.clear();
+
+    TerrainDataFileRef terrainDataFile=database->GetTerrainDataFile();
+
+    if (!terrainDataFile) {
+      return true;
+    }
+
+    if (!terrainDataFile->GetTiles(boundingBox,
+                                   tiles)) {
+      log.Error() << "Error reading terrain data!";
+      return false;
+    }
+
+    return true;
+  }
+
   MapService::CallbackId MapService::RegisterTileStateCallback(TileStateCallback callback)
   {
     std::lock_guard<std::mutex> lock(callbackMutex);
@@ -298,6 +298,35 @@ namespace osmscout {
     return true;
   }
 
+  void StyleCache::SetEnabled(bool enabled)
+  {
+    this->enabled=enabled;
+
+    Clear();
+  }
+
+  void StyleCache::Clear()
+  {
+    std::unique_lock lock(mutex);
+
+    cache.clear();
+    hits=0;
+    misses=0;
+  }
+
+  StyleCache::Statistics StyleCache::GetStatistics() const
+  {
+    Statistics statistics;
+
+    std::shared_lock lock(mutex);
+
+    statistics.hits=hits;
+    statistics.misses=misses;
+    statistics.entries=cache.size();
+
+    return statistics;
+  }
+
   StyleConfig::StyleConfig(const TypeConfigRef& typeConfig)
   : typeConfig(typeConfig),
     styleResolveContext(typeConfig)
@@ -324,6 +353,8 @@ namespace osmscout {
 
   void StyleConfig::Reset()
   {
+    styleCache.Clear();
+
     symbols.clear();
     emptySymbol=nullptr;
 
@@ -366,6 +397,8 @@ namespace osmscout {
     routePathTextStyleConditionals.clear();
 
     constants.clear();
+
+    sourceFiles.clear();
   }
 
   bool StyleConfig::RegisterLabelProviderFactory(const std::string& name,
@@ -942,6 +975,9 @@ namespace osmscout {
 
     PostprocessIconId();
     PostprocessPatternId();
+
+    // cache keys reference selector lists, that may have been changed
+    styleCache.Clear();
   }
 
   TypeConfigRef StyleConfig::GetTypeConfig() const
@@ -954,6 +990,16 @@ namespace osmscout {
     return styleResolveContext.GetFeatureReaderIndex(feature);
   }
 
+  void StyleConfig::SetStyleCacheEnabled(bool enabled)
+  {
+    styleCache.SetEnabled(enabled);
+  }
+
+  StyleCache::Statistics StyleConfig::GetStyleCacheStatistics() const
+  {
+    return styleCache.GetStatistics();
+  }
+
   StyleConfig& StyleConfig::SetWayPrio(const TypeInfoRef& type,
                                        size_t prio)
   {
@@ -1117,53 +1163,92 @@ namespace osmscout {
    */
   template<class S, class A>
   std::shared_ptr<S> GetFeatureStyle(const StyleResolveContext& context,
+                                     StyleCache& cache,
                                      const std::vector<std::list<StyleSelector<S,A>>>& styleSelectors,
                                      const FeatureValueBuffer& buffer,
                                      const Projection& projection)
   {
     assert(!styleSelectors.empty());
 
-    bool               fastpath=false;
-    bool               composed=false;
-    size_t             level=projection.GetMagnification().GetLevel();
-    double             meterInPixel=projection.GetMeterInPixel();
-    double             meterInMM=projection.GetMeterInMM();
-    std::shared_ptr<S> style;
+    size_t level=projection.GetMagnification().GetLevel();
+    double meterInPixel=projection.GetMeterInPixel();
+    double meterInMM=projection.GetMeterInMM();
 
     if (level>=styleSelectors.size()) {
       level=styleSelectors.size()-1;
     }
 
-    for (const auto& selector : styleSelectors[level]) {
-      if (!selector.criteria.Matches(context,
-                                     buffer,
-                                     meterInPixel,
-                                     meterInMM)) {
-        continue;
-      }
+    const auto& selectors=styleSelectors[level];
+    bool        cacheable=cache.IsEnabled() && selectors.size()<=StyleCache::MaxSelectorCount;
+    uint64_t    matches=0;
+    size_t      matchCount=0;
+    size_t      index=0;
 
-      if (!style) {
-        style=selector.style;
-        fastpath=true;
+    const StyleSelector<S,A>* firstMatch=nullptr;
 
-        continue;
+    for (const auto& selector : selectors) {
+      if (selector.criteria.Matches(context,
+                                    buffer,
+                                    meterInPixel,
+                                    meterInMM)) {
+        if (firstMatch==nullptr) {
+          firstMatch=&selector;
+        }
+
+        if (cacheable) {
+          matches|=uint64_t(1) << index;
+        }
+
+        matchCount++;
       }
 
-      if (fastpath) {
-        style=std::make_shared<S>(*style);
-        fastpath=false;
+      index++;
+    }
+
+    if (matchCount==0) {
+      return nullptr;
+    }
+
+    // Fastpath, we can return the style from the style sheet directly
+    if (matchCount==1) {
+      return firstMatch->style;
+    }
+
+    std::shared_ptr<S> style;
+
+    if (cacheable &&
+        cache.Get(&selectors,matches,style)) {
+      return style;
+    }
+
+    style=std::make_shared<S>(*firstMatch->style);
+    index=0;
+
+    for (const auto& selector : selectors) {
+      bool matched=cacheable ? ((matches >> index) & 1)!=0 : selector.criteria.Matches(context,
+                                                                                     buffer,
+                                                                                     meterInPixel,
+                                                                                     meterInMM);
+
+      index++;
+
+      if (!matched ||
+          &selector==firstMatch) {
+        continue;
       }
 
       style->CopyAttributes(*selector.style,
                             selector.attributes);
-      composed=true;
     }
 
-    if (composed &&
-        !style->IsVisible()) {
+    if (!style->IsVisible()) {
       style=nullptr;
     }
 
+    if (cacheable) {
+      cache.Put(&selectors,matches,style);
+    }
+
     return style;
   }
 
@@ -1195,6 +1280,7 @@ namespace osmscout {
 
     for (const auto& nodeTextStyleSelector : nodeTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          nodeTextStyleSelector[buffer.GetType()->GetIndex()],
                                          buffer,
                                          projection);
@@ -1212,6 +1298,7 @@ namespace osmscout {
 
     for (const auto& nodeTextStyleSelector : nodeTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          nodeTextStyleSelector[buffer.GetType()->GetIndex()],
                                          buffer,
                                          projection);
@@ -1228,6 +1315,7 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            nodeIconStyleSelectors[buffer.GetType()->GetIndex()],
                            buffer,
                            projection);
@@ -1244,6 +1332,7 @@ namespace osmscout {
 
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          wayLineStyleSelector[buffer.GetType()->GetIndex()],
                                          buffer,
                                          projection);
@@ -1278,6 +1367,7 @@ namespace osmscout {
 
     for (const auto& routeLineStyleSelector : routeLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          routeLineStyleSelector[buffer.GetType()->GetIndex()],
                                          buffer,
                                          projection);
@@ -1309,6 +1399,7 @@ namespace osmscout {
     symbolStyles.reserve(wayLineStyleSelectors.size());
     for (const auto& wayPathSymbolStyleSelector : wayPathSymbolStyleSelectors) {
       PathSymbolStyleRef style=GetFeatureStyle(styleResolveContext,
+                                               styleCache,
                                                wayPathSymbolStyleSelector[buffer.GetType()->GetIndex()],
                                                buffer,
                                                projection);
@@ -1323,6 +1414,7 @@ namespace osmscout {
                                                     const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            wayPathTextStyleSelectors[buffer.GetType()->GetIndex()],
                            buffer,
                            projection);
@@ -1343,6 +1435,7 @@ namespace osmscout {
                                                       const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            routePathTextStyleSelectors[buffer.GetType()->GetIndex()],
                            buffer,
                            projection);
@@ -1352,6 +1445,7 @@ namespace osmscout {
                                                         const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            wayPathShieldStyleSelectors[buffer.GetType()->GetIndex()],
                            buffer,
                            projection);
@@ -1373,6 +1467,7 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaFillStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1388,6 +1483,7 @@ namespace osmscout {
 
     for (const auto& areaBorderStyleSelector : areaBorderStyleSelectors) {
       BorderStyleRef style=GetFeatureStyle(styleResolveContext,
+                                           styleCache,
                                            areaBorderStyleSelector[type->GetIndex()],
                                            buffer,
                                            projection);
@@ -1426,6 +1522,7 @@ namespace osmscout {
 
     for (const auto& areaTextStyleSelector : areaTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          areaTextStyleSelector[type->GetIndex()],
                                          buffer,
                                          projection);
@@ -1444,6 +1541,7 @@ namespace osmscout {
 
     for (const auto& areaTextStyleSelector : areaTextStyleSelectors) {
       TextStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          areaTextStyleSelector[type->GetIndex()],
                                          buffer,
                                          projection);
@@ -1461,6 +1559,7 @@ namespace osmscout {
                                              const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaIconStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1471,6 +1570,7 @@ namespace osmscout {
                                                        const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaBorderTextStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1481,6 +1581,7 @@ namespace osmscout {
                                                            const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaBorderSymbolStyleSelectors[type->GetIndex()],
                            buffer,
                            projection);
@@ -1489,6 +1590,7 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetLandFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaFillStyleSelectors[tileLandBuffer.GetType()->GetIndex()],
                            tileLandBuffer,
                            projection);
@@ -1497,6 +1599,7 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetSeaFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaFillStyleSelectors[tileSeaBuffer.GetType()->GetIndex()],
                            tileSeaBuffer,
                            projection);
@@ -1505,6 +1608,7 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetCoastFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaFillStyleSelectors[tileCoastBuffer.GetType()->GetIndex()],
                            tileCoastBuffer,
                            projection);
@@ -1513,6 +1617,7 @@ namespace osmscout {
   FillStyleRef StyleConfig::GetUnknownFillStyle(const Projection& projection) const
   {
     return GetFeatureStyle(styleResolveContext,
+                           styleCache,
                            areaFillStyleSelectors[tileUnknownBuffer.GetType()->GetIndex()],
                            tileUnknownBuffer,
                            projection);
@@ -1522,6 +1627,7 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          wayLineStyleSelector[coastlineBuffer.GetType()->GetIndex()],
                                          coastlineBuffer,
                                          projection);
@@ -1538,6 +1644,7 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          wayLineStyleSelector[osmTileBorderBuffer.GetType()->GetIndex()],
                                          osmTileBorderBuffer,
                                          projection);
@@ -1554,6 +1661,7 @@ namespace osmscout {
   {
     for (const auto& wayLineStyleSelector : wayLineStyleSelectors) {
       LineStyleRef style=GetFeatureStyle(styleResolveContext,
+                                         styleCache,
                                          wayLineStyleSelector[osmSubTileBorderBuffer.GetType()->GetIndex()],
                                          osmSubTileBorderBuffer,
                                          projection);
@@ -1696,6 +1804,8 @@ namespace osmscout {
 
       if (!submodule) {
         Reset();
+
+        initialFlags=flags;
       }
 
       fileSize=GetFileSize(styleFile);
@@ -1719,6 +1829,9 @@ namespace osmscout {
 
       fclose(file);
 
+      sourceFiles.emplace_back(styleFile,
+                               CalculateContentHash((const char*)content,fileSize));
+
       success=LoadContent(styleFile,
                           std::string((const char*)content,fileSize),
                           colorPostprocessor,
@@ -0,0 +1,1391 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscoutmap/StyleConfig.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#include <osmscout/io/File.h>
+#include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  /**
+   * Magic number ("OSSB") at the start of a binary style sheet file
+   */
+  static const uint32_t BINARY_FILE_MAGIC=0x4f535342;
+
+  /**
+   * Version of the binary style sheet file format. Must be incremented
+   * on every change of the format or of the style classes.
+   */
+  static const uint32_t BINARY_FILE_VERSION=1;
+
+  static const uint64_t FNV_OFFSET_BASIS=14695981039346656037ULL;
+  static const uint64_t FNV_PRIME=1099511628211ULL;
+
+  static uint64_t HashBytes(uint64_t hash,
+                            const char* data,
+                            size_t size)
+  {
+    for (size_t i=0; i<size; i++) {
+      hash^=static_cast<unsigned char>(data[i]);
+      hash*=FNV_PRIME;
+    }
+
+    return hash;
+  }
+
+  static uint64_t HashString(uint64_t hash,
+                             const std::string& value)
+  {
+    // include the terminating zero to separate consecutive strings
+    return HashBytes(hash,
+                     value.c_str(),
+                     value.length()+1);
+  }
+
+  static uint64_t HashNumber(uint64_t hash,
+                             uint64_t value)
+  {
+    char buffer[sizeof(value)];
+
+    std::memcpy(buffer,&value,sizeof(value));
+
+    return HashBytes(hash,
+                     buffer,
+                     sizeof(buffer));
+  }
+
+  /**
+   * Writes the resolved state of a StyleConfig. Objects that are referenced
+   * multiple times (styles, size conditions) are written only once and later
+   * referenced by their id, so that sharing is preserved on reading.
+   */
+  class BinaryStyleWriter CLASS_FINAL
+  {
+  private:
+    FileWriter&                                 writer;
+    const StyleResolveContext&                  context;
+    std::unordered_map<const void*,uint32_t>    objectIds;
+
+  public:
+    BinaryStyleWriter(FileWriter& writer,
+                      const StyleResolveContext& context)
+    : writer(writer),
+      context(context)
+    {
+      // no code
+    }
+
+    /**
+     * Writes the id of the object and returns true, if the object was not
+     * written before and the caller has to write the object itself.
+     */
+    bool WriteObjectRef(const void* object)
+    {
+      auto entry=objectIds.find(object);
+
+      if (entry!=objectIds.end()) {
+        writer.WriteNumber(entry->second);
+
+        return false;
+      }
+
+      uint32_t id=uint32_t(objectIds.size());
+
+      objectIds.emplace(object,id);
+      writer.WriteNumber(id);
+
+      return true;
+    }
+
+    void WriteDouble(double value)
+    {
+      uint64_t bits;
+
+      std::memcpy(&bits,&value,sizeof(bits));
+
+      writer.Write(bits);
+    }
+
+    void WriteColor(const Color& color)
+    {
+      WriteDouble(color.GetR());
+      WriteDouble(color.GetG());
+      WriteDouble(color.GetB());
+      WriteDouble(color.GetA());
+    }
+
+    void WriteDoubles(const std::vector<double>& values)
+    {
+      writer.WriteNumber(uint32_t(values.size()));
+
+      for (const auto value : values) {
+        WriteDouble(value);
+      }
+    }
+
+    void WriteLabel(const LabelProviderRef& label)
+    {
+      writer.Write(label ? label->GetName() : std::string());
+    }
+
+    void WriteSymbolName(const SymbolRef& symbol)
+    {
+      writer.Write(symbol ? symbol->GetName() : std::string());
+    }
+
+    void Write(const LineStyle& style)
+    {
+      writer.Write(style.GetSlot());
+      WriteColor(style.GetLineColor());
+      WriteColor(style.GetGapColor());
+      writer.Write(style.GetPreferColorFeature());
+      WriteDouble(style.GetDisplayWidth());
+      WriteDouble(style.GetWidth());
+      WriteDouble(style.GetDisplayOffset());
+      WriteDouble(style.GetOffset());
+      writer.Write(uint8_t(style.GetJoinCap()));
+      writer.Write(uint8_t(style.GetEndCap()));
+      WriteDoubles(style.GetDash());
+      writer.Write(int32_t(style.GetPriority()));
+      writer.Write(int32_t(style.GetZIndex()));
+      writer.Write(uint8_t(style.GetOffsetRel()));
+    }
+
+    void Write(const FillStyle& style)
+    {
+      WriteColor(style.GetFillColor());
+      writer.Write(style.GetPatternName());
+      writer.WriteNumber(uint64_t(style.GetPatternId()));
+      WriteDouble(style.GetPatternMinMag().GetMagnification());
+    }
+
+    void Write(const BorderStyle& style)
+    {
+      writer.Write(style.GetSlot());
+      WriteColor(style.GetColor());
+      WriteColor(style.GetGapColor());
+      WriteDouble(style.GetWidth());
+      WriteDoubles(style.GetDash());
+      WriteDouble(style.GetDisplayOffset());
+      WriteDouble(style.GetOffset());
+      writer.Write(int32_t(style.GetPriority()));
+    }
+
+    void Write(const TextStyle& style)
+    {
+      writer.Write(style.GetSlot());
+      writer.WriteNumber(uint64_t(style.GetPriority()));
+      WriteDouble(style.GetSize());
+      WriteLabel(style.GetLabel());
+      writer.WriteNumber(uint64_t(style.GetPosition()));
+      WriteColor(style.GetTextColor());
+      WriteColor(style.GetEmphasizeColor());
+      writer.Write(uint8_t(style.GetStyle()));
+      WriteDouble(style.GetScaleAndFadeMag().GetMagnification());
+      writer.Write(style.GetAutoSize());
+    }
+
+    void Write(const PathShieldStyle& style)
+    {
+      const ShieldStyle& shieldStyle=*style.GetShieldStyle();
+
+      WriteLabel(shieldStyle.GetLabel());
+      writer.WriteNumber(uint64_t(shieldStyle.GetPriority()));
+      WriteDouble(shieldStyle.GetSize());
+      WriteColor(shieldStyle.GetTextColor());
+      WriteColor(shieldStyle.GetBgColor());
+      WriteColor(shieldStyle.GetBorderColor());
+      WriteDouble(style.GetShieldSpace());
+    }
+
+    void Write(const PathTextStyle& style)
+    {
+      WriteLabel(style.GetLabel());
+      WriteDouble(style.GetSize());
+      WriteColor(style.GetTextColor());
+      WriteDouble(style.GetDisplayOffset());
+      WriteDouble(style.GetOffset());
+      writer.WriteNumber(uint64_t(style.GetPriority()));
+    }
+
+    void Write(const IconStyle& style)
+    {
+      WriteSymbolName(style.GetSymbol());
+      writer.Write(style.GetIconName());
+      writer.WriteNumber(uint64_t(style.GetIconId()));
+      writer.WriteNumber(uint32_t(style.GetWidth()));
+      writer.WriteNumber(uint32_t(style.GetHeight()));
+      writer.WriteNumber(uint64_t(style.GetPosition()));
+      writer.WriteNumber(uint64_t(style.GetPriority()));
+      writer.Write(style.IsOverlay());
+    }
+
+    void Write(const PathSymbolStyle& style)
+    {
+      writer.Write(style.GetSlot());
+      WriteSymbolName(style.GetSymbol());
+      writer.Write(uint8_t(style.GetRenderMode()));
+      WriteDouble(style.GetScale());
+      WriteDouble(style.GetSymbolSpace());
+      WriteDouble(style.GetDisplayOffset());
+      WriteDouble(style.GetOffset());
+      writer.Write(uint8_t(style.GetOffsetRel()));
+    }
+
+    void Write(const Symbol& symbol)
+    {
+      writer.Write(symbol.GetName());
+      writer.Write(uint8_t(symbol.GetProjectionMode()));
+      writer.WriteNumber(uint32_t(symbol.GetPrimitives().size()));
+
+      for (const auto& primitive : symbol.GetPrimitives()) {
+        if (const auto* polygon=dynamic_cast<const PolygonPrimitive*>(primitive.get());
+            polygon!=nullptr) {
+          writer.Write(uint8_t(0));
+          writer.WriteNumber(uint32_t(polygon->GetCoords().size()));
+
+          for (const auto& coord : polygon->GetCoords()) {
+            WriteDouble(coord.GetX());
+            WriteDouble(coord.GetY());
+          }
+        }
+        else if (const auto* rectangle=dynamic_cast<const RectanglePrimitive*>(primitive.get());
+                 rectangle!=nullptr) {
+          writer.Write(uint8_t(1));
+          WriteDouble(rectangle->GetTopLeft().GetX());
+          WriteDouble(rectangle->GetTopLeft().GetY());
+          WriteDouble(rectangle->GetWidth());
+          WriteDouble(rectangle->GetHeight());
+        }
+        else if (const auto* circle=dynamic_cast<const CirclePrimitive*>(primitive.get());
+                 circle!=nullptr) {
+          writer.Write(uint8_t(2));
+          WriteDouble(circle->GetCenter().GetX());
+          WriteDouble(circle->GetCenter().GetY());
+          WriteDouble(circle->GetRadius());
+        }
+        else {
+          throw IOException(writer.GetFilename(),
+                            "Cannot write symbol",
+                            "Unsupported draw primitive in symbol '"+symbol.GetName()+"'");
+        }
+
+        writer.Write(bool(primitive->GetFillStyle()));
+
+        if (primitive->GetFillStyle()) {
+          Write(*primitive->GetFillStyle());
+        }
+
+        writer.Write(bool(primitive->GetBorderStyle()));
+
+        if (primitive->GetBorderStyle()) {
+          Write(*primitive->GetBorderStyle());
+        }
+      }
+    }
+
+    void Write(const StyleCriteria& criteria)
+    {
+      writer.WriteNumber(uint32_t(criteria.GetFeatures().size()));
+
+      for (const auto& feature : criteria.GetFeatures()) {
+        writer.WriteNumber(uint64_t(feature.featureFilterIndex));
+        writer.WriteNumber(uint64_t(feature.flagIndex));
+      }
+
+      writer.Write(criteria.GetOneway());
+
+      const SizeConditionRef& sizeCondition=criteria.GetSizeCondition();
+
+      writer.Write(bool(sizeCondition));
+
+      if (sizeCondition &&
+          WriteObjectRef(sizeCondition.get())) {
+        writer.Write(sizeCondition->HasMinMM());
+        WriteDouble(sizeCondition->GetMinMM());
+        writer.Write(sizeCondition->HasMinPx());
+        WriteDouble(sizeCondition->GetMinPx());
+        writer.Write(sizeCondition->HasMaxMM());
+        WriteDouble(sizeCondition->GetMaxMM());
+        writer.Write(sizeCondition->HasMaxPx());
+        WriteDouble(sizeCondition->GetMaxPx());
+      }
+    }
+
+    template<class S, class A>
+    static bool IsSameSelectorList(const std::list<StyleSelector<S,A>>& a,
+                                   const std::list<StyleSelector<S,A>>& b)
+    {
+      return std::equal(a.begin(),a.end(),
+                        b.begin(),b.end(),
+                        [](const StyleSelector<S,A>& selectorA,
+                           const StyleSelector<S,A>& selectorB) {
+                          return selectorA.criteria==selectorB.criteria &&
+                                 selectorA.attributes==selectorB.attributes &&
+                                 selectorA.style==selectorB.style;
+                        });
+    }
+
+    template<class S, class A>
+    void Write(const std::vector<std::vector<std::list<StyleSelector<S,A>>>>& table)
+    {
+      writer.WriteNumber(uint32_t(table.size()));
+
+      for (const auto& typeSelectors : table) {
+        writer.WriteNumber(uint32_t(typeSelectors.size()));
+
+        for (size_t level=0; level<typeSelectors.size(); level++) {
+          const auto& levelSelectors=typeSelectors[level];
+
+          // Selectors usually stay the same for a range of levels
+          bool sameAsPrevious=level>0 &&
+                              IsSameSelectorList(levelSelectors,
+                                                 typeSelectors[level-1]);
+
+          writer.Write(sameAsPrevious);
+
+          if (sameAsPrevious) {
+            continue;
+          }
+
+          writer.WriteNumber(uint32_t(levelSelectors.size()));
+
+          for (const auto& selector : levelSelectors) {
+            Write(selector.criteria);
+
+            writer.WriteNumber(uint32_t(selector.attributes.size()));
+
+            for (const auto attribute : selector.attributes) {
+              writer.WriteNumber(uint32_t(attribute));
+            }
+
+            if (WriteObjectRef(selector.style.get())) {
+              Write(*selector.style);
+            }
+          }
+        }
+      }
+    }
+
+    template<class S, class A>
+    void Write(const std::vector<std::vector<std::vector<std::list<StyleSelector<S,A>>>>>& tables)
+    {
+      writer.WriteNumber(uint32_t(tables.size()));
+
+      for (const auto& table : tables) {
+        Write(table);
+      }
+    }
+
+    void Write(const std::vector<TypeInfoSet>& typeSets)
+    {
+      writer.WriteNumber(uint32_t(typeSets.size()));
+
+      for (const auto& typeSet : typeSets) {
+        writer.WriteNumber(uint32_t(typeSet.Size()));
+
+        for (const auto& type : typeSet) {
+          writer.WriteNumber(uint32_t(type->GetIndex()));
+        }
+      }
+    }
+
+    void Write(const std::vector<bool>& values)
+    {
+      writer.WriteNumber(uint32_t(values.size()));
+
+      for (const auto value : values) {
+        writer.Write(bool(value));
+      }
+    }
+
+    void Write(const std::vector<size_t>& values)
+    {
+      writer.WriteNumber(uint32_t(values.size()));
+
+      for (const auto value : values) {
+        writer.WriteNumber(uint64_t(value));
+      }
+    }
+
+    void WriteFeatureReaders()
+    {
+      writer.WriteNumber(uint32_t(context.GetFeatureReaderCount()));
+
+      for (size_t i=0; i<context.GetFeatureReaderCount(); i++) {
+        writer.Write(context.GetFeatureName(i));
+      }
+    }
+  };
+
+  /**
+   * Counterpart of BinaryStyleWriter
+   */
+  class BinaryStyleReader CLASS_FINAL
+  {
+  private:
+    FileScanner&                                          scanner;
+    const StyleConfig&                                    styleConfig;
+    const TypeConfig&                                     typeConfig;
+    StyleResolveContext&                                  context;
+    std::vector<std::shared_ptr<void>>                    objects;
+    std::vector<size_t>                                   featureReaderIndexes;
+    std::unordered_map<std::string,LabelProviderRef>      labels;
+    std::unordered_map<std::string,SymbolRef>&            symbols;
+
+  private:
+    [[noreturn]] void Fail(const std::string& message) const
+    {
+      throw IOException(scanner.GetFilename(),
+                        "Cannot load style sheet",
+                        message);
+    }
+
+  public:
+    BinaryStyleReader(FileScanner& scanner,
+                      const StyleConfig& styleConfig,
+                      StyleResolveContext& context,
+                      std::unordered_map<std::string,SymbolRef>& symbols)
+    : scanner(scanner),
+      styleConfig(styleConfig),
+      typeConfig(*styleConfig.GetTypeConfig()),
+      context(context),
+      symbols(symbols)
+    {
+      // no code
+    }
+
+    /**
+     * Reads an object reference. Returns true, if the object is read the
+     * first time and the caller has to read the object itself.
+     */
+    template<class T>
+    bool ReadObjectRef(std::shared_ptr<T>& object)
+    {
+      uint32_t id=scanner.ReadUInt32Number();
+
+      if (id<objects.size()) {
+        object=std::static_pointer_cast<T>(objects[id]);
+
+        return false;
+      }
+
+      if (id!=objects.size()) {
+        Fail("Invalid object reference");
+      }
+
+      object=std::make_shared<T>();
+      objects.push_back(object);
+
+      return true;
+    }
+
+    double ReadDouble()
+    {
+      uint64_t bits=scanner.ReadUInt64();
+      double   value;
+
+      std::memcpy(&value,&bits,sizeof(value));
+
+      return value;
+    }
+
+    Color ReadColor()
+    {
+      double r=ReadDouble();
+      double g=ReadDouble();
+      double b=ReadDouble();
+      double a=ReadDouble();
+
+      return {r,g,b,a};
+    }
+
+    std::vector<double> ReadDoubles()
+    {
+      std::vector<double> values(scanner.ReadUInt32Number());
+
+      for (auto& value : values) {
+        value=ReadDouble();
+      }
+
+      return values;
+    }
+
+    LabelProviderRef ReadLabel()
+    {
+      std::string name=scanner.ReadString();
+
+      if (name.empty()) {
+        return nullptr;
+      }
+
+      auto entry=labels.find(name);
+
+      if (entry!=labels.end()) {
+        return entry->second;
+      }
+
+      LabelProviderRef label;
+
+      // See the LABEL production of the style sheet parser
+      if (auto pos=name.find('.');
+          pos!=std::string::npos) {
+        label=std::make_shared<DynamicFeatureLabelReader>(typeConfig,
+                                                          name.substr(0,pos),
+                                                          name.substr(pos+1));
+      }
+      else {
+        label=styleConfig.GetLabelProvider(name);
+      }
+
+      if (!label) {
+        Fail("There is no label provider with name '"+name+"' registered");
+      }
+
+      labels.emplace(name,label);
+
+      return label;
+    }
+
+    SymbolRef ReadSymbolName()
+    {
+      std::string name=scanner.ReadString();
+
+      if (name.empty()) {
+        return nullptr;
+      }
+
+      auto entry=symbols.find(name);
+
+      if (entry==symbols.end()) {
+        Fail("Unknown symbol '"+name+"'");
+      }
+
+      return entry->second;
+    }
+
+    void Read(LineStyle& style)
+    {
+      style.SetSlot(scanner.ReadString());
+      style.SetLineColor(ReadColor());
+      style.SetGapColor(ReadColor());
+      style.SetPreferColorFeature(scanner.ReadBool());
+      style.SetDisplayWidth(ReadDouble());
+      style.SetWidth(ReadDouble());
+      style.SetDisplayOffset(ReadDouble());
+      style.SetOffset(ReadDouble());
+      style.SetJoinCap(LineStyle::CapStyle(scanner.ReadUInt8()));
+      style.SetEndCap(LineStyle::CapStyle(scanner.ReadUInt8()));
+      style.SetDashes(ReadDoubles());
+      style.SetPriority(scanner.ReadInt32());
+      style.SetZIndex(scanner.ReadInt32());
+      style.SetOffsetRel(OffsetRel(scanner.ReadUInt8()));
+    }
+
+    void Read(FillStyle& style)
+    {
+      style.SetFillColor(ReadColor());
+      style.SetPattern(scanner.ReadString());
+      style.SetPatternId(scanner.ReadUInt64Number());
+      style.SetPatternMinMag(Magnification(ReadDouble()));
+    }
+
+    void Read(BorderStyle& style)
+    {
+      style.SetSlot(scanner.ReadString());
+      style.SetColor(ReadColor());
+      style.SetGapColor(ReadColor());
+      style.SetWidth(ReadDouble());
+      style.SetDashes(ReadDoubles());
+      style.SetDisplayOffset(ReadDouble());
+      style.SetOffset(ReadDouble());
+      style.SetPriority(scanner.ReadInt32());
+    }
+
+    void Read(TextStyle& style)
+    {
+      style.SetSlot(scanner.ReadString());
+      style.SetPriority(scanner.ReadUInt64Number());
+      style.SetSize(ReadDouble());
+      style.SetLabel(ReadLabel());
+      style.SetPosition(scanner.ReadUInt64Number());
+      style.SetTextColor(ReadColor());
+      style.SetEmphasizeColor(ReadColor());
+      style.SetStyle(TextStyle::Style(scanner.ReadUInt8()));
+      style.SetScaleAndFadeMag(Magnification(ReadDouble()));
+      style.SetAutoSize(scanner.ReadBool());
+    }
+
+    void Read(PathShieldStyle& style)
+    {
+      style.SetLabel(ReadLabel());
+      style.SetPriority(scanner.ReadUInt64Number());
+      style.SetSize(ReadDouble());
+      style.SetTextColor(ReadColor());
+      style.SetBgColor(ReadColor());
+      style.SetBorderColor(ReadColor());
+      style.SetShieldSpace(ReadDouble());
+    }
+
+    void Read(PathTextStyle& style)
+    {
+      style.SetLabel(ReadLabel());
+      style.SetSize(ReadDouble());
+      style.SetTextColor(ReadColor());
+      style.SetDisplayOffset(ReadDouble());
+      style.SetOffset(ReadDouble());
+      style.SetPriority(scanner.ReadUInt64Number());
+    }
+
+    void Read(IconStyle& style)
+    {
+      style.SetSymbol(ReadSymbolName());
+      style.SetIconName(scanner.ReadString());
+      style.SetIconId(scanner.ReadUInt64Number());
+      style.SetWidth(scanner.ReadUInt32Number());
+      style.SetHeight(scanner.ReadUInt32Number());
+      style.SetPosition(scanner.ReadUInt64Number());
+      style.SetPriority(scanner.ReadUInt64Number());
+      style.SetOverlay(scanner.ReadBool());
+    }
+
+    void Read(PathSymbolStyle& style)
+    {
+      style.SetSlot(scanner.ReadString());
+      style.SetSymbol(ReadSymbolName());
+      style.SetRenderMode(PathSymbolStyle::RenderMode(scanner.ReadUInt8()));
+      style.SetScale(ReadDouble());
+      style.SetSymbolSpace(ReadDouble());
+      style.SetDisplayOffset(ReadDouble());
+      style.SetOffset(ReadDouble());
+      style.SetOffsetRel(OffsetRel(scanner.ReadUInt8()));
+    }
+
+    SymbolRef ReadSymbol()
+    {
+      std::string            name=scanner.ReadString();
+      Symbol::ProjectionMode projectionMode=Symbol::ProjectionMode(scanner.ReadUInt8());
+      SymbolRef              symbol=std::make_shared<Symbol>(name,
+                                                             projectionMode);
+      uint32_t               primitiveCount=scanner.ReadUInt32Number();
+
+      for (uint32_t p=0; p<primitiveCount; p++) {
+        uint8_t               kind=scanner.ReadUInt8();
+        std::vector<Vertex2D> coords;
+        double                values[3]={0.0,0.0,0.0};
+
+        switch (kind) {
+        case 0:
+          coords.resize(scanner.ReadUInt32Number());
+
+          for (auto& coord : coords) {
+            double x=ReadDouble();
+            double y=ReadDouble();
+
+            coord=Vertex2D(x,y);
+          }
+          break;
+        case 1:
+          coords.resize(1);
+          values[0]=ReadDouble();
+          values[1]=ReadDouble();
+          coords[0]=Vertex2D(values[0],values[1]);
+          values[0]=ReadDouble();
+          values[1]=ReadDouble();
+          break;
+        case 2:
+          coords.resize(1);
+          values[0]=ReadDouble();
+          values[1]=ReadDouble();
+          coords[0]=Vertex2D(values[0],values[1]);
+          values[2]=ReadDouble();
+          break;
+        default:
+          Fail("Unsupported draw primitive in symbol '"+name+"'");
+        }
+
+        FillStyleRef   fillStyle;
+        BorderStyleRef borderStyle;
+
+        if (scanner.ReadBool()) {
+          fillStyle=std::make_shared<FillStyle>();
+          Read(*fillStyle);
+        }
+
+        if (scanner.ReadBool()) {
+          borderStyle=std::make_shared<BorderStyle>();
+          Read(*borderStyle);
+        }
+
+        if (kind==0) {
+          PolygonPrimitiveRef polygon=std::make_shared<PolygonPrimitive>(fillStyle,
+                                                                         borderStyle);
+
+          for (const auto& coord : coords) {
+            polygon->AddCoord(coord);
+          }
+
+          symbol->AddPrimitive(polygon);
+        }
+        else if (kind==1) {
+          symbol->AddPrimitive(std::make_shared<RectanglePrimitive>(coords[0],
+                                                                    values[0],
+                                                                    values[1],
+                                                                    fillStyle,
+                                                                    borderStyle));
+        }
+        else {
+          symbol->AddPrimitive(std::make_shared<CirclePrimitive>(coords[0],
+                                                                 values[2],
+                                                                 fillStyle,
+                                                                 borderStyle));
+        }
+      }
+
+      return symbol;
+    }
+
+    StyleCriteria ReadCriteria()
+    {
+      StyleFilter filter;
+      uint32_t    featureCount=scanner.ReadUInt32Number();
+
+      for (uint32_t f=0; f<featureCount; f++) {
+        uint64_t featureFilterIndex=scanner.ReadUInt64Number();
+        uint64_t flagIndex=scanner.ReadUInt64Number();
+
+        if (featureFilterIndex>=featureReaderIndexes.size()) {
+          Fail("Invalid feature filter index");
+        }
+
+        filter.AddFeature(featureReaderIndexes[featureFilterIndex],
+                          flagIndex);
+      }
+
+      filter.SetOneway(scanner.ReadBool());
+
+      if (scanner.ReadBool()) {
+        SizeConditionRef sizeCondition;
+
+        if (ReadObjectRef(sizeCondition)) {
+          if (scanner.ReadBool()) {
+            sizeCondition->SetMinMM(ReadDouble());
+          }
+          else {
+            ReadDouble();
+          }
+
+          if (scanner.ReadBool()) {
+            sizeCondition->SetMinPx(ReadDouble());
+          }
+          else {
+            ReadDouble();
+          }
+
+          if (scanner.ReadBool()) {
+            sizeCondition->SetMaxMM(ReadDouble());
+          }
+          else {
+            ReadDouble();
+          }
+
+          if (scanner.ReadBool()) {
+            sizeCondition->SetMaxPx(ReadDouble());
+          }
+          else {
+            ReadDouble();
+          }
+        }
+
+        filter.SetSizeCondition(sizeCondition);
+      }
+
+      return StyleCriteria(filter);
+    }
+
+    template<class S, class A>
+    void Read(std::vector<std::vector<std::list<StyleSelector<S,A>>>>& table)
+    {
+      table.resize(scanner.ReadUInt32Number());
+
+      for (auto& typeSelectors : table) {
+        typeSelectors.resize(scanner.ReadUInt32Number());
+
+        for (size_t level=0; level<typeSelectors.size(); level++) {
+          auto& levelSelectors=typeSelectors[level];
+
+          if (scanner.ReadBool()) {
+            if (level==0) {
+              Fail("Invalid selector list reference");
+            }
+
+            levelSelectors=typeSelectors[level-1];
+            continue;
+          }
+
+          uint32_t selectorCount=scanner.ReadUInt32Number();
+
+          for (uint32_t s=0; s<selectorCount; s++) {
+            StyleCriteria      criteria=ReadCriteria();
+            std::set<A>        attributes;
+            uint32_t           attributeCount=scanner.ReadUInt32Number();
+            std::shared_ptr<S> style;
+
+            for (uint32_t a=0; a<attributeCount; a++) {
+              attributes.insert(attributes.end(),
+                                A(scanner.ReadUInt32Number()));
+            }
+
+            if (ReadObjectRef(style)) {
+              Read(*style);
+            }
+
+            levelSelectors.emplace_back(criteria,
+                                        attributes,
+                                        style);
+          }
+        }
+      }
+    }
+
+    template<class S, class A>
+    void Read(std::vector<std::vector<std::vector<std::list<StyleSelector<S,A>>>>>& tables)
+    {
+      tables.resize(scanner.ReadUInt32Number());
+
+      for (auto& table : tables) {
+        Read(table);
+      }
+    }
+
+    void Read(std::vector<TypeInfoSet>& typeSets)
+    {
+      uint32_t typeSetCount=scanner.ReadUInt32Number();
+
+      typeSets.clear();
+      typeSets.reserve(typeSetCount);
+
+      for (uint32_t s=0; s<typeSetCount; s++) {
+        TypeInfoSet& typeSet=typeSets.emplace_back(typeConfig);
+        uint32_t     typeCount=scanner.ReadUInt32Number();
+
+        for (uint32_t t=0; t<typeCount; t++) {
+          uint32_t index=scanner.ReadUInt32Number();
+
+          if (index>=typeConfig.GetTypeCount()) {
+            Fail("Invalid type index");
+          }
+
+          typeSet.Set(typeConfig.GetTypeInfo(index));
+        }
+      }
+    }
+
+    void Read(std::vector<bool>& values)
+    {
+      values.resize(scanner.ReadUInt32Number());
+
+      for (size_t i=0; i<values.size(); i++) {
+        values[i]=scanner.ReadBool();
+      }
+    }
+
+    void Read(std::vector<size_t>& values)
+    {
+      values.resize(scanner.ReadUInt32Number());
+
+      for (auto& value : values) {
+        value=scanner.ReadUInt64Number();
+      }
+    }
+
+    void ReadFeatureReaders()
+    {
+      uint32_t featureReaderCount=scanner.ReadUInt32Number();
+
+      featureReaderIndexes.reserve(featureReaderCount);
+
+      for (uint32_t f=0; f<featureReaderCount; f++) {
+        std::string name=scanner.ReadString();
+        FeatureRef  feature=typeConfig.GetFeature(name);
+
+        if (!feature) {
+          Fail("Unknown feature '"+name+"'");
+        }
+
+        featureReaderIndexes.push_back(context.GetFeatureReaderIndex(*feature));
+      }
+    }
+  };
+
+  uint64_t StyleConfig::CalculateContentHash(const char* content,
+                                             size_t size)
+  {
+    return HashBytes(FNV_OFFSET_BASIS,
+                     content,
+                     size);
+  }
+
+  /**
+   * Calculates a hash over all information of the type configuration, the
+   * resolved state of the style sheet depends on (type and feature indexes).
+   */
+  uint64_t StyleConfig::CalculateTypeConfigHash() const
+  {
+    uint64_t hash=FNV_OFFSET_BASIS;
+
+    hash=HashNumber(hash,typeConfig->GetTypeCount());
+
+    for (const auto& type : typeConfig->GetTypes()) {
+      hash=HashString(hash,type->GetName());
+      hash=HashNumber(hash,type->GetIndex());
+      hash=HashNumber(hash,type->GetFeatureCount());
+
+      for (const auto& feature : type->GetFeatures()) {
+        hash=HashString(hash,feature.GetFeature()->GetName());
+        hash=HashNumber(hash,feature.GetIndex());
+      }
+    }
+
+    for (const auto& feature : typeConfig->GetFeatures()) {
+      hash=HashString(hash,feature->GetName());
+      hash=HashNumber(hash,feature->GetFeatureBitCount());
+      hash=HashNumber(hash,feature->GetValueSize());
+    }
+
+    return hash;
+  }
+
+  /**
+   * Store the resolved state of the style sheet (lookup tables, styles, symbols,
+   * constants and flags) as binary file. Together with the state the hash of the type
+   * configuration, the initial flags and the content hash of all style sheet files
+   * read are stored, so that LoadCached() can detect a stale file.
+   */
+  bool StyleConfig::StoreBinary(const std::string& filename,
+                                Log& log) const
+  {
+    StopClock  timer;
+    FileWriter writer;
+
+    try {
+      writer.Open(filename);
+
+      writer.Write(BINARY_FILE_MAGIC);
+      writer.Write(BINARY_FILE_VERSION);
+      writer.Write(CalculateTypeConfigHash());
+
+      writer.WriteNumber(uint32_t(initialFlags.size()));
+
+      for (const auto& [name,value] : std::map<std::string,bool>(initialFlags.begin(),initialFlags.end())) {
+        writer.Write(name);
+        writer.Write(value);
+      }
+
+      writer.WriteNumber(uint32_t(sourceFiles.size()));
+
+      for (const auto& [sourceFile,hash] : sourceFiles) {
+        writer.Write(sourceFile);
+        writer.Write(hash);
+      }
+
+      BinaryStyleWriter styleWriter(writer,
+                                    styleResolveContext);
+
+      writer.WriteNumber(uint32_t(flags.size()));
+
+      // Hash maps are written in sorted order, to get reproducible files
+      for (const auto& [name,value] : std::map<std::string,bool>(flags.begin(),flags.end())) {
+        writer.Write(name);
+        writer.Write(value);
+      }
+
+      writer.WriteNumber(uint32_t(constants.size()));
+
+      for (const auto& [name,constant] : std::map<std::string,StyleConstantRef>(constants.begin(),constants.end())) {
+        writer.Write(name);
+
+        if (const auto* color=dynamic_cast<const StyleConstantColor*>(constant.get());
+            color!=nullptr) {
+          writer.Write(uint8_t(0));
+          styleWriter.WriteColor(color->GetColor());
+        }
+        else if (const auto* mag=dynamic_cast<const StyleConstantMag*>(constant.get());
+                 mag!=nullptr) {
+          writer.Write(uint8_t(1));
+          styleWriter.WriteDouble(mag->GetMag().GetMagnification());
+        }
+        else if (const auto* uint=dynamic_cast<const StyleConstantUInt*>(constant.get());
+                 uint!=nullptr) {
+          writer.Write(uint8_t(2));
+          writer.WriteNumber(uint64_t(uint->GetUInt()));
+        }
+        else if (const auto* width=dynamic_cast<const StyleConstantWidth*>(constant.get());
+                 width!=nullptr) {
+          writer.Write(uint8_t(3));
+          styleWriter.WriteDouble(width->GetWidth());
+          writer.Write(uint8_t(width->GetUnit()));
+        }
+        else {
+          throw IOException(filename,
+                            "Cannot write constant",
+                            "Unsupported type of constant '"+name+"'");
+        }
+      }
+
+      styleWriter.WriteFeatureReaders();
+
+      writer.WriteNumber(uint32_t(symbols.size()));
+
+      for (const auto& [name,symbol] : std::map<std::string,SymbolRef>(symbols.begin(),symbols.end())) {
+        styleWriter.Write(*symbol);
+      }
+
+      styleWriter.Write(wayPrio);
+      styleWriter.Write(wayTextFlags);
+      styleWriter.Write(wayShieldFlags);
+
+      styleWriter.Write(nodeTextStyleSelectors);
+      styleWriter.Write(nodeIconStyleSelectors);
+
+      styleWriter.Write(wayLineStyleSelectors);
+      styleWriter.Write(wayPathTextStyleSelectors);
+      styleWriter.Write(wayPathSymbolStyleSelectors);
+      styleWriter.Write(wayPathShieldStyleSelectors);
+
+      styleWriter.Write(areaFillStyleSelectors);
+      styleWriter.Write(areaBorderStyleSelectors);
+      styleWriter.Write(areaTextStyleSelectors);
+      styleWriter.Write(areaIconStyleSelectors);
+      styleWriter.Write(areaBorderTextStyleSelectors);
+      styleWriter.Write(areaBorderSymbolStyleSelectors);
+
+      styleWriter.Write(routeLineStyleSelectors);
+      styleWriter.Write(routePathTextStyleSelectors);
+
+      styleWriter.Write(nodeTypeSets);
+      styleWriter.Write(wayTypeSets);
+      styleWriter.Write(areaTypeSets);
+      styleWriter.Write(routeTypeSets);
+
+      writer.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      writer.CloseFailsafe();
+      RemoveFile(filename);
+
+      return false;
+    }
+
+    timer.Stop();
+
+    log.Debug() << "Storing binary StyleConfig '" << filename << "' " << timer.ResultString();
+
+    return true;
+  }
+
+  /**
+   * Reads a binary style sheet file. If styleFile is not empty, the file is
+   * only accepted, if it was created from the given style sheet file,
+   * the initial flags are the same and no style sheet file has changed since.
+   */
+  bool StyleConfig::ReadBinary(const std::string& filename,
+                               const std::string& styleFile,
+                               Log& log)
+  {
+    StopClock   timer;
+    FileScanner scanner;
+
+    try {
+      scanner.Open(filename,
+                   FileScanner::Sequential,
+                   true);
+
+      if (scanner.ReadUInt32()!=BINARY_FILE_MAGIC) {
+        log.Warn() << "File '" << filename << "' is not a binary style sheet";
+        scanner.Close();
+
+        return false;
+      }
+
+      if (scanner.ReadUInt32()!=BINARY_FILE_VERSION) {
+        log.Debug() << "Binary style sheet '" << filename << "' has an unsupported format version";
+        scanner.Close();
+
+        return false;
+      }
+
+      if (scanner.ReadUInt64()!=CalculateTypeConfigHash()) {
+        log.Debug() << "Binary style sheet '" << filename << "' was created for a different type configuration";
+        scanner.Close();
+
+        return false;
+      }
+
+      std::unordered_map<std::string,bool> storedInitialFlags;
+      uint32_t                             initialFlagCount=scanner.ReadUInt32Number();
+
+      for (uint32_t f=0; f<initialFlagCount; f++) {
+        std::string name=scanner.ReadString();
+
+        storedInitialFlags[name]=scanner.ReadBool();
+      }
+
+      std::list<std::pair<std::string,uint64_t>> storedSourceFiles;
+      uint32_t                                   sourceFileCount=scanner.ReadUInt32Number();
+
+      for (uint32_t f=0; f<sourceFileCount; f++) {
+        std::string sourceFile=scanner.ReadString();
+        uint64_t    hash=scanner.ReadUInt64();
+
+        storedSourceFiles.emplace_back(sourceFile,hash);
+      }
+
+      if (!styleFile.empty()) {
+        if (storedInitialFlags!=flags) {
+          log.Debug() << "Binary style sheet '" << filename << "' was created with different flags";
+          scanner.Close();
+
+          return false;
+        }
+
+        if (storedSourceFiles.empty() ||
+            storedSourceFiles.front().first!=styleFile) {
+          log.Debug() << "Binary style sheet '" << filename << "' was not created from '" << styleFile << "'";
+          scanner.Close();
+
+          return false;
+        }
+
+        for (const auto& [sourceFile,hash] : storedSourceFiles) {
+          std::vector<char> content;
+
+          if (!ReadFile(sourceFile,content) ||
+              CalculateContentHash(content.data(),content.size())!=hash) {
+            log.Debug() << "Binary style sheet '" << filename << "' is outdated, '" << sourceFile << "' has changed";
+            scanner.Close();
+
+            return false;
+          }
+        }
+      }
+
+      Reset();
+
+      initialFlags=storedInitialFlags;
+      sourceFiles=storedSourceFiles;
+
+      BinaryStyleReader styleReader(scanner,
+                                    *this,
+                                    styleResolveContext,
+                                    symbols);
+
+      uint32_t flagCount=scanner.ReadUInt32Number();
+
+      for (uint32_t f=0; f<flagCount; f++) {
+        std::string name=scanner.ReadString();
+
+        flags[name]=scanner.ReadBool();
+      }
+
+      uint32_t constantCount=scanner.ReadUInt32Number();
+
+      for (uint32_t c=0; c<constantCount; c++) {
+        std::string name=scanner.ReadString();
+        uint8_t     kind=scanner.ReadUInt8();
+
+        switch (kind) {
+        case 0:
+          constants[name]=std::make_shared<StyleConstantColor>(styleReader.ReadColor());
+          break;
+        case 1:
+          constants[name]=std::make_shared<StyleConstantMag>(Magnification(styleReader.ReadDouble()));
+          break;
+        case 2:
+          constants[name]=std::make_shared<StyleConstantUInt>(scanner.ReadUInt64Number());
+          break;
+        case 3: {
+          double width=styleReader.ReadDouble();
+
+          constants[name]=std::make_shared<StyleConstantWidth>(width,
+                                                               StyleConstantWidth::Unit(scanner.ReadUInt8()));
+          break;
+        }
+        default:
+          throw IOException(filename,
+                            "Cannot load style sheet",
+                            "Unsupported type of constant '"+name+"'");
+        }
+      }
+
+      styleReader.ReadFeatureReaders();
+
+      uint32_t symbolCount=scanner.ReadUInt32Number();
+
+      for (uint32_t s=0; s<symbolCount; s++) {
+        RegisterSymbol(styleReader.ReadSymbol());
+      }
+
+      styleReader.Read(wayPrio);
+      styleReader.Read(wayTextFlags);
+      styleReader.Read(wayShieldFlags);
+
+      styleReader.Read(nodeTextStyleSelectors);
+      styleReader.Read(nodeIconStyleSelectors);
+
+      styleReader.Read(wayLineStyleSelectors);
+      styleReader.Read(wayPathTextStyleSelectors);
+      styleReader.Read(wayPathSymbolStyleSelectors);
+      styleReader.Read(wayPathShieldStyleSelectors);
+
+      styleReader.Read(areaFillStyleSelectors);
+      styleReader.Read(areaBorderStyleSelectors);
+      styleReader.Read(areaTextStyleSelectors);
+      styleReader.Read(areaIconStyleSelectors);
+      styleReader.Read(areaBorderTextStyleSelectors);
+      styleReader.Read(areaBorderSymbolStyleSelectors);
+
+      styleReader.Read(routeLineStyleSelectors);
+      styleReader.Read(routePathTextStyleSelectors);
+
+      styleReader.Read(nodeTypeSets);
+      styleReader.Read(wayTypeSets);
+      styleReader.Read(areaTypeSets);
+      styleReader.Read(routeTypeSets);
+
+      scanner.Close();
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+      Reset();
+
+      return false;
+    }
+
+    errors.clear();
+    warnings.clear();
+
+    timer.Stop();
+
+    log.Debug() << "Opening binary StyleConfig '" << filename << "' " << timer.ResultString();
+
+    return true;
+  }
+
+  /**
+   * Load the resolved state of the style sheet from a binary file written by
+   * StoreBinary(). The file is accepted as long as it was written for the same
+   * type configuration, independent of the current state of the style sheet
+   * files it was created from.
+   */
+  bool StyleConfig::LoadBinary(const std::string& filename,
+                               Log& log)
+  {
+    return ReadBinary(filename,
+                      "",
+                      log);
+  }
+
+  /**
+   * Load the given style sheet using cacheFile as binary cache. If the cache
+   * file is valid for the style sheet, the type configuration and the
+   * current flags, it is loaded instead of parsing the style sheet. Else the
+   * style sheet is parsed and the cache file is (re)written.
+   *
+   * A color postprocessor cannot be part of the cache key, so if one is given,
+   * the style sheet is always parsed and the cache file is left untouched.
+   */
+  bool StyleConfig::LoadCached(const std::string& styleFile,
+                               const std::string& cacheFile,
+                               ColorPostprocessor colorPostprocessor,
+                               Log& log)
+  {
+    if (colorPostprocessor==nullptr &&
+        ExistsInFilesystem(cacheFile) &&
+        ReadBinary(cacheFile,
+                   styleFile,
+                   log)) {
+      return true;
+    }
+
+    if (!Load(styleFile,
+              colorPostprocessor,
+              false,
+              log)) {
+      return false;
+    }
+
+    if (colorPostprocessor==nullptr) {
+      std::string tmpFile=cacheFile+".tmp";
+
+      // Write to a temporary file first, so concurrent readers never see a partial file
+      if (StoreBinary(tmpFile,log)) {
+        if (!RenameFile(tmpFile,cacheFile)) {
+          log.Warn() << "Cannot rename '" << tmpFile << "' to '" << cacheFile << "'";
+          RemoveFile(tmpFile);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Return the name of a cache file for LoadCached() in the given cache directory.
+   * The name depends on the database, the style sheet and the flags, so
+   * different databases and flag sets (day/night for example) do not
+   * overwrite each other's cache file.
+   */
+  std::string StyleConfig::GetCacheFileName(const std::string& cacheDirectory,
+                                            const std::string& databaseDirectory,
+                                            const std::string& styleFile,
+                                            const std::unordered_map<std::string,bool>& flags)
+  {
+    uint64_t hash=FNV_OFFSET_BASIS;
+
+    hash=HashString(hash,databaseDirectory);
+    hash=HashString(hash,styleFile);
+
+    for (const auto& [name,value] : std::map<std::string,bool>(flags.begin(),flags.end())) {
+      hash=HashString(hash,name);
+      hash=HashNumber(hash,value ? 1 : 0);
+    }
+
+    std::array<char,17> buffer;
+
+    std::snprintf(buffer.data(),buffer.size(),"%016llx",static_cast<unsigned long long>(hash));
+
+    return AppendFileToDir(cacheDirectory,
+                           std::string("style-")+buffer.data()+".osc");
+  }
+}
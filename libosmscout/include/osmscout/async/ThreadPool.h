@@ -0,0 +1,192 @@
+#ifndef OSMSCOUT_ASYNC_THREADPOOL_H
+#define OSMSCOUT_ASYNC_THREADPOOL_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026 Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <osmscout/lib/CoreImportExport.h>
+
+#include <osmscout/async/Breaker.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Util
+   *
+   * A pool of worker threads executing jobs with priorities.
+   *
+   * Each worker has its own queue for each priority. Jobs submitted by a worker
+   * of the pool are put into the queue of the worker itself, other jobs are distributed
+   * round robin. Idle workers steal jobs from the queues of other workers, so that
+   * many small jobs of one client as well as a few large jobs of many clients
+   * are spread over all workers. Jobs with higher priority are always executed before jobs
+   * with lower priority, independent of the worker queue they are stored in.
+   *
+   * A job can be bound to a Breaker. If the breaker is aborted before the job was
+   * started, the job is skipped and its future is fulfilled with a default constructed
+   * result (for example `false` for jobs returning `bool`).
+   *
+   * The shared instance returned by GetShared() should be used by default, so that
+   * the number of threads does not grow with the number of databases and services in
+   * the process.
+   */
+  class OSMSCOUT_API ThreadPool
+  {
+  public:
+    enum class Priority : size_t
+    {
+      High   = 0, //!< Data that is required right now, for example visible map tiles
+      Normal = 1,
+      Low    = 2  //!< Speculative work, for example prefetching of not yet visible map tiles
+    };
+
+    using Job = std::function<void()>;
+
+  private:
+    static constexpr size_t PriorityCount=3;
+
+    struct WorkerQueue
+    {
+      std::mutex                              mutex;
+      std::array<std::deque<Job>,PriorityCount> jobs;
+    };
+
+  private:
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread>                  threads;
+
+    mutable std::mutex                        mutex;         //!< Protects pendingJobs and running
+    std::condition_variable                   condition;
+    size_t                                    pendingJobs=0; //!< Number of queued jobs not yet claimed by a worker
+    bool                                      running=true;
+
+    std::atomic<size_t>                       nextQueue{0};
+    std::atomic<size_t>                       executedJobs{0};
+    std::atomic<size_t>                       stolenJobs{0};
+
+  private:
+    void Push(Priority priority,
+              Job&& job);
+    bool Pop(size_t worker,
+             Job& job);
+    void Run(size_t worker,
+             const std::string& name);
+
+  public:
+    explicit ThreadPool(size_t threadCount=std::thread::hardware_concurrency(),
+                        const std::string& name="ThreadPool");
+
+    /**
+     * Executes all queued jobs and stops the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * Queue the given function for execution and return a future for its result.
+     *
+     * Note that a job waiting for the result of other jobs of the same pool may block
+     * the pool, if all workers are waiting.
+     */
+    template<typename Function>
+    auto Submit(Function&& function,
+                Priority priority=Priority::Normal,
+                const BreakerRef& breaker=nullptr) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+    {
+      using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+      static_assert(std::is_void_v<Result> || std::is_default_constructible_v<Result>,
+                    "Result of job must be void or default constructible");
+
+      auto task=std::make_shared<std::packaged_task<Result()>>(
+        [function=std::forward<Function>(function),breaker]() mutable -> Result {
+          if (breaker && breaker->IsAborted()) {
+            if constexpr (std::is_void_v<Result>) {
+              return;
+            }
+            else {
+              return Result();
+            }
+          }
+
+          return function();
+        });
+
+      std::future<Result> future=task->get_future();
+
+      Push(priority,
+           [task]() {
+             (*task)();
+           });
+
+      return future;
+    }
+
+    size_t GetThreadCount() const
+    {
+      return threads.size();
+    }
+
+    /**
+     * Return the number of jobs waiting for execution
+     */
+    size_t GetPendingJobCount() const;
+
+    size_t GetExecutedJobCount() const
+    {
+      return executedJobs;
+    }
+
+    /**
+     * Return the number of jobs executed by another worker than the one they were queued for
+     */
+    size_t GetStolenJobCount() const
+    {
+      return stolenJobs;
+    }
+
+    /**
+     * Return the pool shared by all services of the process. It is created on first
+     * use with one worker per hardware thread.
+     */
+    static std::shared_ptr<ThreadPool> GetShared();
+  };
+
+  using ThreadPoolRef = std::shared_ptr<ThreadPool>;
+}
+
+#endif
@@ -50,12 +50,14 @@
 
 // Location index
 #include <osmscout/db/LocationIndex.h>
+#include <osmscout/db/LocationNGramIndex.h>
 
 // Water index
 #include <osmscout/db/WaterIndex.h>
 
 // SRTM index
 #include <osmscout/elevation/SRTM.h>
+#include <osmscout/elevation/TerrainDataFile.h>
 
 #include <osmscout/routing/RouteDescription.h>
 
@@ -345,6 +347,10 @@ namespace osmscout {
     mutable bool                    locationIndexExists=true; //!< false when we know that the location index does not exist or fails to load, true otherwise
     mutable std::mutex              locationIndexMutex;       //!< Mutex to make lazy initialisation of location index thread-safe
 
+    mutable LocationNGramIndexRef   locationNGramIndex;             //!< N-gram index of the names of the location index
+    mutable bool                    locationNGramIndexExists=true;  //!< false when we know that the location n-gram index does not exist or fails to load, true otherwise
+    mutable std::mutex              locationNGramIndexMutex;        //!< Mutex to make lazy initialisation of location n-gram index thread-safe
+
     mutable WaterIndexRef           waterIndex;               //!< Index of land/sea tiles
     mutable bool                    waterIndexExists=true;    //!< false when we know that the water index does not exist or fails to load, true otherwise
     mutable std::mutex              waterIndexMutex;          //!< Mutex to make lazy initialisation of water index thread-safe
@@ -360,6 +366,10 @@ namespace osmscout {
     mutable SRTMRef                 srtmIndex;                //!< Digital elevation data (usually from "Shuttle Radar Topography Mission")
     mutable std::mutex              srtmIndexMutex;           //!< Mutex to make lazy initialisation of SRTM thread-safe
 
+    mutable TerrainDataFileRef      terrainDataFile;                //!< Precomputed contour lines and hill shading
+    mutable bool                    terrainDataFileExists=true;     //!< false when we know that the terrain data file does not exist or fails to load, true otherwise
+    mutable std::mutex              terrainDataFileMutex;           //!< Mutex to make lazy initialisation of terrain data file thread-safe
+
   private:
     template<typename DataFile, typename OffsetsCol, typename DataCol>
     bool GetObjectsByOffset(DataFile dataFile,
@@ -416,6 +426,7 @@ namespace osmscout {
     AreaRouteIndexRef GetAreaRouteIndex() const;
 
     LocationIndexRef GetLocationIndex() const;
+    LocationNGramIndexRef GetLocationNGramIndex() const;
 
     WaterIndexRef GetWaterIndex() const;
 
@@ -423,6 +434,7 @@ namespace osmscout {
     OptimizeWaysLowZoomRef GetOptimizeWaysLowZoom() const;
 
     SRTMRef GetSRTMIndex() const;
+    TerrainDataFileRef GetTerrainDataFile() const;
 
     bool GetBoundingBox(GeoBox& boundingBox) const;
 
@@ -538,6 +550,23 @@ namespace osmscout {
     NodeRegionSearchResult LoadNodesInArea(const TypeInfoSet& types,
                                            const GeoBox& boundingBox) const;
 
+    /**
+     * Load nodes of given types in the given geo box.
+     * Distance is measured in relation to the given location
+     *
+     * @param types
+     *    Set of type to load candidates for
+     * @param boundingBox
+     *    Geographic area to search in
+     * @param location
+     *    Geo coordinate the distance is measured from
+     * @return result object
+     * @throws OSMScoutException in case of errors
+     */
+    NodeRegionSearchResult LoadNodesInArea(const TypeInfoSet& types,
+                                           const GeoBox& boundingBox,
+                                           const GeoCoord& location) const;
+
     /**
      * Load ways of given types in the given geo box.
      * Distance is measured in relation to the center of the bounding box
@@ -552,6 +581,23 @@ namespace osmscout {
     WayRegionSearchResult LoadWaysInArea(const TypeInfoSet& types,
                                          const GeoBox& boundingBox) const;
 
+    /**
+     * Load ways of given types in the given geo box.
+     * Distance is measured in relation to the given location
+     *
+     * @param types
+     *    Set of type to load candidates for
+     * @param boundingBox
+     *    Geographic area to search in
+     * @param location
+     *    Geo coordinate the distance is measured from
+     * @return result object
+     * @throws OSMScoutException in case of errors
+     */
+    WayRegionSearchResult LoadWaysInArea(const TypeInfoSet& types,
+                                         const GeoBox& boundingBox,
+                                         const GeoCoord& location) const;
+
     /**
      * Load areas of given types in the given geo box.
      * Distance is measured in relation to the center of the bounding box
@@ -566,6 +612,23 @@ namespace osmscout {
     AreaRegionSearchResult LoadAreasInArea(const TypeInfoSet& types,
                                            const GeoBox& boundingBox) const;
 
+    /**
+     * Load areas of given types in the given geo box.
+     * Distance is measured in relation to the given location
+     *
+     * @param types
+     *    Set of type to load candidates for
+     * @param boundingBox
+     *    Geographic area to search in
+     * @param location
+     *    Geo coordinate the distance is measured from
+     * @return result object
+     * @throws OSMScoutException in case of errors
+     */
+    AreaRegionSearchResult LoadAreasInArea(const TypeInfoSet& types,
+                                           const GeoBox& boundingBox,
+                                           const GeoCoord& location) const;
+
     void DumpStatistics() const;
 
     void FlushCache();
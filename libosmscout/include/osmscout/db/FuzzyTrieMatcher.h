@@ -0,0 +1,417 @@
+#ifndef OSMSCOUT_FUZZYTRIEMATCHER_H
+#define OSMSCOUT_FUZZYTRIEMATCHER_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace osmscout {
+
+  /**
+   * Return the number of bytes of an UTF-8 character with the given first byte
+   */
+  inline size_t GetUTF8CharacterLength(unsigned char lead)
+  {
+    if (lead>=0xf0) {
+      return 4;
+    }
+
+    if (lead>=0xe0) {
+      return 3;
+    }
+
+    if (lead>=0xc0) {
+      return 2;
+    }
+
+    return 1;
+  }
+
+  /**
+   * Split the given UTF-8 string into its characters
+   */
+  inline std::vector<std::string> SplitUTF8Characters(const std::string& text)
+  {
+    std::vector<std::string> characters;
+
+    for (size_t i=0; i<text.length();) {
+      size_t length=GetUTF8CharacterLength((unsigned char)text[i]);
+
+      characters.push_back(text.substr(i,length));
+      i+=length;
+    }
+
+    return characters;
+  }
+
+  /**
+   * \ingroup Database
+   *
+   * Walks a trie the way a Levenshtein automaton for the query would do. The state
+   * of the automaton for a prefix is the last row of the edit distance matrix between
+   * the query and the prefix. Transpositions of two adjacent characters count as one
+   * edit (optimal string alignment distance), so the last two rows are required.
+   *
+   * The distance of a text is the smallest distance of the query to a prefix of the
+   * text (search as you type).
+   *
+   * The trie is not required to iterate the children of a node, so the existence
+   * of a child is checked by a prefix lookup for the extended prefix. If the
+   * prefix is already at the maximum distance, only characters of the query can be
+   * matched, else all characters that may be part of a normalized text are probed.
+   *
+   * The Trie type has to offer:
+   * - bool HasPrefix(const std::string& prefix) const, returning true, if there
+   *   is at least one key starting with the given prefix
+   * - void VisitKeys(const std::string& prefix, const std::function<bool(const std::string& key)>& visitor) const,
+   *   calling the visitor for each key starting with the given prefix, until the visitor
+   *   returns false
+   *
+   * Each prefix lookup and each visited key counts as one lookup.
+   */
+  template<typename Trie>
+  class FuzzyTrieMatcher
+  {
+  public:
+    /**
+     * Called for each key of a matching text, returns the number of distinct texts
+     * collected so far
+     */
+    using KeyCallback = std::function<size_t(const std::string& key,
+                                             size_t distance)>;
+
+  private:
+    using Row = std::vector<size_t>;
+
+    struct PrefixState;
+    using PrefixStateRef = std::shared_ptr<PrefixState>;
+
+    /**
+     * State of the automaton for a prefix. The state of the parent prefix is kept
+     * for transpositions and for checking if the subtree was already collected.
+     */
+    struct PrefixState
+    {
+      PrefixStateRef parent;
+      Row            row;
+      std::string    character;      //!< Last character of the prefix
+      bool           accepted=false; //!< All texts of the subtree have been collected
+    };
+
+    struct Candidate
+    {
+      size_t         priority; //!< Lower bound of the edit distance of all texts in the subtree
+      bool           accept;   //!< Collect all texts in the subtree instead of expanding the prefix
+      std::string    prefix;
+      PrefixStateRef state;
+    };
+
+    struct CandidateCompare
+    {
+      bool operator()(const Candidate& a,
+                      const Candidate& b) const
+      {
+        if (a.priority!=b.priority) {
+          return a.priority>b.priority;
+        }
+
+        if (a.accept!=b.accept) {
+          return b.accept;
+        }
+
+        return a.prefix.length()>b.prefix.length();
+      }
+    };
+
+    // Collect more candidates than requested, so that ranking by importance and completion
+    // length is possible for texts with the same distance
+    static constexpr size_t CandidateFactor=4;
+
+    const Trie&              trie;
+    std::vector<std::string> query;
+    std::vector<std::string> queryCharacters; //!< Distinct characters of the query
+    size_t                   maxDistance;
+    size_t                   limit;
+    size_t                   maxLookups;
+    size_t                   lookups=0;
+
+    std::priority_queue<Candidate,std::vector<Candidate>,CandidateCompare> candidates;
+
+  private:
+    /**
+     * Return true, if the texts of the subtree of the prefix were already
+     * collected with a better or equal distance
+     */
+    static bool IsAccepted(const PrefixState* state)
+    {
+      for (; state!=nullptr; state=state->parent.get()) {
+        if (state->accepted) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool HasPrefix(const std::string& prefix)
+    {
+      lookups++;
+
+      return trie.HasPrefix(prefix);
+    }
+
+    Row NextRow(const PrefixState& state,
+                const std::string& character) const
+    {
+      const Row& row=state.row;
+      Row        next(row.size());
+
+      next[0]=row[0]+1;
+
+      for (size_t i=1; i<row.size(); i++) {
+        next[i]=std::min({row[i-1]+(query[i-1]==character ? 0 : 1),
+                          row[i]+1,
+                          next[i-1]+1});
+
+        if (i>1 &&
+            state.parent &&
+            query[i-1]==state.character &&
+            query[i-2]==character) {
+          next[i]=std::min(next[i],state.parent->row[i-2]+1);
+        }
+      }
+
+      return next;
+    }
+
+    void AddCandidate(const std::string& prefix,
+                      const PrefixStateRef& state)
+    {
+      const Row& row=state->row;
+      size_t     minDistance=*std::min_element(row.begin(),row.end());
+
+      if (minDistance>maxDistance) {
+        return;
+      }
+
+      if (row.back()<=maxDistance) {
+        candidates.push(Candidate{row.back(),true,prefix,state});
+      }
+
+      // All texts of the subtree are already collected with the best possible distance
+      if (row.back()!=minDistance) {
+        candidates.push(Candidate{minDistance,false,prefix,state});
+      }
+    }
+
+    void AddChild(const Candidate& candidate,
+                  const std::string& character)
+    {
+      auto state=std::make_shared<PrefixState>();
+
+      state->parent=candidate.state;
+      state->row=NextRow(*candidate.state,character);
+      state->character=character;
+
+      AddCandidate(candidate.prefix+character,
+                   state);
+    }
+
+    /**
+     * Probe all continuation bytes of a multi byte character
+     */
+    void ProbeContinuation(const Candidate& candidate,
+                           const std::string& character,
+                           size_t remaining)
+    {
+      if (remaining==0) {
+        AddChild(candidate,character);
+        return;
+      }
+
+      for (unsigned int byte=0x80; byte<=0xbf && lookups<maxLookups; byte++) {
+        std::string next=character+char(byte);
+
+        if (HasPrefix(candidate.prefix+next)) {
+          ProbeContinuation(candidate,next,remaining-1);
+        }
+      }
+    }
+
+    void Expand(const Candidate& candidate)
+    {
+      const Row& row=candidate.state->row;
+      size_t     minDistance=*std::min_element(row.begin(),row.end());
+
+      if (minDistance==maxDistance) {
+        // Only a match does not increase the distance
+        for (const auto& character : queryCharacters) {
+          if (lookups>=maxLookups) {
+            return;
+          }
+
+          if (HasPrefix(candidate.prefix+character)) {
+            AddChild(candidate,character);
+          }
+        }
+
+        return;
+      }
+
+      // Control characters are used as separators between text and object reference
+      for (unsigned int byte=0x20; byte<=0xf4 && lookups<maxLookups; byte++) {
+        if (byte>=0x80 && byte<0xc2) {
+          continue;
+        }
+
+        std::string character(1,char(byte));
+
+        if (!HasPrefix(candidate.prefix+character)) {
+          continue;
+        }
+
+        if (byte<0x80) {
+          AddChild(candidate,character);
+        }
+        else {
+          ProbeContinuation(candidate,
+                            character,
+                            GetUTF8CharacterLength((unsigned char)byte)-1);
+        }
+      }
+    }
+
+    /**
+     * Return false, if enough texts have been collected
+     */
+    bool Accept(const Candidate& candidate,
+                const KeyCallback& callback)
+    {
+      bool finished=false;
+
+      if (lookups>=maxLookups) {
+        return true;
+      }
+
+      trie.VisitKeys(candidate.prefix,
+                     [this,&candidate,&callback,&finished](const std::string& key) {
+                       lookups++;
+
+                       if (callback(key,candidate.priority)>=limit*CandidateFactor) {
+                         finished=true;
+                         return false;
+                       }
+
+                       return lookups<maxLookups;
+                     });
+
+      return !finished;
+    }
+
+  public:
+    FuzzyTrieMatcher(const Trie& trie,
+                     const std::string& query,
+                     size_t maxDistance,
+                     size_t limit,
+                     size_t maxLookups)
+    : trie(trie),
+      query(SplitUTF8Characters(query)),
+      maxDistance(maxDistance),
+      limit(limit),
+      maxLookups(maxLookups)
+    {
+      for (const auto& character : this->query) {
+        if (std::find(queryCharacters.begin(),queryCharacters.end(),character)==queryCharacters.end()) {
+          queryCharacters.push_back(character);
+        }
+      }
+    }
+
+    /**
+     * Walk the trie, calling the callback for each key of a matching text. Texts are
+     * reported with increasing edit distance. A text may be reported again with a
+     * worse distance.
+     */
+    void Match(const KeyCallback& callback)
+    {
+      auto   root=std::make_shared<PrefixState>();
+      size_t collected=0;
+      size_t limitDistance=maxDistance;
+
+      root->row.resize(query.size()+1);
+
+      for (size_t i=0; i<root->row.size(); i++) {
+        root->row[i]=i;
+      }
+
+      AddCandidate("",root);
+
+      while (!candidates.empty() &&
+             lookups<maxLookups) {
+        Candidate candidate=candidates.top();
+
+        candidates.pop();
+
+        // All remaining candidates are worse than the requested number of results
+        if (candidate.priority>limitDistance) {
+          break;
+        }
+
+        if (IsAccepted(candidate.state.get())) {
+          continue;
+        }
+
+        if (candidate.accept) {
+          candidate.state->accepted=true;
+
+          if (!Accept(candidate,[&callback,&collected](const std::string& key,
+                                                       size_t distance) {
+                collected=callback(key,distance);
+                return collected;
+              })) {
+            break;
+          }
+
+          if (collected>=limit) {
+            limitDistance=candidate.priority;
+          }
+        }
+        else {
+          Expand(candidate);
+        }
+      }
+    }
+
+    /**
+     * Return the number of lookups done so far
+     */
+    size_t GetLookups() const
+    {
+      return lookups;
+    }
+  };
+}
+
+#endif
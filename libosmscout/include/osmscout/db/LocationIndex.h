@@ -221,6 +221,12 @@ namespace osmscout {
       return maxAddressWords;
     }
 
+    /**
+     * Load the admin region at the given offset (see AdminRegion::regionOffset)
+     */
+    bool GetAdminRegionByOffset(FileOffset offset,
+                                AdminRegion& region) const;
+
     /**
      * Visit all admin regions
      */
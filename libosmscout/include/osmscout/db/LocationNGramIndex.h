@@ -0,0 +1,130 @@
+#ifndef OSMSCOUT_LOCATIONNGRAMINDEX_H
+#define OSMSCOUT_LOCATIONNGRAMINDEX_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <osmscout/OSMScoutTypes.h>
+
+#include <osmscout/io/FileScanner.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Database
+   *
+   * Inverted index from the n-grams of the names in the location index to the entries
+   * containing them. It is used to find the candidates for a substring search, before
+   * the location index itself is traversed.
+   *
+   * Names are normalized by converting them to upper case and transliterating them (see
+   * NormalizeName()), which is a superset of the normalizations done by StringMatcherCI
+   * and StringMatcherTransliterate. For every name all n-grams of one to three bytes are
+   * indexed. A name containing a pattern then contains all n-grams of the pattern, too, so
+   * intersecting the posting lists of the n-grams of the pattern returns a superset of the
+   * entries matching the pattern.
+   *
+   * There are three sections of posting lists:
+   * - regions: offsets of the admin regions with a name, alternative name or alias
+   *   containing the n-gram
+   * - locations: offsets of the admin regions that directly hold a location with a name
+   *   containing the n-gram
+   * - addresses: offsets of the locations with an address containing the n-gram
+   *
+   * Posting lists are stored sorted and delta encoded as variable length numbers. Only the
+   * n-gram directory and the region hierarchy are held in memory.
+   */
+  class OSMSCOUT_API LocationNGramIndex final
+  {
+  public:
+    static const char* const FILENAME_LOCATION_NGRAM_IDX;
+
+    static constexpr size_t MaxNGramLength=3;
+
+    enum class Section : uint8_t
+    {
+      regions   = 0,
+      locations = 1,
+      addresses = 2
+    };
+
+    static constexpr size_t SectionCount=3;
+
+  private:
+    struct NGramEntry
+    {
+      uint32_t   nGram;
+      uint32_t   count;        //!< Number of entries in the posting list
+      FileOffset offset;       //!< Offset of the posting list
+    };
+
+    struct RegionEntry
+    {
+      FileOffset region;
+      FileOffset parent;
+    };
+
+  private:
+    std::string                                      datafilename;  //!< Full path and name of the data file
+    mutable FileScanner                              scanner;       //!< Scanner instance for reading this file
+    mutable std::mutex                               lookupMutex;
+
+    std::vector<RegionEntry>                         regions;       //!< All regions, sorted by offset
+    std::array<std::vector<NGramEntry>,SectionCount> sections;      //!< N-gram directory per section, sorted by n-gram
+
+  private:
+    FileOffset GetParentRegion(FileOffset region) const;
+
+    void ReadPostingList(const NGramEntry& entry,
+                         std::vector<FileOffset>& postings) const;
+
+  public:
+    LocationNGramIndex() = default;
+    ~LocationNGramIndex();
+
+    bool Open(const std::string& path, bool memoryMappedData);
+    void Close();
+
+    bool GetCandidates(Section section,
+                       const std::string& pattern,
+                       std::vector<FileOffset>& candidates,
+                       size_t maxPostingSize=std::numeric_limits<size_t>::max()) const;
+
+    bool IsInRegion(FileOffset region,
+                    FileOffset ancestor) const;
+
+    static std::string NormalizeName(const std::string& name);
+
+    static void GetNGrams(const std::string& normalizedName,
+                          size_t length,
+                          std::vector<uint32_t>& nGrams);
+  };
+
+  using LocationNGramIndexRef = std::shared_ptr<LocationNGramIndex>;
+}
+
+#endif
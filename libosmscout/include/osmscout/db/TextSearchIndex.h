@@ -20,7 +20,10 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
  */
 
+#include <functional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <osmscout/ObjectRef.h>
 
@@ -33,7 +36,9 @@ namespace osmscout
   /**
    \ingroup Database
    A class that allows prefix-based searching
-   of text data indexed during import
+   of text data indexed during import. Besides exact
+   prefix search a typo tolerant (fuzzy) prefix search
+   is supported.
    */
   class OSMSCOUT_API TextSearchIndex final
   {
@@ -54,6 +59,35 @@ namespace osmscout
   public:
     using ResultsMap = std::unordered_map<std::string, std::vector<ObjectFileRef> >;
 
+    /**
+     * Parameter for the fuzzy search
+     */
+    struct FuzzySearchParameter
+    {
+      size_t maxDistance=2;   //!< Maximum edit distance, further limited by the length of the query (one edit per three characters)
+      size_t limit=10;        //!< Maximum number of results
+      size_t maxLookups=50000; //!< Maximum number of trie lookups per searched trie, limits the latency of the search
+
+      /**
+       * Optional importance of an object in the range [0..1]. If not set, regions are
+       * most important, followed by locations, POIs and other objects.
+       */
+      std::function<double(const ObjectFileRef&)> importance;
+    };
+
+    /**
+     * Result of the fuzzy search
+     */
+    struct FuzzyResult
+    {
+      std::string                text;
+      std::vector<ObjectFileRef> refs;
+      size_t                     distance=0; //!< Edit distance (in characters) between the query and a prefix of the text
+      double                     score=0.0;  //!< Ranking of the result, lower is better
+    };
+
+    using FuzzyResults = std::vector<FuzzyResult>;
+
     TextSearchIndex() = default;
 
     ~TextSearchIndex();
@@ -68,6 +102,27 @@ namespace osmscout
                 bool transliterate,
                 ResultsMap& results) const;
 
+    /**
+     * Search for texts that start with the query, allowing for misspellings.
+     *
+     * The tries are walked like a Levenshtein automaton, visiting only prefixes that
+     * are within the maximum edit distance of the query, the closest prefixes first.
+     * The search stops, as soon as no more results with an edit distance
+     * smaller or equal to that of the top results are possible or the lookup budget
+     * is exhausted.
+     *
+     * Results are ranked by edit distance, then by object importance and
+     * length of the text completion, best result first.
+     */
+    bool SearchFuzzy(const std::string& query,
+                     bool searchPOIs,
+                     bool searchLocations,
+                     bool searchRegions,
+                     bool searchOther,
+                     bool transliterate,
+                     const FuzzySearchParameter& parameter,
+                     FuzzyResults& results) const;
+
   private:
     void splitSearchResult(const std::string& result,
                            std::string& text,
@@ -28,13 +28,19 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
  */
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <osmscout/GeoCoord.h>
 #include <osmscout/util/GeoBox.h>
 
+#include <osmscout/io/FileScanner.h>
+
 #include <osmscout/OSMScoutTypes.h>
 
 #include <osmscout/system/SystemTypes.h>
@@ -58,37 +64,83 @@ namespace osmscout {
   using SRTMDataRef = std::shared_ptr<SRTMData>;
 
   /**
-   * Read elevation data in hgt format
+   * Read elevation data in hgt format.
+   *
+   * HGT files cover 1°x1° each. Instead of keeping only the last used file, the
+   * most recently used files are held in a LRU cache of limited size. Files are memory
+   * mapped, if possible. The cache is shared between threads, a tile stays valid while it
+   * is in use, even if it gets evicted from the cache in the meantime.
+   *
+   * Heights are bilinear interpolated between the four surrounding samples.
    */
   class OSMSCOUT_API SRTM
   {
   public:
-    static const int32_t nodata=-32768;
+    static constexpr int32_t nodata=-32768;
+
+    static constexpr size_t DefaultCacheSize=16;
 
   private:
-    std::string      srtmPath;
-    std::string      currentFilename;
-    osmscout::GeoBox fileBoundingBox;
-    size_t           rows;
-    size_t           columns;
-    size_t           patchSize;
-    uint8_t          *heights;
+    /**
+     * One loaded HGT file
+     */
+    struct Tile
+    {
+      FileScanner          scanner;
+      std::vector<uint8_t> buffer;       //!< Copy of the file content, if the file could not be memory mapped
+      const uint8_t        *data=nullptr;
+      size_t               grid=0;       //!< Number of rows and columns
+      int                  patchLat=0;   //!< Latitude of the south edge
+      int                  patchLon=0;   //!< Longitude of the west edge
+
+      ~Tile();
+
+      int32_t GetHeight(size_t column, size_t row) const
+      {
+        size_t index=2*(row*grid+column);
+
+        return int16_t(uint16_t(data[index] << 8) | data[index+1]);
+      }
+
+      int32_t GetInterpolatedHeight(const GeoCoord& coord) const;
+    };
+
+    using TileRef = std::shared_ptr<const Tile>;
+
+    struct CacheEntry
+    {
+      TileRef                  tile;     //!< Tile or nullptr, if there is no file for it
+      std::list<int>::iterator lruEntry;
+    };
 
   private:
-    bool AssureCorrectFileLoaded(double latitude,
-                                 double longitude);
+    std::string                        srtmPath;
+    size_t                             cacheSize;
+    mutable std::mutex                 cacheMutex;
+    std::list<int>                     lruList;    //!< Keys of the cached tiles, most recently used first
+    std::unordered_map<int,CacheEntry> cache;
+
+  private:
+    static int GetTileKey(int patchLat,
+                          int patchLon);
 
     std::string CalculateHGTFilename(int patchLat,
                                      int patchLon) const;
 
-    int32_t GetHeight(size_t column, size_t row) const;
+    TileRef LoadTile(int patchLat,
+                     int patchLon) const;
+
+    TileRef GetTile(int patchLat,
+                    int patchLon);
 
   public:
-    explicit SRTM(const std::string& path);
+    explicit SRTM(const std::string& path,
+                  size_t cacheSize=DefaultCacheSize);
 
-    virtual ~SRTM();
+    virtual ~SRTM() = default;
 
     int32_t GetHeightAtLocation(const GeoCoord& coord);
+    std::vector<int32_t> GetHeights(std::span<const GeoCoord> coords);
     SRTMDataRef GetHeightInBoundingBox(const GeoBox& boundingBox);
   };
 
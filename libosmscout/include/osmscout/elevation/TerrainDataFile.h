@@ -0,0 +1,109 @@
+#ifndef OSMSCOUT_TERRAINDATAFILE_H
+#define OSMSCOUT_TERRAINDATAFILE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/elevation/TerrainTile.h>
+
+#include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/util/Cache.h>
+#include <osmscout/util/GeoBox.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Database
+   *
+   * Data file holding precomputed contour lines and hill shading (see TerrainTile) for a
+   * number of 1°x1° SRTM patches. The file is optional, it is generated offline from the
+   * SRTM data (see the SrtmTerrain tool). Loaded tiles are cached.
+   */
+  class OSMSCOUT_API TerrainDataFile CLASS_FINAL
+  {
+  public:
+    static const char* const TERRAIN_DAT;
+
+    static constexpr size_t DefaultCacheSize=8;
+
+  private:
+    using TileCache = Cache<int,TerrainTileRef>;
+
+  private:
+    std::string                        datafilename;  //!< Full path and name of the data file
+    mutable FileScanner                scanner;       //!< Scanner instance for reading this file
+    mutable std::mutex                 accessMutex;   //!< Mutex to secure multi-thread access
+    std::unordered_map<int,FileOffset> tileOffsets;   //!< Offsets of the tiles
+    mutable TileCache                  cache;
+
+  public:
+    explicit TerrainDataFile(size_t cacheSize=DefaultCacheSize);
+    ~TerrainDataFile();
+
+    bool Open(const std::string& path, bool memoryMappedData);
+    void Close();
+
+    bool IsOpen() const
+    {
+      return scanner.IsOpen();
+    }
+
+    bool GetTiles(const GeoBox& boundingBox,
+                  std::vector<TerrainTileRef>& tiles) const;
+
+    static int GetTileKey(int patchLat,
+                          int patchLon);
+  };
+
+  using TerrainDataFileRef = std::shared_ptr<TerrainDataFile>;
+
+  /**
+   * Writes a TerrainDataFile tile by tile
+   */
+  class OSMSCOUT_API TerrainDataFileWriter CLASS_FINAL
+  {
+  private:
+    struct IndexEntry
+    {
+      int        patchLat;
+      int        patchLon;
+      FileOffset offset;
+    };
+
+  private:
+    FileWriter              writer;
+    FileOffset              indexOffsetOffset=0;
+    std::vector<IndexEntry> index;
+
+  public:
+    void Open(const std::string& path);
+    void Write(const TerrainTile& tile);
+    void Close();
+  };
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef OSMSCOUT_TERRAINTILE_H
+#define OSMSCOUT_TERRAINTILE_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <osmscout/Point.h>
+
+#include <osmscout/elevation/SRTM.h>
+
+#include <osmscout/io/FileScanner.h>
+#include <osmscout/io/FileWriter.h>
+
+#include <osmscout/system/Compiler.h>
+
+#include <osmscout/util/GeoBox.h>
+
+namespace osmscout {
+
+  class TerrainTile;
+
+  using TerrainTileRef = std::shared_ptr<TerrainTile>;
+
+  /**
+   * Precomputed contour lines and hill shading for one 1°x1° SRTM patch.
+   *
+   * The hill shading is a raster of illumination values, row by row starting at the
+   * northern edge. 0 means completely in shadow, 255 fully lit. Flat terrain has the
+   * value FlatHillShade.
+   */
+  class OSMSCOUT_API TerrainTile CLASS_FINAL
+  {
+  public:
+    static constexpr int32_t DefaultContourInterval=25;
+    static constexpr size_t  DefaultHillShadeCells=300;  //!< Raster cells per degree
+    static constexpr size_t  MaxContourLineLength=512;   //!< Contour lines are split into parts of at most this number of points
+    static const uint8_t     FlatHillShade;
+
+    struct ContourLine
+    {
+      int32_t            elevation=0; //!< Elevation in meter
+      std::vector<Point> nodes;
+      GeoBox             boundingBox;
+    };
+
+  public:
+    int                      patchLat=0;         //!< Latitude of the south edge
+    int                      patchLon=0;         //!< Longitude of the west edge
+    std::vector<ContourLine> contourLines;
+    size_t                   hillShadeRows=0;
+    size_t                   hillShadeColumns=0;
+    std::vector<uint8_t>     hillShade;
+
+  public:
+    GeoBox GetBoundingBox() const;
+
+    uint8_t GetHillShade(size_t column, size_t row) const
+    {
+      return hillShade[row*hillShadeColumns+column];
+    }
+
+    GeoBox GetHillShadeCell(size_t column, size_t row) const;
+
+    void Read(FileScanner& scanner);
+    void Write(FileWriter& writer) const;
+
+    static TerrainTileRef Generate(const SRTMData& data,
+                                   int32_t contourInterval=DefaultContourInterval,
+                                   size_t hillShadeCells=DefaultHillShadeCells);
+  };
+}
+
+#endif
@@ -204,6 +204,15 @@ namespace osmscout {
 
     std::string GetFilename() const;
 
+    /**
+     * Return the memory mapped content of the file or nullptr, if the file is not
+     * memory mapped. The memory is valid until the file is closed.
+     */
+    const char* GetMappedData() const
+    {
+      return mmap;
+    }
+
     void GotoBegin();
     void SetPos(FileOffset pos);
     FileOffset GetPos() const;
@@ -0,0 +1,159 @@
+#ifndef OSMSCOUT_ADMINREGIONINDEX_H
+#define OSMSCOUT_ADMINREGIONINDEX_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <osmscout/db/Database.h>
+
+#include <osmscout/location/Location.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Location
+   *
+   * Resident index of the polygons of all admin regions of the location index, answering
+   * the question "in which regions is this coordinate" without any file access.
+   *
+   * The bounding box of all regions is divided into a regular grid. For every cell the
+   * index holds the region rings, that either contain the cell completely or whose boundary
+   * crosses it. For the latter the edges of the ring touching the cell are
+   * stored together with the cell. A point in polygon test then only casts a ray from
+   * the coordinate to the right through the boundary cells of the ring in the same
+   * grid row, instead of testing against the complete ring.
+   *
+   * Like AdminRegionReverseLookupVisitor only the top outer rings of a region are taken
+   * into account and a region contains a coordinate, if IsCoordInArea() is true for at
+   * least one of these rings.
+   *
+   * All lookup data is held in flat arrays of plain structures and the index is immutable
+   * after Build(), so it can be used from multiple threads without locking.
+   */
+  class OSMSCOUT_API AdminRegionIndex CLASS_FINAL
+  {
+  private:
+    static constexpr uint32_t NoParent=std::numeric_limits<uint32_t>::max();
+
+    /**
+     * An edge of the boundary of a region
+     */
+    struct Edge
+    {
+      double aLat;
+      double aLon;
+      double bLat;
+      double bLon;
+    };
+
+    /**
+     * A cell crossed by a ring of a region. The cells of a ring in one grid row
+     * are stored consecutively and ordered by column.
+     */
+    struct BoundaryCell
+    {
+      uint32_t column;
+      uint32_t edgeOffset;
+      uint32_t edgeCount;
+    };
+
+    /**
+     * A candidate ring of a region of a cell. If the cell is completely within the ring,
+     * boundaryCell equals boundaryCellEnd, else [boundaryCell,boundaryCellEnd[ are
+     * the boundary cells of the ring in the same row, starting with the cell itself.
+     */
+    struct CellEntry
+    {
+      uint32_t region;
+      uint32_t boundaryCell;
+      uint32_t boundaryCellEnd;
+    };
+
+  private:
+    size_t                      gridSize;        //!< Number of rows and columns of the grid
+    GeoBox                      boundingBox;     //!< Bounding box of all regions
+    double                      cellWidth=0.0;
+    double                      cellHeight=0.0;
+
+    std::vector<AdminRegionRef> regions;         //!< All regions in depth first order
+    std::vector<uint32_t>       parents;         //!< Index of the nearest ancestor region with an area or NoParent
+
+    std::vector<uint32_t>       cellOffsets;     //!< Offset of the first entry of each cell
+    std::vector<CellEntry>      cellEntries;
+    std::vector<BoundaryCell>   boundaryCells;
+    std::vector<Edge>           edges;
+
+  private:
+    void Clear();
+
+    size_t GetColumn(double lon) const;
+    size_t GetRow(double lat) const;
+
+    bool IsInRing(const CellEntry& entry,
+                  const GeoCoord& coord) const;
+
+    void AddRing(uint32_t region,
+                 const std::vector<Edge>& ringEdges,
+                 std::vector<std::vector<CellEntry>>& cells);
+
+  public:
+    explicit AdminRegionIndex(size_t gridSize=512);
+
+    bool Build(const Database& database);
+
+    void GetRegions(const GeoCoord& coord,
+                    std::vector<AdminRegionRef>& result) const;
+
+    /**
+     * Return the number of indexed regions
+     */
+    size_t GetRegionCount() const
+    {
+      return regions.size();
+    }
+
+    /**
+     * Return the number of boundary edges held by the index. Edges crossing multiple
+     * cells are counted for every cell.
+     */
+    size_t GetEdgeCount() const
+    {
+      return edges.size();
+    }
+
+    /**
+     * Return the number of ring entries of all cells
+     */
+    size_t GetCellEntryCount() const
+    {
+      return cellEntries.size();
+    }
+  };
+
+  //! \ingroup Location
+  //! Reference counted reference to an AdminRegionIndex instance
+  using AdminRegionIndexRef = std::shared_ptr<AdminRegionIndex>;
+}
+
+#endif
@@ -22,11 +22,14 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <osmscout/TypeInfoSet.h>
 
 #include <osmscout/db/Database.h>
 
+#include <osmscout/location/AdminRegionIndex.h>
 #include <osmscout/location/Location.h>
 
 #include <osmscout/util/StringMatcher.h>
@@ -490,7 +493,10 @@ namespace osmscout {
     using ReverseLookupRef = std::shared_ptr<ReverseLookupResult>;
 
   private:
-    DatabaseRef database;
+    DatabaseRef                 database;
+
+    mutable std::mutex          adminRegionIndexMutex;
+    mutable AdminRegionIndexRef adminRegionIndex;      //!< Lazily built on first region lookup
 
   private:
     static bool DistanceComparator(const LocationDescriptionCandicate &a,
@@ -502,6 +508,8 @@ namespace osmscout {
 
     bool VisitAdminRegions(AdminRegionVisitor& visitor) const;
 
+    AdminRegionIndexRef GetAdminRegionIndex() const;
+
     void AddToCandidates(std::vector<LocationDescriptionCandicate>& candidates,
                          const GeoCoord& location,
                          const NodeRegionSearchResult& results,
@@ -532,6 +540,11 @@ namespace osmscout {
                           const Distance& lookupDistance=Distance::Of<Meter>(100),
                           double sizeFilter=1.0);
 
+    bool DescribeLocations(const std::vector<GeoCoord>& locations,
+                           std::vector<LocationDescription>& descriptions,
+                           const Distance& lookupDistance=Distance::Of<Meter>(100),
+                           double sizeFilter=1.0);
+
     bool DescribeLocationByName(const GeoCoord& location,
                                 LocationDescription& description,
                                 const Distance& lookupDistance=Distance::Of<Meter>(100),
@@ -21,9 +21,11 @@
  */
 
 #include <limits>
+#include <iterator>
 
 #include <osmscout/GeoCoord.h>
 #include <osmscout/routing/RouteDescription.h>
+#include <osmscout/routing/RouteSegmentIndex.h>
 
 #include <osmscout/util/Geometry.h>
 #include <osmscout/util/Time.h>
@@ -37,8 +39,8 @@ namespace osmscout {
     virtual ~OutputDescription() = default;
 
     virtual void NextDescription(const Distance& /*distance*/,
-                                 std::list<RouteDescription::Node>::const_iterator& /*node*/,
-                                 std::list<RouteDescription::Node>::const_iterator /*end*/)
+                                 RouteDescription::NodeList::const_iterator& /*node*/,
+                                 RouteDescription::NodeList::const_iterator /*end*/)
     {};
 
     virtual NodeDescriptionTmpl GetDescription()
@@ -59,48 +61,34 @@ namespace osmscout {
      * of the projected point on the line, return false if there is no such point that is closer than snapDistanceInMeters
      * from the route.
      * The search start a the locationOnRoute node toward the end.
+     * minDistance is set to the distance from the closest segment in any case, foundNode
+     * and foundAbscissa are only modified if a segment was found.
      */
     bool SearchClosestSegment(const GeoCoord& location,
-                              std::list<RouteDescription::Node>::const_iterator& foundNode,
+                              RouteDescription::NodeList::const_iterator& foundNode,
                               double& foundAbscissa,
-                              double& minDistance)
+                              double& minDistance) const
     {
-      auto   nextNode=locationOnRoute;
-      double abscissa=0.0;
-      bool   found=false;
-      double qx,qy;
-      minDistance=std::numeric_limits<double>::max();
       double snapDistanceInDegrees = GetDistanceInLonDegrees(snapDistanceInMeters,
                                                              location.GetLat());
+      auto   fromSegment=static_cast<size_t>(std::distance(route->Nodes().cbegin(),locationOnRoute));
 
-      for (auto node=nextNode++; node!=route->Nodes().end(); node++) {
-        if (nextNode==route->Nodes().end()) {
-          break;
-        }
-        double d=DistanceToSegment(location.GetLon(),
-                                   location.GetLat(),
-                                   node->GetLocation().GetLon(),
-                                   node->GetLocation().GetLat(),
-                                   nextNode->GetLocation().GetLon(),
-                                   nextNode->GetLocation().GetLat(),
-                                   abscissa,
-                                   qx,
-                                   qy);
-        if (minDistance>=d) {
-          minDistance=d;
-          if (d<=snapDistanceInDegrees) {
-            foundNode    =node;
-            foundAbscissa=abscissa;
-            found        =true;
-          }
-        }
-        else if (found && d>minDistance*2) {
-          // Stop the search we have a good candidate
-          break;
-        }
-        nextNode++;
+      RouteSegmentIndex::SegmentMatch match;
+
+      if (!routeIndex->SearchClosestSegment(location,
+                                            fromSegment,
+                                            snapDistanceInDegrees,
+                                            match)) {
+        minDistance=routeIndex->GetDistance(location,
+                                            fromSegment);
+        return false;
       }
-      return found;
+
+      foundNode=route->Nodes().cbegin()+match.segment;
+      foundAbscissa=match.abscissa;
+      minDistance=match.distance;
+
+      return true;
     }
 
   public:
@@ -120,13 +108,14 @@ namespace osmscout {
       route                                                         =newRoute;
       distanceFromStart                                             =Distance::Of<Meter>(0.0);
       durationFromStart                                             =Duration(osmscout::Duration::zero());
+      routeIndex                                                    =std::make_shared<RouteSegmentIndex>(*route);
       locationOnRoute                                               =route->Nodes().begin();
       nextWaypoint                                                  =route->Nodes().begin();
       outputDescription->Clear();
       outputDescription->NextDescription(Distance::Of<Meter>(-1.0),
                                          nextWaypoint,
                                          route->Nodes().end());
-      std::list<RouteDescription::Node>::const_iterator lastWaypoint=--(route->Nodes().end());
+      RouteDescription::NodeList::const_iterator lastWaypoint=std::prev(route->Nodes().end());
       duration=lastWaypoint->GetTime();
       distance=lastWaypoint->GetDistance();
     }
@@ -134,6 +123,7 @@ namespace osmscout {
     void Clear()
     {
       route=nullptr;
+      routeIndex.reset();
     }
 
     bool HasRoute() const
@@ -176,6 +166,11 @@ namespace osmscout {
       return *locationOnRoute;
     }
 
+    /**
+     * Update the position on the route. Return true if the location is closer
+     * than the snap distance to the route. minDistance is set to the distance
+     * from the route (in degrees) in both cases.
+     */
     bool UpdateCurrentLocation(const GeoCoord& location,
                                double& minDistance)
     {
@@ -217,7 +212,7 @@ namespace osmscout {
       if(route == nullptr){
         return false;
       }
-      std::list<RouteDescription::Node>::const_iterator nextNode = route->Nodes().begin();
+      RouteDescription::NodeList::const_iterator nextNode = route->Nodes().begin();
       GeoCoord intersection, foundIntersection;
       double abscissa;
       double minDistance=std::numeric_limits<double>::max();
@@ -243,8 +238,9 @@ namespace osmscout {
 
   private:
     RouteDescription* route=nullptr;                                         // current route description
-    std::list<RouteDescription::Node>::const_iterator locationOnRoute;       // last passed node on the route
-    std::list<RouteDescription::Node>::const_iterator nextWaypoint;          // next node with routing instructions
+    RouteSegmentIndexRef routeIndex;                                         // spatial index of the route segments
+    RouteDescription::NodeList::const_iterator locationOnRoute;       // last passed node on the route
+    RouteDescription::NodeList::const_iterator nextWaypoint;          // next node with routing instructions
     OutputDescription<NodeDescriptionTmpl>            * outputDescription;    // next routing instructions
     Distance                                          distanceFromStart;     // current length from the beginning of the route (in meters)
     Duration                                          durationFromStart;     // current (estimated) duration from the beginning of the route
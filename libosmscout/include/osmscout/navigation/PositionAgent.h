@@ -24,6 +24,8 @@
 #include <osmscout/navigation/Agents.h>
 #include <osmscout/navigation/DataAgent.h>
 
+#include <osmscout/routing/RouteSegmentIndex.h>
+
 namespace osmscout {
 
   /**
@@ -65,7 +67,7 @@ namespace osmscout {
     struct OSMSCOUT_API Position {
       PositionState state{PositionState::Uninitialised};
       GeoCoord coord;
-      std::list<RouteDescription::Node>::const_iterator routeNode; // last passed node on the route
+      RouteDescription::NodeList::const_iterator routeNode; // last passed node on the route
 
       // resolved object
       DatabaseId databaseId;
@@ -109,6 +111,7 @@ namespace osmscout {
     Timestamp lastUpdate; // last update of agent state
     RoutableObjectsRef routableObjects; // routable objects around current position
     RouteDescriptionRef route; // current route description
+    RouteSegmentIndexRef routeIndex; // spatial index of the current route segments
     osmscout::Vehicle vehicle; // current vehicle
     Position position;
     Distance snapDistanceInMeters{Meters(20)}; // max distance from the route path to consider being on route
@@ -121,9 +124,9 @@ namespace osmscout {
 
   private:
     bool SearchClosestSegment(const GeoCoord& location,
-                              const std::list<RouteDescription::Node>::const_iterator& locationOnRoute,
+                              const RouteDescription::NodeList::const_iterator& locationOnRoute,
                               GeoCoord &closestPosition,
-                              std::list<RouteDescription::Node>::const_iterator& foundNode,
+                              RouteDescription::NodeList::const_iterator& foundNode,
                               double& foundAbscissa,
                               double& minDistance) const;
   };
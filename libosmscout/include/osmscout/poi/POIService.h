@@ -31,6 +31,20 @@
 
 namespace osmscout {
 
+  /**
+   * \ingroup Service
+   *
+   * A POI found by POIService::GetNearestPOIs(). Exactly one of node, way and area is set.
+   */
+  struct OSMSCOUT_API NearestPOIResult
+  {
+    NodeRef  node;
+    WayRef   way;
+    AreaRef  area;
+    Distance distance;     //!< Distance from the location to the closest point of the POI
+    GeoCoord closestPoint; //!< Closest point of the POI to the location
+  };
+
   /**
    * \ingroup Service
    *
@@ -38,6 +52,7 @@ namespace osmscout {
    *
    * Currently this includes the following functionality:
    * - Locating POIs of given types in a given area
+   * - Locating the POIs of given types closest to a given location
    */
   class OSMSCOUT_API POIService final
   {
@@ -63,6 +78,11 @@ namespace osmscout {
                          std::vector<WayRef>& ways,
                          const TypeInfoSet& areaTypes,
                          std::vector<AreaRef>& areas) const;
+
+    std::vector<NearestPOIResult> GetNearestPOIs(const GeoCoord& location,
+                                                 const TypeInfoSet& types,
+                                                 size_t count,
+                                                 const Distance& maxDistance) const;
   };
 
   //! \ingroup Service
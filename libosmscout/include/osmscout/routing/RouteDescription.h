@@ -20,10 +20,10 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include <map>
 
@@ -54,6 +54,35 @@ namespace osmscout {
   class OSMSCOUT_API RouteDescription
   {
   public:
+    /**
+     * \ingroup Routing
+     * Compact identifier of a description type. Used as lookup key
+     * for descriptions attached to a node.
+     */
+    enum class DescriptionKind : uint8_t
+    {
+      Start,
+      Target,
+      Name,
+      NameChanged,
+      CrossingWays,
+      Direction,
+      Turn,
+      RoundaboutEnter,
+      RoundaboutLeave,
+      MotorwayEnter,
+      MotorwayChange,
+      MotorwayLeave,
+      MotorwayJunction,
+      Destination,
+      MaxSpeed,
+      TypeName,
+      POIAtRoute,
+      Lanes,
+      SuggestedLanes,
+      Via
+    };
+
     /**
      * \ingroup Routing
      * Base class of all descriptions.
@@ -85,6 +114,7 @@ namespace osmscout {
       std::string GetDescription() const;
 
       static constexpr std::string_view Key = "NodeStart";
+      static constexpr DescriptionKind Kind = DescriptionKind::Start;
     };
 
     using StartDescriptionRef = std::shared_ptr<StartDescription>;
@@ -106,6 +136,7 @@ namespace osmscout {
       std::string GetDescription() const;
 
       static constexpr std::string_view Key = "NodeTarget";
+      static constexpr DescriptionKind Kind = DescriptionKind::Target;
     };
 
     using TargetDescriptionRef = std::shared_ptr<TargetDescription>;
@@ -137,6 +168,7 @@ namespace osmscout {
       std::string GetDescription() const;
 
       static constexpr std::string_view Key = "WayName";
+      static constexpr DescriptionKind Kind = DescriptionKind::Name;
     };
 
     using NameDescriptionRef = std::shared_ptr<NameDescription>;
@@ -168,6 +200,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "WayChangedName";
+      static constexpr DescriptionKind Kind = DescriptionKind::NameChanged;
     };
 
     using NameChangedDescriptionRef = std::shared_ptr<NameChangedDescription>;
@@ -219,6 +252,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "CrossingWays";
+      static constexpr DescriptionKind Kind = DescriptionKind::CrossingWays;
     };
 
     using CrossingWaysDescriptionRef = std::shared_ptr<CrossingWaysDescription>;
@@ -284,6 +318,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "Direction";
+      static constexpr DescriptionKind Kind = DescriptionKind::Direction;
     };
 
     using DirectionDescriptionRef = std::shared_ptr<DirectionDescription>;
@@ -309,6 +344,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "Turn";
+      static constexpr DescriptionKind Kind = DescriptionKind::Turn;
     };
 
     using TurnDescriptionRef = std::shared_ptr<TurnDescription>;
@@ -333,6 +369,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "RoundaboutEnter";
+      static constexpr DescriptionKind Kind = DescriptionKind::RoundaboutEnter;
     };
 
     using RoundaboutEnterDescriptionRef = std::shared_ptr<RoundaboutEnterDescription>;
@@ -363,6 +400,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "RoundaboutLeave";
+      static constexpr DescriptionKind Kind = DescriptionKind::RoundaboutLeave;
     };
 
     using RoundaboutLeaveDescriptionRef = std::shared_ptr<RoundaboutLeaveDescription>;
@@ -387,6 +425,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "MotorwayEnter";
+      static constexpr DescriptionKind Kind = DescriptionKind::MotorwayEnter;
     };
 
     using MotorwayEnterDescriptionRef = std::shared_ptr<MotorwayEnterDescription>;
@@ -425,6 +464,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "MotorwayChange";
+      static constexpr DescriptionKind Kind = DescriptionKind::MotorwayChange;
     };
 
     using MotorwayChangeDescriptionRef = std::shared_ptr<MotorwayChangeDescription>;
@@ -456,6 +496,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "MotorwayLeave";
+      static constexpr DescriptionKind Kind = DescriptionKind::MotorwayLeave;
     };
 
     using MotorwayLeaveDescriptionRef = std::shared_ptr<MotorwayLeaveDescription>;
@@ -480,6 +521,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "MotorwayJunction";
+      static constexpr DescriptionKind Kind = DescriptionKind::MotorwayJunction;
     };
 
     using MotorwayJunctionDescriptionRef = std::shared_ptr<MotorwayJunctionDescription>;
@@ -501,6 +543,7 @@ namespace osmscout {
       std::string GetDescription() const;
 
       static constexpr std::string_view Key = "CrossingDestination";
+      static constexpr DescriptionKind Kind = DescriptionKind::Destination;
     };
 
     using DestinationDescriptionRef = std::shared_ptr<DestinationDescription>;
@@ -525,6 +568,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "MaxSpeed";
+      static constexpr DescriptionKind Kind = DescriptionKind::MaxSpeed;
     };
 
     using MaxSpeedDescriptionRef = std::shared_ptr<MaxSpeedDescription>;
@@ -550,6 +594,7 @@ namespace osmscout {
       std::string GetDescription() const;
 
       static constexpr std::string_view Key = "TypeName";
+      static constexpr DescriptionKind Kind = DescriptionKind::TypeName;
     };
 
     using TypeNameDescriptionRef = std::shared_ptr<TypeNameDescription>;
@@ -595,6 +640,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "POIAtRoute";
+      static constexpr DescriptionKind Kind = DescriptionKind::POIAtRoute;
     };
 
     using POIAtRouteDescriptionRef = std::shared_ptr<POIAtRouteDescription>;
@@ -643,6 +689,7 @@ namespace osmscout {
       bool operator!=(const LaneDescription &o) const;
 
       static constexpr std::string_view Key = "Lanes";
+      static constexpr DescriptionKind Kind = DescriptionKind::Lanes;
     };
 
     using LaneDescriptionRef = std::shared_ptr<LaneDescription>;
@@ -682,6 +729,7 @@ namespace osmscout {
       }
 
       static constexpr std::string_view Key = "SuggestedLanes";
+      static constexpr DescriptionKind Kind = DescriptionKind::SuggestedLanes;
     };
 
     using SuggestedLaneDescriptionRef = std::shared_ptr<SuggestedLaneDescription>;
@@ -706,6 +754,7 @@ namespace osmscout {
         int GetNodeCount() const { return nodeCount; };
 
        static constexpr std::string_view Key = "NodeVia";
+       static constexpr DescriptionKind Kind = DescriptionKind::Via;
       };
 
       using ViaDescriptionRef = std::shared_ptr<ViaDescription>;
@@ -724,8 +773,24 @@ namespace osmscout {
       Distance                                       distance; //!< distance from route start
       Duration                                       time; //!< time from route start
       GeoCoord                                       location; //!< geographic coordinate of node
-      std::unordered_map<std::string,DescriptionRef> descriptionMap;
-      std::list<DescriptionRef>                      descriptions;
+      std::vector<DescriptionKind>                   descriptionKinds; //!< kind of the description at the same index
+      std::vector<DescriptionRef>                    descriptions;
+
+      /**
+       * Return the index of the latest description of the given kind or -1,
+       * if there is no such description. Nodes hold only a handful of descriptions,
+       * so a linear scan is cheaper than any hashing.
+       */
+      int FindDescription(DescriptionKind kind) const
+      {
+        for (size_t i=descriptionKinds.size(); i>0; i--) {
+          if (descriptionKinds[i-1]==kind) {
+            return int(i-1);
+          }
+        }
+
+        return -1;
+      }
 
     public:
       Node(DatabaseId database,
@@ -750,11 +815,23 @@ namespace osmscout {
       /**
        * Return a list of descriptions attached to the current node
        */
-      const std::list<DescriptionRef>& GetDescriptions() const
+      const std::vector<DescriptionRef>& GetDescriptions() const
       {
         return descriptions;
       }
 
+      /**
+       * Return a copy of the descriptions attached to the current node as list.
+       *
+       * Deprecated, it copies all descriptions on every call. Use GetDescriptions(),
+       * it provides the same iteration order without copying.
+       */
+      [[deprecated("Copies the descriptions, use GetDescriptions()")]]
+      std::list<DescriptionRef> GetDescriptionList() const
+      {
+        return {descriptions.begin(),descriptions.end()};
+      }
+
       /**
        * There exists a object/path from the current node to the next node
        * in the route.
@@ -818,23 +895,20 @@ namespace osmscout {
       requires std::is_base_of_v<Description, D>
       bool HasDescription() const
       {
-        std::unordered_map<std::string,DescriptionRef>::const_iterator entry;
-
-        entry=descriptionMap.find(std::string(D::Key));
+        int index=FindDescription(D::Kind);
 
-        return entry!=descriptionMap.end() && entry->second;
+        return index>=0 && descriptions[index];
       }
 
       template <class D>
       requires std::is_base_of_v<Description, D>
       std::shared_ptr<D> GetDescription() const
       {
-        std::unordered_map<std::string,DescriptionRef>::const_iterator entry;
-
-        entry=descriptionMap.find(std::string(D::Key));
+        int index=FindDescription(D::Kind);
 
-        if (entry!=descriptionMap.end()) {
-          return std::dynamic_pointer_cast<D>(entry->second);
+        if (index>=0) {
+          // AddDescription() guarantees that the kind matches the type
+          return std::static_pointer_cast<D>(descriptions[index]);
         }
 
         return nullptr;
@@ -848,15 +922,16 @@ namespace osmscout {
       requires std::is_base_of_v<Description, D>
       void AddDescription(const std::shared_ptr<D>& description)
       {
+        descriptionKinds.push_back(D::Kind);
         descriptions.push_back(description);
-        descriptionMap[std::string(D::Key)]=description;
       }
     };
 
-    using NodeIterator = std::list<RouteDescription::Node>::const_iterator;
+    using NodeList = std::vector<Node>;
+    using NodeIterator = NodeList::const_iterator;
 
   private:
-    std::list<Node> nodes;
+    NodeList nodes;
     std::map<DatabaseId, std::string> databaseMapping;
 
   public:
@@ -877,15 +952,27 @@ namespace osmscout {
                  const ObjectFileRef& pathObject,
                  size_t targetNodeIndex);
 
-    std::list<Node>& Nodes()
+    NodeList& Nodes()
     {
       return nodes;
     }
 
-    const std::list<Node>& Nodes() const
+    const NodeList& Nodes() const
     {
       return nodes;
     }
+
+    /**
+     * Return a copy of the route nodes as list.
+     *
+     * Deprecated, it copies the whole route on every call. Use Nodes(),
+     * it provides the same iteration order without copying.
+     */
+    [[deprecated("Copies the route, use Nodes()")]]
+    std::list<Node> GetNodeList() const
+    {
+      return {nodes.begin(),nodes.end()};
+    }
   };
 
   using RouteDescriptionRef = std::shared_ptr<RouteDescription>;
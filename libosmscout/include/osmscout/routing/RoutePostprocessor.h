@@ -20,6 +20,7 @@
   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
 */
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
@@ -152,6 +153,63 @@ namespace osmscout {
 
     using PostprocessorRef = std::shared_ptr<Postprocessor>;
 
+    /**
+     * \ingroup Routing
+     * Base class for postprocessors that handle the route node by node.
+     *
+     * ProcessNode() may only evaluate the given node and state collected from
+     * the nodes before it. It must not depend on descriptions of following nodes
+     * or on descriptions created by postprocessors executed later. Consecutive
+     * node postprocessors can thus be fused into a single pass over the route
+     * (see FusedPostprocessor) without changing the result.
+     */
+    class OSMSCOUT_API NodePostprocessor : public Postprocessor
+    {
+    public:
+      /**
+       * Called before the first node of the route is passed to ProcessNode().
+       * Resets state from a previous run.
+       */
+      virtual void Begin(const PostprocessorContext& context,
+                         RouteDescription& description);
+
+      virtual bool ProcessNode(const PostprocessorContext& context,
+                               RouteDescription::Node& node) = 0;
+
+      bool Process(const PostprocessorContext& context,
+                   RouteDescription& description) override;
+    };
+
+    using NodePostprocessorRef = std::shared_ptr<NodePostprocessor>;
+
+    /**
+     * \ingroup Routing
+     * Executes a list of node postprocessors in one pass over the route
+     * instead of one pass per postprocessor. The result is identical to
+     * calling the postprocessors one after another.
+     */
+    class OSMSCOUT_API FusedPostprocessor : public Postprocessor
+    {
+    private:
+      std::vector<NodePostprocessorRef> processors;
+
+    public:
+      explicit FusedPostprocessor(const std::vector<NodePostprocessorRef>& processors);
+
+      bool Process(const PostprocessorContext& context,
+                   RouteDescription& description) override;
+
+      /**
+       * Same as Process(), but measures the time spent in each of the fused postprocessors.
+       * It reads the clock for each node and postprocessor, so it is slower than Process().
+       *
+       * @param processorTimes time of each postprocessor, in the order of the postprocessors
+       */
+      bool ProcessTimed(const PostprocessorContext& context,
+                        RouteDescription& description,
+                        std::vector<std::chrono::steady_clock::duration>& processorTimes);
+    };
+
     /**
      * \ingroup Routing
      * Places the given description at the start node
@@ -188,39 +246,58 @@ namespace osmscout {
      * \ingroup Routing
      * Calculates the overall running distance and time for each node
      */
-    class OSMSCOUT_API DistanceAndTimePostprocessor : public Postprocessor
+    class OSMSCOUT_API DistanceAndTimePostprocessor : public NodePostprocessor
     {
+    private:
+      ObjectFileRef prevObject;
+      GeoCoord      prevCoord;
+      ObjectFileRef curObject;
+      GeoCoord      curCoord;
+      AreaRef       area;
+      WayRef        way;
+      Distance      distance;
+      Duration      time;
+
     public:
       DistanceAndTimePostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      void Begin(const PostprocessorContext& context,
+                 RouteDescription& description) override;
+
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     /**
      * \ingroup Routing
      * Places a name description as way description
      */
-    class OSMSCOUT_API WayNamePostprocessor : public Postprocessor
+    class OSMSCOUT_API WayNamePostprocessor : public NodePostprocessor
     {
+    private:
+      RouteDescription::NameDescriptionRef lastNameDesc; //!< name description of the previous node
+
     public:
       WayNamePostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      void Begin(const PostprocessorContext& context,
+                 RouteDescription& description) override;
+
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     /**
      * \ingroup Routing
      * Places a name description as way description
      */
-    class OSMSCOUT_API WayTypePostprocessor : public Postprocessor
+    class OSMSCOUT_API WayTypePostprocessor : public NodePostprocessor
     {
     public:
       WayTypePostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     /**
@@ -267,13 +344,13 @@ namespace osmscout {
      * \ingroup Routing
      * Adds driving hint based on motorway_junction tags
      */
-    class OSMSCOUT_API MotorwayJunctionPostprocessor : public Postprocessor
+    class OSMSCOUT_API MotorwayJunctionPostprocessor : public NodePostprocessor
     {
     public:
       MotorwayJunctionPostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     /**
@@ -293,13 +370,21 @@ namespace osmscout {
      * \ingroup Routing
      * Collects max speed information
      */
-    class OSMSCOUT_API MaxSpeedPostprocessor : public RoutePostprocessor::Postprocessor
+    class OSMSCOUT_API MaxSpeedPostprocessor : public NodePostprocessor
     {
+    private:
+      ObjectFileRef prevObject;
+      DatabaseId    prevDb=0;
+      uint8_t       speed=0;
+
     public:
       MaxSpeedPostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      void Begin(const PostprocessorContext& context,
+                 RouteDescription& description) override;
+
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     /**
@@ -348,21 +433,21 @@ namespace osmscout {
                                      const RouteDescription::NameDescriptionRef& fromName);
       void HandleMotorwayLink(const PostprocessorContext& context,
                               const RouteDescription::NameDescriptionRef &originName,
-                              const std::list<RouteDescription::Node>::const_iterator &lastNode,
-                              const std::list<RouteDescription::Node>::iterator &node,
-                              const std::list<RouteDescription::Node>::const_iterator &end);
+                              const RouteDescription::NodeList::const_iterator &lastNode,
+                              const RouteDescription::NodeList::iterator &node,
+                              const RouteDescription::NodeList::const_iterator &end);
       bool NameChanged(const RouteDescription::NameDescriptionRef &lastName,
                        const RouteDescription::NameDescriptionRef &nextName);
       std::optional<RouteDescription::DirectionDescription::Move> DirectionFromLane(const RouteDescription::Node &node);
       RouteDescription::DirectionDescription::Move Direction(const RouteDescription::Node &previousNode,
                                                              const RouteDescription::Node &node,
                                                              bool *fromGeometry = nullptr);
-      bool HandleNameChange(std::list<RouteDescription::Node>::const_iterator& lastNode,
-                            std::list<RouteDescription::Node>::iterator& node,
-                            const std::list<RouteDescription::Node>::const_iterator &end);
+      bool HandleNameChange(RouteDescription::NodeList::const_iterator& lastNode,
+                            RouteDescription::NodeList::iterator& node,
+                            const RouteDescription::NodeList::const_iterator &end);
       bool HandleDirectionChange(const PostprocessorContext& context,
-                                 const std::list<RouteDescription::Node>::iterator& node,
-                                 const std::list<RouteDescription::Node>::const_iterator& end);
+                                 const RouteDescription::NodeList::iterator& node,
+                                 const RouteDescription::NodeList::const_iterator& end);
       std::vector<NodeExit> CollectNodeWays(const PostprocessorContext& context,
                                             RouteDescription::Node& node,
                                             bool exitsOnly);
@@ -394,22 +479,22 @@ namespace osmscout {
         ObjectFileRef                               object;
         RouteDescription::NameDescriptionRef        name;
         Distance                                    distance;
-        std::list<RouteDescription::Node>::iterator node;
+        RouteDescription::NodeList::iterator node;
       };
 
     private:
-      std::set<ObjectFileRef> CollectPaths(const std::list<RouteDescription::Node>& nodes) const;
+      std::set<ObjectFileRef> CollectPaths(const RouteDescription::NodeList& nodes) const;
       std::list<WayRef> CollectWays(const PostprocessorContext& context,
-                                    const std::list<RouteDescription::Node>& nodes) const;
+                                    const RouteDescription::NodeList& nodes) const;
       std::list<AreaRef> CollectAreas(const PostprocessorContext& context,
-                                      const std::list<RouteDescription::Node>& nodes) const;
+                                      const RouteDescription::NodeList& nodes) const;
       std::map<ObjectFileRef,std::set<ObjectFileRef>> CollectPOICandidates(const Database& database,
                                                                            const std::set<ObjectFileRef>& paths,
                                                                            const std::list<WayRef>& ways,
                                                                            const std::list<AreaRef>& areas);
       std::map<ObjectFileRef,POIAtRoute> AnalysePOICandidates(const PostprocessorContext& context,
                                                               const DatabaseId& databaseId,
-                                                              std::list<RouteDescription::Node>& nodes,
+                                                              RouteDescription::NodeList& nodes,
                                                               const TypeInfoSet& nodeTypes,
                                                               const TypeInfoSet& areaTypes,
                                                               const std::unordered_map<FileOffset,NodeRef>& nodeMap,
@@ -431,13 +516,21 @@ namespace osmscout {
      * \ingroup Routing
      * Evaluate route lanes
      */
-    class OSMSCOUT_API LanesPostprocessor : public RoutePostprocessor::Postprocessor
+    class OSMSCOUT_API LanesPostprocessor : public NodePostprocessor
     {
+    private:
+      ObjectFileRef                        prevObject;
+      DatabaseId                           prevDb=0;
+      RouteDescription::LaneDescriptionRef lanes;
+
     public:
       LanesPostprocessor() = default;
 
-      bool Process(const PostprocessorContext& context,
-                   RouteDescription& description) override;
+      void Begin(const PostprocessorContext& context,
+                 RouteDescription& description) override;
+
+      bool ProcessNode(const PostprocessorContext& context,
+                       RouteDescription::Node& node) override;
     };
 
     using LanesPostprocessorRef = std::shared_ptr<LanesPostprocessor>;
@@ -495,7 +588,21 @@ namespace osmscout {
 
     using SuggestedLanesPostprocessorRef = std::shared_ptr<SuggestedLanesPostprocessor>;
 
+    /**
+     * \ingroup Routing
+     * Execution time of one postprocessor, see SetCollectTimings()
+     */
+    struct PostprocessorTiming
+    {
+      size_t                              index=0;     //!< Position of the postprocessor in the list, starting with 1
+      bool                                fused=false; //!< Executed in one pass with other node postprocessors
+      std::chrono::steady_clock::duration time{0};
+    };
+
   private:
+    bool                                                          collectTimings=false;
+    std::vector<PostprocessorTiming>                              timings;
+
     /* TODO: separate PostprocessorContext implementation from RoutePostprocessor, move state context
      */
     std::vector<RoutingProfileRef>                                profiles;
@@ -589,6 +696,25 @@ namespace osmscout {
     std::vector<DatabaseRef> GetDatabases() const override;
 
   public:
+    /**
+     * If enabled, the execution time of each postprocessor is measured during
+     * PostprocessRouteDescription(). Time of fused node postprocessors is measured per node,
+     * which slows down postprocessing a bit, so it is disabled by default.
+     */
+    void SetCollectTimings(bool collect)
+    {
+      collectTimings=collect;
+    }
+
+    /**
+     * Return execution times of the postprocessors of the last PostprocessRouteDescription() call,
+     * empty if timings are not collected
+     */
+    const std::vector<PostprocessorTiming>& GetTimings() const
+    {
+      return timings;
+    }
+
     bool PostprocessRouteDescription(RouteDescription& description,
                                      const std::vector<RoutingProfileRef>& profiles,
                                      const std::vector<DatabaseRef>& databases,
@@ -0,0 +1,114 @@
+#ifndef OSMSCOUT_ROUTESEGMENTINDEX_H
+#define OSMSCOUT_ROUTESEGMENTINDEX_H
+
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <osmscout/GeoCoord.h>
+
+#include <osmscout/routing/RouteDescription.h>
+
+namespace osmscout {
+
+  /**
+   * \ingroup Routing
+   *
+   * Spatial grid index of the segments of a route description. Segment i connects
+   * route node i with route node i+1.
+   *
+   * The index allows to find the route segment closest to a location without scanning
+   * the whole route. It is build once, when the route is known, and is immutable
+   * afterwards, so it may be shared between threads.
+   *
+   * All distances are in degrees, like in DistanceToSegment.
+   */
+  class OSMSCOUT_API RouteSegmentIndex CLASS_FINAL
+  {
+  public:
+    /**
+     * Result of the segment search
+     */
+    struct OSMSCOUT_API SegmentMatch
+    {
+      size_t   segment=0;     //!< index of the segment start node on the route
+      double   abscissa=0.0;  //!< position of the closest point on the segment, 0 <= abscissa <= 1
+      double   distance=0.0;  //!< distance of the location from the segment in degrees
+      GeoCoord closestPoint;  //!< closest point on the segment
+    };
+
+  private:
+    double                                             cellSize; //!< cell size in degrees
+    std::vector<GeoCoord>                              points;   //!< location of the route nodes
+    std::unordered_map<uint64_t,std::vector<uint32_t>> cells;    //!< segments crossing the given cell
+
+  private:
+    uint32_t GetCellX(double lon) const;
+    uint32_t GetCellY(double lat) const;
+
+    static uint64_t GetCellKey(uint32_t x, uint32_t y)
+    {
+      return (uint64_t(x) << 32) | y;
+    }
+
+    void AddSegment(uint32_t segment);
+
+  public:
+    explicit RouteSegmentIndex(const RouteDescription& route,
+                               double cellSize=0.005);
+
+    size_t GetSegmentCount() const
+    {
+      return points.size()>1 ? points.size()-1 : 0;
+    }
+
+    /**
+     * Search the route segment closest to the given location, not farther than maxDistance.
+     *
+     * Only segments starting at fromSegment or later are evaluated. Since the route
+     * may pass the same place multiple times, the first section of the route (in driving
+     * direction) that is within maxDistance is preferred, and the closest segment of
+     * this section is returned.
+     *
+     * @return true, if there is such segment
+     */
+    bool SearchClosestSegment(const GeoCoord& location,
+                              size_t fromSegment,
+                              double maxDistance,
+                              SegmentMatch& match) const;
+
+    /**
+     * Return the distance of the location to the closest route segment starting at
+     * fromSegment or later, without any distance limit. All remaining segments
+     * are evaluated, so it is meant for the rare case when the location is off the route.
+     *
+     * @return the distance or std::numeric_limits<double>::max() if there is no such segment
+     */
+    double GetDistance(const GeoCoord& location,
+                       size_t fromSegment) const;
+  };
+
+  using RouteSegmentIndexRef = std::shared_ptr<RouteSegmentIndex>;
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <osmscout/Point.h>
 #include <osmscout/Area.h>
 
+#include <optional>
 #include <vector>
 
 namespace osmscout {
@@ -45,5 +46,20 @@ extern OSMSCOUT_API GeoCoord PolygonCenter(const Area& area, double precision =
 
 extern OSMSCOUT_API GeoCoord PolygonCenter(const std::vector<Point>& polygon, double precision = 1);
 
+/**
+ * \ingroup Util
+ *
+ * Return the label anchor of the ring with the given index: the pole of inaccessibility
+ * of the ring, taking the direct inner (clipping) rings into account.
+ *
+ * Returns std::nullopt, if the ring cannot have a label (it is a clipping ring or has no
+ * feature with a label) or if the center of the ring bounding box is a good enough anchor.
+ * Outer rings without own type use the type and features of the master ring.
+ * The bounding box center is used by the renderer if no anchor is stored, it is considered
+ * good enough, if it is inside the ring (and not inside one of its inner rings) and not
+ * further away from the pole of inaccessibility than 20% of the longest bounding box side.
+ */
+extern OSMSCOUT_API std::optional<GeoCoord> RingLabelAnchor(const Area& area, size_t ringIndex);
+
 }
 #endif //OSMSCOUT_POLYGONCENTER_H
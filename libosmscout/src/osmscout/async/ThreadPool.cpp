@@ -0,0 +1,191 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026 Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/async/ThreadPool.h>
+
+#include <algorithm>
+
+#include <osmscout/async/Thread.h>
+
+namespace osmscout {
+
+  namespace {
+    /**
+     * Identifies the pool and the worker the current thread belongs to
+     */
+    struct CurrentWorker
+    {
+      const ThreadPool* pool=nullptr;
+      size_t            worker=0;
+    };
+
+    thread_local CurrentWorker currentWorker;
+  }
+
+  ThreadPool::ThreadPool(size_t threadCount,
+                         const std::string& name)
+  {
+    threadCount=std::max(size_t(1),threadCount);
+
+    queues.reserve(threadCount);
+    threads.reserve(threadCount);
+
+    for (size_t i=0; i<threadCount; i++) {
+      queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (size_t i=0; i<threadCount; i++) {
+      threads.emplace_back(&ThreadPool::Run,this,i,name);
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      running=false;
+    }
+
+    condition.notify_all();
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  void ThreadPool::Push(Priority priority,
+                        Job&& job)
+  {
+    size_t queue;
+
+    if (currentWorker.pool==this) {
+      queue=currentWorker.worker;
+    }
+    else {
+      queue=nextQueue++ % queues.size();
+    }
+
+    {
+      std::scoped_lock<std::mutex> lock(queues[queue]->mutex);
+
+      queues[queue]->jobs[size_t(priority)].push_back(std::move(job));
+    }
+
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+
+      pendingJobs++;
+    }
+
+    condition.notify_one();
+  }
+
+  /**
+   * Take the job with the highest priority, preferring the own queue of the worker. The
+   * worker takes the oldest job of its own queue, but steals the newest job from other
+   * queues.
+   */
+  bool ThreadPool::Pop(size_t worker,
+                       Job& job)
+  {
+    for (size_t priority=0; priority<PriorityCount; priority++) {
+      {
+        std::scoped_lock<std::mutex> lock(queues[worker]->mutex);
+        auto&                        jobs=queues[worker]->jobs[priority];
+
+        if (!jobs.empty()) {
+          job=std::move(jobs.front());
+          jobs.pop_front();
+
+          return true;
+        }
+      }
+
+      for (size_t i=1; i<queues.size(); i++) {
+        size_t                       victim=(worker+i)%queues.size();
+        std::scoped_lock<std::mutex> lock(queues[victim]->mutex);
+        auto&                        jobs=queues[victim]->jobs[priority];
+
+        if (!jobs.empty()) {
+          job=std::move(jobs.back());
+          jobs.pop_back();
+          stolenJobs++;
+
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void ThreadPool::Run(size_t worker,
+                       const std::string& name)
+  {
+    SetThreadName(name);
+
+    currentWorker.pool=this;
+    currentWorker.worker=worker;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        condition.wait(lock,[this]() {
+          return pendingJobs>0 || !running;
+        });
+
+        if (pendingJobs==0) {
+          return;
+        }
+
+        // Claim one of the queued jobs
+        pendingJobs--;
+      }
+
+      Job job;
+
+      // Jobs are queued before they are counted, so there is at least one job
+      // for each claim. Another worker may take it in front of us while we are scanning
+      // the queues, but then there is another one left.
+      while (!Pop(worker,job)) {
+        std::this_thread::yield();
+      }
+
+      job();
+      executedJobs++;
+    }
+  }
+
+  size_t ThreadPool::GetPendingJobCount() const
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+
+    return pendingJobs;
+  }
+
+  ThreadPoolRef ThreadPool::GetShared()
+  {
+    static ThreadPoolRef sharedPool=std::make_shared<ThreadPool>(std::thread::hardware_concurrency(),
+                                                                 "SharedPool");
+
+    return sharedPool;
+  }
+}
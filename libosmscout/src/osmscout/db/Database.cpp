@@ -21,6 +21,8 @@
 
 #include <algorithm>
 
+#include <osmscout/io/File.h>
+
 #include <osmscout/system/Assert.h>
 #include <osmscout/system/Math.h>
 
@@ -271,6 +273,11 @@ namespace osmscout {
       locationIndex=nullptr;
     }
 
+    if (locationNGramIndex) {
+      locationNGramIndex->Close();
+      locationNGramIndex=nullptr;
+    }
+
     if (waterIndex) {
       waterIndex->Close();
       waterIndex=nullptr;
@@ -286,6 +293,11 @@ namespace osmscout {
       optimizeAreasLowZoom=nullptr;
     }
 
+    if (terrainDataFile) {
+      terrainDataFile->Close();
+      terrainDataFile=nullptr;
+    }
+
     isOpen=false;
   }
 
@@ -599,6 +611,41 @@ namespace osmscout {
     return locationIndex;
   }
 
+  LocationNGramIndexRef Database::GetLocationNGramIndex() const
+  {
+    std::scoped_lock<std::mutex> guard(locationNGramIndexMutex);
+
+    if (!IsOpen() || !locationNGramIndexExists) {
+      return nullptr;
+    }
+
+    if (!locationNGramIndex) {
+      // The index is optional, databases imported by older versions do not have it
+      if (!ExistsInFilesystem(AppendFileToDir(path,
+                                              LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX))) {
+        locationNGramIndexExists=false;
+        return nullptr;
+      }
+
+      locationNGramIndex=std::make_shared<LocationNGramIndex>();
+
+      StopClock timer;
+
+      if (!locationNGramIndex->Open(path, parameter.GetIndexMMap())) {
+        log.Error() << "Cannot load location n-gram index!";
+        locationNGramIndexExists=false;
+        locationNGramIndex=nullptr;
+        return nullptr;
+      }
+
+      timer.Stop();
+
+      log.Debug() << "Opening LocationNGramIndex: " << timer.ResultString();
+    }
+
+    return locationNGramIndex;
+  }
+
   WaterIndexRef Database::GetWaterIndex() const
   {
     std::scoped_lock<std::mutex> guard(waterIndexMutex);
@@ -648,6 +695,41 @@ namespace osmscout {
     return srtmIndex;
   }
 
+  TerrainDataFileRef Database::GetTerrainDataFile() const
+  {
+    std::scoped_lock<std::mutex> guard(terrainDataFileMutex);
+
+    if (!IsOpen() || !terrainDataFileExists) {
+      return nullptr;
+    }
+
+    if (!terrainDataFile) {
+      // The file is optional, it is generated separately from SRTM data
+      if (!ExistsInFilesystem(AppendFileToDir(path,
+                                              TerrainDataFile::TERRAIN_DAT))) {
+        terrainDataFileExists=false;
+        return nullptr;
+      }
+
+      terrainDataFile=std::make_shared<TerrainDataFile>();
+
+      StopClock timer;
+
+      if (!terrainDataFile->Open(path, parameter.GetIndexMMap())) {
+        log.Error() << "Cannot load terrain data file!";
+        terrainDataFileExists=false;
+        terrainDataFile=nullptr;
+        return nullptr;
+      }
+
+      timer.Stop();
+
+      log.Debug() << "Opening TerrainDataFile: " << timer.ResultString();
+    }
+
+    return terrainDataFile;
+  }
+
   OptimizeAreasLowZoomRef Database::GetOptimizeAreasLowZoom() const
   {
     std::scoped_lock<std::mutex> guard(optimizeAreasMutex);
@@ -1223,6 +1305,15 @@ namespace osmscout {
 
   NodeRegionSearchResult Database::LoadNodesInArea(const TypeInfoSet& types,
                                                    const GeoBox& boundingBox) const
+  {
+    return LoadNodesInArea(types,
+                           boundingBox,
+                           boundingBox.GetCenter());
+  }
+
+  NodeRegionSearchResult Database::LoadNodesInArea(const TypeInfoSet& types,
+                                                   const GeoBox& boundingBox,
+                                                   const GeoCoord& location) const
   {
     AreaNodeIndexRef areaNodeIndex=GetAreaNodeIndex();
 
@@ -1233,7 +1324,6 @@ namespace osmscout {
     NodeRegionSearchResult  result;
     std::vector<FileOffset> offsets;
     TypeInfoSet             loadedAddressTypes;
-    GeoCoord                center=boundingBox.GetCenter();
 
     if (!areaNodeIndex->GetOffsets(boundingBox,
                                    types,
@@ -1260,7 +1350,7 @@ namespace osmscout {
     }
 
     for (const auto& node : nodes) {
-      Distance distance=GetEllipsoidalDistance(center,
+      Distance distance=GetEllipsoidalDistance(location,
                                                node.get()->GetCoords());
 
       result.nodeResults.push_back(NodeRegionSearchResultEntry(node,
@@ -1272,6 +1362,15 @@ namespace osmscout {
 
   WayRegionSearchResult Database::LoadWaysInArea(const TypeInfoSet& types,
                                                  const GeoBox& boundingBox) const
+  {
+    return LoadWaysInArea(types,
+                          boundingBox,
+                          boundingBox.GetCenter());
+  }
+
+  WayRegionSearchResult Database::LoadWaysInArea(const TypeInfoSet& types,
+                                                 const GeoBox& boundingBox,
+                                                 const GeoCoord& location) const
   {
     AreaWayIndexRef areaWayIndex=GetAreaWayIndex();
 
@@ -1282,7 +1381,6 @@ namespace osmscout {
     WayRegionSearchResult   result;
     std::vector<FileOffset> offsets;
     TypeInfoSet             loadedAddressTypes;
-    GeoCoord                center=boundingBox.GetCenter();
 
     if (!areaWayIndex->GetOffsets(boundingBox,
                                   types,
@@ -1321,7 +1419,7 @@ namespace osmscout {
         a=way->nodes[i-1].GetCoord();
         b=way->nodes[i].GetCoord();
 
-        double newDistance=CalculateDistancePointToLineSegment(center,
+        double newDistance=CalculateDistancePointToLineSegment(location,
                                                                a,
                                                                b,
                                                                intersection);
@@ -1330,7 +1428,7 @@ namespace osmscout {
           continue;
         }
 
-        currentDistance=GetEllipsoidalDistance(center,
+        currentDistance=GetEllipsoidalDistance(location,
                                                intersection);
 
         if (currentDistance<distance) {
@@ -1349,6 +1447,15 @@ namespace osmscout {
 
   AreaRegionSearchResult Database::LoadAreasInArea(const TypeInfoSet& types,
                                                    const GeoBox& boundingBox) const
+  {
+    return LoadAreasInArea(types,
+                           boundingBox,
+                           boundingBox.GetCenter());
+  }
+
+  AreaRegionSearchResult Database::LoadAreasInArea(const TypeInfoSet& types,
+                                                   const GeoBox& boundingBox,
+                                                   const GeoCoord& location) const
   {
     AreaAreaIndexRef areaAreaIndex=GetAreaAreaIndex();
 
@@ -1359,7 +1466,6 @@ namespace osmscout {
     AreaRegionSearchResult     result;
     std::vector<DataBlockSpan> areaSpans;
     TypeInfoSet                loadedTypes;
-    GeoCoord                   center=boundingBox.GetCenter();
 
     if (!areaAreaIndex->GetAreasInArea(*typeConfig,
                                        boundingBox,
@@ -1399,7 +1505,7 @@ namespace osmscout {
         }
 
         if (ring.IsTopOuter()) {
-          if (IsCoordInArea(center,
+          if (IsCoordInArea(location,
                             ring.nodes)) {
             distance=Distance::Of<Meter>(0.0);
             inArea=true;
@@ -1422,7 +1528,7 @@ namespace osmscout {
               b=ring.nodes[i].GetCoord();
             }
 
-            double newDistance=CalculateDistancePointToLineSegment(center,
+            double newDistance=CalculateDistancePointToLineSegment(location,
                                                                    a,
                                                                    b,
                                                                    intersection);
@@ -1431,7 +1537,7 @@ namespace osmscout {
               continue;
             }
 
-            currentDistance=GetEllipsoidalDistance(center,
+            currentDistance=GetEllipsoidalDistance(location,
                                                    intersection);
 
             if (currentDistance<distance) {
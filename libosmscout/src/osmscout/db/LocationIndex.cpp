@@ -573,6 +573,26 @@ namespace osmscout {
     return !scanner.HasError();
   }
 
+  bool LocationIndex::GetAdminRegionByOffset(FileOffset offset,
+                                             AdminRegion& region) const
+  {
+    try {
+      FileScannerPtr scanner=fileScannerPool.Borrow();
+      if (!scanner){
+        return false;
+      }
+
+      scanner->SetPos(offset);
+
+      return LoadAdminRegion(*scanner,
+                             region);
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+  }
+
   bool LocationIndex::VisitAdminRegions(AdminRegionVisitor& visitor) const
   {
     try {
@@ -0,0 +1,304 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/db/LocationNGramIndex.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/String.h>
+
+namespace osmscout {
+
+  const char* const LocationNGramIndex::FILENAME_LOCATION_NGRAM_IDX="locationngram.idx";
+
+  LocationNGramIndex::~LocationNGramIndex()
+  {
+    Close();
+  }
+
+  bool LocationNGramIndex::Open(const std::string& path, bool memoryMappedData)
+  {
+    datafilename=AppendFileToDir(path,FILENAME_LOCATION_NGRAM_IDX);
+
+    try {
+      scanner.Open(datafilename,FileScanner::FastRandom,memoryMappedData);
+
+      FileOffset directoryOffset=scanner.ReadFileOffset();
+
+      scanner.SetPos(directoryOffset);
+
+      uint32_t regionCount=scanner.ReadUInt32Number();
+
+      regions.resize(regionCount);
+
+      for (auto& region : regions) {
+        region.region=scanner.ReadFileOffset();
+        region.parent=scanner.ReadFileOffset();
+      }
+
+      for (auto& section : sections) {
+        uint32_t nGramCount=scanner.ReadUInt32Number();
+
+        section.resize(nGramCount);
+
+        for (auto& entry : section) {
+          entry.nGram=scanner.ReadUInt32Number();
+          entry.count=scanner.ReadUInt32Number();
+          entry.offset=scanner.ReadFileOffset();
+        }
+      }
+
+      if (scanner.HasError()) {
+        log.Error() << "Error while reading from file '" << scanner.GetFilename() << "'";
+        return false;
+      }
+
+      return true;
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+  }
+
+  void LocationNGramIndex::Close()
+  {
+    regions.clear();
+
+    for (auto& section : sections) {
+      section.clear();
+    }
+
+    try  {
+      if (scanner.IsOpen()) {
+        scanner.Close();
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+    }
+  }
+
+  FileOffset LocationNGramIndex::GetParentRegion(FileOffset region) const
+  {
+    auto entry=std::lower_bound(regions.begin(),
+                                regions.end(),
+                                region,
+                                [](const RegionEntry& entry, FileOffset offset) {
+                                  return entry.region<offset;
+                                });
+
+    if (entry==regions.end() ||
+        entry->region!=region) {
+      return 0;
+    }
+
+    return entry->parent;
+  }
+
+  void LocationNGramIndex::ReadPostingList(const NGramEntry& entry,
+                                           std::vector<FileOffset>& postings) const
+  {
+    FileOffset offset=0;
+
+    postings.clear();
+    postings.reserve(entry.count);
+
+    scanner.SetPos(entry.offset);
+
+    for (uint32_t i=0; i<entry.count; i++) {
+      offset+=scanner.ReadUInt64Number();
+      postings.push_back(offset);
+    }
+  }
+
+  /**
+   * Return the entries of the given section, that may match the given pattern.
+   *
+   * The candidates are a superset of the entries, for which a StringMatcherCI or a
+   * StringMatcherTransliterate for the pattern returns a (partial) match. If the posting
+   * list of an n-gram of the pattern is longer than maxPostingSize it is not used for
+   * restricting the candidates, because reading it would be more expensive than testing the
+   * entries themselves.
+   *
+   * @param section
+   *    Section to search in
+   * @param pattern
+   *    Search pattern, as passed to the StringMatcherFactory
+   * @param candidates
+   *    Sorted offsets of the candidates
+   * @param maxPostingSize
+   *    Maximum length of a posting list to read
+   * @return
+   *    True, if the candidates are valid, false if the index cannot restrict the candidates
+   *    for the pattern (or on error)
+   */
+  bool LocationNGramIndex::GetCandidates(Section section,
+                                         const std::string& pattern,
+                                         std::vector<FileOffset>& candidates,
+                                         size_t maxPostingSize) const
+  {
+    std::string           normalizedPattern=NormalizeName(pattern);
+    std::vector<uint32_t> nGrams;
+
+    candidates.clear();
+
+    if (normalizedPattern.empty()) {
+      return false;
+    }
+
+    GetNGrams(normalizedPattern,
+              std::min(normalizedPattern.length(),MaxNGramLength),
+              nGrams);
+
+    std::sort(nGrams.begin(),nGrams.end());
+    nGrams.erase(std::unique(nGrams.begin(),nGrams.end()),nGrams.end());
+
+    const std::vector<NGramEntry>& directory=sections[size_t(section)];
+    std::vector<const NGramEntry*> entries;
+
+    for (uint32_t nGram : nGrams) {
+      auto entry=std::lower_bound(directory.begin(),
+                                  directory.end(),
+                                  nGram,
+                                  [](const NGramEntry& entry, uint32_t value) {
+                                    return entry.nGram<value;
+                                  });
+
+      if (entry==directory.end() ||
+          entry->nGram!=nGram) {
+        // No name contains this n-gram, so nothing can match
+        return true;
+      }
+
+      entries.push_back(&*entry);
+    }
+
+    // Intersect the shortest posting lists first
+    std::sort(entries.begin(),
+              entries.end(),
+              [](const NGramEntry* a, const NGramEntry* b) {
+                return a->count<b->count;
+              });
+
+    if (entries.front()->count>maxPostingSize) {
+      return false;
+    }
+
+    try {
+      std::scoped_lock<std::mutex> lock(lookupMutex);
+      std::vector<FileOffset>      postings;
+      std::vector<FileOffset>      intersection;
+
+      ReadPostingList(*entries.front(),
+                      candidates);
+
+      for (size_t i=1; i<entries.size() && !candidates.empty(); i++) {
+        if (entries[i]->count>maxPostingSize) {
+          break;
+        }
+
+        ReadPostingList(*entries[i],
+                        postings);
+
+        intersection.clear();
+
+        std::set_intersection(candidates.begin(),
+                              candidates.end(),
+                              postings.begin(),
+                              postings.end(),
+                              std::back_inserter(intersection));
+
+        std::swap(candidates,intersection);
+      }
+
+      if (scanner.HasError()) {
+        log.Error() << "Error while reading from file '" << scanner.GetFilename() << "'";
+        candidates.clear();
+        return false;
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      candidates.clear();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Return true, if the given region is the ancestor region or one of its (indirect)
+   * child regions
+   */
+  bool LocationNGramIndex::IsInRegion(FileOffset region,
+                                      FileOffset ancestor) const
+  {
+    // Guard against endless loops on broken data
+    for (size_t depth=0; region!=0 && depth<=regions.size(); depth++) {
+      if (region==ancestor) {
+        return true;
+      }
+
+      region=GetParentRegion(region);
+    }
+
+    return false;
+  }
+
+  /**
+   * Normalize the given name before splitting it into n-grams
+   */
+  std::string LocationNGramIndex::NormalizeName(const std::string& name)
+  {
+    return UTF8Transliterate(UTF8StringToUpper(name));
+  }
+
+  /**
+   * Append all n-grams of the given length of the given (normalized) name. N-grams are
+   * sequences of bytes. The length of the n-gram is encoded into the value, too, so
+   * n-grams of different length are distinct.
+   */
+  void LocationNGramIndex::GetNGrams(const std::string& normalizedName,
+                                     size_t length,
+                                     std::vector<uint32_t>& nGrams)
+  {
+    if (length==0 ||
+        length>MaxNGramLength ||
+        normalizedName.length()<length) {
+      return;
+    }
+
+    for (size_t start=0; start+length<=normalizedName.length(); start++) {
+      uint32_t nGram=uint32_t(length) << 24;
+
+      for (size_t i=0; i<length; i++) {
+        nGram|=uint32_t(static_cast<unsigned char>(normalizedName[start+i])) << (8*(length-1-i));
+      }
+
+      nGrams.push_back(nGram);
+    }
+  }
+}
@@ -1,12 +1,61 @@
 #include <osmscout/db/TextSearchIndex.h>
 
+#include <algorithm>
+#include <functional>
+
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/String.h>
 
 #include <osmscout/io/File.h>
 
+#include <osmscout/db/FuzzyTrieMatcher.h>
+
 namespace osmscout
 {
+  namespace {
+
+    /**
+     * Adapter of a marisa trie for FuzzyTrieMatcher
+     */
+    class MarisaTrie
+    {
+    private:
+      const marisa::Trie& trie;
+
+    public:
+      explicit MarisaTrie(const marisa::Trie& trie)
+      : trie(trie)
+      {
+        // no code
+      }
+
+      bool HasPrefix(const std::string& prefix) const
+      {
+        marisa::Agent agent;
+
+        agent.set_query(prefix.c_str(),
+                        prefix.length());
+
+        return trie.predictive_search(agent);
+      }
+
+      void VisitKeys(const std::string& prefix,
+                     const std::function<bool(const std::string& key)>& visitor) const
+      {
+        marisa::Agent agent;
+
+        agent.set_query(prefix.c_str(),
+                        prefix.length());
+
+        while (trie.predictive_search(agent)) {
+          if (!visitor(std::string(agent.key().ptr(),agent.key().length()))) {
+            return;
+          }
+        }
+      }
+    };
+  }
+
   const char* const TextSearchIndex::TEXT_POI_DAT="textpoi.dat";
   const char* const TextSearchIndex::TEXT_LOC_DAT="textloc.dat";
   const char* const TextSearchIndex::TEXT_REGION_DAT="textregion.dat";
@@ -172,6 +221,129 @@ namespace osmscout
     return true;
   }
 
+  bool TextSearchIndex::SearchFuzzy(const std::string& query,
+                                    bool searchPOIs,
+                                    bool searchLocations,
+                                    bool searchRegions,
+                                    bool searchOther,
+                                    bool transliterate,
+                                    const FuzzySearchParameter& parameter,
+                                    FuzzyResults& results) const
+  {
+    results.clear();
+
+    std::string lookupStr=UTF8NormForLookup(query);
+    if (transliterate) {
+      lookupStr=UTF8Transliterate(lookupStr);
+    }
+
+    if (lookupStr.empty() ||
+        parameter.limit==0) {
+      return true;
+    }
+
+    // Short queries would match nearly everything with the maximum distance
+    size_t queryLength=SplitUTF8Characters(lookupStr).size();
+    size_t maxDistance=std::min(parameter.maxDistance,queryLength/3);
+
+    std::vector<bool> searchGroups;
+
+    searchGroups.push_back(searchPOIs);
+    searchGroups.push_back(searchLocations);
+    searchGroups.push_back(searchRegions);
+    searchGroups.push_back(searchOther);
+
+    // Default importance of the object kinds in the order of the tries
+    std::vector<double> groupImportance{0.33,0.66,1.0,0.0};
+
+    std::unordered_map<std::string,size_t> resultIndex;
+    std::vector<double>                    importance;
+
+    for (size_t i=0; i<tries.size(); i++) {
+      if (!searchGroups[i] || !tries[i].isAvail) {
+        continue;
+      }
+
+      std::unordered_map<std::string,size_t> trieTexts;
+
+      try {
+        MarisaTrie                   trie(*tries[i].trie);
+        FuzzyTrieMatcher<MarisaTrie> matcher(trie,
+                                             lookupStr,
+                                             maxDistance,
+                                             parameter.limit,
+                                             parameter.maxLookups);
+
+        matcher.Match([this,&parameter,&groupImportance,i,&results,&resultIndex,&importance,&trieTexts](const std::string& key,
+                                                                                                       size_t distance) {
+          std::string   text;
+          ObjectFileRef ref;
+
+          splitSearchResult(key,text,ref);
+
+          auto trieText=trieTexts.find(text);
+
+          // Texts are reported with increasing distance, all keys of a text are reported
+          // in one go. So a text reported again was already collected with a better distance.
+          if (trieText!=trieTexts.end() &&
+              trieText->second!=distance) {
+            return trieTexts.size();
+          }
+
+          trieTexts.emplace(text,distance);
+
+          auto index=resultIndex.find(text);
+
+          if (index==resultIndex.end()) {
+            index=resultIndex.emplace(text,results.size()).first;
+            results.push_back(FuzzyResult{text,{},distance,0.0});
+            importance.push_back(0.0);
+          }
+
+          FuzzyResult& result=results[index->second];
+
+          if (distance<result.distance) {
+            result.distance=distance;
+          }
+
+          result.refs.push_back(ref);
+          importance[index->second]=std::max(importance[index->second],
+                                             parameter.importance ? parameter.importance(ref) : groupImportance[i]);
+
+          return trieTexts.size();
+        });
+      }
+      catch (const marisa::Exception &ex) {
+        log.Error() << "Error searching for text: " << ex.what();
+
+        return false;
+      }
+    }
+
+    // The edit distance dominates the score, importance and length of the completion
+    // only rank results with the same distance
+    for (size_t i=0; i<results.size(); i++) {
+      size_t completionLength=SplitUTF8Characters(results[i].text).size();
+
+      completionLength=completionLength>queryLength ? completionLength-queryLength : 0;
+
+      results[i].score=double(results[i].distance)+
+                       std::min(0.5,0.02*double(completionLength))-
+                       0.25*std::clamp(importance[i],0.0,1.0);
+    }
+
+    std::stable_sort(results.begin(),results.end(),[](const FuzzyResult& a,
+                                                      const FuzzyResult& b) {
+      return a.score<b.score;
+    });
+
+    if (results.size()>parameter.limit) {
+      results.resize(parameter.limit);
+    }
+
+    return true;
+  }
+
   void TextSearchIndex::splitSearchResult(const std::string& result,
                                           std::string& text,
                                           ObjectFileRef& ref) const
@@ -25,16 +25,16 @@
  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
  */
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
-#include <fstream>
-#include <ostream>
 #include <sstream>
 
 #include <osmscout/elevation/SRTM.h>
 
-#include <osmscout/log/Logger.h>
+#include <osmscout/io/File.h>
 
-#include <osmscout/system/Math.h>
+#include <osmscout/log/Logger.h>
 
 namespace osmscout {
 
@@ -43,15 +43,66 @@ namespace osmscout {
 #define SRTM1_FILESIZE (SRTM1_GRID*SRTM1_GRID*2)
 #define SRTM3_FILESIZE (SRTM3_GRID*SRTM3_GRID*2)
 
-  SRTM::SRTM(const std::string& path)
+  SRTM::Tile::~Tile()
+  {
+    try {
+      if (scanner.IsOpen()) {
+        scanner.Close();
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+    }
+  }
+
+  /**
+   * Return the height at the given location, interpolated between the four surrounding
+   * samples. If one of them has no data, the nearest sample is returned.
+   */
+  int32_t SRTM::Tile::GetInterpolatedHeight(const GeoCoord& coord) const
+  {
+    // Row 0 is the northern edge, column 0 the western edge of the tile
+    double scale=double(grid-1);
+    double x=std::clamp((coord.GetLon()-double(patchLon))*scale,0.0,scale);
+    double y=std::clamp((double(patchLat+1)-coord.GetLat())*scale,0.0,scale);
+    size_t column=std::min(size_t(x),grid-2);
+    size_t row=std::min(size_t(y),grid-2);
+    double fx=x-double(column);
+    double fy=y-double(row);
+
+    int32_t h00=GetHeight(column,row);
+    int32_t h10=GetHeight(column+1,row);
+    int32_t h01=GetHeight(column,row+1);
+    int32_t h11=GetHeight(column+1,row+1);
+
+    if (h00==nodata ||
+        h10==nodata ||
+        h01==nodata ||
+        h11==nodata) {
+      return GetHeight(size_t(std::lround(x)),
+                       size_t(std::lround(y)));
+    }
+
+    double h=double(h00)*(1.0-fx)*(1.0-fy)+
+             double(h10)*fx*(1.0-fy)+
+             double(h01)*(1.0-fx)*fy+
+             double(h11)*fx*fy;
+
+    return int32_t(std::lround(h));
+  }
+
+  SRTM::SRTM(const std::string& path,
+             size_t cacheSize)
   : srtmPath(path),
-    heights(nullptr)
+    cacheSize(std::max(cacheSize,size_t(1)))
   {
   }
 
-  SRTM::~SRTM()
+  int SRTM::GetTileKey(int patchLat,
+                       int patchLon)
   {
-    delete heights;
+    return (patchLat+90)*360+(patchLon+180);
   }
 
   /**
@@ -99,81 +150,94 @@ namespace osmscout {
     return fileName.str();
   }
 
-  bool SRTM::AssureCorrectFileLoaded(double latitude,
-                                     double longitude)
+  /**
+   * Load the HGT file for the given patch. Returns nullptr, if there is no (valid) file.
+   */
+  SRTM::TileRef SRTM::LoadTile(int patchLat,
+                               int patchLon) const
   {
-    int         patchLat     =int(floor(latitude));
-    int         patchLon     =int(floor(longitude));
-    std::string patchFilename=CalculateHGTFilename(patchLat,
-                                                   patchLon);
+    std::string filename=AppendFileToDir(srtmPath,
+                                         CalculateHGTFilename(patchLat,
+                                                              patchLon));
 
-    if (currentFilename==patchFilename) {
-      return heights!=nullptr;
-    }
+    try {
+      if (!ExistsInFilesystem(filename)) {
+        return nullptr;
+      }
 
-    std::istream::pos_type length;
+      auto       tile=std::make_shared<Tile>();
+      FileOffset fileSize=GetFileSize(filename);
 
-    currentFilename=std::move(patchFilename);
+      if (fileSize==SRTM1_FILESIZE) {
+        tile->grid=SRTM1_GRID;
+        log.Debug() << "Open SRTM1 hgt file: " << filename;
+      }
+      else if (fileSize==SRTM3_FILESIZE) {
+        tile->grid=SRTM3_GRID;
+        log.Debug() << "Open SRTM3 hgt file: " << filename;
+      }
+      else {
+        log.Warn() << "Unexpected size of hgt file: " << filename;
+        return nullptr;
+      }
 
-    if (heights!=nullptr) {
-      delete heights;
-      heights=nullptr;
-    }
+      tile->patchLat=patchLat;
+      tile->patchLon=patchLon;
 
-    std::ifstream currentFile;
+      tile->scanner.Open(filename,
+                         FileScanner::FastRandom,
+                         true);
 
-    currentFile.open(srtmPath+"/"+currentFilename,
-                     std::ios::in | std::ios::binary | std::ios::ate);
+      tile->data=reinterpret_cast<const uint8_t*>(tile->scanner.GetMappedData());
 
-    if (!currentFile.std::ios::good()) {
-      currentFile.close();
-      return false;
-    }
-
-    length=currentFile.tellg();
-    currentFile.seekg(0,
-                      std::ios::beg);
+      if (tile->data==nullptr) {
+        tile->buffer.resize(fileSize);
+        tile->scanner.Read(reinterpret_cast<char*>(tile->buffer.data()),
+                           fileSize);
+        tile->scanner.Close();
+        tile->data=tile->buffer.data();
+      }
 
-    if (length==(std::istream::pos_type) SRTM1_FILESIZE) {
-      rows   =SRTM1_GRID;
-      columns=SRTM1_GRID;
-      patchSize=SRTM1_FILESIZE;
-      log.Debug() << "Open SRTM1 hgt file: " << (srtmPath+"/"+currentFilename).c_str();
-    }
-    else if (length==(std::istream::pos_type) SRTM3_FILESIZE) {
-      rows   =SRTM3_GRID;
-      columns=SRTM3_GRID;
-      patchSize=SRTM3_FILESIZE;
-      log.Debug() << "Open SRTM3 hgt file: " << (srtmPath+"/"+currentFilename).c_str();
+      return tile;
     }
-    else {
-      return false;
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return nullptr;
     }
+  }
 
-    heights=new uint8_t[SRTM::patchSize];
-
-    currentFile.read((char*) heights,
-                     SRTM::patchSize);
+  /**
+   * Return the tile for the given patch from the cache, loading it if necessary.
+   * Returns nullptr, if there is no data for the patch.
+   */
+  SRTM::TileRef SRTM::GetTile(int patchLat,
+                              int patchLon)
+  {
+    int                          key=GetTileKey(patchLat,
+                                                patchLon);
+    std::scoped_lock<std::mutex> lock(cacheMutex);
+    auto                         entry=cache.find(key);
 
-    if (!currentFile.std::ios::good()) {
-      delete[] heights;
-      heights=nullptr;
-      currentFile.close();
+    if (entry!=cache.end()) {
+      lruList.splice(lruList.begin(),
+                     lruList,
+                     entry->second.lruEntry);
 
-      return false;
+      return entry->second.tile;
     }
 
-    currentFile.close();
+    TileRef tile=LoadTile(patchLat,
+                          patchLon);
 
-    fileBoundingBox=GeoBox(GeoCoord(patchLat,patchLon),GeoCoord(patchLat+1,patchLon+1));
+    lruList.push_front(key);
+    cache[key]=CacheEntry{tile,lruList.begin()};
 
-    return true;
-  }
+    while (cache.size()>cacheSize) {
+      cache.erase(lruList.back());
+      lruList.pop_back();
+    }
 
-  int32_t SRTM::GetHeight(size_t column, size_t row) const
-  {
-    return (heights[2*row*SRTM::columns+2*column] << 8)+
-           (heights[2*row*SRTM::columns+2*column+1]);
+    return tile;
   }
 
   /**
@@ -181,52 +245,60 @@ namespace osmscout {
    */
   int32_t SRTM::GetHeightAtLocation(const GeoCoord& coord)
   {
-    if (!AssureCorrectFileLoaded(coord.GetLat(),
-                                 coord.GetLon())) {
+    TileRef tile=GetTile(int(floor(coord.GetLat())),
+                         int(floor(coord.GetLon())));
+
+    if (!tile) {
       return nodata;
     }
 
-    if (heights!=nullptr) {
-      [[maybe_unused]] double pixelSize=1.0/double(SRTM::rows-1);
-      double                  latitude=coord.GetLat();
-      double                  longitude=coord.GetLon();
-      double                  fracLat  =latitude>=0.0 ? 1-latitude+floor(latitude) : ceil(latitude)-latitude;
-      double                  fracLon  =longitude>=0.0 ? longitude-floor(longitude) : 1-ceil(longitude)+longitude;
-      int                     col      =int(floor(fracLon*SRTM::columns));
-      int                     row      =int(floor(fracLat*SRTM::rows));
-
-      int32_t h1=GetHeight(col,row);
-
-      log.Debug() << "Height at " << coord.GetDisplayText() << " " << fracLat << "x" << fracLon << " with tile coords " << col << "," << row << " = " << h1;
-
-#ifndef SRTM_BILINEAR_INTERPOLATION
-      return (int32_t) floor(h1);
-#else
-      // TODO: Hmmm, is the right interpolation box? Have to look again at the original sources!
-      int h2 = GetHeight(col+1,row);
-      int h3 = GetHeight(col,row+1);
-      int h4 = GetHeight(col+1,row+1);
-
-      // bilinear interpolation
-      double fLat = fracLat - fracLat*row/SRTM::rows;
-      double fLon = fracLon - fracLon*pixelSize/SRTM::columns;
-      log.Debug() << "fLat=" << fLat << " fLon=" << fLon;
-
-      double h = h1*(1-fLat)*(1-fLon) + h2*fLat*(1-fLon) + h3*(1-fLat)*fLon + h4*fLat*fLon;
-      return (int32_t)floor(h+0.5);
-#endif
+    return tile->GetInterpolatedHeight(coord);
+  }
+
+  /**
+   * Return the heights at the given locations (or SRTM::nodata for locations without
+   * data). Consecutive locations within the same tile are evaluated without accessing the
+   * cache again, so this is considerably faster than calling GetHeightAtLocation() for
+   * each point of a track.
+   */
+  std::vector<int32_t> SRTM::GetHeights(std::span<const GeoCoord> coords)
+  {
+    std::vector<int32_t> heights(coords.size(),nodata);
+    TileRef              tile;
+    int                  tileKey=-1;
+
+    for (size_t i=0; i<coords.size(); i++) {
+      int patchLat=int(floor(coords[i].GetLat()));
+      int patchLon=int(floor(coords[i].GetLon()));
+      int key=GetTileKey(patchLat,
+                         patchLon);
+
+      if (key!=tileKey) {
+        tile=GetTile(patchLat,
+                     patchLon);
+        tileKey=key;
+      }
+
+      if (tile) {
+        heights[i]=tile->GetInterpolatedHeight(coords[i]);
+      }
     }
 
-    return nodata;
+    return heights;
   }
 
   SRTMDataRef SRTM::GetHeightInBoundingBox(const GeoBox& boundingBox)
   {
-    if (!AssureCorrectFileLoaded(boundingBox.GetMinCoord().GetLat(),
-                                 boundingBox.GetMinCoord().GetLon())) {
+    int     patchLat=int(floor(boundingBox.GetMinCoord().GetLat()));
+    int     patchLon=int(floor(boundingBox.GetMinCoord().GetLon()));
+    TileRef srtmTile=GetTile(patchLat,
+                             patchLon);
+
+    if (!srtmTile) {
       return nullptr;
     }
 
+    GeoBox      fileBoundingBox(GeoCoord(patchLat,patchLon),GeoCoord(patchLat+1,patchLon+1));
     SRTMDataRef tile=std::make_shared<SRTMData>();
 
     tile->boundingBox=boundingBox.Intersection(fileBoundingBox);
@@ -238,14 +310,14 @@ namespace osmscout {
     // TODO: We simply copy the complete height map for now
 
     tile->boundingBox=fileBoundingBox;
-    tile->columns=columns;
-    tile->rows=rows;
+    tile->columns=srtmTile->grid;
+    tile->rows=srtmTile->grid;
 
-    tile->heights.resize(columns*rows);
+    tile->heights.resize(tile->columns*tile->rows);
 
-    for (size_t y=0; y<rows; y++) {
-      for (size_t x=0; x<columns; x++) {
-        int32_t height=GetHeight(x,y);
+    for (size_t y=0; y<tile->rows; y++) {
+      for (size_t x=0; x<tile->columns; x++) {
+        int32_t height=srtmTile->GetHeight(x,y);
 
         if (height>10000) {
           log.Error() << "Unexpected height: " << x << "," << y << " = " << height;
@@ -253,7 +325,7 @@ namespace osmscout {
           height=nodata;
         }
 
-        tile->heights[y*columns+x]=height;
+        tile->heights[y*tile->columns+x]=height;
       }
     }
 
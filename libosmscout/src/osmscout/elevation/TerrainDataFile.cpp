@@ -0,0 +1,210 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/elevation/TerrainDataFile.h>
+
+#include <cmath>
+
+#include <osmscout/io/File.h>
+
+#include <osmscout/log/Logger.h>
+
+namespace osmscout {
+
+  const char* const TerrainDataFile::TERRAIN_DAT="terrain.dat";
+
+  TerrainDataFile::TerrainDataFile(size_t cacheSize)
+  : cache(cacheSize)
+  {
+    // no code
+  }
+
+  TerrainDataFile::~TerrainDataFile()
+  {
+    Close();
+  }
+
+  int TerrainDataFile::GetTileKey(int patchLat,
+                                  int patchLon)
+  {
+    return (patchLat+90)*360+(patchLon+180);
+  }
+
+  bool TerrainDataFile::Open(const std::string& path, bool memoryMappedData)
+  {
+    datafilename=AppendFileToDir(path,TERRAIN_DAT);
+
+    try {
+      scanner.Open(datafilename,FileScanner::FastRandom,memoryMappedData);
+
+      FileOffset indexOffset=scanner.ReadFileOffset();
+
+      scanner.SetPos(indexOffset);
+
+      uint32_t tileCount=scanner.ReadUInt32Number();
+
+      tileOffsets.reserve(tileCount);
+
+      for (uint32_t i=0; i<tileCount; i++) {
+        int32_t    patchLat=scanner.ReadInt32Number();
+        int32_t    patchLon=scanner.ReadInt32Number();
+        FileOffset offset=scanner.ReadFileOffset();
+
+        tileOffsets[GetTileKey(patchLat,patchLon)]=offset;
+      }
+
+      if (scanner.HasError()) {
+        log.Error() << "Error while reading from file '" << scanner.GetFilename() << "'";
+        return false;
+      }
+
+      return true;
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      return false;
+    }
+  }
+
+  void TerrainDataFile::Close()
+  {
+    std::scoped_lock<std::mutex> lock(accessMutex);
+
+    tileOffsets.clear();
+    cache.Flush();
+
+    try  {
+      if (scanner.IsOpen()) {
+        scanner.Close();
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      scanner.CloseFailsafe();
+    }
+  }
+
+  /**
+   * Return all tiles intersecting the given bounding box. Tiles not in the file
+   * are skipped.
+   */
+  bool TerrainDataFile::GetTiles(const GeoBox& boundingBox,
+                                 std::vector<TerrainTileRef>& tiles) const
+  {
+    tiles.clear();
+
+    if (!boundingBox.IsValid()) {
+      return true;
+    }
+
+    int minLat=int(std::floor(boundingBox.GetMinLat()));
+    int maxLat=int(std::floor(boundingBox.GetMaxLat()));
+    int minLon=int(std::floor(boundingBox.GetMinLon()));
+    int maxLon=int(std::floor(boundingBox.GetMaxLon()));
+
+    std::scoped_lock<std::mutex> lock(accessMutex);
+
+    try {
+      for (int patchLat=minLat; patchLat<=maxLat; patchLat++) {
+        for (int patchLon=minLon; patchLon<=maxLon; patchLon++) {
+          int                 key=GetTileKey(patchLat,patchLon);
+          TileCache::CacheRef cacheRef;
+
+          if (cache.GetEntry(key,cacheRef)) {
+            tiles.push_back(cacheRef->value);
+            continue;
+          }
+
+          auto offset=tileOffsets.find(key);
+
+          if (offset==tileOffsets.end()) {
+            continue;
+          }
+
+          auto tile=std::make_shared<TerrainTile>();
+
+          scanner.SetPos(offset->second);
+          tile->Read(scanner);
+
+          cache.SetEntry(TileCache::CacheEntry(key,tile));
+          tiles.push_back(tile);
+        }
+      }
+    }
+    catch (const IOException& e) {
+      log.Error() << e.GetDescription();
+      tiles.clear();
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Create a new terrain data file in the given directory
+   *
+   * throws IOException on error
+   */
+  void TerrainDataFileWriter::Open(const std::string& path)
+  {
+    index.clear();
+
+    writer.Open(AppendFileToDir(path,TerrainDataFile::TERRAIN_DAT));
+
+    indexOffsetOffset=writer.GetPos();
+    writer.WriteFileOffset(0);
+  }
+
+  /**
+   * Append the given tile
+   *
+   * throws IOException on error
+   */
+  void TerrainDataFileWriter::Write(const TerrainTile& tile)
+  {
+    index.push_back({tile.patchLat,
+                     tile.patchLon,
+                     writer.GetPos()});
+
+    tile.Write(writer);
+  }
+
+  /**
+   * Write the index of all tiles and close the file
+   *
+   * throws IOException on error
+   */
+  void TerrainDataFileWriter::Close()
+  {
+    FileOffset indexOffset=writer.GetPos();
+
+    writer.WriteNumber(uint32_t(index.size()));
+
+    for (const auto& entry : index) {
+      writer.WriteNumber(int32_t(entry.patchLat));
+      writer.WriteNumber(int32_t(entry.patchLon));
+      writer.WriteFileOffset(entry.offset);
+    }
+
+    writer.SetPos(indexOffsetOffset);
+    writer.WriteFileOffset(indexOffset);
+
+    writer.Close();
+  }
+}
@@ -0,0 +1,461 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/elevation/TerrainTile.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+#include <osmscout/util/Geometry.h>
+
+namespace osmscout {
+
+  // 255*cos(zenith) for the sun 45° above the horizon
+  const uint8_t TerrainTile::FlatHillShade=180;
+
+  namespace {
+
+    constexpr double SunAzimuth=315.0;   //!< Direction of the sun in degrees, clockwise from north
+    constexpr double SunAltitude=45.0;   //!< Height of the sun over the horizon in degrees
+    constexpr double MeterPerDegree=111320.0;
+
+    constexpr size_t NoSegment=std::numeric_limits<size_t>::max();
+
+    /**
+     * Edges of the sample grid are identified by the sample at their top or left end.
+     * Even ids are horizontal edges, odd ids vertical edges.
+     */
+    uint64_t HorizontalEdge(const SRTMData& data, size_t x, size_t y)
+    {
+      return 2*(uint64_t(y)*data.columns+x);
+    }
+
+    uint64_t VerticalEdge(const SRTMData& data, size_t x, size_t y)
+    {
+      return 2*(uint64_t(y)*data.columns+x)+1;
+    }
+
+    GeoCoord GetSampleCoord(const SRTMData& data, double x, double y)
+    {
+      return {data.boundingBox.GetMaxLat()-y/double(data.rows-1),
+              data.boundingBox.GetMinLon()+x/double(data.columns-1)};
+    }
+
+    /**
+     * Return the location, where the given elevation crosses the given edge
+     */
+    GeoCoord GetCrossing(const SRTMData& data, uint64_t edge, int32_t elevation)
+    {
+      size_t  sample=edge/2;
+      size_t  x=sample%data.columns;
+      size_t  y=sample/data.columns;
+      bool    vertical=(edge%2)!=0;
+      int32_t heightA=data.GetHeight(x,y);
+      int32_t heightB=vertical ? data.GetHeight(x,y+1) : data.GetHeight(x+1,y);
+      double  t=double(elevation-heightA)/double(heightB-heightA);
+
+      if (vertical) {
+        return GetSampleCoord(data,double(x),double(y)+t);
+      }
+
+      return GetSampleCoord(data,double(x)+t,double(y));
+    }
+
+    /**
+     * Marching squares: Collect the segments of the given contour line for all grid cells.
+     * Samples with at least the given elevation are inside. A segment connects the two
+     * edges of the cell crossed by the contour line.
+     */
+    void CollectSegments(const SRTMData& data,
+                         int32_t elevation,
+                         std::vector<std::array<uint64_t,2>>& segments)
+    {
+      segments.clear();
+
+      for (size_t y=0; y+1<data.rows; y++) {
+        for (size_t x=0; x+1<data.columns; x++) {
+          int32_t topLeft=data.GetHeight(x,y);
+          int32_t topRight=data.GetHeight(x+1,y);
+          int32_t bottomRight=data.GetHeight(x+1,y+1);
+          int32_t bottomLeft=data.GetHeight(x,y+1);
+
+          if (topLeft==SRTM::nodata ||
+              topRight==SRTM::nodata ||
+              bottomRight==SRTM::nodata ||
+              bottomLeft==SRTM::nodata) {
+            continue;
+          }
+
+          unsigned int cellCase=(topLeft>=elevation ? 8u : 0u) |
+                                (topRight>=elevation ? 4u : 0u) |
+                                (bottomRight>=elevation ? 2u : 0u) |
+                                (bottomLeft>=elevation ? 1u : 0u);
+
+          if (cellCase==0 || cellCase==15) {
+            continue;
+          }
+
+          uint64_t top=HorizontalEdge(data,x,y);
+          uint64_t right=VerticalEdge(data,x+1,y);
+          uint64_t bottom=HorizontalEdge(data,x,y+1);
+          uint64_t left=VerticalEdge(data,x,y);
+          bool     centerInside=double(topLeft+topRight+bottomRight+bottomLeft)/4.0>=double(elevation);
+
+          switch (cellCase) {
+          case 1:
+          case 14:
+            segments.push_back({left,bottom});
+            break;
+          case 2:
+          case 13:
+            segments.push_back({bottom,right});
+            break;
+          case 3:
+          case 12:
+            segments.push_back({left,right});
+            break;
+          case 4:
+          case 11:
+            segments.push_back({top,right});
+            break;
+          case 6:
+          case 9:
+            segments.push_back({top,bottom});
+            break;
+          case 7:
+          case 8:
+            segments.push_back({top,left});
+            break;
+          case 5:
+            // Saddle, top right and bottom left are inside
+            if (centerInside) {
+              segments.push_back({top,left});
+              segments.push_back({right,bottom});
+            }
+            else {
+              segments.push_back({top,right});
+              segments.push_back({left,bottom});
+            }
+            break;
+          case 10:
+            // Saddle, top left and bottom right are inside
+            if (centerInside) {
+              segments.push_back({top,right});
+              segments.push_back({left,bottom});
+            }
+            else {
+              segments.push_back({top,left});
+              segments.push_back({right,bottom});
+            }
+            break;
+          default:
+            break;
+          }
+        }
+      }
+    }
+
+    void AddContourLine(const SRTMData& data,
+                        int32_t elevation,
+                        const std::deque<uint64_t>& edges,
+                        std::vector<TerrainTile::ContourLine>& contourLines)
+    {
+      // Split long lines, so that invisible parts can be skipped during rendering
+      for (size_t start=0; start+1<edges.size(); start+=TerrainTile::MaxContourLineLength-1) {
+        size_t                   end=std::min(start+TerrainTile::MaxContourLineLength,edges.size());
+        TerrainTile::ContourLine contourLine;
+
+        contourLine.elevation=elevation;
+        contourLine.nodes.reserve(end-start);
+
+        for (size_t i=start; i<end; i++) {
+          GeoCoord coord=GetCrossing(data,edges[i],elevation);
+
+          contourLine.nodes.emplace_back(0,coord);
+          contourLine.boundingBox.Include(coord);
+        }
+
+        contourLines.push_back(std::move(contourLine));
+      }
+    }
+
+    /**
+     * Join the segments of one elevation into lines
+     */
+    void JoinSegments(const SRTMData& data,
+                      int32_t elevation,
+                      const std::vector<std::array<uint64_t,2>>& segments,
+                      std::vector<TerrainTile::ContourLine>& contourLines)
+    {
+      // Every edge is shared by at most two cells and so by at most two segments
+      std::unordered_map<uint64_t,std::array<size_t,2>> edgeSegments;
+      std::vector<bool>                                  used(segments.size(),false);
+
+      edgeSegments.reserve(segments.size()*2);
+
+      for (size_t s=0; s<segments.size(); s++) {
+        for (uint64_t edge : segments[s]) {
+          auto entry=edgeSegments.try_emplace(edge,std::array<size_t,2>{NoSegment,NoSegment}).first;
+
+          entry->second[entry->second[0]==NoSegment ? 0 : 1]=s;
+        }
+      }
+
+      auto getUnusedSegment=[&](uint64_t edge) {
+        for (size_t s : edgeSegments[edge]) {
+          if (s!=NoSegment && !used[s]) {
+            return s;
+          }
+        }
+
+        return NoSegment;
+      };
+
+      for (size_t s=0; s<segments.size(); s++) {
+        if (used[s]) {
+          continue;
+        }
+
+        used[s]=true;
+
+        std::deque<uint64_t> edges{segments[s][0],segments[s][1]};
+
+        for (bool forward : {true,false}) {
+          while (true) {
+            uint64_t edge=forward ? edges.back() : edges.front();
+            size_t   next=getUnusedSegment(edge);
+
+            if (next==NoSegment) {
+              break;
+            }
+
+            used[next]=true;
+
+            uint64_t nextEdge=segments[next][0]==edge ? segments[next][1] : segments[next][0];
+
+            if (forward) {
+              edges.push_back(nextEdge);
+            }
+            else {
+              edges.push_front(nextEdge);
+            }
+          }
+        }
+
+        AddContourLine(data,
+                       elevation,
+                       edges,
+                       contourLines);
+      }
+    }
+
+    void GenerateContourLines(const SRTMData& data,
+                              int32_t contourInterval,
+                              TerrainTile& tile)
+    {
+      int32_t minHeight=std::numeric_limits<int32_t>::max();
+      int32_t maxHeight=std::numeric_limits<int32_t>::min();
+
+      for (auto height : data.heights) {
+        if (height!=SRTM::nodata) {
+          minHeight=std::min(minHeight,height);
+          maxHeight=std::max(maxHeight,height);
+        }
+      }
+
+      if (minHeight>maxHeight) {
+        return;
+      }
+
+      std::vector<std::array<uint64_t,2>> segments;
+      int32_t                             firstElevation=int32_t(std::floor(double(minHeight)/contourInterval))*contourInterval+contourInterval;
+
+      for (int32_t elevation=firstElevation; elevation<=maxHeight; elevation+=contourInterval) {
+        CollectSegments(data,
+                        elevation,
+                        segments);
+        JoinSegments(data,
+                     elevation,
+                     segments,
+                     tile.contourLines);
+      }
+    }
+
+    /**
+     * Hill shading using the slope and aspect as calculated by Horn's method for the sample
+     * nearest to the center of each raster cell
+     */
+    void GenerateHillShade(const SRTMData& data,
+                           size_t cells,
+                           TerrainTile& tile)
+    {
+      double zenith=DegToRad(90.0-SunAltitude);
+      double azimuth=DegToRad(std::fmod(360.0-SunAzimuth+90.0,360.0));
+      double dy=MeterPerDegree/double(data.rows-1);
+
+      tile.hillShadeRows=cells;
+      tile.hillShadeColumns=cells;
+      tile.hillShade.assign(cells*cells,TerrainTile::FlatHillShade);
+
+      for (size_t row=0; row<cells; row++) {
+        double fracRow=(double(row)+0.5)/double(cells);
+        size_t y=std::clamp(size_t(std::lround(fracRow*double(data.rows-1))),size_t(1),data.rows-2);
+        double dx=dy*std::cos(DegToRad(data.boundingBox.GetMaxLat()-fracRow));
+
+        for (size_t column=0; column<cells; column++) {
+          double fracColumn=(double(column)+0.5)/double(cells);
+          size_t x=std::clamp(size_t(std::lround(fracColumn*double(data.columns-1))),size_t(1),data.columns-2);
+
+          std::array<double,9> z;
+          bool                 valid=true;
+
+          for (size_t i=0; i<9 && valid; i++) {
+            int32_t height=data.GetHeight(x+i%3-1,y+i/3-1);
+
+            valid=height!=SRTM::nodata;
+            z[i]=double(height);
+          }
+
+          if (!valid) {
+            continue;
+          }
+
+          // Neighbours a b c / d e f / g h i, north up
+          double dzdx=((z[2]+2*z[5]+z[8])-(z[0]+2*z[3]+z[6]))/(8*dx);
+          double dzdy=((z[6]+2*z[7]+z[8])-(z[0]+2*z[1]+z[2]))/(8*dy);
+          double slope=std::atan(std::sqrt(dzdx*dzdx+dzdy*dzdy));
+          double aspect=std::atan2(dzdy,-dzdx);
+          double shade=255.0*(std::cos(zenith)*std::cos(slope)+
+                              std::sin(zenith)*std::sin(slope)*std::cos(azimuth-aspect));
+
+          tile.hillShade[row*cells+column]=uint8_t(std::clamp(std::lround(shade),0l,255l));
+        }
+      }
+    }
+  }
+
+  GeoBox TerrainTile::GetBoundingBox() const
+  {
+    return {GeoCoord(patchLat,patchLon),
+            GeoCoord(patchLat+1,patchLon+1)};
+  }
+
+  GeoBox TerrainTile::GetHillShadeCell(size_t column, size_t row) const
+  {
+    return {GeoCoord(double(patchLat+1)-double(row+1)/double(hillShadeRows),
+                     double(patchLon)+double(column)/double(hillShadeColumns)),
+            GeoCoord(double(patchLat+1)-double(row)/double(hillShadeRows),
+                     double(patchLon)+double(column+1)/double(hillShadeColumns))};
+  }
+
+  /**
+   * Read the tile from the given scanner
+   *
+   * throws IOException on error
+   */
+  void TerrainTile::Read(FileScanner& scanner)
+  {
+    patchLat=scanner.ReadInt32Number();
+    patchLon=scanner.ReadInt32Number();
+
+    uint32_t contourLineCount=scanner.ReadUInt32Number();
+
+    contourLines.resize(contourLineCount);
+
+    std::vector<SegmentGeoBox> segments;
+
+    for (auto& contourLine : contourLines) {
+      contourLine.elevation=scanner.ReadInt32Number();
+      scanner.Read(contourLine.nodes,
+                   segments,
+                   contourLine.boundingBox,
+                   false);
+    }
+
+    hillShadeRows=scanner.ReadUInt32Number();
+    hillShadeColumns=scanner.ReadUInt32Number();
+
+    hillShade.resize(hillShadeRows*hillShadeColumns);
+
+    if (!hillShade.empty()) {
+      scanner.Read(reinterpret_cast<char*>(hillShade.data()),
+                   hillShade.size());
+    }
+  }
+
+  /**
+   * Write the tile to the given writer
+   *
+   * throws IOException on error
+   */
+  void TerrainTile::Write(FileWriter& writer) const
+  {
+    writer.WriteNumber(int32_t(patchLat));
+    writer.WriteNumber(int32_t(patchLon));
+
+    writer.WriteNumber(uint32_t(contourLines.size()));
+
+    for (const auto& contourLine : contourLines) {
+      writer.WriteNumber(contourLine.elevation);
+      writer.Write(contourLine.nodes,
+                   false);
+    }
+
+    writer.WriteNumber(uint32_t(hillShadeRows));
+    writer.WriteNumber(uint32_t(hillShadeColumns));
+
+    if (!hillShade.empty()) {
+      writer.Write(reinterpret_cast<const char*>(hillShade.data()),
+                   hillShade.size());
+    }
+  }
+
+  /**
+   * Generate contour lines in the given interval (in meter) and a hill shading raster with the
+   * given number of cells per degree from the height map of one SRTM patch
+   */
+  TerrainTileRef TerrainTile::Generate(const SRTMData& data,
+                                       int32_t contourInterval,
+                                       size_t hillShadeCells)
+  {
+    auto tile=std::make_shared<TerrainTile>();
+
+    tile->patchLat=int(std::lround(data.boundingBox.GetMinLat()));
+    tile->patchLon=int(std::lround(data.boundingBox.GetMinLon()));
+
+    if (data.rows<3 ||
+        data.columns<3) {
+      return tile;
+    }
+
+    GenerateContourLines(data,
+                         std::max(contourInterval,int32_t(1)),
+                         *tile);
+
+    GenerateHillShade(data,
+                      std::max(hillShadeCells,size_t(1)),
+                      *tile);
+
+    return tile;
+  }
+}
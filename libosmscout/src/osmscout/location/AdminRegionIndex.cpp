@@ -0,0 +1,404 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/location/AdminRegionIndex.h>
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+
+#include <osmscout/log/Logger.h>
+
+#include <osmscout/util/StopClock.h>
+
+#include <osmscout/system/Math.h>
+
+namespace osmscout {
+
+  namespace {
+    /**
+     * Collects all admin regions of the location index in depth first order
+     */
+    class AdminRegionCollector : public AdminRegionVisitor
+    {
+    public:
+      std::vector<AdminRegionRef> regions;
+
+    public:
+      Action Visit(const AdminRegion& region) override
+      {
+        regions.push_back(std::make_shared<AdminRegion>(region));
+
+        return visitChildren;
+      }
+    };
+  }
+
+  /**
+   * @param gridSize
+   *    Number of rows and columns of the grid spanning the bounding box of all regions
+   */
+  AdminRegionIndex::AdminRegionIndex(size_t gridSize)
+  : gridSize(std::max(size_t(1),gridSize))
+  {
+    // no code
+  }
+
+  void AdminRegionIndex::Clear()
+  {
+    boundingBox.Invalidate();
+    cellWidth=0.0;
+    cellHeight=0.0;
+
+    regions.clear();
+    parents.clear();
+    cellOffsets.clear();
+    cellEntries.clear();
+    boundaryCells.clear();
+    edges.clear();
+  }
+
+  size_t AdminRegionIndex::GetColumn(double lon) const
+  {
+    double column=std::floor((lon-boundingBox.GetMinLon())/cellWidth);
+
+    if (column<0.0) {
+      return 0;
+    }
+
+    return std::min(gridSize-1,size_t(column));
+  }
+
+  size_t AdminRegionIndex::GetRow(double lat) const
+  {
+    double row=std::floor((lat-boundingBox.GetMinLat())/cellHeight);
+
+    if (row<0.0) {
+      return 0;
+    }
+
+    return std::min(gridSize-1,size_t(row));
+  }
+
+  /**
+   * Test the coordinate against the ring of the given cell entry.
+   *
+   * The same crossing rule as in IsCoordInArea() is used, casting a ray from the coordinate
+   * to the right. Every crossing is only counted in the cell (column) it is in, so that
+   * edges touching multiple cells of the row are not counted twice. All crossings right of
+   * the coordinate are in the cell of the coordinate or in a cell further right, so walking
+   * the boundary cells of the ring in the current row finds all of them.
+   */
+  bool AdminRegionIndex::IsInRing(const CellEntry& entry,
+                                  const GeoCoord& coord) const
+  {
+    if (entry.boundaryCell==entry.boundaryCellEnd) {
+      return true;
+    }
+
+    const double lat=coord.GetLat();
+    const double lon=coord.GetLon();
+    bool         inside=false;
+
+    for (uint32_t c=entry.boundaryCell; c<entry.boundaryCellEnd; c++) {
+      const BoundaryCell& cell=boundaryCells[c];
+
+      for (uint32_t e=cell.edgeOffset; e<cell.edgeOffset+cell.edgeCount; e++) {
+        const Edge& edge=edges[e];
+
+        if (c==entry.boundaryCell &&
+            ((edge.aLat==lat && edge.aLon==lon) ||
+             (edge.bLat==lat && edge.bLon==lon))) {
+          return true;
+        }
+
+        if ((edge.aLat<=lat && lat<edge.bLat) ||
+            (edge.bLat<=lat && lat<edge.aLat)) {
+          double crossing=(edge.bLon-edge.aLon)*(lat-edge.aLat)/(edge.bLat-edge.aLat)+edge.aLon;
+
+          // Rounding may move the crossing outside the cells the edge has been assigned to
+          crossing=std::clamp(crossing,
+                              std::min(edge.aLon,edge.bLon),
+                              std::max(edge.aLon,edge.bLon));
+
+          if (lon<crossing &&
+              GetColumn(crossing)==cell.column) {
+            inside=!inside;
+          }
+        }
+      }
+    }
+
+    return inside;
+  }
+
+  void AdminRegionIndex::AddRing(uint32_t region,
+                                 const std::vector<Edge>& ringEdges,
+                                 std::vector<std::vector<CellEntry>>& cells)
+  {
+    // (row, column, edge) for every cell touched by the bounding box of an edge
+    std::vector<std::tuple<size_t,size_t,size_t>> assignments;
+
+    for (size_t e=0; e<ringEdges.size(); e++) {
+      const Edge& edge=ringEdges[e];
+      size_t      minRow=GetRow(std::min(edge.aLat,edge.bLat));
+      size_t      maxRow=GetRow(std::max(edge.aLat,edge.bLat));
+      size_t      minColumn=GetColumn(std::min(edge.aLon,edge.bLon));
+      size_t      maxColumn=GetColumn(std::max(edge.aLon,edge.bLon));
+
+      for (size_t row=minRow; row<=maxRow; row++) {
+        for (size_t column=minColumn; column<=maxColumn; column++) {
+          assignments.emplace_back(row,column,e);
+        }
+      }
+    }
+
+    std::sort(assignments.begin(),assignments.end());
+
+    auto current=assignments.begin();
+
+    while (current!=assignments.end()) {
+      size_t   row=std::get<0>(*current);
+      uint32_t rowStart=uint32_t(boundaryCells.size());
+
+      // Boundary cells of the row
+      while (current!=assignments.end() &&
+             std::get<0>(*current)==row) {
+        size_t       column=std::get<1>(*current);
+        BoundaryCell cell;
+
+        cell.column=uint32_t(column);
+        cell.edgeOffset=uint32_t(edges.size());
+
+        while (current!=assignments.end() &&
+               std::get<0>(*current)==row &&
+               std::get<1>(*current)==column) {
+          edges.push_back(ringEdges[std::get<2>(*current)]);
+          ++current;
+        }
+
+        cell.edgeCount=uint32_t(edges.size()-cell.edgeOffset);
+        boundaryCells.push_back(cell);
+      }
+
+      uint32_t rowEnd=uint32_t(boundaryCells.size());
+
+      for (uint32_t c=rowStart; c<rowEnd; c++) {
+        size_t column=boundaryCells[c].column;
+
+        cells[row*gridSize+column].push_back(CellEntry{region,c,rowEnd});
+
+        // Cells between two boundary cells are either completely inside or outside
+        // of the ring, test the first one to find out
+        if (c+1<rowEnd &&
+            boundaryCells[c+1].column>column+1) {
+          GeoCoord  center(boundingBox.GetMinLat()+(double(row)+0.5)*cellHeight,
+                           boundingBox.GetMinLon()+(double(column+1)+0.5)*cellWidth);
+          CellEntry entry{region,c+1,rowEnd};
+
+          if (IsInRing(entry,center)) {
+            for (size_t inner=column+1; inner<boundaryCells[c+1].column; inner++) {
+              cells[row*gridSize+inner].push_back(CellEntry{region,rowEnd,rowEnd});
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Load all admin regions and their top outer rings from the database and build the
+   * index. On error the index is left empty.
+   *
+   * @param database
+   *    Database with a location index
+   * @return
+   *    True on success, else false
+   */
+  bool AdminRegionIndex::Build(const Database& database)
+  {
+    StopClock            timer;
+    LocationIndexRef     locationIndex=database.GetLocationIndex();
+    AdminRegionCollector collector;
+
+    Clear();
+
+    if (!locationIndex) {
+      return false;
+    }
+
+    if (!locationIndex->VisitAdminRegions(collector)) {
+      return false;
+    }
+
+    std::unordered_map<FileOffset,uint32_t>     regionIndex;
+    std::vector<std::vector<std::vector<Edge>>> regionRings(collector.regions.size());
+
+    regions=std::move(collector.regions);
+    parents.assign(regions.size(),NoParent);
+
+    for (size_t r=0; r<regions.size(); r++) {
+      regionIndex[regions[r]->regionOffset]=uint32_t(r);
+    }
+
+    for (size_t r=0; r<regions.size(); r++) {
+      const AdminRegion& region=*regions[r];
+
+      if (auto parent=regionIndex.find(region.parentRegionOffset);
+          parent!=regionIndex.end() &&
+          parent->second!=r) {
+        parents[r]=parent->second;
+      }
+
+      if (region.object.GetType()!=refArea) {
+        continue;
+      }
+
+      AreaRef area;
+
+      if (!database.GetAreaByOffset(region.object.GetFileOffset(),
+                                    area)) {
+        log.Error() << "Cannot load area of admin region '" << region.name << "'";
+        Clear();
+
+        return false;
+      }
+
+      for (const auto& ring : area->rings) {
+        if (!ring.IsTopOuter() ||
+            ring.nodes.empty()) {
+          continue;
+        }
+
+        std::vector<Edge>& ringEdges=regionRings[r].emplace_back();
+
+        // Same edge orientation as in IsCoordInArea(), to get identical crossings
+        for (size_t i=0, j=ring.nodes.size()-1; i<ring.nodes.size(); j=i++) {
+          ringEdges.push_back(Edge{ring.nodes[i].GetLat(),
+                                   ring.nodes[i].GetLon(),
+                                   ring.nodes[j].GetLat(),
+                                   ring.nodes[j].GetLon()});
+        }
+
+        boundingBox.Include(ring.GetBoundingBox());
+      }
+    }
+
+    // Regions without an area are never matched, so children refer to the nearest
+    // ancestor with an area. Parents are in front of their children and thus
+    // already resolved.
+    for (size_t r=0; r<regions.size(); r++) {
+      uint32_t parent=parents[r];
+
+      if (parent!=NoParent &&
+          regionRings[parent].empty()) {
+        parents[r]=parents[parent];
+      }
+    }
+
+    if (!boundingBox.IsValid()) {
+      cellOffsets.assign(gridSize*gridSize+1,0);
+
+      return true;
+    }
+
+    cellWidth=std::max(boundingBox.GetWidth()/double(gridSize),
+                       std::numeric_limits<double>::min());
+    cellHeight=std::max(boundingBox.GetHeight()/double(gridSize),
+                        std::numeric_limits<double>::min());
+
+    std::vector<std::vector<CellEntry>> cells(gridSize*gridSize);
+
+    // Every ring is tested on its own, a region contains the coordinate, if one of its
+    // rings does
+    for (size_t r=0; r<regions.size(); r++) {
+      for (const auto& ringEdges : regionRings[r]) {
+        AddRing(uint32_t(r),
+                ringEdges,
+                cells);
+      }
+
+      regionRings[r].clear();
+      regionRings[r].shrink_to_fit();
+    }
+
+    cellOffsets.reserve(cells.size()+1);
+
+    for (const auto& cell : cells) {
+      cellOffsets.push_back(uint32_t(cellEntries.size()));
+      cellEntries.insert(cellEntries.end(),cell.begin(),cell.end());
+    }
+
+    cellOffsets.push_back(uint32_t(cellEntries.size()));
+
+    timer.Stop();
+
+    log.Info() << "Admin region index: " << regions.size() << " regions, "
+               << cellEntries.size() << " cell entries, "
+               << edges.size() << " edges, built in " << timer.ResultString();
+
+    return true;
+  }
+
+  /**
+   * Return all regions containing the given coordinate. Like the traversal of the
+   * location index, a region is only returned, if its parent region contains the
+   * coordinate, too. Parents without an area are skipped in favour of their nearest
+   * ancestor with an area. Regions are returned top down in depth first order.
+   *
+   * @param coord
+   *    Coordinate to look up
+   * @param result
+   *    Regions containing the coordinate
+   */
+  void AdminRegionIndex::GetRegions(const GeoCoord& coord,
+                                    std::vector<AdminRegionRef>& result) const
+  {
+    result.clear();
+
+    if (!boundingBox.Includes(coord,false)) {
+      return;
+    }
+
+    size_t                cell=GetRow(coord.GetLat())*gridSize+GetColumn(coord.GetLon());
+    std::vector<uint32_t> matches;
+
+    for (uint32_t e=cellOffsets[cell]; e<cellOffsets[cell+1]; e++) {
+      if (IsInRing(cellEntries[e],coord)) {
+        matches.push_back(cellEntries[e].region);
+      }
+    }
+
+    // Parents are always in front of their children, regions with multiple rings
+    // may match more than once
+    std::sort(matches.begin(),matches.end());
+    matches.erase(std::unique(matches.begin(),matches.end()),
+                  matches.end());
+
+    std::vector<uint32_t> accepted;
+
+    for (uint32_t region : matches) {
+      if (parents[region]==NoParent ||
+          std::binary_search(accepted.begin(),accepted.end(),parents[region])) {
+        accepted.push_back(region);
+        result.push_back(regions[region]);
+      }
+    }
+  }
+}
@@ -21,11 +21,14 @@
 
 #include <algorithm>
 #include <deque>
+#include <future>
 #include <map>
 #include <set>
 
 #include <osmscout/FeatureReader.h>
 
+#include <osmscout/async/ThreadPool.h>
+
 #include <osmscout/feature/AddressFeature.h>
 #include <osmscout/feature/AdminLevelFeature.h>
 #include <osmscout/feature/NameFeature.h>
@@ -344,6 +347,31 @@ namespace osmscout {
     return locationIndex->VisitAdminRegions(visitor);
   }
 
+  /**
+   * Return the admin region index of the database, building it on first call.
+   *
+   * @return
+   *    The index or nullptr, if the index could not be built
+   */
+  AdminRegionIndexRef LocationDescriptionService::GetAdminRegionIndex() const
+  {
+    std::scoped_lock<std::mutex> lock(adminRegionIndexMutex);
+
+    if (!adminRegionIndex) {
+      AdminRegionIndexRef              index=std::make_shared<AdminRegionIndex>();
+      LocationIndex::ScopeCacheCleaner cacheCleaner(database->GetLocationIndex());
+
+      if (!index->Build(*database)) {
+        log.Error() << "Cannot build admin region index";
+        return nullptr;
+      }
+
+      adminRegionIndex=index;
+    }
+
+    return adminRegionIndex;
+  }
+
   void LocationDescriptionService::AddToCandidates(std::vector<LocationDescriptionCandicate>& candidates,
                                                    const GeoCoord& location,
                                                    const NodeRegionSearchResult& results,
@@ -743,36 +771,43 @@ namespace osmscout {
     return true;
   }
 
+  /**
+   * Return all admin regions containing the given coordinate, ordered by their offset
+   * in the location index. Uses the resident admin region index, which is built on the
+   * first call.
+   *
+   * @param coord
+   *    Coordinate to look up
+   * @param result
+   *    One entry for each region
+   * @return
+   *    True, if there was no error
+   */
   bool LocationDescriptionService::ReverseLookupRegion(const GeoCoord &coord,
                                                        std::list<ReverseLookupResult>& result) const
   {
     result.clear();
 
-    LocationIndexRef locationIndex=database->GetLocationIndex();
-    LocationIndex::ScopeCacheCleaner cacheCleaner(database->GetLocationIndex());
+    AdminRegionIndexRef index=GetAdminRegionIndex();
 
-    if (!locationIndex) {
+    if (!index) {
       return false;
     }
 
-    AdminRegionReverseLookupVisitor adminRegionVisitor(*database,
-                                                       *locationIndex,
-                                                       result,
-                                                       false,
-                                                       false,
-                                                       false);
-    AdminRegionReverseLookupVisitor::SearchEntry searchEntry;
+    std::vector<AdminRegionRef> regions;
 
-    searchEntry.coords.push_back(coord);
-    adminRegionVisitor.AddSearchEntry(searchEntry);
+    index->GetRegions(coord,
+                      regions);
 
-    if (!VisitAdminRegions(adminRegionVisitor)) {
-      return false;
-    }
+    std::sort(regions.begin(),regions.end(),[](const AdminRegionRef& a,
+                                               const AdminRegionRef& b) {
+      return a->regionOffset<b->regionOffset;
+    });
 
-    for (const auto &region:adminRegionVisitor.adminRegions){
+    for (const auto &region : regions) {
       ReverseLookupResult regionResult;
-      regionResult.adminRegion=region.second;
+
+      regionResult.adminRegion=region;
       result.push_back(regionResult);
     }
 
@@ -1509,6 +1544,60 @@ namespace osmscout {
                                       lookupDistance);
   }
 
+  /**
+   * Describe a batch of locations. The locations are distributed over the workers of
+   * the shared thread pool, so the method must not be called from a job of that pool.
+   *
+   * @param locations
+   *    Locations to describe
+   * @param descriptions
+   *    Descriptions, in the same order as the locations
+   * @return
+   *    True, if all locations could be described
+   */
+  bool LocationDescriptionService::DescribeLocations(const std::vector<GeoCoord>& locations,
+                                                     std::vector<LocationDescription>& descriptions,
+                                                     const Distance& lookupDistance,
+                                                     const double sizeFilter)
+  {
+    descriptions.clear();
+    descriptions.resize(locations.size());
+
+    if (locations.empty()) {
+      return true;
+    }
+
+    ThreadPoolRef                  threadPool=ThreadPool::GetShared();
+    size_t                         chunkCount=std::min(locations.size(),threadPool->GetThreadCount());
+    size_t                         chunkSize=(locations.size()+chunkCount-1)/chunkCount;
+    std::vector<std::future<bool>> results;
+
+    for (size_t start=0; start<locations.size(); start+=chunkSize) {
+      size_t end=std::min(locations.size(),start+chunkSize);
+
+      results.push_back(threadPool->Submit([this,&locations,&descriptions,&lookupDistance,sizeFilter,start,end]() {
+        for (size_t i=start; i<end; i++) {
+          if (!DescribeLocation(locations[i],
+                                descriptions[i],
+                                lookupDistance,
+                                sizeFilter)) {
+            return false;
+          }
+        }
+
+        return true;
+      }));
+    }
+
+    bool success=true;
+
+    for (auto& result : results) {
+      success=result.get() && success;
+    }
+
+    return success;
+  }
+
   bool LocationDescriptionService::DescribeLocationByHighwayMilestone(const GeoCoord& location,
                                                                        LocationDescription& description,
                                                                        const Distance& lookupDistance,
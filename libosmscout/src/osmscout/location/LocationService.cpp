@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <limits>
 
 #include <osmscout/log/Logger.h>
 #include <osmscout/util/String.h>
@@ -48,6 +49,8 @@ namespace osmscout {
 
     size_t                  limit;
 
+    LocationNGramIndexRef   nGramIndex;   //!< Optional index for restricting the candidates
+
     SearchParameter() = default;
   };
 
@@ -1155,6 +1158,59 @@ namespace osmscout {
     return patterns;
   }
 
+  /**
+   * Posting lists of addresses longer than this are not read, visiting the addresses of
+   * the location is cheaper
+   */
+  static constexpr size_t MaxAddressPostingSize=10000;
+
+  /**
+   * Return the offsets of all entries of the given section of the n-gram index, that may
+   * match one of the given patterns.
+   *
+   * Returns false, if the candidates cannot be restricted: there is no n-gram index, the string
+   * matcher normalizes strings in a way unknown to the index or the index cannot restrict
+   * the candidates of one of the patterns.
+   */
+  static bool GetNGramCandidates(const SearchParameter& parameter,
+                                 LocationNGramIndex::Section section,
+                                 const std::list<TokenStringRef>& patterns,
+                                 std::vector<FileOffset>& candidates,
+                                 size_t maxPostingSize=std::numeric_limits<size_t>::max())
+  {
+    candidates.clear();
+
+    if (!parameter.nGramIndex) {
+      return false;
+    }
+
+    if (dynamic_cast<const StringMatcherCIFactory*>(parameter.stringMatcherFactory.get())==nullptr &&
+        dynamic_cast<const StringMatcherTransliterateFactory*>(parameter.stringMatcherFactory.get())==nullptr) {
+      return false;
+    }
+
+    std::vector<FileOffset> patternCandidates;
+
+    for (const auto& pattern : patterns) {
+      if (!parameter.nGramIndex->GetCandidates(section,
+                                               pattern->text,
+                                               patternCandidates,
+                                               maxPostingSize)) {
+        candidates.clear();
+        return false;
+      }
+
+      candidates.insert(candidates.end(),
+                        patternCandidates.begin(),
+                        patternCandidates.end());
+    }
+
+    std::sort(candidates.begin(),candidates.end());
+    candidates.erase(std::unique(candidates.begin(),candidates.end()),candidates.end());
+
+    return true;
+  }
+
   static void AddRegionResult(const SearchParameter& parameter,
                               LocationSearchResult::MatchQuality regionMatchQuality,
                               const AdminRegionSearchVisitor::Result& regionMatch,
@@ -1312,6 +1368,20 @@ namespace osmscout {
 
     CleanupSearchPatterns(addressSearchPatterns);
 
+    std::vector<FileOffset> locationCandidates;
+
+    if (GetNGramCandidates(parameter,
+                           LocationNGramIndex::Section::addresses,
+                           addressSearchPatterns,
+                           locationCandidates,
+                           MaxAddressPostingSize) &&
+        !std::binary_search(locationCandidates.begin(),
+                            locationCandidates.end(),
+                            locationMatch.location->locationOffset)) {
+      osmscout::log.Debug() << "No address candidates for location '" << locationMatch.location->name << "'";
+      return true;
+    }
+
     AddressSearchVisitor addressVisitor(parameter.stringMatcherFactory,
                                         addressSearchPatterns);
 
@@ -1403,10 +1473,43 @@ namespace osmscout {
                                           locationSearchPatterns,
                                           breaker);
 
-    StopClock locationVisitTime;
+    StopClock               locationVisitTime;
+    std::vector<FileOffset> regionCandidates;
+
+    if (GetNGramCandidates(parameter,
+                           LocationNGramIndex::Section::locations,
+                           locationSearchPatterns,
+                           regionCandidates)) {
+      // Only visit the regions (below the matched region) holding candidate locations
+      for (const auto regionOffset : regionCandidates) {
+        if (!parameter.nGramIndex->IsInRegion(regionOffset,
+                                              regionMatch.adminRegion->regionOffset)) {
+          continue;
+        }
+
+        AdminRegion region;
 
-    if (!locationIndex->VisitLocations(*regionMatch.adminRegion,
-                                       locationVisitor)) {
+        if (regionOffset==regionMatch.adminRegion->regionOffset) {
+          region=*regionMatch.adminRegion;
+        }
+        else if (!locationIndex->GetAdminRegionByOffset(regionOffset,
+                                                        region)) {
+          return false;
+        }
+
+        if (!locationIndex->VisitLocations(region,
+                                           locationVisitor,
+                                           false)) {
+          return false;
+        }
+
+        if (breaker && breaker->IsAborted()) {
+          break;
+        }
+      }
+    }
+    else if (!locationIndex->VisitLocations(*regionMatch.adminRegion,
+                                            locationVisitor)) {
       return false;
     }
 
@@ -1882,6 +1985,7 @@ namespace osmscout {
     parameter.partialMatch=searchParameter.GetPartialMatch();
     parameter.stringMatcherFactory=searchParameter.GetStringMatcherFactory();
     parameter.limit=searchParameter.GetLimit();
+    parameter.nGramIndex=database->GetLocationNGramIndex();
 
     result.limitReached=false;
     result.results.clear();
@@ -2077,9 +2181,32 @@ namespace osmscout {
                                                 RegionMatch,
                                                 RegionPartialMatch);
 
-    StopClock adminRegionVisitTime;
+    StopClock               adminRegionVisitTime;
+    std::vector<FileOffset> regionCandidates;
 
-    locationIndex->VisitAdminRegions(adminRegionVisitor);
+    if (GetNGramCandidates(parameter,
+                           LocationNGramIndex::Section::regions,
+                           regionSearchPatterns,
+                           regionCandidates)) {
+      // Offsets are in the same (depth first) order as visited by the location index
+      for (const auto regionOffset : regionCandidates) {
+        AdminRegion region;
+
+        if (!locationIndex->GetAdminRegionByOffset(regionOffset,
+                                                   region)) {
+          return false;
+        }
+
+        if (adminRegionVisitor.Visit(region)==AdminRegionVisitor::stop) {
+          break;
+        }
+      }
+
+      osmscout::log.Debug() << "Admin region candidates: " << regionCandidates.size();
+    }
+    else {
+      locationIndex->VisitAdminRegions(adminRegionVisitor);
+    }
 
     adminRegionVisitTime.Stop();
 
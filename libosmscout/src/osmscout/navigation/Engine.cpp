@@ -19,6 +19,8 @@
 
 #include <osmscout/navigation/Engine.h>
 
+#include <iterator>
+
 namespace osmscout {
 
   NavigationMessage::NavigationMessage(const Timestamp& timestamp)
@@ -43,27 +45,24 @@ namespace osmscout {
 
   std::list<NavigationMessageRef> NavigationEngine::Process(const NavigationMessageRef& message) const
   {
-    std::list<NavigationMessageRef> messageQueue{message};
-    std::list<NavigationMessageRef> result;
-
-    while (!messageQueue.empty()) {
-      auto messageToProcess=messageQueue.front();
+    // Messages are appended to the queue while it is processed, so we walk it by index.
+    // All processed messages besides the initial one are part of the result.
+    std::vector<NavigationMessageRef> messageQueue{message};
 
-      messageQueue.pop_front();
+    for (size_t i=0; i<messageQueue.size(); i++) {
+      // copy, reference may get invalidated by insertion below
+      auto messageToProcess=messageQueue[i];
 
       for (const auto& agent : agents) {
         auto resultMessages=agent->Process(messageToProcess);
 
         messageQueue.insert(messageQueue.end(),
-                            resultMessages.begin(),
-                            resultMessages.end());
-
-        result.insert(result.end(),
-                      resultMessages.begin(),
-                      resultMessages.end());
+                            std::make_move_iterator(resultMessages.begin()),
+                            std::make_move_iterator(resultMessages.end()));
       }
     }
 
-    return result;
+    return std::list<NavigationMessageRef>(std::make_move_iterator(messageQueue.begin()+1),
+                                           std::make_move_iterator(messageQueue.end()));
   }
 }
@@ -24,6 +24,7 @@
 #include <osmscout/navigation/DataAgent.h>
 
 #include <chrono>
+#include <iterator>
 
 namespace osmscout {
 
@@ -206,6 +207,7 @@ namespace osmscout {
                routeUpdateMessage != nullptr) {
 
       route=routeUpdateMessage->routeDescription;
+      routeIndex=std::make_shared<RouteSegmentIndex>(*route);
       vehicle=routeUpdateMessage->vehicle;
       position.routeNode=route->Nodes().begin();
     } else if (dynamic_cast<TimeTickMessage*>(message.get())==nullptr) {
@@ -370,52 +372,34 @@ namespace osmscout {
      * of the projected point on the line, return false if there is no such point that is closer than snapDistanceInMeters
      * from the route.
      * The search start a the locationOnRoute node toward the end.
+     * The out parameters are only modified if a segment was found.
      */
   bool PositionAgent::SearchClosestSegment(const GeoCoord& location,
-                                           const std::list<RouteDescription::Node>::const_iterator& locationOnRoute,
+                                           const RouteDescription::NodeList::const_iterator& locationOnRoute,
                                            GeoCoord &closestPosition,
-                                           std::list<RouteDescription::Node>::const_iterator& foundNode,
+                                           RouteDescription::NodeList::const_iterator& foundNode,
                                            double& foundAbscissa,
                                            double& minDistance) const
   {
-    auto   nextNode=locationOnRoute;
-    double abscissa=0.0;
-    bool   found=false;
-    double qLon,qLat;
     double snapDistanceInDegrees = GetDistanceInLonDegrees(snapDistanceInMeters,
                                                            location.GetLat());
+    auto   fromSegment=static_cast<size_t>(std::distance(route->Nodes().cbegin(),locationOnRoute));
 
-    minDistance=std::numeric_limits<double>::max();
-    for (auto node=nextNode++; node!=route->Nodes().end(); node++) {
-      if (nextNode==route->Nodes().end()) {
-        break;
-      }
-      double d=DistanceToSegment(location.GetLon(),
-                                 location.GetLat(),
-                                 node->GetLocation().GetLon(),
-                                 node->GetLocation().GetLat(),
-                                 nextNode->GetLocation().GetLon(),
-                                 nextNode->GetLocation().GetLat(),
-                                 abscissa,
-                                 qLon,
-                                 qLat);
-      if (minDistance>=d) {
-        minDistance=d;
-        if (d<=snapDistanceInDegrees) {
-          foundNode    =node;
-          foundAbscissa=abscissa;
-          found        =true;
-          closestPosition.Set(qLat,qLon);
-        }
-      }
-      else if (found && d>minDistance*2) {
-        // Stop the search we have a good candidate
-        break;
-      }
-      nextNode++;
+    RouteSegmentIndex::SegmentMatch match;
+
+    if (!routeIndex->SearchClosestSegment(location,
+                                          fromSegment,
+                                          snapDistanceInDegrees,
+                                          match)) {
+      return false;
     }
 
-    return found;
+    foundNode=route->Nodes().cbegin()+match.segment;
+    foundAbscissa=match.abscissa;
+    minDistance=match.distance;
+    closestPosition=match.closestPoint;
+
+    return true;
   }
 
 }
@@ -20,12 +20,74 @@
 #include <osmscout/poi/POIService.h>
 
 #include <algorithm>
+#include <cmath>
 #include <future>
+#include <queue>
+#include <set>
 
 #include <osmscout/log/Logger.h>
 
+#include <osmscout/util/Exception.h>
+#include <osmscout/util/Geometry.h>
+
 namespace osmscout {
 
+  namespace {
+    /**
+     * Radius of the first ring searched by POIService::GetNearestPOIs()
+     */
+    const Distance InitialSearchRadius=Distance::Of<Meter>(250.0);
+
+    /**
+     * Return a bounding box containing all points with the given maximum distance to the
+     * location. In contrast to GeoBox::BoxByCenterAndRadius() the edges of the box (and
+     * not its corners) have the given distance.
+     *
+     * The smallest radius of curvature of the WGS-84 ellipsoid (the meridional radius at the
+     * equator) is used to convert the distance into an angle, so every point within the
+     * distance on the ellipsoid is within that angle on the sphere. The widest longitude of the
+     * resulting spherical cap is not at the latitude of the location but at
+     * asin(sin(angle)/cos(lat)). If the cap includes a pole, it covers all longitudes.
+     */
+    GeoBox GetBoxAroundLocation(const GeoCoord& location,
+                                const Distance& radius)
+    {
+      const double a=6378137.0;
+      const double b=6356752.3142;
+      double       angle=radius.AsMeter()/(b*b/a);
+      double       lat=DegToRad(location.GetLat());
+      double       topLat=location.GetLat()+RadToDeg(angle);
+      double       bottomLat=location.GetLat()-RadToDeg(angle);
+      double       leftLon=-180.0;
+      double       rightLon=180.0;
+
+      if (topLat<90.0 &&
+          bottomLat>-90.0) {
+        double lonDelta=RadToDeg(std::asin(std::sin(angle)/std::cos(lat)));
+
+        leftLon=std::max(location.GetLon()-lonDelta,-180.0);
+        rightLon=std::min(location.GetLon()+lonDelta,180.0);
+      }
+
+      return GeoBox(GeoCoord(std::max(bottomLat,-90.0),leftLon),
+                    GeoCoord(std::min(topLat,90.0),rightLon));
+    }
+
+    /**
+     * Split the part of the outer box, that is not covered by the inner box, into four stripes
+     */
+    std::vector<GeoBox> GetRing(const GeoBox& inner,
+                                const GeoBox& outer)
+    {
+      return {
+        GeoBox(GeoCoord(inner.GetMaxLat(),outer.GetMinLon()),outer.GetMaxCoord()),
+        GeoBox(outer.GetMinCoord(),GeoCoord(inner.GetMinLat(),outer.GetMaxLon())),
+        GeoBox(GeoCoord(inner.GetMinLat(),outer.GetMinLon()),GeoCoord(inner.GetMaxLat(),inner.GetMinLon())),
+        GeoBox(GeoCoord(inner.GetMinLat(),inner.GetMaxLon()),GeoCoord(inner.GetMaxLat(),outer.GetMaxLon()))
+      };
+    }
+  }
+
   POIService::POIService(const DatabaseRef& database)
   : database(database)
   {
@@ -63,20 +125,17 @@ namespace osmscout {
     areas.clear();
     ways.clear();
 
-    auto nodeResult=std::async(std::launch::async,
-                               &Database::LoadNodesInArea,database,
-                               std::ref(nodeTypes),
-                               std::ref(boundingBox));
+    auto nodeResult=std::async(std::launch::async,[this,&nodeTypes,&boundingBox]() {
+      return database->LoadNodesInArea(nodeTypes,boundingBox);
+    });
 
-    auto wayResult=std::async(std::launch::async,
-                              &Database::LoadWaysInArea,database,
-                              std::ref(wayTypes),
-                              std::ref(boundingBox));
+    auto wayResult=std::async(std::launch::async,[this,&wayTypes,&boundingBox]() {
+      return database->LoadWaysInArea(wayTypes,boundingBox);
+    });
 
-    auto areaResult=std::async(std::launch::async,
-                               &Database::LoadAreasInArea,database,
-                               std::ref(areaTypes),
-                               std::ref(boundingBox));
+    auto areaResult=std::async(std::launch::async,[this,&areaTypes,&boundingBox]() {
+      return database->LoadAreasInArea(areaTypes,boundingBox);
+    });
 
     auto nodeResultData=nodeResult.get();
 
@@ -179,4 +238,131 @@ namespace osmscout {
       areas.push_back(entry.GetArea());
     }
   }
+
+  /**
+   * Returns the given number of objects of the given types closest to the given location.
+   *
+   * The search starts with a small box around the location and then grows ring by ring,
+   * doubling the radius each time. Every ring only queries the area, node and way indexes
+   * for the part not searched before. After a ring all objects closer than its radius
+   * are known, so the search stops as soon as the requested number of objects is found
+   * within the searched radius.
+   *
+   * @param location
+   *    Location to measure the distance from
+   * @param types
+   *    Types of the nodes, ways and areas to return
+   * @param count
+   *    Maximum number of objects to return
+   * @param maxDistance
+   *    Maximum distance of an object to the location
+   * @return
+   *    Up to count objects, ordered by increasing distance
+   * @exception
+   *    OSMScoutException in case of errors
+   */
+  std::vector<NearestPOIResult> POIService::GetNearestPOIs(const GeoCoord& location,
+                                                           const TypeInfoSet& types,
+                                                           size_t count,
+                                                           const Distance& maxDistance) const
+  {
+    std::vector<NearestPOIResult> candidates;
+
+    if (count==0) {
+      return candidates;
+    }
+
+    GeoBox databaseBox;
+
+    if (!database->GetBoundingBox(databaseBox)) {
+      throw UninitializedException("BoundingBoxDataFile");
+    }
+
+    std::priority_queue<Distance> nearest; // Distances of the closest candidates, farthest on top
+    std::set<ObjectFileRef>       visited;
+    GeoBox                        searched;
+    Distance                      radius=std::min(InitialSearchRadius,maxDistance);
+
+    auto addCandidate=[&](const ObjectFileRef& object,
+                          NearestPOIResult&& candidate) {
+      if (candidate.distance>maxDistance ||
+          !visited.insert(object).second) {
+        return;
+      }
+
+      if (nearest.size()<count) {
+        nearest.push(candidate.distance);
+      }
+      else if (candidate.distance<nearest.top()) {
+        nearest.pop();
+        nearest.push(candidate.distance);
+      }
+
+      candidates.push_back(std::move(candidate));
+    };
+
+    while (true) {
+      GeoBox              box=GetBoxAroundLocation(location,radius);
+      std::vector<GeoBox> boxes=searched.IsValid() ? GetRing(searched,box) : std::vector<GeoBox>{box};
+
+      // Rings are small and fast to load, so loading them in parallel does not pay off
+      for (const auto& ringBox : boxes) {
+        for (const auto& entry : database->LoadNodesInArea(types,ringBox,location).GetNodeResults()) {
+          NearestPOIResult candidate;
+
+          candidate.node=entry.GetNode();
+          candidate.distance=entry.GetDistance();
+          candidate.closestPoint=candidate.node->GetCoords();
+
+          addCandidate(candidate.node->GetObjectFileRef(),
+                       std::move(candidate));
+        }
+
+        for (const auto& entry : database->LoadWaysInArea(types,ringBox,location).GetWayResults()) {
+          NearestPOIResult candidate;
+
+          candidate.way=entry.GetWay();
+          candidate.distance=entry.GetDistance();
+          candidate.closestPoint=entry.GetClosestPoint();
+
+          addCandidate(candidate.way->GetObjectFileRef(),
+                       std::move(candidate));
+        }
+
+        for (const auto& entry : database->LoadAreasInArea(types,ringBox,location).GetAreaResults()) {
+          NearestPOIResult candidate;
+
+          candidate.area=entry.GetArea();
+          candidate.distance=entry.GetDistance();
+          candidate.closestPoint=entry.IsInArea() ? location : entry.GetClosestPoint();
+
+          addCandidate(candidate.area->GetObjectFileRef(),
+                       std::move(candidate));
+        }
+      }
+
+      searched=box;
+
+      // All objects closer than the radius are known now
+      if ((nearest.size()==count && nearest.top()<=radius) ||
+          radius>=maxDistance ||
+          (box.Includes(databaseBox.GetMinCoord(),false) &&
+           box.Includes(databaseBox.GetMaxCoord(),false))) {
+        break;
+      }
+
+      radius=std::min(radius*2.0,maxDistance);
+    }
+
+    std::stable_sort(candidates.begin(),candidates.end(),[](const NearestPOIResult& a,
+                                                            const NearestPOIResult& b) {
+      return a.distance<b.distance;
+    });
+
+    if (candidates.size()>count) {
+      candidates.resize(count);
+    }
+
+    return candidates;
+  }
 }
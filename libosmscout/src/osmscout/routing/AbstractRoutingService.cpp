@@ -1754,6 +1754,8 @@ namespace osmscout {
       return RouteDescriptionResult(description);
     }
 
+    description->Nodes().reserve(data.Entries().size());
+
     for (const auto& entry : data.Entries()) {
       description->AddNode(entry.GetDatabaseId(),
                            entry.GetCurrentNodeIndex(),
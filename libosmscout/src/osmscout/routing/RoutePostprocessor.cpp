@@ -22,6 +22,7 @@
 #include <osmscout/system/Math.h>
 
 #include <osmscout/util/Geometry.h>
+#include <osmscout/util/StopClock.h>
 #include <osmscout/log/Logger.h>
 
 #include <osmscout/location/LocationDescriptionService.h>
@@ -129,158 +130,232 @@ namespace osmscout {
     return true;
   }
 
-  bool RoutePostprocessor::DistanceAndTimePostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                                 RouteDescription& description)
+  void RoutePostprocessor::NodePostprocessor::Begin(const PostprocessorContext& /*context*/,
+                                                    RouteDescription& /*description*/)
   {
-    ObjectFileRef prevObject;
-    GeoCoord      prevCoord(0.0,0.0);
+    // no code
+  }
 
-    ObjectFileRef curObject;
-    GeoCoord      curCoord(0.0,0.0);
+  bool RoutePostprocessor::NodePostprocessor::Process(const PostprocessorContext& context,
+                                                      RouteDescription& description)
+  {
+    Begin(context,
+          description);
+
+    for (auto& node : description.Nodes()) {
+      if (!ProcessNode(context,node)) {
+        return false;
+      }
+    }
 
-    AreaRef       area;
-    WayRef        way;
+    return true;
+  }
 
-    Distance      distance;
-    Duration      time(0);
+  RoutePostprocessor::FusedPostprocessor::FusedPostprocessor(const std::vector<NodePostprocessorRef>& processors)
+  : processors(processors)
+  {
+    // no code
+  }
+
+  bool RoutePostprocessor::FusedPostprocessor::Process(const PostprocessorContext& context,
+                                                       RouteDescription& description)
+  {
+    for (const auto& processor : processors) {
+      processor->Begin(context,
+                       description);
+    }
 
     for (auto& node : description.Nodes()) {
-      // The last node does not have a pathWayId set, since we are not going anywhere!
-      if (node.HasPathObject()) {
-        // Only load the next way, if it is different from the old one
-        curObject=node.GetPathObject();
+      for (const auto& processor : processors) {
+        if (!processor->ProcessNode(context,node)) {
+          return false;
+        }
+      }
+    }
 
-        if (curObject!=prevObject) {
-          switch (node.GetPathObject().GetType()) {
-          case refNone:
-          case refNode:
-            assert(false);
-            break;
-          case refArea:
-            area=postprocessor.GetArea(node.GetDBFileOffset());
-            break;
-          case refWay:
-            way=postprocessor.GetWay(node.GetDBFileOffset());
-            break;
-          }
+    return true;
+  }
+
+  bool RoutePostprocessor::FusedPostprocessor::ProcessTimed(const PostprocessorContext& context,
+                                                            RouteDescription& description,
+                                                            std::vector<std::chrono::steady_clock::duration>& processorTimes)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    processorTimes.assign(processors.size(),Clock::duration::zero());
+
+    for (size_t i=0; i<processors.size(); i++) {
+      auto start=Clock::now();
+
+      processors[i]->Begin(context,
+                           description);
+
+      processorTimes[i]+=Clock::now()-start;
+    }
+
+    for (auto& node : description.Nodes()) {
+      for (size_t i=0; i<processors.size(); i++) {
+        auto start=Clock::now();
+        bool success=processors[i]->ProcessNode(context,node);
+
+        processorTimes[i]+=Clock::now()-start;
+
+        if (!success) {
+          return false;
         }
+      }
+    }
+
+    return true;
+  }
 
+  void RoutePostprocessor::DistanceAndTimePostprocessor::Begin(const PostprocessorContext& /*context*/,
+                                                               RouteDescription& /*description*/)
+  {
+    prevObject.Invalidate();
+    prevCoord.Set(0.0,0.0);
+    curObject.Invalidate();
+    curCoord.Set(0.0,0.0);
+    area.reset();
+    way.reset();
+    distance=Distance();
+    time=Duration(0);
+  }
+
+  bool RoutePostprocessor::DistanceAndTimePostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                                     RouteDescription::Node& node)
+  {
+    // The last node does not have a pathWayId set, since we are not going anywhere!
+    if (node.HasPathObject()) {
+      // Only load the next way, if it is different from the old one
+      curObject=node.GetPathObject();
+
+      if (curObject!=prevObject) {
         switch (node.GetPathObject().GetType()) {
         case refNone:
         case refNode:
           assert(false);
           break;
         case refArea:
-          curCoord=area->rings.front().GetCoord(node.GetCurrentNodeIndex());
+          area=postprocessor.GetArea(node.GetDBFileOffset());
           break;
         case refWay:
-          curCoord=way->GetCoord(node.GetCurrentNodeIndex());
+          way=postprocessor.GetWay(node.GetDBFileOffset());
+          break;
         }
+      }
 
-        // There is no delta for the first route node
-        if (prevObject.Valid()) {
-          Distance deltaDistance=GetEllipsoidalDistance(prevCoord,
-                                                        curCoord);
+      switch (node.GetPathObject().GetType()) {
+      case refNone:
+      case refNode:
+        assert(false);
+        break;
+      case refArea:
+        curCoord=area->rings.front().GetCoord(node.GetCurrentNodeIndex());
+        break;
+      case refWay:
+        curCoord=way->GetCoord(node.GetCurrentNodeIndex());
+      }
 
-          Duration deltaTime(0);
+      // There is no delta for the first route node
+      if (prevObject.Valid()) {
+        Distance deltaDistance=GetEllipsoidalDistance(prevCoord,
+                                                      curCoord);
 
-          if (node.GetPathObject().GetType()==refArea) {
-            deltaTime=postprocessor.GetTime(node.GetDatabaseId(),
-                                            *area,
-                                            deltaDistance);
-          }
-          else if (node.GetPathObject().GetType()==refWay) {
-            deltaTime=postprocessor.GetTime(node.GetDatabaseId(),
-                                            *way,
-                                            deltaDistance);
-          }
+        Duration deltaTime(0);
 
-          distance+=deltaDistance;
-          time+=deltaTime;
+        if (node.GetPathObject().GetType()==refArea) {
+          deltaTime=postprocessor.GetTime(node.GetDatabaseId(),
+                                          *area,
+                                          deltaDistance);
+        }
+        else if (node.GetPathObject().GetType()==refWay) {
+          deltaTime=postprocessor.GetTime(node.GetDatabaseId(),
+                                          *way,
+                                          deltaDistance);
         }
+
+        distance+=deltaDistance;
+        time+=deltaTime;
       }
+    }
 
-      node.SetDistance(distance);
-      node.SetTime(time);
-      node.SetLocation(curCoord);
+    node.SetDistance(distance);
+    node.SetTime(time);
+    node.SetLocation(curCoord);
 
-      prevObject=curObject;
-      prevCoord=curCoord;
-    }
+    prevObject=curObject;
+    prevCoord=curCoord;
 
     return true;
   }
 
-  bool RoutePostprocessor::WayNamePostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                         RouteDescription& description)
+  void RoutePostprocessor::WayNamePostprocessor::Begin(const PostprocessorContext& /*context*/,
+                                                       RouteDescription& /*description*/)
+  {
+    lastNameDesc.reset();
+  }
+
+  bool RoutePostprocessor::WayNamePostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                             RouteDescription::Node& node)
   {
     //
     // Store the name of each way
     //
 
-    for (auto node=description.Nodes().begin();
-         node!=description.Nodes().end();
-         ++node) {
-      // The last node does not have a pathWayId set, since we are not going anywhere from the target node!
-      if (!node->HasPathObject()) {
-        break;
-      }
-
-      if (node->GetPathObject().GetType()==refArea) {
-        RouteDescription::NameDescriptionRef nameDesc=postprocessor.GetNameDescription(*node);
-
-        node->AddDescription(nameDesc);
-      }
-      else if (node->GetPathObject().GetType()==refWay) {
-        WayRef                               way=postprocessor.GetWay(node->GetDBFileOffset());
-        RouteDescription::NameDescriptionRef nameDesc=postprocessor.GetNameDescription(node->GetDatabaseId(),*way);
+    // The last node does not have a pathWayId set, since we are not going anywhere from the target node!
+    if (!node.HasPathObject()) {
+      lastNameDesc.reset();
+      return true;
+    }
 
-        if (postprocessor.IsBridge(*node) &&
-            node!=description.Nodes().begin()) {
-          auto lastNode=node;
+    RouteDescription::NameDescriptionRef nameDesc;
 
-          lastNode--;
-          RouteDescription::NameDescriptionRef lastDesc=lastNode->GetDescription<RouteDescription::NameDescription>();
+    if (node.GetPathObject().GetType()==refArea) {
+      nameDesc=postprocessor.GetNameDescription(node);
+    }
+    else if (node.GetPathObject().GetType()==refWay) {
+      WayRef way=postprocessor.GetWay(node.GetDBFileOffset());
 
-          if (lastDesc &&
-              lastDesc->GetRef()==nameDesc->GetRef() &&
-              lastDesc->GetName()!=nameDesc->GetName()) {
-            nameDesc=std::move(lastDesc);
-          }
-        }
+      nameDesc=postprocessor.GetNameDescription(node.GetDatabaseId(),*way);
 
-        node->AddDescription(nameDesc);
+      if (postprocessor.IsBridge(node) &&
+          lastNameDesc &&
+          lastNameDesc->GetRef()==nameDesc->GetRef() &&
+          lastNameDesc->GetName()!=nameDesc->GetName()) {
+        nameDesc=lastNameDesc;
       }
     }
+    else {
+      lastNameDesc.reset();
+      return true;
+    }
+
+    node.AddDescription(nameDesc);
+    lastNameDesc=nameDesc;
 
     return true;
   }
 
-  bool RoutePostprocessor::WayTypePostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                         RouteDescription& description)
+  bool RoutePostprocessor::WayTypePostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                             RouteDescription::Node& node)
   {
-    //
-    // Store the name of each way
-    //
-
-    for (auto& node : description.Nodes()) {
-      // The last node does not have a pathWayId set, since we are not going anywhere from the target node!
-      if (!node.HasPathObject()) {
-        break;
-      }
+    // The last node does not have a pathWayId set, since we are not going anywhere from the target node!
+    if (!node.HasPathObject()) {
+      return true;
+    }
 
-      if (node.GetPathObject().GetType()==refArea) {
-        AreaRef                                  area=postprocessor.GetArea(node.GetDBFileOffset());
-        RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(area->GetType()->GetName());
+    if (node.GetPathObject().GetType()==refArea) {
+      AreaRef                                  area=postprocessor.GetArea(node.GetDBFileOffset());
+      RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(area->GetType()->GetName());
 
-        node.AddDescription(typeNameDesc);
-      }
-      else if (node.GetPathObject().GetType()==refWay) {
-        WayRef                                   way=postprocessor.GetWay(node.GetDBFileOffset());
-        RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(way->GetType()->GetName());
+      node.AddDescription(typeNameDesc);
+    }
+    else if (node.GetPathObject().GetType()==refWay) {
+      WayRef                                   way=postprocessor.GetWay(node.GetDBFileOffset());
+      RouteDescription::TypeNameDescriptionRef typeNameDesc=std::make_shared<RouteDescription::TypeNameDescription>(way->GetType()->GetName());
 
-        node.AddDescription(typeNameDesc);
-      }
+      node.AddDescription(typeNameDesc);
     }
 
     return true;
@@ -427,7 +502,7 @@ namespace osmscout {
   bool RoutePostprocessor::DirectionPostprocessor::Process(const PostprocessorContext& postprocessor,
                                                            RouteDescription& description)
   {
-    std::list<RouteDescription::Node>::const_iterator prevNode=description.Nodes().end();
+    RouteDescription::NodeList::const_iterator prevNode=description.Nodes().end();
     for (auto node=description.Nodes().begin();
          node!=description.Nodes().end();
          prevNode=node++) {
@@ -517,22 +592,20 @@ namespace osmscout {
     return true;
   }
 
-  bool RoutePostprocessor::MotorwayJunctionPostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                                  RouteDescription& description)
+  bool RoutePostprocessor::MotorwayJunctionPostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                                      RouteDescription::Node& node)
   {
-     for (auto& node: description.Nodes()) {
-       const DatabaseId dbId=node.GetDatabaseId();
+    const DatabaseId dbId=node.GetDatabaseId();
 
-       if (const NodeRef n=postprocessor.GetJunctionNode(node); n){
-         RouteDescription::NameDescriptionRef nameDescription = postprocessor.GetNameDescription(dbId, *n);
+    if (const NodeRef n=postprocessor.GetJunctionNode(node); n){
+      RouteDescription::NameDescriptionRef nameDescription = postprocessor.GetNameDescription(dbId, *n);
 
-         if (!nameDescription->GetName().empty() || !nameDescription->GetRef().empty()) {
-           node.AddDescription(std::make_shared<RouteDescription::MotorwayJunctionDescription>(nameDescription));
-         }
-       }
-     }
+      if (!nameDescription->GetName().empty() || !nameDescription->GetRef().empty()) {
+        node.AddDescription(std::make_shared<RouteDescription::MotorwayJunctionDescription>(nameDescription));
+      }
+    }
 
-     return true;
+    return true;
   }
 
   bool RoutePostprocessor::DestinationPostprocessor::Process(const PostprocessorContext& postprocessor,
@@ -574,34 +647,33 @@ namespace osmscout {
     return true;
   }
 
-  bool RoutePostprocessor::MaxSpeedPostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                          RouteDescription& description)
+  void RoutePostprocessor::MaxSpeedPostprocessor::Begin(const PostprocessorContext& /*context*/,
+                                                        RouteDescription& /*description*/)
   {
-    ObjectFileRef              prevObject;
-    DatabaseId                 prevDb=0;
-    ObjectFileRef              curObject;
-    DatabaseId                 curDb;
-
-    uint8_t                    speed=0;
-
-    for (auto& node : description.Nodes()) {
-      // The last node does not have a pathWayId set, since we are not going anywhere!
-      if (node.HasPathObject()) {
-        // Only load the next way, if it is different from the old one
-        curObject=node.GetPathObject();
-        curDb=node.GetDatabaseId();
+    prevObject.Invalidate();
+    prevDb=0;
+    speed=0;
+  }
 
-        if (curObject!=prevObject || curDb!=prevDb) {
-          speed=postprocessor.GetMaxSpeed(node);
-        }
+  bool RoutePostprocessor::MaxSpeedPostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                              RouteDescription::Node& node)
+  {
+    // The last node does not have a pathWayId set, since we are not going anywhere!
+    if (node.HasPathObject()) {
+      // Only load the next way, if it is different from the old one
+      ObjectFileRef curObject=node.GetPathObject();
+      DatabaseId    curDb=node.GetDatabaseId();
 
-        if (speed!=0) {
-          node.AddDescription(std::make_shared<RouteDescription::MaxSpeedDescription>(speed));
-        }
+      if (curObject!=prevObject || curDb!=prevDb) {
+        speed=postprocessor.GetMaxSpeed(node);
+      }
 
-        prevObject=curObject;
-        prevDb=curDb;
+      if (speed!=0) {
+        node.AddDescription(std::make_shared<RouteDescription::MaxSpeedDescription>(speed));
       }
+
+      prevObject=curObject;
+      prevDb=curDb;
     }
 
     return true;
@@ -767,9 +839,9 @@ namespace osmscout {
 
   void RoutePostprocessor::InstructionPostprocessor::HandleMotorwayLink(const PostprocessorContext& postprocessor,
                                                                         const RouteDescription::NameDescriptionRef &originName,
-                                                                        const std::list<RouteDescription::Node>::const_iterator &lastNode,
-                                                                        const std::list<RouteDescription::Node>::iterator &node,
-                                                                        const std::list<RouteDescription::Node>::const_iterator &end)
+                                                                        const RouteDescription::NodeList::const_iterator &lastNode,
+                                                                        const RouteDescription::NodeList::iterator &node,
+                                                                        const RouteDescription::NodeList::const_iterator &end)
   {
     bool                                 originIsMotorway=postprocessor.IsMotorway(*lastNode);
     bool                                 targetIsMotorway=false;
@@ -901,9 +973,9 @@ namespace osmscout {
     return RouteDescription::DirectionDescription::straightOn;
   }
 
-  bool RoutePostprocessor::InstructionPostprocessor::HandleNameChange(std::list<RouteDescription::Node>::const_iterator& lastNode,
-                                                                      std::list<RouteDescription::Node>::iterator& node,
-                                                                      const std::list<RouteDescription::Node>::const_iterator &end)
+  bool RoutePostprocessor::InstructionPostprocessor::HandleNameChange(RouteDescription::NodeList::const_iterator& lastNode,
+                                                                      RouteDescription::NodeList::iterator& node,
+                                                                      const RouteDescription::NodeList::const_iterator &end)
   {
     RouteDescription::NameDescriptionRef nextName;
     RouteDescription::NameDescriptionRef lastName;
@@ -926,14 +998,14 @@ namespace osmscout {
   }
 
   bool RoutePostprocessor::InstructionPostprocessor::HandleDirectionChange(const PostprocessorContext& postprocessor,
-                                                                           const std::list<RouteDescription::Node>::iterator& node,
-                                                                           const std::list<RouteDescription::Node>::const_iterator& end)
+                                                                           const RouteDescription::NodeList::iterator& node,
+                                                                           const RouteDescription::NodeList::const_iterator& end)
   {
     if (node->GetObjects().size()<=1){
       return false;
     }
 
-    std::list<RouteDescription::Node>::const_iterator lastNode=node;
+    RouteDescription::NodeList::const_iterator lastNode=node;
     RouteDescription::NameDescriptionRef              nextName;
     RouteDescription::NameDescriptionRef              lastName;
 
@@ -1004,8 +1076,8 @@ namespace osmscout {
     // Analyze crossing
     //
 
-    std::list<RouteDescription::Node>::iterator       node=description.Nodes().begin();
-    std::list<RouteDescription::Node>::const_iterator lastNode=description.Nodes().end();
+    RouteDescription::NodeList::iterator       node=description.Nodes().begin();
+    RouteDescription::NodeList::const_iterator lastNode=description.Nodes().end();
     while (node!=description.Nodes().end()) {
       RouteDescription::NameDescriptionRef originName;
       RouteDescription::NameDescriptionRef targetName;
@@ -1282,7 +1354,7 @@ namespace osmscout {
     }
   };
 
-  std::set<ObjectFileRef> RoutePostprocessor::POIsPostprocessor::CollectPaths(const std::list<RouteDescription::Node>& nodes) const
+  std::set<ObjectFileRef> RoutePostprocessor::POIsPostprocessor::CollectPaths(const RouteDescription::NodeList& nodes) const
   {
     ObjectFileRef           prevObject;
     ObjectFileRef           curObject;
@@ -1304,7 +1376,7 @@ namespace osmscout {
   }
 
   std::list<WayRef> RoutePostprocessor::POIsPostprocessor::CollectWays(const PostprocessorContext& postprocessor,
-                                                                       const std::list<RouteDescription::Node>& nodes) const
+                                                                       const RouteDescription::NodeList& nodes) const
   {
     ObjectFileRef     prevObject;
     ObjectFileRef     curObject;
@@ -1328,7 +1400,7 @@ namespace osmscout {
   }
 
   std::list<AreaRef> RoutePostprocessor::POIsPostprocessor::CollectAreas(const PostprocessorContext& postprocessor,
-                                                                         const std::list<RouteDescription::Node>& nodes) const
+                                                                         const RouteDescription::NodeList& nodes) const
   {
     ObjectFileRef      prevObject;
     ObjectFileRef      curObject;
@@ -1410,7 +1482,7 @@ namespace osmscout {
   std::map<ObjectFileRef,RoutePostprocessor::POIsPostprocessor::POIAtRoute>
     RoutePostprocessor::POIsPostprocessor::AnalysePOICandidates(const PostprocessorContext& postprocessor,
                                                                 const DatabaseId& databaseId,
-                                                                std::list<RouteDescription::Node>& nodes,
+                                                                RouteDescription::NodeList& nodes,
                                                                 const TypeInfoSet& nodeTypes,
                                                                 const TypeInfoSet& areaTypes,
                                                                 const std::unordered_map<FileOffset,NodeRef>& nodeMap,
@@ -1620,33 +1692,32 @@ namespace osmscout {
     return true;
   }
 
-  bool RoutePostprocessor::LanesPostprocessor::Process(const PostprocessorContext& postprocessor,
-                                                       RouteDescription& description)
+  void RoutePostprocessor::LanesPostprocessor::Begin(const PostprocessorContext& /*context*/,
+                                                     RouteDescription& /*description*/)
   {
-    ObjectFileRef              prevObject;
-    DatabaseId                 prevDb=0;
-    ObjectFileRef              curObject;
-    DatabaseId                 curDb;
-
-    RouteDescription::LaneDescriptionRef lanes;
-
-    for (auto& node : description.Nodes()) {
-      // The last node does not have a pathWayId set, since we are not going anywhere!
-      if (node.HasPathObject()) {
-        // Only load the next way, if it is different from the old one
-        curObject=node.GetPathObject();
-        curDb=node.GetDatabaseId();
+    prevObject.Invalidate();
+    prevDb=0;
+    lanes.reset();
+  }
 
-        if (curObject!=prevObject || curDb!=prevDb) {
-          lanes=postprocessor.GetLanes(node);
-        }
-        if (lanes) {
-          node.AddDescription(lanes);
-        }
+  bool RoutePostprocessor::LanesPostprocessor::ProcessNode(const PostprocessorContext& postprocessor,
+                                                           RouteDescription::Node& node)
+  {
+    // The last node does not have a pathWayId set, since we are not going anywhere!
+    if (node.HasPathObject()) {
+      // Only load the next way, if it is different from the old one
+      ObjectFileRef curObject=node.GetPathObject();
+      DatabaseId    curDb=node.GetDatabaseId();
 
-        prevObject=curObject;
-        prevDb=curDb;
+      if (curObject!=prevObject || curDb!=prevDb) {
+        lanes=postprocessor.GetLanes(node);
+      }
+      if (lanes) {
+        node.AddDescription(lanes);
       }
+
+      prevObject=curObject;
+      prevDb=curDb;
     }
 
     return true;
@@ -2935,16 +3006,77 @@ namespace osmscout {
       }
     }
 
-    size_t pos=1;
+    timings.clear();
+
+    // Consecutive node postprocessors are fused into a single pass over the route
+    std::list<std::pair<size_t,PostprocessorRef>> steps;
+    std::vector<NodePostprocessorRef>             nodeProcessors;
+    size_t                                        pos=1;
+
+    auto flushNodeProcessors=[&]() {
+      if (nodeProcessors.size()==1) {
+        steps.emplace_back(1,nodeProcessors.front());
+      }
+      else if (nodeProcessors.size()>1) {
+        steps.emplace_back(nodeProcessors.size(),std::make_shared<FusedPostprocessor>(nodeProcessors));
+      }
+      nodeProcessors.clear();
+    };
+
     for (const auto& processor : processors) {
-      if (!processor->Process(*this,description)) {
+      if (auto nodeProcessor=std::dynamic_pointer_cast<NodePostprocessor>(processor); nodeProcessor) {
+        nodeProcessors.push_back(nodeProcessor);
+      }
+      else {
+        flushNodeProcessors();
+        steps.emplace_back(1,processor);
+      }
+    }
+
+    flushNodeProcessors();
+
+    for (const auto& [count,processor] : steps) {
+      StopClock                                        processorTime;
+      std::vector<std::chrono::steady_clock::duration> fusedTimes;
+      bool                                             success;
+
+      if (collectTimings && count>1) {
+        success=std::static_pointer_cast<FusedPostprocessor>(processor)->ProcessTimed(*this,
+                                                                                     description,
+                                                                                     fusedTimes);
+      }
+      else {
+        success=processor->Process(*this,description);
+      }
+
+      if (!success) {
         log.Error() << "Error during execution of postprocessor " << pos;
         Cleanup();
 
         return false;
       }
 
-      pos++;
+      processorTime.Stop();
+
+      if (collectTimings) {
+        if (count>1) {
+          for (size_t i=0; i<fusedTimes.size(); i++) {
+            timings.push_back({pos+i,true,fusedTimes[i]});
+          }
+        }
+        else {
+          timings.push_back({pos,false,processorTime.GetDuration()});
+        }
+      }
+
+      if (count>1) {
+        log.Debug() << "Postprocessors " << pos << "-" << pos+count-1 << " (fused): " << processorTime.ResultString() << "s";
+      }
+      else {
+        log.Debug() << "Postprocessor " << pos << ": " << processorTime.ResultString() << "s";
+      }
+
+      pos+=count;
     }
 
     Cleanup();
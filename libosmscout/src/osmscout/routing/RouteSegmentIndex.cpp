@@ -0,0 +1,196 @@
+/*
+  This source is part of the libosmscout library
+  Copyright (C) 2026  Tim Teulings
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307  USA
+*/
+
+#include <osmscout/routing/RouteSegmentIndex.h>
+
+#include <osmscout/util/Geometry.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace osmscout {
+
+  RouteSegmentIndex::RouteSegmentIndex(const RouteDescription& route,
+                                       double cellSize)
+  : cellSize(cellSize)
+  {
+    assert(cellSize>0.0);
+
+    points.reserve(route.Nodes().size());
+    for (const auto& node : route.Nodes()) {
+      points.push_back(node.GetLocation());
+    }
+
+    for (size_t segment=0; segment<GetSegmentCount(); segment++) {
+      AddSegment(uint32_t(segment));
+    }
+  }
+
+  uint32_t RouteSegmentIndex::GetCellX(double lon) const
+  {
+    return uint32_t(std::max(0.0,std::floor((lon+180.0)/cellSize)));
+  }
+
+  uint32_t RouteSegmentIndex::GetCellY(double lat) const
+  {
+    return uint32_t(std::max(0.0,std::floor((lat+90.0)/cellSize)));
+  }
+
+  /**
+   * Register the segment in all cells it crosses. We walk the cell columns
+   * between the segment ends and add the cells covered by the part of the segment
+   * inside the column.
+   */
+  void RouteSegmentIndex::AddSegment(uint32_t segment)
+  {
+    GeoCoord start=points[segment];
+    GeoCoord end=points[segment+1];
+
+    if (start.GetLon()>end.GetLon()) {
+      std::swap(start,end);
+    }
+
+    uint32_t startX=GetCellX(start.GetLon());
+    uint32_t endX=GetCellX(end.GetLon());
+    double   deltaLon=end.GetLon()-start.GetLon();
+    double   deltaLat=end.GetLat()-start.GetLat();
+
+    for (uint32_t x=startX; x<=endX; x++) {
+      double columnStartLat=start.GetLat();
+      double columnEndLat=end.GetLat();
+
+      if (deltaLon>0.0) {
+        double columnStartLon=std::max(start.GetLon(),double(x)*cellSize-180.0);
+        double columnEndLon=std::min(end.GetLon(),double(x+1)*cellSize-180.0);
+
+        columnStartLat=start.GetLat()+deltaLat*(columnStartLon-start.GetLon())/deltaLon;
+        columnEndLat=start.GetLat()+deltaLat*(columnEndLon-start.GetLon())/deltaLon;
+      }
+
+      uint32_t startY=GetCellY(std::min(columnStartLat,columnEndLat));
+      uint32_t endY=GetCellY(std::max(columnStartLat,columnEndLat));
+
+      for (uint32_t y=startY; y<=endY; y++) {
+        std::vector<uint32_t>& cell=cells[GetCellKey(x,y)];
+
+        if (cell.empty() || cell.back()!=segment) {
+          cell.push_back(segment);
+        }
+      }
+    }
+  }
+
+  bool RouteSegmentIndex::SearchClosestSegment(const GeoCoord& location,
+                                               size_t fromSegment,
+                                               double maxDistance,
+                                               SegmentMatch& match) const
+  {
+    uint32_t startX=GetCellX(location.GetLon()-maxDistance);
+    uint32_t endX=GetCellX(location.GetLon()+maxDistance);
+    uint32_t startY=GetCellY(location.GetLat()-maxDistance);
+    uint32_t endY=GetCellY(location.GetLat()+maxDistance);
+
+    std::vector<uint32_t> candidates;
+
+    for (uint32_t x=startX; x<=endX; x++) {
+      for (uint32_t y=startY; y<=endY; y++) {
+        auto cell=cells.find(GetCellKey(x,y));
+
+        if (cell==cells.end()) {
+          continue;
+        }
+
+        for (uint32_t segment : cell->second) {
+          if (segment>=fromSegment) {
+            candidates.push_back(segment);
+          }
+        }
+      }
+    }
+
+    std::sort(candidates.begin(),candidates.end());
+    candidates.erase(std::unique(candidates.begin(),candidates.end()),candidates.end());
+
+    bool     found=false;
+    uint32_t lastSegment=0;
+
+    for (uint32_t segment : candidates) {
+      double abscissa;
+      double qLon;
+      double qLat;
+      double distance=DistanceToSegment(location.GetLon(),
+                                        location.GetLat(),
+                                        points[segment].GetLon(),
+                                        points[segment].GetLat(),
+                                        points[segment+1].GetLon(),
+                                        points[segment+1].GetLat(),
+                                        abscissa,
+                                        qLon,
+                                        qLat);
+
+      if (distance>maxDistance) {
+        continue;
+      }
+
+      if (found && segment!=lastSegment+1) {
+        // The route left the surrounding of the location, we have our candidate
+        break;
+      }
+
+      if (!found || match.distance>=distance) {
+        match.segment=segment;
+        match.abscissa=abscissa;
+        match.distance=distance;
+        match.closestPoint.Set(qLat,qLon);
+        found=true;
+      }
+
+      lastSegment=segment;
+    }
+
+    return found;
+  }
+
+  double RouteSegmentIndex::GetDistance(const GeoCoord& location,
+                                        size_t fromSegment) const
+  {
+    double minDistance=std::numeric_limits<double>::max();
+
+    for (size_t segment=fromSegment; segment<GetSegmentCount(); segment++) {
+      double abscissa;
+      double qLon;
+      double qLat;
+      double distance=DistanceToSegment(location.GetLon(),
+                                        location.GetLat(),
+                                        points[segment].GetLon(),
+                                        points[segment].GetLat(),
+                                        points[segment+1].GetLon(),
+                                        points[segment+1].GetLat(),
+                                        abscissa,
+                                        qLon,
+                                        qLat);
+
+      minDistance=std::min(minDistance,distance);
+    }
+
+    return minDistance;
+  }
+}
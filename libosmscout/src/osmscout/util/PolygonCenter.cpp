@@ -205,4 +205,75 @@ GeoCoord PolygonCenter(const std::vector<Point>& ring, double precision)
   GeoBox bbox=osmscout::GetBoundingBox(ring);
   return PolygonCenter(polygon, bbox, precision);
 }
+
+static bool HasLabelFeature(const FeatureValueBuffer& buffer)
+{
+  for (size_t idx=0; idx<buffer.GetFeatureCount(); idx++) {
+    if (buffer.HasFeature(idx) &&
+        buffer.GetFeature(idx).GetFeature()->HasLabel()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::optional<GeoCoord> RingLabelAnchor(const Area& area, size_t ringIndex)
+{
+  const Area::Ring& ring=area.rings[ringIndex];
+
+  if (ring.nodes.size()<3 ||
+      !ring.GetType()) {
+    return std::nullopt;
+  }
+
+  // Outer rings without own type inherit type and features from the master ring
+  TypeInfoRef               type=area.GetRingType(ring);
+  const FeatureValueBuffer& features=ring.GetType()==type ? ring.GetFeatureValueBuffer() : area.GetFeatureValueBuffer();
+
+  if (!type ||
+      type->GetIgnore() ||
+      !HasLabelFeature(features)) {
+    return std::nullopt;
+  }
+
+  Polygon polygon;
+
+  polygon.push_back(&ring.nodes);
+
+  if (ring.IsOuter()) {
+    area.VisitClippingRings(ringIndex, [&polygon](size_t, const Area::Ring &innerRing, const TypeInfoRef&) -> bool {
+      if (innerRing.nodes.size()>=3) {
+        polygon.push_back(&innerRing.nodes);
+      }
+      return true;
+    });
+  }
+
+  GeoBox bbox=ring.GetBoundingBox();
+  double dimension=std::max(bbox.GetWidth(), bbox.GetHeight());
+  GeoCoord center=PolygonCenter(polygon, bbox, dimension * 0.01);
+  GeoCoord bboxCenter=bbox.GetCenter();
+
+  // The bounding box center would place the label outside of the area
+  if (!IsCoordInArea(bboxCenter, ring.nodes)) {
+    return center;
+  }
+
+  for (size_t i=1; i<polygon.size(); i++) {
+    if (IsCoordInArea(bboxCenter, *polygon[i])) {
+      return center;
+    }
+  }
+
+  // when computed center is close to bbox center (20% of longest bbox side),
+  // it is not necessary to store center coordinates to Ring
+  auto a=bboxCenter.GetLat()-center.GetLat();
+  auto b=bboxCenter.GetLon()-center.GetLon();
+  if (sqrt(a*a + b*b) < dimension * 0.2) {
+    return std::nullopt;
+  }
+
+  return center;
+}
 }
@@ -732,19 +732,19 @@ namespace osmscout {
       return false;
     }
 
-    std::tm time{};
-
-    time.tm_year = y - 1900; // Year since 1900
-    time.tm_mon = M - 1;     // 0-11
-    time.tm_mday = d;        // 1-31
-    time.tm_hour = h;        // 0-23
-    time.tm_min = m;         // 0-59
-    time.tm_sec = s;         // 0-60
+    // Pure calendar arithmetic, mktime is slow and serialized by the time zone lock,
+    // what hurts when parsing large gpx files in parallel
+    year_month_day ymd=year(y)/month(static_cast<unsigned>(M))/day(static_cast<unsigned>(d));
+    if (!ymd.ok() ||
+        h<0 || h>23 ||
+        m<0 || m>59 ||
+        s<0 || s>60) { // leap second
+      return false;
+    }
 
-    std::time_t tt = MkTimeUTC(&time);
+    sys_days date=ymd;
 
-    time_point<system_clock, nanoseconds> timePoint=system_clock::from_time_t(tt);
-    timestamp=time_point_cast<milliseconds,system_clock,nanoseconds>(timePoint);
+    timestamp=time_point_cast<milliseconds>(date+hours(h)+minutes(m)+seconds(s));
     // add milliseconds
     if (ret>6) {
       timestamp += milliseconds(mill);